@@ -6,4 +6,9 @@ layout(std430, binding = 2) readonly buffer MaterialBuffer { GpuMaterial materia
 layout(std430, binding = 3) readonly buffer MeshBuffer { GpuStaticMesh meshes[]; };
 layout(std430, binding = 4) readonly buffer LightBuffer { GpuLight lights[]; };
 layout(std140, binding = 5) uniform CameraBuffer { GpuCamera camera; };
+layout(std140, binding = 6) uniform ShadowBuffer { GpuShadowCascades shadows; };
 layout(std430, binding = 6) readonly buffer TextureHandleBuffer { uint64_t textureHandles[]; };
+layout(std430, binding = 7) readonly buffer MeshletBuffer { GpuMeshlet meshlets[]; };
+layout(std430, binding = 10) readonly buffer MeshLodBuffer { GpuMeshLod meshLods[]; };
+layout(std430, binding = 11) buffer TextureFeedbackBuffer { uint textureFeedback[]; };
+layout(std430, binding = 12) readonly buffer TextureResidencyBuffer { uint textureResidency[]; };
@@ -0,0 +1,226 @@
+// ConeTracing.glsl
+#include "Common.glsl"
+
+// Voxel cone tracing against the VoxelPass radiance and irradiance volumes.
+
+uniform sampler3D u_VoxelRadiance;
+uniform sampler3D u_VoxelNormal;
+uniform sampler3D u_IrradianceCache;
+
+uniform ivec3 u_Resolution;
+uniform ivec3 u_GridMin;
+uniform ivec3 u_GridMax;
+uniform int u_MipCount;
+uniform vec3 u_CellSize;
+
+uniform float u_IndirectStrength = 1.0;
+uniform float u_SpecularStrength = 1.0;
+uniform float u_MaxDistance = 50.0;
+
+const float CONE_TRACE_MIN_DIAMETER = 0.5;
+
+vec3 WorldToVoxelUVW(vec3 worldPos)
+{
+    return (worldPos - u_GridMin) / (u_GridMax - u_GridMin);
+}
+
+vec4 SampleVoxelRadianceSafe(vec3 worldPos, float lod)
+{
+    vec3 uvw = WorldToVoxelUVW(worldPos);
+    if (any(lessThan(uvw, vec3(0.0))) || any(greaterThan(uvw, vec3(1.0))))
+        return vec4(0.0);
+    return textureLod(u_VoxelRadiance, uvw, lod);
+}
+
+vec4 SampleIrradianceSafe(vec3 worldPos, float lod)
+{
+    vec3 uvw = WorldToVoxelUVW(worldPos);
+    if (any(lessThan(uvw, vec3(0.0))) || any(greaterThan(uvw, vec3(1.0))))
+        return vec4(0.0);
+    return textureLod(u_IrradianceCache, uvw, lod);
+}
+
+void BuildTangentBasis(vec3 normal, out vec3 tangent, out vec3 bitangent)
+{
+    vec3 up = abs(normal.y) < 0.9 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
+    tangent = normalize(cross(up, normal));
+    bitangent = cross(normal, tangent);
+}
+
+vec3 SampleConeDirection(vec3 normal, vec3 tangent, vec3 bitangent, int index, int total)
+{
+    float goldenRatio = 2.39996322972865332;
+    float theta = float(index) * goldenRatio;
+    float phi = acos(1.0 - (float(index) + 0.5) / float(total));
+    
+    float sinPhi = sin(phi);
+    vec3 dir = sinPhi * cos(theta) * tangent +
+               sinPhi * sin(theta) * bitangent +
+               cos(phi) * normal;
+    
+    return normalize(dir);
+}
+
+vec3 TraceSpecularCone(vec3 origin, vec3 direction, float roughness, float maxDist)
+{
+    vec3 radiance = vec3(0.0);
+    float alpha = 0.0;
+    
+    float coneAperture = max(0.0001, roughness * roughness * 0.5);
+    float minVoxelDiameter = u_CellSize.x * CONE_TRACE_MIN_DIAMETER;    
+    float dist = minVoxelDiameter * 2.0;
+    
+    const int MAX_STEPS = 128;
+    int step = 0;
+    
+    while (dist < maxDist && alpha < 0.99 && step < MAX_STEPS)
+    {
+        float coneDiameter = max(minVoxelDiameter, 2.0 * tan(coneAperture) * dist);  
+        float lod = log2(coneDiameter / u_CellSize.x);
+        lod = clamp(lod, 0.0, float(u_MipCount - 1));
+        
+        vec3 samplePos = origin + direction * dist;
+        
+        vec4 irradianceSample = SampleIrradianceSafe(samplePos, lod);
+        vec4 geometrySample = SampleVoxelRadianceSafe(samplePos, lod);
+        
+        if (geometrySample.a > 0.001)
+        {
+            float weight = geometrySample.a * (1.0 - alpha);
+            radiance += irradianceSample.rgb * weight;
+            alpha += weight;
+        }
+        
+        dist += max(coneDiameter * 0.5, minVoxelDiameter);
+        step++;
+    }
+    
+    return radiance;
+}
+
+// The cone straight along the normal, it also picks up the irradiance cache where there is no geometry.
+vec3 TraceDiffuseCenterCone(vec3 position, vec3 normal, float coneRatio, float maxDist)
+{
+    float minVoxelDiameter = u_CellSize.x * CONE_TRACE_MIN_DIAMETER;
+    vec3 radiance = vec3(0.0);
+    float coneWeight = 0.0;
+    float occlusion = 0.0;
+    float dist = minVoxelDiameter * 3.0;
+    
+    for (int step = 0; step < 64; step++)
+    {
+        if (dist >= maxDist) break;
+        
+        float coneDiameter = max(2.0 * coneRatio * dist, minVoxelDiameter);
+        float lod = clamp(log2(coneDiameter / u_CellSize.x), 0.0, float(u_MipCount - 1));
+        
+        vec3 samplePos = position + normal * dist;
+        
+        vec4 irradianceSample = SampleIrradianceSafe(samplePos, lod);
+        vec4 geometrySample = SampleVoxelRadianceSafe(samplePos, lod);
+        
+        if (geometrySample.a > 0.01 || irradianceSample.a > 0.1)
+        {
+            float falloff = 1.0 / (1.0 + 0.02 * dist);
+            float weight = max(geometrySample.a, irradianceSample.a * 0.5) * (1.0 - min(occlusion, 0.95)) * falloff;
+
+            vec3 sampleValue = irradianceSample.a > 0.1 ? irradianceSample.rgb : geometrySample.rgb;
+            radiance += sampleValue * weight;
+            coneWeight += weight;
+            occlusion += geometrySample.a * (1.0 - min(occlusion, 0.95)) * 0.25;
+        }
+        
+        dist += coneDiameter * 1.2;
+    }
+    
+    if (coneWeight > 0.0001)
+        radiance /= coneWeight;
+    
+    return radiance;
+}
+
+// One of the four cones tilted around the normal, index 0 to 3.
+vec3 TraceDiffuseSideCone(vec3 position, vec3 normal, vec3 tangent, vec3 bitangent, int index, float coneRatio, float maxDist)
+{
+    float minVoxelDiameter = u_CellSize.x * CONE_TRACE_MIN_DIAMETER;
+    float angle = float(index) * 1.5708;
+    vec3 offset = cos(angle) * tangent + sin(angle) * bitangent;
+    vec3 coneDir = normalize(normal + offset * 0.5);
+    
+    vec3 radiance = vec3(0.0);
+    float coneWeight = 0.0;
+    float occlusion = 0.0;
+    float dist = minVoxelDiameter * 3.0;
+    
+    for (int step = 0; step < 64; step++)
+    {
+        if (dist >= maxDist) break;
+        
+        float coneDiameter = max(2.0 * coneRatio * dist, minVoxelDiameter);
+        float lod = clamp(log2(coneDiameter / u_CellSize.x) + 0.5, 0.0, float(u_MipCount - 1));
+        
+        vec3 samplePos = position + coneDir * dist;
+        
+        vec4 irradianceSample = SampleIrradianceSafe(samplePos, lod);
+        vec4 geometrySample = SampleVoxelRadianceSafe(samplePos, lod);
+        
+        if (geometrySample.a > 0.01)
+        {
+            float falloff = 1.0 / (1.0 + 0.05 * dist);
+            float weight = geometrySample.a * (1.0 - min(occlusion, 0.98)) * falloff;
+            radiance += irradianceSample.rgb * weight;
+            coneWeight += weight;
+            occlusion += geometrySample.a * (1.0 - min(occlusion, 0.98)) * 0.3;
+        }
+        
+        dist += coneDiameter * 1.3;
+    }
+    
+    if (coneWeight > 0.0001)
+        radiance /= coneWeight;
+    
+    return radiance;
+}
+
+vec3 ComputeIndirectDiffuse(vec3 position, vec3 normal, float roughness)
+{
+    vec3 tangent, bitangent;
+    BuildTangentBasis(normal, tangent, bitangent);
+    
+    float maxDist = u_MaxDistance * 0.4;
+    float coneRatio = mix(0.35, 0.75, roughness);
+    
+    vec3 gi = TraceDiffuseCenterCone(position, normal, coneRatio, maxDist) * 0.3;
+    for (int i = 0; i < 4; i++)
+        gi += TraceDiffuseSideCone(position, normal, tangent, bitangent, i, coneRatio, maxDist) * 0.175;
+    
+    return gi * u_IndirectStrength;
+}
+
+// Half of the side cones, set 0 or 1. Neighbouring pixels and consecutive frames alternate
+// sets, so temporal accumulation converges on the full cone set at the cost of three cones.
+vec3 ComputeIndirectDiffuseCheckerboard(vec3 position, vec3 normal, float roughness, int set)
+{
+    vec3 tangent, bitangent;
+    BuildTangentBasis(normal, tangent, bitangent);
+    
+    float maxDist = u_MaxDistance * 0.4;
+    float coneRatio = mix(0.35, 0.75, roughness);
+    
+    vec3 gi = TraceDiffuseCenterCone(position, normal, coneRatio, maxDist) * 0.3;
+    gi += TraceDiffuseSideCone(position, normal, tangent, bitangent, set, coneRatio, maxDist) * 0.35;
+    gi += TraceDiffuseSideCone(position, normal, tangent, bitangent, set + 2, coneRatio, maxDist) * 0.35;
+    
+    return gi * u_IndirectStrength;
+}
+
+vec3 ComputeSpecularReflection(vec3 position, vec3 normal, vec3 viewDir, float roughness)
+{
+    if (roughness > 0.95)
+        return vec3(0.0);
+    
+    vec3 reflectDir = reflect(-viewDir, normal);
+    float maxDist = u_MaxDistance * mix(1.0, 0.5, roughness * roughness);
+    
+    return TraceSpecularCone(position, reflectDir, roughness, maxDist) * u_SpecularStrength;
+}
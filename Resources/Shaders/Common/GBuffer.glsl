@@ -0,0 +1,73 @@
+// GBuffer.glsl
+#include "Common.glsl"
+
+// Layout, 12 bytes of colour per pixel plus depth:
+//   GBuffer/Color     RGBA8   albedo with the sRGB curve applied, alpha
+//   GBuffer/Normal    RG16F   octahedral world normal
+//   GBuffer/Material  RGBA8   metallic, roughness, ao, (ior - 1) / 2
+// World position is not stored, it comes back from the depth buffer.
+
+struct GBufferMaterial
+{
+    float m_Metallic;
+    float m_Roughness;
+    float m_AO;
+    float m_IOR;
+};
+
+const float GBUFFER_IOR_RANGE = 2.0;
+
+vec4 EncodeAlbedo(vec4 linear)
+{
+    vec3 c = clamp(linear.rgb, 0.0, 1.0);
+    vec3 srgb = mix(1.055 * pow(c, vec3(1.0 / 2.4)) - 0.055, c * 12.92, lessThan(c, vec3(0.0031308)));
+    return vec4(srgb, linear.a);
+}
+
+vec4 DecodeAlbedo(vec4 encoded)
+{
+    vec3 c = encoded.rgb;
+    vec3 linear = mix(pow((c + 0.055) / 1.055, vec3(2.4)), c / 12.92, lessThan(c, vec3(0.04045)));
+    return vec4(linear, encoded.a);
+}
+
+vec2 OctWrap(vec2 v)
+{
+    return (1.0 - abs(v.yx)) * mix(vec2(-1.0), vec2(1.0), greaterThanEqual(v, vec2(0.0)));
+}
+
+vec2 EncodeNormal(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    return n.z >= 0.0 ? n.xy : OctWrap(n.xy);
+}
+
+vec3 DecodeNormal(vec2 encoded)
+{
+    vec3 n = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
+vec4 EncodeMaterial(float metallic, float roughness, float ao, float ior)
+{
+    return clamp(vec4(metallic, roughness, ao, (ior - 1.0) / GBUFFER_IOR_RANGE), 0.0, 1.0);
+}
+
+GBufferMaterial DecodeMaterial(vec4 encoded)
+{
+    GBufferMaterial mat;
+    mat.m_Metallic = encoded.r;
+    mat.m_Roughness = encoded.g;
+    mat.m_AO = encoded.b;
+    mat.m_IOR = 1.0 + encoded.a * GBUFFER_IOR_RANGE;
+    return mat;
+}
+
+vec3 ReconstructWorldPosition(vec2 uv, float depth)
+{
+    vec4 clip = vec4(uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 world = camera.m_InverseViewProjection * clip;
+    return world.xyz / world.w;
+}
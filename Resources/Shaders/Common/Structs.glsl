@@ -42,13 +42,65 @@ struct GpuStaticMesh
     uint32_t m_IndexCount;
     uint32_t m_MaterialIndex;
     uint32_t m_UseViewModel;
-    int _pad1;
+    uint32_t m_LodOffset;
+    uint32_t m_LodCount;
+    uint32_t m_Skinned;
+};
+
+struct GpuMeshLod
+{
+    uint32_t m_FirstIndex;
+    uint32_t m_IndexCount;
+    uint32_t m_MeshletOffset;
+    uint32_t m_MeshletCount;
+    float m_Error;
+    float _pad0[3];
+};
+
+struct GpuMeshlet
+{
+    vec3 m_Center;
+    float m_Radius;
+    vec3 m_ConeAxis;
+    float m_ConeCutoff;
+    uint32_t m_MeshIndex;
+    uint32_t m_IndexOffset;
+    uint32_t m_IndexCount;
+    uint32_t m_VertexOffset;
+};
+
+struct GpuDrawCommand
+{
+    int m_Count;
+    int m_InstanceCount;
+    int m_FirstIndex;
+    int m_BaseVertex;
+    int m_BaseInstance;
+    int _pad0[3];
+};
+
+struct GpuSkinnedVertex
+{
+    uvec2 m_Joints;
+    uvec2 m_Weights;
+};
+
+struct GpuSkinnedMesh
+{
+    uint32_t m_SourceOffset;
+    uint32_t m_VertexOffset;
+    uint32_t m_VertexCount;
+    uint32_t m_FirstThread;
+    uint32_t m_BoneMatrixOffset;
+    uint32_t m_BoneCount;
+    int _pad0[2];
 };
 
 struct GpuCamera
 {
     mat4 m_ViewMatrix;
     mat4 m_ProjectionMatrix;
+    mat4 m_InverseViewProjection;
     vec3 m_Position;
     float _pad0;
 };
@@ -62,9 +114,24 @@ struct GpuLight
     vec3 m_Direction;
     int m_Type;
     vec2 m_ConeAngles;
-    vec2 _pad0;
+    int m_ShadowTileCount;
+    int _pad0;
     mat4 m_LightSpaceMatrix;
     mat4 m_ShadowMatrices[6];
+    vec4 m_ShadowTiles[6];
+};
+
+#define SHADOW_CASCADE_COUNT 4
+
+struct GpuShadowCascades
+{
+    mat4 m_ViewProjection[SHADOW_CASCADE_COUNT];
+    vec4 m_Splits;
+    vec4 m_TexelSizes;
+    int m_CascadeCount;
+    int m_LightIndex;
+    int _pad0;              // std140 gives arrays a 16 byte stride, scalars keep the C++ size
+    int _pad1;
 };
 
 struct UnpackedVertex
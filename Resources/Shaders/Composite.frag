@@ -3,233 +3,39 @@
 #extension GL_NV_gpu_shader5 : enable
 #extension GL_ARB_bindless_texture : require
 #extension GL_ARB_gpu_shader_int64 : enable
-#include "Common/Common.glsl"
+#include "Common/GBuffer.glsl"
+#include "Common/ConeTracing.glsl"
 
 in vec2 TexCoord;
 out vec4 FragColor;
 
 uniform sampler2D u_GColor;
 uniform sampler2D u_GNormal;
-uniform sampler2D u_GPosition;
 uniform sampler2D u_GMaterial;
 uniform sampler2D u_ShadowMap;
 uniform sampler2D u_DirectLighting;
 uniform sampler2D u_Selection;
 uniform sampler2D u_DepthBuffer;
-
-uniform sampler3D u_VoxelRadiance;
-uniform sampler3D u_VoxelNormal;
-uniform sampler3D u_IrradianceCache;
-
-uniform ivec3 u_Resolution;
-uniform ivec3 u_GridMin;
-uniform ivec3 u_GridMax;
-uniform int u_MipCount;
-uniform vec3 u_CellSize;
+uniform sampler2D u_IndirectDiffuse;
+uniform sampler2D u_IndirectSpecular;
 
 uniform bool u_EnableGI = true;
 uniform bool u_EnableReflections = true;
+uniform bool u_EnableReducedGI = true;
+uniform int u_IndirectDownscale = 2;
 uniform bool u_EnableTonemapping = true;
 uniform bool u_EnableAO = true;
 uniform float u_AOIntensity = 1.0;
 uniform float u_AORadius = 2.0;
 
-uniform float u_IndirectStrength = 1.0;
-uniform float u_SpecularStrength = 1.0;
-uniform float u_MaxDistance = 50.0;
-
 uniform vec3 u_OutlineColor = vec3(1.0, 0.6, 0.0);
 
-const float CONE_TRACE_MIN_DIAMETER = 0.5;
-
-vec3 WorldToVoxelUVW(vec3 worldPos)
-{
-    return (worldPos - u_GridMin) / (u_GridMax - u_GridMin);
-}
-
-vec4 SampleVoxelRadianceSafe(vec3 worldPos, float lod)
-{
-    vec3 uvw = WorldToVoxelUVW(worldPos);
-    if (any(lessThan(uvw, vec3(0.0))) || any(greaterThan(uvw, vec3(1.0))))
-        return vec4(0.0);
-    return textureLod(u_VoxelRadiance, uvw, lod);
-}
-
-vec4 SampleIrradianceSafe(vec3 worldPos, float lod)
-{
-    vec3 uvw = WorldToVoxelUVW(worldPos);
-    if (any(lessThan(uvw, vec3(0.0))) || any(greaterThan(uvw, vec3(1.0))))
-        return vec4(0.0);
-    return textureLod(u_IrradianceCache, uvw, lod);
-}
-
-void BuildTangentBasis(vec3 normal, out vec3 tangent, out vec3 bitangent)
-{
-    vec3 up = abs(normal.y) < 0.9 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
-    tangent = normalize(cross(up, normal));
-    bitangent = cross(normal, tangent);
-}
-
-vec3 SampleConeDirection(vec3 normal, vec3 tangent, vec3 bitangent, int index, int total)
-{
-    float goldenRatio = 2.39996322972865332;
-    float theta = float(index) * goldenRatio;
-    float phi = acos(1.0 - (float(index) + 0.5) / float(total));
-    
-    float sinPhi = sin(phi);
-    vec3 dir = sinPhi * cos(theta) * tangent +
-               sinPhi * sin(theta) * bitangent +
-               cos(phi) * normal;
-    
-    return normalize(dir);
-}
-
 vec3 IORToF0(float ior, vec3 albedo, float metallic)
 {
     float baseF0 = pow((ior - 1.0) / (ior + 1.0), 2.0);
     return mix(vec3(baseF0), albedo, metallic);
 }
 
-vec3 TraceSpecularCone(vec3 origin, vec3 direction, float roughness, float maxDist)
-{
-    vec3 radiance = vec3(0.0);
-    float alpha = 0.0;
-    
-    float coneAperture = max(0.0001, roughness * roughness * 0.5);
-    float minVoxelDiameter = u_CellSize.x * CONE_TRACE_MIN_DIAMETER;    
-    float dist = minVoxelDiameter * 2.0;
-    
-    const int MAX_STEPS = 128;
-    int step = 0;
-    
-    while (dist < maxDist && alpha < 0.99 && step < MAX_STEPS)
-    {
-        float coneDiameter = max(minVoxelDiameter, 2.0 * tan(coneAperture) * dist);  
-        float lod = log2(coneDiameter / u_CellSize.x);
-        lod = clamp(lod, 0.0, float(u_MipCount - 1));
-        
-        vec3 samplePos = origin + direction * dist;
-        
-        vec4 irradianceSample = SampleIrradianceSafe(samplePos, lod);
-        vec4 geometrySample = SampleVoxelRadianceSafe(samplePos, lod);
-        
-        if (geometrySample.a > 0.001)
-        {
-            float weight = geometrySample.a * (1.0 - alpha);
-            radiance += irradianceSample.rgb * weight;
-            alpha += weight;
-        }
-        
-        dist += max(coneDiameter * 0.5, minVoxelDiameter);
-        step++;
-    }
-    
-    return radiance;
-}
-
-vec3 ComputeIndirectDiffuse(vec3 position, vec3 normal, float roughness)
-{
-    vec3 tangent, bitangent;
-    BuildTangentBasis(normal, tangent, bitangent);
-    
-    vec3 gi = vec3(0.0);
-    float maxDist = u_MaxDistance * 0.4;
-    float minVoxelDiameter = u_CellSize.x * CONE_TRACE_MIN_DIAMETER;
-    float coneRatio = mix(0.35, 0.75, roughness);
-    
-    {
-        vec3 radiance = vec3(0.0);
-        float coneWeight = 0.0;
-        float occlusion = 0.0;
-        float dist = minVoxelDiameter * 3.0;
-        
-        for (int step = 0; step < 64; step++)
-        {
-            if (dist >= maxDist) break;
-            
-            float coneDiameter = max(2.0 * coneRatio * dist, minVoxelDiameter);
-            float lod = clamp(log2(coneDiameter / u_CellSize.x), 0.0, float(u_MipCount - 1));
-            
-            vec3 samplePos = position + normal * dist;
-            
-            vec4 irradianceSample = SampleIrradianceSafe(samplePos, lod);
-            vec4 geometrySample = SampleVoxelRadianceSafe(samplePos, lod);
-            
-            if (geometrySample.a > 0.01 || irradianceSample.a > 0.1)
-            {
-                float falloff = 1.0 / (1.0 + 0.02 * dist);
-                float weight = max(geometrySample.a, irradianceSample.a * 0.5) * (1.0 - min(occlusion, 0.95)) * falloff;
-    
-                vec3 sampleValue = irradianceSample.a > 0.1 ? irradianceSample.rgb : geometrySample.rgb;
-                radiance += sampleValue * weight;
-                coneWeight += weight;
-                occlusion += geometrySample.a * (1.0 - min(occlusion, 0.95)) * 0.25;
-            }
-            
-            dist += coneDiameter * 1.2;
-        }
-        
-        if (coneWeight > 0.0001)
-            radiance /= coneWeight;
-        
-        gi += radiance * 0.3;
-    }
-    
-    for (int i = 0; i < 4; i++)
-    {
-        float angle = float(i) * 1.5708;
-        vec3 offset = cos(angle) * tangent + sin(angle) * bitangent;
-        vec3 coneDir = normalize(normal + offset * 0.5);
-        
-        vec3 radiance = vec3(0.0);
-        float coneWeight = 0.0;
-        float occlusion = 0.0;
-        float dist = minVoxelDiameter * 3.0;
-        
-        for (int step = 0; step < 64; step++)
-        {
-            if (dist >= maxDist) break;
-            
-            float coneDiameter = max(2.0 * coneRatio * dist, minVoxelDiameter);
-            float lod = clamp(log2(coneDiameter / u_CellSize.x) + 0.5, 0.0, float(u_MipCount - 1));
-            
-            vec3 samplePos = position + coneDir * dist;
-            
-            vec4 irradianceSample = SampleIrradianceSafe(samplePos, lod);
-            vec4 geometrySample = SampleVoxelRadianceSafe(samplePos, lod);
-            
-            if (geometrySample.a > 0.01)
-            {
-                float falloff = 1.0 / (1.0 + 0.05 * dist);
-                float weight = geometrySample.a * (1.0 - min(occlusion, 0.98)) * falloff;
-                radiance += irradianceSample.rgb * weight;
-                coneWeight += weight;
-                occlusion += geometrySample.a * (1.0 - min(occlusion, 0.98)) * 0.3;
-            }
-            
-            dist += coneDiameter * 1.3;
-        }
-        
-        if (coneWeight > 0.0001)
-            radiance /= coneWeight;
-        
-        gi += radiance * 0.175;
-    }
-    
-    return gi * u_IndirectStrength;
-}
-
-vec3 ComputeSpecularReflection(vec3 position, vec3 normal, vec3 viewDir, float roughness)
-{
-    if (roughness > 0.95)
-        return vec3(0.0);
-    
-    vec3 reflectDir = reflect(-viewDir, normal);
-    float maxDist = u_MaxDistance * mix(1.0, 0.5, roughness * roughness);
-    
-    return TraceSpecularCone(position, reflectDir, roughness, maxDist) * u_SpecularStrength;
-}
-
 float ComputeVoxelAO(vec3 position, vec3 normal)
 {
     vec3 tangent, bitangent;
@@ -270,6 +76,68 @@ float ComputeVoxelAO(vec3 position, vec3 normal)
     return occlusion;
 }
 
+// Joint bilateral upsample of the reduced resolution indirect lighting. Low res pixel q was
+// traced at full res pixel q * scale + scale / 2, its view depth is in the diffuse alpha.
+void UpsampleIndirect(ivec2 pixel, float viewDepth, vec3 normal, out vec3 diffuse, out vec3 specular)
+{
+    ivec2 lowSize = textureSize(u_IndirectDiffuse, 0);
+    ivec2 fullSize = textureSize(u_GNormal, 0);
+    int scale = u_IndirectDownscale;
+    
+    vec2 lowPos = (vec2(pixel) - float(scale / 2)) / float(scale);
+    ivec2 base = ivec2(floor(lowPos));
+    vec2 f = lowPos - vec2(base);
+    
+    diffuse = vec3(0.0);
+    specular = vec3(0.0);
+    float totalWeight = 0.0;
+    
+    vec3 nearestDiffuse = vec3(0.0);
+    vec3 nearestSpecular = vec3(0.0);
+    float nearestDelta = 1e30;
+    
+    for (int i = 0; i < 4; i++)
+    {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 q = clamp(base + offset, ivec2(0), lowSize - 1);
+        
+        vec4 lowDiffuse = texelFetch(u_IndirectDiffuse, q, 0);
+        vec3 lowSpecular = texelFetch(u_IndirectSpecular, q, 0).rgb;
+        if (lowDiffuse.a <= 0.0)
+            continue;
+        
+        vec3 lowNormal = DecodeNormal(texelFetch(u_GNormal, min(q * scale + scale / 2, fullSize - 1), 0).xy);
+        float depthDelta = abs(lowDiffuse.a - viewDepth) / viewDepth;
+        
+        vec2 bilinear = mix(vec2(1.0) - f, f, vec2(offset));
+        float weight = bilinear.x * bilinear.y;
+        weight *= 1.0 / (depthDelta * 50.0 + 0.001);
+        weight *= pow(max(dot(normal, lowNormal), 0.0), 16.0);
+        
+        diffuse += lowDiffuse.rgb * weight;
+        specular += lowSpecular * weight;
+        totalWeight += weight;
+        
+        if (depthDelta < nearestDelta)
+        {
+            nearestDelta = depthDelta;
+            nearestDiffuse = lowDiffuse.rgb;
+            nearestSpecular = lowSpecular;
+        }
+    }
+    
+    // No tap on the same surface, take the closest in depth rather than leave a hole.
+    if (totalWeight < 0.0001)
+    {
+        diffuse = nearestDiffuse;
+        specular = nearestSpecular;
+        return;
+    }
+    
+    diffuse /= totalWeight;
+    specular /= totalWeight;
+}
+
 vec3 ACESFilm(vec3 x)
 {
     float a = 2.51;
@@ -324,26 +192,41 @@ vec3 HandleOutline(vec2 uv, vec3 baseColor)
 
 void main()
 {
-    vec3 worldPos = texture(u_GPosition, TexCoord).rgb;   
-    if (dot(worldPos, worldPos) < 0.001)
+    float depth = texture(u_DepthBuffer, TexCoord).r;
+    if (depth >= 0.9999)
     {
         FragColor = texture(u_DirectLighting, TexCoord);
         return;
     }
     
+    vec3 worldPos = ReconstructWorldPosition(TexCoord, depth);
     vec3 directLighting = texture(u_DirectLighting, TexCoord).rgb;
-    vec3 albedo = texture(u_GColor, TexCoord).rgb;
-    vec3 normal = normalize(texture(u_GNormal, TexCoord).rgb * 2.0 - 1.0);
-    vec4 material = texture(u_GMaterial, TexCoord);
+    vec3 albedo = DecodeAlbedo(texture(u_GColor, TexCoord)).rgb;
+    vec3 normal = DecodeNormal(texture(u_GNormal, TexCoord).xy);
+    GBufferMaterial material = DecodeMaterial(texture(u_GMaterial, TexCoord));
     
-    float metallic = material.r;
-    float ior = texture(u_GPosition, TexCoord).a;
-    float roughness = max(material.g, 0.04);
-    float ao = material.b;
+    float metallic = material.m_Metallic;
+    float ior = material.m_IOR;
+    float roughness = max(material.m_Roughness, 0.04);
+    float ao = material.m_AO;
     
     vec3 viewDir = normalize(camera.m_Position - worldPos);
     vec3 finalColor = directLighting;
-            vec3 indirectDiffuse = ComputeIndirectDiffuse(worldPos, normal, roughness);
+    
+    vec3 indirectDiffuse = vec3(0.0);
+    vec3 specularReflection = vec3(0.0);
+    if (u_EnableReducedGI)
+    {
+        float viewDepth = -(camera.m_ViewMatrix * vec4(worldPos, 1.0)).z;
+        UpsampleIndirect(ivec2(gl_FragCoord.xy), viewDepth, normal, indirectDiffuse, specularReflection);
+    }
+    else
+    {
+        if (u_EnableGI)
+            indirectDiffuse = ComputeIndirectDiffuse(worldPos, normal, roughness);
+        if (u_EnableReflections)
+            specularReflection = ComputeSpecularReflection(worldPos, normal, viewDir, roughness);
+    }
 
     if (u_EnableGI)
     {
@@ -354,7 +237,6 @@ void main()
     if (u_EnableReflections)
     {
         vec3 F0 = IORToF0(ior, albedo, metallic); 
-        vec3 specularReflection = ComputeSpecularReflection(worldPos, normal, viewDir, roughness); 
         float NdotV = max(dot(normal, viewDir), 0.0);
         vec3 fresnel = FresnelSchlickRoughness(NdotV, F0, roughness);   
         finalColor += specularReflection * fresnel;
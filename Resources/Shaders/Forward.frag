@@ -28,7 +28,9 @@ void main()
     vec3 N = normalize(in_Normal);
     if (material.m_Normal_TexIndex >= 0) {
         sampler2D normalSampler = sampler2D(textureHandles[material.m_Normal_TexIndex]);
-        vec3 tangentNormal = texture(normalSampler, in_TexCoord).xyz * 2.0 - 1.0;
+        vec3 tangentNormal;
+        tangentNormal.xy = texture(normalSampler, in_TexCoord).xy * 2.0 - 1.0;
+        tangentNormal.z = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
         tangentNormal.xy *= material.m_NormalScale;
 
         vec3 T = normalize(in_Tangent);
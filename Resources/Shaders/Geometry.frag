@@ -3,7 +3,7 @@
 #extension GL_NV_gpu_shader5 : enable
 #extension GL_ARB_bindless_texture : enable
 #extension GL_ARB_gpu_shader_int64 : enable
-#include "Common/Common.glsl"
+#include "Common/GBuffer.glsl"
 
 layout(location = 0) in vec3 In_WorldPos;
 layout(location = 1) in vec3 In_Normal;
@@ -14,9 +14,8 @@ layout(location = 5) flat in uint In_MaterialIndex;
 layout(location = 6) flat in uint In_MeshIndex;
 
 layout(location = 0) out vec4 Out_Color;
-layout(location = 1) out vec4 Out_Normal;
-layout(location = 2) out vec4 Out_Position;
-layout(location = 3) out vec4 Out_Material;
+layout(location = 1) out vec2 Out_Normal;
+layout(location = 2) out vec4 Out_Material;
 layout(location = 4) out vec4 Out_Emissive;
 layout(location = 5) out vec4 Out_Selection;
 
@@ -25,6 +24,17 @@ vec4 TrySampleTexture(int texIndex, vec2 uv)
     if (texIndex < 0) return vec4(1.0);
     uvec2 handleParts = unpackUint2x32(textureHandles[texIndex]);
     sampler2D tex = sampler2D(uint64_t(textureHandles[texIndex]));
+
+    // Streaming feedback from one pixel per 4x4 quad, in mips of the full chain. The y
+    // LOD is unclamped, so it still asks for levels finer than the resident one.
+    if (all(equal(uvec2(gl_FragCoord.xy) & 3u, uvec2(0u))))
+    {
+        float lod = textureQueryLod(tex, uv).y + float(textureResidency[texIndex]);
+        uint mip = uint(max(lod, 0.0));
+        if (mip < textureFeedback[texIndex])
+            atomicMin(textureFeedback[texIndex], mip);
+    }
+
     return texture(tex, uv);
 }
 
@@ -46,16 +56,21 @@ void main()
     vec3 normal = normalize(In_Normal);
     if (mat.m_Normal_TexIndex >= 0)
     {
-        vec3 mapN = TrySampleTexture(mat.m_Normal_TexIndex, In_TexCoord).xyz * 2.0 - 1.0;
+        vec3 mapN;
+        mapN.xy = TrySampleTexture(mat.m_Normal_TexIndex, In_TexCoord).xy * 2.0 - 1.0;
+        mapN.z = sqrt(max(1.0 - dot(mapN.xy, mapN.xy), 0.0)); // BC5 normal maps only store XY
         mapN.xy *= mat.m_NormalScale;
         mat3 TBN = mat3(normalize(In_Tangent), normalize(In_Bitangent), normalize(In_Normal));
         normal = normalize(TBN * mapN);
     }
 
-    Out_Color = baseColor;
-    Out_Normal = vec4(normal * 0.5 + 0.5, 1.0);
-    Out_Position = vec4(In_WorldPos,  mat.m_IOR);
-    Out_Material = vec4(mat.m_MetallicFactor, mat.m_RoughnessFactor, mat.m_IOR, 1.0);
+    float ao = 1.0;
+    if (mat.m_Occlusion_TexIndex >= 0)
+        ao = mix(1.0, TrySampleTexture(mat.m_Occlusion_TexIndex, In_TexCoord).r, mat.m_OcclusionStrength);
+
+    Out_Color = EncodeAlbedo(baseColor);
+    Out_Normal = EncodeNormal(normal);
+    Out_Material = EncodeMaterial(mat.m_MetallicFactor, mat.m_RoughnessFactor, ao, mat.m_IOR);
     Out_Emissive = vec4(emissive, 1.0);
 
     GpuStaticMesh mesh = meshes[In_MeshIndex];
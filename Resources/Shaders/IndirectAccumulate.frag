@@ -0,0 +1,83 @@
+// IndirectAccumulate.frag
+#version 460 core
+#extension GL_NV_gpu_shader5 : enable
+#extension GL_ARB_bindless_texture : require
+#extension GL_ARB_gpu_shader_int64 : enable
+#include "Common/GBuffer.glsl"
+
+in vec2 TexCoord;
+layout(location = 0) out vec4 Diffuse;
+layout(location = 1) out vec4 Specular;
+
+uniform sampler2D u_TraceDiffuse;
+uniform sampler2D u_TraceSpecular;
+uniform sampler2D u_HistoryDiffuse;
+uniform sampler2D u_HistorySpecular;
+uniform sampler2D u_DepthBuffer;
+
+uniform mat4 u_PrevViewProjection;
+uniform bool u_HistoryValid = false;
+uniform int u_Downscale = 2;
+uniform float u_DiffuseHistory = 0.9;
+uniform float u_SpecularHistory = 0.75;
+
+// Blends this frame's trace into last frame's result, reprojected with last frame's camera.
+// History is clamped to the 3x3 neighbourhood of the new trace, which covers both checkerboard
+// cone sets, and dropped when the surface under it is at a different depth.
+void main()
+{
+    ivec2 low = ivec2(gl_FragCoord.xy);
+    ivec2 lowSize = textureSize(u_TraceDiffuse, 0);
+    
+    vec4 diffuse = texelFetch(u_TraceDiffuse, low, 0);
+    vec4 specular = texelFetch(u_TraceSpecular, low, 0);
+    
+    Diffuse = diffuse;
+    Specular = specular;
+    if (!u_HistoryValid || diffuse.a <= 0.0)
+        return;
+    
+    vec3 diffuseMin = diffuse.rgb;
+    vec3 diffuseMax = diffuse.rgb;
+    vec3 specularMin = specular.rgb;
+    vec3 specularMax = specular.rgb;
+    for (int y = -1; y <= 1; y++)
+    {
+        for (int x = -1; x <= 1; x++)
+        {
+            ivec2 q = clamp(low + ivec2(x, y), ivec2(0), lowSize - 1);
+            vec4 d = texelFetch(u_TraceDiffuse, q, 0);
+            if (d.a <= 0.0)
+                continue;
+            
+            vec3 s = texelFetch(u_TraceSpecular, q, 0).rgb;
+            diffuseMin = min(diffuseMin, d.rgb);
+            diffuseMax = max(diffuseMax, d.rgb);
+            specularMin = min(specularMin, s);
+            specularMax = max(specularMax, s);
+        }
+    }
+    
+    ivec2 fullSize = textureSize(u_DepthBuffer, 0);
+    ivec2 pixel = min(low * u_Downscale + u_Downscale / 2, fullSize - 1);
+    float depth = texelFetch(u_DepthBuffer, pixel, 0).r;
+    vec3 worldPos = ReconstructWorldPosition((vec2(pixel) + 0.5) / vec2(fullSize), depth);
+    
+    vec4 prevClip = u_PrevViewProjection * vec4(worldPos, 1.0);
+    if (prevClip.w <= 0.0)
+        return;
+    
+    vec2 prevUV = prevClip.xy / prevClip.w * 0.5 + 0.5;
+    if (any(lessThan(prevUV, vec2(0.0))) || any(greaterThan(prevUV, vec2(1.0))))
+        return;
+    
+    // Clip w is view depth under the previous camera, compare it with what was stored there.
+    vec4 historyDiffuse = texture(u_HistoryDiffuse, prevUV);
+    if (historyDiffuse.a <= 0.0 || abs(historyDiffuse.a - prevClip.w) > 0.05 * prevClip.w)
+        return;
+    
+    vec3 historySpecular = texture(u_HistorySpecular, prevUV).rgb;
+    
+    Diffuse.rgb = mix(diffuse.rgb, clamp(historyDiffuse.rgb, diffuseMin, diffuseMax), u_DiffuseHistory);
+    Specular.rgb = mix(specular.rgb, clamp(historySpecular, specularMin, specularMax), u_SpecularHistory);
+}
@@ -0,0 +1,54 @@
+// IndirectTrace.frag
+#version 460 core
+#extension GL_NV_gpu_shader5 : enable
+#extension GL_ARB_bindless_texture : require
+#extension GL_ARB_gpu_shader_int64 : enable
+#include "Common/GBuffer.glsl"
+#include "Common/ConeTracing.glsl"
+
+in vec2 TexCoord;
+layout(location = 0) out vec4 Diffuse;
+layout(location = 1) out vec4 Specular;
+
+uniform sampler2D u_GNormal;
+uniform sampler2D u_GMaterial;
+uniform sampler2D u_DepthBuffer;
+
+uniform bool u_EnableGI = true;
+uniform bool u_EnableReflections = true;
+uniform int u_Downscale = 2;
+uniform uint u_FrameIndex = 0;
+
+// Runs once per scale x scale block of the G-buffer and traces from one fixed pixel in it.
+// Diffuse alpha carries that pixel's view depth for reprojection and upsampling, 0 on sky.
+void main()
+{
+    ivec2 low = ivec2(gl_FragCoord.xy);
+    ivec2 fullSize = textureSize(u_DepthBuffer, 0);
+    ivec2 pixel = min(low * u_Downscale + u_Downscale / 2, fullSize - 1);
+    
+    float depth = texelFetch(u_DepthBuffer, pixel, 0).r;
+    if (depth >= 0.9999)
+    {
+        Diffuse = vec4(0.0);
+        Specular = vec4(0.0);
+        return;
+    }
+    
+    vec2 uv = (vec2(pixel) + 0.5) / vec2(fullSize);
+    vec3 worldPos = ReconstructWorldPosition(uv, depth);
+    vec3 normal = DecodeNormal(texelFetch(u_GNormal, pixel, 0).xy);
+    GBufferMaterial material = DecodeMaterial(texelFetch(u_GMaterial, pixel, 0));
+    float roughness = max(material.m_Roughness, 0.04);
+    
+    vec3 viewDir = normalize(camera.m_Position - worldPos);
+    float viewDepth = -(camera.m_ViewMatrix * vec4(worldPos, 1.0)).z;
+    
+    int set = int((uint(low.x + low.y) + u_FrameIndex) & 1u);
+    
+    vec3 diffuse = u_EnableGI ? ComputeIndirectDiffuseCheckerboard(worldPos, normal, roughness, set) : vec3(0.0);
+    vec3 specular = u_EnableReflections ? ComputeSpecularReflection(worldPos, normal, viewDir, roughness) : vec3(0.0);
+    
+    Diffuse = vec4(diffuse, viewDepth);
+    Specular = vec4(specular, 1.0);
+}
@@ -3,19 +3,20 @@
 #extension GL_NV_gpu_shader5 : enable
 #extension GL_ARB_bindless_texture : require
 #extension GL_ARB_gpu_shader_int64 : enable
-#include "Common/Common.glsl"
+#include "Common/GBuffer.glsl"
 
 in vec2 TexCoord;
 out vec4 FragColor;
 
 uniform sampler2D u_GColor;
 uniform sampler2D u_GNormal;
-uniform sampler2D u_GPosition;
 uniform sampler2D u_GMaterial;
-uniform sampler2D u_ShadowMap;
+uniform sampler2DShadow u_ShadowMap;
+uniform sampler2DShadow u_LocalShadowAtlas;
 uniform sampler2D u_DepthBuffer;
 
 #define SHADOW_SAMPLES 16
+#define SHADOW_FILTER_TEXELS 1.5
 #define LIGHT_TYPE_DIRECTIONAL 0
 #define LIGHT_TYPE_POINT 1
 #define LIGHT_TYPE_SPOT 2
@@ -73,37 +74,118 @@ float Noise(vec2 co)
     return fract(sin(dot(co, vec2(12.9898, 78.233))) * 43758.5453);
 }
 
-float SoftShadow(vec3 worldPos, vec3 N, vec3 L, mat4 lightSpaceMatrix)
+int SelectCascade(float viewDepth)
 {
-    vec4 lightSpace = lightSpaceMatrix * vec4(worldPos, 1.0);
-    vec3 proj = lightSpace.xyz / lightSpace.w;
-    proj = proj * 0.5 + 0.5;
+    for (int c = 0; c < shadows.m_CascadeCount - 1; c++)
+    {
+        if (viewDepth < shadows.m_Splits[c])
+            return c;
+    }
+    return shadows.m_CascadeCount - 1;
+}
+
+// Cascaded shadow of the main directional light. Each cascade owns one quarter of the atlas,
+// offsets and filter radius are in shadow texels so every cascade blurs by the same amount on screen.
+float CascadeShadow(vec3 worldPos, vec3 N, vec3 L)
+{
+    if (shadows.m_CascadeCount <= 0)
+        return 0.0;
     
-    if (proj.z > 1.0 || any(lessThan(proj.xy, vec2(0.0))) || any(greaterThan(proj.xy, vec2(1.0))))
+    float viewDepth = -(camera.m_ViewMatrix * vec4(worldPos, 1.0)).z;
+    float maxDistance = shadows.m_Splits[shadows.m_CascadeCount - 1];
+    if (viewDepth >= maxDistance)
         return 0.0;
     
-    float NdotL = max(dot(N, normalize(-L)), 0.0);
-    float bias = mix(0.0005, 0.002, 1.0 - NdotL);
+    int cascade = SelectCascade(viewDepth);
+    float texelWorld = shadows.m_TexelSizes[cascade];
+    
+    float NdotL = clamp(dot(N, L), 0.0, 1.0);
+    vec3 offsetPos = worldPos + N * texelWorld * (1.0 + 1.5 * (1.0 - NdotL));
+    
+    vec4 lightSpace = shadows.m_ViewProjection[cascade] * vec4(offsetPos, 1.0);
+    vec3 proj = lightSpace.xyz / lightSpace.w * 0.5 + 0.5;
+    if (proj.z > 1.0)
+        return 0.0;
+    
+    vec2 atlasTexel = 1.0 / vec2(textureSize(u_ShadowMap, 0));
+    vec2 tileOrigin = vec2(cascade % 2, cascade / 2) * 0.5;
+    vec2 tileMin = tileOrigin + atlasTexel * 2.0;
+    vec2 tileMax = tileOrigin + 0.5 - atlasTexel * 2.0;
+    vec2 uv = tileOrigin + proj.xy * 0.5;
     
     float angle = Noise(gl_FragCoord.xy) * 6.28318;
+    float ref = proj.z - 0.0002;
     
-    float shadow = 0.0;
-    float filterSize = 0.002;
+    float lit = 0.0;
+    for (int i = 0; i < SHADOW_SAMPLES; i++)
+    {
+        vec2 offset = VogelDisk(i, angle) * SHADOW_FILTER_TEXELS * atlasTexel;
+        lit += texture(u_ShadowMap, vec3(clamp(uv + offset, tileMin, tileMax), ref));
+    }
+    
+    float shadow = 1.0 - lit / float(SHADOW_SAMPLES);
+    shadow *= 1.0 - smoothstep(maxDistance * 0.9, maxDistance, viewDepth);
+    
+    return shadow;
+}
+
+// Faces in the order PointLight builds its shadow matrices: +X, -X, +Y, -Y, +Z, -Z.
+int CubeFace(vec3 v)
+{
+    vec3 a = abs(v);
+    if (a.x >= a.y && a.x >= a.z)
+        return v.x > 0.0 ? 0 : 1;
+    if (a.y >= a.z)
+        return v.y > 0.0 ? 2 : 3;
+    return v.z > 0.0 ? 4 : 5;
+}
+
+// Point and spot light shadows from the local atlas. m_ShadowTiles holds uv offset, uv scale
+// and size in texels for each of the light's tiles.
+float LocalShadow(GpuLight light, vec3 worldPos, vec3 N)
+{
+    if (light.m_ShadowTileCount <= 0)
+        return 0.0;
     
-    for (int i = 0; i < SHADOW_SAMPLES; i++) {
-        vec2 offset = VogelDisk(i, angle) * filterSize;
-        float depth = texture(u_ShadowMap, proj.xy + offset).r;
-        shadow += (depth < proj.z - bias) ? 1.0 : 0.0;
+    vec3 toSurface = worldPos - light.m_Position;
+    int tile = 0;
+    mat4 lightMatrix = light.m_LightSpaceMatrix;
+    float tanHalfFov = tan(light.m_ConeAngles.y);
+    if (light.m_Type == LIGHT_TYPE_POINT)
+    {
+        tile = CubeFace(toSurface);
+        lightMatrix = light.m_ShadowMatrices[tile];
+        tanHalfFov = 1.0;
     }
     
-    shadow /= float(SHADOW_SAMPLES);
+    vec4 rect = light.m_ShadowTiles[tile];
+    float texelWorld = 2.0 * length(toSurface) * tanHalfFov / rect.w;
     
-    vec2 fade = smoothstep(0.0, 0.05, proj.xy) * (1.0 - smoothstep(0.95, 1.0, proj.xy));
-    shadow *= fade.x * fade.y;
+    vec3 L = normalize(-toSurface);
+    float NdotL = clamp(dot(N, L), 0.0, 1.0);
+    vec3 offsetPos = worldPos + N * texelWorld * (1.0 + 1.5 * (1.0 - NdotL));
     
-    shadow *= 1.0 - smoothstep(0.95, 1.0, proj.z);
+    vec4 lightSpace = lightMatrix * vec4(offsetPos, 1.0);
+    if (lightSpace.w <= 0.0)
+        return 0.0;
     
-    return shadow;
+    vec3 proj = lightSpace.xyz / lightSpace.w * 0.5 + 0.5;
+    if (proj.z > 1.0 || any(lessThan(proj.xy, vec2(0.0))) || any(greaterThan(proj.xy, vec2(1.0))))
+        return 0.0;
+    
+    float atlasTexel = rect.z / rect.w;
+    vec2 tileMin = rect.xy + atlasTexel;
+    vec2 tileMax = rect.xy + rect.z - atlasTexel;
+    vec2 uv = rect.xy + proj.xy * rect.z;
+    float ref = proj.z - 0.00005;
+    
+    float lit = 0.0;
+    lit += texture(u_LocalShadowAtlas, vec3(clamp(uv + vec2(-0.5, -0.5) * atlasTexel, tileMin, tileMax), ref));
+    lit += texture(u_LocalShadowAtlas, vec3(clamp(uv + vec2( 0.5, -0.5) * atlasTexel, tileMin, tileMax), ref));
+    lit += texture(u_LocalShadowAtlas, vec3(clamp(uv + vec2(-0.5,  0.5) * atlasTexel, tileMin, tileMax), ref));
+    lit += texture(u_LocalShadowAtlas, vec3(clamp(uv + vec2( 0.5,  0.5) * atlasTexel, tileMin, tileMax), ref));
+    
+    return 1.0 - lit * 0.25;
 }
 
 vec3 CalculateDirectionalLight(GpuLight light, vec3 albedo, float metallic, float roughness, vec3 N, vec3 V, vec3 worldPos, bool useShadow)
@@ -125,7 +207,7 @@ vec3 CalculateDirectionalLight(GpuLight light, vec3 albedo, float metallic, floa
     
     float shadow = 0.0;
     if (useShadow) {
-        shadow = SoftShadow(worldPos, N, light.m_Direction, light.m_LightSpaceMatrix);
+        shadow = CascadeShadow(worldPos, N, L);
     }
     
     return (kD * albedo / PI + specular) * light.m_Color * light.m_Intensity * NdotL * (1.0 - shadow);
@@ -197,24 +279,21 @@ vec3 CalculateSpotLight(GpuLight light, vec3 albedo, float metallic, float rough
 
 void main()
 {
-    vec4 albedoTex = texture(u_GColor, TexCoord);
-    vec3 normal = texture(u_GNormal, TexCoord).xyz;
-    vec3 worldPos = texture(u_GPosition, TexCoord).xyz;
-    vec4 material = texture(u_GMaterial, TexCoord);
-
     float depth = texture(u_DepthBuffer, TexCoord).r;
     
     if (depth >= 0.9999) {
         discard;
     }
     
-    vec3 N = normalize(normal * 2.0 - 1.0);
+    vec4 albedoTex = DecodeAlbedo(texture(u_GColor, TexCoord));
+    GBufferMaterial material = DecodeMaterial(texture(u_GMaterial, TexCoord));
+    vec3 worldPos = ReconstructWorldPosition(TexCoord, depth);
+    
+    vec3 N = DecodeNormal(texture(u_GNormal, TexCoord).xy);
     vec3 V = normalize(camera.m_Position - worldPos);
     
-    float metallic = material.r;
-    float roughness = material.g;
-    float ao = material.b;
-    float emissive = material.a;
+    float metallic = material.m_Metallic;
+    float roughness = material.m_Roughness;
     
     vec3 Lo = vec3(0.0);
     
@@ -238,16 +317,16 @@ void main()
         
         if (light.m_Type == LIGHT_TYPE_DIRECTIONAL)
         {
-            bool useShadow = (i == 0);
+            bool useShadow = (i == shadows.m_LightIndex);
             Lo += CalculateDirectionalLight(light, albedoTex.rgb, metallic, roughness, N, V, worldPos, useShadow);
         }
         else if (light.m_Type == LIGHT_TYPE_POINT)
         {
-            Lo += CalculatePointLight(light, albedoTex.rgb, metallic, roughness, N, V, worldPos);
+            Lo += CalculatePointLight(light, albedoTex.rgb, metallic, roughness, N, V, worldPos) * (1.0 - LocalShadow(light, worldPos, N));
         }
         else if (light.m_Type == LIGHT_TYPE_SPOT)
         {
-            Lo += CalculateSpotLight(light, albedoTex.rgb, metallic, roughness, N, V, worldPos);
+            Lo += CalculateSpotLight(light, albedoTex.rgb, metallic, roughness, N, V, worldPos) * (1.0 - LocalShadow(light, worldPos, N));
         }
     }
     
@@ -0,0 +1,30 @@
+// Upscale.frag
+#version 460 core
+
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D u_Source;
+uniform float u_Sharpness = 0.5;
+
+// Bilinear resample of the render resolution image, then a contrast adaptive sharpen over the
+// cross around it. Flat regions get the most sharpening, edges that already have contrast the least.
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(u_Source, 0));
+
+    vec3 c = texture(u_Source, TexCoord).rgb;
+    vec3 n = texture(u_Source, TexCoord + vec2(0.0, texel.y)).rgb;
+    vec3 s = texture(u_Source, TexCoord - vec2(0.0, texel.y)).rgb;
+    vec3 e = texture(u_Source, TexCoord + vec2(texel.x, 0.0)).rgb;
+    vec3 w = texture(u_Source, TexCoord - vec2(texel.x, 0.0)).rgb;
+
+    vec3 minRGB = min(c, min(min(n, s), min(e, w)));
+    vec3 maxRGB = max(c, max(max(n, s), max(e, w)));
+
+    vec3 amp = sqrt(clamp(min(minRGB, 1.0 - maxRGB) / max(maxRGB, vec3(0.0001)), 0.0, 1.0));
+    vec3 weight = -amp * 0.2 * u_Sharpness;
+
+    vec3 result = (c + (n + s + e + w) * weight) / (1.0 + 4.0 * weight);
+    FragColor = vec4(clamp(result, minRGB, maxRGB), 1.0);
+}
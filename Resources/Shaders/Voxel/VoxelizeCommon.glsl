@@ -0,0 +1,95 @@
+// VoxelizeCommon.glsl
+// Shared by the compute voxelizer and the raster path it hands large triangles to.
+
+// Running averages packed as RGBA8, the alpha byte counts contributions. Plain r32ui
+// compare-and-swap is core GL, unlike the fp16 vector atomics this replaces.
+layout(binding = 0, r32ui) coherent volatile uniform uimage3D u_AtomicRadiance;
+layout(binding = 1, r32ui) coherent volatile uniform uimage3D u_AtomicNormal;
+
+uniform ivec3 u_Resolution;
+uniform ivec3 u_GridMin;
+uniform ivec3 u_GridMax;
+uniform vec3 u_CellSize;
+
+// Bounds the spin under heavy contention, a dropped contribution costs less than a stalled wave.
+const uint VOXEL_MAX_SWAPS = 64u;
+
+uint AverageVoxelValue(uint packed, vec3 value)
+{
+    vec4 current = unpackUnorm4x8(packed);
+    float count = round(current.a * 255.0);
+    vec3 average = (current.rgb * count + value) / (count + 1.0);
+    return packUnorm4x8(vec4(average, min(count + 1.0, 255.0) / 255.0));
+}
+
+// Radiance is stored as x / (1 + x) so the 8 bit average keeps some HDR range,
+// BuildVoxels.comp decodes it.
+void AccumulateVoxel(ivec3 voxelCoord, vec3 radiance, vec3 normal)
+{
+    vec3 encodedRadiance = radiance / (1.0 + radiance);
+    vec3 encodedNormal = normal * 0.5 + 0.5;
+
+    uint expected = 0u;
+    uint desired = AverageVoxelValue(expected, encodedRadiance);
+    for (uint i = 0u; i < VOXEL_MAX_SWAPS; i++)
+    {
+        uint previous = imageAtomicCompSwap(u_AtomicRadiance, voxelCoord, expected, desired);
+        if (previous == expected)
+            break;
+
+        expected = previous;
+        desired = AverageVoxelValue(expected, encodedRadiance);
+    }
+
+    expected = 0u;
+    desired = AverageVoxelValue(expected, encodedNormal);
+    for (uint i = 0u; i < VOXEL_MAX_SWAPS; i++)
+    {
+        uint previous = imageAtomicCompSwap(u_AtomicNormal, voxelCoord, expected, desired);
+        if (previous == expected)
+            break;
+
+        expected = previous;
+        desired = AverageVoxelValue(expected, encodedNormal);
+    }
+}
+
+// uvFootprint is how much of the UV range one sample stands for, it picks the mip so
+// both paths get a filtered texel without needing derivatives.
+vec3 ShadeVoxel(uint materialIndex, vec2 texCoord, float uvFootprint, vec3 N)
+{
+    GpuMaterial material = materials[materialIndex];
+    vec3 albedo = material.m_BaseColorFactor.rgb;
+    vec3 emissive = material.m_EmissiveFactor;
+
+    if (material.m_BaseColor_TexIndex >= 0)
+    {
+        sampler2D baseColor = sampler2D(textureHandles[material.m_BaseColor_TexIndex]);
+        float lod = log2(max(uvFootprint * float(textureSize(baseColor, 0).x), 1.0));
+        albedo *= textureLod(baseColor, texCoord, lod).rgb;
+    }
+
+    if (material.m_Emissive_TexIndex >= 0)
+    {
+        sampler2D emissiveMap = sampler2D(textureHandles[material.m_Emissive_TexIndex]);
+        float lod = log2(max(uvFootprint * float(textureSize(emissiveMap, 0).x), 1.0));
+        emissive *= textureLod(emissiveMap, texCoord, lod).rgb;
+    }
+
+    vec3 baseLighting = vec3(0.02);
+
+    // Only directional lights light the voxels.
+    for (int i = 0, directional = 0; i < lights.length() && directional < 4; i++)
+    {
+        GpuLight light = lights[i];
+        if (light.m_Type != 0)
+            continue;
+
+        directional++;
+        vec3 L = -light.m_Direction;
+        float NdotL = max(dot(N, L), 0.0);
+        baseLighting += light.m_Color * light.m_Intensity * NdotL;
+    }
+
+    return emissive + albedo * baseLighting;
+}
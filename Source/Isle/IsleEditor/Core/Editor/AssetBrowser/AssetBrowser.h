@@ -41,7 +41,7 @@ namespace Isle
         std::string m_DragDropPayloadType = "ASSET_ROOT_OBJECT";
 
         int m_CurrentAssetId = -1;
-        int m_LastAssetCount = 0;
+        uint32_t m_LastAssetRevision = UINT32_MAX;
 
     public:
         virtual void Start() override;
@@ -76,7 +76,7 @@ namespace Isle
         m_RootFolder = new VFSFolder{ "Root", "/", {}, {}, nullptr };
         m_CurrentFolder = m_RootFolder;
         m_CurrentAssetId = -1;
-        m_LastAssetCount = 0;
+        m_LastAssetRevision = UINT32_MAX;
         RebuildVFS();
     }
 
@@ -114,12 +114,12 @@ namespace Isle
                     entry.type = "Material";
                     entry.vfsPath = assetPath + "/Materials/" + entry.name;
                 }
-                else if (dynamic_cast<StaticMesh*>(obj))
+                else if (Cast<StaticMesh>(obj))
                 {
                     entry.type = "Mesh";
                     entry.vfsPath = assetPath + "/Meshes/" + entry.name;
                 }
-                else if (dynamic_cast<SceneComponent*>(obj))
+                else if (Cast<SceneComponent>(obj))
                 {
                     entry.type = "Component";
                     entry.vfsPath = assetPath + "/Components/" + entry.name;
@@ -227,10 +227,10 @@ namespace Isle
             return;
         }
 
-        if (assetManager->m_Assets.size() != m_LastAssetCount)
+        if (assetManager->m_Revision != m_LastAssetRevision)
         {
             RebuildVFS();
-            m_LastAssetCount = assetManager->m_Assets.size();
+            m_LastAssetRevision = assetManager->m_Revision;
         }
 
         DrawSplitView();
@@ -674,7 +674,7 @@ namespace Isle
                     auto it = assetManager->m_Assets.find(assetId);
                     if (it != assetManager->m_Assets.end() && it->second->m_RootObject)
                     {
-                        Scene::Instance()->Add(dynamic_cast<SceneComponent*>(it->second->m_RootObject));
+                        Scene::Instance()->Add(Cast<SceneComponent>(it->second->m_RootObject), false);
                         ISLE_LOG("Added asset '%s' to scene", it->second->GetName().c_str());
                     }
                 }
@@ -322,35 +322,35 @@ namespace Isle
                 m_Light->m_CastShadows = value.boolValue;
                 break;
             case PropertyType::Direction:
-                if (auto dirLight = dynamic_cast<DirectionalLight*>(m_Light))
+                if (auto dirLight = Cast<DirectionalLight>(m_Light))
                     dirLight->m_Dir = glm::normalize(value.vec3Value);
-                else if (auto spotLight = dynamic_cast<SpotLight*>(m_Light))
+                else if (auto spotLight = Cast<SpotLight>(m_Light))
                     spotLight->m_Direction = glm::normalize(value.vec3Value);
                 break;
             case PropertyType::Position:
-                if (auto pointLight = dynamic_cast<PointLight*>(m_Light))
+                if (auto pointLight = Cast<PointLight>(m_Light))
                     pointLight->m_Position = value.vec3Value;
-                else if (auto spotLight = dynamic_cast<SpotLight*>(m_Light))
+                else if (auto spotLight = Cast<SpotLight>(m_Light))
                     spotLight->m_Position = value.vec3Value;
                 break;
             case PropertyType::Radius:
-                if (auto pointLight = dynamic_cast<PointLight*>(m_Light))
+                if (auto pointLight = Cast<PointLight>(m_Light))
                 {
                     pointLight->m_Radius = value.floatValue;
                     pointLight->UpdateMatrices();
                 }
-                else if (auto spotLight = dynamic_cast<SpotLight*>(m_Light))
+                else if (auto spotLight = Cast<SpotLight>(m_Light))
                 {
                     spotLight->m_Radius = value.floatValue;
                     spotLight->UpdateMatrices();
                 }
                 break;
             case PropertyType::InnerCone:
-                if (auto spotLight = dynamic_cast<SpotLight*>(m_Light))
+                if (auto spotLight = Cast<SpotLight>(m_Light))
                     spotLight->m_InnerCone = value.floatValue;
                 break;
             case PropertyType::OuterCone:
-                if (auto spotLight = dynamic_cast<SpotLight*>(m_Light))
+                if (auto spotLight = Cast<SpotLight>(m_Light))
                     spotLight->m_OuterCone = value.floatValue;
                 break;
             }
@@ -10,6 +10,8 @@
 #include <Core/Editor/AssetBrowser/AssetBrowser.h>
 #include <Core/Editor/CodeView/CodeView.h>
 #include <Core/Editor/TabBar/TabBar.h>
+#include <Core/Editor/ProfilerView/ProfilerView.h>
+#include <Core/Editor/MemoryView/MemoryView.h>
 
 namespace Isle
 {
@@ -101,6 +103,26 @@ namespace Isle
         m_CodeView->SetDockConstraints(codeViewDock);
         m_CodeView->Start();
 
+        m_ProfilerView = new ProfilerView();
+        DockConstraints profilerDock;
+        profilerDock.m_Side = DOCK_SIDE::FILL;
+        profilerDock.m_CanResize = false;
+        profilerDock.m_CanMove = false;
+        profilerDock.m_Showtitle = false;
+        profilerDock.m_Priority = 10;
+        m_ProfilerView->SetDockConstraints(profilerDock);
+        m_ProfilerView->Start();
+
+        m_MemoryView = new MemoryView();
+        DockConstraints memoryDock;
+        memoryDock.m_Side = DOCK_SIDE::FILL;
+        memoryDock.m_CanResize = false;
+        memoryDock.m_CanMove = false;
+        memoryDock.m_Showtitle = false;
+        memoryDock.m_Priority = 10;
+        m_MemoryView->SetDockConstraints(memoryDock);
+        m_MemoryView->Start();
+
         m_TransformWidget = new TransformWidget();
         m_TransformWidget->Start();
 
@@ -113,6 +135,8 @@ namespace Isle
         m_Components.push_back(m_AssetBrowser);
         m_Components.push_back(m_Viewport);
         m_Components.push_back(m_CodeView);
+        m_Components.push_back(m_ProfilerView);
+        m_Components.push_back(m_MemoryView);
 
         m_CurrentViewMode = ViewMode::VIEWPORT;
     }
@@ -144,10 +168,18 @@ namespace Isle
             RenderComponent(m_Viewport);
             m_TransformWidget->Update();
         }
-        else
+        else if (m_CurrentViewMode == ViewMode::CODEVIEW)
         {
             RenderComponent(m_CodeView);
         }
+        else if (m_CurrentViewMode == ViewMode::PROFILER)
+        {
+            RenderComponent(m_ProfilerView);
+        }
+        else
+        {
+            RenderComponent(m_MemoryView);
+        }
     }
 
     void Editor::Destroy()
@@ -158,6 +190,8 @@ namespace Isle
         m_Scene->Destroy();
         m_Viewport->Destroy();
         m_CodeView->Destroy();
+        m_ProfilerView->Destroy();
+        m_MemoryView->Destroy();
         m_AssetBrowser->Destroy();
         m_Commands->Destroy();
     }
@@ -17,11 +17,15 @@ namespace Isle
         class CommandHistory;
         class CodeView;
         class TabBar;
+        class ProfilerView;
+        class MemoryView;
 
         enum class ViewMode
         { 
             VIEWPORT, 
-            CODEVIEW 
+            CODEVIEW,
+            PROFILER,
+            MEMORY
         };
 
     private:
@@ -37,6 +41,8 @@ namespace Isle
         CommandHistory* m_Commands;
         CodeView* m_CodeView;
         TabBar* m_TabBar;
+        ProfilerView* m_ProfilerView;
+        MemoryView* m_MemoryView;
 
         ViewMode m_CurrentViewMode = ViewMode::VIEWPORT;
 
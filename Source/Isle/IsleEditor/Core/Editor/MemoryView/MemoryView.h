@@ -0,0 +1,190 @@
+// MemoryView.h
+#pragma once
+#include <IsleEngine.h>
+#include <Core/Common/EditorCommon.h>
+
+namespace Isle
+{
+    class Editor::MemoryView : public EditorComponent
+    {
+    private:
+        std::vector<GfxResourceInfo> m_Resources;
+        char m_Filter[128] = {};
+        int m_CategoryFilter = -1;
+
+    public:
+        virtual void Start() override;
+        virtual void Update() override;
+        virtual void Destroy() override;
+        virtual const char* GetWindowName() const override { return "Memory"; }
+
+    private:
+        void DrawCategoryTable();
+        void DrawResourceTable();
+        static const char* FormatBytes(size_t bytes, char* buffer, size_t bufferSize);
+    };
+
+    void Editor::MemoryView::Start()
+    {
+    }
+
+    void Editor::MemoryView::Update()
+    {
+        const RenderStats& stats = Render::Instance()->GetStats();
+
+        char used[32], peak[32], uploaded[32];
+        ImGui::Text("VRAM %s (peak %s) | Uploads %u, %s last frame",
+            FormatBytes(stats.VRAMUsed, used, sizeof(used)),
+            FormatBytes(stats.VRAMPeak, peak, sizeof(peak)),
+            stats.UploadsThisFrame,
+            FormatBytes(stats.UploadBytesThisFrame, uploaded, sizeof(uploaded)));
+
+        ImGui::Separator();
+        DrawCategoryTable();
+
+        ImGui::Spacing();
+        ImGui::SetNextItemWidth(250.0f);
+        ImGui::InputTextWithHint("##Filter", "Filter by label", m_Filter, sizeof(m_Filter));
+        ImGui::SameLine();
+
+        const char* preview = m_CategoryFilter < 0 ? "All"
+            : GfxResourceTracker::GetCategoryName(static_cast<GFX_RESOURCE_CATEGORY>(m_CategoryFilter));
+        ImGui::SetNextItemWidth(150.0f);
+        if (ImGui::BeginCombo("##Category", preview))
+        {
+            if (ImGui::Selectable("All", m_CategoryFilter < 0))
+                m_CategoryFilter = -1;
+
+            for (int i = 0; i < static_cast<int>(GFX_RESOURCE_CATEGORY::COUNT); i++)
+            {
+                if (ImGui::Selectable(GfxResourceTracker::GetCategoryName(static_cast<GFX_RESOURCE_CATEGORY>(i)), m_CategoryFilter == i))
+                    m_CategoryFilter = i;
+            }
+            ImGui::EndCombo();
+        }
+
+        DrawResourceTable();
+    }
+
+    void Editor::MemoryView::Destroy()
+    {
+        m_Resources.clear();
+    }
+
+    void Editor::MemoryView::DrawCategoryTable()
+    {
+        const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+        if (!ImGui::BeginTable("Categories", 5, flags))
+            return;
+
+        ImGui::TableSetupColumn("Category");
+        ImGui::TableSetupColumn("Count");
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableSetupColumn("Peak");
+        ImGui::TableSetupColumn("Uploaded (last frame)");
+        ImGui::TableHeadersRow();
+
+        char size[32], peak[32], uploaded[32];
+        for (int i = 0; i < static_cast<int>(GFX_RESOURCE_CATEGORY::COUNT); i++)
+        {
+            const GFX_RESOURCE_CATEGORY category = static_cast<GFX_RESOURCE_CATEGORY>(i);
+            const GfxCategoryStats stats = GfxResourceTracker::GetCategoryStats(category);
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(GfxResourceTracker::GetCategoryName(category));
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", stats.m_Count);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(FormatBytes(stats.m_Bytes, size, sizeof(size)));
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(FormatBytes(stats.m_PeakBytes, peak, sizeof(peak)));
+            ImGui::TableNextColumn();
+            ImGui::Text("%s (%u)", FormatBytes(stats.m_UploadBytes, uploaded, sizeof(uploaded)), stats.m_Uploads);
+        }
+
+        ImGui::EndTable();
+    }
+
+    void Editor::MemoryView::DrawResourceTable()
+    {
+        GfxResourceTracker::GetResources(m_Resources);
+
+        const std::string filter = m_Filter;
+        m_Resources.erase(std::remove_if(m_Resources.begin(), m_Resources.end(),
+            [&](const GfxResourceInfo& info)
+            {
+                if (m_CategoryFilter >= 0 && static_cast<int>(info.m_Category) != m_CategoryFilter)
+                    return true;
+                return !filter.empty() && info.m_Label.find(filter) == std::string::npos;
+            }), m_Resources.end());
+
+        const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY |
+            ImGuiTableFlags_Sortable | ImGuiTableFlags_SizingStretchProp;
+        if (!ImGui::BeginTable("Resources", 4, flags, ImGui::GetContentRegionAvail()))
+            return;
+
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Label");
+        ImGui::TableSetupColumn("Category");
+        ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("Peak", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableHeadersRow();
+
+        if (ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs())
+        {
+            if (sortSpecs->SpecsCount > 0)
+            {
+                const ImGuiTableColumnSortSpecs& spec = sortSpecs->Specs[0];
+                const bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+                std::sort(m_Resources.begin(), m_Resources.end(),
+                    [&](const GfxResourceInfo& a, const GfxResourceInfo& b)
+                    {
+                        int order = 0;
+                        switch (spec.ColumnIndex)
+                        {
+                        case 0: order = a.m_Label.compare(b.m_Label); break;
+                        case 1: order = static_cast<int>(a.m_Category) - static_cast<int>(b.m_Category); break;
+                        case 2: order = a.m_Size < b.m_Size ? -1 : (a.m_Size > b.m_Size ? 1 : 0); break;
+                        default: order = a.m_PeakSize < b.m_PeakSize ? -1 : (a.m_PeakSize > b.m_PeakSize ? 1 : 0); break;
+                        }
+                        return ascending ? order < 0 : order > 0;
+                    });
+            }
+        }
+
+        char size[32], peak[32];
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_Resources.size()));
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                const GfxResourceInfo& info = m_Resources[row];
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(info.m_Label.empty() ? "<unnamed>" : info.m_Label.c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(GfxResourceTracker::GetCategoryName(info.m_Category));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(info.m_Size, size, sizeof(size)));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(info.m_PeakSize, peak, sizeof(peak)));
+            }
+        }
+
+        ImGui::EndTable();
+    }
+
+    const char* Editor::MemoryView::FormatBytes(size_t bytes, char* buffer, size_t bufferSize)
+    {
+        if (bytes >= (size_t(1) << 20))
+            snprintf(buffer, bufferSize, "%.2f MB", bytes / (1024.0 * 1024.0));
+        else if (bytes >= (size_t(1) << 10))
+            snprintf(buffer, bufferSize, "%.1f KB", bytes / 1024.0);
+        else
+            snprintf(buffer, bufferSize, "%zu B", bytes);
+        return buffer;
+    }
+}
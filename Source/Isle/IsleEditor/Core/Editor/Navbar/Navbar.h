@@ -59,6 +59,50 @@ namespace Isle
                 }
             }
 
+            ImGui::Separator();
+
+            if (ImGui::MenuItem("Load Scene"))
+            {
+                OPENFILENAMEA ofn;
+                char szFile[260] = { 0 };
+
+                ZeroMemory(&ofn, sizeof(ofn));
+                ofn.lStructSize = sizeof(ofn);
+                ofn.hwndOwner = nullptr;
+                ofn.lpstrFile = szFile;
+                ofn.nMaxFile = sizeof(szFile);
+                ofn.lpstrFilter = "Isle Scene\0*.iscene\0All Files\0*.*\0";
+                ofn.nFilterIndex = 1;
+                ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST;
+
+                if (GetOpenFileNameA(&ofn) == TRUE)
+                {
+                    if (SceneComponent* loaded = SceneSerializer::Load(ofn.lpstrFile))
+                        Scene::Instance()->Add(loaded);
+                }
+            }
+
+            if (ImGui::MenuItem("Save Scene"))
+            {
+                OPENFILENAMEA ofn;
+                char szFile[260] = { 0 };
+
+                ZeroMemory(&ofn, sizeof(ofn));
+                ofn.lStructSize = sizeof(ofn);
+                ofn.hwndOwner = nullptr;
+                ofn.lpstrFile = szFile;
+                ofn.nMaxFile = sizeof(szFile);
+                ofn.lpstrFilter = "Isle Scene\0*.iscene\0";
+                ofn.lpstrDefExt = "iscene";
+                ofn.nFilterIndex = 1;
+                ofn.Flags = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT;
+
+                if (GetSaveFileNameA(&ofn) == TRUE)
+                {
+                    SceneSerializer::Save(ofn.lpstrFile, Scene::Instance());
+                }
+            }
+
             ImGui::EndPopup();
         }
 
@@ -0,0 +1,273 @@
+// ProfilerView.h
+#pragma once
+#include <IsleEngine.h>
+#include <Core/Common/EditorCommon.h>
+
+namespace Isle
+{
+    class Editor::ProfilerView : public EditorComponent
+    {
+    private:
+        // Absolute frame index, UINT64_MAX follows the newest frame.
+        uint64_t m_SelectedFrame = UINT64_MAX;
+        std::vector<uint32_t> m_ThreadDepths;
+        std::string m_TracePath = "ProfilerTrace.json";
+
+    public:
+        virtual void Start() override;
+        virtual void Update() override;
+        virtual void Destroy() override;
+        virtual const char* GetWindowName() const override { return "Profiler"; }
+
+    private:
+        const ProfileFrame* GetSelectedFrame();
+        void DrawToolbar(const ProfileFrame* frame);
+        void DrawFrameHistory(float height);
+        void DrawFlameGraph(const ProfileFrame& frame);
+        float DrawEventRow(const std::vector<ProfileEvent>& events, uint32_t thread, uint32_t depthCount,
+            ImVec2 origin, float width, uint64_t start, uint64_t range);
+
+        static ImU32 GetEventColor(const char* name);
+    };
+
+    void Editor::ProfilerView::Start()
+    {
+    }
+
+    void Editor::ProfilerView::Update()
+    {
+        const ProfileFrame* frame = GetSelectedFrame();
+
+        DrawToolbar(frame);
+        ImGui::Separator();
+
+        DrawFrameHistory(70.0f);
+        ImGui::Separator();
+
+        ImGui::BeginChild("FlameGraph", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+        if (frame)
+            DrawFlameGraph(*frame);
+        else
+            ImGui::TextDisabled("No frames recorded");
+        ImGui::EndChild();
+    }
+
+    void Editor::ProfilerView::Destroy()
+    {
+    }
+
+    const ProfileFrame* Editor::ProfilerView::GetSelectedFrame()
+    {
+        if (m_SelectedFrame != UINT64_MAX)
+        {
+            for (uint32_t i = 0; i < Profiler::GetFrameCount(); i++)
+            {
+                const ProfileFrame* frame = Profiler::GetFrame(i);
+                if (frame && frame->m_Index == m_SelectedFrame)
+                    return frame;
+            }
+
+            m_SelectedFrame = UINT64_MAX;
+        }
+
+        return Profiler::GetFrame(0);
+    }
+
+    void Editor::ProfilerView::DrawToolbar(const ProfileFrame* frame)
+    {
+        bool enabled = Profiler::IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled))
+            Profiler::SetEnabled(enabled);
+
+        ImGui::SameLine();
+        bool paused = Profiler::IsPaused();
+        if (ImGui::Checkbox("Pause", &paused))
+            Profiler::SetPaused(paused);
+
+        ImGui::SameLine();
+        if (ImGui::Button("Latest"))
+            m_SelectedFrame = UINT64_MAX;
+
+        ImGui::SameLine();
+        if (ImGui::Button("Export Trace"))
+        {
+            if (Profiler::ExportChromeTrace(m_TracePath))
+                ISLE_SUCCESS("Trace written to %s\n", m_TracePath.c_str());
+        }
+
+        if (frame)
+        {
+            ImGui::SameLine();
+            ImGui::Text("Frame %llu | CPU %.2f ms | GPU %s",
+                (unsigned long long)frame->m_Index, frame->GetMs(),
+                frame->m_GpuResolved ? "" : "pending");
+
+            if (frame->m_GpuResolved)
+            {
+                ImGui::SameLine(0.0f, 0.0f);
+                ImGui::Text("%.2f ms", frame->GetGpuMs());
+            }
+
+            if (frame->m_DroppedEvents > 0)
+            {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "(%u events dropped)", frame->m_DroppedEvents);
+            }
+        }
+    }
+
+    // Oldest frame on the left, click a bar to inspect that frame.
+    void Editor::ProfilerView::DrawFrameHistory(float height)
+    {
+        const uint32_t count = Profiler::GetFrameCount();
+        const float width = ImGui::GetContentRegionAvail().x;
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        ImGui::InvisibleButton("FrameHistory", ImVec2(width, height));
+        const bool hovered = ImGui::IsItemHovered();
+        const bool clicked = ImGui::IsItemClicked();
+
+        drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(25, 25, 25, 255));
+
+        if (count == 0)
+            return;
+
+        double maxMs = 1000.0 / 30.0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (const ProfileFrame* frame = Profiler::GetFrame(i))
+                maxMs = std::max(maxMs, frame->GetMs());
+        }
+
+        const float barWidth = width / Profiler::FRAME_COUNT;
+        const float mouseX = ImGui::GetIO().MousePos.x;
+
+        const float budgetY = origin.y + height - float((1000.0 / 60.0) / maxMs) * height;
+        drawList->AddLine(ImVec2(origin.x, budgetY), ImVec2(origin.x + width, budgetY), IM_COL32(90, 160, 90, 160));
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const ProfileFrame* frame = Profiler::GetFrame(i);
+            if (!frame)
+                continue;
+
+            const float x = origin.x + width - (i + 1) * barWidth;
+            const float barHeight = float(frame->GetMs() / maxMs) * height;
+            const bool selected = m_SelectedFrame == frame->m_Index ||
+                (m_SelectedFrame == UINT64_MAX && i == 0);
+            const bool underMouse = hovered && mouseX >= x && mouseX < x + barWidth;
+
+            ImU32 color = frame->GetMs() > 1000.0 / 60.0 ? IM_COL32(200, 90, 60, 255) : IM_COL32(80, 140, 200, 255);
+            if (selected || underMouse)
+                color = IM_COL32(240, 200, 80, 255);
+
+            drawList->AddRectFilled(
+                ImVec2(x, origin.y + height - barHeight),
+                ImVec2(x + std::max(barWidth - 1.0f, 1.0f), origin.y + height),
+                color);
+
+            if (underMouse)
+            {
+                ImGui::SetTooltip("Frame %llu\nCPU %.2f ms\nGPU %.2f ms",
+                    (unsigned long long)frame->m_Index, frame->GetMs(), frame->GetGpuMs());
+
+                if (clicked)
+                    m_SelectedFrame = i == 0 ? UINT64_MAX : frame->m_Index;
+            }
+        }
+    }
+
+    void Editor::ProfilerView::DrawFlameGraph(const ProfileFrame& frame)
+    {
+        uint64_t start = frame.m_Start;
+        uint64_t end = frame.m_End;
+        for (const ProfileEvent& event : frame.m_CpuEvents)
+        {
+            start = std::min(start, event.m_Start);
+            end = std::max(end, event.m_End);
+        }
+        for (const ProfileEvent& event : frame.m_GpuEvents)
+        {
+            start = std::min(start, event.m_Start);
+            end = std::max(end, event.m_End);
+        }
+
+        const uint64_t range = std::max<uint64_t>(end - start, 1);
+        const float width = ImGui::GetContentRegionAvail().x;
+
+        m_ThreadDepths.assign(Profiler::GetThreadCount(), 0);
+        for (const ProfileEvent& event : frame.m_CpuEvents)
+        {
+            if (event.m_Thread < m_ThreadDepths.size())
+                m_ThreadDepths[event.m_Thread] = std::max(m_ThreadDepths[event.m_Thread], event.m_Depth + 1);
+        }
+        for (const ProfileEvent& event : frame.m_GpuEvents)
+            m_ThreadDepths[Profiler::GPU_THREAD] = std::max(m_ThreadDepths[Profiler::GPU_THREAD], event.m_Depth + 1);
+
+        ImVec2 cursor = ImGui::GetCursorScreenPos();
+        const float startY = cursor.y;
+
+        for (uint32_t thread = 1; thread < m_ThreadDepths.size(); thread++)
+        {
+            if (m_ThreadDepths[thread] > 0)
+                cursor.y += DrawEventRow(frame.m_CpuEvents, thread, m_ThreadDepths[thread], cursor, width, start, range);
+        }
+
+        if (m_ThreadDepths[Profiler::GPU_THREAD] > 0)
+            cursor.y += DrawEventRow(frame.m_GpuEvents, Profiler::GPU_THREAD, m_ThreadDepths[Profiler::GPU_THREAD], cursor, width, start, range);
+
+        ImGui::Dummy(ImVec2(width, cursor.y - startY));
+    }
+
+    float Editor::ProfilerView::DrawEventRow(const std::vector<ProfileEvent>& events, uint32_t thread, uint32_t depthCount,
+        ImVec2 origin, float width, uint64_t start, uint64_t range)
+    {
+        const float labelHeight = ImGui::GetTextLineHeightWithSpacing();
+        const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+        const ImVec2 mouse = ImGui::GetIO().MousePos;
+        const bool windowHovered = ImGui::IsWindowHovered();
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        drawList->AddText(origin, IM_COL32(180, 180, 180, 255), Profiler::GetThreadName(thread));
+
+        const float top = origin.y + labelHeight;
+        for (const ProfileEvent& event : events)
+        {
+            if (event.m_Thread != thread)
+                continue;
+
+            const float x0 = origin.x + float(double(event.m_Start - start) / range) * width;
+            const float x1 = std::max(origin.x + float(double(event.m_End - start) / range) * width, x0 + 1.0f);
+            const float y0 = top + event.m_Depth * rowHeight;
+            const float y1 = y0 + rowHeight - 1.0f;
+
+            drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), GetEventColor(event.m_Name));
+
+            const ImVec2 textSize = ImGui::CalcTextSize(event.m_Name);
+            if (x1 - x0 > textSize.x + 6.0f)
+            {
+                drawList->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y1), true);
+                drawList->AddText(ImVec2(x0 + 3.0f, y0 + 2.0f), IM_COL32(15, 15, 15, 255), event.m_Name);
+                drawList->PopClipRect();
+            }
+
+            if (windowHovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+                ImGui::SetTooltip("%s\n%.3f ms", event.m_Name, event.GetMs());
+        }
+
+        return labelHeight + depthCount * rowHeight + 6.0f;
+    }
+
+    // Stable color per name so a scope keeps its color from frame to frame.
+    ImU32 Editor::ProfilerView::GetEventColor(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for (const char* c = name ? name : ""; *c; c++)
+            hash = (hash ^ uint8_t(*c)) * 16777619u;
+
+        float r, g, b;
+        ImGui::ColorConvertHSVtoRGB((hash % 360) / 360.0f, 0.45f, 0.9f, r, g, b);
+        return ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.0f));
+    }
+}
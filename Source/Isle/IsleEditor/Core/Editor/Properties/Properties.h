@@ -62,7 +62,7 @@ namespace Isle
             if (ImGui::InputText("Name", buffer, sizeof(buffer)))
                 component->SetName(buffer);
 
-            ImGui::Text("ID: %d", component->GetId());
+            ImGui::Text("ID: %u (generation %u)", component->GetHandle().m_Index, component->GetHandle().m_Generation);
         }
 
         if (ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen))
@@ -156,7 +156,7 @@ namespace Isle
 
     void Editor::Properties::LightProperties()
     {
-        Light* light = dynamic_cast<Light*>(Editor::Instance()->GetSelectedComponent());
+        Light* light = Cast<Light>(Editor::Instance()->GetSelectedComponent());
         if (!light)
             return;
 
@@ -221,7 +221,7 @@ namespace Isle
             ImGui::Separator();
 
             // Directional Light
-            if (auto dirLight = dynamic_cast<DirectionalLight*>(light))
+            if (auto dirLight = Cast<DirectionalLight>(light))
             {
                 if (ImGui::CollapsingHeader("Directional Light", ImGuiTreeNodeFlags_DefaultOpen))
                 {
@@ -250,7 +250,7 @@ namespace Isle
                 }
             }
             // Point Light
-            else if (auto pointLight = dynamic_cast<PointLight*>(light))
+            else if (auto pointLight = Cast<PointLight>(light))
             {
                 if (ImGui::CollapsingHeader("Point Light", ImGuiTreeNodeFlags_DefaultOpen))
                 {
@@ -303,7 +303,7 @@ namespace Isle
                 }
             }
             // Spot Light
-            else if (auto spotLight = dynamic_cast<SpotLight*>(light))
+            else if (auto spotLight = Cast<SpotLight>(light))
             {
                 if (ImGui::CollapsingHeader("Spot Light", ImGuiTreeNodeFlags_DefaultOpen))
                 {
@@ -432,7 +432,7 @@ namespace Isle
 
     void Editor::Properties::MeshProperties()
     {
-        Mesh* mesh = dynamic_cast<Mesh*>(Editor::Instance()->GetSelectedComponent());
+        Mesh* mesh = Cast<Mesh>(Editor::Instance()->GetSelectedComponent());
         if (!mesh)
             return;
 
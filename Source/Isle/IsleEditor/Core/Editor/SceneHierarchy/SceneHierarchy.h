@@ -31,14 +31,14 @@ namespace Isle
             return;
         }
 
-        auto children = runtimeScene->GetChildren();
+        auto children = runtimeScene->Children();
         if (children.empty())
         {
             ImGui::Text("Scene is empty.");
         }
         else
         {
-            for (auto& child : children)
+            for (SceneComponent* child : children)
                 DrawComponentTree(child);
         }
 
@@ -80,7 +80,7 @@ namespace Isle
         ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow |
             ImGuiTreeNodeFlags_SpanAvailWidth;
 
-        const auto& children = component->GetChildren();
+        auto children = component->Children();
         if (children.empty())
             flags |= ImGuiTreeNodeFlags_Leaf;
 
@@ -101,9 +101,9 @@ namespace Isle
 
         if (open)
         {
-            for (auto* child : children)
+            for (SceneComponent* child : children)
             {
-                if (child && child != component)
+                if (child != component)
                     DrawComponentTree(child);
             }
 
@@ -42,6 +42,22 @@ namespace Isle
                 ImGui::EndTabItem();
             }
 
+            if (ImGui::BeginTabItem("Profiler"))
+            {
+                if (editor->m_CurrentViewMode != ViewMode::PROFILER)
+                    editor->m_CurrentViewMode = ViewMode::PROFILER;
+
+                ImGui::EndTabItem();
+            }
+
+            if (ImGui::BeginTabItem("Memory"))
+            {
+                if (editor->m_CurrentViewMode != ViewMode::MEMORY)
+                    editor->m_CurrentViewMode = ViewMode::MEMORY;
+
+                ImGui::EndTabItem();
+            }
+
             ImGui::EndTabBar();
         }
 
@@ -39,6 +39,17 @@ namespace Isle
         ImVec2 viewportSize = ImGui::GetContentRegionAvail();
         ImVec2 startPos = ImGui::GetCursorScreenPos();
 
+        // Render targets follow the panel, the pipeline scales them down from there when the GPU is behind.
+        Pipeline* pipeline = Render::Instance()->GetPipeline();
+        if (pipeline && viewportSize.x >= 1.0f && viewportSize.y >= 1.0f)
+        {
+            pipeline->SetOutputSize(glm::ivec2(viewportSize.x, viewportSize.y));
+
+            MainCamera* mainCam = MainCamera::Instance();
+            if (mainCam && mainCam->GetCamera())
+                mainCam->GetCamera()->SetAspectRatio(viewportSize.x / viewportSize.y);
+        }
+
         if (m_ViewportTexture && m_ViewportTexture->m_Id != 0)
         {
             viewportSize = ImGui::GetContentRegionAvail();
@@ -93,7 +104,7 @@ namespace Isle
                         auto it = assetManager->m_Assets.find(assetId);
                         if (it != assetManager->m_Assets.end() && it->second->m_RootObject)
                         {
-                            Scene::Instance()->Add(dynamic_cast<SceneComponent*>(it->second->m_RootObject), true);
+                            Scene::Instance()->Add(Cast<SceneComponent>(it->second->m_RootObject), false);
                         }
                     }
                 }
@@ -138,6 +149,8 @@ namespace Isle
         ));
 
         const RenderStats& stats = Render::Instance()->GetStats();
+        const glm::ivec2 renderSize = pipeline ? pipeline->GetRenderSize() : glm::ivec2(0);
+        const float renderScale = pipeline ? pipeline->m_DynamicResolution.GetScale() : 0.0f;
         ImDrawList* drawList = ImGui::GetWindowDrawList();
 
         ImVec2 overlayPos = ImVec2(
@@ -148,16 +161,20 @@ namespace Isle
         char statsText[512];
         snprintf(statsText, sizeof(statsText),
             "FPS: %f\n"
+            "CPU: %.2f ms | GPU: %.2f ms\n"
             "Meshes: %u | Lights: %u\n"
             "Verts: %u | Indices: %u\n"
-            "Materials: %u | Textures: %u\n"
-            "Uploads: %u | Dirty Buffers: %u\n"
+            "Materials: %u | Textures: %u (%.1f MB)\n"
+            "Uploads: %u (%.1f KB) | Dirty Buffers: %u\n"
+            "Render: %dx%d (%.0f%%)\n"
             "VRAM: %.2f MB | Frame#: %llu",
             Engine::Instance()->m_FPS,
+            stats.RenderTimeCPU, stats.RenderTimeGPU,
             stats.MeshCount, stats.LightCount,
             stats.VertexCount, stats.IndexCount,
-            stats.MaterialCount, stats.TextureCount,
-            stats.UploadsThisFrame, stats.DirtyBufferCount,
+            stats.MaterialCount, stats.TextureCount, stats.TextureMemoryGPU / (1024.0 * 1024.0),
+            stats.UploadsThisFrame, stats.UploadBytesThisFrame / 1024.0, stats.DirtyBufferCount,
+            renderSize.x, renderSize.y, renderScale * 100.0f,
             stats.VRAMUsed / (1024.0 * 1024.0),
             stats.RenderFrameCount
         );
@@ -356,7 +373,7 @@ namespace Isle
                 {
                     if (!comp) return;
 
-                    if (StaticMesh* mesh = dynamic_cast<StaticMesh*>(comp))
+                    if (StaticMesh* mesh = Cast<StaticMesh>(comp))
                     {
                         glm::mat4 world = mesh->GetWorldMatrix();
                         glm::vec3 aabbMin = glm::vec3(world * glm::vec4(mesh->m_Bounds.m_Min, 1.0f));
@@ -391,11 +408,8 @@ namespace Isle
                         testComponent(child);
                 };
 
-            for (auto& component : Scene::Instance()->GetChildren())
-            {
-                if (!component) continue;
+            for (SceneComponent* component : Scene::Instance()->Children())
                 testComponent(component);
-            }
 
             if (bestMesh)
             {
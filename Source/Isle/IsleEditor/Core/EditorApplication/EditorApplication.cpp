@@ -6,6 +6,8 @@ namespace Isle
 {
     void EditorApplication::Start()
     {
+        Profiler::SetThreadName("Main");
+
         m_Window = new Window();
         m_Window->Start();
 
@@ -44,7 +46,7 @@ namespace Isle
 
     void EditorApplication::Update()
     {
-        if (auto mesh = dynamic_cast<Mesh*>(Editor::Instance()->GetSelectedComponent()))
+        if (auto mesh = Cast<Mesh>(Editor::Instance()->GetSelectedComponent()))
         {
             Render::Instance()->GetPipeline()->SelectMesh(mesh, true);
         }
@@ -75,13 +77,21 @@ namespace Isle
             Application::Instance()->Update();
         }
 
-        Editor::Instance()->Update();
+        {
+            ISLE_PROFILE_SCOPE("Editor");
+            Editor::Instance()->Update();
+        }
 
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            ISLE_PROFILE_GPU_SCOPE("ImGui");
+            ImGui::Render();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
 
         m_Window->SwapBuffers();
         Input::Instance()->Reset();
+
+        Profiler::EndFrame();
     }
 
     void EditorApplication::Destroy()
@@ -89,6 +99,12 @@ namespace Isle
         ShutdownGame();
         UnloadGameDLL();
 
+        Editor::Instance()->SetViewportTexture(nullptr);
+        Render::Instance()->Destroy();
+        GfxResourceTracker::ReportLeaks();
+
+        Profiler::Shutdown();
+
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
@@ -0,0 +1,433 @@
+// AnimationClip.cpp
+#include "AnimationClip.h"
+#include <emmintrin.h>
+
+namespace Isle
+{
+    namespace
+    {
+        // Longest run of frames one pair of keys may cover, keeps the reduction linear on long
+        // noisy channels.
+        constexpr uint32_t MAX_KEY_SPAN = 256;
+
+        constexpr float SQRT2 = 1.41421356f;
+
+        void QuantizeVector(const glm::vec3& value, const glm::vec3& min, const glm::vec3& extent, uint16_t* out)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                const float t = extent[c] > 0.0f ? (value[c] - min[c]) / extent[c] : 0.0f;
+                out[c] = static_cast<uint16_t>(glm::round(glm::clamp(t, 0.0f, 1.0f) * 65535.0f));
+            }
+        }
+
+        // Same arithmetic as DecodeKeys, so the reduction measures what plays back.
+        glm::vec3 DequantizeVector(const uint16_t* in, const glm::vec3& min, const glm::vec3& step)
+        {
+            return min + glm::vec3(in[0], in[1], in[2]) * step;
+        }
+
+        // The largest component is dropped and rebuilt from the unit length, the other three
+        // lie within +-1/sqrt(2) and get 15 bits each. Its index takes the spare top bits.
+        void QuantizeRotation(const glm::quat& rotation, uint16_t* out)
+        {
+            const float components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+
+            uint32_t largest = 0;
+            for (uint32_t i = 1; i < 4; i++)
+            {
+                if (glm::abs(components[i]) > glm::abs(components[largest]))
+                    largest = i;
+            }
+
+            // q and -q are the same rotation, flip so the dropped component is positive.
+            const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+            uint16_t packed[3];
+            for (uint32_t i = 0, k = 0; i < 4; i++)
+            {
+                if (i == largest)
+                    continue;
+
+                const float v = glm::clamp(components[i] * sign * SQRT2, -1.0f, 1.0f);
+                packed[k++] = static_cast<uint16_t>(glm::round((v * 0.5f + 0.5f) * 32767.0f));
+            }
+
+            out[0] = static_cast<uint16_t>(packed[0] | ((largest >> 1) << 15));
+            out[1] = static_cast<uint16_t>(packed[1] | ((largest & 1) << 15));
+            out[2] = packed[2];
+        }
+
+        glm::quat DequantizeRotation(const uint16_t* in)
+        {
+            const uint32_t largest = ((in[0] >> 15) << 1) | (in[1] >> 15);
+
+            float components[4];
+            float lengthSq = 0.0f;
+            for (uint32_t i = 0, k = 0; i < 4; i++)
+            {
+                if (i == largest)
+                    continue;
+
+                const float v = (in[k++] & 0x7FFF) * (2.0f / 32767.0f / SQRT2) - 1.0f / SQRT2;
+                components[i] = v;
+                lengthSq += v * v;
+            }
+            components[largest] = glm::sqrt(glm::max(1.0f - lengthSq, 0.0f));
+
+            return glm::quat(components[3], components[0], components[1], components[2]);
+        }
+
+        // Same blend the sampler does.
+        glm::quat Nlerp(const glm::quat& from, const glm::quat& to, float alpha)
+        {
+            const glm::quat target = glm::dot(from, to) < 0.0f ? -to : to;
+            return glm::normalize(from + (target - from) * alpha);
+        }
+
+        // Angle of the rotation between a and b. acos of the dot product can't resolve the
+        // small angles the tolerance is about in float, atan2 of the difference can.
+        float RotationError(const glm::quat& a, const glm::quat& b)
+        {
+            const glm::quat d = glm::conjugate(a) * b;
+            return 2.0f * glm::atan(glm::length(glm::vec3(d.x, d.y, d.z)), glm::abs(d.w));
+        }
+
+        float VectorError(const glm::vec3& a, const glm::vec3& b)
+        {
+            const glm::vec3 d = glm::abs(a - b);
+            return glm::max(d.x, glm::max(d.y, d.z));
+        }
+
+        // Greedy reduction: extends each span from the last kept key for as long as blending
+        // the decoded end keys stays within tolerance of every source frame in between.
+        template<typename T, typename Lerp, typename Error>
+        std::vector<uint32_t> ReduceKeys(const std::vector<T>& source, const std::vector<T>& decoded, float tolerance, Lerp lerp, Error error)
+        {
+            const uint32_t count = static_cast<uint32_t>(source.size());
+            std::vector<uint32_t> keys = { 0 };
+
+            bool constant = true;
+            for (uint32_t f = 1; f < count && constant; f++)
+                constant = error(decoded[0], source[f]) <= tolerance;
+
+            if (constant)
+                return keys;
+
+            uint32_t start = 0;
+            for (uint32_t end = 2; end < count; end++)
+            {
+                bool fits = end - start <= MAX_KEY_SPAN;
+                for (uint32_t f = start + 1; f < end && fits; f++)
+                {
+                    const float alpha = static_cast<float>(f - start) / static_cast<float>(end - start);
+                    fits = error(lerp(decoded[start], decoded[end], alpha), source[f]) <= tolerance;
+                }
+
+                if (!fits)
+                {
+                    start = end - 1;
+                    keys.push_back(start);
+                }
+            }
+
+            keys.push_back(count - 1);
+            return keys;
+        }
+
+        template<typename T>
+        std::vector<T> Densify(const std::vector<T>& values, uint32_t frameCount)
+        {
+            std::vector<T> dense(frameCount);
+            for (uint32_t f = 0; f < frameCount; f++)
+                dense[f] = values[glm::min<size_t>(f, values.size() - 1)];
+            return dense;
+        }
+
+        __m128 Select(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+    }
+
+    void AnimationClip::Build(const std::vector<AnimationTrackSource>& tracks, const AnimationCompression& settings)
+    {
+        m_SampleRate = glm::max(settings.m_SampleRate, 1.0f);
+        m_TrackCount = static_cast<uint32_t>(tracks.size());
+        m_TrackStride = (glm::max(m_TrackCount, 1u) + AnimationPose::LANES - 1) & ~(AnimationPose::LANES - 1);
+        m_SourceSize = 0;
+
+        m_Channels.assign(static_cast<size_t>(m_TrackCount) * CHANNEL_COUNT, Channel());
+        m_Ranges.assign(static_cast<size_t>(m_TrackStride) * 12, 0.0f);
+        m_KeyFrames.clear();
+        m_KeyValues.clear();
+        m_StaticChannels.clear();
+
+        size_t frameCount = 0;
+        for (const AnimationTrackSource& track : tracks)
+            frameCount = glm::max(frameCount, glm::max(track.m_Translations.size(), glm::max(track.m_Rotations.size(), track.m_Scales.size())));
+
+        m_FrameCount = static_cast<uint32_t>(glm::min<size_t>(frameCount, MAX_FRAMES));
+
+        for (uint32_t t = 0; t < m_TrackCount; t++)
+        {
+            BuildVectorChannel(t, CHANNEL_TRANSLATION, tracks[t].m_Translations, settings.m_TranslationError);
+            BuildRotationChannel(t, tracks[t].m_Rotations, settings.m_RotationError);
+            BuildVectorChannel(t, CHANNEL_SCALE, tracks[t].m_Scales, settings.m_ScaleError);
+
+            for (uint32_t c = 0; c < CHANNEL_COUNT; c++)
+            {
+                if (m_Channels[t * CHANNEL_COUNT + c].m_KeyCount == 0)
+                    m_StaticChannels.push_back(t * CHANNEL_COUNT + c);
+            }
+        }
+
+        m_KeyFrames.shrink_to_fit();
+        m_KeyValues.shrink_to_fit();
+    }
+
+    void AnimationClip::BuildVectorChannel(uint32_t track, CHANNEL channel, const std::vector<glm::vec3>& values, float tolerance)
+    {
+        if (values.empty() || m_FrameCount == 0)
+            return;
+
+        m_SourceSize += glm::min<size_t>(values.size(), m_FrameCount) * sizeof(glm::vec3);
+
+        const std::vector<glm::vec3> source = Densify(values, m_FrameCount);
+
+        glm::vec3 min = source[0];
+        glm::vec3 max = source[0];
+        for (const glm::vec3& value : source)
+        {
+            min = glm::min(min, value);
+            max = glm::max(max, value);
+        }
+
+        const glm::vec3 extent = max - min;
+        const glm::vec3 step = extent / 65535.0f;
+        for (int c = 0; c < 3; c++)
+        {
+            GetRange(channel, c)[track] = min[c];
+            GetRange(channel, 3 + c)[track] = step[c];
+        }
+
+        std::vector<uint16_t> quantized(source.size() * 3);
+        std::vector<glm::vec3> decoded(source.size());
+        for (size_t f = 0; f < source.size(); f++)
+        {
+            QuantizeVector(source[f], min, extent, &quantized[f * 3]);
+            decoded[f] = DequantizeVector(&quantized[f * 3], min, step);
+        }
+
+        AddKeys(track, channel, ReduceKeys(source, decoded, tolerance,
+            [](const glm::vec3& a, const glm::vec3& b, float alpha) { return glm::mix(a, b, alpha); }, VectorError), quantized);
+    }
+
+    void AnimationClip::BuildRotationChannel(uint32_t track, const std::vector<glm::quat>& values, float tolerance)
+    {
+        if (values.empty() || m_FrameCount == 0)
+            return;
+
+        m_SourceSize += glm::min<size_t>(values.size(), m_FrameCount) * sizeof(glm::quat);
+
+        std::vector<glm::quat> source = Densify(values, m_FrameCount);
+        for (glm::quat& rotation : source)
+            rotation = glm::normalize(rotation);
+
+        std::vector<uint16_t> quantized(source.size() * 3);
+        std::vector<glm::quat> decoded(source.size());
+        for (size_t f = 0; f < source.size(); f++)
+        {
+            QuantizeRotation(source[f], &quantized[f * 3]);
+            decoded[f] = DequantizeRotation(&quantized[f * 3]);
+        }
+
+        AddKeys(track, CHANNEL_ROTATION, ReduceKeys(source, decoded, tolerance, Nlerp, RotationError), quantized);
+    }
+
+    void AnimationClip::AddKeys(uint32_t track, CHANNEL channel, const std::vector<uint32_t>& keys, const std::vector<uint16_t>& quantized)
+    {
+        Channel& target = m_Channels[track * CHANNEL_COUNT + channel];
+        target.m_FirstKey = static_cast<uint32_t>(m_KeyFrames.size());
+        target.m_KeyCount = static_cast<uint32_t>(keys.size());
+
+        for (uint32_t key : keys)
+        {
+            m_KeyFrames.push_back(static_cast<uint16_t>(key));
+            m_KeyValues.insert(m_KeyValues.end(), quantized.begin() + key * 3, quantized.begin() + key * 3 + 3);
+        }
+    }
+
+    void AnimationClip::SampleKeys(float time, const Transform* restPose, AnimationKeys& out, uint16_t* cursors) const
+    {
+        const uint32_t jointCount = out.m_From.GetCount();
+        const uint32_t trackCount = glm::min(jointCount, m_TrackCount);
+        const float frame = m_FrameCount > 1 ? glm::clamp(time * m_SampleRate, 0.0f, static_cast<float>(m_FrameCount - 1)) : 0.0f;
+
+        // Only the search and the copy of the quantized shorts are per joint, DecodeKeys does
+        // the rest four joints at a time.
+        for (uint32_t c = 0; c < CHANNEL_COUNT; c++)
+        {
+            float* alpha = out.GetAlpha(c);
+            uint16_t* from[3] = { out.GetQuantized(0, c * 3), out.GetQuantized(0, c * 3 + 1), out.GetQuantized(0, c * 3 + 2) };
+            uint16_t* to[3] = { out.GetQuantized(1, c * 3), out.GetQuantized(1, c * 3 + 1), out.GetQuantized(1, c * 3 + 2) };
+
+            for (uint32_t j = 0; j < trackCount; j++)
+            {
+                const Channel& channel = m_Channels[j * CHANNEL_COUNT + c];
+                if (channel.m_KeyCount == 0)
+                {
+                    alpha[j] = 0.0f;
+                    continue;
+                }
+
+                const uint16_t* keyFrames = m_KeyFrames.data() + channel.m_FirstKey;
+                const uint32_t keyCount = channel.m_KeyCount;
+
+                // The last key at or before frame.
+                auto holds = [&](uint32_t k)
+                    {
+                        return k < keyCount && keyFrames[k] <= frame && (k + 1 == keyCount || frame < keyFrames[k + 1]);
+                    };
+
+                uint32_t key = cursors ? cursors[j * CHANNEL_COUNT + c] : 0;
+                if (!cursors || !holds(key))
+                {
+                    if (cursors && holds(key + 1))
+                        key++;
+                    else
+                    {
+                        const uint16_t* it = std::upper_bound(keyFrames, keyFrames + keyCount, frame,
+                            [](float value, uint16_t k) { return value < static_cast<float>(k); });
+                        key = it == keyFrames ? 0 : static_cast<uint32_t>(it - keyFrames - 1);
+                    }
+
+                    if (cursors)
+                        cursors[j * CHANNEL_COUNT + c] = static_cast<uint16_t>(key);
+                }
+
+                const uint32_t next = glm::min(key + 1, keyCount - 1);
+
+                const float fromFrame = keyFrames[key];
+                const float toFrame = keyFrames[next];
+                alpha[j] = toFrame > fromFrame ? (frame - fromFrame) / (toFrame - fromFrame) : 0.0f;
+
+                const uint16_t* fromValue = &m_KeyValues[(static_cast<size_t>(channel.m_FirstKey) + key) * 3];
+                const uint16_t* toValue = &m_KeyValues[(static_cast<size_t>(channel.m_FirstKey) + next) * 3];
+                for (int k = 0; k < 3; k++)
+                {
+                    from[k][j] = fromValue[k];
+                    to[k][j] = toValue[k];
+                }
+            }
+        }
+
+        DecodeKeys(trackCount, out);
+
+        const Transform identity;
+        for (uint32_t index : m_StaticChannels)
+        {
+            const uint32_t joint = index / CHANNEL_COUNT;
+            if (joint >= trackCount)
+                break;
+
+            const Transform& rest = restPose ? restPose[joint] : identity;
+            for (AnimationPose* pose : { &out.m_From, &out.m_To })
+            {
+                switch (index % CHANNEL_COUNT)
+                {
+                case CHANNEL_TRANSLATION:
+                    pose->GetStream(ANIMATION_STREAM_TX)[joint] = rest.m_Translation.x;
+                    pose->GetStream(ANIMATION_STREAM_TY)[joint] = rest.m_Translation.y;
+                    pose->GetStream(ANIMATION_STREAM_TZ)[joint] = rest.m_Translation.z;
+                    break;
+                case CHANNEL_ROTATION:
+                    pose->GetStream(ANIMATION_STREAM_RX)[joint] = rest.m_Rotation.x;
+                    pose->GetStream(ANIMATION_STREAM_RY)[joint] = rest.m_Rotation.y;
+                    pose->GetStream(ANIMATION_STREAM_RZ)[joint] = rest.m_Rotation.z;
+                    pose->GetStream(ANIMATION_STREAM_RW)[joint] = rest.m_Rotation.w;
+                    break;
+                case CHANNEL_SCALE:
+                    pose->GetStream(ANIMATION_STREAM_SX)[joint] = rest.m_Scale.x;
+                    pose->GetStream(ANIMATION_STREAM_SY)[joint] = rest.m_Scale.y;
+                    pose->GetStream(ANIMATION_STREAM_SZ)[joint] = rest.m_Scale.z;
+                    break;
+                }
+            }
+        }
+
+        for (uint32_t j = trackCount; j < jointCount; j++)
+        {
+            const Transform& rest = restPose ? restPose[j] : identity;
+            out.m_From.Set(j, rest);
+            out.m_To.Set(j, rest);
+
+            for (uint32_t c = 0; c < CHANNEL_COUNT; c++)
+                out.GetAlpha(c)[j] = 0.0f;
+        }
+    }
+
+    void AnimationClip::DecodeKeys(uint32_t count, AnimationKeys& keys) const
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i valueMask = _mm_set1_epi32(0x7FFF);
+        const __m128 rotationScale = _mm_set1_ps(2.0f / 32767.0f / SQRT2);
+        const __m128 rotationBias = _mm_set1_ps(-1.0f / SQRT2);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        for (uint32_t side = 0; side < 2; side++)
+        {
+            AnimationPose& pose = side == 0 ? keys.m_From : keys.m_To;
+
+            for (uint32_t j = 0; j < count; j += AnimationPose::LANES)
+            {
+                auto load = [&](uint32_t stream)
+                    {
+                        const __m128i shorts = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(keys.GetQuantized(side, stream) + j));
+                        return _mm_unpacklo_epi16(shorts, zero);
+                    };
+
+                for (CHANNEL channel : { CHANNEL_TRANSLATION, CHANNEL_SCALE })
+                {
+                    const uint32_t firstStream = channel == CHANNEL_TRANSLATION ? ANIMATION_STREAM_TX : ANIMATION_STREAM_SX;
+                    for (uint32_t c = 0; c < 3; c++)
+                    {
+                        const __m128 min = _mm_loadu_ps(GetRange(channel, c) + j);
+                        const __m128 step = _mm_loadu_ps(GetRange(channel, 3 + c) + j);
+                        const __m128 value = _mm_add_ps(min, _mm_mul_ps(_mm_cvtepi32_ps(load(channel * 3 + c)), step));
+                        _mm_storeu_ps(pose.GetStream(firstStream + c) + j, value);
+                    }
+                }
+
+                const __m128i packed[3] = { load(3), load(4), load(5) };
+                const __m128i largest = _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(packed[0], 15), 1), _mm_srli_epi32(packed[1], 15));
+
+                __m128 v[3];
+                for (int k = 0; k < 3; k++)
+                    v[k] = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(packed[k], valueMask)), rotationScale), rotationBias);
+
+                __m128 lengthSq = _mm_mul_ps(v[0], v[0]);
+                lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(v[1], v[1]));
+                lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(v[2], v[2]));
+                const __m128 dropped = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(one, lengthSq), _mm_setzero_ps()));
+
+                // The three stored components fill the slots around the dropped one in order.
+                const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(0)));
+                const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(1)));
+                const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(2)));
+                const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(3)));
+
+                _mm_storeu_ps(pose.GetStream(ANIMATION_STREAM_RX) + j, Select(is0, dropped, v[0]));
+                _mm_storeu_ps(pose.GetStream(ANIMATION_STREAM_RY) + j, Select(is1, dropped, Select(is0, v[0], v[1])));
+                _mm_storeu_ps(pose.GetStream(ANIMATION_STREAM_RZ) + j, Select(is2, dropped, Select(is3, v[2], v[1])));
+                _mm_storeu_ps(pose.GetStream(ANIMATION_STREAM_RW) + j, Select(is3, dropped, v[2]));
+            }
+        }
+    }
+
+    size_t AnimationClip::GetCompressedSize() const
+    {
+        return m_Channels.size() * sizeof(Channel) + m_KeyFrames.size() * sizeof(uint16_t) + m_KeyValues.size() * sizeof(uint16_t) +
+            m_Ranges.size() * sizeof(float) + m_StaticChannels.size() * sizeof(uint32_t);
+    }
+}
@@ -0,0 +1,105 @@
+// AnimationClip.h
+#pragma once
+#include <Core/Common/Common.h>
+#include "AnimationPose.h"
+
+namespace Isle
+{
+    struct AnimationCompression
+    {
+        // Frames per second the source tracks are sampled at.
+        float m_SampleRate = 30.0f;
+
+        // How far a dropped frame may end up from its source value. Rotations in radians.
+        float m_TranslationError = 1e-4f;
+        float m_RotationError = 1e-4f;
+        float m_ScaleError = 1e-4f;
+    };
+
+    // Uncompressed input for one joint, one value per frame. An empty channel is not animated
+    // and keeps the joint's rest pose.
+    struct AnimationTrackSource
+    {
+        std::vector<glm::vec3> m_Translations;
+        std::vector<glm::quat> m_Rotations;
+        std::vector<glm::vec3> m_Scales;
+    };
+
+    // Joint animation kept compressed in memory and sampled straight from there. Each channel
+    // keeps only the frames linear interpolation can't rebuild within the error tolerance,
+    // translation and scale as 16 bits per component over the channel's range, rotations as
+    // the smallest three components in 48 bits.
+    class ISLEENGINE_API AnimationClip : public Object
+    {
+        ISLE_TYPE(AnimationClip, Object)
+
+    public:
+        static constexpr uint32_t MAX_FRAMES = 0xFFFF;
+
+    private:
+        enum CHANNEL : uint32_t
+        {
+            CHANNEL_TRANSLATION,
+            CHANNEL_ROTATION,
+            CHANNEL_SCALE,
+            CHANNEL_COUNT
+        };
+
+        struct Channel
+        {
+            uint32_t m_FirstKey = 0;
+            uint32_t m_KeyCount = 0;
+        };
+
+        float m_SampleRate = 30.0f;
+        uint32_t m_FrameCount = 0;
+        uint32_t m_TrackCount = 0;
+        uint32_t m_TrackStride = 0;
+        size_t m_SourceSize = 0;
+
+        // CHANNEL_COUNT per track.
+        std::vector<Channel> m_Channels;
+
+        // Frame of every kept key, and three quantized shorts holding its value.
+        std::vector<uint16_t> m_KeyFrames;
+        std::vector<uint16_t> m_KeyValues;
+
+        // Dequantization range of the translation and scale channels, minimum then step per
+        // component, one stream of m_TrackStride floats each so decoding reads four tracks at once.
+        std::vector<float> m_Ranges;
+
+        // Channels without keys, track * CHANNEL_COUNT + channel. They sample the rest pose.
+        std::vector<uint32_t> m_StaticChannels;
+
+    public:
+        // Channels longer than MAX_FRAMES are cut, shorter ones hold their last value.
+        void Build(const std::vector<AnimationTrackSource>& tracks, const AnimationCompression& settings = AnimationCompression());
+
+        // Finds the keys around time for every joint of out. Joints past the clip's tracks, and
+        // channels the clip doesn't animate, take restPose. cursors, if given, holds
+        // GetCursorCount() key indices kept between calls, playback moving forward from the
+        // last sample then skips the search.
+        void SampleKeys(float time, const Transform* restPose, AnimationKeys& out, uint16_t* cursors = nullptr) const;
+        uint32_t GetCursorCount() const { return m_TrackCount * CHANNEL_COUNT; }
+
+        uint32_t GetTrackCount() const { return m_TrackCount; }
+        uint32_t GetFrameCount() const { return m_FrameCount; }
+        float GetSampleRate() const { return m_SampleRate; }
+        float GetDuration() const { return m_FrameCount > 1 ? (m_FrameCount - 1) / m_SampleRate : 0.0f; }
+
+        size_t GetKeyCount() const { return m_KeyFrames.size(); }
+        size_t GetCompressedSize() const;
+        size_t GetSourceSize() const { return m_SourceSize; }
+
+    private:
+        void BuildVectorChannel(uint32_t track, CHANNEL channel, const std::vector<glm::vec3>& values, float tolerance);
+        void BuildRotationChannel(uint32_t track, const std::vector<glm::quat>& values, float tolerance);
+        void AddKeys(uint32_t track, CHANNEL channel, const std::vector<uint32_t>& keys, const std::vector<uint16_t>& quantized);
+
+        float* GetRange(CHANNEL channel, uint32_t stream) { return m_Ranges.data() + ((channel == CHANNEL_SCALE ? 6 : 0) + stream) * m_TrackStride; }
+        const float* GetRange(CHANNEL channel, uint32_t stream) const { return m_Ranges.data() + ((channel == CHANNEL_SCALE ? 6 : 0) + stream) * m_TrackStride; }
+
+        // Dequantizes the gathered keys of the first count joints into the keys' poses.
+        void DecodeKeys(uint32_t count, AnimationKeys& keys) const;
+    };
+}
@@ -0,0 +1,204 @@
+// AnimationPose.cpp
+#include "AnimationPose.h"
+#include <emmintrin.h>
+
+namespace Isle
+{
+    namespace
+    {
+        constexpr uint32_t CHANNEL_FIRST_STREAM[3] = { ANIMATION_STREAM_TX, ANIMATION_STREAM_RX, ANIMATION_STREAM_SX };
+
+        uint32_t PaddedCount(uint32_t count)
+        {
+            return (count + AnimationPose::LANES - 1) & ~(AnimationPose::LANES - 1);
+        }
+
+        __m128 Lerp(__m128 from, __m128 to, __m128 alpha)
+        {
+            return _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), alpha));
+        }
+
+        // Sign bit of dot(a, b) in every lane, xor it in to move b onto a's hemisphere.
+        __m128 HemisphereSign(const __m128* a, const __m128* b)
+        {
+            __m128 dot = _mm_mul_ps(a[0], b[0]);
+            dot = _mm_add_ps(dot, _mm_mul_ps(a[1], b[1]));
+            dot = _mm_add_ps(dot, _mm_mul_ps(a[2], b[2]));
+            dot = _mm_add_ps(dot, _mm_mul_ps(a[3], b[3]));
+            return _mm_and_ps(dot, _mm_set1_ps(-0.0f));
+        }
+
+        void NormalizeQuat(__m128* q)
+        {
+            __m128 lengthSq = _mm_mul_ps(q[0], q[0]);
+            lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(q[1], q[1]));
+            lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(q[2], q[2]));
+            lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(q[3], q[3]));
+
+            const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSq, _mm_set1_ps(1e-12f))));
+            for (int c = 0; c < 4; c++)
+                q[c] = _mm_mul_ps(q[c], inv);
+        }
+    }
+
+    void AnimationPose::Resize(uint32_t count)
+    {
+        if (count == m_Count && !m_Data.empty())
+            return;
+
+        m_Count = count;
+        m_Stride = PaddedCount(glm::max(count, 1u));
+        m_Data.resize(static_cast<size_t>(m_Stride) * ANIMATION_STREAM_COUNT);
+
+        const Transform identity;
+        for (uint32_t j = 0; j < m_Stride; j++)
+            Set(j, identity);
+    }
+
+    void AnimationPose::Set(uint32_t joint, const Transform& transform)
+    {
+        float* data = m_Data.data() + joint;
+        data[ANIMATION_STREAM_TX * m_Stride] = transform.m_Translation.x;
+        data[ANIMATION_STREAM_TY * m_Stride] = transform.m_Translation.y;
+        data[ANIMATION_STREAM_TZ * m_Stride] = transform.m_Translation.z;
+        data[ANIMATION_STREAM_RX * m_Stride] = transform.m_Rotation.x;
+        data[ANIMATION_STREAM_RY * m_Stride] = transform.m_Rotation.y;
+        data[ANIMATION_STREAM_RZ * m_Stride] = transform.m_Rotation.z;
+        data[ANIMATION_STREAM_RW * m_Stride] = transform.m_Rotation.w;
+        data[ANIMATION_STREAM_SX * m_Stride] = transform.m_Scale.x;
+        data[ANIMATION_STREAM_SY * m_Stride] = transform.m_Scale.y;
+        data[ANIMATION_STREAM_SZ * m_Stride] = transform.m_Scale.z;
+    }
+
+    Transform AnimationPose::Get(uint32_t joint) const
+    {
+        const float* data = m_Data.data() + joint;
+
+        Transform transform;
+        transform.m_Translation = glm::vec3(data[ANIMATION_STREAM_TX * m_Stride], data[ANIMATION_STREAM_TY * m_Stride], data[ANIMATION_STREAM_TZ * m_Stride]);
+        transform.m_Rotation = glm::quat(data[ANIMATION_STREAM_RW * m_Stride], data[ANIMATION_STREAM_RX * m_Stride],
+            data[ANIMATION_STREAM_RY * m_Stride], data[ANIMATION_STREAM_RZ * m_Stride]);
+        transform.m_Scale = glm::vec3(data[ANIMATION_STREAM_SX * m_Stride], data[ANIMATION_STREAM_SY * m_Stride], data[ANIMATION_STREAM_SZ * m_Stride]);
+        return transform;
+    }
+
+    void AnimationPose::Clear()
+    {
+        std::fill(m_Data.begin(), m_Data.end(), 0.0f);
+    }
+
+    void AnimationPose::Interpolate(const AnimationKeys& keys, AnimationPose& out)
+    {
+        out.Resize(keys.m_From.m_Count);
+
+        const uint32_t stride = out.m_Stride;
+        const float* from = keys.m_From.m_Data.data();
+        const float* to = keys.m_To.m_Data.data();
+        float* result = out.m_Data.data();
+
+        for (uint32_t j = 0; j < stride; j += LANES)
+        {
+            // Translation and scale are plain lerps.
+            for (uint32_t channel = 0; channel < 3; channel += 2)
+            {
+                const __m128 alpha = _mm_loadu_ps(keys.GetAlpha(channel) + j);
+                for (uint32_t s = CHANNEL_FIRST_STREAM[channel]; s < CHANNEL_FIRST_STREAM[channel] + 3; s++)
+                {
+                    const size_t offset = static_cast<size_t>(s) * stride + j;
+                    _mm_storeu_ps(result + offset, Lerp(_mm_loadu_ps(from + offset), _mm_loadu_ps(to + offset), alpha));
+                }
+            }
+
+            __m128 qFrom[4];
+            __m128 qTo[4];
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                const size_t offset = static_cast<size_t>(ANIMATION_STREAM_RX + c) * stride + j;
+                qFrom[c] = _mm_loadu_ps(from + offset);
+                qTo[c] = _mm_loadu_ps(to + offset);
+            }
+
+            const __m128 sign = HemisphereSign(qFrom, qTo);
+            const __m128 alpha = _mm_loadu_ps(keys.GetAlpha(1) + j);
+
+            __m128 q[4];
+            for (uint32_t c = 0; c < 4; c++)
+                q[c] = Lerp(qFrom[c], _mm_xor_ps(qTo[c], sign), alpha);
+
+            NormalizeQuat(q);
+            for (uint32_t c = 0; c < 4; c++)
+                _mm_storeu_ps(result + static_cast<size_t>(ANIMATION_STREAM_RX + c) * stride + j, q[c]);
+        }
+    }
+
+    void AnimationPose::Accumulate(const AnimationPose& pose, float weight)
+    {
+        const __m128 w = _mm_set1_ps(weight);
+        const float* source = pose.m_Data.data();
+        float* accum = m_Data.data();
+
+        for (uint32_t j = 0; j < m_Stride; j += LANES)
+        {
+            for (uint32_t s = ANIMATION_STREAM_TX; s <= ANIMATION_STREAM_TZ; s++)
+            {
+                const size_t offset = static_cast<size_t>(s) * m_Stride + j;
+                _mm_storeu_ps(accum + offset, _mm_add_ps(_mm_loadu_ps(accum + offset), _mm_mul_ps(_mm_loadu_ps(source + offset), w)));
+            }
+
+            for (uint32_t s = ANIMATION_STREAM_SX; s <= ANIMATION_STREAM_SZ; s++)
+            {
+                const size_t offset = static_cast<size_t>(s) * m_Stride + j;
+                _mm_storeu_ps(accum + offset, _mm_add_ps(_mm_loadu_ps(accum + offset), _mm_mul_ps(_mm_loadu_ps(source + offset), w)));
+            }
+
+            __m128 qAccum[4];
+            __m128 qPose[4];
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                const size_t offset = static_cast<size_t>(ANIMATION_STREAM_RX + c) * m_Stride + j;
+                qAccum[c] = _mm_loadu_ps(accum + offset);
+                qPose[c] = _mm_loadu_ps(source + offset);
+            }
+
+            const __m128 sign = HemisphereSign(qAccum, qPose);
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                const size_t offset = static_cast<size_t>(ANIMATION_STREAM_RX + c) * m_Stride + j;
+                _mm_storeu_ps(accum + offset, _mm_add_ps(qAccum[c], _mm_mul_ps(_mm_xor_ps(qPose[c], sign), w)));
+            }
+        }
+    }
+
+    void AnimationPose::Normalize(float totalWeight)
+    {
+        const __m128 inv = _mm_set1_ps(totalWeight > 0.0f ? 1.0f / totalWeight : 0.0f);
+        float* data = m_Data.data();
+
+        for (uint32_t j = 0; j < m_Stride; j += LANES)
+        {
+            for (uint32_t s : { ANIMATION_STREAM_TX, ANIMATION_STREAM_TY, ANIMATION_STREAM_TZ, ANIMATION_STREAM_SX, ANIMATION_STREAM_SY, ANIMATION_STREAM_SZ })
+            {
+                const size_t offset = static_cast<size_t>(s) * m_Stride + j;
+                _mm_storeu_ps(data + offset, _mm_mul_ps(_mm_loadu_ps(data + offset), inv));
+            }
+
+            __m128 q[4];
+            for (uint32_t c = 0; c < 4; c++)
+                q[c] = _mm_loadu_ps(data + static_cast<size_t>(ANIMATION_STREAM_RX + c) * m_Stride + j);
+
+            NormalizeQuat(q);
+            for (uint32_t c = 0; c < 4; c++)
+                _mm_storeu_ps(data + static_cast<size_t>(ANIMATION_STREAM_RX + c) * m_Stride + j, q[c]);
+        }
+    }
+
+    void AnimationKeys::Resize(uint32_t count)
+    {
+        m_From.Resize(count);
+        m_To.Resize(count);
+
+        m_Stride = PaddedCount(glm::max(count, 1u));
+        m_Alpha.resize(static_cast<size_t>(m_Stride) * 3, 0.0f);
+        m_Quantized.resize(static_cast<size_t>(m_Stride) * QUANTIZED_STREAMS * 2, 0);
+    }
+}
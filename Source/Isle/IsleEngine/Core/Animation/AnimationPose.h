@@ -0,0 +1,85 @@
+// AnimationPose.h
+#pragma once
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    // One float stream per transform component, joints run along each stream.
+    enum ANIMATION_STREAM : uint32_t
+    {
+        ANIMATION_STREAM_TX,
+        ANIMATION_STREAM_TY,
+        ANIMATION_STREAM_TZ,
+        ANIMATION_STREAM_RX,
+        ANIMATION_STREAM_RY,
+        ANIMATION_STREAM_RZ,
+        ANIMATION_STREAM_RW,
+        ANIMATION_STREAM_SX,
+        ANIMATION_STREAM_SY,
+        ANIMATION_STREAM_SZ,
+        ANIMATION_STREAM_COUNT
+    };
+
+    struct AnimationKeys;
+
+    // Local transforms of a skeleton in SoA layout, so four joints go through every SIMD
+    // operation at once. Streams are padded to a multiple of four, the padding holds identity.
+    class ISLEENGINE_API AnimationPose
+    {
+    public:
+        static constexpr uint32_t LANES = 4;
+
+    private:
+        std::vector<float> m_Data;
+        uint32_t m_Count = 0;
+        uint32_t m_Stride = 0;
+
+    public:
+        // Keeps the storage when shrinking, so a warmed up pose never allocates again.
+        void Resize(uint32_t count);
+        uint32_t GetCount() const { return m_Count; }
+
+        float* GetStream(uint32_t stream) { return m_Data.data() + stream * m_Stride; }
+        const float* GetStream(uint32_t stream) const { return m_Data.data() + stream * m_Stride; }
+
+        void Set(uint32_t joint, const Transform& transform);
+        Transform Get(uint32_t joint) const;
+
+        // Zeroes every joint, the starting point for Accumulate.
+        void Clear();
+
+        // Blends each joint between the keys around the sample time, nlerp on the shortest
+        // arc for rotations.
+        static void Interpolate(const AnimationKeys& keys, AnimationPose& out);
+
+        // Adds the weighted pose. Rotations are flipped onto the hemisphere of what has been
+        // accumulated so far.
+        void Accumulate(const AnimationPose& pose, float weight);
+
+        // Finishes a run of Accumulate calls whose weights add up to totalWeight.
+        void Normalize(float totalWeight);
+    };
+
+    // The keys either side of one sample time, with the blend factor between them for each
+    // joint's translation, rotation and scale. Clips gather the keys still quantized into
+    // m_Quantized, nine shorts per joint and side in the same SoA layout, and decode them into
+    // m_From and m_To four joints at a time.
+    struct AnimationKeys
+    {
+        static constexpr uint32_t QUANTIZED_STREAMS = 9;
+
+        AnimationPose m_From;
+        AnimationPose m_To;
+        std::vector<float> m_Alpha;
+        std::vector<uint16_t> m_Quantized;
+        uint32_t m_Stride = 0;
+
+        void Resize(uint32_t count);
+
+        float* GetAlpha(uint32_t channel) { return m_Alpha.data() + channel * m_Stride; }
+        const float* GetAlpha(uint32_t channel) const { return m_Alpha.data() + channel * m_Stride; }
+
+        // side 0 is the key before the sample time, 1 the key after.
+        uint16_t* GetQuantized(uint32_t side, uint32_t stream) { return m_Quantized.data() + (side * QUANTIZED_STREAMS + stream) * m_Stride; }
+    };
+}
@@ -0,0 +1,143 @@
+// AnimationSystem.cpp
+#include "AnimationSystem.h"
+
+namespace Isle
+{
+    AnimationSystem::~AnimationSystem()
+    {
+        Shutdown();
+
+        for (Animator* animator : m_Animators)
+            animator->m_SystemIndex = -1;
+    }
+
+    void AnimationSystem::Register(Animator* animator)
+    {
+        if (!animator || animator->m_SystemIndex >= 0)
+            return;
+
+        animator->m_SystemIndex = static_cast<int>(m_Animators.size());
+        m_Animators.push_back(animator);
+    }
+
+    void AnimationSystem::Unregister(Animator* animator)
+    {
+        if (!animator)
+            return;
+
+        const int index = animator->m_SystemIndex;
+        if (index < 0 || index >= static_cast<int>(m_Animators.size()) || m_Animators[index] != animator)
+            return;
+
+        // Swap with the last one, evaluation order doesn't matter.
+        m_Animators[index] = m_Animators.back();
+        m_Animators[index]->m_SystemIndex = index;
+        m_Animators.pop_back();
+        animator->m_SystemIndex = -1;
+    }
+
+    void AnimationSystem::Update(float deltaTime)
+    {
+        if (m_Animators.empty())
+            return;
+
+        const uint32_t batchSize = glm::max(m_BatchSize, 1u);
+        const uint32_t batches = static_cast<uint32_t>((m_Animators.size() + batchSize - 1) / batchSize);
+        const uint32_t hardwareThreads = glm::max(std::thread::hardware_concurrency(), 1u);
+
+        uint32_t workers = m_MaxWorkers < 0 ? hardwareThreads - 1 : static_cast<uint32_t>(m_MaxWorkers);
+        workers = glm::min(workers, batches - 1);
+
+        if (m_Scratch.empty() || workers > m_Workers.size())
+            StartWorkers(workers);
+
+        m_DeltaTime = deltaTime;
+        m_Next.store(0, std::memory_order_relaxed);
+
+        if (workers == 0)
+        {
+            RunBatches(*m_Scratch[0]);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_ActiveWorkers = workers;
+            m_Busy = workers;
+            m_Generation++;
+        }
+        m_Wake.notify_all();
+
+        RunBatches(*m_Scratch[0]);
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Done.wait(lock, [&] { return m_Busy == 0; });
+    }
+
+    void AnimationSystem::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Quit = true;
+        }
+        m_Wake.notify_all();
+
+        for (std::thread& worker : m_Workers)
+            worker.join();
+
+        m_Workers.clear();
+        m_Scratch.clear();
+        m_Quit = false;
+    }
+
+    void AnimationSystem::StartWorkers(uint32_t count)
+    {
+        while (m_Scratch.size() < count + 1)
+            m_Scratch.push_back(std::make_unique<Animator::Scratch>());
+
+        const uint64_t generation = m_Generation;
+        for (uint32_t i = static_cast<uint32_t>(m_Workers.size()); i < count; i++)
+            m_Workers.emplace_back(&AnimationSystem::WorkerLoop, this, i, generation, m_Scratch[i + 1].get());
+    }
+
+    void AnimationSystem::WorkerLoop(uint32_t index, uint64_t generation, Animator::Scratch* scratch)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Wake.wait(lock, [&] { return m_Quit || m_Generation != generation; });
+
+                if (m_Quit)
+                    return;
+
+                generation = m_Generation;
+                if (index >= m_ActiveWorkers)
+                    continue;
+            }
+
+            RunBatches(*scratch);
+
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (--m_Busy == 0)
+                m_Done.notify_one();
+        }
+    }
+
+    void AnimationSystem::RunBatches(Animator::Scratch& scratch)
+    {
+        const uint32_t count = static_cast<uint32_t>(m_Animators.size());
+        const uint32_t batchSize = glm::max(m_BatchSize, 1u);
+
+        while (true)
+        {
+            const uint32_t first = m_Next.fetch_add(batchSize, std::memory_order_relaxed);
+            if (first >= count)
+                break;
+
+            const uint32_t last = glm::min(first + batchSize, count);
+            for (uint32_t i = first; i < last; i++)
+                m_Animators[i]->Evaluate(m_DeltaTime, scratch);
+        }
+    }
+}
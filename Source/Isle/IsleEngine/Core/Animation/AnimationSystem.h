@@ -0,0 +1,59 @@
+// AnimationSystem.h
+#pragma once
+#include <Core/Common/Common.h>
+#include "Animator.h"
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+namespace Isle
+{
+    // Evaluates every started Animator once a frame. Animators are handed out to a set of
+    // persistent worker threads in small batches, the calling thread takes batches too, and
+    // Update returns once every skeleton is posed.
+    class ISLEENGINE_API AnimationSystem : public Singleton<AnimationSystem>, public Object
+    {
+    public:
+        // Threads besides the caller, below zero uses one per spare hardware thread.
+        int m_MaxWorkers = -1;
+
+        // Animators a thread claims at once.
+        uint32_t m_BatchSize = 8;
+
+    private:
+        std::vector<Animator*> m_Animators;
+
+        std::vector<std::thread> m_Workers;
+
+        // Slot 0 belongs to the calling thread, worker i uses slot i + 1.
+        std::vector<std::unique_ptr<Animator::Scratch>> m_Scratch;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        std::condition_variable m_Done;
+        uint64_t m_Generation = 0;
+        uint32_t m_ActiveWorkers = 0;
+        uint32_t m_Busy = 0;
+        bool m_Quit = false;
+
+        std::atomic<uint32_t> m_Next = 0;
+        float m_DeltaTime = 0.0f;
+
+    public:
+        ~AnimationSystem() override;
+
+        void Register(Animator* animator);
+        void Unregister(Animator* animator);
+        size_t GetAnimatorCount() const { return m_Animators.size(); }
+
+        void Update(float deltaTime);
+
+        // Joins the workers, the next Update starts them again.
+        void Shutdown();
+
+    private:
+        void StartWorkers(uint32_t count);
+        void WorkerLoop(uint32_t index, uint64_t generation, Animator::Scratch* scratch);
+        void RunBatches(Animator::Scratch& scratch);
+    };
+}
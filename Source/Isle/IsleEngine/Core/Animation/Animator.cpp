@@ -0,0 +1,136 @@
+// Animator.cpp
+#include "Animator.h"
+#include "AnimationSystem.h"
+
+namespace Isle
+{
+    Animator::~Animator()
+    {
+        if (AnimationSystem::IsValid())
+            AnimationSystem::Instance()->Unregister(this);
+    }
+
+    void Animator::Start()
+    {
+        AnimationSystem::Instance()->Register(this);
+    }
+
+    void Animator::Destroy()
+    {
+        if (AnimationSystem::IsValid())
+            AnimationSystem::Instance()->Unregister(this);
+
+        SceneComponent::Destroy();
+    }
+
+    void Animator::SetTargets(const std::vector<SceneComponent*>& targets)
+    {
+        m_Targets.assign(targets.begin(), targets.end());
+
+        m_RestPose.resize(targets.size());
+        for (size_t i = 0; i < targets.size(); i++)
+            m_RestPose[i] = targets[i] ? targets[i]->m_Transform : Transform();
+    }
+
+    AnimationLayer& Animator::Play(AnimationClip* clip, bool loop)
+    {
+        m_Layers.clear();
+        return AddLayer(clip, 1.0f, loop);
+    }
+
+    AnimationLayer& Animator::AddLayer(AnimationClip* clip, float weight, bool loop)
+    {
+        AnimationLayer& layer = m_Layers.emplace_back();
+        layer.m_Clip = clip;
+        layer.m_Weight = weight;
+        layer.m_Loop = loop;
+        return layer;
+    }
+
+    void Animator::Evaluate(float deltaTime, Scratch& scratch)
+    {
+        if (m_Targets.empty())
+            return;
+
+        uint32_t activeLayers = 0;
+        for (AnimationLayer& layer : m_Layers)
+        {
+            if (!layer.m_Clip)
+                continue;
+
+            if (layer.m_Cursors.size() != layer.m_Clip->GetCursorCount())
+                layer.m_Cursors.assign(layer.m_Clip->GetCursorCount(), 0);
+
+            const float duration = layer.m_Clip->GetDuration();
+            layer.m_Time += deltaTime * layer.m_Speed;
+
+            if (layer.m_Loop && duration > 0.0f)
+            {
+                layer.m_Time = glm::mod(layer.m_Time, duration);
+                if (layer.m_Time < 0.0f)
+                    layer.m_Time += duration;
+            }
+            else
+            {
+                layer.m_Time = glm::clamp(layer.m_Time, 0.0f, duration);
+            }
+
+            if (layer.m_Weight > 0.0f)
+                activeLayers++;
+        }
+
+        if (activeLayers == 0)
+            return;
+
+        const uint32_t count = GetTargetCount();
+        scratch.m_Keys.Resize(count);
+
+        const AnimationPose* result = &scratch.m_Pose;
+        if (activeLayers == 1)
+        {
+            for (AnimationLayer& layer : m_Layers)
+            {
+                if (layer.m_Clip && layer.m_Weight > 0.0f)
+                {
+                    layer.m_Clip->SampleKeys(layer.m_Time, m_RestPose.data(), scratch.m_Keys, layer.m_Cursors.data());
+                    AnimationPose::Interpolate(scratch.m_Keys, scratch.m_Pose);
+                    break;
+                }
+            }
+        }
+        else
+        {
+            scratch.m_Blend.Resize(count);
+            scratch.m_Blend.Clear();
+
+            float totalWeight = 0.0f;
+            for (AnimationLayer& layer : m_Layers)
+            {
+                if (!layer.m_Clip || layer.m_Weight <= 0.0f)
+                    continue;
+
+                layer.m_Clip->SampleKeys(layer.m_Time, m_RestPose.data(), scratch.m_Keys, layer.m_Cursors.data());
+                AnimationPose::Interpolate(scratch.m_Keys, scratch.m_Pose);
+                scratch.m_Blend.Accumulate(scratch.m_Pose, layer.m_Weight);
+                totalWeight += layer.m_Weight;
+            }
+
+            scratch.m_Blend.Normalize(totalWeight);
+            result = &scratch.m_Blend;
+        }
+
+        for (uint32_t j = 0; j < count; j++)
+        {
+            SceneComponent* target = m_Targets[j].Get();
+            if (!target || !target->IsValid())
+                continue;
+
+            target->m_Transform = result->Get(j);
+            target->MarkDirty();
+        }
+    }
+
+    BEGIN_REFLECT_CLASS(Animator)
+        REFLECT_PARENT_CLASS(SceneComponent)
+    END_REFLECT_CLASS(Animator)
+}
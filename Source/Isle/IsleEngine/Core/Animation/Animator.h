@@ -0,0 +1,68 @@
+// Animator.h
+#pragma once
+#include <Core/Common/Common.h>
+#include "AnimationClip.h"
+
+namespace Isle
+{
+    struct AnimationLayer
+    {
+        AnimationClip* m_Clip = nullptr;
+        float m_Time = 0.0f;
+        float m_Speed = 1.0f;
+        float m_Weight = 1.0f;
+        bool m_Loop = true;
+
+        // Where sampling found each channel's keys last frame.
+        std::vector<uint16_t> m_Cursors;
+    };
+
+    // Plays clips on a skeleton and writes the local transforms of its joints, which are
+    // ordinary scene components. Track i of every clip drives target i, several layers blend
+    // by weight. The AnimationSystem evaluates every started animator once per frame on its
+    // worker threads, so two animators must never share a target.
+    class ISLEENGINE_API Animator : public SceneComponent
+    {
+        GENERATED_BODY()
+        ISLE_TYPE(Animator, SceneComponent)
+
+        friend class AnimationSystem;
+
+    public:
+        // Per thread working memory, grows to the largest skeleton and is reused after that.
+        struct Scratch
+        {
+            AnimationKeys m_Keys;
+            AnimationPose m_Pose;
+            AnimationPose m_Blend;
+        };
+
+    private:
+        std::vector<WeakRef<SceneComponent>> m_Targets;
+        std::vector<Transform> m_RestPose;
+        std::vector<AnimationLayer> m_Layers;
+        int m_SystemIndex = -1;
+
+    public:
+        ~Animator() override;
+
+        void Start() override;
+        void Destroy() override;
+
+        // Captures the targets' current transforms as the pose channels a clip doesn't animate.
+        void SetTargets(const std::vector<SceneComponent*>& targets);
+        uint32_t GetTargetCount() const { return static_cast<uint32_t>(m_Targets.size()); }
+
+        // Play replaces every layer with the one clip. The returned layer is valid until the
+        // next layer is added.
+        AnimationLayer& Play(AnimationClip* clip, bool loop = true);
+        AnimationLayer& AddLayer(AnimationClip* clip, float weight, bool loop = true);
+        AnimationLayer* GetLayer(size_t index) { return index < m_Layers.size() ? &m_Layers[index] : nullptr; }
+        size_t GetLayerCount() const { return m_Layers.size(); }
+        void ClearLayers() { m_Layers.clear(); }
+
+        // Advances the layers and poses the targets. Safe to call from any thread, as long as
+        // no other thread touches this animator's targets meanwhile.
+        void Evaluate(float deltaTime, Scratch& scratch);
+    };
+}
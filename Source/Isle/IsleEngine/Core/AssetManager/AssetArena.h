@@ -0,0 +1,58 @@
+// AssetArena.h
+#pragma once
+#include <Core/Common/Common.h>
+#include <Core/Common/Memory/ObjectPool.h>
+#include <Core/Graphics/Mesh/StaticMesh.h>
+#include <Core/Graphics/Mesh/SkinnedMesh.h>
+#include <Core/Graphics/Material/Material.h>
+#include <Core/Graphics/Texture/Texture.h>
+#include <Core/Animation/Animator.h>
+
+namespace Isle
+{
+    // Everything one import creates, one pool per type. The importer sizes the pools up front
+    // so an asset's nodes, meshes and materials each sit in a single block, and unloading the
+    // asset destroys them all at once.
+    //
+    // The arena owns these objects. Scene and pipeline only borrow them: an asset added to the
+    // scene must be added without ownership, and is not unloaded while anything uses it.
+    class AssetArena
+    {
+    public:
+        ObjectPool<SceneComponent> m_SceneComponents;
+        ObjectPool<StaticMesh> m_StaticMeshes;
+        ObjectPool<SkinnedMesh> m_SkinnedMeshes;
+        ObjectPool<Material> m_Materials;
+        ObjectPool<Texture> m_Textures;
+        ObjectPool<Animator> m_Animators;
+        ObjectPool<AnimationClip> m_AnimationClips;
+
+    public:
+        ~AssetArena() { Clear(); }
+
+        // Nodes first, they point at meshes, meshes point at materials, materials at textures.
+        // Animators go with the nodes, clips once nothing plays them.
+        void Clear()
+        {
+            m_Animators.Clear();
+            m_SceneComponents.Clear();
+            m_StaticMeshes.Clear();
+            m_SkinnedMeshes.Clear();
+            m_Materials.Clear();
+            m_Textures.Clear();
+            m_AnimationClips.Clear();
+        }
+
+        size_t GetObjectCount() const
+        {
+            return m_SceneComponents.GetCount() + m_StaticMeshes.GetCount() + m_SkinnedMeshes.GetCount() + m_Materials.GetCount() + m_Textures.GetCount() +
+                m_Animators.GetCount() + m_AnimationClips.GetCount();
+        }
+
+        size_t GetReservedBytes() const
+        {
+            return m_SceneComponents.GetReservedBytes() + m_StaticMeshes.GetReservedBytes() + m_SkinnedMeshes.GetReservedBytes() +
+                m_Materials.GetReservedBytes() + m_Textures.GetReservedBytes() + m_Animators.GetReservedBytes() + m_AnimationClips.GetReservedBytes();
+        }
+    };
+}
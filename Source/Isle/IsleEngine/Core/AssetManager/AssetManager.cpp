@@ -21,6 +21,15 @@ namespace Isle
 			return nullptr;
 		}
 
+		// Loading a path again reimports it, unless the old copy is still referenced.
+		if (Asset* previous = Find(path))
+		{
+			if (IsInUse(previous))
+				return previous;
+
+			Unload(previous->m_AssetId);
+		}
+
 		auto* gltfImporter = new GltfImporter();
 		if (!gltfImporter->LoadFromFile(path))
 		{
@@ -29,8 +38,10 @@ namespace Isle
 			return nullptr;
 		}
 
-		int assetId = static_cast<int>(m_Assets.size());
+		int assetId = m_NextAssetId++;
 		Asset* asset = new Asset();
+		asset->m_AssetId = assetId;
+		asset->m_Path = path;
 		m_Assets[assetId] = asset;
 
 		RegisterAsset(gltfImporter, asset);
@@ -43,7 +54,10 @@ namespace Isle
 			return nullptr;
 		}
 
-		ISLE_LOG("AssetManager: Loaded '%s' (%zu objects)\n", path.c_str(), asset->m_Objects.size());
+		asset->m_Arena = std::move(gltfImporter->m_Arena);
+		m_Revision++;
+
+		ISLE_LOG("AssetManager: Loaded '%s' (%zu objects, %zu KB arena)\n", path.c_str(), asset->m_Objects.size(), asset->m_Arena->GetReservedBytes() / 1024);
 		delete gltfImporter;
 		return asset;
 	}
@@ -67,12 +81,86 @@ namespace Isle
 		for (auto* mat : importer->m_Materials)
 			Register(mat);
 		for (auto* mesh : importer->m_StaticMeshes)
+		{
+			if (mesh)
+			{
+				mesh->m_AssetId = asset->m_AssetId;
+				mesh->m_AssetObjectId = static_cast<int>(asset->m_Objects.size());
+			}
 			Register(mesh);
+		}
 		for (auto* comp : importer->m_SceneComponents)
 			Register(comp);
 
 		if (importer->m_RootComponent)
 			Register(importer->m_RootComponent);
+
+		// After the root, ids of assets without animation stay what they were.
+		Register(importer->m_Animator);
+		for (auto* clip : importer->m_AnimationClips)
+			Register(clip);
+	}
+
+	Asset* AssetManager::Find(const std::string& path)
+	{
+		for (auto& [id, asset] : m_Assets)
+		{
+			if (asset && asset->m_Path == path)
+				return asset;
+		}
+		return nullptr;
+	}
+
+	Asset* AssetManager::GetAsset(int assetId)
+	{
+		auto it = m_Assets.find(assetId);
+		return it != m_Assets.end() ? it->second : nullptr;
+	}
+
+	bool AssetManager::Unload(int assetId)
+	{
+		auto it = m_Assets.find(assetId);
+		if (it == m_Assets.end())
+			return false;
+
+		Asset* asset = it->second;
+		if (IsInUse(asset))
+		{
+			ISLE_WARN("AssetManager: '%s' is still in use, not unloading\n", asset->m_Path.c_str());
+			return false;
+		}
+
+		ISLE_LOG("AssetManager: Unloaded '%s'\n", asset->m_Path.c_str());
+		m_Assets.erase(it);
+		delete asset;
+		m_Revision++;
+		return true;
+	}
+
+	bool AssetManager::IsInUse(Asset* asset)
+	{
+		if (!asset)
+			return false;
+
+		if (asset->m_Pinned)
+			return true;
+
+		auto* root = Cast<SceneComponent>(asset->m_RootObject);
+		if (root && root->m_Owner)
+			return true;
+
+		bool uploaded = false;
+		if (asset->m_Arena)
+		{
+			auto checkUploaded = [&](StaticMesh& mesh)
+				{
+					if (mesh.m_Id >= 0)
+						uploaded = true;
+				};
+			asset->m_Arena->m_StaticMeshes.ForEach(checkUploaded);
+			asset->m_Arena->m_SkinnedMeshes.ForEach(checkUploaded);
+		}
+		return uploaded;
 	}
 
 	Importer* AssetManager::GetImporter()
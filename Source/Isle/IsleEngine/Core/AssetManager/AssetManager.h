@@ -1,26 +1,47 @@
 #pragma once
 #include <Core/Common/Common.h>
 #include <Core/Importer/Importer.h>
+#include <Core/AssetManager/AssetArena.h>
 
 namespace Isle
 {
 	class ISLEENGINE_API Asset : public Object
 	{
 	public:
+		int m_AssetId = -1;
+		std::string m_Path;
 		Object* m_RootObject;
 		std::map<int, Object*> m_Objects;
+
+		// Owns everything in m_Objects, they are freed together when the asset is unloaded.
+		std::unique_ptr<AssetArena> m_Arena;
+
+		// Set when a saved scene refers to the asset, it then stays loaded.
+		bool m_Pinned = false;
 	};
 
 	class ISLEENGINE_API AssetManager : public Singleton<AssetManager>, public Object
 	{
 	private:
 		Importer* m_Importer = nullptr;
+		int m_NextAssetId = 0;
 
 	public:
 		std::map<int, Asset*> m_Assets;
 
+		// Bumped on every load and unload, views over m_Assets compare it to know when to rebuild.
+		uint32_t m_Revision = 0;
+
 	public:
 		Asset* Load(const std::string& path);
+		Asset* Find(const std::string& path);
+		Asset* GetAsset(int assetId);
+
+		// Frees the asset and all its objects. Refuses, and returns false, while it is in use.
+		bool Unload(int assetId);
+
+		// Pinned, placed in a scene, or with meshes uploaded to the pipeline.
+		bool IsInUse(Asset* asset);
 
 	private:
 		Importer* GetImporter();
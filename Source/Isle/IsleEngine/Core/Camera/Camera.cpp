@@ -120,6 +120,7 @@ namespace Isle
         GCamera.m_CameraPos = m_Transform.m_Translation;
         GCamera.m_ProjectionMatrix = m_ProjectionMatrix;
         GCamera.m_ViewMatrix = m_ViewMatrix;
+        GCamera.m_InverseViewProjection = glm::inverse(m_ProjectionMatrix * m_ViewMatrix);
         return GCamera;
     }
 }
\ No newline at end of file
@@ -7,6 +7,8 @@ namespace Isle
 {
 	class Camera : public SceneComponent
 	{
+		ISLE_TYPE(Camera, SceneComponent)
+
 	public:
 		glm::mat4 m_ViewMatrix;
 		glm::mat4 m_ProjectionMatrix;
@@ -7,6 +7,8 @@ namespace Isle
 {
 	class ISLEENGINE_API MainCamera : public Singleton<MainCamera>, public SceneComponent
 	{
+		ISLE_TYPE(MainCamera, SceneComponent)
+
 	public:
 		Camera* m_CurrentCamera = nullptr;
 
@@ -25,11 +25,12 @@
 #include <functional>
 #include <mutex>
 
-#define GLFW_EXPOSE_NATIVE_WIN32
-
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#ifdef _WIN32
+#define GLFW_EXPOSE_NATIVE_WIN32
 #include <GLFW/glfw3native.h>
+#endif
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -44,28 +45,19 @@
 #include "Object/Object.h"
 #include "Memory/Ref.h"
 #include "Memory/WeakRef.h"
+#include "Memory/FrameAllocator.h"
+#include "Memory/AllocationCounter.h"
 #include "Component/Component.h"
 #include "Singleton/Singleton.h"
 #include "Transform/Transform.h"
 #include "Bounds/Bounds.h"
-#include "SceneComponent/SceneComponent.h"
-
-#define ISLE_OBJECT_CLASS(ClassName) \
-    friend class Isle::Object; \
-    private: \
-        static inline std::atomic<int> s_NextId{1}; \
-        static inline std::unordered_map<int, std::weak_ptr<Isle::Object>> s_Registry; \
-        static inline std::shared_mutex s_RegistryMutex; \
-    public:
 
 namespace Isle
 {
     template<typename T, typename... Args>
     static Ref<T> CreateObject(Args&&... args)
     {
-        auto obj = std::make_shared<T>(std::forward<Args>(args)...);
-        obj->AutoRegister();
-        return Ref<T>(obj);
+        return Ref<T>(std::make_shared<T>(std::forward<Args>(args)...));
     }
 
     template<typename T, typename... Args>
@@ -142,4 +134,5 @@ inline bool HasAnsiSupport()
     } while (0)
 
 #include "Reflection/Reflection.h"
+#include "SceneComponent/SceneComponent.h"
 #include "Profiler/Profiler.h"
@@ -6,6 +6,8 @@ namespace Isle
 {
 	class Component : public Object
 	{
+		ISLE_TYPE(Component, Object)
+
 	public:
 		virtual void Start() {};
 		virtual void Update() {};
@@ -0,0 +1,36 @@
+// MappedFile.h
+#pragma once
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    // Read only view of a whole file mapped into the address space. Pages are brought in by
+    // the OS as they are touched, so opening costs nothing and nothing is copied up front.
+    class ISLEENGINE_API MappedFile
+    {
+    private:
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+
+#ifdef _WIN32
+        void* m_File = nullptr;
+        void* m_Mapping = nullptr;
+#else
+        int m_File = -1;
+#endif
+
+    public:
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+        const uint8_t* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+    };
+}
@@ -0,0 +1,117 @@
+// AllocationCounter.cpp
+#include <Core/Common/Common.h>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+#if defined(_DEBUG) && defined(_MSC_VER)
+#define ISLE_COUNT_ALLOCATIONS
+#endif
+
+namespace Isle
+{
+    namespace
+    {
+        thread_local uint64_t t_Allocations = 0;
+    }
+
+#ifdef ISLE_COUNT_ALLOCATIONS
+    bool AllocationCounter::IsEnabled()
+    {
+        return true;
+    }
+#else
+    bool AllocationCounter::IsEnabled()
+    {
+        return false;
+    }
+#endif
+
+    uint64_t AllocationCounter::GetThreadCount()
+    {
+        return t_Allocations;
+    }
+
+    AllocationCheck::~AllocationCheck()
+    {
+        if (!m_Armed)
+            return;
+
+        const uint64_t allocations = AllocationCounter::GetThreadCount() - m_Start;
+        if (allocations == 0)
+            return;
+
+        ISLE_ERROR("%s made %llu heap allocations, it should make none\n", m_Name, static_cast<unsigned long long>(allocations));
+        assert(allocations == 0 && "steady state path allocated");
+    }
+}
+
+#ifdef ISLE_COUNT_ALLOCATIONS
+namespace
+{
+    void* CountedAlloc(size_t size)
+    {
+        Isle::t_Allocations++;
+        return std::malloc(size ? size : 1);
+    }
+
+    void* CountedAlignedAlloc(size_t size, std::align_val_t alignment)
+    {
+        Isle::t_Allocations++;
+        return _aligned_malloc(size ? size : 1, static_cast<size_t>(alignment));
+    }
+
+    void AlignedFree(void* ptr)
+    {
+        _aligned_free(ptr);
+    }
+}
+
+// Replacing these in the engine DLL counts every allocation its code makes. The sized and
+// nothrow forms fall back to these, the aligned ones need their own pair.
+void* operator new(size_t size)
+{
+    if (void* ptr = CountedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAlloc(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = CountedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { AlignedFree(ptr); }
+#endif
@@ -0,0 +1,40 @@
+// AllocationCounter.h
+#pragma once
+#include <cstdint>
+
+namespace Isle
+{
+    // Heap allocations made through operator new by engine code on the calling thread. Only MSVC
+    // debug builds count them: there every module links its own operator new, so replacing the
+    // engine's leaves game code alone. A replacement in an ELF shared library would take over the
+    // whole process instead, so other builds don't replace it and always read zero.
+    class ISLEENGINE_API AllocationCounter
+    {
+    public:
+        static bool IsEnabled();
+        static uint64_t GetThreadCount();
+    };
+
+    // Reports when the scope made any heap allocation on this thread. Meant for paths that
+    // must stay allocation free once warmed up, and only armed when the caller says so.
+    class AllocationCheck
+    {
+    public:
+        AllocationCheck(const char* name, bool armed = true)
+            : m_Name(name), m_Start(AllocationCounter::GetThreadCount()), m_Armed(armed && AllocationCounter::IsEnabled())
+        {
+        }
+
+        ~AllocationCheck();
+
+        void Disarm() { m_Armed = false; }
+
+        AllocationCheck(const AllocationCheck&) = delete;
+        AllocationCheck& operator=(const AllocationCheck&) = delete;
+
+    private:
+        const char* m_Name;
+        uint64_t m_Start;
+        bool m_Armed;
+    };
+}
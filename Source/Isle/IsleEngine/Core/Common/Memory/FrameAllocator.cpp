@@ -0,0 +1,116 @@
+// FrameAllocator.cpp
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    namespace
+    {
+        struct FrameBlock
+        {
+            uint8_t* m_Data = nullptr;
+            size_t m_Capacity = 0;
+            size_t m_Used = 0;
+        };
+
+        FrameBlock s_Block;
+
+        // Overflow chunks of the current frame, freed at EndFrame(). Only a frame that outgrows
+        // the block ever gets here.
+        std::vector<uint8_t*> s_Spills;
+        size_t s_SpilledBytes = 0;
+        size_t s_Peak = 0;
+
+        constexpr size_t BLOCK_ALIGNMENT = 64;
+
+        // Alignments are powers of two, as alignof guarantees.
+        size_t AlignUp(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        uint8_t* AllocateBlock(size_t size)
+        {
+            return static_cast<uint8_t*>(::operator new(size, std::align_val_t(BLOCK_ALIGNMENT)));
+        }
+
+        void FreeBlock(uint8_t* data)
+        {
+            ::operator delete(data, std::align_val_t(BLOCK_ALIGNMENT));
+        }
+    }
+
+    void* FrameAllocator::Allocate(size_t size, size_t alignment)
+    {
+        if (!s_Block.m_Data)
+        {
+            s_Block.m_Data = AllocateBlock(DEFAULT_CAPACITY);
+            s_Block.m_Capacity = DEFAULT_CAPACITY;
+        }
+
+        size = std::max<size_t>(size, 1);
+
+        const uintptr_t base = reinterpret_cast<uintptr_t>(s_Block.m_Data);
+        const size_t offset = AlignUp(base + s_Block.m_Used, alignment) - base;
+        if (offset + size <= s_Block.m_Capacity)
+        {
+            s_Block.m_Used = offset + size;
+            s_Peak = std::max(s_Peak, s_Block.m_Used + s_SpilledBytes);
+            return s_Block.m_Data + offset;
+        }
+
+        // Padded so any alignment fits, the chunk itself is freed with the block alignment.
+        const size_t spillSize = size + alignment;
+        uint8_t* spill = AllocateBlock(spillSize);
+        s_Spills.push_back(spill);
+        s_SpilledBytes += spillSize;
+        s_Peak = std::max(s_Peak, s_Block.m_Used + s_SpilledBytes);
+
+        const uintptr_t address = reinterpret_cast<uintptr_t>(spill);
+        return spill + (AlignUp(address, alignment) - address);
+    }
+
+    void FrameAllocator::EndFrame()
+    {
+        if (!s_Spills.empty())
+        {
+            for (uint8_t* spill : s_Spills)
+                FreeBlock(spill);
+            s_Spills.clear();
+
+            const size_t capacity = AlignUp(s_Peak + s_Peak / 2, BLOCK_ALIGNMENT);
+            ISLE_LOG("FrameAllocator: frame used %zu KB, growing the block to %zu KB\n", s_Peak / 1024, capacity / 1024);
+
+            FreeBlock(s_Block.m_Data);
+            s_Block.m_Data = AllocateBlock(capacity);
+            s_Block.m_Capacity = capacity;
+            s_SpilledBytes = 0;
+        }
+
+        s_Block.m_Used = 0;
+    }
+
+    void FrameAllocator::Shutdown()
+    {
+        EndFrame();
+
+        FreeBlock(s_Block.m_Data);
+        s_Block = {};
+        s_Spills.shrink_to_fit();
+        s_Peak = 0;
+    }
+
+    size_t FrameAllocator::GetUsed()
+    {
+        return s_Block.m_Used + s_SpilledBytes;
+    }
+
+    size_t FrameAllocator::GetCapacity()
+    {
+        return s_Block.m_Capacity;
+    }
+
+    size_t FrameAllocator::GetPeak()
+    {
+        return s_Peak;
+    }
+}
@@ -0,0 +1,59 @@
+// FrameAllocator.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Isle
+{
+    // Bump allocator for scratch memory that only lives until the end of the frame. Allocating
+    // moves a pointer, nothing is freed on its own, and EndFrame() rewinds the whole block.
+    //
+    // Main thread only. A frame that runs past the block spills into heap chunks, and the next
+    // EndFrame() grows the block past the peak so the same load fits without spilling again.
+    class ISLEENGINE_API FrameAllocator
+    {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 1 << 20;
+
+    public:
+        static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T>
+        static T* AllocateArray(size_t count)
+        {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // Everything handed out since the last call becomes invalid.
+        static void EndFrame();
+        static void Shutdown();
+
+        static size_t GetUsed();
+        static size_t GetCapacity();
+        static size_t GetPeak();
+    };
+
+    // Lets standard containers draw from the frame allocator. Deallocation does nothing, so
+    // reserve up front when the size is known, a growing container leaves its old buffers behind.
+    template<typename T>
+    class FrameStlAllocator
+    {
+    public:
+        using value_type = T;
+
+        FrameStlAllocator() = default;
+
+        template<typename U>
+        FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+        T* allocate(size_t count) { return FrameAllocator::AllocateArray<T>(count); }
+        void deallocate(T*, size_t) {}
+
+        template<typename U>
+        bool operator==(const FrameStlAllocator<U>&) const { return true; }
+    };
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+}
@@ -0,0 +1,150 @@
+// ObjectPool.h
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Isle
+{
+    // Typed storage for objects that share one lifetime. Objects are constructed in place in
+    // large blocks, so objects created together sit next to each other, and nothing is freed
+    // on its own: Clear() or the destructor runs every destructor and drops whole blocks.
+    //
+    // Create() may run on several threads at once. Clear() and ForEach() must not overlap
+    // with it. Objects from a pool must never be deleted directly.
+    template<typename T>
+    class ObjectPool
+    {
+    private:
+        struct Block
+        {
+            T* m_Data = nullptr;
+            uint32_t m_Capacity = 0;
+            std::atomic<uint32_t> m_Used{ 0 };  // can run past m_Capacity while threads race for the last slot
+
+            // Set once a slot's constructor returned. A claimed slot whose constructor threw
+            // stays unset and is never destroyed.
+            std::unique_ptr<bool[]> m_Live;
+
+            uint32_t GetCount() const { return std::min(m_Used.load(std::memory_order_acquire), m_Capacity); }
+        };
+
+        std::vector<std::unique_ptr<Block>> m_Blocks;
+        std::atomic<Block*> m_Current{ nullptr };
+        std::atomic<size_t> m_Count{ 0 };
+        std::mutex m_GrowMutex;
+        uint32_t m_BlockSize;
+
+    public:
+        explicit ObjectPool(uint32_t blockSize = 64) : m_BlockSize(blockSize) {}
+        ~ObjectPool() { Clear(); }
+
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator=(const ObjectPool&) = delete;
+
+        // Makes the next count creations land in one contiguous block.
+        void Reserve(uint32_t count)
+        {
+            std::lock_guard<std::mutex> lock(m_GrowMutex);
+
+            Block* current = m_Current.load(std::memory_order_acquire);
+            if (current && current->m_Capacity - current->GetCount() >= count)
+                return;
+
+            AddBlock(count);
+        }
+
+        template<typename... Args>
+        T* Create(Args&&... args)
+        {
+            for (;;)
+            {
+                Block* block = m_Current.load(std::memory_order_acquire);
+                if (block)
+                {
+                    const uint32_t slot = block->m_Used.fetch_add(1, std::memory_order_acq_rel);
+                    if (slot < block->m_Capacity)
+                    {
+                        T* object = new (block->m_Data + slot) T(std::forward<Args>(args)...);
+                        block->m_Live[slot] = true;
+                        m_Count.fetch_add(1, std::memory_order_relaxed);
+                        return object;
+                    }
+                }
+
+                Grow(block);
+            }
+        }
+
+        // Destroys everything, newest first, and releases the storage.
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(m_GrowMutex);
+
+            for (auto block = m_Blocks.rbegin(); block != m_Blocks.rend(); ++block)
+            {
+                for (uint32_t i = (*block)->GetCount(); i > 0; i--)
+                {
+                    if ((*block)->m_Live[i - 1])
+                        (*block)->m_Data[i - 1].~T();
+                }
+
+                ::operator delete((*block)->m_Data, std::align_val_t(alignof(T)));
+            }
+
+            m_Blocks.clear();
+            m_Current.store(nullptr, std::memory_order_release);
+            m_Count.store(0, std::memory_order_relaxed);
+        }
+
+        template<typename Func>
+        void ForEach(Func&& func)
+        {
+            for (auto& block : m_Blocks)
+            {
+                for (uint32_t i = 0, count = block->GetCount(); i < count; i++)
+                {
+                    if (block->m_Live[i])
+                        func(block->m_Data[i]);
+                }
+            }
+        }
+
+        size_t GetCount() const { return m_Count.load(std::memory_order_relaxed); }
+
+        size_t GetReservedBytes() const
+        {
+            size_t bytes = 0;
+            for (auto& block : m_Blocks)
+                bytes += size_t(block->m_Capacity) * sizeof(T);
+            return bytes;
+        }
+
+    private:
+        void Grow(Block* full)
+        {
+            std::lock_guard<std::mutex> lock(m_GrowMutex);
+
+            // Another thread may have replaced the block while this one waited.
+            if (m_Current.load(std::memory_order_acquire) != full)
+                return;
+
+            AddBlock(m_BlockSize);
+        }
+
+        void AddBlock(uint32_t capacity)
+        {
+            auto block = std::make_unique<Block>();
+            block->m_Capacity = std::max(capacity, 1u);
+            block->m_Data = static_cast<T*>(::operator new(sizeof(T) * block->m_Capacity, std::align_val_t(alignof(T))));
+            block->m_Live = std::make_unique<bool[]>(block->m_Capacity);
+
+            m_Current.store(block.get(), std::memory_order_release);
+            m_Blocks.push_back(std::move(block));
+        }
+    };
+}
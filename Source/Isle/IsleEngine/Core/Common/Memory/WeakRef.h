@@ -3,37 +3,38 @@
 
 namespace Isle
 {
-   template<typename T>
+    // A plain object handle. It does not keep anything alive and costs nothing to copy,
+    // resolving goes through the registry without locking and fails once the object is gone.
+    template<typename T>
     class WeakRef
     {
     private:
-        int m_Id = 0;
-        std::weak_ptr<T> m_Weak;
+        ObjectHandle m_Handle;
 
     public:
         WeakRef() = default;
+        WeakRef(const T* object) : m_Handle(object ? object->GetHandle() : ObjectHandle()) {}
+        WeakRef(const Ref<T>& ref) : WeakRef(ref.Get()) {}
 
-        WeakRef(const Ref<T>& ref)
-        {
-            if (ref)
-            {
-                m_Id = ref->GetId();
-                m_Weak = ref.m_Ptr;
-            }
-        }
+        T* Get() const { return Object::Find<T>(m_Handle); }
 
+        // Shares ownership when the object was made by New<T>, otherwise the Ref does not own it.
         Ref<T> Lock() const
         {
-            if (auto ptr = m_Weak.lock())
-                return Ref<T>(ptr);
+            T* object = Get();
+            if (!object)
+                return Ref<T>();
 
-            if (m_Id > 0)
-                return Ref<T>(Object::Find<T>(m_Id));
+            if (std::shared_ptr<Object> shared = object->weak_from_this().lock())
+                return Ref<T>(std::shared_ptr<T>(shared, object));
 
-            return Ref<T>();
+            return Ref<T>(object);
         }
 
-        bool IsValid() const { return !m_Weak.expired(); }
-        int GetId() const { return m_Id; }
+        bool IsValid() const { return Get() != nullptr; }
+        ObjectHandle GetHandle() const { return m_Handle; }
+
+        bool operator==(const WeakRef& other) const { return m_Handle == other.m_Handle; }
+        bool operator!=(const WeakRef& other) const { return !(m_Handle == other.m_Handle); }
     };
-}
\ No newline at end of file
+}
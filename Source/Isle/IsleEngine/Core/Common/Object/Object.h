@@ -3,67 +3,130 @@
 #include <unordered_map>
 #include <memory>
 #include <atomic>
-#include <shared_mutex>
+#include <type_traits>
+#include <cstdint>
+#include "ObjectRegistry.h"
 
 namespace Isle
 {
+    // FNV-1a, type ids are hashes of the class name so every module agrees on them
+    // without sharing any data across the DLL boundary.
+    constexpr uint32_t HashTypeName(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        for (; *name; name++)
+            hash = (hash ^ static_cast<uint8_t>(*name)) * 16777619u;
+        return hash;
+    }
+
+    // Runtime type information for the Object hierarchy that does not go through RTTI.
+    // Each class declaring ISLE_TYPE has a compile time id and depth, and one TypeInfo
+    // holding the ids of its ancestors indexed by depth, so asking whether an object is
+    // a T is one compare at T's depth.
+    struct TypeInfo
+    {
+        static constexpr uint32_t MAX_DEPTH = 16;
+
+        const char* m_Name;
+        const TypeInfo* m_Parent;
+        uint32_t m_Id;
+        uint32_t m_Depth;
+        uint32_t m_Ancestors[MAX_DEPTH] = {};
+
+        TypeInfo(const char* name, const TypeInfo* parent)
+            : m_Name(name)
+            , m_Parent(parent)
+            , m_Id(HashTypeName(name))
+            , m_Depth(parent ? parent->m_Depth + 1 : 0)
+        {
+            if (parent)
+            {
+                for (uint32_t i = 0; i < MAX_DEPTH && i <= parent->m_Depth; i++)
+                    m_Ancestors[i] = parent->m_Ancestors[i];
+            }
+
+            if (m_Depth < MAX_DEPTH)
+                m_Ancestors[m_Depth] = m_Id;
+        }
+
+        bool IsA(uint32_t id, uint32_t depth) const
+        {
+            if (depth < MAX_DEPTH)
+                return depth <= m_Depth && m_Ancestors[depth] == id;
+
+            // Deeper than the table, walk up the chain instead.
+            for (const TypeInfo* type = this; type; type = type->m_Parent)
+            {
+                if (type->m_Id == id)
+                    return true;
+            }
+            return false;
+        }
+    };
+
+    class Object;
+
+    template<typename T>
+    T* Cast(Object* object);
+
     class Object : public std::enable_shared_from_this<Object>
     {
     private:
-        inline static std::atomic<int> s_NextId{ 1 };
-        inline static std::unordered_map<int, std::weak_ptr<Object>> s_Registry;
-        inline static std::shared_mutex s_RegistryMutex;
-
-        const int m_Id;
+        ObjectHandle m_Handle;
         std::string m_Name;
 
     protected:
         Object(std::string name = "")
-            : m_Id(s_NextId.fetch_add(1, std::memory_order_relaxed))
+            : m_Handle(ObjectRegistry::Register(this))
             , m_Name(std::move(name))
         {
         }
 
     public:
-        virtual ~Object() { AutoUnregister(); }
+        virtual ~Object() { ObjectRegistry::Unregister(m_Handle); }
 
         Object(const Object&) = delete;
         Object& operator=(const Object&) = delete;
-        Object(Object&&) = default;
-        Object& operator=(Object&&) = default;
 
-        int GetId() const { return m_Id; }
-        const std::string& GetName() const { return m_Name; }
-        void SetName(std::string name) { m_Name = std::move(name); }
+        // A moved-to object is a new object with a handle of its own.
+        Object(Object&& other) noexcept
+            : m_Handle(ObjectRegistry::Register(this))
+            , m_Name(std::move(other.m_Name))
+        {
+        }
 
-        void AutoRegister()
+        Object& operator=(Object&& other) noexcept
         {
-            std::unique_lock<std::shared_mutex> lock(s_RegistryMutex);
-            s_Registry[m_Id] = weak_from_this();
+            m_Name = std::move(other.m_Name);
+            return *this;
         }
 
-        void AutoUnregister()
+        using ThisType = Object;
+        static constexpr uint32_t TypeId = HashTypeName("Object");
+        static constexpr uint32_t TypeDepth = 0;
+
+        static const TypeInfo* StaticType()
         {
-            std::unique_lock<std::shared_mutex> lock(s_RegistryMutex);
-            s_Registry.erase(m_Id);
+            static const TypeInfo s_Type("Object", nullptr);
+            return &s_Type;
         }
 
+        virtual const TypeInfo* GetTypeInfo() const { return StaticType(); }
+
+        ObjectHandle GetHandle() const { return m_Handle; }
+        const std::string& GetName() const { return m_Name; }
+        void SetName(std::string name) { m_Name = std::move(name); }
+
         virtual std::string ToString() const
         {
-            return m_Name.empty() ? "Object#" + std::to_string(m_Id) : m_Name;
+            return m_Name.empty() ? "Object#" + std::to_string(m_Handle.m_Index) : m_Name;
         }
 
+        // Lock free, nullptr once the object behind the handle is gone or is not a T.
         template<typename T = Object>
-        static std::shared_ptr<T> Find(int id)
+        static T* Find(ObjectHandle handle)
         {
-            std::shared_lock<std::shared_mutex> lock(s_RegistryMutex);
-            auto it = s_Registry.find(id);
-            if (it != s_Registry.end())
-            {
-                if (auto ptr = it->second.lock())
-                    return std::dynamic_pointer_cast<T>(ptr);
-            }
-            return nullptr;
+            return Cast<T>(ObjectRegistry::Resolve(handle));
         }
 
         template<typename T>
@@ -73,4 +136,53 @@ namespace Isle
         }
     };
 
-}
\ No newline at end of file
+    template<typename T>
+    concept DeclaresTypeInfo = requires
+    {
+        typename T::ThisType;
+        requires std::is_same_v<typename T::ThisType, T>;
+    };
+
+    // Replacements for dynamic_cast on Object pointers. Classes declaring ISLE_TYPE are
+    // checked against their type id, anything else still goes through dynamic_cast.
+    template<typename T>
+    bool IsA(const Object* object)
+    {
+        if constexpr (DeclaresTypeInfo<T>)
+            return object && object->GetTypeInfo()->IsA(T::TypeId, T::TypeDepth);
+        else
+            return dynamic_cast<const T*>(object) != nullptr;
+    }
+
+    template<typename T>
+    T* Cast(Object* object)
+    {
+        if constexpr (DeclaresTypeInfo<T>)
+            return IsA<T>(object) ? static_cast<T*>(object) : nullptr;
+        else
+            return dynamic_cast<T*>(object);
+    }
+
+    template<typename T>
+    const T* Cast(const Object* object)
+    {
+        if constexpr (DeclaresTypeInfo<T>)
+            return IsA<T>(object) ? static_cast<const T*>(object) : nullptr;
+        else
+            return dynamic_cast<const T*>(object);
+    }
+}
+
+// Declares the runtime type of a class deriving from Object, see TypeInfo.
+#define ISLE_TYPE(ClassName, ParentName) \
+    public: \
+        using ThisType = ClassName; \
+        static constexpr uint32_t TypeId = Isle::HashTypeName(#ClassName); \
+        static constexpr uint32_t TypeDepth = ParentName::TypeDepth + 1; \
+        static const Isle::TypeInfo* StaticType() \
+        { \
+            static const Isle::TypeInfo s_Type(#ClassName, ParentName::StaticType()); \
+            return &s_Type; \
+        } \
+        const Isle::TypeInfo* GetTypeInfo() const override { return StaticType(); } \
+    private:
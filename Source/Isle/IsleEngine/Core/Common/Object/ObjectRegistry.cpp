@@ -0,0 +1,139 @@
+// ObjectRegistry.cpp
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    namespace
+    {
+        constexpr uint32_t NO_SLOT = ObjectHandle::INVALID_INDEX;
+
+        struct ObjectSlot
+        {
+            std::atomic<Object*> m_Object{ nullptr };
+            std::atomic<uint32_t> m_Generation{ 1 };
+            std::atomic<uint32_t> m_NextFree{ NO_SLOT };
+        };
+
+        std::atomic<ObjectSlot*> s_Pages[ObjectRegistry::MAX_PAGES] = {};
+        std::atomic<uint32_t> s_SlotCount{ 0 };
+        std::atomic<uint32_t> s_LiveCount{ 0 };
+
+        // Free list head, the low half is the slot index and the high half a counter
+        // bumped on every change so a pop cannot succeed against a recycled head (ABA).
+        std::atomic<uint64_t> s_FreeHead{ NO_SLOT };
+
+        ObjectSlot* FindSlot(uint32_t index)
+        {
+            const uint32_t page = index / ObjectRegistry::PAGE_SIZE;
+            if (page >= ObjectRegistry::MAX_PAGES)
+                return nullptr;
+
+            ObjectSlot* slots = s_Pages[page].load(std::memory_order_acquire);
+            return slots ? &slots[index % ObjectRegistry::PAGE_SIZE] : nullptr;
+        }
+
+        ObjectSlot* EnsureSlot(uint32_t index)
+        {
+            std::atomic<ObjectSlot*>& page = s_Pages[index / ObjectRegistry::PAGE_SIZE];
+
+            ObjectSlot* slots = page.load(std::memory_order_acquire);
+            if (!slots)
+            {
+                // Several threads can cross into a new page at once, one allocation wins.
+                ObjectSlot* fresh = new ObjectSlot[ObjectRegistry::PAGE_SIZE];
+                if (page.compare_exchange_strong(slots, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+                    slots = fresh;
+                else
+                    delete[] fresh;
+            }
+
+            return &slots[index % ObjectRegistry::PAGE_SIZE];
+        }
+
+        uint32_t PopFree()
+        {
+            uint64_t head = s_FreeHead.load(std::memory_order_acquire);
+            while (uint32_t(head) != NO_SLOT)
+            {
+                const uint32_t index = uint32_t(head);
+                const uint32_t next = FindSlot(index)->m_NextFree.load(std::memory_order_relaxed);
+                const uint64_t replacement = (((head >> 32) + 1) << 32) | next;
+
+                if (s_FreeHead.compare_exchange_weak(head, replacement, std::memory_order_acq_rel, std::memory_order_acquire))
+                    return index;
+            }
+            return NO_SLOT;
+        }
+
+        void PushFree(uint32_t index, ObjectSlot* slot)
+        {
+            uint64_t head = s_FreeHead.load(std::memory_order_relaxed);
+            uint64_t replacement;
+            do
+            {
+                slot->m_NextFree.store(uint32_t(head), std::memory_order_relaxed);
+                replacement = (((head >> 32) + 1) << 32) | index;
+            } while (!s_FreeHead.compare_exchange_weak(head, replacement, std::memory_order_release, std::memory_order_relaxed));
+        }
+    }
+
+    ObjectHandle ObjectRegistry::Register(Object* object)
+    {
+        uint32_t index = PopFree();
+        if (index == NO_SLOT)
+        {
+            index = s_SlotCount.fetch_add(1, std::memory_order_relaxed);
+            if (index >= PAGE_SIZE * MAX_PAGES)
+            {
+                s_SlotCount.fetch_sub(1, std::memory_order_relaxed);
+                ISLE_ERROR("ObjectRegistry: out of slots, object is not registered\n");
+                return {};
+            }
+        }
+
+        ObjectSlot* slot = EnsureSlot(index);
+        slot->m_Object.store(object, std::memory_order_release);
+        s_LiveCount.fetch_add(1, std::memory_order_relaxed);
+
+        return { index, slot->m_Generation.load(std::memory_order_acquire) };
+    }
+
+    void ObjectRegistry::Unregister(ObjectHandle handle)
+    {
+        if (handle.IsNull())
+            return;
+
+        ObjectSlot* slot = FindSlot(handle.m_Index);
+        if (!slot || slot->m_Generation.load(std::memory_order_acquire) != handle.m_Generation)
+            return;
+
+        // Retire the generation before the slot can be reused, Resolve() checks it on both
+        // sides of reading the pointer.
+        slot->m_Object.store(nullptr, std::memory_order_relaxed);
+        slot->m_Generation.fetch_add(1, std::memory_order_acq_rel);
+        s_LiveCount.fetch_sub(1, std::memory_order_relaxed);
+
+        PushFree(handle.m_Index, slot);
+    }
+
+    Object* ObjectRegistry::Resolve(ObjectHandle handle)
+    {
+        if (handle.IsNull())
+            return nullptr;
+
+        ObjectSlot* slot = FindSlot(handle.m_Index);
+        if (!slot || slot->m_Generation.load(std::memory_order_acquire) != handle.m_Generation)
+            return nullptr;
+
+        Object* object = slot->m_Object.load(std::memory_order_acquire);
+        if (slot->m_Generation.load(std::memory_order_acquire) != handle.m_Generation)
+            return nullptr;
+
+        return object;
+    }
+
+    uint32_t ObjectRegistry::GetLiveCount()
+    {
+        return s_LiveCount.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,45 @@
+// ObjectRegistry.h
+#pragma once
+#include <cstdint>
+
+namespace Isle
+{
+    class Object;
+
+    // Slot index plus the generation the slot had when the object took it. Once the object
+    // is destroyed the slot's generation moves on, so old handles stop resolving even after
+    // the slot is handed to someone else.
+    struct ObjectHandle
+    {
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        uint32_t m_Index = INVALID_INDEX;
+        uint32_t m_Generation = 0;
+
+        bool IsNull() const { return m_Index == INVALID_INDEX; }
+
+        uint64_t GetValue() const { return (uint64_t(m_Generation) << 32) | m_Index; }
+        static ObjectHandle FromValue(uint64_t value) { return { uint32_t(value), uint32_t(value >> 32) }; }
+
+        bool operator==(const ObjectHandle& other) const = default;
+    };
+
+    // Every live Object, as a generational slot map. Slots live in pages that are never
+    // moved or freed and released slots go on a lock free stack, so registering, releasing
+    // and resolving never take a lock.
+    //
+    // Resolve() only says whether the handle still names a live object, it does not keep
+    // it alive. Use the result on the thread that owns the object, or hold a Ref.
+    class ISLEENGINE_API ObjectRegistry
+    {
+    public:
+        static constexpr uint32_t PAGE_SIZE = 4096;
+        static constexpr uint32_t MAX_PAGES = 16384;
+
+    public:
+        static ObjectHandle Register(Object* object);
+        static void Unregister(ObjectHandle handle);
+        static Object* Resolve(ObjectHandle handle);
+        static uint32_t GetLiveCount();
+    };
+}
@@ -0,0 +1,479 @@
+// Profiler.cpp
+#include <Core/Common/Common.h>
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
+#include <fstream>
+
+namespace Isle
+{
+    namespace
+    {
+        constexpr uint32_t MAX_THREADS = 64;
+        constexpr uint32_t EVENT_MASK = Profiler::THREAD_EVENT_CAPACITY - 1;
+        static_assert((Profiler::THREAD_EVENT_CAPACITY & EVENT_MASK) == 0, "Event capacity must be a power of two");
+
+        // Single producer (the owning thread), single consumer (EndFrame).
+        struct ThreadBuffer
+        {
+            ProfileEvent m_Events[Profiler::THREAD_EVENT_CAPACITY];
+            std::atomic<uint32_t> m_Write{ 0 };
+            std::atomic<uint32_t> m_Read{ 0 };
+            std::atomic<uint32_t> m_Dropped{ 0 };
+            std::atomic<bool> m_Retired{ false };
+            std::atomic<bool> m_Free{ false };
+            const char* m_Name = nullptr;
+            uint32_t m_Thread = 0;
+            uint32_t m_Depth = 0;
+        };
+
+        struct ThreadSlot
+        {
+            ThreadBuffer* m_Buffer = nullptr;
+
+            ~ThreadSlot()
+            {
+                if (m_Buffer)
+                    m_Buffer->m_Retired.store(true, std::memory_order_release);
+            }
+        };
+
+        struct GpuQueryFrame
+        {
+            GLuint m_Queries[Profiler::GPU_SCOPES_PER_FRAME * 2] = {};
+            const char* m_Names[Profiler::GPU_SCOPES_PER_FRAME] = {};
+            uint32_t m_Depths[Profiler::GPU_SCOPES_PER_FRAME] = {};
+            uint32_t m_Count = 0;
+            uint64_t m_FrameIndex = 0;
+            int64_t m_CpuOffset = 0;
+            bool m_Pending = false;
+        };
+
+        const auto s_Epoch = std::chrono::high_resolution_clock::now();
+
+        std::atomic<bool> s_Enabled{ true };
+        std::atomic<bool> s_Paused{ false };
+
+        std::mutex s_RegistryMutex;
+        std::unique_ptr<ThreadBuffer> s_BufferStorage[MAX_THREADS];
+        std::atomic<ThreadBuffer*> s_Buffers[MAX_THREADS] = {};
+        std::atomic<uint32_t> s_BufferCount{ 0 };
+        thread_local ThreadSlot t_Slot;
+
+        ProfileFrame s_Frames[Profiler::FRAME_COUNT];
+        uint64_t s_FrameCount = 0;
+        uint64_t s_FrameStart = 0;
+
+        GpuQueryFrame s_GpuFrames[Profiler::GPU_QUERY_FRAMES];
+        uint32_t s_GpuStack[Profiler::GPU_SCOPES_PER_FRAME];
+        uint32_t s_GpuStackSize = 0;
+        bool s_GpuInitialized = false;
+        bool s_GpuFrameOpen = false;
+
+        ThreadBuffer* GetThreadBuffer()
+        {
+            if (t_Slot.m_Buffer)
+                return t_Slot.m_Buffer;
+
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+            const uint32_t count = s_BufferCount.load(std::memory_order_relaxed);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                ThreadBuffer* buffer = s_Buffers[i].load(std::memory_order_relaxed);
+                if (buffer->m_Free.load(std::memory_order_acquire))
+                {
+                    buffer->m_Free.store(false, std::memory_order_relaxed);
+                    buffer->m_Name = nullptr;
+                    buffer->m_Depth = 0;
+                    t_Slot.m_Buffer = buffer;
+                    return buffer;
+                }
+            }
+
+            if (count == MAX_THREADS)
+                return nullptr;
+
+            s_BufferStorage[count] = std::make_unique<ThreadBuffer>();
+            ThreadBuffer* buffer = s_BufferStorage[count].get();
+            buffer->m_Thread = count + 1;
+            s_Buffers[count].store(buffer, std::memory_order_release);
+            s_BufferCount.store(count + 1, std::memory_order_release);
+
+            t_Slot.m_Buffer = buffer;
+            return buffer;
+        }
+
+        // Moves everything the thread recorded since the last frame into out (or drops it).
+        void DrainThread(ThreadBuffer* buffer, ProfileFrame* out)
+        {
+            const bool retired = buffer->m_Retired.load(std::memory_order_acquire);
+            const uint32_t write = buffer->m_Write.load(std::memory_order_acquire);
+            uint32_t read = buffer->m_Read.load(std::memory_order_relaxed);
+
+            if (out)
+            {
+                for (; read != write; read++)
+                    out->m_CpuEvents.push_back(buffer->m_Events[read & EVENT_MASK]);
+                out->m_DroppedEvents += buffer->m_Dropped.exchange(0, std::memory_order_relaxed);
+            }
+            else
+            {
+                buffer->m_Dropped.store(0, std::memory_order_relaxed);
+            }
+
+            buffer->m_Read.store(write, std::memory_order_release);
+
+            if (retired)
+            {
+                buffer->m_Retired.store(false, std::memory_order_relaxed);
+                buffer->m_Free.store(true, std::memory_order_release);
+            }
+        }
+
+        ProfileFrame* FindFrame(uint64_t index)
+        {
+            if (index >= s_FrameCount || s_FrameCount - index > Profiler::FRAME_COUNT)
+                return nullptr;
+
+            ProfileFrame& frame = s_Frames[index % Profiler::FRAME_COUNT];
+            return frame.m_Index == index ? &frame : nullptr;
+        }
+
+        // Timestamps land in order, so once the last query is available all of them are.
+        void ResolveGpuFrame(GpuQueryFrame& gpu)
+        {
+            if (!gpu.m_Pending)
+                return;
+
+            if (gpu.m_Count == 0)
+            {
+                gpu.m_Pending = false;
+                return;
+            }
+
+            GfxDevice* device = GfxDevice::Get();
+            if (!device->IsQueryAvailable(gpu.m_Queries[gpu.m_Count * 2 - 1]))
+                return;
+
+            gpu.m_Pending = false;
+
+            ProfileFrame* frame = FindFrame(gpu.m_FrameIndex);
+            if (!frame)
+                return;
+
+            frame->m_GpuEvents.clear();
+            for (uint32_t i = 0; i < gpu.m_Count; i++)
+            {
+                const uint64_t begin = device->GetQueryResult(gpu.m_Queries[i * 2]);
+                const uint64_t end = device->GetQueryResult(gpu.m_Queries[i * 2 + 1]);
+
+                ProfileEvent event;
+                event.m_Name = gpu.m_Names[i];
+                event.m_Start = uint64_t(int64_t(begin) + gpu.m_CpuOffset);
+                event.m_End = uint64_t(int64_t(end) + gpu.m_CpuOffset);
+                event.m_Depth = gpu.m_Depths[i];
+                event.m_Thread = Profiler::GPU_THREAD;
+                frame->m_GpuEvents.push_back(event);
+            }
+
+            frame->m_GpuResolved = true;
+        }
+
+        void WriteJsonString(std::ofstream& file, const char* text)
+        {
+            file << '"';
+            for (const char* c = text ? text : ""; *c; c++)
+            {
+                if (*c == '"' || *c == '\\')
+                    file << '\\' << *c;
+                else if ((unsigned char)*c < 0x20)
+                    file << ' ';
+                else
+                    file << *c;
+            }
+            file << '"';
+        }
+    }
+
+    double ProfileFrame::GetGpuMs() const
+    {
+        uint64_t total = 0;
+        for (const ProfileEvent& event : m_GpuEvents)
+        {
+            if (event.m_Depth == 0)
+                total += event.m_End - event.m_Start;
+        }
+        return total / 1e6;
+    }
+
+    uint64_t Profiler::Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - s_Epoch).count();
+    }
+
+    void Profiler::SetEnabled(bool enabled)
+    {
+        s_Enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::IsEnabled()
+    {
+        return s_Enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::SetPaused(bool paused)
+    {
+        s_Paused.store(paused, std::memory_order_relaxed);
+    }
+
+    bool Profiler::IsPaused()
+    {
+        return s_Paused.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        if (ThreadBuffer* buffer = GetThreadBuffer())
+            buffer->m_Name = name;
+    }
+
+    const char* Profiler::GetThreadName(uint32_t thread)
+    {
+        if (thread == GPU_THREAD)
+            return "GPU";
+
+        if (thread > s_BufferCount.load(std::memory_order_acquire))
+            return "Unknown";
+
+        const ThreadBuffer* buffer = s_Buffers[thread - 1].load(std::memory_order_acquire);
+        return buffer->m_Name ? buffer->m_Name : "Worker";
+    }
+
+    uint32_t Profiler::GetThreadCount()
+    {
+        return s_BufferCount.load(std::memory_order_acquire) + 1;
+    }
+
+    uint32_t Profiler::BeginEvent()
+    {
+        ThreadBuffer* buffer = GetThreadBuffer();
+        if (!buffer)
+            return UINT32_MAX;
+
+        return buffer->m_Depth++;
+    }
+
+    void Profiler::EndEvent(const char* name, uint64_t start, uint32_t depth)
+    {
+        const uint64_t end = Now();
+
+        ThreadBuffer* buffer = t_Slot.m_Buffer;
+        buffer->m_Depth = depth;
+
+        const uint32_t write = buffer->m_Write.load(std::memory_order_relaxed);
+        if (write - buffer->m_Read.load(std::memory_order_acquire) >= THREAD_EVENT_CAPACITY)
+        {
+            buffer->m_Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        ProfileEvent& event = buffer->m_Events[write & EVENT_MASK];
+        event.m_Name = name;
+        event.m_Start = start;
+        event.m_End = end;
+        event.m_Depth = depth;
+        event.m_Thread = buffer->m_Thread;
+
+        buffer->m_Write.store(write + 1, std::memory_order_release);
+    }
+
+    void Profiler::BeginGpuEvent(const char* name)
+    {
+        if (IsPaused() || s_GpuStackSize == GPU_SCOPES_PER_FRAME)
+            return;
+
+        if (!s_GpuInitialized)
+        {
+            for (GpuQueryFrame& gpu : s_GpuFrames)
+                GfxDevice::Get()->CreateQueries(GPU_SCOPES_PER_FRAME * 2, gpu.m_Queries);
+            s_GpuInitialized = true;
+        }
+
+        GpuQueryFrame& gpu = s_GpuFrames[s_FrameCount % GPU_QUERY_FRAMES];
+        if (!s_GpuFrameOpen)
+        {
+            // Still unresolved after GPU_QUERY_FRAMES frames, give up on it rather than wait.
+            gpu.m_Pending = false;
+            gpu.m_Count = 0;
+            gpu.m_FrameIndex = s_FrameCount;
+
+            const int64_t gpuNow = GfxDevice::Get()->GetTimestamp();
+            gpu.m_CpuOffset = int64_t(Now()) - gpuNow;
+
+            s_GpuFrameOpen = true;
+        }
+
+        uint32_t index = UINT32_MAX;
+        if (gpu.m_Count < GPU_SCOPES_PER_FRAME)
+        {
+            index = gpu.m_Count++;
+            gpu.m_Names[index] = name;
+            gpu.m_Depths[index] = s_GpuStackSize;
+            GfxDevice::Get()->QueryTimestamp(gpu.m_Queries[index * 2]);
+        }
+
+        s_GpuStack[s_GpuStackSize++] = index;
+    }
+
+    void Profiler::EndGpuEvent()
+    {
+        if (s_GpuStackSize == 0)
+            return;
+
+        const uint32_t index = s_GpuStack[--s_GpuStackSize];
+        if (index == UINT32_MAX || !s_GpuFrameOpen)
+            return;
+
+        GpuQueryFrame& gpu = s_GpuFrames[s_FrameCount % GPU_QUERY_FRAMES];
+        GfxDevice::Get()->QueryTimestamp(gpu.m_Queries[index * 2 + 1]);
+    }
+
+    void Profiler::EndFrame()
+    {
+        const uint64_t now = Now();
+        const bool paused = IsPaused();
+
+        ProfileFrame* frame = nullptr;
+        if (!paused)
+        {
+            frame = &s_Frames[s_FrameCount % FRAME_COUNT];
+            frame->m_Index = s_FrameCount;
+            frame->m_Start = s_FrameStart;
+            frame->m_End = now;
+            frame->m_DroppedEvents = 0;
+            frame->m_GpuResolved = false;
+            frame->m_CpuEvents.clear();
+            frame->m_GpuEvents.clear();
+        }
+
+        const uint32_t count = s_BufferCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; i++)
+            DrainThread(s_Buffers[i].load(std::memory_order_acquire), frame);
+
+        if (frame)
+        {
+            std::sort(frame->m_CpuEvents.begin(), frame->m_CpuEvents.end(),
+                [](const ProfileEvent& a, const ProfileEvent& b) { return a.m_Start < b.m_Start; });
+        }
+
+        if (s_GpuFrameOpen)
+        {
+            // Scopes left open never wrote their end timestamp, the frame can't be resolved.
+            GpuQueryFrame& gpu = s_GpuFrames[s_FrameCount % GPU_QUERY_FRAMES];
+            gpu.m_Pending = s_GpuStackSize == 0;
+            s_GpuStackSize = 0;
+            s_GpuFrameOpen = false;
+        }
+
+        if (s_GpuInitialized)
+        {
+            for (GpuQueryFrame& gpu : s_GpuFrames)
+                ResolveGpuFrame(gpu);
+        }
+
+        if (!paused)
+            s_FrameCount++;
+
+        s_FrameStart = now;
+    }
+
+    void Profiler::Shutdown()
+    {
+        if (s_GpuInitialized)
+        {
+            for (GpuQueryFrame& gpu : s_GpuFrames)
+            {
+                GfxDevice::Get()->DestroyQueries(GPU_SCOPES_PER_FRAME * 2, gpu.m_Queries);
+                gpu = GpuQueryFrame();
+            }
+            s_GpuInitialized = false;
+        }
+
+        s_GpuStackSize = 0;
+        s_GpuFrameOpen = false;
+    }
+
+    const ProfileFrame* Profiler::GetFrame(uint32_t framesAgo)
+    {
+        if (framesAgo >= s_FrameCount)
+            return nullptr;
+
+        return FindFrame(s_FrameCount - 1 - framesAgo);
+    }
+
+    uint32_t Profiler::GetFrameCount()
+    {
+        return (uint32_t)std::min<uint64_t>(s_FrameCount, FRAME_COUNT);
+    }
+
+    double Profiler::GetLatestGpuMs()
+    {
+        for (uint32_t i = 0; i < GetFrameCount(); i++)
+        {
+            const ProfileFrame* frame = GetFrame(i);
+            if (frame && frame->m_GpuResolved)
+                return frame->GetGpuMs();
+        }
+        return 0.0;
+    }
+
+    bool Profiler::ExportChromeTrace(const std::string& path)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            ISLE_ERROR("Failed to write trace: %s\n", path.c_str());
+            return false;
+        }
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+        bool first = true;
+        auto writeEvent = [&](const ProfileEvent& event)
+        {
+            char times[96];
+            snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f",
+                event.m_Start / 1e3, (event.m_End - event.m_Start) / 1e3);
+
+            file << (first ? "" : ",\n") << "{\"name\":";
+            WriteJsonString(file, event.m_Name);
+            file << ",\"cat\":\"" << (event.m_Thread == GPU_THREAD ? "gpu" : "cpu")
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.m_Thread << ',' << times << '}';
+            first = false;
+        };
+
+        for (uint32_t i = GetFrameCount(); i-- > 0;)
+        {
+            const ProfileFrame* frame = GetFrame(i);
+            if (!frame)
+                continue;
+
+            for (const ProfileEvent& event : frame->m_CpuEvents)
+                writeEvent(event);
+            for (const ProfileEvent& event : frame->m_GpuEvents)
+                writeEvent(event);
+        }
+
+        for (uint32_t thread = 0; thread < GetThreadCount(); thread++)
+        {
+            file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                 << thread << ",\"args\":{\"name\":";
+            WriteJsonString(file, GetThreadName(thread));
+            file << "}}";
+            first = false;
+        }
+
+        file << "\n]}\n";
+        return true;
+    }
+}
@@ -1,105 +1,164 @@
 #pragma once
+#include <atomic>
 #include <chrono>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace Isle
 {
-    class ScopedTimer
+    // Names must outlive the profiler, string literals are the intended use. Recording a
+    // scope never allocates and never locks: every thread appends to its own ring.
+    struct ProfileEvent
     {
-    public:
-        ScopedTimer(const std::string& name);
-        ~ScopedTimer();
+        const char* m_Name = nullptr;
+        uint64_t m_Start = 0;
+        uint64_t m_End = 0;
+        uint32_t m_Depth = 0;
+        uint32_t m_Thread = 0;
 
-    private:
-        std::string m_Name;
-        std::chrono::high_resolution_clock::time_point m_StartTime;
+        double GetMs() const { return (m_End - m_Start) / 1e6; }
     };
 
-    class Profiler
+    struct ProfileFrame
     {
-    public:
-        static void BeginSection(const std::string& name);
-        static void EndSection(const std::string& name);
-        static void PrintResults();
-        static void Clear();
+        uint64_t m_Index = 0;
+        uint64_t m_Start = 0;
+        uint64_t m_End = 0;
+        uint32_t m_DroppedEvents = 0;
+        bool m_GpuResolved = false;
 
-    private:
-        struct TimingData
-        {
-            double totalMs = 0.0;
-            int callCount = 0;
-            std::chrono::high_resolution_clock::time_point startTime;
-        };
+        std::vector<ProfileEvent> m_CpuEvents;
+        std::vector<ProfileEvent> m_GpuEvents;
 
-        static std::unordered_map<std::string, TimingData> s_Timings;
-        static std::vector<std::pair<std::string, double>> s_OrderedResults;
+        double GetMs() const { return (m_End - m_Start) / 1e6; }
+        double GetGpuMs() const;
     };
 
-    inline ScopedTimer::ScopedTimer(const std::string& name)
-        : m_Name(name)
+    class ISLEENGINE_API Profiler
     {
-        m_StartTime = std::chrono::high_resolution_clock::now();
-    }
+    public:
+        static constexpr uint32_t FRAME_COUNT = 128;
+        static constexpr uint32_t THREAD_EVENT_CAPACITY = 1 << 14;
+        static constexpr uint32_t GPU_QUERY_FRAMES = 4;
+        static constexpr uint32_t GPU_SCOPES_PER_FRAME = 64;
+        static constexpr uint32_t GPU_THREAD = 0;
 
-    inline ScopedTimer::~ScopedTimer()
-    {
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - m_StartTime);
-        double ms = duration.count() / 1000.0;
+        // Nanoseconds since the profiler started.
+        static uint64_t Now();
 
-        ISLE_LOG("[PROFILE] %s: %.2fms\n", m_Name.c_str(), ms);
-    }
+        static void SetEnabled(bool enabled);
+        static bool IsEnabled();
+        static void SetPaused(bool paused);
+        static bool IsPaused();
 
-    inline std::unordered_map<std::string, Profiler::TimingData> Profiler::s_Timings;
-    inline std::vector<std::pair<std::string, double>> Profiler::s_OrderedResults;
+        static void SetThreadName(const char* name);
+        static const char* GetThreadName(uint32_t thread);
+        static uint32_t GetThreadCount();
 
-    inline void Profiler::BeginSection(const std::string& name)
-    {
-        auto& data = s_Timings[name];
-        data.startTime = std::chrono::high_resolution_clock::now();
-    }
+        static uint32_t BeginEvent();
+        static void EndEvent(const char* name, uint64_t start, uint32_t depth);
 
-    inline void Profiler::EndSection(const std::string& name)
-    {
-        auto it = s_Timings.find(name);
-        if (it == s_Timings.end())
-            return;
+        // GL timestamp pairs, resolved a few frames later without stalling.
+        static void BeginGpuEvent(const char* name);
+        static void EndGpuEvent();
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - it->second.startTime);
-        double ms = duration.count() / 1000.0;
+        // Frame mark: collects every thread's events into the frame ring.
+        static void EndFrame();
+        static void Shutdown();
 
-        it->second.totalMs += ms;
-        it->second.callCount++;
-    }
+        // 0 is the last finished frame. Returns null past the recorded history.
+        static const ProfileFrame* GetFrame(uint32_t framesAgo = 0);
+        static uint32_t GetFrameCount();
 
-    inline void Profiler::PrintResults()
+        // Sum of the outermost GPU scopes of the newest frame whose queries resolved.
+        static double GetLatestGpuMs();
+
+        static bool ExportChromeTrace(const std::string& path);
+    };
+
+    class ProfileScope
     {
-        s_OrderedResults.clear();
+    public:
+        explicit ProfileScope(const char* name)
+            : m_Name(name), m_Depth(Profiler::IsEnabled() ? Profiler::BeginEvent() : UINT32_MAX)
+        {
+            if (m_Depth != UINT32_MAX)
+                m_Start = Profiler::Now();
+        }
 
-        for (const auto& [name, data] : s_Timings)
+        ~ProfileScope()
         {
-            s_OrderedResults.push_back({ name, data.totalMs });
+            if (m_Depth != UINT32_MAX)
+                Profiler::EndEvent(m_Name, m_Start, m_Depth);
         }
 
-        std::sort(s_OrderedResults.begin(), s_OrderedResults.end(),
-            [](const auto& a, const auto& b) { return a.second > b.second; });
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_Name;
+        uint32_t m_Depth;
+        uint64_t m_Start = 0;
+    };
+
+    class GpuProfileScope
+    {
+    public:
+        explicit GpuProfileScope(const char* name)
+            : m_Active(Profiler::IsEnabled())
+        {
+            if (m_Active)
+                Profiler::BeginGpuEvent(name);
+        }
 
-        ISLE_LOG("=== Profiler Results ===\n");
-        for (const auto& [name, ms] : s_OrderedResults)
+        ~GpuProfileScope()
         {
-            const auto& data = s_Timings[name];
-            ISLE_LOG("%s: %.2fms (calls: %d, avg: %.2fms)\n",
-                name.c_str(), ms, data.callCount, ms / data.callCount);
+            if (m_Active)
+                Profiler::EndGpuEvent();
         }
-        ISLE_LOG("========================\n");
+
+        GpuProfileScope(const GpuProfileScope&) = delete;
+        GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+    private:
+        bool m_Active;
+    };
+
+    // Profile scope that also logs its duration in debug builds.
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(const char* name);
+        ~ScopedTimer();
+
+    private:
+        ProfileScope m_Scope;
+        const char* m_Name;
+        std::chrono::high_resolution_clock::time_point m_StartTime;
+    };
+
+    inline ScopedTimer::ScopedTimer(const char* name)
+        : m_Scope(name), m_Name(name)
+    {
+        m_StartTime = std::chrono::high_resolution_clock::now();
     }
 
-    inline void Profiler::Clear()
+    inline ScopedTimer::~ScopedTimer()
     {
-        s_Timings.clear();
-        s_OrderedResults.clear();
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - m_StartTime);
+        double ms = duration.count() / 1000.0;
+
+        ISLE_LOG("[PROFILE] %s: %.2fms\n", m_Name, ms);
+        (void)ms;
     }
-}
\ No newline at end of file
+}
+
+#define ISLE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ISLE_PROFILE_CONCAT(a, b) ISLE_PROFILE_CONCAT_INNER(a, b)
+
+#define ISLE_PROFILE_SCOPE(name) ::Isle::ProfileScope ISLE_PROFILE_CONCAT(_isleProfileScope, __LINE__)(name)
+#define ISLE_PROFILE_FUNCTION() ISLE_PROFILE_SCOPE(__FUNCTION__)
+#define ISLE_PROFILE_GPU_SCOPE(name) \
+    ISLE_PROFILE_SCOPE(name); \
+    ::Isle::GpuProfileScope ISLE_PROFILE_CONCAT(_isleGpuProfileScope, __LINE__)(name)
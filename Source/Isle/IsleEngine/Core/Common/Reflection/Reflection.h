@@ -1,8 +1,11 @@
 #pragma once
 #include <Core/Common/Common.h>
+#include <Core/Common/Serialization/BinaryStream.h>
 #include <functional>
 #include <any>
 #include <typeindex>
+#include <atomic>
+#include <cstring>
 
 namespace Isle
 {
@@ -22,6 +25,8 @@ namespace Isle
         Vec4,
         Color,
         Object,
+        UInt,
+        Quat,
         Unknown
     };
 
@@ -37,6 +42,51 @@ namespace Isle
         VisibleAnywhere = 1 << 6
     };
 
+    template<typename T>
+    constexpr PropertyType PropertyTypeOf()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return PropertyType::Bool;
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            return PropertyType::Int;
+        else if constexpr (std::is_integral_v<T>)
+            return PropertyType::UInt;
+        else if constexpr (std::is_same_v<T, float>)
+            return PropertyType::Float;
+        else if constexpr (std::is_same_v<T, std::string>)
+            return PropertyType::String;
+        else if constexpr (std::is_same_v<T, glm::vec2>)
+            return PropertyType::Vec2;
+        else if constexpr (std::is_same_v<T, glm::vec3>)
+            return PropertyType::Vec3;
+        else if constexpr (std::is_same_v<T, glm::vec4>)
+            return PropertyType::Vec4;
+        else if constexpr (std::is_same_v<T, glm::quat>)
+            return PropertyType::Quat;
+        else if constexpr (std::is_base_of_v<Object, T>)
+            return PropertyType::Object;
+        else
+            return PropertyType::Unknown;
+    }
+
+    // offsetof does not take member pointers and is only conditionally supported for
+    // classes with virtual functions, so measure the member against a dummy address.
+    template<typename ClassType, typename PropType>
+    uint32_t MemberOffset(PropType ClassType::* member)
+    {
+        constexpr uintptr_t base = 0x1000;
+        const ClassType* object = reinterpret_cast<const ClassType*>(base);
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&(object->*member)) - base);
+    }
+
+    template<typename Derived, typename Base>
+    uint32_t BaseOffset()
+    {
+        constexpr uintptr_t base = 0x1000;
+        Derived* object = reinterpret_cast<Derived*>(base);
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(static_cast<Base*>(object)) - base);
+    }
+
     class PropertyBase
     {
     protected:
@@ -45,6 +95,10 @@ namespace Isle
         uint32_t m_Flags;
         std::string m_Category;
         std::string m_Tooltip;
+        uint32_t m_Offset = 0;
+        uint32_t m_Size = 0;
+        bool m_Trivial = false;
+        bool m_Serializable = false;
 
     public:
         PropertyBase(const std::string& name, PropertyType type, uint32_t flags = PropertyFlags::EditAnywhere)
@@ -59,11 +113,30 @@ namespace Isle
         const std::string& GetCategory() const { return m_Category; }
         const std::string& GetTooltip() const { return m_Tooltip; }
 
+        // Byte offset of the member inside the class that registered it.
+        uint32_t GetOffset() const { return m_Offset; }
+        uint32_t GetSize() const { return m_Size; }
+        // Trivially copyable members are copied, compared and saved as raw bytes.
+        bool IsTrivial() const { return m_Trivial; }
+
+        // Strings and trivially copyable members that are not Transient.
+        bool IsSerializable() const { return m_Serializable; }
+        size_t GetSerializedSize() const { return m_Trivial ? m_Size : 0; }   // 0 for strings, their length is stored
+
         void SetCategory(const std::string& category) { m_Category = category; }
         void SetTooltip(const std::string& tooltip) { m_Tooltip = tooltip; }
 
+        // Boxed access for tools, allocates for anything larger than a pointer. Code that
+        // touches many properties should go through ClassDescriptor::GetLayout() instead.
         virtual std::any GetValue(void* instance) const = 0;
         virtual void SetValue(void* instance, const std::any& value) = 0;
+
+        // The slow path for members that are not trivially copyable. These take a pointer
+        // to the member itself, see PropertyField::GetField().
+        virtual void CopyField(void* destination, const void* source) const = 0;
+        virtual bool FieldEquals(const void* a, const void* b) const = 0;
+        virtual void Serialize(const void* field, BinaryWriter& writer) const = 0;
+        virtual void Deserialize(void* field, BinaryReader& reader) const = 0;
     };
 
     template<typename ClassType, typename PropType>
@@ -74,9 +147,13 @@ namespace Isle
 
     public:
         Property(const std::string& name, PropType ClassType::* memberPtr, uint32_t flags = PropertyFlags::EditAnywhere)
-            : PropertyBase(name, DeducePropertyType<PropType>(), flags)
+            : PropertyBase(name, PropertyTypeOf<PropType>(), flags)
             , m_MemberPtr(memberPtr)
         {
+            m_Offset = MemberOffset(memberPtr);
+            m_Size = static_cast<uint32_t>(sizeof(PropType));
+            m_Trivial = std::is_trivially_copyable_v<PropType>;
+            m_Serializable = !(flags & PropertyFlags::Transient) && (m_Trivial || std::is_same_v<PropType, std::string>);
         }
 
         std::any GetValue(void* instance) const override
@@ -91,31 +168,67 @@ namespace Isle
             obj->*m_MemberPtr = std::any_cast<PropType>(value);
         }
 
-    private:
-        template<typename T>
-        static PropertyType DeducePropertyType()
-        {
-            if constexpr (std::is_same_v<T, int> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>)
-                return PropertyType::Int;
-            else if constexpr (std::is_same_v<T, size_t>)
-                return PropertyType::Int;
-            else if constexpr (std::is_same_v<T, float>)
-                return PropertyType::Float;
-            else if constexpr (std::is_same_v<T, bool>)
-                return PropertyType::Bool;
-            else if constexpr (std::is_same_v<T, std::string>)
-                return PropertyType::String;
-            else if constexpr (std::is_same_v<T, glm::vec2>)
-                return PropertyType::Vec2;
-            else if constexpr (std::is_same_v<T, glm::vec3>)
-                return PropertyType::Vec3;
-            else if constexpr (std::is_same_v<T, glm::vec4>)
-                return PropertyType::Vec4;
-            else if constexpr (std::is_base_of_v<Object, T>)
-                return PropertyType::Object;
+        void CopyField(void* destination, const void* source) const override
+        {
+            if constexpr (std::is_copy_assignable_v<PropType>)
+                *static_cast<PropType*>(destination) = *static_cast<const PropType*>(source);
+        }
+
+        bool FieldEquals(const void* a, const void* b) const override
+        {
+            if constexpr (std::equality_comparable<PropType>)
+                return *static_cast<const PropType*>(a) == *static_cast<const PropType*>(b);
             else
-                return PropertyType::Unknown;
+                return false;
         }
+
+        void Serialize(const void* field, BinaryWriter& writer) const override
+        {
+            if constexpr (std::is_same_v<PropType, std::string>)
+                writer.WriteString(*static_cast<const std::string*>(field));
+            else if constexpr (std::is_trivially_copyable_v<PropType>)
+                writer.WriteBytes(field, sizeof(PropType));
+        }
+
+        void Deserialize(void* field, BinaryReader& reader) const override
+        {
+            if constexpr (std::is_same_v<PropType, std::string>)
+                *static_cast<std::string*>(field) = std::string(reader.ReadString());
+            else if constexpr (std::is_trivially_copyable_v<PropType>)
+                reader.ReadBytes(field, sizeof(PropType));
+        }
+    };
+
+    // One entry of a class's flattened property table. The offset is from the start of an
+    // instance of that class with inherited properties rebased, so a field is one add away.
+    struct PropertyField
+    {
+        const PropertyBase* m_Property = nullptr;
+        uint32_t m_Offset = 0;
+        uint32_t m_Size = 0;
+        PropertyType m_Type = PropertyType::Unknown;
+        uint32_t m_Flags = 0;
+        bool m_Trivial = false;
+
+        template<typename T>
+        bool Is() const { return m_Type == PropertyTypeOf<T>() && m_Size == sizeof(T); }
+
+        void* GetField(void* instance) const { return static_cast<uint8_t*>(instance) + m_Offset; }
+        const void* GetField(const void* instance) const { return static_cast<const uint8_t*>(instance) + m_Offset; }
+
+        // Typed access, nullptr when T is not the registered type.
+        template<typename T>
+        T* Get(void* instance) const { return Is<T>() ? static_cast<T*>(GetField(instance)) : nullptr; }
+
+        template<typename T>
+        const T* Get(const void* instance) const { return Is<T>() ? static_cast<const T*>(GetField(instance)) : nullptr; }
+    };
+
+    // Adjacent trivially copyable fields merged into one memcpy/memcmp range.
+    struct PropertySpan
+    {
+        uint32_t m_Offset;
+        uint32_t m_Size;
     };
 
     class FunctionBase
@@ -183,12 +296,26 @@ namespace Isle
 
     class ClassDescriptor
     {
+    public:
+        using FactoryFunction = Object* (*)();
+
     private:
         std::string m_Name;
         std::type_index m_TypeIndex;
-        std::unordered_map<std::string, std::unique_ptr<PropertyBase>> m_Properties;
+        std::vector<std::unique_ptr<PropertyBase>> m_Properties;    // own properties, registration order
         std::unordered_map<std::string, std::unique_ptr<FunctionBase>> m_Functions;
         ClassDescriptor* m_Parent;
+        uint32_t m_ParentOffset = 0;
+        FactoryFunction m_Factory = nullptr;
+
+        // Flattened tables, rebuilt on first use after anything in the registry changed.
+        // Registrars from another translation unit can add parent properties after this
+        // class registered, so they cannot be built eagerly.
+        mutable std::vector<PropertyField> m_Layout;
+        mutable std::vector<PropertySpan> m_TrivialSpans;
+        mutable std::vector<uint32_t> m_NonTrivialFields;
+        mutable std::unordered_map<std::string, uint32_t> m_LayoutIndex;
+        mutable std::atomic<uint32_t> m_LayoutGeneration{ UINT32_MAX };
 
     public:
         ClassDescriptor(const std::string& name, std::type_index typeIndex)
@@ -199,29 +326,39 @@ namespace Isle
         const std::string& GetName() const { return m_Name; }
         std::type_index GetTypeIndex() const { return m_TypeIndex; }
 
-        void SetParent(ClassDescriptor* parent) { m_Parent = parent; }
+        // parentOffset is where the parent subobject starts inside this class.
+        void SetParent(ClassDescriptor* parent, uint32_t parentOffset = 0);
         ClassDescriptor* GetParent() const { return m_Parent; }
 
-        void AddProperty(std::unique_ptr<PropertyBase> prop)
-        {
-            m_Properties[prop->GetName()] = std::move(prop);
-        }
+        // Set for default constructible classes, singletons and abstract classes have none.
+        void SetFactory(FactoryFunction factory) { m_Factory = factory; }
+        bool CanCreate() const { return m_Factory != nullptr; }
+        Object* Create() const { return m_Factory ? m_Factory() : nullptr; }
+
+        void AddProperty(std::unique_ptr<PropertyBase> prop);
 
         void AddFunction(std::unique_ptr<FunctionBase> func)
         {
             m_Functions[func->GetName()] = std::move(func);
         }
 
-        PropertyBase* GetProperty(const std::string& name) const
-        {
-            auto it = m_Properties.find(name);
-            if (it != m_Properties.end())
-                return it->second.get();
+        // Every property including inherited ones, parents first. Hot code should look a
+        // property up once with FindField() and keep the index, then go through the layout.
+        const std::vector<PropertyField>& GetLayout() const;
 
-            if (m_Parent)
-                return m_Parent->GetProperty(name);
+        static constexpr uint32_t INVALID_FIELD = UINT32_MAX;
 
-            return nullptr;
+        uint32_t FindField(const std::string& name) const
+        {
+            GetLayout();
+            auto it = m_LayoutIndex.find(name);
+            return it != m_LayoutIndex.end() ? it->second : INVALID_FIELD;
+        }
+
+        PropertyBase* GetProperty(const std::string& name) const
+        {
+            uint32_t index = FindField(name);
+            return index != INVALID_FIELD ? const_cast<PropertyBase*>(m_Layout[index].m_Property) : nullptr;
         }
 
         FunctionBase* GetFunction(const std::string& name) const
@@ -236,7 +373,7 @@ namespace Isle
             return nullptr;
         }
 
-        const std::unordered_map<std::string, std::unique_ptr<PropertyBase>>& GetProperties() const
+        const std::vector<std::unique_ptr<PropertyBase>>& GetProperties() const
         {
             return m_Properties;
         }
@@ -249,16 +386,9 @@ namespace Isle
         std::vector<PropertyBase*> GetAllProperties() const
         {
             std::vector<PropertyBase*> props;
-
-            if (m_Parent)
-            {
-                auto parentProps = m_Parent->GetAllProperties();
-                props.insert(props.end(), parentProps.begin(), parentProps.end());
-            }
-
-            for (auto& [name, prop] : m_Properties)
-                props.push_back(prop.get());
-
+            props.reserve(GetLayout().size());
+            for (const PropertyField& field : m_Layout)
+                props.push_back(const_cast<PropertyBase*>(field.m_Property));
             return props;
         }
 
@@ -277,6 +407,71 @@ namespace Isle
 
             return funcs;
         }
+
+        // Bulk operations over every reflected property of two instances of this class.
+        // Trivially copyable fields go through memcpy/memcmp in merged spans, so padding
+        // is never read; the rest fall back to the per-property virtuals.
+        void CopyProperties(void* destination, const void* source) const
+        {
+            GetLayout();
+
+            uint8_t* dst = static_cast<uint8_t*>(destination);
+            const uint8_t* src = static_cast<const uint8_t*>(source);
+            for (const PropertySpan& span : m_TrivialSpans)
+                std::memcpy(dst + span.m_Offset, src + span.m_Offset, span.m_Size);
+
+            for (uint32_t index : m_NonTrivialFields)
+            {
+                const PropertyField& field = m_Layout[index];
+                field.m_Property->CopyField(field.GetField(destination), field.GetField(source));
+            }
+        }
+
+        // Bitwise for trivially copyable fields, so -0.0 and 0.0 differ and NaN equals itself.
+        bool PropertiesEqual(const void* a, const void* b) const
+        {
+            GetLayout();
+
+            const uint8_t* lhs = static_cast<const uint8_t*>(a);
+            const uint8_t* rhs = static_cast<const uint8_t*>(b);
+            for (const PropertySpan& span : m_TrivialSpans)
+            {
+                if (std::memcmp(lhs + span.m_Offset, rhs + span.m_Offset, span.m_Size) != 0)
+                    return false;
+            }
+
+            for (uint32_t index : m_NonTrivialFields)
+            {
+                const PropertyField& field = m_Layout[index];
+                if (!field.m_Property->FieldEquals(field.GetField(a), field.GetField(b)))
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Appends the layout index of every field that differs, returns how many did.
+        size_t DiffProperties(const void* a, const void* b, std::vector<uint32_t>& changed) const
+        {
+            const std::vector<PropertyField>& layout = GetLayout();
+            const size_t before = changed.size();
+
+            for (uint32_t i = 0; i < static_cast<uint32_t>(layout.size()); i++)
+            {
+                const PropertyField& field = layout[i];
+                const bool equal = field.m_Trivial
+                    ? std::memcmp(field.GetField(a), field.GetField(b), field.m_Size) == 0
+                    : field.m_Property->FieldEquals(field.GetField(a), field.GetField(b));
+
+                if (!equal)
+                    changed.push_back(i);
+            }
+
+            return changed.size() - before;
+        }
+
+    private:
+        void BuildLayout(uint32_t generation) const;
     };
 
     class ReflectionRegistry : public Singleton<ReflectionRegistry>
@@ -285,6 +480,11 @@ namespace Isle
         std::unordered_map<std::type_index, std::unique_ptr<ClassDescriptor>> m_Classes;
         std::unordered_map<std::string, ClassDescriptor*> m_ClassesByName;
 
+        // Bumped whenever a property or parent is added, descriptors compare it against the
+        // generation they flattened at.
+        std::atomic<uint32_t> m_Generation{ 0 };
+        std::recursive_mutex m_LayoutMutex;
+
     public:
         template<typename T>
         ClassDescriptor* RegisterClass(const std::string& name)
@@ -299,6 +499,9 @@ namespace Isle
             auto desc = std::make_unique<ClassDescriptor>(name, typeIdx);
             ClassDescriptor* ptr = desc.get();
 
+            if constexpr (std::is_base_of_v<Object, T> && std::is_default_constructible_v<T> && !std::is_abstract_v<T>)
+                ptr->SetFactory([]() -> Object* { return new T(); });
+
             m_Classes[typeIdx] = std::move(desc);
             m_ClassesByName[name] = ptr;
 
@@ -317,6 +520,15 @@ namespace Isle
             return nullptr;
         }
 
+        // Lookup by dynamic type, typeid(*instance) finds the most derived registered class.
+        ClassDescriptor* GetClass(std::type_index typeIdx)
+        {
+            auto it = m_Classes.find(typeIdx);
+            if (it != m_Classes.end())
+                return it->second.get();
+            return nullptr;
+        }
+
         ClassDescriptor* GetClass(const std::string& name)
         {
             auto it = m_ClassesByName.find(name);
@@ -329,8 +541,102 @@ namespace Isle
         {
             return m_ClassesByName;
         }
+
+        uint32_t GetGeneration() const { return m_Generation.load(std::memory_order_acquire); }
+        void InvalidateLayouts() { m_Generation.fetch_add(1, std::memory_order_acq_rel); }
+        std::recursive_mutex& GetLayoutMutex() { return m_LayoutMutex; }
     };
 
+    inline void ClassDescriptor::SetParent(ClassDescriptor* parent, uint32_t parentOffset)
+    {
+        m_Parent = parent;
+        m_ParentOffset = parentOffset;
+        ReflectionRegistry::Instance()->InvalidateLayouts();
+    }
+
+    inline void ClassDescriptor::AddProperty(std::unique_ptr<PropertyBase> prop)
+    {
+        auto it = std::find_if(m_Properties.begin(), m_Properties.end(),
+            [&](const std::unique_ptr<PropertyBase>& existing) { return existing->GetName() == prop->GetName(); });
+
+        if (it != m_Properties.end())
+            *it = std::move(prop);
+        else
+            m_Properties.push_back(std::move(prop));
+
+        ReflectionRegistry::Instance()->InvalidateLayouts();
+    }
+
+    inline const std::vector<PropertyField>& ClassDescriptor::GetLayout() const
+    {
+        const uint32_t generation = ReflectionRegistry::Instance()->GetGeneration();
+        if (m_LayoutGeneration.load(std::memory_order_acquire) != generation)
+            BuildLayout(generation);
+        return m_Layout;
+    }
+
+    inline void ClassDescriptor::BuildLayout(uint32_t generation) const
+    {
+        std::lock_guard<std::recursive_mutex> lock(ReflectionRegistry::Instance()->GetLayoutMutex());
+        if (m_LayoutGeneration.load(std::memory_order_relaxed) == generation)
+            return;
+
+        m_Layout.clear();
+        m_LayoutIndex.clear();
+        m_TrivialSpans.clear();
+        m_NonTrivialFields.clear();
+
+        if (m_Parent)
+        {
+            for (PropertyField field : m_Parent->GetLayout())
+            {
+                field.m_Offset += m_ParentOffset;
+                m_Layout.push_back(field);
+            }
+        }
+
+        for (const auto& prop : m_Properties)
+        {
+            PropertyField field;
+            field.m_Property = prop.get();
+            field.m_Offset = prop->GetOffset();
+            field.m_Size = prop->GetSize();
+            field.m_Type = prop->GetType();
+            field.m_Flags = prop->GetFlags();
+            field.m_Trivial = prop->IsTrivial();
+            m_Layout.push_back(field);
+        }
+
+        // Later entries win, a redeclared property hides the inherited one.
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_Layout.size()); i++)
+            m_LayoutIndex[m_Layout[i].m_Property->GetName()] = i;
+
+        std::vector<PropertySpan> spans;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(m_Layout.size()); i++)
+        {
+            if (m_Layout[i].m_Trivial)
+                spans.push_back({ m_Layout[i].m_Offset, m_Layout[i].m_Size });
+            else
+                m_NonTrivialFields.push_back(i);
+        }
+
+        std::sort(spans.begin(), spans.end(), [](const PropertySpan& a, const PropertySpan& b) { return a.m_Offset < b.m_Offset; });
+        for (const PropertySpan& span : spans)
+        {
+            if (!m_TrivialSpans.empty() && span.m_Offset <= m_TrivialSpans.back().m_Offset + m_TrivialSpans.back().m_Size)
+            {
+                PropertySpan& last = m_TrivialSpans.back();
+                last.m_Size = glm::max(last.m_Size, span.m_Offset + span.m_Size - last.m_Offset);
+            }
+            else
+            {
+                m_TrivialSpans.push_back(span);
+            }
+        }
+
+        m_LayoutGeneration.store(generation, std::memory_order_release);
+    }
+
     template<typename T>
     struct ClassRegistration
     {
@@ -360,9 +666,16 @@ namespace Isle
         template<typename ParentType>
         ClassRegistration& Parent()
         {
-            ClassDescriptor* parent = ReflectionRegistry::Instance()->GetClass<ParentType>();
+            // StaticClass() registers the parent on first use, registrars in other
+            // translation units may not have run yet.
+            ClassDescriptor* parent = nullptr;
+            if constexpr (requires { ParentType::StaticClass(); })
+                parent = ParentType::StaticClass();
+            else
+                parent = ReflectionRegistry::Instance()->GetClass<ParentType>();
+
             if (parent)
-                descriptor->SetParent(parent);
+                descriptor->SetParent(parent, BaseOffset<T, ParentType>());
             return *this;
         }
     };
@@ -389,7 +702,7 @@ namespace Isle
         { \
             ClassName::StaticClass(); \
             Isle::ClassRegistration<ClassName> reg(#ClassName); \
-            reg
+            static_cast<void>(reg
 
 #define REFLECT_PROP(PropName, Flags) \
     .Property(#PropName, &_ReflClass::PropName, Flags)
@@ -400,7 +713,8 @@ namespace Isle
 #define REFLECT_PARENT_CLASS(ParentClass) \
     .Parent<ParentClass>()
 
-#define END_REFLECT_CLASS() \
-                ; \
+// Closes the chain as a cast to void, a class without properties doesn't leave a bare reg;.
+#define END_REFLECT_CLASS(ClassName) \
+                ); \
         } \
-    } g_ReflectionRegistrar;
\ No newline at end of file
+    } g_##ClassName##_ReflectionRegistrar;
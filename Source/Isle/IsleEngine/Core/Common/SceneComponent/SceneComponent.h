@@ -2,6 +2,9 @@ namespace Isle
 {
     class ISLEENGINE_API SceneComponent : public Component
     {
+        GENERATED_BODY()
+        ISLE_TYPE(SceneComponent, Component)
+
     public:
         SceneComponent* m_Owner = nullptr;
         std::vector<SceneComponent*> m_Children;
@@ -132,12 +135,13 @@ namespace Isle
                 if (!child || !child->IsValid())
                     continue;
 
-                if (T* casted = dynamic_cast<T*>(child))
+                if (T* casted = Cast<T>(child))
                     return casted;
             }
             return nullptr;
         }
 
+        // GetChildren copies into a new vector, per frame code should use Children() or ForEachChild.
         template<typename T>
         std::vector<T*> GetChildren()
         {
@@ -151,7 +155,7 @@ namespace Isle
                 if (!child || !child->IsValid())
                     continue;
 
-                if (T* casted = dynamic_cast<T*>(child))
+                if (T* casted = Cast<T>(child))
                     results.push_back(casted);
             }
             return results;
@@ -176,55 +180,104 @@ namespace Isle
         std::vector<T*> GetChildrenInChildren()
         {
             std::vector<T*> results;
+            ForEachDescendant<T>([&](T* child) { results.push_back(child); });
+            return results;
+        }
 
-            if (m_IsDestroyed)
-                return results;
+        std::vector<SceneComponent*> GetChildrenInChildren()
+        {
+            return GetChildrenInChildren<SceneComponent>();
+        }
 
-            std::function<void(SceneComponent*)> traverse = [&](SceneComponent* current)
-                {
-                    if (!current || !current->IsValid())
-                        return;
+        // Range over the valid direct children that are a T. It walks m_Children by index, so
+        // nothing is copied and children added while iterating are still visited.
+        template<typename T>
+        class ChildView
+        {
+        public:
+            struct End {};
+
+            class Iterator
+            {
+            private:
+                const std::vector<SceneComponent*>* m_Children;
+                size_t m_Index;
+                T* m_Current = nullptr;
 
-                    for (SceneComponent* child : current->m_Children)
+            public:
+                Iterator(const std::vector<SceneComponent*>* children) : m_Children(children), m_Index(0) { Advance(); }
+
+                T* operator*() const { return m_Current; }
+                Iterator& operator++() { m_Index++; Advance(); return *this; }
+                bool operator!=(End) const { return m_Index < m_Children->size(); }
+
+            private:
+                void Advance()
+                {
+                    for (; m_Index < m_Children->size(); m_Index++)
                     {
+                        SceneComponent* child = (*m_Children)[m_Index];
                         if (!child || !child->IsValid())
                             continue;
 
-                        if (T* casted = dynamic_cast<T*>(child))
-                            results.push_back(casted);
-
-                        traverse(child);
+                        if ((m_Current = Cast<T>(child)))
+                            return;
                     }
-                };
+                    m_Current = nullptr;
+                }
+            };
 
-            traverse(this);
-            return results;
-        }
+        private:
+            const std::vector<SceneComponent*>* m_Children;
 
-        std::vector<SceneComponent*> GetChildrenInChildren()
+        public:
+            explicit ChildView(const std::vector<SceneComponent*>* children) : m_Children(children) {}
+
+            Iterator begin() const { return Iterator(m_Children); }
+            End end() const { return {}; }
+            bool empty() const { return !(begin() != end()); }
+        };
+
+        template<typename T = SceneComponent>
+        ChildView<T> Children() const
         {
-            std::vector<SceneComponent*> results;
+            return ChildView<T>(&m_Children);
+        }
 
+        // Calls func for every valid direct child that is a T, without building a vector.
+        template<typename T, typename Func>
+        void ForEachChild(Func&& func)
+        {
             if (m_IsDestroyed)
-                return results;
+                return;
 
-            std::function<void(SceneComponent*)> traverse = [&](SceneComponent* current)
-                {
-                    if (!current || !current->IsValid())
-                        return;
+            for (SceneComponent* child : m_Children)
+            {
+                if (!child || !child->IsValid())
+                    continue;
 
-                    for (SceneComponent* child : current->m_Children)
-                    {
-                        if (!child || !child->IsValid())
-                            continue;
+                if (T* casted = Cast<T>(child))
+                    func(casted);
+            }
+        }
 
-                        results.push_back(child);
-                        traverse(child);
-                    }
-                };
+        // Same for the whole subtree, depth first, parents before their children.
+        template<typename T, typename Func>
+        void ForEachDescendant(Func&& func)
+        {
+            if (m_IsDestroyed)
+                return;
 
-            traverse(this);
-            return results;
+            for (SceneComponent* child : m_Children)
+            {
+                if (!child || !child->IsValid())
+                    continue;
+
+                if (T* casted = Cast<T>(child))
+                    func(casted);
+
+                child->ForEachDescendant<T>(func);
+            }
         }
 
         void SetBounds(Bounds bounds)
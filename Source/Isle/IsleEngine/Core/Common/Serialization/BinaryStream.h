@@ -0,0 +1,115 @@
+// BinaryStream.h
+#pragma once
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Isle
+{
+    // Append only byte buffer. Values are written as raw bytes in host order, strings as a
+    // uint32 length followed by the characters.
+    class BinaryWriter
+    {
+    private:
+        std::vector<uint8_t> m_Data;
+
+    public:
+        template<typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter::Write needs a trivially copyable type");
+            WriteBytes(&value, sizeof(T));
+        }
+
+        void WriteBytes(const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            m_Data.insert(m_Data.end(), bytes, bytes + size);
+        }
+
+        void WriteString(std::string_view value)
+        {
+            Write(static_cast<uint32_t>(value.size()));
+            WriteBytes(value.data(), value.size());
+        }
+
+        void Reserve(size_t size) { m_Data.reserve(size); }
+        void Clear() { m_Data.clear(); }
+
+        const uint8_t* GetData() const { return m_Data.data(); }
+        size_t GetSize() const { return m_Data.size(); }
+    };
+
+    // Reads what BinaryWriter wrote from memory it does not own. Running past the end marks
+    // the reader failed and returns zeroes, callers check IsValid() once at the end.
+    class BinaryReader
+    {
+    private:
+        const uint8_t* m_Cursor = nullptr;
+        const uint8_t* m_End = nullptr;
+        bool m_Failed = false;
+
+    public:
+        BinaryReader() = default;
+        BinaryReader(const void* data, size_t size)
+            : m_Cursor(static_cast<const uint8_t*>(data))
+            , m_End(static_cast<const uint8_t*>(data) + size)
+        {
+        }
+
+        template<typename T>
+        T Read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "BinaryReader::Read needs a trivially copyable type");
+            T value{};
+            ReadBytes(&value, sizeof(T));
+            return value;
+        }
+
+        void ReadBytes(void* destination, size_t size)
+        {
+            if (!Require(size))
+            {
+                std::memset(destination, 0, size);
+                return;
+            }
+
+            std::memcpy(destination, m_Cursor, size);
+            m_Cursor += size;
+        }
+
+        // Points into the source buffer, valid for as long as it is.
+        std::string_view ReadString()
+        {
+            const uint32_t length = Read<uint32_t>();
+            if (!Require(length))
+                return {};
+
+            std::string_view value(reinterpret_cast<const char*>(m_Cursor), length);
+            m_Cursor += length;
+            return value;
+        }
+
+        void Skip(size_t size)
+        {
+            if (Require(size))
+                m_Cursor += size;
+        }
+
+        bool IsValid() const { return !m_Failed; }
+        size_t GetRemaining() const { return static_cast<size_t>(m_End - m_Cursor); }
+
+    private:
+        bool Require(size_t size)
+        {
+            if (m_Failed || static_cast<size_t>(m_End - m_Cursor) < size)
+            {
+                m_Failed = true;
+                return false;
+            }
+            return true;
+        }
+    };
+}
@@ -1,11 +1,15 @@
 #include "Engine.h"
 #include <Core/Scene/Scene.h>
 #include <Core/Graphics/Render.h>
+#include <Core/Animation/AnimationSystem.h>
 
 namespace Isle
 {
     static std::chrono::high_resolution_clock::time_point s_LastFrameTime;
 
+    // A new pipeline's render graph grows its pass lists over its first few frames.
+    static constexpr uint32_t RENDER_WARMUP_FRAMES = 3;
+
     void Engine::Start()
     {
         s_LastFrameTime = std::chrono::high_resolution_clock::now();
@@ -17,9 +21,38 @@ namespace Isle
         m_DeltaTime = std::chrono::duration<double>(now - s_LastFrameTime).count();
         m_FPS = 1.0f / m_DeltaTime;
 
+        // Poses skeletons before the scene sees the frame, joint transforms are plain locals by then.
+        {
+            ISLE_PROFILE_SCOPE("Animation Update");
+            AnimationSystem::Instance()->Update(static_cast<float>(m_DeltaTime));
+        }
+
         // everything happens in these two functions
-        Scene::Instance()->Update(m_DeltaTime);
-        Render::Instance()->RenderFrame();
+        Scene* scene = Scene::Instance();
+        Render* render = Render::Instance();
+
+        // Once nothing is waiting to start or upload, neither half of the frame may touch the heap.
+        const bool steady = !scene->IsUploading();
+        {
+            ISLE_PROFILE_SCOPE("Scene Update");
+            AllocationCheck allocationCheck("Scene Update", steady);
+            scene->Update(m_DeltaTime);
+            if (scene->IsUploading())
+                allocationCheck.Disarm();
+        }
+        {
+            // Frames that create a GPU resource, after a resize or a new target, are let off.
+            Pipeline* pipeline = render->GetPipeline();
+            const bool warm = pipeline && pipeline->GetRenderGraph().GetFrame() >= RENDER_WARMUP_FRAMES;
+            const uint64_t resources = GfxResourceTracker::GetRegisterCount();
+
+            AllocationCheck allocationCheck("Render Frame", steady && !scene->IsUploading() && warm);
+            render->RenderFrame();
+            if (GfxResourceTracker::GetRegisterCount() != resources)
+                allocationCheck.Disarm();
+        }
+
+        FrameAllocator::EndFrame();
 
         s_LastFrameTime = now;
     }
@@ -27,5 +60,7 @@ namespace Isle
     void Engine::Destroy()
     {
         Scene::Instance()->ClearAll();
+        AnimationSystem::Instance()->Shutdown();
+        FrameAllocator::Shutdown();
     }
 }
@@ -4,7 +4,7 @@
 namespace Isle
 {
     FrameBuffer::FrameBuffer(int width, int height)
-        : m_Width(width), m_Height(height)
+        : GfxResource(GFX_RESOURCE_CATEGORY::FRAMEBUFFER), m_Width(width), m_Height(height)
     {
         Create();
     }
@@ -17,7 +17,7 @@ namespace Isle
     void FrameBuffer::Create()
     {
         if (!m_Id)
-            glGenFramebuffers(1, &m_Id);
+            m_Id = GfxDevice::Get()->CreateFrameBuffer();
         m_IsLoaded = true;
     }
 
@@ -25,7 +25,7 @@ namespace Isle
     {
         if (m_Id)
         {
-            glDeleteFramebuffers(1, &m_Id);
+            GfxDevice::Get()->DestroyFrameBuffer(m_Id);
             m_Id = 0;
         }
         m_Attachments.clear();
@@ -42,14 +42,15 @@ namespace Isle
 
     void FrameBuffer::Bind(uint32_t)
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
-        glViewport(0, 0, m_Width, m_Height);
+        GfxDevice* device = GfxDevice::Get();
+        device->BindFrameBuffer(GL_FRAMEBUFFER, m_Id);
+        device->SetViewport(0, 0, m_Width, m_Height);
         m_IsResident = true;
     }
 
     void FrameBuffer::Unbind(uint32_t)
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GfxDevice::Get()->BindFrameBuffer(GL_FRAMEBUFFER, 0);
         m_IsResident = false;
     }
 
@@ -58,7 +59,7 @@ namespace Isle
         if (!m_Id)
             Create();
 
-        glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
+        GfxDevice* device = GfxDevice::Get();
 
         if (type == ATTACHMENT_TYPE::DEPTH || type == ATTACHMENT_TYPE::SHADOW_MAP || type == ATTACHMENT_TYPE::SHADOW_CUBE)
         {
@@ -73,39 +74,37 @@ namespace Isle
         if (type == ATTACHMENT_TYPE::SHADOW_MAP)
         {
             texture->Create(m_Width, m_Height, TEXTURE_FORMAT::DEPTH32F, nullptr, false);
-            texture->Bind();
 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+            device->TexParameter(GL_TEXTURE_2D, texture->m_Id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+            device->TexParameter(GL_TEXTURE_2D, texture->m_Id, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+            device->TexParameter(GL_TEXTURE_2D, texture->m_Id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+            device->TexParameter(GL_TEXTURE_2D, texture->m_Id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 
             GLfloat borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-            glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+            device->TexParameter(GL_TEXTURE_2D, texture->m_Id, GL_TEXTURE_BORDER_COLOR, borderColor);
 
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, texture->m_Id, 0);
+            device->TexParameter(GL_TEXTURE_2D, texture->m_Id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            device->TexParameter(GL_TEXTURE_2D, texture->m_Id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            device->FrameBufferTexture(m_Id, GL_DEPTH_ATTACHMENT, texture->m_Id, 0);
 
-            glDrawBuffer(GL_NONE);
-            glReadBuffer(GL_NONE);
-
-            texture->Unbind();
+            device->SetDrawBuffers(m_Id, nullptr, 0);
+            device->SetReadBuffer(m_Id, GL_NONE);
         }
         else
         {
             texture->Create(m_Width, m_Height, format, nullptr, generateMipmaps);
             GLenum attachment = ResolveAttachment(type, static_cast<int>(m_DrawBuffers.size()));
-            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture->m_Id, 0);
+            device->FrameBufferTexture(m_Id, attachment, texture->m_Id, 0);
 
             if (type != ATTACHMENT_TYPE::DEPTH && type != ATTACHMENT_TYPE::DEPTH_STENCIL)
             {
                 m_DrawBuffers.push_back(attachment);
-                glDrawBuffers(static_cast<GLsizei>(m_DrawBuffers.size()), m_DrawBuffers.data());
+                device->SetDrawBuffers(m_Id, m_DrawBuffers.data(), static_cast<GLsizei>(m_DrawBuffers.size()));
             }
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
+        GfxResourceTracker::SetCategory(texture.Get(), GFX_RESOURCE_CATEGORY::FRAMEBUFFER);
         m_Attachments[type] = texture;
         return texture;
     }
@@ -114,11 +113,12 @@ namespace Isle
     {
         if (!texture || !m_Id) return;
 
-        glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
+        GfxDevice* device = GfxDevice::Get();
         GLenum attachment = ResolveAttachment(type, attachmentIndex);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture->m_Id, 0);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        device->FrameBufferTexture(m_Id, attachment, texture->m_Id, 0);
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
 
+        GfxResourceTracker::SetCategory(texture.Get(), GFX_RESOURCE_CATEGORY::FRAMEBUFFER);
         m_Attachments[type] = texture;
 
         if (type != ATTACHMENT_TYPE::DEPTH && type != ATTACHMENT_TYPE::DEPTH_STENCIL)
@@ -146,7 +146,7 @@ namespace Isle
     void FrameBuffer::SetDrawBuffers(const std::vector<ATTACHMENT_TYPE>& targets)
     {
         m_DrawBuffers.clear();
-        glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
+        GfxDevice* device = GfxDevice::Get();
 
         for (int i = 0; i < targets.size(); i++)
         {
@@ -159,28 +159,18 @@ namespace Isle
                 auto tex = GetAttachment(type);
                 if (tex)
                 {
-                    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, tex->m_Id, 0);
+                    device->FrameBufferTexture(m_Id, attachment, tex->m_Id, 0);
                 }
             }
         }
 
-        if (!m_DrawBuffers.empty())
-        {
-            glDrawBuffers(static_cast<GLsizei>(m_DrawBuffers.size()), m_DrawBuffers.data());
-        }
-        else
-        {
-            glDrawBuffer(GL_NONE);
-        }
-
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        device->SetDrawBuffers(m_Id, m_DrawBuffers.data(), static_cast<GLsizei>(m_DrawBuffers.size()));
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
     }
 
     bool FrameBuffer::CheckStatus()
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
-        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLenum status = GfxDevice::Get()->CheckFrameBufferStatus(m_Id);
 
         if (status != GL_FRAMEBUFFER_COMPLETE)
         {
@@ -192,25 +182,18 @@ namespace Isle
 
     void FrameBuffer::Clear(const glm::vec4& color, float depth, int stencil)
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
+        GfxDevice* device = GfxDevice::Get();
+        device->BindFrameBuffer(GL_FRAMEBUFFER, m_Id);
 
         bool isDepthOnly = (m_DrawBuffers.empty() || m_DrawBuffers[0] == GL_NONE) &&
             (m_Attachments.count(ATTACHMENT_TYPE::DEPTH) ||
                 m_Attachments.count(ATTACHMENT_TYPE::SHADOW_MAP));
 
         if (isDepthOnly) {
-            glDrawBuffer(GL_NONE);
-            glClearDepth(depth);
-            glClear(GL_DEPTH_BUFFER_BIT);
+            device->SetDrawBuffers(m_Id, nullptr, 0);
+            device->Clear(GL_DEPTH_BUFFER_BIT, color, depth);
         }
         else {
-            if (!m_DrawBuffers.empty() && m_DrawBuffers[0] != GL_NONE) {
-                glClearColor(color.r, color.g, color.b, color.a);
-            }
-
-            glClearDepth(depth);
-            glClearStencil(stencil);
-
             GLbitfield clearBits = 0;
             if (!m_DrawBuffers.empty() && m_DrawBuffers[0] != GL_NONE) {
                 clearBits |= GL_COLOR_BUFFER_BIT;
@@ -223,24 +206,24 @@ namespace Isle
                 clearBits |= GL_STENCIL_BUFFER_BIT;
             }
 
-            glClear(clearBits);
+            device->Clear(clearBits, color, depth, stencil);
         }
     }
 
     void FrameBuffer::ClearColor(const glm::vec4& color)
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
-        glClearColor(color.r, color.g, color.b, color.a);
-        glClear(GL_COLOR_BUFFER_BIT);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GfxDevice* device = GfxDevice::Get();
+        device->BindFrameBuffer(GL_FRAMEBUFFER, m_Id);
+        device->Clear(GL_COLOR_BUFFER_BIT, color);
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
     }
 
     void FrameBuffer::ClearDepth(float depth)
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, m_Id);
-        glClearDepth(depth);
-        glClear(GL_DEPTH_BUFFER_BIT);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GfxDevice* device = GfxDevice::Get();
+        device->BindFrameBuffer(GL_FRAMEBUFFER, m_Id);
+        device->Clear(GL_DEPTH_BUFFER_BIT, glm::vec4(0.0f), depth);
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
     }
 
     void FrameBuffer::Resize(int width, int height)
@@ -261,12 +244,11 @@ namespace Isle
         int targetWidth = target ? target->m_Width : m_Width;
         int targetHeight = target ? target->m_Height : m_Height;
 
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_Id);
-        glReadBuffer(GL_COLOR_ATTACHMENT0);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetId);
-        glBlitFramebuffer(0, 0, m_Width, m_Height,
-            0, 0, targetWidth, targetHeight, mask, filter);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GfxDevice* device = GfxDevice::Get();
+        device->SetReadBuffer(m_Id, GL_COLOR_ATTACHMENT0);
+        device->BlitFrameBuffer(m_Id, targetId, glm::ivec4(0, 0, m_Width, m_Height),
+            glm::ivec4(0, 0, targetWidth, targetHeight), mask, filter);
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
     }
 
 
@@ -275,21 +257,14 @@ namespace Isle
     {
         GLuint targetId = target ? target->m_Id : 0;
 
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_Id);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetId);
-
-        glBlitFramebuffer(
-            srcRect.x, srcRect.y, srcRect.z, srcRect.w,
-            destRect.x, destRect.y, destRect.z, destRect.w,
-            mask, filter
-        );
-
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GfxDevice* device = GfxDevice::Get();
+        device->BlitFrameBuffer(m_Id, targetId, srcRect, destRect, mask, filter);
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
     }
 
     void FrameBuffer::SetViewport()
     {
-        glViewport(0, 0, m_Width, m_Height);
+        GfxDevice::Get()->SetViewport(0, 0, m_Width, m_Height);
     }
 
     void FrameBuffer::BlitToTexture(Ref<Texture> targetTexture, GLbitfield mask, GLenum filter)
@@ -297,18 +272,15 @@ namespace Isle
         if (!targetTexture)
             return;
 
-        GLuint tempFBO;
-        glGenFramebuffers(1, &tempFBO);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, tempFBO);
-        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-            GL_TEXTURE_2D, targetTexture->m_Id, 0);
+        GfxDevice* device = GfxDevice::Get();
+        GLuint tempFBO = device->CreateFrameBuffer();
+        device->FrameBufferTexture(tempFBO, GL_COLOR_ATTACHMENT0, targetTexture->m_Id, 0);
 
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_Id);
-        glBlitFramebuffer(0, 0, m_Width, m_Height,
-            0, 0, targetTexture->m_Width, targetTexture->m_Height, mask, filter);
+        device->BlitFrameBuffer(m_Id, tempFBO, glm::ivec4(0, 0, m_Width, m_Height),
+            glm::ivec4(0, 0, targetTexture->m_Width, targetTexture->m_Height), mask, filter);
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glDeleteFramebuffers(1, &tempFBO);
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
+        device->DestroyFrameBuffer(tempFBO);
     }
 
     void FrameBuffer::BlitDepthTo(FrameBuffer* target)
@@ -317,23 +289,49 @@ namespace Isle
         int targetWidth = target ? target->m_Width : m_Width;
         int targetHeight = target ? target->m_Height : m_Height;
 
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_Id);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetId);
+        GfxDevice* device = GfxDevice::Get();
+        device->BlitFrameBuffer(m_Id, targetId, glm::ivec4(0, 0, m_Width, m_Height),
+            glm::ivec4(0, 0, targetWidth, targetHeight), GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        device->BindFrameBuffer(GL_FRAMEBUFFER, 0);
+    }
 
-        glBlitFramebuffer(
-            0, 0, m_Width, m_Height,
-            0, 0, targetWidth, targetHeight,
-            GL_DEPTH_BUFFER_BIT,
-            GL_NEAREST
-        );
+    void FrameBuffer::SetDebugLabel(const std::string& name)
+    {
+        GfxResourceTracker::SetLabel(this, name);
+        GfxDevice::Get()->SetObjectLabel(GL_FRAMEBUFFER, m_Id, name);
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        for (auto& [type, texture] : m_Attachments)
+        {
+            if (texture)
+                texture->SetDebugLabel(name + "/" + GetAttachmentName(type));
+        }
     }
 
-    void FrameBuffer::SetDebugLabel(const std::string& name)
+    const char* FrameBuffer::GetAttachmentName(ATTACHMENT_TYPE type)
     {
-        if (glObjectLabel)
-            glObjectLabel(GL_FRAMEBUFFER, m_Id, -1, name.c_str());
+        switch (type)
+        {
+        case ATTACHMENT_TYPE::COLOR:         return "Color";
+        case ATTACHMENT_TYPE::DEPTH:         return "Depth";
+        case ATTACHMENT_TYPE::DEPTH_STENCIL: return "DepthStencil";
+        case ATTACHMENT_TYPE::NORMAL:        return "Normal";
+        case ATTACHMENT_TYPE::EMISSIVE:      return "Emissive";
+        case ATTACHMENT_TYPE::POSITION:      return "Position";
+        case ATTACHMENT_TYPE::MATERIAL:      return "Material";
+        case ATTACHMENT_TYPE::VELOCITY:      return "Velocity";
+        case ATTACHMENT_TYPE::LIGHTING:      return "Lighting";
+        case ATTACHMENT_TYPE::INDIRECT:      return "Indirect";
+        case ATTACHMENT_TYPE::SPECULAR:      return "Specular";
+        case ATTACHMENT_TYPE::REFLECTION:    return "Reflection";
+        case ATTACHMENT_TYPE::SELECTION:     return "Selection";
+        case ATTACHMENT_TYPE::RADIANCE:      return "Radiance";
+        case ATTACHMENT_TYPE::SCENE:         return "Scene";
+        case ATTACHMENT_TYPE::HDR:           return "HDR";
+        case ATTACHMENT_TYPE::FINAL:         return "Final";
+        case ATTACHMENT_TYPE::SHADOW_MAP:    return "ShadowMap";
+        case ATTACHMENT_TYPE::SHADOW_CUBE:   return "ShadowCube";
+        default:                             return "None";
+        }
     }
 
     GLenum FrameBuffer::ResolveAttachment(ATTACHMENT_TYPE type, int index)
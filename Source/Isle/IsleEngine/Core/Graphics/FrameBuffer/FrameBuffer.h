@@ -72,5 +72,6 @@ namespace Isle
         void SetViewport();
 
         static GLenum ResolveAttachment(ATTACHMENT_TYPE type, int index = 0);
+        static const char* GetAttachmentName(ATTACHMENT_TYPE type);
     };
 }
\ No newline at end of file
@@ -0,0 +1,188 @@
+// BufferAllocator.cpp
+#include "BufferAllocator.h"
+
+namespace Isle
+{
+    BufferRange BufferAllocator::Allocate(uint32_t count, uint32_t owner)
+    {
+        if (count == 0)
+            return {};
+
+        uint32_t offset = m_End;
+
+        // Smallest hole that fits, the rest of it stays free.
+        auto fit = m_FreeBySize.lower_bound(count);
+        if (fit != m_FreeBySize.end())
+        {
+            auto range = m_FreeRanges.find(fit->second);
+            offset = range->first;
+            const uint32_t holeCount = range->second;
+
+            RemoveFree(range);
+            if (holeCount > count)
+                InsertFree(offset + count, holeCount - count);
+        }
+        else
+        {
+            m_End += count;
+        }
+
+        uint32_t index;
+        if (!m_FreeHandles.empty())
+        {
+            index = m_FreeHandles.back();
+            m_FreeHandles.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_Allocations.size());
+            m_Allocations.emplace_back();
+        }
+
+        Allocation& allocation = m_Allocations[index];
+        allocation.m_Offset = offset;
+        allocation.m_Count = count;
+        allocation.m_Owner = owner;
+        allocation.m_Live = true;
+
+        m_LiveByOffset[offset] = index;
+        m_Used += count;
+
+        return { index, allocation.m_Generation };
+    }
+
+    void BufferAllocator::Free(BufferRange range)
+    {
+        if (!IsValid(range))
+            return;
+
+        Allocation& allocation = m_Allocations[range.m_Index];
+        m_LiveByOffset.erase(allocation.m_Offset);
+        m_Used -= allocation.m_Count;
+
+        InsertFree(allocation.m_Offset, allocation.m_Count);
+
+        allocation.m_Live = false;
+        allocation.m_Generation++;
+        m_FreeHandles.push_back(range.m_Index);
+    }
+
+    bool BufferAllocator::IsValid(BufferRange range) const
+    {
+        return range.m_Index < m_Allocations.size() &&
+            m_Allocations[range.m_Index].m_Live &&
+            m_Allocations[range.m_Index].m_Generation == range.m_Generation;
+    }
+
+    uint32_t BufferAllocator::GetOffset(BufferRange range) const
+    {
+        return IsValid(range) ? m_Allocations[range.m_Index].m_Offset : 0;
+    }
+
+    uint32_t BufferAllocator::GetCount(BufferRange range) const
+    {
+        return IsValid(range) ? m_Allocations[range.m_Index].m_Count : 0;
+    }
+
+    bool BufferAllocator::Compact(uint32_t maxElements, std::vector<Move>& outMoves)
+    {
+        if (!m_Compacting)
+        {
+            if (m_FreeRanges.empty() || GetFragmented() < m_End / 4)
+                return false;
+
+            m_Compacting = true;
+        }
+
+        uint32_t moved = 0;
+        while (!m_FreeRanges.empty())
+        {
+            auto hole = m_FreeRanges.begin();
+            const uint32_t holeOffset = hole->first;
+            const uint32_t holeCount = hole->second;
+
+            // Trailing holes are trimmed off m_End, so a live range always follows.
+            auto next = m_LiveByOffset.find(holeOffset + holeCount);
+            if (next == m_LiveByOffset.end())
+                break;
+
+            const uint32_t index = next->second;
+            Allocation& allocation = m_Allocations[index];
+            if (moved > 0 && moved + allocation.m_Count > maxElements)
+                break;
+
+            RemoveFree(hole);
+            m_LiveByOffset.erase(next);
+
+            outMoves.push_back({ { index, allocation.m_Generation }, allocation.m_Offset, holeOffset, allocation.m_Count, allocation.m_Owner });
+
+            allocation.m_Offset = holeOffset;
+            m_LiveByOffset[holeOffset] = index;
+
+            // The hole now sits right after the moved range and merges with the next one.
+            InsertFree(holeOffset + allocation.m_Count, holeCount);
+            moved += allocation.m_Count;
+        }
+
+        m_Compacting = !m_FreeRanges.empty();
+        return m_Compacting;
+    }
+
+    void BufferAllocator::Clear()
+    {
+        m_Allocations.clear();
+        m_FreeHandles.clear();
+        m_FreeRanges.clear();
+        m_FreeBySize.clear();
+        m_LiveByOffset.clear();
+        m_End = 0;
+        m_Used = 0;
+        m_Compacting = false;
+    }
+
+    void BufferAllocator::InsertFree(uint32_t offset, uint32_t count)
+    {
+        auto next = m_FreeRanges.lower_bound(offset);
+        if (next != m_FreeRanges.end() && offset + count == next->first)
+        {
+            count += next->second;
+            RemoveFree(next);
+        }
+
+        auto previous = m_FreeRanges.lower_bound(offset);
+        if (previous != m_FreeRanges.begin())
+        {
+            --previous;
+            if (previous->first + previous->second == offset)
+            {
+                offset = previous->first;
+                count += previous->second;
+                RemoveFree(previous);
+            }
+        }
+
+        if (offset + count == m_End)
+        {
+            m_End = offset;
+            return;
+        }
+
+        m_FreeRanges[offset] = count;
+        m_FreeBySize.emplace(count, offset);
+    }
+
+    void BufferAllocator::RemoveFree(std::map<uint32_t, uint32_t>::iterator range)
+    {
+        auto [first, last] = m_FreeBySize.equal_range(range->second);
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second == range->first)
+            {
+                m_FreeBySize.erase(it);
+                break;
+            }
+        }
+
+        m_FreeRanges.erase(range);
+    }
+}
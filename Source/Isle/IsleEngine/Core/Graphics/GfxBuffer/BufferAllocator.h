@@ -0,0 +1,114 @@
+// BufferAllocator.h
+#pragma once
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    // Names an allocation for as long as it lives, even while compaction moves it around.
+    struct BufferRange
+    {
+        static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+        uint32_t m_Index = INVALID_INDEX;
+        uint32_t m_Generation = 0;
+
+        bool IsValid() const { return m_Index != INVALID_INDEX; }
+    };
+
+    // Element ranges inside one big buffer. Freed ranges merge with free neighbours and are
+    // reused best fit, the buffer only grows when no hole fits. Holes at the very end give the
+    // space back straight away.
+    //
+    // Compact() slides the range after the lowest hole down into it, a bounded number of
+    // elements per call, so the buffer tightens over several frames. The caller copies the data
+    // of every reported move in order and patches whatever stored the old offset.
+    class ISLEENGINE_API BufferAllocator
+    {
+    public:
+        struct Move
+        {
+            BufferRange m_Range;
+            uint32_t m_From = 0;
+            uint32_t m_To = 0;
+            uint32_t m_Count = 0;
+            uint32_t m_Owner = 0;
+        };
+
+    private:
+        struct Allocation
+        {
+            uint32_t m_Offset = 0;
+            uint32_t m_Count = 0;
+            uint32_t m_Owner = 0;
+            uint32_t m_Generation = 1;
+            bool m_Live = false;
+        };
+
+        std::vector<Allocation> m_Allocations;
+        std::vector<uint32_t> m_FreeHandles;
+
+        std::map<uint32_t, uint32_t> m_FreeRanges;         // offset -> count
+        std::multimap<uint32_t, uint32_t> m_FreeBySize;    // count -> offset
+        std::map<uint32_t, uint32_t> m_LiveByOffset;       // offset -> allocation
+
+        uint32_t m_End = 0;
+        uint32_t m_Used = 0;
+        bool m_Compacting = false;
+
+    public:
+        // Owner is handed back with every move of the range. Zero elements give an invalid range.
+        BufferRange Allocate(uint32_t count, uint32_t owner = 0);
+        void Free(BufferRange range);
+
+        bool IsValid(BufferRange range) const;
+        uint32_t GetOffset(BufferRange range) const;
+        uint32_t GetCount(BufferRange range) const;
+
+        // Does nothing until holes make up a quarter of the buffer, then keeps compacting on
+        // every call until they are gone. Moves at least one range per call while working.
+        // Returns true while compaction is still in progress.
+        bool Compact(uint32_t maxElements, std::vector<Move>& outMoves);
+
+        void Clear();
+
+        // The buffer must hold this many elements, everything past it is unused.
+        uint32_t GetEnd() const { return m_End; }
+        uint32_t GetUsed() const { return m_Used; }
+        uint32_t GetFragmented() const { return m_End - m_Used; }
+
+    private:
+        void InsertFree(uint32_t offset, uint32_t count);
+        void RemoveFree(std::map<uint32_t, uint32_t>::iterator range);
+    };
+
+    // Fixed size slots by index. An index stays put for as long as it is held, released ones
+    // are handed out again before the buffer grows.
+    class SlotAllocator
+    {
+    private:
+        std::vector<uint32_t> m_Free;
+        uint32_t m_End = 0;
+
+    public:
+        uint32_t Allocate()
+        {
+            if (m_Free.empty())
+                return m_End++;
+
+            const uint32_t slot = m_Free.back();
+            m_Free.pop_back();
+            return slot;
+        }
+
+        void Free(uint32_t slot) { m_Free.push_back(slot); }
+
+        void Clear()
+        {
+            m_Free.clear();
+            m_End = 0;
+        }
+
+        uint32_t GetEnd() const { return m_End; }
+        uint32_t GetUsed() const { return m_End - static_cast<uint32_t>(m_Free.size()); }
+    };
+}
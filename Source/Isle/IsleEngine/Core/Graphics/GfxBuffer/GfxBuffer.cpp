@@ -14,13 +14,14 @@ namespace Isle
         m_Target = ResolveTarget(type);
         m_UsageHint = ResolveUsage(usage);
 
+        GfxDevice* device = GfxDevice::Get();
         if (type == GFX_BUFFER_TYPE::VERTEX && !m_VAO)
         {
-            glGenVertexArrays(1, &m_VAO);
+            m_VAO = device->CreateVertexArray();
         }
 
         if (!m_Id)
-            glGenBuffers(1, &m_Id);
+            m_Id = device->CreateBuffer();
 
         if (size > 0)
         {
@@ -28,27 +29,28 @@ namespace Isle
             if (data)
                 std::memcpy(m_LocalData.data(), data, size);
 
-            glBindBuffer(m_Target, m_Id);
-            glBufferData(m_Target, size, m_LocalData.data(), m_UsageHint);
-            glBindBuffer(m_Target, 0);
-            m_SizeInBytes = static_cast<size_t>(size);
+            device->BufferData(m_Target, m_Id, size, m_LocalData.data(), m_UsageHint);
+            SetSizeInBytes(static_cast<size_t>(size));
+            RecordUpload(static_cast<size_t>(size));
         }
 
         m_IsLoaded = true;
         m_Dirty = false;
+        m_DirtyBegin = SIZE_MAX;
+        m_DirtyEnd = 0;
     }
 
     void GfxBuffer::Destroy()
     {
         if (m_VAO)
         {
-            glDeleteVertexArrays(1, &m_VAO);
+            GfxDevice::Get()->DestroyVertexArray(m_VAO);
             m_VAO = 0;
         }
 
         if (m_Id)
         {
-            glDeleteBuffers(1, &m_Id);
+            GfxDevice::Get()->DestroyBuffer(m_Id);
             m_Id = 0;
         }
 
@@ -57,7 +59,7 @@ namespace Isle
         m_AssociatedIndexBuffer = nullptr;
         m_IsLoaded = false;
         m_IsResident = false;
-        m_SizeInBytes = 0;
+        SetSizeInBytes(0);
     }
 
     void GfxBuffer::Bind(uint32_t slot)
@@ -69,96 +71,56 @@ namespace Isle
         case GFX_BUFFER_TYPE::VERTEX:
             if (m_VAO)
             {
-                glBindVertexArray(m_VAO);
+                GfxDevice::Get()->BindVertexArray(m_VAO);
                 m_IsResident = true;
             }
             break;
 
-        case GFX_BUFFER_TYPE::INDEX:
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Id);
-            m_IsResident = true;
-            break;
-
         case GFX_BUFFER_TYPE::UNIFORM:
-            glBindBufferBase(GL_UNIFORM_BUFFER, slot, m_Id);
-            m_IsResident = true;
-            break;
-
         case GFX_BUFFER_TYPE::STORAGE:
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot, m_Id);
-            m_IsResident = true;
-            break;
-
         case GFX_BUFFER_TYPE::ATOMIC_COUNTER:
-            glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, slot, m_Id);
-            m_IsResident = true;
-            break;
-
         case GFX_BUFFER_TYPE::TRANSFORM_FEEDBACK:
-            glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, slot, m_Id);
-            m_IsResident = true;
-            break;
-
-        case GFX_BUFFER_TYPE::INDIRECT_DRAW:
-            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_Id);
-            m_IsResident = true;
-            break;
-
-        case GFX_BUFFER_TYPE::INDIRECT_DISPATCH:
-            glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, m_Id);
-            m_IsResident = true;
-            break;
-
-        case GFX_BUFFER_TYPE::PIXEL_PACK:
-            glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Id);
-            m_IsResident = true;
-            break;
-
-        case GFX_BUFFER_TYPE::PIXEL_UNPACK:
-            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Id);
+            GfxDevice::Get()->BindBufferBase(m_Target, slot, m_Id);
             m_IsResident = true;
             break;
 
         default:
-            glBindBuffer(m_Target, m_Id);
+            GfxDevice::Get()->BindBuffer(m_Target, m_Id);
             m_IsResident = true;
             break;
         }
     }
 
-    void GfxBuffer::Unbind(uint32_t)
+    void GfxBuffer::BindAs(GFX_BUFFER_TYPE type, uint32_t slot)
     {
-        switch (m_Type)
-        {
-        case GFX_BUFFER_TYPE::VERTEX:
-            if (m_VAO)
-                glBindVertexArray(0);
-            break;
-
-        case GFX_BUFFER_TYPE::INDEX:
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-            break;
+        if (!m_Id) return;
 
+        switch (type)
+        {
         case GFX_BUFFER_TYPE::UNIFORM:
-            glBindBuffer(GL_UNIFORM_BUFFER, 0);
-            break;
-
         case GFX_BUFFER_TYPE::STORAGE:
-            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-            break;
-
         case GFX_BUFFER_TYPE::ATOMIC_COUNTER:
-            glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
-            break;
-
         case GFX_BUFFER_TYPE::TRANSFORM_FEEDBACK:
-            glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, 0);
+            GfxDevice::Get()->BindBufferBase(ResolveTarget(type), slot, m_Id);
             break;
 
         default:
-            glBindBuffer(m_Target, 0);
+            GfxDevice::Get()->BindBuffer(ResolveTarget(type), m_Id);
             break;
         }
+    }
+
+    void GfxBuffer::Unbind(uint32_t)
+    {
+        if (m_Type == GFX_BUFFER_TYPE::VERTEX)
+        {
+            if (m_VAO)
+                GfxDevice::Get()->BindVertexArray(0);
+        }
+        else
+        {
+            GfxDevice::Get()->BindBuffer(m_Target, 0);
+        }
         m_IsResident = false;
     }
 
@@ -188,28 +150,13 @@ namespace Isle
         if (m_Type != GFX_BUFFER_TYPE::VERTEX || !m_VAO)
             return;
 
-        glBindVertexArray(m_VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_Id);
-
-        for (const auto& attrib : m_VertexAttributes)
-        {
-            glEnableVertexAttribArray(attrib.index);
-            glVertexAttribPointer(attrib.index, attrib.size, attrib.type,
-                attrib.normalized, attrib.stride, attrib.pointer);
-
-            if (attrib.divisor > 0)
-            {
-                glVertexAttribDivisor(attrib.index, attrib.divisor);
-            }
-        }
+        GfxDevice* device = GfxDevice::Get();
+        device->SetVertexAttributes(m_VAO, m_Id, m_VertexAttributes);
 
         if (m_AssociatedIndexBuffer && m_AssociatedIndexBuffer->GetType() == GFX_BUFFER_TYPE::INDEX)
         {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_AssociatedIndexBuffer->GetId());
+            device->SetIndexBuffer(m_VAO, m_AssociatedIndexBuffer->GetId());
         }
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
     }
 
     void GfxBuffer::SetIndexBuffer(GfxBuffer* indexBuffer)
@@ -221,9 +168,7 @@ namespace Isle
 
         if (m_AssociatedIndexBuffer)
         {
-            glBindVertexArray(m_VAO);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_AssociatedIndexBuffer->GetId());
-            glBindVertexArray(0);
+            GfxDevice::Get()->SetIndexBuffer(m_VAO, m_AssociatedIndexBuffer->GetId());
         }
     }
 
@@ -232,22 +177,38 @@ namespace Isle
         if (!m_Id || m_LocalData.empty() || !m_Dirty)
             return;
 
-        glBindBuffer(m_Target, m_Id);
-
-        GLint currentSize = 0;
-        glGetBufferParameteriv(m_Target, GL_BUFFER_SIZE, &currentSize);
-
-        if (currentSize == 0 || m_LocalData.size() > static_cast<size_t>(currentSize))
+        // m_SizeInBytes mirrors the GL allocation, no need to query GL_BUFFER_SIZE.
+        if (m_SizeInBytes == 0 || m_LocalData.size() > m_SizeInBytes)
         {
-            glBufferData(m_Target, m_LocalData.size(), m_LocalData.data(), m_UsageHint);
+            GfxDevice::Get()->BufferData(m_Target, m_Id, m_LocalData.size(), m_LocalData.data(), m_UsageHint);
+            SetSizeInBytes(m_LocalData.size());
+            RecordUpload(m_LocalData.size());
         }
         else
         {
-            glBufferSubData(m_Target, 0, m_LocalData.size(), m_LocalData.data());
+            const size_t begin = std::min(m_DirtyBegin, m_LocalData.size());
+            const size_t end = std::min(m_DirtyEnd, m_LocalData.size());
+            if (end > begin)
+            {
+                GfxDevice::Get()->BufferSubData(m_Target, m_Id, begin, end - begin, m_LocalData.data() + begin);
+                RecordUpload(end - begin);
+            }
         }
 
-        glBindBuffer(m_Target, 0);
         m_Dirty = false;
+        m_DirtyBegin = SIZE_MAX;
+        m_DirtyEnd = 0;
+    }
+
+    void GfxBuffer::Resize(size_t bytes)
+    {
+        const size_t previous = m_LocalData.size();
+        if (bytes == previous)
+            return;
+
+        m_LocalData.resize(bytes);
+        if (bytes > previous)
+            MarkDirty(previous, bytes - previous);
     }
 
     void GfxBuffer::Download()
@@ -255,25 +216,19 @@ namespace Isle
         if (!m_Id || m_LocalData.empty())
             return;
 
-        glBindBuffer(m_Target, m_Id);
-        glGetBufferSubData(m_Target, 0, m_LocalData.size(), m_LocalData.data());
-        glBindBuffer(m_Target, 0);
+        GfxDevice::Get()->GetBufferSubData(m_Target, m_Id, 0, m_LocalData.size(), m_LocalData.data());
     }
 
     void GfxBuffer::Clear(GLenum internalFormat, GLenum format, GLenum type, const void* clearValue)
     {
-        glBindBuffer(m_Target, m_Id);
-        glClearBufferData(m_Target, internalFormat, format, type, clearValue);
-        glBindBuffer(m_Target, 0);
+        GfxDevice::Get()->ClearBufferData(m_Id, internalFormat, format, type, clearValue);
         std::fill(m_LocalData.begin(), m_LocalData.end(), 0);
     }
 
     void* GfxBuffer::Map(GLenum access)
     {
         if (m_Mapped) return nullptr;
-        glBindBuffer(m_Target, m_Id);
-        void* ptr = glMapBuffer(m_Target, access);
-        glBindBuffer(m_Target, 0);
+        void* ptr = GfxDevice::Get()->MapBuffer(m_Target, m_Id, access);
         m_Mapped = true;
         return ptr;
     }
@@ -281,20 +236,17 @@ namespace Isle
     void GfxBuffer::Unmap()
     {
         if (!m_Mapped) return;
-        glBindBuffer(m_Target, m_Id);
-        glUnmapBuffer(m_Target);
-        glBindBuffer(m_Target, 0);
+        GfxDevice::Get()->UnmapBuffer(m_Target, m_Id);
         m_Mapped = false;
     }
 
     void GfxBuffer::SetDebugLabel(const std::string& name)
     {
-        if (glObjectLabel)
-        {
-            glObjectLabel(GL_BUFFER, m_Id, -1, name.c_str());
-            if (m_VAO)
-                glObjectLabel(GL_VERTEX_ARRAY, m_VAO, -1, (name + "_VAO").c_str());
-        }
+        GfxResourceTracker::SetLabel(this, name);
+
+        GfxDevice::Get()->SetObjectLabel(GL_BUFFER, m_Id, name);
+        if (m_VAO)
+            GfxDevice::Get()->SetObjectLabel(GL_VERTEX_ARRAY, m_VAO, name + "_VAO");
     }
 
     GLenum GfxBuffer::ResolveTarget(GFX_BUFFER_TYPE type)
@@ -308,6 +260,7 @@ namespace Isle
         case GFX_BUFFER_TYPE::ATOMIC_COUNTER:     return GL_ATOMIC_COUNTER_BUFFER;
         case GFX_BUFFER_TYPE::INDIRECT_DRAW:      return GL_DRAW_INDIRECT_BUFFER;
         case GFX_BUFFER_TYPE::INDIRECT_DISPATCH:  return GL_DISPATCH_INDIRECT_BUFFER;
+        case GFX_BUFFER_TYPE::INDIRECT_PARAMETER: return GL_PARAMETER_BUFFER;
         case GFX_BUFFER_TYPE::PIXEL_PACK:         return GL_PIXEL_PACK_BUFFER;
         case GFX_BUFFER_TYPE::PIXEL_UNPACK:       return GL_PIXEL_UNPACK_BUFFER;
         case GFX_BUFFER_TYPE::TRANSFORM_FEEDBACK: return GL_TRANSFORM_FEEDBACK_BUFFER;
@@ -1,6 +1,7 @@
 #pragma once
 #include <Core/Common/Common.h>
 #include <Core/Graphics/GfxResource/GfxResource.h>
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
 #include <unordered_map>
 
 namespace Isle
@@ -15,6 +16,7 @@ namespace Isle
         ATOMIC_COUNTER,
         INDIRECT_DRAW,
         INDIRECT_DISPATCH,
+        INDIRECT_PARAMETER,
         PIXEL_PACK,
         PIXEL_UNPACK,
         TRANSFORM_FEEDBACK,
@@ -27,17 +29,6 @@ namespace Isle
         STREAM
     };
 
-    struct VertexAttribute
-    {
-        GLuint index;
-        GLint size;
-        GLenum type;
-        GLboolean normalized;
-        GLsizei stride;
-        const void* pointer;
-        GLuint divisor = 0;
-    };
-
     class GfxBuffer : public GfxResource
     {
     private:
@@ -51,17 +42,22 @@ namespace Isle
         bool m_Mapped = false;
         bool m_Dirty = false;
 
+        // Bytes changed since the last upload, only these go up while the GL storage fits.
+        size_t m_DirtyBegin = SIZE_MAX;
+        size_t m_DirtyEnd = 0;
+
         std::vector<uint8_t> m_LocalData;
         std::vector<VertexAttribute> m_VertexAttributes;
 
         GfxBuffer* m_AssociatedIndexBuffer = nullptr;
 
     public:
-        GfxBuffer() = default;
+        GfxBuffer() : GfxResource(GFX_RESOURCE_CATEGORY::BUFFER) {}
         ~GfxBuffer() override;
 
         GfxBuffer(GFX_BUFFER_TYPE type, GLsizeiptr size = 0, const void* data = nullptr,
             GFX_BUFFER_USAGE usage = GFX_BUFFER_USAGE::STATIC)
+            : GfxResource(GFX_RESOURCE_CATEGORY::BUFFER)
         {
             Create(type, size, data, usage);
         }
@@ -75,6 +71,7 @@ namespace Isle
 
         void Bind(uint32_t slot = 0) override;
         void Unbind(uint32_t slot = 0) override;
+        void BindAs(GFX_BUFFER_TYPE type, uint32_t slot = 0);
 
         void AddVertexAttribute(GLuint index, GLint size, GLenum type,
             GLboolean normalized, GLsizei stride,
@@ -121,8 +118,7 @@ namespace Isle
             const uint8_t* src = reinterpret_cast<const uint8_t*>(&element);
             m_LocalData.insert(m_LocalData.end(), src, src + bytes);
 
-            m_Dirty = true;
-            m_SizeInBytes = m_LocalData.size();
+            MarkDirty(currentElements * sizeof(T), bytes);
 
             return currentElements;
         }
@@ -144,8 +140,7 @@ namespace Isle
             const uint8_t* src = reinterpret_cast<const uint8_t*>(elements.data());
             m_LocalData.insert(m_LocalData.end(), src, src + bytes);
 
-            m_Dirty = true;
-            m_SizeInBytes = m_LocalData.size();
+            MarkDirty(currentElements * sizeof(T), bytes);
 
             return currentElements;
         }
@@ -156,7 +151,16 @@ namespace Isle
         static GLenum ResolveTarget(GFX_BUFFER_TYPE type);
         static GLenum ResolveUsage(GFX_BUFFER_USAGE usage);
 
-        void MarkDirty() { m_Dirty = true; }
+        // Resizes the CPU copy, new bytes are zero. The GL storage follows on the next Upload().
+        void Resize(size_t bytes);
+
+        void MarkDirty() { MarkDirty(0, SIZE_MAX); }
+        void MarkDirty(size_t offset, size_t bytes)
+        {
+            m_Dirty = true;
+            m_DirtyBegin = std::min(m_DirtyBegin, offset);
+            m_DirtyEnd = std::max(m_DirtyEnd, bytes > SIZE_MAX - offset ? SIZE_MAX : offset + bytes);
+        }
         bool IsDirty() const { return m_Dirty; }
         GLsizeiptr GetSize() const { return static_cast<GLsizeiptr>(m_LocalData.size()); }
         GLuint GetId() const { return m_Id; }
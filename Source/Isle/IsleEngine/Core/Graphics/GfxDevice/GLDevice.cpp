@@ -0,0 +1,630 @@
+// GLDevice.cpp
+#include "GLDevice.h"
+
+namespace Isle
+{
+    GLuint GLDevice::CreateBuffer()
+    {
+        GLuint id = 0;
+        glGenBuffers(1, &id);
+        return id;
+    }
+
+    void GLDevice::DestroyBuffer(GLuint id)
+    {
+        glDeleteBuffers(1, &id);
+    }
+
+    void GLDevice::BindBuffer(GLenum target, GLuint id)
+    {
+        glBindBuffer(target, id);
+    }
+
+    void GLDevice::BindBufferBase(GLenum target, GLuint slot, GLuint id)
+    {
+        glBindBufferBase(target, slot, id);
+    }
+
+    void GLDevice::BufferData(GLenum target, GLuint id, size_t size, const void* data, GLenum usage)
+    {
+        glBindBuffer(target, id);
+        glBufferData(target, static_cast<GLsizeiptr>(size), data, usage);
+        glBindBuffer(target, 0);
+    }
+
+    void GLDevice::BufferSubData(GLenum target, GLuint id, size_t offset, size_t size, const void* data)
+    {
+        glBindBuffer(target, id);
+        glBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+        glBindBuffer(target, 0);
+    }
+
+    void GLDevice::GetBufferSubData(GLenum target, GLuint id, size_t offset, size_t size, void* outData)
+    {
+        glBindBuffer(target, id);
+        glGetBufferSubData(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), outData);
+        glBindBuffer(target, 0);
+    }
+
+    void GLDevice::CopyBufferSubData(GLuint source, GLuint dest, size_t sourceOffset, size_t destOffset, size_t size)
+    {
+        glCopyNamedBufferSubData(source, dest, static_cast<GLintptr>(sourceOffset), static_cast<GLintptr>(destOffset),
+            static_cast<GLsizeiptr>(size));
+    }
+
+    void GLDevice::ClearBufferData(GLuint id, GLenum internalFormat, GLenum format, GLenum type, const void* value)
+    {
+        glClearNamedBufferData(id, internalFormat, format, type, value);
+    }
+
+    void* GLDevice::MapBuffer(GLenum target, GLuint id, GLenum access)
+    {
+        glBindBuffer(target, id);
+        void* ptr = glMapBuffer(target, access);
+        glBindBuffer(target, 0);
+        return ptr;
+    }
+
+    void GLDevice::UnmapBuffer(GLenum target, GLuint id)
+    {
+        glBindBuffer(target, id);
+        glUnmapBuffer(target);
+        glBindBuffer(target, 0);
+    }
+
+    GLuint GLDevice::CreateVertexArray()
+    {
+        GLuint id = 0;
+        glGenVertexArrays(1, &id);
+        return id;
+    }
+
+    void GLDevice::DestroyVertexArray(GLuint id)
+    {
+        glDeleteVertexArrays(1, &id);
+    }
+
+    void GLDevice::BindVertexArray(GLuint id)
+    {
+        glBindVertexArray(id);
+    }
+
+    void GLDevice::SetVertexAttributes(GLuint vao, GLuint vertexBuffer, const std::vector<VertexAttribute>& attributes)
+    {
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+
+        for (const VertexAttribute& attrib : attributes)
+        {
+            glEnableVertexAttribArray(attrib.index);
+            glVertexAttribPointer(attrib.index, attrib.size, attrib.type,
+                attrib.normalized, attrib.stride, attrib.pointer);
+
+            if (attrib.divisor > 0)
+                glVertexAttribDivisor(attrib.index, attrib.divisor);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+
+    void GLDevice::SetIndexBuffer(GLuint vao, GLuint indexBuffer)
+    {
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        glBindVertexArray(0);
+    }
+
+    GLuint GLDevice::CreateTexture(GLenum)
+    {
+        GLuint id = 0;
+        glGenTextures(1, &id);
+        return id;
+    }
+
+    void GLDevice::DestroyTexture(GLuint id)
+    {
+        glDeleteTextures(1, &id);
+    }
+
+    void GLDevice::BindTexture(GLuint unit, GLenum target, GLuint id)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(target, id);
+    }
+
+    void GLDevice::BindImageTexture(GLuint unit, GLuint id, GLint level, GLboolean layered, GLenum access, GLenum format)
+    {
+        glBindImageTexture(unit, id, level, layered, 0, access, format);
+    }
+
+    void GLDevice::TexImage(GLenum target, GLuint id, GLint level, GLenum internalFormat, int width, int height, int depth,
+        GLenum format, GLenum type, const void* data)
+    {
+        glBindTexture(target, id);
+        if (target == GL_TEXTURE_3D)
+            glTexImage3D(target, level, internalFormat, width, height, depth, 0, format, type, data);
+        else
+            glTexImage2D(target, level, internalFormat, width, height, 0, format, type, data);
+        glBindTexture(target, 0);
+    }
+
+    void GLDevice::TexStorage(GLenum target, GLuint id, GLint levels, GLenum internalFormat, int width, int height, int depth)
+    {
+        glBindTexture(target, id);
+        if (target == GL_TEXTURE_3D)
+            glTexStorage3D(target, levels, internalFormat, width, height, depth);
+        else
+            glTexStorage2D(target, levels, internalFormat, width, height);
+        glBindTexture(target, 0);
+    }
+
+    void GLDevice::TexSubImage(GLenum target, GLuint id, GLint level, int width, int height, int depth,
+        GLenum format, GLenum type, const void* data)
+    {
+        glBindTexture(target, id);
+        if (target == GL_TEXTURE_3D)
+            glTexSubImage3D(target, level, 0, 0, 0, width, height, depth, format, type, data);
+        else
+            glTexSubImage2D(target, level, 0, 0, width, height, format, type, data);
+        glBindTexture(target, 0);
+    }
+
+    void GLDevice::CompressedTexImage2D(GLuint id, GLint level, GLenum internalFormat, int width, int height,
+        size_t size, const void* data)
+    {
+        glBindTexture(GL_TEXTURE_2D, id);
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, static_cast<GLsizei>(size), data);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void GLDevice::CompressedTexSubImage2D(GLuint id, GLint level, int width, int height, GLenum internalFormat,
+        size_t size, const void* data)
+    {
+        glBindTexture(GL_TEXTURE_2D, id);
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height, internalFormat, static_cast<GLsizei>(size), data);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void GLDevice::CopyTexture2D(GLuint source, GLint sourceLevel, GLuint dest, GLint destLevel, int width, int height)
+    {
+        glCopyImageSubData(
+            source, GL_TEXTURE_2D, sourceLevel, 0, 0, 0,
+            dest, GL_TEXTURE_2D, destLevel, 0, 0, 0,
+            width, height, 1);
+    }
+
+    void GLDevice::CopyTextureRegion2D(GLuint source, GLuint dest, int destX, int destY, int width, int height)
+    {
+        glCopyImageSubData(
+            source, GL_TEXTURE_2D, 0, 0, 0, 0,
+            dest, GL_TEXTURE_2D, 0, destX, destY, 0,
+            width, height, 1);
+    }
+
+    void GLDevice::GetTexImage(GLenum target, GLuint id, GLint level, GLenum format, GLenum type, void* outData)
+    {
+        glBindTexture(target, id);
+        glGetTexImage(target, level, format, type, outData);
+        glBindTexture(target, 0);
+    }
+
+    void GLDevice::ClearTexImage(GLuint id, GLint level, GLenum format, GLenum type, const void* data)
+    {
+        glClearTexImage(id, level, format, type, data);
+    }
+
+    void GLDevice::GenerateMipmap(GLenum target, GLuint id)
+    {
+        glBindTexture(target, id);
+        glGenerateMipmap(target);
+        glBindTexture(target, 0);
+    }
+
+    void GLDevice::TexParameter(GLenum target, GLuint id, GLenum name, GLint value)
+    {
+        glBindTexture(target, id);
+        glTexParameteri(target, name, value);
+        glBindTexture(target, 0);
+    }
+
+    void GLDevice::TexParameter(GLenum target, GLuint id, GLenum name, GLfloat value)
+    {
+        glBindTexture(target, id);
+        glTexParameterf(target, name, value);
+        glBindTexture(target, 0);
+    }
+
+    void GLDevice::TexParameter(GLenum target, GLuint id, GLenum name, const GLfloat* values)
+    {
+        glBindTexture(target, id);
+        glTexParameterfv(target, name, values);
+        glBindTexture(target, 0);
+    }
+
+    uint64_t GLDevice::MakeTextureResident(GLuint id)
+    {
+        GLuint64 handle = glGetTextureHandleARB(id);
+        glMakeTextureHandleResidentARB(handle);
+        return handle;
+    }
+
+    void GLDevice::MakeTextureNonResident(uint64_t handle)
+    {
+        glMakeTextureHandleNonResidentARB(handle);
+    }
+
+    GLuint GLDevice::CreateFrameBuffer()
+    {
+        GLuint id = 0;
+        glGenFramebuffers(1, &id);
+        return id;
+    }
+
+    void GLDevice::DestroyFrameBuffer(GLuint id)
+    {
+        glDeleteFramebuffers(1, &id);
+    }
+
+    void GLDevice::BindFrameBuffer(GLenum target, GLuint id)
+    {
+        glBindFramebuffer(target, id);
+    }
+
+    void GLDevice::FrameBufferTexture(GLuint id, GLenum attachment, GLuint texture, GLint level)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, id);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture, level);
+    }
+
+    void GLDevice::SetDrawBuffers(GLuint id, const GLenum* buffers, GLsizei count)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, id);
+        if (count > 0)
+            glDrawBuffers(count, buffers);
+        else
+            glDrawBuffer(GL_NONE);
+    }
+
+    void GLDevice::SetReadBuffer(GLuint id, GLenum buffer)
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, id);
+        glReadBuffer(buffer);
+    }
+
+    GLenum GLDevice::CheckFrameBufferStatus(GLuint id)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, id);
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return status;
+    }
+
+    void GLDevice::BlitFrameBuffer(GLuint source, GLuint dest, const glm::ivec4& sourceRect, const glm::ivec4& destRect,
+        GLbitfield mask, GLenum filter)
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, source);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dest);
+        glBlitFramebuffer(
+            sourceRect.x, sourceRect.y, sourceRect.z, sourceRect.w,
+            destRect.x, destRect.y, destRect.z, destRect.w,
+            mask, filter);
+    }
+
+    void GLDevice::Clear(GLbitfield mask, const glm::vec4& color, float depth, int stencil)
+    {
+        if (mask & GL_COLOR_BUFFER_BIT)
+            glClearColor(color.r, color.g, color.b, color.a);
+        if (mask & GL_DEPTH_BUFFER_BIT)
+            glClearDepth(depth);
+        if (mask & GL_STENCIL_BUFFER_BIT)
+            glClearStencil(stencil);
+
+        glClear(mask);
+    }
+
+    GLuint GLDevice::CreateProgram()
+    {
+        return glCreateProgram();
+    }
+
+    void GLDevice::DestroyProgram(GLuint program)
+    {
+        glDeleteProgram(program);
+    }
+
+    GLuint GLDevice::CompileShader(GLenum stage, const std::string& source, std::string& outLog)
+    {
+        GLuint shader = glCreateShader(stage);
+
+        const char* src = source.c_str();
+        glShaderSource(shader, 1, &src, nullptr);
+        glCompileShader(shader);
+
+        GLint success = 0;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            GLchar infoLog[1024];
+            glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
+            outLog = infoLog;
+            glDeleteShader(shader);
+            return 0;
+        }
+
+        return shader;
+    }
+
+    void GLDevice::DestroyShader(GLuint shader)
+    {
+        glDeleteShader(shader);
+    }
+
+    void GLDevice::AttachShader(GLuint program, GLuint shader)
+    {
+        glAttachShader(program, shader);
+    }
+
+    void GLDevice::DetachShader(GLuint program, GLuint shader)
+    {
+        glDetachShader(program, shader);
+    }
+
+    bool GLDevice::LinkProgram(GLuint program, std::string& outLog)
+    {
+        glLinkProgram(program);
+
+        GLint success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            GLchar infoLog[1024];
+            glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+            outLog = infoLog;
+            return false;
+        }
+        return true;
+    }
+
+    bool GLDevice::ValidateProgram(GLuint program, std::string& outLog)
+    {
+        glValidateProgram(program);
+
+        GLint validated = 0;
+        glGetProgramiv(program, GL_VALIDATE_STATUS, &validated);
+        if (!validated)
+        {
+            GLchar infoLog[1024];
+            glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+            outLog = infoLog;
+            return false;
+        }
+        return true;
+    }
+
+    void GLDevice::UseProgram(GLuint program)
+    {
+        glUseProgram(program);
+    }
+
+    GLint GLDevice::GetUniformLocation(GLuint program, const char* name)
+    {
+        return glGetUniformLocation(program, name);
+    }
+
+    void GLDevice::SetUniform(GLint location, int value)
+    {
+        glUniform1i(location, value);
+    }
+
+    void GLDevice::SetUniform(GLint location, unsigned int value)
+    {
+        glUniform1ui(location, value);
+    }
+
+    void GLDevice::SetUniform(GLint location, float value)
+    {
+        glUniform1f(location, value);
+    }
+
+    void GLDevice::SetUniform(GLint location, const glm::vec2& value)
+    {
+        glUniform2fv(location, 1, glm::value_ptr(value));
+    }
+
+    void GLDevice::SetUniform(GLint location, const glm::vec3& value)
+    {
+        glUniform3fv(location, 1, glm::value_ptr(value));
+    }
+
+    void GLDevice::SetUniform(GLint location, const glm::vec4& value)
+    {
+        glUniform4fv(location, 1, glm::value_ptr(value));
+    }
+
+    void GLDevice::SetUniform(GLint location, const glm::vec4* values, GLsizei count)
+    {
+        glUniform4fv(location, count, glm::value_ptr(values[0]));
+    }
+
+    void GLDevice::SetUniform(GLint location, const glm::ivec2& value)
+    {
+        glUniform2iv(location, 1, glm::value_ptr(value));
+    }
+
+    void GLDevice::SetUniform(GLint location, const glm::ivec3& value)
+    {
+        glUniform3iv(location, 1, glm::value_ptr(value));
+    }
+
+    void GLDevice::SetUniform(GLint location, const glm::mat3& value)
+    {
+        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+
+    void GLDevice::SetUniform(GLint location, const glm::mat4& value)
+    {
+        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+
+    void GLDevice::SetCapability(GLenum capability, bool enabled)
+    {
+        if (enabled)
+            glEnable(capability);
+        else
+            glDisable(capability);
+    }
+
+    void GLDevice::SetDepthState(bool write, GLenum func)
+    {
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+        glDepthFunc(func);
+    }
+
+    void GLDevice::SetBlendFunc(GLenum source, GLenum dest, GLenum sourceAlpha, GLenum destAlpha)
+    {
+        if (source == sourceAlpha && dest == destAlpha)
+            glBlendFunc(source, dest);
+        else
+            glBlendFuncSeparate(source, dest, sourceAlpha, destAlpha);
+    }
+
+    void GLDevice::SetCullFace(GLenum face)
+    {
+        glCullFace(face);
+    }
+
+    void GLDevice::SetColorMask(bool r, bool g, bool b, bool a)
+    {
+        glColorMask(r ? GL_TRUE : GL_FALSE, g ? GL_TRUE : GL_FALSE, b ? GL_TRUE : GL_FALSE, a ? GL_TRUE : GL_FALSE);
+    }
+
+    void GLDevice::SetViewport(int x, int y, int width, int height)
+    {
+        glViewport(x, y, width, height);
+    }
+
+    void GLDevice::SetScissor(int x, int y, int width, int height)
+    {
+        glScissor(x, y, width, height);
+    }
+
+    void GLDevice::SetViewportIndexed(GLuint index, float x, float y, float width, float height)
+    {
+        glViewportIndexedf(index, x, y, width, height);
+    }
+
+    void GLDevice::SetViewportSwizzle(GLuint index, GLenum x, GLenum y, GLenum z, GLenum w)
+    {
+        glViewportSwizzleNV(index, x, y, z, w);
+    }
+
+    void GLDevice::DrawElements(GLenum mode, GLsizei count, GLenum type, size_t offset)
+    {
+        glDrawElements(mode, count, type, reinterpret_cast<const void*>(offset));
+        m_Stats.m_DrawCalls++;
+    }
+
+    void GLDevice::DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, size_t offset,
+        GLsizei instanceCount, GLint baseVertex, GLuint baseInstance)
+    {
+        glDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, reinterpret_cast<const void*>(offset),
+            instanceCount, baseVertex, baseInstance);
+        m_Stats.m_DrawCalls++;
+    }
+
+    void GLDevice::DrawArraysIndirect(GLenum mode, size_t offset)
+    {
+        glDrawArraysIndirect(mode, reinterpret_cast<const void*>(offset));
+        m_Stats.m_DrawCalls++;
+    }
+
+    void GLDevice::MultiDrawElementsIndirect(GLenum mode, GLenum type, size_t offset, GLsizei drawCount, GLsizei stride)
+    {
+        glMultiDrawElementsIndirect(mode, type, reinterpret_cast<const void*>(offset), drawCount, stride);
+        m_Stats.m_DrawCalls++;
+    }
+
+    void GLDevice::MultiDrawElementsIndirectCount(GLenum mode, GLenum type, size_t offset, size_t countOffset,
+        GLsizei maxDrawCount, GLsizei stride)
+    {
+        glMultiDrawElementsIndirectCount(mode, type, reinterpret_cast<const void*>(offset),
+            static_cast<GLintptr>(countOffset), maxDrawCount, stride);
+        m_Stats.m_DrawCalls++;
+    }
+
+    void GLDevice::DispatchCompute(GLuint groupsX, GLuint groupsY, GLuint groupsZ)
+    {
+        glDispatchCompute(groupsX, groupsY, groupsZ);
+        m_Stats.m_Dispatches++;
+    }
+
+    void GLDevice::Barrier(GLbitfield barriers)
+    {
+        glMemoryBarrier(barriers);
+        m_Stats.m_Barriers++;
+    }
+
+    void GLDevice::Finish()
+    {
+        glFinish();
+    }
+
+    GLsync GLDevice::FenceSync()
+    {
+        return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    bool GLDevice::IsSignaled(GLsync sync)
+    {
+        GLenum status = glClientWaitSync(sync, 0, 0);
+        return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+    }
+
+    void GLDevice::DeleteSync(GLsync sync)
+    {
+        glDeleteSync(sync);
+    }
+
+    void GLDevice::CreateQueries(GLsizei count, GLuint* outQueries)
+    {
+        glGenQueries(count, outQueries);
+    }
+
+    void GLDevice::DestroyQueries(GLsizei count, const GLuint* queries)
+    {
+        glDeleteQueries(count, queries);
+    }
+
+    void GLDevice::QueryTimestamp(GLuint query)
+    {
+        glQueryCounter(query, GL_TIMESTAMP);
+    }
+
+    bool GLDevice::IsQueryAvailable(GLuint query)
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        return available != 0;
+    }
+
+    uint64_t GLDevice::GetQueryResult(GLuint query)
+    {
+        GLuint64 result = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+        return result;
+    }
+
+    int64_t GLDevice::GetTimestamp()
+    {
+        GLint64 timestamp = 0;
+        glGetInteger64v(GL_TIMESTAMP, &timestamp);
+        return timestamp;
+    }
+
+    void GLDevice::SetObjectLabel(GLenum identifier, GLuint id, const std::string& label)
+    {
+        if (glObjectLabel)
+            glObjectLabel(identifier, id, -1, label.c_str());
+    }
+}
@@ -0,0 +1,41 @@
+// GfxDevice.cpp
+#include "GfxDevice.h"
+#include "GLDevice.h"
+#include "NullDevice.h"
+
+namespace Isle
+{
+    static GfxDevice* s_Device = nullptr;
+
+    bool GfxDevice::Initialize(GFX_BACKEND backend)
+    {
+        if (s_Device)
+        {
+            if (s_Device->GetBackend() == backend)
+                return true;
+
+            // Live resources hold names that only mean something to the current device.
+            ISLE_ERROR("GfxDevice already initialized with another backend\n");
+            return false;
+        }
+
+        switch (backend)
+        {
+        case GFX_BACKEND::NULL_DEVICE: s_Device = new NullDevice(); break;
+        default:                       s_Device = new GLDevice(); break;
+        }
+        return true;
+    }
+
+    GfxDevice* GfxDevice::Get()
+    {
+        if (!s_Device)
+            s_Device = new GLDevice();
+        return s_Device;
+    }
+
+    bool GfxDevice::IsNull()
+    {
+        return Get()->GetBackend() == GFX_BACKEND::NULL_DEVICE;
+    }
+}
@@ -0,0 +1,169 @@
+// GfxDevice.h
+#pragma once
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    enum class GFX_BACKEND
+    {
+        OPENGL,
+        NULL_DEVICE
+    };
+
+    struct VertexAttribute
+    {
+        GLuint index;
+        GLint size;
+        GLenum type;
+        GLboolean normalized;
+        GLsizei stride;
+        const void* pointer;
+        GLuint divisor = 0;
+    };
+
+    // Draws and dispatches the device has seen, the null device has nothing else to show.
+    struct GfxDeviceStats
+    {
+        uint64_t m_DrawCalls = 0;
+        uint64_t m_Dispatches = 0;
+        uint64_t m_Barriers = 0;
+    };
+
+    // Every GL call below GfxBuffer, Texture, Texture3D, FrameBuffer, Shader and PipelineState
+    // goes through the active device. Handles stay GL names so callers keep their GLuint ids,
+    // the null device hands out its own and keeps resource contents in CPU memory.
+    class ISLEENGINE_API GfxDevice
+    {
+    public:
+        // Call before any resource is created, without it the first Get() creates the GL device.
+        // The device is never destroyed, resources held by statics release through it at exit.
+        static bool Initialize(GFX_BACKEND backend);
+        static GfxDevice* Get();
+        static bool IsNull();
+
+        virtual ~GfxDevice() = default;
+        virtual GFX_BACKEND GetBackend() const = 0;
+
+        const GfxDeviceStats& GetStats() const { return m_Stats; }
+        void ResetStats() { m_Stats = GfxDeviceStats(); }
+
+        // Buffers
+        virtual GLuint CreateBuffer() = 0;
+        virtual void DestroyBuffer(GLuint id) = 0;
+        virtual void BindBuffer(GLenum target, GLuint id) = 0;
+        virtual void BindBufferBase(GLenum target, GLuint slot, GLuint id) = 0;
+        virtual void BufferData(GLenum target, GLuint id, size_t size, const void* data, GLenum usage) = 0;
+        virtual void BufferSubData(GLenum target, GLuint id, size_t offset, size_t size, const void* data) = 0;
+        virtual void GetBufferSubData(GLenum target, GLuint id, size_t offset, size_t size, void* outData) = 0;
+        virtual void CopyBufferSubData(GLuint source, GLuint dest, size_t sourceOffset, size_t destOffset, size_t size) = 0;
+        virtual void ClearBufferData(GLuint id, GLenum internalFormat, GLenum format, GLenum type, const void* value) = 0;
+        virtual void* MapBuffer(GLenum target, GLuint id, GLenum access) = 0;
+        virtual void UnmapBuffer(GLenum target, GLuint id) = 0;
+
+        // Vertex arrays
+        virtual GLuint CreateVertexArray() = 0;
+        virtual void DestroyVertexArray(GLuint id) = 0;
+        virtual void BindVertexArray(GLuint id) = 0;
+        virtual void SetVertexAttributes(GLuint vao, GLuint vertexBuffer, const std::vector<VertexAttribute>& attributes) = 0;
+        virtual void SetIndexBuffer(GLuint vao, GLuint indexBuffer) = 0;
+
+        // Textures, target is GL_TEXTURE_2D or GL_TEXTURE_3D
+        virtual GLuint CreateTexture(GLenum target) = 0;
+        virtual void DestroyTexture(GLuint id) = 0;
+        virtual void BindTexture(GLuint unit, GLenum target, GLuint id) = 0;
+        virtual void BindImageTexture(GLuint unit, GLuint id, GLint level, GLboolean layered, GLenum access, GLenum format) = 0;
+        virtual void TexImage(GLenum target, GLuint id, GLint level, GLenum internalFormat, int width, int height, int depth,
+            GLenum format, GLenum type, const void* data) = 0;
+        virtual void TexStorage(GLenum target, GLuint id, GLint levels, GLenum internalFormat, int width, int height, int depth) = 0;
+        virtual void TexSubImage(GLenum target, GLuint id, GLint level, int width, int height, int depth,
+            GLenum format, GLenum type, const void* data) = 0;
+        virtual void CompressedTexImage2D(GLuint id, GLint level, GLenum internalFormat, int width, int height,
+            size_t size, const void* data) = 0;
+        virtual void CompressedTexSubImage2D(GLuint id, GLint level, int width, int height, GLenum internalFormat,
+            size_t size, const void* data) = 0;
+        virtual void CopyTexture2D(GLuint source, GLint sourceLevel, GLuint dest, GLint destLevel, int width, int height) = 0;
+        virtual void CopyTextureRegion2D(GLuint source, GLuint dest, int destX, int destY, int width, int height) = 0;
+        virtual void GetTexImage(GLenum target, GLuint id, GLint level, GLenum format, GLenum type, void* outData) = 0;
+        virtual void ClearTexImage(GLuint id, GLint level, GLenum format, GLenum type, const void* data) = 0;
+        virtual void GenerateMipmap(GLenum target, GLuint id) = 0;
+        virtual void TexParameter(GLenum target, GLuint id, GLenum name, GLint value) = 0;
+        virtual void TexParameter(GLenum target, GLuint id, GLenum name, GLfloat value) = 0;
+        virtual void TexParameter(GLenum target, GLuint id, GLenum name, const GLfloat* values) = 0;
+        virtual uint64_t MakeTextureResident(GLuint id) = 0;
+        virtual void MakeTextureNonResident(uint64_t handle) = 0;
+
+        // Framebuffers, id 0 is the default framebuffer
+        virtual GLuint CreateFrameBuffer() = 0;
+        virtual void DestroyFrameBuffer(GLuint id) = 0;
+        virtual void BindFrameBuffer(GLenum target, GLuint id) = 0;
+        virtual void FrameBufferTexture(GLuint id, GLenum attachment, GLuint texture, GLint level) = 0;
+        virtual void SetDrawBuffers(GLuint id, const GLenum* buffers, GLsizei count) = 0;
+        virtual void SetReadBuffer(GLuint id, GLenum buffer) = 0;
+        virtual GLenum CheckFrameBufferStatus(GLuint id) = 0;
+        virtual void BlitFrameBuffer(GLuint source, GLuint dest, const glm::ivec4& sourceRect, const glm::ivec4& destRect,
+            GLbitfield mask, GLenum filter) = 0;
+        virtual void Clear(GLbitfield mask, const glm::vec4& color, float depth = 1.0f, int stencil = 0) = 0;
+
+        // Shaders
+        virtual GLuint CreateProgram() = 0;
+        virtual void DestroyProgram(GLuint program) = 0;
+        virtual GLuint CompileShader(GLenum stage, const std::string& source, std::string& outLog) = 0;
+        virtual void DestroyShader(GLuint shader) = 0;
+        virtual void AttachShader(GLuint program, GLuint shader) = 0;
+        virtual void DetachShader(GLuint program, GLuint shader) = 0;
+        virtual bool LinkProgram(GLuint program, std::string& outLog) = 0;
+        virtual bool ValidateProgram(GLuint program, std::string& outLog) = 0;
+        virtual void UseProgram(GLuint program) = 0;
+        virtual GLint GetUniformLocation(GLuint program, const char* name) = 0;
+        virtual void SetUniform(GLint location, int value) = 0;
+        virtual void SetUniform(GLint location, unsigned int value) = 0;
+        virtual void SetUniform(GLint location, float value) = 0;
+        virtual void SetUniform(GLint location, const glm::vec2& value) = 0;
+        virtual void SetUniform(GLint location, const glm::vec3& value) = 0;
+        virtual void SetUniform(GLint location, const glm::vec4& value) = 0;
+        virtual void SetUniform(GLint location, const glm::vec4* values, GLsizei count) = 0;
+        virtual void SetUniform(GLint location, const glm::ivec2& value) = 0;
+        virtual void SetUniform(GLint location, const glm::ivec3& value) = 0;
+        virtual void SetUniform(GLint location, const glm::mat3& value) = 0;
+        virtual void SetUniform(GLint location, const glm::mat4& value) = 0;
+
+        // Fixed function state
+        virtual void SetCapability(GLenum capability, bool enabled) = 0;
+        virtual void SetDepthState(bool write, GLenum func) = 0;
+        virtual void SetBlendFunc(GLenum source, GLenum dest, GLenum sourceAlpha, GLenum destAlpha) = 0;
+        virtual void SetCullFace(GLenum face) = 0;
+        virtual void SetColorMask(bool r, bool g, bool b, bool a) = 0;
+        virtual void SetViewport(int x, int y, int width, int height) = 0;
+        virtual void SetScissor(int x, int y, int width, int height) = 0;
+        virtual void SetViewportIndexed(GLuint index, float x, float y, float width, float height) = 0;
+        virtual void SetViewportSwizzle(GLuint index, GLenum x, GLenum y, GLenum z, GLenum w) = 0;
+
+        // Work submission
+        virtual void DrawElements(GLenum mode, GLsizei count, GLenum type, size_t offset) = 0;
+        virtual void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, size_t offset,
+            GLsizei instanceCount, GLint baseVertex, GLuint baseInstance) = 0;
+        virtual void DrawArraysIndirect(GLenum mode, size_t offset) = 0;
+        virtual void MultiDrawElementsIndirect(GLenum mode, GLenum type, size_t offset, GLsizei drawCount, GLsizei stride) = 0;
+        virtual void MultiDrawElementsIndirectCount(GLenum mode, GLenum type, size_t offset, size_t countOffset,
+            GLsizei maxDrawCount, GLsizei stride) = 0;
+        virtual void DispatchCompute(GLuint groupsX, GLuint groupsY, GLuint groupsZ) = 0;
+        virtual void Barrier(GLbitfield barriers) = 0;
+        virtual void Finish() = 0;
+
+        // Synchronization and timer queries
+        virtual GLsync FenceSync() = 0;
+        virtual bool IsSignaled(GLsync sync) = 0;
+        virtual void DeleteSync(GLsync sync) = 0;
+        virtual void CreateQueries(GLsizei count, GLuint* outQueries) = 0;
+        virtual void DestroyQueries(GLsizei count, const GLuint* queries) = 0;
+        virtual void QueryTimestamp(GLuint query) = 0;
+        virtual bool IsQueryAvailable(GLuint query) = 0;
+        virtual uint64_t GetQueryResult(GLuint query) = 0;
+        virtual int64_t GetTimestamp() = 0;
+
+        virtual void SetObjectLabel(GLenum identifier, GLuint id, const std::string& label) = 0;
+
+    protected:
+        GfxDeviceStats m_Stats;
+    };
+}
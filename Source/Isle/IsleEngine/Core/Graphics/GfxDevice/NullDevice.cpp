@@ -0,0 +1,615 @@
+// NullDevice.cpp
+#include "NullDevice.h"
+
+namespace Isle
+{
+    const std::vector<uint8_t>* NullDevice::GetBufferData(GLuint id) const
+    {
+        auto it = m_Buffers.find(id);
+        return it != m_Buffers.end() ? &it->second : nullptr;
+    }
+
+    const NullDevice::NullTexture* NullDevice::GetTexture(GLuint id) const
+    {
+        auto it = m_Textures.find(id);
+        return it != m_Textures.end() ? &it->second : nullptr;
+    }
+
+    NullDevice::NullLevel* NullDevice::GetLevel(GLuint texture, GLint level, bool create)
+    {
+        auto it = m_Textures.find(texture);
+        if (it == m_Textures.end() || level < 0)
+            return nullptr;
+
+        std::vector<NullLevel>& levels = it->second.m_Levels;
+        if (static_cast<size_t>(level) >= levels.size())
+        {
+            if (!create)
+                return nullptr;
+            levels.resize(level + 1);
+        }
+        return &levels[level];
+    }
+
+    size_t NullDevice::GetPixelSize(GLenum format, GLenum type)
+    {
+        switch (type)
+        {
+        case GL_UNSIGNED_INT_24_8:               return 4;
+        case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:  return 8;
+        default: break;
+        }
+
+        size_t components = 4;
+        switch (format)
+        {
+        case GL_RED:
+        case GL_RED_INTEGER:
+        case GL_DEPTH_COMPONENT:
+        case GL_STENCIL_INDEX:  components = 1; break;
+        case GL_RG:
+        case GL_RG_INTEGER:     components = 2; break;
+        case GL_RGB:
+        case GL_RGB_INTEGER:    components = 3; break;
+        default:                components = 4; break;
+        }
+
+        switch (type)
+        {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:  return components;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:     return components * 2;
+        default:                return components * 4;
+        }
+    }
+
+    GLuint NullDevice::CreateBuffer()
+    {
+        const GLuint id = NextId();
+        m_Buffers[id];
+        return id;
+    }
+
+    void NullDevice::DestroyBuffer(GLuint id)
+    {
+        m_Buffers.erase(id);
+    }
+
+    void NullDevice::BindBuffer(GLenum, GLuint)
+    {
+    }
+
+    void NullDevice::BindBufferBase(GLenum, GLuint, GLuint)
+    {
+    }
+
+    void NullDevice::BufferData(GLenum, GLuint id, size_t size, const void* data, GLenum)
+    {
+        auto it = m_Buffers.find(id);
+        if (it == m_Buffers.end())
+            return;
+
+        it->second.assign(size, 0);
+        if (data && size > 0)
+            std::memcpy(it->second.data(), data, size);
+    }
+
+    void NullDevice::BufferSubData(GLenum, GLuint id, size_t offset, size_t size, const void* data)
+    {
+        auto it = m_Buffers.find(id);
+        if (it == m_Buffers.end() || !data || offset + size > it->second.size())
+            return;
+
+        std::memcpy(it->second.data() + offset, data, size);
+    }
+
+    void NullDevice::GetBufferSubData(GLenum, GLuint id, size_t offset, size_t size, void* outData)
+    {
+        auto it = m_Buffers.find(id);
+        if (it == m_Buffers.end() || !outData || offset + size > it->second.size())
+            return;
+
+        std::memcpy(outData, it->second.data() + offset, size);
+    }
+
+    void NullDevice::CopyBufferSubData(GLuint source, GLuint dest, size_t sourceOffset, size_t destOffset, size_t size)
+    {
+        auto src = m_Buffers.find(source);
+        auto dst = m_Buffers.find(dest);
+        if (src == m_Buffers.end() || dst == m_Buffers.end() ||
+            sourceOffset + size > src->second.size() || destOffset + size > dst->second.size())
+            return;
+
+        std::memmove(dst->second.data() + destOffset, src->second.data() + sourceOffset, size);
+    }
+
+    void NullDevice::ClearBufferData(GLuint id, GLenum, GLenum format, GLenum type, const void* value)
+    {
+        auto it = m_Buffers.find(id);
+        if (it == m_Buffers.end())
+            return;
+
+        std::vector<uint8_t>& data = it->second;
+        if (!value)
+        {
+            std::fill(data.begin(), data.end(), 0);
+            return;
+        }
+
+        const size_t pixelSize = GetPixelSize(format, type);
+        const uint8_t* pattern = static_cast<const uint8_t*>(value);
+        for (size_t offset = 0; offset + pixelSize <= data.size(); offset += pixelSize)
+            std::memcpy(data.data() + offset, pattern, pixelSize);
+    }
+
+    void* NullDevice::MapBuffer(GLenum, GLuint id, GLenum)
+    {
+        auto it = m_Buffers.find(id);
+        return it != m_Buffers.end() ? it->second.data() : nullptr;
+    }
+
+    void NullDevice::UnmapBuffer(GLenum, GLuint)
+    {
+    }
+
+    GLuint NullDevice::CreateVertexArray()
+    {
+        return NextId();
+    }
+
+    void NullDevice::DestroyVertexArray(GLuint)
+    {
+    }
+
+    void NullDevice::BindVertexArray(GLuint)
+    {
+    }
+
+    void NullDevice::SetVertexAttributes(GLuint, GLuint, const std::vector<VertexAttribute>&)
+    {
+    }
+
+    void NullDevice::SetIndexBuffer(GLuint, GLuint)
+    {
+    }
+
+    GLuint NullDevice::CreateTexture(GLenum target)
+    {
+        const GLuint id = NextId();
+        m_Textures[id].m_Target = target;
+        return id;
+    }
+
+    void NullDevice::DestroyTexture(GLuint id)
+    {
+        m_Textures.erase(id);
+    }
+
+    void NullDevice::BindTexture(GLuint, GLenum, GLuint)
+    {
+    }
+
+    void NullDevice::BindImageTexture(GLuint, GLuint, GLint, GLboolean, GLenum, GLenum)
+    {
+    }
+
+    void NullDevice::TexImage(GLenum, GLuint id, GLint level, GLenum internalFormat, int width, int height, int depth,
+        GLenum format, GLenum type, const void* data)
+    {
+        NullLevel* mip = GetLevel(id, level, true);
+        if (!mip)
+            return;
+
+        m_Textures[id].m_InternalFormat = internalFormat;
+        mip->m_Width = width;
+        mip->m_Height = height;
+        mip->m_Depth = std::max(depth, 1);
+        mip->m_ClearValue.clear();
+        mip->m_Data.clear();
+
+        if (data)
+        {
+            const size_t size = size_t(width) * height * mip->m_Depth * GetPixelSize(format, type);
+            mip->m_Data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        }
+    }
+
+    void NullDevice::TexStorage(GLenum, GLuint id, GLint levels, GLenum internalFormat, int width, int height, int depth)
+    {
+        auto it = m_Textures.find(id);
+        if (it == m_Textures.end())
+            return;
+
+        it->second.m_InternalFormat = internalFormat;
+        it->second.m_Levels.assign(std::max(levels, 1), NullLevel());
+        for (NullLevel& mip : it->second.m_Levels)
+        {
+            mip.m_Width = width;
+            mip.m_Height = height;
+            mip.m_Depth = std::max(depth, 1);
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+            depth = std::max(depth / 2, 1);
+        }
+    }
+
+    void NullDevice::TexSubImage(GLenum, GLuint id, GLint level, int width, int height, int depth,
+        GLenum format, GLenum type, const void* data)
+    {
+        NullLevel* mip = GetLevel(id, level, true);
+        if (!mip || !data)
+            return;
+
+        const size_t size = size_t(width) * height * std::max(depth, 1) * GetPixelSize(format, type);
+        mip->m_Data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+    }
+
+    void NullDevice::CompressedTexImage2D(GLuint id, GLint level, GLenum internalFormat, int width, int height,
+        size_t size, const void* data)
+    {
+        NullLevel* mip = GetLevel(id, level, true);
+        if (!mip)
+            return;
+
+        m_Textures[id].m_InternalFormat = internalFormat;
+        mip->m_Width = width;
+        mip->m_Height = height;
+        mip->m_Depth = 1;
+        mip->m_ClearValue.clear();
+        mip->m_Data.clear();
+
+        if (data)
+            mip->m_Data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+    }
+
+    void NullDevice::CompressedTexSubImage2D(GLuint id, GLint level, int, int, GLenum, size_t size, const void* data)
+    {
+        NullLevel* mip = GetLevel(id, level, true);
+        if (!mip || !data)
+            return;
+
+        mip->m_Data.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+    }
+
+    void NullDevice::CopyTexture2D(GLuint source, GLint sourceLevel, GLuint dest, GLint destLevel, int, int)
+    {
+        const NullLevel* src = GetLevel(source, sourceLevel);
+        NullLevel* dst = GetLevel(dest, destLevel, true);
+        if (!src || !dst)
+            return;
+
+        dst->m_Data = src->m_Data;
+        dst->m_ClearValue = src->m_ClearValue;
+    }
+
+    void NullDevice::CopyTextureRegion2D(GLuint source, GLuint dest, int destX, int destY, int width, int height)
+    {
+        const NullLevel* src = GetLevel(source, 0);
+        NullLevel* dst = GetLevel(dest, 0);
+        if (!src || !dst || src->m_Width <= 0 || src->m_Height <= 0)
+            return;
+
+        const size_t pixelSize = !src->m_Data.empty()
+            ? src->m_Data.size() / (size_t(src->m_Width) * src->m_Height)
+            : src->m_ClearValue.size();
+        if (pixelSize == 0 || destX < 0 || destY < 0 || destX + width > dst->m_Width || destY + height > dst->m_Height)
+            return;
+
+        // Expand a cleared destination so the untouched part keeps reading its clear value.
+        if (dst->m_Data.empty())
+        {
+            dst->m_Data.assign(size_t(dst->m_Width) * dst->m_Height * pixelSize, 0);
+            if (dst->m_ClearValue.size() == pixelSize)
+            {
+                for (size_t i = 0; i < dst->m_Data.size(); i += pixelSize)
+                    std::memcpy(dst->m_Data.data() + i, dst->m_ClearValue.data(), pixelSize);
+            }
+        }
+
+        for (int y = 0; y < height; y++)
+        {
+            uint8_t* row = dst->m_Data.data() + ((size_t(destY) + y) * dst->m_Width + destX) * pixelSize;
+            for (int x = 0; x < width; x++)
+            {
+                const uint8_t* texel = !src->m_Data.empty()
+                    ? src->m_Data.data() + (size_t(y) * src->m_Width + x) * pixelSize
+                    : src->m_ClearValue.data();
+                std::memcpy(row + size_t(x) * pixelSize, texel, pixelSize);
+            }
+        }
+    }
+
+    void NullDevice::GetTexImage(GLenum, GLuint id, GLint level, GLenum format, GLenum type, void* outData)
+    {
+        const NullLevel* mip = GetLevel(id, level);
+        if (!mip || !outData)
+            return;
+
+        uint8_t* out = static_cast<uint8_t*>(outData);
+        const size_t pixelSize = GetPixelSize(format, type);
+        const size_t size = size_t(mip->m_Width) * mip->m_Height * mip->m_Depth * pixelSize;
+
+        if (mip->m_Data.size() == size)
+        {
+            std::memcpy(out, mip->m_Data.data(), size);
+        }
+        else if (mip->m_ClearValue.size() == pixelSize)
+        {
+            for (size_t offset = 0; offset < size; offset += pixelSize)
+                std::memcpy(out + offset, mip->m_ClearValue.data(), pixelSize);
+        }
+        else
+        {
+            std::memset(out, 0, size);
+        }
+    }
+
+    // Only the value is kept, a cleared 3D texture would otherwise cost its full size in RAM.
+    void NullDevice::ClearTexImage(GLuint id, GLint level, GLenum format, GLenum type, const void* data)
+    {
+        NullLevel* mip = GetLevel(id, level);
+        if (!mip)
+            return;
+
+        mip->m_Data.clear();
+        mip->m_ClearValue.assign(GetPixelSize(format, type), 0);
+        if (data)
+            std::memcpy(mip->m_ClearValue.data(), data, mip->m_ClearValue.size());
+    }
+
+    void NullDevice::GenerateMipmap(GLenum, GLuint id)
+    {
+        auto it = m_Textures.find(id);
+        if (it == m_Textures.end() || it->second.m_Levels.empty())
+            return;
+
+        std::vector<NullLevel>& levels = it->second.m_Levels;
+        NullLevel base = levels[0];
+        base.m_Data.clear();
+        base.m_ClearValue.clear();
+
+        levels.resize(1);
+        while (base.m_Width > 1 || base.m_Height > 1 || base.m_Depth > 1)
+        {
+            base.m_Width = std::max(base.m_Width / 2, 1);
+            base.m_Height = std::max(base.m_Height / 2, 1);
+            base.m_Depth = std::max(base.m_Depth / 2, 1);
+            levels.push_back(base);
+        }
+    }
+
+    void NullDevice::TexParameter(GLenum, GLuint, GLenum, GLint)
+    {
+    }
+
+    void NullDevice::TexParameter(GLenum, GLuint, GLenum, GLfloat)
+    {
+    }
+
+    void NullDevice::TexParameter(GLenum, GLuint, GLenum, const GLfloat*)
+    {
+    }
+
+    uint64_t NullDevice::MakeTextureResident(GLuint id)
+    {
+        auto it = m_Textures.find(id);
+        if (it == m_Textures.end())
+            return 0;
+
+        // Never zero, callers treat a zero handle as not resident.
+        it->second.m_Handle = (uint64_t(1) << 32) | id;
+        return it->second.m_Handle;
+    }
+
+    void NullDevice::MakeTextureNonResident(uint64_t handle)
+    {
+        auto it = m_Textures.find(static_cast<GLuint>(handle & 0xFFFFFFFFu));
+        if (it != m_Textures.end())
+            it->second.m_Handle = 0;
+    }
+
+    GLuint NullDevice::CreateFrameBuffer()
+    {
+        return NextId();
+    }
+
+    void NullDevice::DestroyFrameBuffer(GLuint)
+    {
+    }
+
+    void NullDevice::BindFrameBuffer(GLenum, GLuint)
+    {
+    }
+
+    void NullDevice::FrameBufferTexture(GLuint, GLenum, GLuint, GLint)
+    {
+    }
+
+    void NullDevice::SetDrawBuffers(GLuint, const GLenum*, GLsizei)
+    {
+    }
+
+    void NullDevice::SetReadBuffer(GLuint, GLenum)
+    {
+    }
+
+    GLenum NullDevice::CheckFrameBufferStatus(GLuint)
+    {
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    void NullDevice::BlitFrameBuffer(GLuint, GLuint, const glm::ivec4&, const glm::ivec4&, GLbitfield, GLenum)
+    {
+    }
+
+    void NullDevice::Clear(GLbitfield, const glm::vec4&, float, int)
+    {
+    }
+
+    GLuint NullDevice::CreateProgram()
+    {
+        return NextId();
+    }
+
+    void NullDevice::DestroyProgram(GLuint)
+    {
+    }
+
+    GLuint NullDevice::CompileShader(GLenum, const std::string&, std::string&)
+    {
+        return NextId();
+    }
+
+    void NullDevice::DestroyShader(GLuint)
+    {
+    }
+
+    void NullDevice::AttachShader(GLuint, GLuint)
+    {
+    }
+
+    void NullDevice::DetachShader(GLuint, GLuint)
+    {
+    }
+
+    bool NullDevice::LinkProgram(GLuint, std::string&)
+    {
+        return true;
+    }
+
+    bool NullDevice::ValidateProgram(GLuint, std::string&)
+    {
+        return true;
+    }
+
+    void NullDevice::UseProgram(GLuint)
+    {
+    }
+
+    // No uniforms exist, Shader skips the setters on -1.
+    GLint NullDevice::GetUniformLocation(GLuint, const char*)
+    {
+        return -1;
+    }
+
+    void NullDevice::SetUniform(GLint, int) {}
+    void NullDevice::SetUniform(GLint, unsigned int) {}
+    void NullDevice::SetUniform(GLint, float) {}
+    void NullDevice::SetUniform(GLint, const glm::vec2&) {}
+    void NullDevice::SetUniform(GLint, const glm::vec3&) {}
+    void NullDevice::SetUniform(GLint, const glm::vec4&) {}
+    void NullDevice::SetUniform(GLint, const glm::vec4*, GLsizei) {}
+    void NullDevice::SetUniform(GLint, const glm::ivec2&) {}
+    void NullDevice::SetUniform(GLint, const glm::ivec3&) {}
+    void NullDevice::SetUniform(GLint, const glm::mat3&) {}
+    void NullDevice::SetUniform(GLint, const glm::mat4&) {}
+
+    void NullDevice::SetCapability(GLenum, bool) {}
+    void NullDevice::SetDepthState(bool, GLenum) {}
+    void NullDevice::SetBlendFunc(GLenum, GLenum, GLenum, GLenum) {}
+    void NullDevice::SetCullFace(GLenum) {}
+    void NullDevice::SetColorMask(bool, bool, bool, bool) {}
+    void NullDevice::SetViewport(int, int, int, int) {}
+    void NullDevice::SetScissor(int, int, int, int) {}
+    void NullDevice::SetViewportIndexed(GLuint, float, float, float, float) {}
+    void NullDevice::SetViewportSwizzle(GLuint, GLenum, GLenum, GLenum, GLenum) {}
+
+    void NullDevice::DrawElements(GLenum, GLsizei, GLenum, size_t)
+    {
+        m_Stats.m_DrawCalls++;
+    }
+
+    void NullDevice::DrawElementsInstanced(GLenum, GLsizei, GLenum, size_t, GLsizei, GLint, GLuint)
+    {
+        m_Stats.m_DrawCalls++;
+    }
+
+    void NullDevice::DrawArraysIndirect(GLenum, size_t)
+    {
+        m_Stats.m_DrawCalls++;
+    }
+
+    void NullDevice::MultiDrawElementsIndirect(GLenum, GLenum, size_t, GLsizei, GLsizei)
+    {
+        m_Stats.m_DrawCalls++;
+    }
+
+    void NullDevice::MultiDrawElementsIndirectCount(GLenum, GLenum, size_t, size_t, GLsizei, GLsizei)
+    {
+        m_Stats.m_DrawCalls++;
+    }
+
+    void NullDevice::DispatchCompute(GLuint, GLuint, GLuint)
+    {
+        m_Stats.m_Dispatches++;
+    }
+
+    void NullDevice::Barrier(GLbitfield)
+    {
+        m_Stats.m_Barriers++;
+    }
+
+    void NullDevice::Finish()
+    {
+    }
+
+    // Work completes on submission, fences are signaled as soon as they exist.
+    GLsync NullDevice::FenceSync()
+    {
+        return reinterpret_cast<GLsync>(static_cast<uintptr_t>(NextId()));
+    }
+
+    bool NullDevice::IsSignaled(GLsync)
+    {
+        return true;
+    }
+
+    void NullDevice::DeleteSync(GLsync)
+    {
+    }
+
+    void NullDevice::CreateQueries(GLsizei count, GLuint* outQueries)
+    {
+        for (GLsizei i = 0; i < count; i++)
+        {
+            outQueries[i] = NextId();
+            m_Queries[outQueries[i]] = 0;
+        }
+    }
+
+    void NullDevice::DestroyQueries(GLsizei count, const GLuint* queries)
+    {
+        for (GLsizei i = 0; i < count; i++)
+            m_Queries.erase(queries[i]);
+    }
+
+    // Timestamps are taken at submission, GPU scopes show the CPU time spent recording them.
+    void NullDevice::QueryTimestamp(GLuint query)
+    {
+        m_Queries[query] = static_cast<uint64_t>(GetTimestamp());
+    }
+
+    bool NullDevice::IsQueryAvailable(GLuint)
+    {
+        return true;
+    }
+
+    uint64_t NullDevice::GetQueryResult(GLuint query)
+    {
+        auto it = m_Queries.find(query);
+        return it != m_Queries.end() ? it->second : 0;
+    }
+
+    int64_t NullDevice::GetTimestamp()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void NullDevice::SetObjectLabel(GLenum, GLuint, const std::string&)
+    {
+    }
+}
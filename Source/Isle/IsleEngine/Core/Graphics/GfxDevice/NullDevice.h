@@ -0,0 +1,167 @@
+// NullDevice.h
+#pragma once
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
+
+namespace Isle
+{
+    // Runs without a GL context. Buffer and texture contents live in CPU memory so uploads and
+    // readbacks round trip, everything that would execute on the GPU is only counted. Same
+    // threading rules as GL, one thread at a time.
+    class ISLEENGINE_API NullDevice : public GfxDevice
+    {
+    public:
+        struct NullLevel
+        {
+            int m_Width = 0;
+            int m_Height = 0;
+            int m_Depth = 0;
+
+            // Empty until something is uploaded, reads fall back to m_ClearValue.
+            std::vector<uint8_t> m_Data;
+            std::vector<uint8_t> m_ClearValue;
+        };
+
+        struct NullTexture
+        {
+            GLenum m_Target = GL_TEXTURE_2D;
+            GLenum m_InternalFormat = 0;
+            uint64_t m_Handle = 0;
+            std::vector<NullLevel> m_Levels;
+        };
+
+    private:
+        GLuint m_NextId = 1;
+        std::unordered_map<GLuint, std::vector<uint8_t>> m_Buffers;
+        std::unordered_map<GLuint, NullTexture> m_Textures;
+        std::unordered_map<GLuint, uint64_t> m_Queries;
+
+    public:
+        virtual GFX_BACKEND GetBackend() const override { return GFX_BACKEND::NULL_DEVICE; }
+
+        const std::vector<uint8_t>* GetBufferData(GLuint id) const;
+        const NullTexture* GetTexture(GLuint id) const;
+        size_t GetBufferCount() const { return m_Buffers.size(); }
+        size_t GetTextureCount() const { return m_Textures.size(); }
+
+        // Buffers
+        virtual GLuint CreateBuffer() override;
+        virtual void DestroyBuffer(GLuint id) override;
+        virtual void BindBuffer(GLenum target, GLuint id) override;
+        virtual void BindBufferBase(GLenum target, GLuint slot, GLuint id) override;
+        virtual void BufferData(GLenum target, GLuint id, size_t size, const void* data, GLenum usage) override;
+        virtual void BufferSubData(GLenum target, GLuint id, size_t offset, size_t size, const void* data) override;
+        virtual void GetBufferSubData(GLenum target, GLuint id, size_t offset, size_t size, void* outData) override;
+        virtual void CopyBufferSubData(GLuint source, GLuint dest, size_t sourceOffset, size_t destOffset, size_t size) override;
+        virtual void ClearBufferData(GLuint id, GLenum internalFormat, GLenum format, GLenum type, const void* value) override;
+        virtual void* MapBuffer(GLenum target, GLuint id, GLenum access) override;
+        virtual void UnmapBuffer(GLenum target, GLuint id) override;
+
+        // Vertex arrays
+        virtual GLuint CreateVertexArray() override;
+        virtual void DestroyVertexArray(GLuint id) override;
+        virtual void BindVertexArray(GLuint id) override;
+        virtual void SetVertexAttributes(GLuint vao, GLuint vertexBuffer, const std::vector<VertexAttribute>& attributes) override;
+        virtual void SetIndexBuffer(GLuint vao, GLuint indexBuffer) override;
+
+        // Textures, target is GL_TEXTURE_2D or GL_TEXTURE_3D
+        virtual GLuint CreateTexture(GLenum target) override;
+        virtual void DestroyTexture(GLuint id) override;
+        virtual void BindTexture(GLuint unit, GLenum target, GLuint id) override;
+        virtual void BindImageTexture(GLuint unit, GLuint id, GLint level, GLboolean layered, GLenum access, GLenum format) override;
+        virtual void TexImage(GLenum target, GLuint id, GLint level, GLenum internalFormat, int width, int height, int depth,
+            GLenum format, GLenum type, const void* data) override;
+        virtual void TexStorage(GLenum target, GLuint id, GLint levels, GLenum internalFormat, int width, int height, int depth) override;
+        virtual void TexSubImage(GLenum target, GLuint id, GLint level, int width, int height, int depth,
+            GLenum format, GLenum type, const void* data) override;
+        virtual void CompressedTexImage2D(GLuint id, GLint level, GLenum internalFormat, int width, int height,
+            size_t size, const void* data) override;
+        virtual void CompressedTexSubImage2D(GLuint id, GLint level, int width, int height, GLenum internalFormat,
+            size_t size, const void* data) override;
+        virtual void CopyTexture2D(GLuint source, GLint sourceLevel, GLuint dest, GLint destLevel, int width, int height) override;
+        virtual void CopyTextureRegion2D(GLuint source, GLuint dest, int destX, int destY, int width, int height) override;
+        virtual void GetTexImage(GLenum target, GLuint id, GLint level, GLenum format, GLenum type, void* outData) override;
+        virtual void ClearTexImage(GLuint id, GLint level, GLenum format, GLenum type, const void* data) override;
+        virtual void GenerateMipmap(GLenum target, GLuint id) override;
+        virtual void TexParameter(GLenum target, GLuint id, GLenum name, GLint value) override;
+        virtual void TexParameter(GLenum target, GLuint id, GLenum name, GLfloat value) override;
+        virtual void TexParameter(GLenum target, GLuint id, GLenum name, const GLfloat* values) override;
+        virtual uint64_t MakeTextureResident(GLuint id) override;
+        virtual void MakeTextureNonResident(uint64_t handle) override;
+
+        // Framebuffers, id 0 is the default framebuffer
+        virtual GLuint CreateFrameBuffer() override;
+        virtual void DestroyFrameBuffer(GLuint id) override;
+        virtual void BindFrameBuffer(GLenum target, GLuint id) override;
+        virtual void FrameBufferTexture(GLuint id, GLenum attachment, GLuint texture, GLint level) override;
+        virtual void SetDrawBuffers(GLuint id, const GLenum* buffers, GLsizei count) override;
+        virtual void SetReadBuffer(GLuint id, GLenum buffer) override;
+        virtual GLenum CheckFrameBufferStatus(GLuint id) override;
+        virtual void BlitFrameBuffer(GLuint source, GLuint dest, const glm::ivec4& sourceRect, const glm::ivec4& destRect,
+            GLbitfield mask, GLenum filter) override;
+        virtual void Clear(GLbitfield mask, const glm::vec4& color, float depth, int stencil) override;
+
+        // Shaders
+        virtual GLuint CreateProgram() override;
+        virtual void DestroyProgram(GLuint program) override;
+        virtual GLuint CompileShader(GLenum stage, const std::string& source, std::string& outLog) override;
+        virtual void DestroyShader(GLuint shader) override;
+        virtual void AttachShader(GLuint program, GLuint shader) override;
+        virtual void DetachShader(GLuint program, GLuint shader) override;
+        virtual bool LinkProgram(GLuint program, std::string& outLog) override;
+        virtual bool ValidateProgram(GLuint program, std::string& outLog) override;
+        virtual void UseProgram(GLuint program) override;
+        virtual GLint GetUniformLocation(GLuint program, const char* name) override;
+        virtual void SetUniform(GLint location, int value) override;
+        virtual void SetUniform(GLint location, unsigned int value) override;
+        virtual void SetUniform(GLint location, float value) override;
+        virtual void SetUniform(GLint location, const glm::vec2& value) override;
+        virtual void SetUniform(GLint location, const glm::vec3& value) override;
+        virtual void SetUniform(GLint location, const glm::vec4& value) override;
+        virtual void SetUniform(GLint location, const glm::vec4* values, GLsizei count) override;
+        virtual void SetUniform(GLint location, const glm::ivec2& value) override;
+        virtual void SetUniform(GLint location, const glm::ivec3& value) override;
+        virtual void SetUniform(GLint location, const glm::mat3& value) override;
+        virtual void SetUniform(GLint location, const glm::mat4& value) override;
+
+        // Fixed function state
+        virtual void SetCapability(GLenum capability, bool enabled) override;
+        virtual void SetDepthState(bool write, GLenum func) override;
+        virtual void SetBlendFunc(GLenum source, GLenum dest, GLenum sourceAlpha, GLenum destAlpha) override;
+        virtual void SetCullFace(GLenum face) override;
+        virtual void SetColorMask(bool r, bool g, bool b, bool a) override;
+        virtual void SetViewport(int x, int y, int width, int height) override;
+        virtual void SetScissor(int x, int y, int width, int height) override;
+        virtual void SetViewportIndexed(GLuint index, float x, float y, float width, float height) override;
+        virtual void SetViewportSwizzle(GLuint index, GLenum x, GLenum y, GLenum z, GLenum w) override;
+
+        // Work submission
+        virtual void DrawElements(GLenum mode, GLsizei count, GLenum type, size_t offset) override;
+        virtual void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, size_t offset,
+            GLsizei instanceCount, GLint baseVertex, GLuint baseInstance) override;
+        virtual void DrawArraysIndirect(GLenum mode, size_t offset) override;
+        virtual void MultiDrawElementsIndirect(GLenum mode, GLenum type, size_t offset, GLsizei drawCount, GLsizei stride) override;
+        virtual void MultiDrawElementsIndirectCount(GLenum mode, GLenum type, size_t offset, size_t countOffset,
+            GLsizei maxDrawCount, GLsizei stride) override;
+        virtual void DispatchCompute(GLuint groupsX, GLuint groupsY, GLuint groupsZ) override;
+        virtual void Barrier(GLbitfield barriers) override;
+        virtual void Finish() override;
+
+        // Synchronization and timer queries
+        virtual GLsync FenceSync() override;
+        virtual bool IsSignaled(GLsync sync) override;
+        virtual void DeleteSync(GLsync sync) override;
+        virtual void CreateQueries(GLsizei count, GLuint* outQueries) override;
+        virtual void DestroyQueries(GLsizei count, const GLuint* queries) override;
+        virtual void QueryTimestamp(GLuint query) override;
+        virtual bool IsQueryAvailable(GLuint query) override;
+        virtual uint64_t GetQueryResult(GLuint query) override;
+        virtual int64_t GetTimestamp() override;
+
+        virtual void SetObjectLabel(GLenum identifier, GLuint id, const std::string& label) override;
+
+    private:
+        GLuint NextId() { return m_NextId++; }
+        NullLevel* GetLevel(GLuint texture, GLint level, bool create = false);
+        static size_t GetPixelSize(GLenum format, GLenum type);
+    };
+}
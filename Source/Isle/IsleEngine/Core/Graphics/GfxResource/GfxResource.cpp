@@ -3,6 +3,16 @@
 
 namespace Isle
 {
+    GfxResource::GfxResource(GFX_RESOURCE_CATEGORY category)
+    {
+        GfxResourceTracker::Register(this, category);
+    }
+
+    GfxResource::~GfxResource()
+    {
+        GfxResourceTracker::Unregister(this);
+    }
+
     bool GfxResource::IsLoaded() const
     {
         return m_IsLoaded;
@@ -17,4 +27,18 @@ namespace Isle
     {
         return m_SizeInBytes;
     }
+
+    void GfxResource::SetSizeInBytes(size_t bytes)
+    {
+        if (bytes == m_SizeInBytes)
+            return;
+
+        m_SizeInBytes = bytes;
+        GfxResourceTracker::SetSize(this, bytes);
+    }
+
+    void GfxResource::RecordUpload(size_t bytes) const
+    {
+        GfxResourceTracker::RecordUpload(this, bytes);
+    }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 // GfxResource.h
 #pragma once
 #include <Core/Common/Common.h>
+#include <Core/Graphics/GfxResource/GfxResourceTracker.h>
 
 namespace Isle
 {
@@ -12,7 +13,8 @@ namespace Isle
         size_t m_SizeInBytes = 0;
 
     public:
-        virtual ~GfxResource() = default;
+        explicit GfxResource(GFX_RESOURCE_CATEGORY category);
+        virtual ~GfxResource();
 
         virtual void Load() = 0;
         virtual void Unload() = 0;
@@ -22,5 +24,10 @@ namespace Isle
         bool IsLoaded() const;
         bool IsResident() const;
         size_t GetSizeInBytes() const;
+
+    protected:
+        // GPU storage changes go through here so the tracker stays in sync.
+        void SetSizeInBytes(size_t bytes);
+        void RecordUpload(size_t bytes) const;
     };
 }
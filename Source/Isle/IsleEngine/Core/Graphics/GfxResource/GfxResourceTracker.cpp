@@ -0,0 +1,246 @@
+// GfxResourceTracker.cpp
+#include "GfxResourceTracker.h"
+
+namespace Isle
+{
+    namespace
+    {
+        constexpr size_t CATEGORY_COUNT = static_cast<size_t>(GFX_RESOURCE_CATEGORY::COUNT);
+
+        struct CategoryCounters
+        {
+            uint32_t m_Count = 0;
+            size_t m_Bytes = 0;
+            size_t m_PeakBytes = 0;
+            uint32_t m_Uploads = 0;
+            size_t m_UploadBytes = 0;
+            uint32_t m_LastUploads = 0;
+            size_t m_LastUploadBytes = 0;
+        };
+
+        struct TrackerState
+        {
+            std::mutex m_Mutex;
+            std::unordered_map<const GfxResource*, GfxResourceInfo> m_Resources;
+            CategoryCounters m_Categories[CATEGORY_COUNT];
+            size_t m_TotalBytes = 0;
+            size_t m_PeakBytes = 0;
+            uint64_t m_Registered = 0;
+        };
+
+        // Resources owned by singletons and static Refs die after ordinary statics, so the
+        // state is never destroyed.
+        TrackerState& GetState()
+        {
+            static TrackerState* s_State = new TrackerState();
+            return *s_State;
+        }
+
+        CategoryCounters& GetCounters(TrackerState& state, GFX_RESOURCE_CATEGORY category)
+        {
+            return state.m_Categories[static_cast<size_t>(category)];
+        }
+
+        void AddBytes(TrackerState& state, GFX_RESOURCE_CATEGORY category, size_t bytes)
+        {
+            CategoryCounters& counters = GetCounters(state, category);
+            counters.m_Bytes += bytes;
+            counters.m_PeakBytes = std::max(counters.m_PeakBytes, counters.m_Bytes);
+
+            state.m_TotalBytes += bytes;
+            state.m_PeakBytes = std::max(state.m_PeakBytes, state.m_TotalBytes);
+        }
+
+        void RemoveBytes(TrackerState& state, GFX_RESOURCE_CATEGORY category, size_t bytes)
+        {
+            GetCounters(state, category).m_Bytes -= bytes;
+            state.m_TotalBytes -= bytes;
+        }
+    }
+
+    void GfxResourceTracker::Register(const GfxResource* resource, GFX_RESOURCE_CATEGORY category)
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        GfxResourceInfo& info = state.m_Resources[resource];
+        info.m_Resource = resource;
+        info.m_Category = category;
+        GetCounters(state, category).m_Count++;
+        state.m_Registered++;
+    }
+
+    void GfxResourceTracker::Unregister(const GfxResource* resource)
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        auto it = state.m_Resources.find(resource);
+        if (it == state.m_Resources.end())
+            return;
+
+        RemoveBytes(state, it->second.m_Category, it->second.m_Size);
+        GetCounters(state, it->second.m_Category).m_Count--;
+        state.m_Resources.erase(it);
+    }
+
+    void GfxResourceTracker::SetCategory(const GfxResource* resource, GFX_RESOURCE_CATEGORY category)
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        auto it = state.m_Resources.find(resource);
+        if (it == state.m_Resources.end() || it->second.m_Category == category)
+            return;
+
+        GfxResourceInfo& info = it->second;
+        RemoveBytes(state, info.m_Category, info.m_Size);
+        GetCounters(state, info.m_Category).m_Count--;
+
+        info.m_Category = category;
+        AddBytes(state, info.m_Category, info.m_Size);
+        GetCounters(state, info.m_Category).m_Count++;
+    }
+
+    void GfxResourceTracker::SetLabel(const GfxResource* resource, const std::string& label)
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        auto it = state.m_Resources.find(resource);
+        if (it != state.m_Resources.end())
+            it->second.m_Label = label;
+    }
+
+    void GfxResourceTracker::SetSize(const GfxResource* resource, size_t bytes)
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        auto it = state.m_Resources.find(resource);
+        if (it == state.m_Resources.end())
+            return;
+
+        GfxResourceInfo& info = it->second;
+        RemoveBytes(state, info.m_Category, info.m_Size);
+        AddBytes(state, info.m_Category, bytes);
+
+        info.m_Size = bytes;
+        info.m_PeakSize = std::max(info.m_PeakSize, bytes);
+    }
+
+    void GfxResourceTracker::RecordUpload(const GfxResource* resource, size_t bytes)
+    {
+        if (bytes == 0)
+            return;
+
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        auto it = state.m_Resources.find(resource);
+        if (it == state.m_Resources.end())
+            return;
+
+        CategoryCounters& counters = GetCounters(state, it->second.m_Category);
+        counters.m_Uploads++;
+        counters.m_UploadBytes += bytes;
+    }
+
+    void GfxResourceTracker::EndFrame()
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        for (CategoryCounters& counters : state.m_Categories)
+        {
+            counters.m_LastUploads = counters.m_Uploads;
+            counters.m_LastUploadBytes = counters.m_UploadBytes;
+            counters.m_Uploads = 0;
+            counters.m_UploadBytes = 0;
+        }
+    }
+
+    GfxCategoryStats GfxResourceTracker::GetCategoryStats(GFX_RESOURCE_CATEGORY category)
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        const CategoryCounters& counters = GetCounters(state, category);
+
+        GfxCategoryStats stats;
+        stats.m_Count = counters.m_Count;
+        stats.m_Bytes = counters.m_Bytes;
+        stats.m_PeakBytes = counters.m_PeakBytes;
+        stats.m_Uploads = counters.m_LastUploads;
+        stats.m_UploadBytes = counters.m_LastUploadBytes;
+        return stats;
+    }
+
+    size_t GfxResourceTracker::GetTotalBytes()
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+        return state.m_TotalBytes;
+    }
+
+    size_t GfxResourceTracker::GetPeakBytes()
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+        return state.m_PeakBytes;
+    }
+
+    uint64_t GfxResourceTracker::GetRegisterCount()
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+        return state.m_Registered;
+    }
+
+    void GfxResourceTracker::GetResources(std::vector<GfxResourceInfo>& outResources)
+    {
+        TrackerState& state = GetState();
+        std::lock_guard<std::mutex> lock(state.m_Mutex);
+
+        outResources.clear();
+        outResources.reserve(state.m_Resources.size());
+        for (const auto& [resource, info] : state.m_Resources)
+            outResources.push_back(info);
+    }
+
+    size_t GfxResourceTracker::ReportLeaks()
+    {
+        std::vector<GfxResourceInfo> resources;
+        GetResources(resources);
+
+        size_t leakedBytes = 0;
+        size_t leakedCount = 0;
+        for (const GfxResourceInfo& info : resources)
+        {
+            if (info.m_Size == 0)
+                continue;
+
+            ISLE_WARN("Leaked %s '%s': %.2f KB\n", GetCategoryName(info.m_Category),
+                info.m_Label.empty() ? "<unnamed>" : info.m_Label.c_str(), info.m_Size / 1024.0);
+            leakedBytes += info.m_Size;
+            leakedCount++;
+        }
+
+        if (leakedCount > 0)
+            ISLE_WARN("%zu GPU resources still alive at shutdown (%.2f MB)\n", leakedCount, leakedBytes / (1024.0 * 1024.0));
+
+        return leakedCount;
+    }
+
+    const char* GfxResourceTracker::GetCategoryName(GFX_RESOURCE_CATEGORY category)
+    {
+        switch (category)
+        {
+        case GFX_RESOURCE_CATEGORY::BUFFER:      return "Buffer";
+        case GFX_RESOURCE_CATEGORY::TEXTURE:     return "Texture";
+        case GFX_RESOURCE_CATEGORY::TEXTURE3D:   return "Texture3D";
+        case GFX_RESOURCE_CATEGORY::FRAMEBUFFER: return "FrameBuffer";
+        default:                                 return "Unknown";
+        }
+    }
+}
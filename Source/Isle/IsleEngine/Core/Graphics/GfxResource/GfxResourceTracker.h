@@ -0,0 +1,67 @@
+// GfxResourceTracker.h
+#pragma once
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    class GfxResource;
+
+    enum class GFX_RESOURCE_CATEGORY
+    {
+        BUFFER,
+        TEXTURE,
+        TEXTURE3D,
+        FRAMEBUFFER,
+        COUNT
+    };
+
+    struct GfxResourceInfo
+    {
+        const GfxResource* m_Resource = nullptr;
+        GFX_RESOURCE_CATEGORY m_Category = GFX_RESOURCE_CATEGORY::BUFFER;
+        std::string m_Label;
+        size_t m_Size = 0;
+        size_t m_PeakSize = 0;
+    };
+
+    struct GfxCategoryStats
+    {
+        uint32_t m_Count = 0;
+        size_t m_Bytes = 0;
+        size_t m_PeakBytes = 0;
+
+        // Totals of the last finished frame.
+        uint32_t m_Uploads = 0;
+        size_t m_UploadBytes = 0;
+    };
+
+    // Every GfxResource registers itself on construction. Sizes are the GPU storage the
+    // resource owns, render target textures are counted under FRAMEBUFFER.
+    class ISLEENGINE_API GfxResourceTracker
+    {
+    public:
+        static void Register(const GfxResource* resource, GFX_RESOURCE_CATEGORY category);
+        static void Unregister(const GfxResource* resource);
+
+        static void SetCategory(const GfxResource* resource, GFX_RESOURCE_CATEGORY category);
+        static void SetLabel(const GfxResource* resource, const std::string& label);
+        static void SetSize(const GfxResource* resource, size_t bytes);
+        static void RecordUpload(const GfxResource* resource, size_t bytes);
+
+        // Publishes this frame's upload counters and starts a new frame.
+        static void EndFrame();
+
+        static GfxCategoryStats GetCategoryStats(GFX_RESOURCE_CATEGORY category);
+        static size_t GetTotalBytes();
+        static size_t GetPeakBytes();
+
+        // Resources registered since startup, goes up whenever anything is created.
+        static uint64_t GetRegisterCount();
+        static void GetResources(std::vector<GfxResourceInfo>& outResources);
+
+        // Logs every resource still alive, call once the renderer has shut down.
+        static size_t ReportLeaks();
+
+        static const char* GetCategoryName(GFX_RESOURCE_CATEGORY category);
+    };
+}
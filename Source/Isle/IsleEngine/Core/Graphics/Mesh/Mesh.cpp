@@ -29,28 +29,65 @@ namespace Isle
         }
     }
 
-    std::vector<GpuVertex> Mesh::GetVertices()
+    const std::vector<GpuVertex>& Mesh::GetVertices()
     {
         return m_Vertices;
     }
 
-    std::vector<unsigned int> Mesh::GetIndices()
+    const std::vector<unsigned int>& Mesh::GetIndices()
     {
         return m_Indices;
     }
 
+    void Mesh::CopyGeometry(Mesh& source)
+    {
+        m_Vertices = source.m_Vertices;
+        m_Indices = source.m_Indices;
+        m_Meshlets = source.m_Meshlets;
+        m_Lods = source.m_Lods;
+        m_Material = source.m_Material;
+        m_UseViewModel = source.m_UseViewModel;
+        m_AssetId = source.m_AssetId;
+        m_AssetObjectId = source.m_AssetObjectId;
+        MarkDirty();
+    }
+
     void Mesh::SetVertices(std::vector<GpuVertex> vertices)
     {
         m_Vertices = std::move(vertices);
+        m_Meshlets.clear();
+        m_Lods.clear();
         MarkDirty();
     }
 
     void Mesh::SetIndices(std::vector<unsigned int> indices)
     {
         m_Indices = std::move(indices);
+        m_Meshlets.clear();
+        m_Lods.clear();
         MarkDirty();
     }
 
+    void Mesh::BuildMeshlets()
+    {
+        m_Meshlets = MeshletBuilder::Build(m_Vertices, m_Indices);
+    }
+
+    const std::vector<GpuMeshlet>& Mesh::GetMeshlets()
+    {
+        return m_Meshlets;
+    }
+
+    void Mesh::BuildLods(const MeshLodSettings& settings)
+    {
+        m_Lods = MeshSimplifier::BuildLodChain(m_Vertices, m_Indices, settings);
+    }
+
+    const std::vector<MeshLod>& Mesh::GetLods()
+    {
+        return m_Lods;
+    }
+
     bool Mesh::IsDirty()
     {
         return m_Dirty || IsTransformDirty();
@@ -2,19 +2,29 @@
 #include <Core/Common/Common.h>
 #include <Core/Graphics/Material/Material.h>
 #include <Core/Graphics/Structs/GpuStructs.h>
+#include <Core/Graphics/Mesh/Meshlet.h>
+#include <Core/Graphics/Mesh/MeshSimplifier.h>
 
 namespace Isle
 {
     class Mesh : public SceneComponent
     {
+        ISLE_TYPE(Mesh, SceneComponent)
+
     public:
         int m_Id = -1;
 
+        // Where the geometry came from, so a saved scene can reference it instead of storing it.
+        int m_AssetId = -1;
+        int m_AssetObjectId = -1;
+
     protected:
         Ref<Material> m_Material = nullptr;
         bool m_UseViewModel = false;
         std::vector<GpuVertex> m_Vertices;
         std::vector<unsigned int> m_Indices;
+        std::vector<GpuMeshlet> m_Meshlets;
+        std::vector<MeshLod> m_Lods;
         bool m_Dirty = true;
 
     public:
@@ -26,10 +36,19 @@ namespace Isle
         Material* GetMaterial();
         void SetMaterial(Material* material);
 
+        // Takes over geometry, meshlets, LODs, material and asset reference from another mesh.
+        virtual void CopyGeometry(Mesh& source);
+
         void SetVertices(std::vector<GpuVertex> vertices);
         void SetIndices(std::vector<unsigned int> indices);
-        std::vector<GpuVertex> GetVertices();
-        std::vector<unsigned int> GetIndices();
+        const std::vector<GpuVertex>& GetVertices();
+        const std::vector<unsigned int>& GetIndices();
+
+        void BuildMeshlets();
+        const std::vector<GpuMeshlet>& GetMeshlets();
+
+        void BuildLods(const MeshLodSettings& settings = MeshLodSettings());
+        const std::vector<MeshLod>& GetLods();
 
         bool IsDirty();
         void MarkDirty(bool value = true);
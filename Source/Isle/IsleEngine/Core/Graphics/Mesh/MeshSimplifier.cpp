@@ -0,0 +1,387 @@
+// MeshSimplifier.cpp
+#include "MeshSimplifier.h"
+#include <Core/Graphics/Mesh/Meshlet.h>
+
+namespace Isle
+{
+    namespace
+    {
+        struct Quadric
+        {
+            double m_A00 = 0.0, m_A01 = 0.0, m_A02 = 0.0;
+            double m_A11 = 0.0, m_A12 = 0.0, m_A22 = 0.0;
+            double m_B0 = 0.0, m_B1 = 0.0, m_B2 = 0.0;
+            double m_C = 0.0;
+            double m_Weight = 0.0;
+
+            void AddPlane(const glm::dvec3& n, double d, double weight)
+            {
+                m_A00 += weight * n.x * n.x;
+                m_A01 += weight * n.x * n.y;
+                m_A02 += weight * n.x * n.z;
+                m_A11 += weight * n.y * n.y;
+                m_A12 += weight * n.y * n.z;
+                m_A22 += weight * n.z * n.z;
+                m_B0 += weight * n.x * d;
+                m_B1 += weight * n.y * d;
+                m_B2 += weight * n.z * d;
+                m_C += weight * d * d;
+                m_Weight += weight;
+            }
+
+            void Add(const Quadric& other)
+            {
+                m_A00 += other.m_A00; m_A01 += other.m_A01; m_A02 += other.m_A02;
+                m_A11 += other.m_A11; m_A12 += other.m_A12; m_A22 += other.m_A22;
+                m_B0 += other.m_B0; m_B1 += other.m_B1; m_B2 += other.m_B2;
+                m_C += other.m_C;
+                m_Weight += other.m_Weight;
+            }
+
+            double Evaluate(const glm::dvec3& p) const
+            {
+                double rx = m_A00 * p.x + m_A01 * p.y + m_A02 * p.z;
+                double ry = m_A01 * p.x + m_A11 * p.y + m_A12 * p.z;
+                double rz = m_A02 * p.x + m_A12 * p.y + m_A22 * p.z;
+
+                double error = p.x * rx + p.y * ry + p.z * rz +
+                    2.0 * (m_B0 * p.x + m_B1 * p.y + m_B2 * p.z) + m_C;
+
+                return m_Weight > 0.0 ? glm::max(error, 0.0) / m_Weight : 0.0;
+            }
+        };
+
+        struct PositionKey
+        {
+            uint32_t m_X, m_Y, m_Z;
+
+            bool operator==(const PositionKey& other) const
+            {
+                return m_X == other.m_X && m_Y == other.m_Y && m_Z == other.m_Z;
+            }
+        };
+
+        struct PositionKeyHash
+        {
+            size_t operator()(const PositionKey& key) const
+            {
+                return (key.m_X * 73856093u) ^ (key.m_Y * 19349663u) ^ (key.m_Z * 83492791u);
+            }
+        };
+
+        struct Collapse
+        {
+            uint32_t m_From;
+            uint32_t m_To;
+            double m_Cost;
+        };
+
+        PositionKey MakeKey(const glm::vec3& p)
+        {
+            PositionKey key;
+            std::memcpy(&key.m_X, &p.x, sizeof(uint32_t));
+            std::memcpy(&key.m_Y, &p.y, sizeof(uint32_t));
+            std::memcpy(&key.m_Z, &p.z, sizeof(uint32_t));
+            return key;
+        }
+    }
+
+    std::vector<unsigned int> MeshSimplifier::Simplify(
+        const std::vector<GpuVertex>& vertices,
+        const std::vector<unsigned int>& indices,
+        size_t targetIndexCount,
+        float maxError,
+        float* outError)
+    {
+        std::vector<unsigned int> result = indices;
+        double resultError = 0.0;
+
+        if (outError)
+            *outError = 0.0f;
+
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        if (result.size() <= targetIndexCount || vertexCount == 0)
+            return result;
+
+        for (unsigned int index : result)
+        {
+            if (index >= vertexCount)
+            {
+                ISLE_WARN("MeshSimplifier: index %u out of range (%u vertices)\n", index, vertexCount);
+                return result;
+            }
+        }
+
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<uint32_t> canonicalUses(vertexCount, 0);
+        std::vector<uint8_t> referenced(vertexCount, 0);
+
+        for (unsigned int index : result)
+            referenced[index] = 1;
+
+        {
+            std::unordered_map<PositionKey, uint32_t, PositionKeyHash> lookup;
+            lookup.reserve(vertexCount);
+
+            for (uint32_t i = 0; i < vertexCount; i++)
+            {
+                auto it = lookup.emplace(MakeKey(vertices[i].m_Position), i).first;
+                remap[i] = it->second;
+
+                if (referenced[i])
+                    canonicalUses[remap[i]]++;
+            }
+        }
+
+        std::vector<uint8_t> lockedCanonical(vertexCount, 0);
+        for (uint32_t i = 0; i < vertexCount; i++)
+        {
+            if (canonicalUses[remap[i]] > 1)
+                lockedCanonical[remap[i]] = 1;
+        }
+
+        {
+            std::unordered_map<uint64_t, uint32_t> edgeUses;
+            edgeUses.reserve(result.size());
+
+            for (size_t t = 0; t < result.size(); t += 3)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    uint32_t a = remap[result[t + k]];
+                    uint32_t b = remap[result[t + (k + 1) % 3]];
+                    uint64_t key = (uint64_t(glm::min(a, b)) << 32) | glm::max(a, b);
+                    edgeUses[key]++;
+                }
+            }
+
+            for (const auto& [key, uses] : edgeUses)
+            {
+                if (uses != 2)
+                {
+                    lockedCanonical[uint32_t(key >> 32)] = 1;
+                    lockedCanonical[uint32_t(key & 0xFFFFFFFFu)] = 1;
+                }
+            }
+        }
+
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t t = 0; t < result.size(); t += 3)
+        {
+            glm::dvec3 p0 = vertices[result[t + 0]].m_Position;
+            glm::dvec3 p1 = vertices[result[t + 1]].m_Position;
+            glm::dvec3 p2 = vertices[result[t + 2]].m_Position;
+
+            glm::dvec3 n = glm::cross(p1 - p0, p2 - p0);
+            double area = glm::length(n);
+            if (area <= 0.0)
+                continue;
+
+            n /= area;
+            double d = -glm::dot(n, p0);
+
+            for (int k = 0; k < 3; k++)
+                quadrics[remap[result[t + k]]].AddPlane(n, d, area * 0.5);
+        }
+
+        const double maxErrorSq = double(maxError) * double(maxError);
+
+        std::vector<uint32_t> collapse(vertexCount);
+        std::vector<uint8_t> touched(vertexCount);
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1);
+        std::vector<uint32_t> adjacency;
+        std::vector<Collapse> candidates;
+
+        for (int pass = 0; pass < 64 && result.size() > targetIndexCount; pass++)
+        {
+            const uint32_t triangleCount = static_cast<uint32_t>(result.size() / 3);
+
+            std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+            for (unsigned int index : result)
+                adjacencyOffsets[index + 1]++;
+
+            for (uint32_t v = 0; v < vertexCount; v++)
+                adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+            adjacency.resize(result.size());
+            {
+                std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+                for (uint32_t t = 0; t < triangleCount; t++)
+                {
+                    for (int k = 0; k < 3; k++)
+                        adjacency[fill[result[t * 3 + k]]++] = t;
+                }
+            }
+
+            candidates.clear();
+            for (uint32_t t = 0; t < triangleCount; t++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    uint32_t i = result[t * 3 + k];
+                    uint32_t j = result[t * 3 + (k + 1) % 3];
+
+                    if (remap[i] == remap[j])
+                        continue;
+
+                    Quadric q = quadrics[remap[i]];
+                    q.Add(quadrics[remap[j]]);
+
+                    if (!lockedCanonical[remap[i]])
+                        candidates.push_back({ i, j, q.Evaluate(vertices[j].m_Position) });
+
+                    if (!lockedCanonical[remap[j]])
+                        candidates.push_back({ j, i, q.Evaluate(vertices[i].m_Position) });
+                }
+            }
+
+            if (candidates.empty())
+                break;
+
+            std::sort(candidates.begin(), candidates.end(),
+                [](const Collapse& a, const Collapse& b) { return a.m_Cost < b.m_Cost; });
+
+            for (uint32_t v = 0; v < vertexCount; v++)
+                collapse[v] = v;
+            std::fill(touched.begin(), touched.end(), 0);
+
+            const size_t triangleBudget = (result.size() - targetIndexCount) / 3;
+            size_t removedTriangles = 0;
+            size_t applied = 0;
+
+            for (const Collapse& c : candidates)
+            {
+                if (c.m_Cost > maxErrorSq || removedTriangles >= triangleBudget)
+                    break;
+
+                const uint32_t from = c.m_From;
+                const uint32_t to = c.m_To;
+
+                if (touched[remap[from]] || touched[remap[to]])
+                    continue;
+
+                const glm::vec3 target = vertices[to].m_Position;
+                bool flips = false;
+                size_t sharedTriangles = 0;
+
+                for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1] && !flips; a++)
+                {
+                    const uint32_t t = adjacency[a];
+                    const uint32_t v0 = result[t * 3 + 0];
+                    const uint32_t v1 = result[t * 3 + 1];
+                    const uint32_t v2 = result[t * 3 + 2];
+
+                    if (v0 == to || v1 == to || v2 == to)
+                    {
+                        sharedTriangles++;
+                        continue;
+                    }
+
+                    glm::vec3 p0 = vertices[v0].m_Position;
+                    glm::vec3 p1 = vertices[v1].m_Position;
+                    glm::vec3 p2 = vertices[v2].m_Position;
+                    glm::vec3 before = glm::cross(p1 - p0, p2 - p0);
+
+                    if (v0 == from) p0 = target;
+                    if (v1 == from) p1 = target;
+                    if (v2 == from) p2 = target;
+                    glm::vec3 after = glm::cross(p1 - p0, p2 - p0);
+
+                    // Turning more than ~75 degrees also counts, a collapse onto a row of
+                    // border vertices otherwise leaves zero area slivers standing on edge.
+                    flips = glm::dot(before, after) <= 0.25f * glm::length(before) * glm::length(after);
+                }
+
+                if (flips)
+                    continue;
+
+                collapse[from] = to;
+                quadrics[remap[to]].Add(quadrics[remap[from]]);
+                resultError = glm::max(resultError, c.m_Cost);
+
+                touched[remap[from]] = 1;
+                touched[remap[to]] = 1;
+                for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; a++)
+                {
+                    const uint32_t t = adjacency[a];
+                    for (int k = 0; k < 3; k++)
+                        touched[remap[result[t * 3 + k]]] = 1;
+                }
+
+                removedTriangles += sharedTriangles;
+                applied++;
+            }
+
+            if (applied == 0)
+                break;
+
+            size_t write = 0;
+            for (size_t t = 0; t < result.size(); t += 3)
+            {
+                uint32_t a = collapse[result[t + 0]];
+                uint32_t b = collapse[result[t + 1]];
+                uint32_t c = collapse[result[t + 2]];
+
+                if (a == b || b == c || a == c)
+                    continue;
+
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+        }
+
+        if (outError)
+            *outError = static_cast<float>(glm::sqrt(resultError));
+
+        return result;
+    }
+
+    std::vector<MeshLod> MeshSimplifier::BuildLodChain(
+        const std::vector<GpuVertex>& vertices,
+        const std::vector<unsigned int>& indices,
+        const MeshLodSettings& settings)
+    {
+        std::vector<MeshLod> lods;
+
+        if (vertices.empty() || indices.size() < 3)
+            return lods;
+
+        Bounds bounds;
+        for (unsigned int index : indices)
+        {
+            if (index < vertices.size())
+                bounds.Encapsulate(vertices[index].m_Position);
+        }
+
+        const float maxError = settings.m_MaxError * glm::length(bounds.GetSize());
+        std::vector<unsigned int> current = indices;
+        float accumulatedError = 0.0f;
+
+        for (uint32_t lod = 1; lod <= settings.m_MaxLods; lod++)
+        {
+            const size_t targetTriangles = static_cast<size_t>((current.size() / 3) * settings.m_Reduction);
+            if (targetTriangles < settings.m_MinTriangles)
+                break;
+
+            float error = 0.0f;
+            std::vector<unsigned int> simplified = Simplify(vertices, current, targetTriangles * 3, maxError, &error);
+
+            if (simplified.size() * 20 >= current.size() * 19)
+                break;
+
+            accumulatedError += error;
+
+            MeshLod meshLod;
+            meshLod.m_Error = accumulatedError;
+            meshLod.m_Indices = std::move(simplified);
+            meshLod.m_Meshlets = MeshletBuilder::Build(vertices, meshLod.m_Indices);
+
+            current = meshLod.m_Indices;
+            lods.push_back(std::move(meshLod));
+        }
+
+        return lods;
+    }
+}
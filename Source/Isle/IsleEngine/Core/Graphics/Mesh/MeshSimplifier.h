@@ -0,0 +1,42 @@
+// MeshSimplifier.h
+#pragma once
+#include <Core/Common/Common.h>
+#include <Core/Graphics/Structs/GpuStructs.h>
+
+namespace Isle
+{
+    struct MeshLodSettings
+    {
+        uint32_t m_MaxLods = 4;
+        float m_Reduction = 0.5f;
+        float m_MaxError = 0.05f;
+        uint32_t m_MinTriangles = 32;
+    };
+
+    struct MeshLod
+    {
+        std::vector<unsigned int> m_Indices;
+        std::vector<GpuMeshlet> m_Meshlets;
+        float m_Error = 0.0f;
+    };
+
+    class ISLEENGINE_API MeshSimplifier
+    {
+    public:
+        // Quadric error metric edge collapse restricted to existing vertices, so every
+        // LOD shares the source vertex buffer. Seam and border vertices are locked.
+        // Returns the simplified index list; outError receives the object space error.
+        static std::vector<unsigned int> Simplify(
+            const std::vector<GpuVertex>& vertices,
+            const std::vector<unsigned int>& indices,
+            size_t targetIndexCount,
+            float maxError,
+            float* outError = nullptr);
+
+        // Builds LOD1..N. m_MaxError is relative to the mesh bounding box diagonal.
+        static std::vector<MeshLod> BuildLodChain(
+            const std::vector<GpuVertex>& vertices,
+            const std::vector<unsigned int>& indices,
+            const MeshLodSettings& settings = MeshLodSettings());
+    };
+}
@@ -0,0 +1,351 @@
+// Meshlet.cpp
+#include "Meshlet.h"
+
+namespace Isle
+{
+    std::vector<GpuMeshlet> MeshletBuilder::Build(
+        const std::vector<GpuVertex>& vertices,
+        std::vector<unsigned int>& indices,
+        uint32_t maxVertices,
+        uint32_t maxTriangles)
+    {
+        std::vector<GpuMeshlet> meshlets;
+
+        const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+        const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+        if (vertexCount == 0 || triangleCount == 0 || maxVertices < 3 || maxTriangles == 0)
+            return meshlets;
+
+        for (uint32_t i = 0; i < triangleCount * 3; i++)
+        {
+            if (indices[i] >= vertexCount)
+            {
+                ISLE_WARN("MeshletBuilder: index %u out of range (%u vertices)\n", indices[i], vertexCount);
+                return meshlets;
+            }
+        }
+
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (uint32_t i = 0; i < triangleCount * 3; i++)
+            adjacencyOffsets[indices[i] + 1]++;
+
+        for (uint32_t v = 0; v < vertexCount; v++)
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (uint32_t t = 0; t < triangleCount; t++)
+        {
+            adjacency[fill[indices[t * 3 + 0]]++] = t;
+            adjacency[fill[indices[t * 3 + 1]]++] = t;
+            adjacency[fill[indices[t * 3 + 2]]++] = t;
+        }
+
+        std::vector<glm::vec3> centroids(triangleCount);
+        for (uint32_t t = 0; t < triangleCount; t++)
+        {
+            centroids[t] = (vertices[indices[t * 3 + 0]].m_Position +
+                vertices[indices[t * 3 + 1]].m_Position +
+                vertices[indices[t * 3 + 2]].m_Position) / 3.0f;
+        }
+
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        std::vector<uint32_t> vertexStamp(vertexCount, UINT32_MAX);
+
+        std::vector<unsigned int> reordered;
+        reordered.reserve(triangleCount * 3);
+
+        std::vector<uint32_t> meshletVertices;
+        meshletVertices.reserve(maxVertices);
+
+        uint32_t meshletId = 0;
+        uint32_t meshletTriangles = 0;
+        glm::vec3 centroidSum(0.0f);
+        uint32_t remaining = triangleCount;
+        uint32_t cursor = 0;
+
+        auto newVertexCount = [&](uint32_t t) -> uint32_t {
+            uint32_t count = 0;
+            for (uint32_t k = 0; k < 3; k++)
+                count += vertexStamp[indices[t * 3 + k]] != meshletId ? 1 : 0;
+            return count;
+            };
+
+        auto flush = [&]() {
+            if (meshletTriangles == 0)
+                return;
+
+            GpuMeshlet meshlet{};
+            meshlet.m_IndexCount = meshletTriangles * 3;
+            meshlet.m_IndexOffset = static_cast<uint32_t>(reordered.size()) - meshlet.m_IndexCount;
+            ComputeBounds(vertices, reordered.data() + meshlet.m_IndexOffset, meshlet.m_IndexCount, meshlet);
+            meshlets.push_back(meshlet);
+
+            meshletId++;
+            meshletTriangles = 0;
+            centroidSum = glm::vec3(0.0f);
+            meshletVertices.clear();
+            };
+
+        while (remaining > 0)
+        {
+            uint32_t best = UINT32_MAX;
+            uint32_t bestExtra = 4;
+            float bestDistance = FLT_MAX;
+            glm::vec3 centroid = meshletTriangles > 0 ? centroidSum / float(meshletTriangles) : glm::vec3(0.0f);
+
+            for (uint32_t v : meshletVertices)
+            {
+                for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; a++)
+                {
+                    uint32_t t = adjacency[a];
+                    if (emitted[t])
+                        continue;
+
+                    uint32_t extra = newVertexCount(t);
+                    if (meshletVertices.size() + extra > maxVertices)
+                        continue;
+
+                    glm::vec3 delta = centroids[t] - centroid;
+                    float distance = glm::dot(delta, delta);
+
+                    if (extra < bestExtra || (extra == bestExtra && distance < bestDistance))
+                    {
+                        best = t;
+                        bestExtra = extra;
+                        bestDistance = distance;
+                    }
+                }
+            }
+
+            if (best == UINT32_MAX)
+            {
+                while (cursor < triangleCount && emitted[cursor])
+                    cursor++;
+
+                const uint32_t window = 32;
+                uint32_t scanned = 0;
+
+                for (uint32_t t = cursor; t < triangleCount && scanned < window; t++)
+                {
+                    if (emitted[t])
+                        continue;
+
+                    scanned++;
+                    if (meshletVertices.size() + newVertexCount(t) > maxVertices)
+                        continue;
+
+                    glm::vec3 delta = centroids[t] - centroid;
+                    float distance = meshletTriangles > 0 ? glm::dot(delta, delta) : 0.0f;
+
+                    if (distance < bestDistance)
+                    {
+                        best = t;
+                        bestDistance = distance;
+                    }
+                }
+
+                if (best == UINT32_MAX)
+                {
+                    flush();
+                    continue;
+                }
+            }
+
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                uint32_t v = indices[best * 3 + k];
+                if (vertexStamp[v] != meshletId)
+                {
+                    vertexStamp[v] = meshletId;
+                    meshletVertices.push_back(v);
+                }
+                reordered.push_back(v);
+            }
+
+            emitted[best] = 1;
+            remaining--;
+            meshletTriangles++;
+            centroidSum += centroids[best];
+
+            if (meshletTriangles >= maxTriangles)
+                flush();
+        }
+
+        flush();
+
+        indices.swap(reordered);
+        return meshlets;
+    }
+
+    void MeshletBuilder::ComputeBounds(
+        const std::vector<GpuVertex>& vertices,
+        const unsigned int* indices,
+        uint32_t indexCount,
+        GpuMeshlet& meshlet)
+    {
+        glm::vec3 minBounds(FLT_MAX);
+        glm::vec3 maxBounds(-FLT_MAX);
+
+        for (uint32_t i = 0; i < indexCount; i++)
+        {
+            const glm::vec3& p = vertices[indices[i]].m_Position;
+            minBounds = glm::min(minBounds, p);
+            maxBounds = glm::max(maxBounds, p);
+        }
+
+        glm::vec3 center = (minBounds + maxBounds) * 0.5f;
+        float radiusSq = 0.0f;
+
+        for (uint32_t i = 0; i < indexCount; i++)
+        {
+            glm::vec3 delta = vertices[indices[i]].m_Position - center;
+            radiusSq = glm::max(radiusSq, glm::dot(delta, delta));
+        }
+
+        meshlet.m_Center = center;
+        meshlet.m_Radius = glm::sqrt(radiusSq);
+
+        std::vector<glm::vec3> normals;
+        normals.reserve(indexCount / 3);
+        glm::vec3 axis(0.0f);
+
+        for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            const glm::vec3& a = vertices[indices[i + 0]].m_Position;
+            const glm::vec3& b = vertices[indices[i + 1]].m_Position;
+            const glm::vec3& c = vertices[indices[i + 2]].m_Position;
+
+            glm::vec3 n = glm::cross(b - a, c - a);
+            float length = glm::length(n);
+            if (length <= 1e-12f)
+                continue;
+
+            n /= length;
+            normals.push_back(n);
+            axis += n;
+        }
+
+        float axisLength = glm::length(axis);
+        if (normals.empty() || axisLength <= 1e-6f)
+        {
+            meshlet.m_ConeAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+            meshlet.m_ConeCutoff = 1.0f;
+            return;
+        }
+
+        axis /= axisLength;
+
+        float minDot = 1.0f;
+        for (const auto& n : normals)
+            minDot = glm::min(minDot, glm::dot(n, axis));
+
+        meshlet.m_ConeAxis = axis;
+        meshlet.m_ConeCutoff = minDot <= 0.1f ? 1.0f : glm::sqrt(1.0f - minDot * minDot);
+    }
+
+    void MeshletCuller::SetCamera(const glm::mat4& viewProjection, const glm::vec3& cameraPos)
+    {
+        const glm::mat4 m = glm::transpose(viewProjection);
+
+        m_Planes[0] = m[3] + m[0];
+        m_Planes[1] = m[3] - m[0];
+        m_Planes[2] = m[3] + m[1];
+        m_Planes[3] = m[3] - m[1];
+        m_Planes[4] = m[3] + m[2];
+        m_Planes[5] = m[3] - m[2];
+
+        for (auto& plane : m_Planes)
+            plane /= glm::length(glm::vec3(plane));
+
+        m_CameraPos = cameraPos;
+    }
+
+    bool MeshletCuller::IsInFrustum(const glm::vec3& center, float radius) const
+    {
+        for (const auto& plane : m_Planes)
+        {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    bool MeshletCuller::IsBackfacing(const glm::vec3& center, float radius, const glm::vec3& coneAxis, float coneCutoff) const
+    {
+        if (coneCutoff >= 1.0f)
+            return false;
+
+        glm::vec3 view = center - m_CameraPos;
+        return glm::dot(view, coneAxis) >= coneCutoff * glm::length(view) + radius;
+    }
+
+    namespace
+    {
+        // Largest axis scale for the bounding sphere. Non-uniform scale bends normals by
+        // different amounts, so the cone no longer bounds them and backface culling is off.
+        float GetCullScale(const glm::mat3& basis, bool& uniform)
+        {
+            const glm::vec3 scales(glm::length(basis[0]), glm::length(basis[1]), glm::length(basis[2]));
+            const float maxScale = glm::max(scales.x, glm::max(scales.y, scales.z));
+            const float minScale = glm::min(scales.x, glm::min(scales.y, scales.z));
+
+            uniform = maxScale - minScale <= maxScale * 1e-3f;
+            return maxScale;
+        }
+    }
+
+    bool MeshletCuller::IsVisible(const GpuMeshlet& meshlet, const glm::mat4& transform) const
+    {
+        const glm::mat3 basis = glm::mat3(transform);
+        bool uniform = true;
+        const float scale = GetCullScale(basis, uniform);
+
+        glm::vec3 center = glm::vec3(transform * glm::vec4(meshlet.m_Center, 1.0f));
+        float radius = meshlet.m_Radius * scale;
+
+        if (!IsInFrustum(center, radius))
+            return false;
+
+        if (!uniform)
+            return true;
+
+        glm::vec3 axis = glm::normalize(basis * meshlet.m_ConeAxis);
+        return !IsBackfacing(center, radius, axis, meshlet.m_ConeCutoff);
+    }
+
+    uint32_t MeshletCuller::Cull(
+        const std::vector<GpuMeshlet>& meshlets,
+        const glm::mat4& transform,
+        std::vector<GpuDrawCommand>& outCommands) const
+    {
+        const glm::mat3 basis = glm::mat3(transform);
+        bool uniform = true;
+        const float scale = GetCullScale(basis, uniform);
+
+        uint32_t visible = 0;
+        for (const auto& meshlet : meshlets)
+        {
+            glm::vec3 center = glm::vec3(transform * glm::vec4(meshlet.m_Center, 1.0f));
+            float radius = meshlet.m_Radius * scale;
+
+            if (!IsInFrustum(center, radius))
+                continue;
+
+            if (uniform && IsBackfacing(center, radius, glm::normalize(basis * meshlet.m_ConeAxis), meshlet.m_ConeCutoff))
+                continue;
+
+            GpuDrawCommand cmd{};
+            cmd.m_Count = meshlet.m_IndexCount;
+            cmd.m_InstanceCount = 1;
+            cmd.m_FirstIndex = meshlet.m_IndexOffset;
+            cmd.m_BaseVertex = meshlet.m_VertexOffset;
+            cmd.m_BaseInstance = meshlet.m_MeshIndex;
+            outCommands.push_back(cmd);
+            visible++;
+        }
+
+        return visible;
+    }
+}
@@ -0,0 +1,47 @@
+// Meshlet.h
+#pragma once
+#include <Core/Common/Common.h>
+#include <Core/Graphics/Structs/GpuStructs.h>
+
+namespace Isle
+{
+    class ISLEENGINE_API MeshletBuilder
+    {
+    public:
+        static constexpr uint32_t MAX_VERTICES = 64;
+        static constexpr uint32_t MAX_TRIANGLES = 124;
+
+        // Reorders indices so every meshlet is a contiguous index range.
+        // Offsets in the returned meshlets are relative to the mesh.
+        static std::vector<GpuMeshlet> Build(
+            const std::vector<GpuVertex>& vertices,
+            std::vector<unsigned int>& indices,
+            uint32_t maxVertices = MAX_VERTICES,
+            uint32_t maxTriangles = MAX_TRIANGLES);
+
+        static void ComputeBounds(
+            const std::vector<GpuVertex>& vertices,
+            const unsigned int* indices,
+            uint32_t indexCount,
+            GpuMeshlet& meshlet);
+    };
+
+    class ISLEENGINE_API MeshletCuller
+    {
+    public:
+        glm::vec4 m_Planes[6];
+        glm::vec3 m_CameraPos = glm::vec3(0.0f);
+
+    public:
+        void SetCamera(const glm::mat4& viewProjection, const glm::vec3& cameraPos);
+
+        bool IsVisible(const GpuMeshlet& meshlet, const glm::mat4& transform) const;
+        bool IsInFrustum(const glm::vec3& center, float radius) const;
+        bool IsBackfacing(const glm::vec3& center, float radius, const glm::vec3& coneAxis, float coneCutoff) const;
+
+        uint32_t Cull(
+            const std::vector<GpuMeshlet>& meshlets,
+            const glm::mat4& transform,
+            std::vector<GpuDrawCommand>& outCommands) const;
+    };
+}
@@ -184,4 +184,16 @@ namespace Isle
         m_Vertices = Vertices;
         m_Indices = Indices;
     }
-}
\ No newline at end of file
+
+    BEGIN_REFLECT_CLASS(CubeMesh)
+        REFLECT_PARENT_CLASS(StaticMesh)
+    END_REFLECT_CLASS(CubeMesh)
+
+    BEGIN_REFLECT_CLASS(PlaneMesh)
+        REFLECT_PARENT_CLASS(StaticMesh)
+    END_REFLECT_CLASS(PlaneMesh)
+
+    BEGIN_REFLECT_CLASS(SphereMesh)
+        REFLECT_PARENT_CLASS(StaticMesh)
+    END_REFLECT_CLASS(SphereMesh)
+}
@@ -5,6 +5,8 @@ namespace Isle
 {
     class PrimitiveMesh : public StaticMesh
     {
+        ISLE_TYPE(PrimitiveMesh, StaticMesh)
+
     public:
         glm::vec4 m_Color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
 
@@ -17,6 +19,9 @@ namespace Isle
 
     class CubeMesh : public PrimitiveMesh
     {
+        GENERATED_BODY()
+        ISLE_TYPE(CubeMesh, PrimitiveMesh)
+
     public:
         CubeMesh();
         virtual void Build() override;
@@ -24,6 +29,9 @@ namespace Isle
 
     class PlaneMesh : public PrimitiveMesh
     {
+        GENERATED_BODY()
+        ISLE_TYPE(PlaneMesh, PrimitiveMesh)
+
     public:
         PlaneMesh();
         virtual void Build() override;
@@ -31,6 +39,9 @@ namespace Isle
 
     class SphereMesh : public PrimitiveMesh
     {
+        GENERATED_BODY()
+        ISLE_TYPE(SphereMesh, PrimitiveMesh)
+
     public:
         SphereMesh();
         virtual void Build() override;
@@ -0,0 +1,136 @@
+// SkinnedMesh.cpp
+#include "SkinnedMesh.h"
+#include <glm/gtc/packing.hpp>
+
+namespace Isle
+{
+    void SkinnedMesh::SetSkinWeights(const std::vector<glm::uvec4>& joints, const std::vector<glm::vec4>& weights)
+    {
+        const size_t count = glm::min(joints.size(), weights.size());
+        m_SkinWeights.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const glm::uvec4 joint = glm::min(joints[i], glm::uvec4(MAX_JOINTS));
+            glm::vec4 weight = glm::max(weights[i], glm::vec4(0.0f));
+
+            const float sum = weight.x + weight.y + weight.z + weight.w;
+            weight = sum > 0.0f ? weight / sum : glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+
+            GpuSkinnedVertex& skin = m_SkinWeights[i];
+            skin.m_Joints[0] = joint.x | (joint.y << 16);
+            skin.m_Joints[1] = joint.z | (joint.w << 16);
+            skin.m_Weights[0] = glm::packUnorm2x16(glm::vec2(weight.x, weight.y));
+            skin.m_Weights[1] = glm::packUnorm2x16(glm::vec2(weight.z, weight.w));
+        }
+
+        BuildJointBounds();
+        MarkDirty();
+    }
+
+    void SkinnedMesh::SetSkeleton(const std::vector<SceneComponent*>& joints, std::vector<glm::mat4> inverseBindMatrices)
+    {
+        const size_t count = glm::min(joints.size(), static_cast<size_t>(MAX_JOINTS));
+
+        m_Joints.assign(joints.begin(), joints.begin() + count);
+        m_InverseBindMatrices = std::move(inverseBindMatrices);
+        m_InverseBindMatrices.resize(count, glm::mat4(1.0f));
+
+        BuildJointBounds();
+        MarkDirty();
+    }
+
+    Bounds SkinnedMesh::ComputeJointMatrices(glm::mat4* out) const
+    {
+        const glm::mat4 meshFromWorld = glm::inverse(GetWorldMatrix());
+
+        Bounds bounds;
+        for (size_t j = 0; j < m_Joints.size(); j++)
+        {
+            SceneComponent* joint = m_Joints[j].Get();
+            out[j] = joint ? meshFromWorld * joint->GetWorldMatrix() * m_InverseBindMatrices[j] : glm::mat4(1.0f);
+
+            // Every skinned position is a convex blend of positions moved by single joints, so
+            // the joint spheres moved along hold all of them.
+            const glm::vec4& sphere = m_JointBounds[j];
+            if (sphere.w < 0.0f)
+                continue;
+
+            const glm::mat3 basis(out[j]);
+            const float scale = glm::max(glm::length(basis[0]), glm::max(glm::length(basis[1]), glm::length(basis[2])));
+            const glm::vec3 center = glm::vec3(out[j] * glm::vec4(glm::vec3(sphere), 1.0f));
+            const glm::vec3 extent(sphere.w * scale);
+
+            bounds.Encapsulate(center - extent);
+            bounds.Encapsulate(center + extent);
+        }
+
+        return bounds;
+    }
+
+    void SkinnedMesh::CopyGeometry(Mesh& source)
+    {
+        StaticMesh::CopyGeometry(source);
+
+        if (SkinnedMesh* skinned = Cast<SkinnedMesh>(&source))
+        {
+            m_SkinWeights = skinned->m_SkinWeights;
+            m_InverseBindMatrices = skinned->m_InverseBindMatrices;
+            m_JointBounds = skinned->m_JointBounds;
+        }
+    }
+
+    void SkinnedMesh::BuildJointBounds()
+    {
+        const size_t jointCount = m_InverseBindMatrices.size();
+        m_JointBounds.assign(jointCount, glm::vec4(0.0f, 0.0f, 0.0f, -1.0f));
+
+        if (jointCount == 0 || m_SkinWeights.size() != m_Vertices.size())
+            return;
+
+        // Box centre first, then the radius around it, over the vertices each joint moves.
+        std::vector<Bounds> boxes(jointCount);
+        auto forEachInfluence = [&](auto&& func)
+            {
+                for (size_t i = 0; i < m_SkinWeights.size(); i++)
+                {
+                    const GpuSkinnedVertex& skin = m_SkinWeights[i];
+                    const uint32_t joints[4] = {
+                        skin.m_Joints[0] & 0xFFFF, skin.m_Joints[0] >> 16,
+                        skin.m_Joints[1] & 0xFFFF, skin.m_Joints[1] >> 16
+                    };
+                    const uint32_t weights[4] = {
+                        skin.m_Weights[0] & 0xFFFF, skin.m_Weights[0] >> 16,
+                        skin.m_Weights[1] & 0xFFFF, skin.m_Weights[1] >> 16
+                    };
+
+                    for (int k = 0; k < 4; k++)
+                    {
+                        if (weights[k] != 0 && joints[k] < jointCount)
+                            func(joints[k], m_Vertices[i].m_Position);
+                    }
+                }
+            };
+
+        forEachInfluence([&](uint32_t joint, const glm::vec3& position)
+            {
+                boxes[joint].Encapsulate(position);
+            });
+
+        for (size_t j = 0; j < jointCount; j++)
+        {
+            if (boxes[j].IsValid())
+                m_JointBounds[j] = glm::vec4(boxes[j].GetCenter(), 0.0f);
+        }
+
+        forEachInfluence([&](uint32_t joint, const glm::vec3& position)
+            {
+                glm::vec4& sphere = m_JointBounds[joint];
+                sphere.w = glm::max(sphere.w, glm::length(position - glm::vec3(sphere)));
+            });
+    }
+
+    BEGIN_REFLECT_CLASS(SkinnedMesh)
+        REFLECT_PARENT_CLASS(StaticMesh)
+    END_REFLECT_CLASS(SkinnedMesh)
+}
@@ -0,0 +1,49 @@
+// SkinnedMesh.h
+#pragma once
+#include "StaticMesh.h"
+
+namespace Isle
+{
+    // A static mesh whose vertices follow a skeleton. The joints are ordinary scene components,
+    // whatever moves them (animation, gameplay, the editor) moves the mesh.
+    //
+    // The pipeline keeps the bind pose on the side and a compute pass skins it into the mesh's
+    // range of the shared vertex buffer every frame, so every other pass draws it like any
+    // static mesh. Without a skeleton it renders in bind pose.
+    class SkinnedMesh : public StaticMesh
+    {
+        GENERATED_BODY()
+        ISLE_TYPE(SkinnedMesh, StaticMesh)
+
+    public:
+        static constexpr uint32_t MAX_JOINTS = 0xFFFF;
+
+    protected:
+        std::vector<GpuSkinnedVertex> m_SkinWeights;
+        std::vector<glm::mat4> m_InverseBindMatrices;
+        std::vector<WeakRef<SceneComponent>> m_Joints;
+
+        // Bind pose sphere around the vertices each joint moves, xyz centre, w radius.
+        std::vector<glm::vec4> m_JointBounds;
+
+    public:
+        // One entry per vertex, weights are normalised on the way in.
+        void SetSkinWeights(const std::vector<glm::uvec4>& joints, const std::vector<glm::vec4>& weights);
+        const std::vector<GpuSkinnedVertex>& GetSkinWeights() const { return m_SkinWeights; }
+
+        // A joint that goes away holds its bind pose.
+        void SetSkeleton(const std::vector<SceneComponent*>& joints, std::vector<glm::mat4> inverseBindMatrices);
+        uint32_t GetJointCount() const { return static_cast<uint32_t>(m_Joints.size()); }
+        bool HasSkeleton() const { return !m_Joints.empty() && m_SkinWeights.size() == m_Vertices.size(); }
+
+        // Writes one matrix per joint taking bind pose mesh space to the current pose, and
+        // returns bounds that hold the skinned vertices.
+        Bounds ComputeJointMatrices(glm::mat4* out) const;
+
+        // Skeletons point into the source hierarchy, only weights and bind matrices come along.
+        void CopyGeometry(Mesh& source) override;
+
+    private:
+        void BuildJointBounds();
+    };
+}
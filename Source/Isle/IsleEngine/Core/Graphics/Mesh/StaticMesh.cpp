@@ -4,16 +4,34 @@
 
 namespace Isle
 {
+    StaticMesh::~StaticMesh()
+    {
+        // Gives the buffer ranges back, a pipeline that never saw this mesh ignores it.
+        if (m_Id >= 0 && Render::IsValid())
+        {
+            if (Pipeline* pipeline = Render::Instance()->GetPipeline())
+                pipeline->RemoveStaticMesh(this);
+        }
+    }
+
 	GpuStaticMesh StaticMesh::GetGpuStaticMesh()
 	{
         GpuStaticMesh GStaticMesh{};
         GStaticMesh.m_Transform = GetWorldMatrix();
         GStaticMesh.m_NormalMatrix = glm::transpose(glm::inverse(GStaticMesh.m_Transform));
-        GStaticMesh.m_VertexOffset = Render::Instance()->GetPipeline()->GetNumVertices();
-        GStaticMesh.m_IndexOffset = Render::Instance()->GetPipeline()->GetNumIndicies();
         GStaticMesh.m_IndexCount = GetIndices().size();
         GStaticMesh.m_UseViewModel = 0;
 
+        if (m_Bounds.IsValid())
+        {
+            GStaticMesh.m_AABBMin = m_Bounds.m_Min;
+            GStaticMesh.m_AABBMax = m_Bounds.m_Max;
+        }
+
         return GStaticMesh;
 	}
-}
\ No newline at end of file
+
+    BEGIN_REFLECT_CLASS(StaticMesh)
+        REFLECT_PARENT_CLASS(SceneComponent)
+    END_REFLECT_CLASS(StaticMesh)
+}
@@ -5,7 +5,12 @@ namespace Isle
 {
     class StaticMesh : public Mesh
     {
+        GENERATED_BODY()
+        ISLE_TYPE(StaticMesh, Mesh)
+
     public:
+        ~StaticMesh() override;
+
         GpuStaticMesh GetGpuStaticMesh();
     };
 }
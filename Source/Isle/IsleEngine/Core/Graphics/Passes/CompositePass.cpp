@@ -1,29 +1,25 @@
 // CompositePass.cpp
 #include "CompositePass.h"
+#include <Core/Graphics/Pipeline/Pipeline.h>
 
 namespace Isle
 {
     void CompositePass::Start()
     {
-        m_FrameBuffer = New<FrameBuffer>(1920, 1080);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::COLOR, TEXTURE_FORMAT::RGBA16F);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::DEPTH, TEXTURE_FORMAT::DEPTH32F);
-
-        std::vector<ATTACHMENT_TYPE> drawTargets = {
-            ATTACHMENT_TYPE::COLOR
-        };
-        m_FrameBuffer->SetDrawBuffers(drawTargets);
-
-        if (!m_FrameBuffer->CheckStatus())
-        {
-            ISLE_ERROR("CompositePass framebuffer incomplete!\n");
-        }
+        m_Output = New<Texture>(1920, 1080, TEXTURE_FORMAT::RGBA16F);
+        GfxResourceTracker::SetCategory(m_Output.Get(), GFX_RESOURCE_CATEGORY::FRAMEBUFFER);
+        m_Output->SetDebugLabel("Composite/Color");
 
         m_Shader = New<Shader>();
         m_Shader->LoadFromFile(SHADER_TYPE::FRAGMENT, "Resources\\Shaders\\Composite.frag");
         m_Shader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Composite.vert");
         m_Shader->Link();
 
+        m_UpscaleShader = New<Shader>();
+        m_UpscaleShader->LoadFromFile(SHADER_TYPE::FRAGMENT, "Resources\\Shaders\\Upscale.frag");
+        m_UpscaleShader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Composite.vert");
+        m_UpscaleShader->Link();
+
         m_PipelineState = New<PipelineState>();
         m_PipelineState->SetDepthTest(false);
         m_PipelineState->SetDepthWrite(false);
@@ -37,37 +33,87 @@ namespace Isle
 
     void CompositePass::Bind()
     {
-        m_FrameBuffer->Bind();
-        m_FrameBuffer->Clear();
         m_Shader->Bind();
         m_PipelineState->Bind();
     }
 
     void CompositePass::Unbind()
     {
-        m_FrameBuffer->Unbind();
     }
 
     void CompositePass::Destroy()
     {
-        if (m_FrameBuffer)
-            m_FrameBuffer->Destroy();
+        if (m_Output)
+            m_Output->Destroy();
     }
 
-    Ref<Texture> CompositePass::GetOutputTexture()
+    void CompositePass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
     {
-        if (m_FrameBuffer)
-        {
-            return m_FrameBuffer->GetAttachment(ATTACHMENT_TYPE::COLOR);
-        }
-        return nullptr;
+        const glm::ivec2 outputSize = pipeline.GetOutputSize();
+        const glm::ivec2 renderSize = pipeline.GetRenderSize();
+
+        if (m_Output->m_Width != outputSize.x || m_Output->m_Height != outputSize.y)
+            m_Output->Resize(outputSize.x, outputSize.y);
+
+        RenderGraphHandle output = graph.ImportTexture("Final", m_Output);
+        RenderGraphHandle selection = pipeline.HasSelection() ? graph.Find("Selection") : RENDER_GRAPH_NONE;
+
+        // With the reduced resolution path on, composite only upsamples what IndirectPass traced.
+        IndirectPass* indirect = pipeline.GetIndirectPass();
+        m_ReducedGI = indirect && indirect->m_Enabled;
+        m_IndirectDownscale = indirect ? indirect->GetDownscale() : 1;
+
+        RenderGraphBuilder builder = graph.AddPass("Composite", this, [this, &pipeline](RenderGraphContext&)
+            {
+                if (VoxelPass* voxels = pipeline.GetVoxelPass())
+                    voxels->SetConeTraceUniforms(m_Shader.Get());
+
+                m_Shader->SetBool("u_EnableReducedGI", m_ReducedGI);
+                m_Shader->SetInt("u_IndirectDownscale", m_IndirectDownscale);
+
+                if (pipeline.GetFullscreenQuad())
+                    pipeline.GetFullscreenQuad()->Draw();
+            });
+
+        // At full scale composite writes the output directly and there is nothing to upscale.
+        const bool upscale = renderSize != outputSize;
+        RenderGraphHandle scene = upscale
+            ? builder.CreateTexture("Composite/Scene", { renderSize.x, renderSize.y, TEXTURE_FORMAT::RGBA16F })
+            : output;
+
+        builder.Sample(graph.Find("GBuffer/Color"), "u_GColor")
+            .Sample(graph.Find("GBuffer/Normal"), "u_GNormal")
+            .Sample(graph.Find("GBuffer/Material"), "u_GMaterial")
+            .Sample(graph.Find("ShadowMap"), "u_ShadowMap")
+            .Sample(graph.Find("Lighting"), "u_DirectLighting")
+            .Sample(selection, "u_Selection")
+            .Sample(graph.Find("Voxel/Radiance"), "u_VoxelRadiance")
+            .Sample(graph.Find("Voxel/Normal"), "u_VoxelNormal")
+            .Sample(graph.Find("GBuffer/Depth"), "u_DepthBuffer")
+            .Sample(graph.Find("Voxel/Irradiance"), "u_IrradianceCache")
+            .Sample(m_ReducedGI ? graph.Find("Indirect/Diffuse") : RENDER_GRAPH_NONE, "u_IndirectDiffuse")
+            .Sample(m_ReducedGI ? graph.Find("Indirect/Specular") : RENDER_GRAPH_NONE, "u_IndirectSpecular")
+            .WriteAttachment(scene, ATTACHMENT_TYPE::COLOR);
+
+        if (!upscale)
+            return;
+
+        graph.AddPass("Upscale", nullptr, [this, &pipeline](RenderGraphContext& context)
+            {
+                m_UpscaleShader->Bind();
+                m_PipelineState->Bind();
+                context.BindInputs(m_UpscaleShader.Get());
+                m_UpscaleShader->SetFloat("u_Sharpness", m_Sharpness);
+
+                if (pipeline.GetFullscreenQuad())
+                    pipeline.GetFullscreenQuad()->Draw();
+            })
+            .Sample(scene, "u_Source")
+            .WriteAttachment(output, ATTACHMENT_TYPE::COLOR);
     }
 
-    void CompositePass::BlitToScreen()
+    Ref<Texture> CompositePass::GetOutputTexture()
     {
-        if (m_FrameBuffer)
-        {
-            m_FrameBuffer->BlitTo(nullptr, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-        }
+        return m_Output;
     }
 }
\ No newline at end of file
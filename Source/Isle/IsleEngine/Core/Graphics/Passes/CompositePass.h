@@ -6,14 +6,27 @@ namespace Isle
 {
     class CompositePass : public Pass
     {
+    public:
+        // Contrast adaptive sharpening applied when upscaling to the output size, 0 is plain bilinear.
+        float m_Sharpness = 0.5f;
+
     public:
         virtual void Bind() override;
         virtual void Unbind() override;
         virtual void Start() override;
         virtual void Update() override;
         virtual void Destroy() override;
-        
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
+
         Ref<Texture> GetOutputTexture();
-        void BlitToScreen();
+
+    private:
+        // Outlives the frame, the editor viewport shows it.
+        Ref<Texture> m_Output = nullptr;
+        Ref<Shader> m_UpscaleShader = nullptr;
+
+        // Decided in AddToGraph, read when the pass runs.
+        bool m_ReducedGI = false;
+        int m_IndirectDownscale = 1;
     };
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+// CullPass.cpp
+#include "CullPass.h"
+#include <Core/Graphics/Mesh/Meshlet.h>
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
+#include <Core/Graphics/Pipeline/Pipeline.h>
+
+namespace Isle
+{
+    void CullPass::Start()
+    {
+        m_Shader = New<Shader>();
+        m_Shader->LoadFromFile(SHADER_TYPE::COMPUTE, "Resources\\Shaders\\Culling\\MeshletCull.comp");
+        m_Shader->Link();
+
+        m_HiZShader = New<Shader>();
+        m_HiZShader->LoadFromFile(SHADER_TYPE::COMPUTE, "Resources\\Shaders\\Culling\\HiZ.comp");
+        m_HiZShader->Link();
+
+        // The HiZ is created in AddToGraph, once the render size is known.
+    }
+
+    void CullPass::Update()
+    {
+    }
+
+    void CullPass::Bind()
+    {
+        m_Shader->Bind();
+    }
+
+    void CullPass::Unbind()
+    {
+    }
+
+    void CullPass::Destroy()
+    {
+        if (m_HiZ)
+            m_HiZ->Destroy();
+
+        m_HiZValid = false;
+    }
+
+    void CullPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
+    {
+        // Follows window resizes and dynamic resolution. A new HiZ is invalid until the
+        // geometry pass fills it, so occlusion is skipped for that frame instead of reading
+        // mips laid out for the old size.
+        const glm::ivec2 size = pipeline.GetRenderSize();
+        ResizeHiZ(size.x, size.y);
+
+        // Grow the output before importing it, recreating the buffer changes its name.
+        Ref<GfxBuffer> visibleDraws = pipeline.GetVisibleDrawBuffer();
+        const GLsizeiptr visibleBytes = pipeline.GetNumMeshlets() * sizeof(GpuDrawCommand);
+        if (visibleDraws->GetSize() < visibleBytes)
+            visibleDraws->Create(GFX_BUFFER_TYPE::INDIRECT_DRAW, visibleBytes, nullptr, GFX_BUFFER_USAGE::DYNAMIC);
+
+        // Written by the HiZ pass last frame.
+        RenderGraphHandle hiZ = graph.ImportTexture("HiZ", m_HiZ);
+        RenderGraphHandle draws = graph.ImportBuffer("VisibleDraws", visibleDraws.Get());
+        RenderGraphHandle count = graph.ImportBuffer("VisibleCount", pipeline.GetVisibleCountBuffer().Get());
+
+        graph.AddPass("Cull", this, [this, &pipeline](RenderGraphContext&)
+            {
+                pipeline.GetVisibleCountBuffer()->Clear();
+                pipeline.GetVisibleDrawBuffer()->BindAs(GFX_BUFFER_TYPE::STORAGE, 8);
+                pipeline.GetVisibleCountBuffer()->Bind(9);
+
+                Cull(pipeline.GetNumMeshlets(), *pipeline.GetCameraBuffer()->GetDataPtr<GpuCamera>());
+            })
+            .Read(hiZ, RG_ACCESS::SAMPLED)
+            .Write(draws, RG_ACCESS::STORAGE)
+            .Write(count, RG_ACCESS::STORAGE);
+    }
+
+    void CullPass::ResizeHiZ(int width, int height)
+    {
+        if (m_HiZ && width == m_HiZSize.x && height == m_HiZSize.y)
+            return;
+
+        if (m_HiZ)
+            m_HiZ->Destroy();
+        CreateHiZ(width, height);
+    }
+
+    void CullPass::CreateHiZ(int width, int height)
+    {
+        m_HiZ = New<Texture>();
+        m_HiZ->m_MinFilter = TEXTURE_FILTER::NEAREST_MIPMAP_NEAREST;
+        m_HiZ->m_MagFilter = TEXTURE_FILTER::NEAREST;
+        m_HiZ->m_WrapS = TEXTURE_WRAP::CLAMP_TO_EDGE;
+        m_HiZ->m_WrapT = TEXTURE_WRAP::CLAMP_TO_EDGE;
+        m_HiZ->Create(width, height, TEXTURE_FORMAT::R32F);
+        m_HiZ->GenerateMipmaps();
+        m_HiZ->SetDebugLabel("HiZ");
+
+        m_HiZSize = glm::ivec2(width, height);
+        m_HiZMipCount = static_cast<int>(glm::floor(glm::log2(static_cast<float>(glm::max(width, height))))) + 1;
+        m_HiZValid = false;
+    }
+
+    void CullPass::Cull(uint32_t meshletCount, const GpuCamera& camera)
+    {
+        if (meshletCount == 0)
+            return;
+
+        MeshletCuller culler;
+        culler.SetCamera(camera.m_ProjectionMatrix * camera.m_ViewMatrix, camera.m_CameraPos);
+
+        m_Shader->SetVec4Array("u_FrustumPlanes", culler.m_Planes, 6);
+
+        m_Shader->SetUInt("u_MeshletCount", meshletCount);
+        m_Shader->SetBool("u_EnableOcclusion", m_EnableOcclusion && m_HiZValid);
+        m_Shader->SetMat4("u_PrevViewProjection", m_PrevViewProjection);
+        m_Shader->SetIVec2("u_HiZSize", m_HiZSize);
+        m_Shader->SetInt("u_HiZMipCount", m_HiZMipCount);
+        m_Shader->SetFloat("u_LodScale", camera.m_ProjectionMatrix[1][1] * 0.5f * m_HiZSize.y);
+        m_Shader->SetFloat("u_LodPixelError", m_LodPixelError);
+
+        m_HiZ->Bind(7);
+        m_Shader->SetInt("u_HiZ", 7);
+
+        m_Shader->DispatchCompute((meshletCount + 63) / 64, 1, 1);
+    }
+
+    void CullPass::BuildHiZ(Ref<Texture> depth, const glm::mat4& viewProjection)
+    {
+        if (!depth || !m_HiZShader)
+            return;
+
+        ResizeHiZ(depth->m_Width, depth->m_Height);
+
+        m_HiZShader->Bind();
+
+        depth->Bind(7);
+        m_HiZShader->SetInt("u_DepthBuffer", 7);
+
+        glm::ivec2 sourceSize = m_HiZSize;
+        for (int level = 0; level < m_HiZMipCount; level++)
+        {
+            glm::ivec2 destSize = glm::max(m_HiZSize >> level, glm::ivec2(1));
+
+            m_HiZ->BindAsImage(0, GL_READ_ONLY, glm::max(level - 1, 0));
+            m_HiZ->BindAsImage(1, GL_WRITE_ONLY, level);
+
+            m_HiZShader->SetInt("u_Level", level);
+            m_HiZShader->SetIVec2("u_SourceSize", sourceSize);
+            m_HiZShader->SetIVec2("u_DestSize", destSize);
+
+            m_HiZShader->DispatchCompute((destSize.x + 7) / 8, (destSize.y + 7) / 8, 1);
+
+            // Each level reads the one before it, the graph only sees the pass as a whole.
+            if (level + 1 < m_HiZMipCount)
+                GfxDevice::Get()->Barrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+            sourceSize = destSize;
+        }
+
+        m_PrevViewProjection = viewProjection;
+        m_HiZValid = true;
+    }
+}
@@ -0,0 +1,37 @@
+// CullPass.h
+#pragma once
+#include <Core/Graphics/Passes/Pass.h>
+#include <Core/Graphics/Texture/Texture.h>
+#include <Core/Graphics/Structs/GpuStructs.h>
+
+namespace Isle
+{
+    class CullPass : public Pass
+    {
+    public:
+        Ref<Shader> m_HiZShader = nullptr;
+        Ref<Texture> m_HiZ = nullptr;
+
+        glm::mat4 m_PrevViewProjection = glm::mat4(1.0f);
+        glm::ivec2 m_HiZSize = glm::ivec2(0);
+        int m_HiZMipCount = 0;
+        bool m_HiZValid = false;
+        bool m_EnableOcclusion = true;
+        float m_LodPixelError = 1.0f;
+
+    public:
+        virtual void Bind() override;
+        virtual void Unbind() override;
+        virtual void Start() override;
+        virtual void Update() override;
+        virtual void Destroy() override;
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
+
+        void Cull(uint32_t meshletCount, const GpuCamera& camera);
+        void BuildHiZ(Ref<Texture> depth, const glm::mat4& viewProjection);
+        void ResizeHiZ(int width, int height);
+
+    private:
+        void CreateHiZ(int width, int height);
+    };
+}
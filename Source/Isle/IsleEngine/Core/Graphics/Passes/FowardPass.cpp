@@ -9,6 +9,8 @@ namespace Isle
         m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::COLOR, TEXTURE_FORMAT::RGBA8);
         m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::DEPTH, TEXTURE_FORMAT::DEPTH32F);
 
+        m_FrameBuffer->SetDebugLabel("Forward");
+
         if (!m_FrameBuffer->CheckStatus())
         {
             ISLE_ERROR("ForwardPass framebuffer incomplete!\n");
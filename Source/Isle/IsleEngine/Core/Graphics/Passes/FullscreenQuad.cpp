@@ -50,7 +50,7 @@ namespace Isle
             return;
 
         m_VertexBuffer->Bind();
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        GfxDevice::Get()->DrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
         m_VertexBuffer->Unbind();
     }
 }
\ No newline at end of file
@@ -1,30 +1,11 @@
 // FowardPass.cpp
 #include "GeometryPass.h"
+#include <Core/Graphics/Pipeline/Pipeline.h>
 
 namespace Isle
 {
     void GeometryPass::Start()
     {
-        m_FrameBuffer = New<FrameBuffer>(1920, 1080);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::COLOR, TEXTURE_FORMAT::RGBA16F);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::NORMAL, TEXTURE_FORMAT::RGBA16F);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::POSITION, TEXTURE_FORMAT::RGBA32F);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::MATERIAL, TEXTURE_FORMAT::RGBA16F);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::DEPTH, TEXTURE_FORMAT::DEPTH32F);
-
-        std::vector<ATTACHMENT_TYPE> drawTargets = {
-            ATTACHMENT_TYPE::COLOR,
-            ATTACHMENT_TYPE::NORMAL,
-            ATTACHMENT_TYPE::POSITION,
-            ATTACHMENT_TYPE::MATERIAL,
-        };
-        m_FrameBuffer->SetDrawBuffers(drawTargets);
-
-        if (!m_FrameBuffer->CheckStatus())
-        {
-            ISLE_ERROR("ForwardPass framebuffer incomplete!\n");
-        }
-
         m_Shader = New<Shader>();
         m_Shader->LoadFromFile(SHADER_TYPE::FRAGMENT, "Resources\\Shaders\\Geometry.frag");
         m_Shader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Geometry.vert");
@@ -44,16 +25,12 @@ namespace Isle
 
     void GeometryPass::Bind()
     {
-        m_FrameBuffer->Bind();
-
         m_Shader->Bind();
         m_PipelineState->Bind();
-        m_FrameBuffer->Clear();
     }
 
     void GeometryPass::Unbind()
     {
-        m_FrameBuffer->Unbind();
     }
 
     void GeometryPass::Destroy()
@@ -61,4 +38,50 @@ namespace Isle
         if (m_FrameBuffer)
             m_FrameBuffer->Destroy();
     }
+
+    void GeometryPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
+    {
+        const glm::ivec2 size = pipeline.GetRenderSize();
+        RenderGraphHandle draws = graph.Find("VisibleDraws");
+        RenderGraphHandle count = graph.Find("VisibleCount");
+        const bool culled = draws != RENDER_GRAPH_NONE;
+
+        // Texture streaming feedback is written here and read back outside the graph.
+        RenderGraphBuilder builder = graph.AddPass("Geometry", this, [&pipeline, culled](RenderGraphContext&)
+            {
+                TextureStreamer* streamer = pipeline.GetTextureStreamer();
+                if (streamer)
+                    streamer->Bind();
+
+                pipeline.Draw(culled);
+
+                if (streamer)
+                    streamer->RequestFeedback();
+            });
+
+        // Encoding lives in Shaders/Common/GBuffer.glsl, position is rebuilt from depth.
+        RenderGraphHandle color = builder.CreateTexture("GBuffer/Color", { size.x, size.y, TEXTURE_FORMAT::RGBA8 });
+        RenderGraphHandle normal = builder.CreateTexture("GBuffer/Normal", { size.x, size.y, TEXTURE_FORMAT::RG16F });
+        RenderGraphHandle material = builder.CreateTexture("GBuffer/Material", { size.x, size.y, TEXTURE_FORMAT::RGBA8 });
+        RenderGraphHandle depth = builder.CreateTexture("GBuffer/Depth", { size.x, size.y, TEXTURE_FORMAT::DEPTH32F });
+
+        builder.WriteAttachment(color, ATTACHMENT_TYPE::COLOR)
+            .WriteAttachment(normal, ATTACHMENT_TYPE::NORMAL)
+            .WriteAttachment(material, ATTACHMENT_TYPE::MATERIAL)
+            .WriteAttachment(depth, ATTACHMENT_TYPE::DEPTH)
+            .Read(draws, RG_ACCESS::INDIRECT)
+            .Read(count, RG_ACCESS::INDIRECT)
+            .SetSideEffects();
+
+        if (!pipeline.GetCullPass())
+            return;
+
+        graph.AddPass("HiZ", nullptr, [&pipeline, depth](RenderGraphContext& context)
+            {
+                const GpuCamera* cam = pipeline.GetCameraBuffer()->GetDataPtr<GpuCamera>();
+                pipeline.GetCullPass()->BuildHiZ(context.GetTexture(depth), cam->m_ProjectionMatrix * cam->m_ViewMatrix);
+            })
+            .Read(depth, RG_ACCESS::SAMPLED)
+            .Write(graph.Find("HiZ"), RG_ACCESS::IMAGE);
+    }
 }
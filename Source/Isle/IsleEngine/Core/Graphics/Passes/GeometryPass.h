@@ -12,6 +12,7 @@ namespace Isle
         virtual void Start() override;
         virtual void Update() override;
         virtual void Destroy() override;
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
     };
 }
 
@@ -0,0 +1,161 @@
+// IndirectPass.cpp
+#include "IndirectPass.h"
+#include <Core/Graphics/Pipeline/Pipeline.h>
+
+namespace Isle
+{
+    void IndirectPass::Start()
+    {
+        m_Shader = New<Shader>();
+        m_Shader->LoadFromFile(SHADER_TYPE::FRAGMENT, "Resources\\Shaders\\IndirectTrace.frag");
+        m_Shader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Composite.vert");
+        m_Shader->Link();
+
+        m_AccumulateShader = New<Shader>();
+        m_AccumulateShader->LoadFromFile(SHADER_TYPE::FRAGMENT, "Resources\\Shaders\\IndirectAccumulate.frag");
+        m_AccumulateShader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Composite.vert");
+        m_AccumulateShader->Link();
+
+        m_PipelineState = New<PipelineState>();
+        m_PipelineState->SetDepthTest(false);
+        m_PipelineState->SetDepthWrite(false);
+        m_PipelineState->SetCullEnabled(false);
+        m_PipelineState->SetBlendEnabled(false);
+    }
+
+    void IndirectPass::Update()
+    {
+    }
+
+    void IndirectPass::Bind()
+    {
+        m_Shader->Bind();
+        m_PipelineState->Bind();
+    }
+
+    void IndirectPass::Unbind()
+    {
+    }
+
+    void IndirectPass::Destroy()
+    {
+        for (auto& set : m_History)
+        {
+            for (Ref<Texture>& texture : set)
+            {
+                if (texture)
+                    texture->Destroy();
+            }
+        }
+    }
+
+    void IndirectPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
+    {
+        if (!m_Enabled)
+        {
+            m_HistoryValid = false;
+            return;
+        }
+
+        const GpuCamera* camera = pipeline.GetCameraBuffer()->GetDataPtr<GpuCamera>();
+        if (!camera)
+            return;
+
+        const int downscale = GetDownscale();
+        const glm::ivec2 renderSize = pipeline.GetRenderSize();
+        const glm::ivec2 size = glm::max((renderSize + downscale - 1) / downscale, glm::ivec2(1));
+        if (size != m_HistorySize)
+            CreateHistory(size);
+
+        const int current = m_FrameIndex & 1;
+        RenderGraphHandle historyDiffuse = graph.ImportTexture("Indirect/HistoryDiffuse", m_History[current ^ 1][0]);
+        RenderGraphHandle historySpecular = graph.ImportTexture("Indirect/HistorySpecular", m_History[current ^ 1][1]);
+        RenderGraphHandle diffuse = graph.ImportTexture("Indirect/Diffuse", m_History[current][0]);
+        RenderGraphHandle specular = graph.ImportTexture("Indirect/Specular", m_History[current][1]);
+        RenderGraphHandle depth = graph.Find("GBuffer/Depth");
+
+        RenderGraphBuilder trace = graph.AddPass("Indirect Trace", this, [this, &pipeline](RenderGraphContext&)
+            {
+                if (VoxelPass* voxels = pipeline.GetVoxelPass())
+                    voxels->SetConeTraceUniforms(m_Shader.Get());
+
+                m_Shader->SetInt("u_Downscale", GetDownscale());
+                m_Shader->SetUInt("u_FrameIndex", m_FrameIndex);
+
+                if (pipeline.GetFullscreenQuad())
+                    pipeline.GetFullscreenQuad()->Draw();
+            });
+
+        RenderGraphHandle traceDiffuse = trace.CreateTexture("Indirect/TraceDiffuse", { size.x, size.y, TEXTURE_FORMAT::RGBA16F });
+        RenderGraphHandle traceSpecular = trace.CreateTexture("Indirect/TraceSpecular", { size.x, size.y, TEXTURE_FORMAT::RGBA16F });
+
+        trace.Sample(graph.Find("GBuffer/Normal"), "u_GNormal")
+            .Sample(graph.Find("GBuffer/Material"), "u_GMaterial")
+            .Sample(depth, "u_DepthBuffer")
+            .Sample(graph.Find("Voxel/Radiance"), "u_VoxelRadiance")
+            .Sample(graph.Find("Voxel/Normal"), "u_VoxelNormal")
+            .Sample(graph.Find("Voxel/Irradiance"), "u_IrradianceCache")
+            .WriteAttachment(traceDiffuse, ATTACHMENT_TYPE::INDIRECT)
+            .WriteAttachment(traceSpecular, ATTACHMENT_TYPE::SPECULAR);
+
+        graph.AddPass("Indirect Accumulate", nullptr, [this, &pipeline](RenderGraphContext& context)
+            {
+                m_AccumulateShader->Bind();
+                m_PipelineState->Bind();
+                context.BindInputs(m_AccumulateShader.Get());
+
+                m_AccumulateShader->SetMat4("u_PrevViewProjection", m_PrevViewProjection);
+                m_AccumulateShader->SetBool("u_HistoryValid", m_HistoryValid);
+                m_AccumulateShader->SetInt("u_Downscale", GetDownscale());
+                m_AccumulateShader->SetFloat("u_DiffuseHistory", m_DiffuseHistory);
+                m_AccumulateShader->SetFloat("u_SpecularHistory", m_SpecularHistory);
+
+                if (pipeline.GetFullscreenQuad())
+                    pipeline.GetFullscreenQuad()->Draw();
+
+                // The history moves on once this frame has read it. The pass writes imported
+                // textures, so the graph never culls it.
+                const GpuCamera* camera = pipeline.GetCameraBuffer()->GetDataPtr<GpuCamera>();
+                m_PrevViewProjection = camera->m_ProjectionMatrix * camera->m_ViewMatrix;
+                m_HistoryValid = true;
+                m_FrameIndex++;
+            })
+            .Sample(traceDiffuse, "u_TraceDiffuse")
+            .Sample(traceSpecular, "u_TraceSpecular")
+            .Sample(historyDiffuse, "u_HistoryDiffuse")
+            .Sample(historySpecular, "u_HistorySpecular")
+            .Sample(depth, "u_DepthBuffer")
+            .WriteAttachment(diffuse, ATTACHMENT_TYPE::INDIRECT)
+            .WriteAttachment(specular, ATTACHMENT_TYPE::SPECULAR);
+    }
+
+    void IndirectPass::CreateHistory(glm::ivec2 size)
+    {
+        static const char* HISTORY_LABELS[2][2] = {
+            { "Indirect/Diffuse0", "Indirect/Specular0" },
+            { "Indirect/Diffuse1", "Indirect/Specular1" },
+        };
+
+        for (int i = 0; i < 2; i++)
+        {
+            for (int j = 0; j < 2; j++)
+            {
+                Ref<Texture>& texture = m_History[i][j];
+                if (texture)
+                {
+                    texture->Resize(size.x, size.y);
+                    continue;
+                }
+
+                texture = New<Texture>(size.x, size.y, TEXTURE_FORMAT::RGBA16F);
+                texture->SetWrapS(TEXTURE_WRAP::CLAMP_TO_EDGE);
+                texture->SetWrapT(TEXTURE_WRAP::CLAMP_TO_EDGE);
+                GfxResourceTracker::SetCategory(texture.Get(), GFX_RESOURCE_CATEGORY::FRAMEBUFFER);
+                texture->SetDebugLabel(HISTORY_LABELS[i][j]);
+            }
+        }
+
+        m_HistorySize = size;
+        m_HistoryValid = false;
+    }
+}
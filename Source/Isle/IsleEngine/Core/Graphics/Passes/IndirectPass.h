@@ -0,0 +1,48 @@
+// IndirectPass.h
+#pragma once
+#include <Core/Graphics/Passes/Pass.h>
+#include <Core/Graphics/Texture/Texture.h>
+
+namespace Isle
+{
+    // Voxel cone traced indirect diffuse and specular at half or quarter resolution. Each pixel
+    // traces half of the diffuse side cones, alternating in a checkerboard across pixels and
+    // frames, and the results are accumulated over frames with the previous camera. Composite
+    // brings them back to full resolution with a depth and normal aware upsample.
+    class IndirectPass : public Pass
+    {
+    public:
+        // Off makes composite trace every pixel every frame, as before.
+        bool m_Enabled = true;
+
+        // 2 traces at half resolution, 4 at quarter.
+        int m_Downscale = 2;
+
+        float m_DiffuseHistory = 0.9f;
+        float m_SpecularHistory = 0.75f;
+
+    private:
+        Ref<Shader> m_AccumulateShader = nullptr;
+
+        // Accumulated diffuse and specular, ping-ponged between frames.
+        Ref<Texture> m_History[2][2];
+        glm::ivec2 m_HistorySize = glm::ivec2(0);
+        bool m_HistoryValid = false;
+
+        glm::mat4 m_PrevViewProjection = glm::mat4(1.0f);
+        uint32_t m_FrameIndex = 0;
+
+    public:
+        virtual void Bind() override;
+        virtual void Unbind() override;
+        virtual void Start() override;
+        virtual void Update() override;
+        virtual void Destroy() override;
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
+
+        int GetDownscale() const { return m_Downscale >= 4 ? 4 : 2; }
+
+    private:
+        void CreateHistory(glm::ivec2 size);
+    };
+}
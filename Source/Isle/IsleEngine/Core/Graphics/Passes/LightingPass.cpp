@@ -1,23 +1,10 @@
 #include "LightingPass.h"
+#include <Core/Graphics/Pipeline/Pipeline.h>
 
 namespace Isle
 {
     void LightingPass::Start()
     {
-        m_FrameBuffer = New<FrameBuffer>(1920, 1080);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::COLOR, TEXTURE_FORMAT::RGBA16F);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::DEPTH, TEXTURE_FORMAT::DEPTH24_STENCIL8);
-
-        std::vector<ATTACHMENT_TYPE> drawTargets = {
-            ATTACHMENT_TYPE::COLOR
-        };
-        m_FrameBuffer->SetDrawBuffers(drawTargets);
-
-        if (!m_FrameBuffer->CheckStatus())
-        {
-            ISLE_ERROR("LightingPass framebuffer incomplete!\n");
-        }
-
         m_Shader = New<Shader>();
         m_Shader->LoadFromFile(SHADER_TYPE::FRAGMENT, "Resources\\Shaders\\Lighting.frag");
         m_Shader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Lighting.vert");
@@ -38,12 +25,6 @@ namespace Isle
 
     void LightingPass::Bind()
     {
-        if (m_FrameBuffer)
-        {
-            m_FrameBuffer->Bind();
-            m_FrameBuffer->Clear(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-        }
-
         if (m_Shader)
             m_Shader->Bind();
 
@@ -53,8 +34,6 @@ namespace Isle
 
     void LightingPass::Unbind()
     {
-        if (m_FrameBuffer)
-            m_FrameBuffer->Unbind();
     }
 
     void LightingPass::Destroy()
@@ -63,20 +42,25 @@ namespace Isle
             m_FrameBuffer->Destroy();
     }
 
-    Ref<Texture> LightingPass::GetOutputTexture()
+    void LightingPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
     {
-        if (m_FrameBuffer)
-        {
-            return m_FrameBuffer->GetAttachment(ATTACHMENT_TYPE::COLOR);
-        }
-        return nullptr;
-    }
+        const glm::ivec2 size = pipeline.GetRenderSize();
 
-    void LightingPass::BlitToScreen()
-    {
-        if (m_FrameBuffer)
-        {
-            m_FrameBuffer->BlitTo(nullptr, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-        }
+        RenderGraphBuilder builder = graph.AddPass("Lighting", this, [&pipeline](RenderGraphContext&)
+            {
+                if (pipeline.GetFullscreenQuad())
+                    pipeline.GetFullscreenQuad()->Draw();
+            });
+
+        RenderGraphHandle lighting = builder.CreateTexture("Lighting", { size.x, size.y, TEXTURE_FORMAT::RGBA16F });
+
+        builder.Sample(graph.Find("GBuffer/Color"), "u_GColor")
+            .Sample(graph.Find("GBuffer/Normal"), "u_GNormal")
+            .Sample(graph.Find("GBuffer/Material"), "u_GMaterial")
+            .Sample(graph.Find("ShadowMap"), "u_ShadowMap")
+            .Sample(graph.Find("LocalShadowAtlas"), "u_LocalShadowAtlas")
+            .Sample(graph.Find("GBuffer/Depth"), "u_DepthBuffer")
+            .WriteAttachment(lighting, ATTACHMENT_TYPE::COLOR)
+            .SetClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
     }
 }
\ No newline at end of file
@@ -12,9 +12,7 @@ namespace Isle
         virtual void Start() override;
         virtual void Update() override;
         virtual void Destroy() override;
-
-        Ref<Texture> GetOutputTexture();
-        void BlitToScreen();
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
     };
 }
 
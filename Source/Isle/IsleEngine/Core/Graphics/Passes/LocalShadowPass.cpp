@@ -0,0 +1,403 @@
+// LocalShadowPass.cpp
+#include "LocalShadowPass.h"
+#include <Core/Graphics/Pipeline/Pipeline.h>
+#include <Core/Graphics/Mesh/Meshlet.h>
+
+namespace Isle
+{
+    static constexpr int LIGHT_TYPE_POINT = 1;
+    static constexpr int LIGHT_TYPE_SPOT = 2;
+
+    void LocalShadowPass::Start()
+    {
+        CreateAtlas();
+
+        m_DrawBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::INDIRECT_DRAW);
+        m_DrawBuffer->SetDebugLabel("LocalShadowDrawBuffer");
+
+        m_Shader = New<Shader>();
+        m_Shader->LoadFromFile(SHADER_TYPE::FRAGMENT, "Resources\\Shaders\\Shadow.frag");
+        m_Shader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Shadow.vert");
+        m_Shader->Link();
+
+        m_PipelineState = New<PipelineState>();
+		m_PipelineState->SetDepthTest(true);
+		m_PipelineState->SetDepthWrite(true);
+		m_PipelineState->SetCullEnabled(true);
+		m_PipelineState->SetCullFace(CULL_MODE::FRONT);
+    }
+
+    void LocalShadowPass::Update()
+    {
+    }
+
+    void LocalShadowPass::Bind()
+    {
+        m_PipelineState->Bind();
+        m_Shader->Bind();
+    }
+
+    void LocalShadowPass::Unbind()
+    {
+    }
+
+    void LocalShadowPass::Destroy()
+    {
+        if (m_Atlas)
+            m_Atlas->Destroy();
+    }
+
+    void LocalShadowPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
+    {
+        if (m_Atlas->m_Width != m_AtlasSize)
+            CreateAtlas();
+
+        RenderGraphHandle atlas = graph.ImportTexture("LocalShadowAtlas", m_Atlas);
+
+        m_VisibleLights.clear();
+        m_DirtyLights.clear();
+        m_RenderQueue.clear();
+        m_TilesDrawn = 0;
+
+        GpuLight* lights = pipeline.GetLightBuffer()->GetDataPtr<GpuLight>();
+        const GpuCamera* camera = pipeline.GetCameraBuffer()->GetDataPtr<GpuCamera>();
+        if (!lights || !camera)
+            return;
+
+        const uint32_t lightCount = static_cast<uint32_t>(pipeline.GetNumLights());
+        if (m_Lights.size() < lightCount)
+            m_Lights.resize(lightCount);
+
+        MeshletCuller frustum;
+        frustum.SetCamera(camera->m_ProjectionMatrix * camera->m_ViewMatrix, camera->m_CameraPos);
+
+        // Importance is the fraction of the screen height the light's range covers.
+        std::vector<uint32_t>& visible = m_VisibleLights;
+        for (uint32_t id = 0; id < lightCount; id++)
+        {
+            const GpuLight& light = lights[id];
+            const bool local = (light.m_Type == LIGHT_TYPE_POINT || light.m_Type == LIGHT_TYPE_SPOT) && light.m_Radius > 0.0f;
+            if (!local || !frustum.IsInFrustum(light.m_Position, light.m_Radius))
+                continue;
+
+            const float distance = glm::distance(camera->m_CameraPos, light.m_Position);
+            ShadowedLight& shadowed = m_Lights[id];
+            shadowed.m_Importance = glm::min(1.0f, light.m_Radius * camera->m_ProjectionMatrix[1][1] / glm::max(distance, light.m_Radius));
+            visible.push_back(id);
+        }
+
+        // Lights that went out of view or away hand their tiles back.
+        for (uint32_t id = 0; id < m_Lights.size(); id++)
+        {
+            if (m_Lights[id].m_InView && std::find(visible.begin(), visible.end(), id) == visible.end())
+            {
+                FreeLight(m_Lights[id]);
+                m_Lights[id] = ShadowedLight();
+            }
+        }
+
+        for (uint32_t id : visible)
+            m_Lights[id].m_InView = true;
+
+        std::sort(visible.begin(), visible.end(), [this](uint32_t a, uint32_t b)
+            {
+                return m_Lights[a].m_Importance > m_Lights[b].m_Importance;
+            });
+
+        // Pick tile sizes, most important lights first so they get first pick of the space.
+        const int maxLevel = static_cast<int>(glm::log2(static_cast<float>(glm::min(m_MaxTileSize, m_AtlasSize) / m_MinTileSize)));
+        for (uint32_t id : visible)
+        {
+            ShadowedLight& shadowed = m_Lights[id];
+            const int tileCount = lights[id].m_Type == LIGHT_TYPE_POINT ? 6 : 1;
+
+            const float ideal = glm::log2(glm::max(shadowed.m_Importance * m_MaxTileSize / m_MinTileSize, 1.0f));
+            const int level = glm::clamp(static_cast<int>(glm::ceil(ideal)), 0, maxLevel);
+
+            // A quarter level of slack either way, so lights near a size boundary keep their tiles.
+            const bool reallocate = shadowed.m_Level < 0 || shadowed.m_Level > maxLevel ||
+                shadowed.m_TileCount != tileCount || ideal < shadowed.m_Level - 1.25f;
+
+            if (reallocate)
+            {
+                // Shrinking always fits once the old tiles are back.
+                FreeLight(shadowed);
+                for (int l = level; l >= 0; l--)
+                {
+                    if (AllocateLight(shadowed, l, tileCount))
+                        break;
+                }
+            }
+            else if (level > shadowed.m_Level && ideal > shadowed.m_Level + 0.25f)
+            {
+                // Growing keeps the current tiles unless a bigger set is actually free.
+                for (int l = level; l > shadowed.m_Level; l--)
+                {
+                    ShadowedLight grown;
+                    if (AllocateLight(grown, l, tileCount))
+                    {
+                        FreeLight(shadowed);
+                        shadowed.m_Level = grown.m_Level;
+                        shadowed.m_TileCount = grown.m_TileCount;
+                        for (int t = 0; t < tileCount; t++)
+                            shadowed.m_Tiles[t] = grown.m_Tiles[t];
+                        break;
+                    }
+                }
+            }
+        }
+
+        // A light needs redrawing when it moved, or when anything inside its range appeared or moved.
+        const std::vector<glm::vec4>& moved = pipeline.GetMovedBounds();
+        std::vector<uint32_t>& dirty = m_DirtyLights;
+        for (uint32_t id : visible)
+        {
+            ShadowedLight& shadowed = m_Lights[id];
+            if (shadowed.m_Level < 0)
+                continue;
+
+            const GpuLight& light = lights[id];
+            const glm::vec4 sphere(light.m_Position, light.m_Radius);
+            for (int t = 0; t < shadowed.m_TileCount; t++)
+            {
+                const glm::mat4& matrix = light.m_Type == LIGHT_TYPE_POINT ? light.m_ShadowMatrices[t] : light.m_LightSpaceMatrix;
+                if (matrix != shadowed.m_Matrices[t])
+                    shadowed.m_Dirty = true;
+            }
+
+            for (const glm::vec4& bounds : moved)
+            {
+                if (Pipeline::SpheresOverlap(bounds, sphere))
+                    shadowed.m_Dirty = true;
+            }
+
+            if (shadowed.m_Dirty)
+                dirty.push_back(id);
+        }
+
+        // Lights with nothing drawn yet go first, then importance weighted by how long they waited.
+        std::sort(dirty.begin(), dirty.end(), [this](uint32_t a, uint32_t b)
+            {
+                const ShadowedLight& la = m_Lights[a];
+                const ShadowedLight& lb = m_Lights[b];
+                if (la.m_Valid != lb.m_Valid)
+                    return !la.m_Valid;
+                return la.m_Importance * (1 + la.m_WaitFrames) > lb.m_Importance * (1 + lb.m_WaitFrames);
+            });
+
+        for (uint32_t id : dirty)
+        {
+            ShadowedLight& shadowed = m_Lights[id];
+            if (m_TilesDrawn > 0 && m_TilesDrawn + shadowed.m_TileCount > m_TileBudget)
+            {
+                shadowed.m_WaitFrames++;
+                continue;
+            }
+
+            const GpuLight& light = lights[id];
+            for (int t = 0; t < shadowed.m_TileCount; t++)
+                shadowed.m_Matrices[t] = light.m_Type == LIGHT_TYPE_POINT ? light.m_ShadowMatrices[t] : light.m_LightSpaceMatrix;
+            shadowed.m_Sphere = glm::vec4(light.m_Position, light.m_Radius);
+            shadowed.m_Valid = true;
+            shadowed.m_Dirty = false;
+            shadowed.m_WaitFrames = 0;
+
+            m_RenderQueue.push_back(id);
+            m_TilesDrawn += shadowed.m_TileCount;
+        }
+
+        // Point the light table at the tiles, with the matrices the tiles were drawn with.
+        bool changed = false;
+        for (uint32_t id = 0; id < lightCount; id++)
+        {
+            GpuLight updated = lights[id];
+            updated.m_ShadowTileCount = 0;
+
+            if (id < m_Lights.size() && m_Lights[id].m_Valid && m_Lights[id].m_Level >= 0)
+            {
+                const ShadowedLight& shadowed = m_Lights[id];
+                const float tileSize = static_cast<float>(GetTileSize(shadowed.m_Level));
+                updated.m_ShadowTileCount = shadowed.m_TileCount;
+                for (int t = 0; t < shadowed.m_TileCount; t++)
+                {
+                    updated.m_ShadowTiles[t] = glm::vec4(glm::vec2(shadowed.m_Tiles[t]) / static_cast<float>(m_AtlasSize), tileSize / m_AtlasSize, tileSize);
+                    if (updated.m_Type == LIGHT_TYPE_POINT)
+                        updated.m_ShadowMatrices[t] = shadowed.m_Matrices[t];
+                    else
+                        updated.m_LightSpaceMatrix = shadowed.m_Matrices[t];
+                }
+            }
+
+            if (std::memcmp(&updated, &lights[id], sizeof(GpuLight)) != 0)
+            {
+                lights[id] = updated;
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            pipeline.GetLightBuffer()->MarkDirty();
+            pipeline.GetLightBuffer()->Upload();
+        }
+
+        if (m_RenderQueue.empty())
+            return;
+
+        graph.AddPass("Local Shadows", this, [this, &pipeline](RenderGraphContext&)
+            {
+                GfxDevice* device = GfxDevice::Get();
+                device->SetCapability(GL_SCISSOR_TEST, true);
+
+                for (uint32_t id : m_RenderQueue)
+                {
+                    const ShadowedLight& shadowed = m_Lights[id];
+                    const int size = GetTileSize(shadowed.m_Level);
+
+                    // Casters outside the light's range are dropped from the list.
+                    const float tolerance = 2.0f * shadowed.m_Sphere.w / size * pipeline.m_ShadowLodTexels;
+                    pipeline.UpdateLodDrawCommands(m_DrawBuffer.Get(), tolerance, MESH_MOBILITY::ANY, shadowed.m_Sphere);
+
+                    for (int t = 0; t < shadowed.m_TileCount; t++)
+                    {
+                        const glm::ivec2 tile = shadowed.m_Tiles[t];
+                        device->SetViewport(tile.x, tile.y, size, size);
+                        device->SetScissor(tile.x, tile.y, size, size);
+                        device->Clear(GL_DEPTH_BUFFER_BIT, glm::vec4(0.0f), 1.0f);
+
+                        m_Shader->SetMat4("u_LightViewProjection", shadowed.m_Matrices[t]);
+                        pipeline.DrawIndirect(m_DrawBuffer.Get());
+                    }
+                }
+
+                device->SetCapability(GL_SCISSOR_TEST, false);
+            })
+            .WriteAttachment(atlas, ATTACHMENT_TYPE::SHADOW_MAP)
+            .KeepContents();
+    }
+
+    bool LocalShadowPass::AllocateTile(int level, glm::ivec2& outTile)
+    {
+        if (level >= static_cast<int>(m_FreeTiles.size()))
+            return false;
+
+        std::vector<glm::ivec2>& free = m_FreeTiles[level];
+        if (!free.empty())
+        {
+            outTile = free.back();
+            free.pop_back();
+            return true;
+        }
+
+        glm::ivec2 parent;
+        if (!AllocateTile(level + 1, parent))
+            return false;
+
+        const int size = GetTileSize(level);
+        free.push_back(parent + glm::ivec2(size, size));
+        free.push_back(parent + glm::ivec2(0, size));
+        free.push_back(parent + glm::ivec2(size, 0));
+        outTile = parent;
+        return true;
+    }
+
+    void LocalShadowPass::FreeTile(int level, glm::ivec2 tile)
+    {
+        std::vector<glm::ivec2>& free = m_FreeTiles[level];
+        if (level + 1 < static_cast<int>(m_FreeTiles.size()))
+        {
+            const int size = GetTileSize(level);
+            const glm::ivec2 parent = (tile / (size * 2)) * (size * 2);
+
+            // At most the other three quarters of the parent.
+            size_t siblings[3];
+            int siblingCount = 0;
+            for (size_t i = 0; i < free.size() && siblingCount < 3; i++)
+            {
+                const glm::ivec2 offset = free[i] - parent;
+                if (offset.x >= 0 && offset.y >= 0 && offset.x <= size && offset.y <= size && free[i] != tile)
+                    siblings[siblingCount++] = i;
+            }
+
+            if (siblingCount == 3)
+            {
+                for (int s = siblingCount - 1; s >= 0; s--)
+                    free.erase(free.begin() + siblings[s]);
+                FreeTile(level + 1, parent);
+                return;
+            }
+        }
+
+        free.push_back(tile);
+    }
+
+    bool LocalShadowPass::AllocateLight(ShadowedLight& light, int level, int tileCount)
+    {
+        for (int t = 0; t < tileCount; t++)
+        {
+            if (AllocateTile(level, light.m_Tiles[t]))
+                continue;
+
+            for (int i = 0; i < t; i++)
+                FreeTile(level, light.m_Tiles[i]);
+            return false;
+        }
+
+        light.m_Level = level;
+        light.m_TileCount = tileCount;
+        light.m_Valid = false;
+        light.m_Dirty = true;
+        return true;
+    }
+
+    void LocalShadowPass::FreeLight(ShadowedLight& light)
+    {
+        if (light.m_Level >= 0)
+        {
+            for (int t = 0; t < light.m_TileCount; t++)
+                FreeTile(light.m_Level, light.m_Tiles[t]);
+        }
+
+        light.m_Level = -1;
+        light.m_TileCount = 0;
+        light.m_Valid = false;
+        light.m_Dirty = true;
+    }
+
+    void LocalShadowPass::CreateAtlas()
+    {
+        GfxDevice* device = GfxDevice::Get();
+
+        m_Atlas = New<Texture>();
+        m_Atlas->Create(m_AtlasSize, m_AtlasSize, TEXTURE_FORMAT::DEPTH32F, nullptr, false);
+
+        device->TexParameter(GL_TEXTURE_2D, m_Atlas->m_Id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        device->TexParameter(GL_TEXTURE_2D, m_Atlas->m_Id, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        device->TexParameter(GL_TEXTURE_2D, m_Atlas->m_Id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        device->TexParameter(GL_TEXTURE_2D, m_Atlas->m_Id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        device->TexParameter(GL_TEXTURE_2D, m_Atlas->m_Id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        device->TexParameter(GL_TEXTURE_2D, m_Atlas->m_Id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        GfxResourceTracker::SetCategory(m_Atlas.Get(), GFX_RESOURCE_CATEGORY::FRAMEBUFFER);
+        m_Atlas->SetDebugLabel("LocalShadowAtlas");
+
+        // One free tile covering the whole atlas at the top level.
+        int levels = 1;
+        while ((m_MinTileSize << levels) <= m_AtlasSize)
+            levels++;
+
+        m_FreeTiles.assign(levels, {});
+        m_FreeTiles[levels - 1].push_back(glm::ivec2(0));
+        m_Lights.clear();
+    }
+
+    void LocalShadowPass::SetAtlasSize(int size)
+    {
+        m_AtlasSize = size;
+    }
+
+    int LocalShadowPass::GetAtlasSize()
+    {
+        return m_AtlasSize;
+    }
+}
@@ -0,0 +1,73 @@
+// LocalShadowPass.h
+#pragma once
+#include <Core/Graphics/Passes/Pass.h>
+#include <Core/Graphics/GfxBuffer/GfxBuffer.h>
+#include <Core/Graphics/Structs/GpuStructs.h>
+
+namespace Isle
+{
+    // Shadows for point and spot lights, packed into one atlas. A light's tile size follows how
+    // much of the screen its range covers, tiles are only redrawn when the light or a caster
+    // inside its range changed, and at most m_TileBudget tiles are drawn per frame. Where each
+    // light lives in the atlas is written into its entry of the light table.
+    class LocalShadowPass : public Pass
+    {
+    public:
+        int m_TileBudget = 12;
+        int m_MinTileSize = 128;
+        int m_MaxTileSize = 1024;
+
+    private:
+        struct ShadowedLight
+        {
+            int m_TileCount = 0;
+            int m_Level = -1;               // tile size is m_MinTileSize << m_Level
+            glm::ivec2 m_Tiles[6];
+            glm::mat4 m_Matrices[6];        // what the tiles were last drawn with
+            glm::vec4 m_Sphere = glm::vec4(0.0f);
+            float m_Importance = 0.0f;
+            uint32_t m_WaitFrames = 0;
+            bool m_InView = false;
+            bool m_Valid = false;
+            bool m_Dirty = true;
+        };
+
+        int m_AtlasSize = 4096;
+        Ref<Texture> m_Atlas = nullptr;
+        Ref<GfxBuffer> m_DrawBuffer = nullptr;
+
+        // Shadow state indexed by light id, and free atlas tiles by level. Tiles split four ways
+        // on the way down and merge back once all four quarters are free again.
+        std::vector<ShadowedLight> m_Lights;
+        std::vector<std::vector<glm::ivec2>> m_FreeTiles;
+
+        // Rebuilt every frame, kept so their storage is reused.
+        std::vector<uint32_t> m_VisibleLights;
+        std::vector<uint32_t> m_DirtyLights;
+        std::vector<uint32_t> m_RenderQueue;
+        int m_TilesDrawn = 0;
+
+    public:
+        virtual void Bind() override;
+        virtual void Unbind() override;
+        virtual void Start() override;
+        virtual void Update() override;
+        virtual void Destroy() override;
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
+
+        Ref<Texture> GetAtlas() { return m_Atlas; }
+        int GetShadowedLightCount() const { return static_cast<int>(m_VisibleLights.size()); }
+        int GetTilesDrawn() const { return m_TilesDrawn; }
+
+        int GetAtlasSize();
+        void SetAtlasSize(int size);
+
+    private:
+        void CreateAtlas();
+        int GetTileSize(int level) const { return m_MinTileSize << level; }
+        bool AllocateTile(int level, glm::ivec2& outTile);
+        void FreeTile(int level, glm::ivec2 tile);
+        bool AllocateLight(ShadowedLight& light, int level, int tileCount);
+        void FreeLight(ShadowedLight& light);
+    };
+}
@@ -15,6 +15,10 @@ namespace Isle
     {
     }
 
+    void Pass::AddToGraph(RenderGraph&, Pipeline&)
+    {
+    }
+
     void Pass::Bind()
     {
     }
@@ -6,6 +6,9 @@
 
 namespace Isle
 {
+    class Pipeline;
+    class RenderGraph;
+
     class Pass : public Component
     {
     public:
@@ -21,6 +24,9 @@ namespace Isle
         virtual void Update() override;
         virtual void Destroy() override;
 
+        // Declares this frame's graph passes, called by Pipeline::Update in registration order.
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline);
+
         Ref<Shader> GetShader() { return m_Shader; }
         void SetShader(Ref<Shader> shader) { m_Shader = shader; }
 
@@ -1,23 +1,11 @@
 // SelectionPass.cpp
 #include "SelectionPass.h"
+#include <Core/Graphics/Pipeline/Pipeline.h>
 
 namespace Isle
 {
     void SelectionPass::Start()
     {
-        m_FrameBuffer = New<FrameBuffer>(1920, 1080);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::SELECTION, TEXTURE_FORMAT::R8);
-
-        std::vector<ATTACHMENT_TYPE> drawTargets = {
-            ATTACHMENT_TYPE::SELECTION
-        };
-        m_FrameBuffer->SetDrawBuffers(drawTargets);
-
-        if (!m_FrameBuffer->CheckStatus())
-        {
-            ISLE_ERROR("CompositePass framebuffer incomplete!\n");
-        }
-
         m_Shader = New<Shader>();
         m_Shader->LoadFromFile(SHADER_TYPE::FRAGMENT, "Resources\\Shaders\\Selection.frag");
         m_Shader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Selection.vert");
@@ -35,16 +23,12 @@ namespace Isle
 
     void SelectionPass::Bind()
     {
-        m_FrameBuffer->Bind();
-        m_FrameBuffer->Clear();
-
         m_Shader->Bind();
         m_PipelineState->Bind();
     }
 
     void SelectionPass::Unbind()
     {
-        m_FrameBuffer->Unbind();
     }
 
     void SelectionPass::Destroy()
@@ -52,4 +36,18 @@ namespace Isle
         if (m_FrameBuffer)
             m_FrameBuffer->Destroy();
     }
+
+    void SelectionPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
+    {
+        const glm::ivec2 size = pipeline.GetRenderSize();
+
+        // Composite only reads the mask while something is selected, otherwise this pass is culled.
+        RenderGraphBuilder builder = graph.AddPass("Selection", this, [&pipeline](RenderGraphContext&)
+            {
+                pipeline.DrawSelected();
+            });
+
+        RenderGraphHandle selection = builder.CreateTexture("Selection", { size.x, size.y, TEXTURE_FORMAT::R8 });
+        builder.WriteAttachment(selection, ATTACHMENT_TYPE::SELECTION);
+    }
 }
\ No newline at end of file
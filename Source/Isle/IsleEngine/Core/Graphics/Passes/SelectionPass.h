@@ -12,5 +12,6 @@ namespace Isle
         virtual void Start() override;
         virtual void Update() override;
         virtual void Destroy() override;
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
     };
 }
\ No newline at end of file
@@ -1,16 +1,26 @@
 // ShadowPass.cpp
 #include "ShadowPass.h"
+#include <Core/Graphics/Pipeline/Pipeline.h>
 
 namespace Isle
 {
+    static const char* STATIC_CASCADE_NAMES[SHADOW_CASCADE_COUNT] = { "ShadowStatic0", "ShadowStatic1", "ShadowStatic2", "ShadowStatic3" };
+    static const char* STATIC_PASS_NAMES[SHADOW_CASCADE_COUNT] = { "Shadow Static 0", "Shadow Static 1", "Shadow Static 2", "Shadow Static 3" };
+
     void ShadowPass::Start()
     {
-        m_FrameBuffer = New<FrameBuffer>(m_Size, m_Size);
-        m_FrameBuffer->AddAttachment(ATTACHMENT_TYPE::SHADOW_MAP);
+        CreateShadowMap();
+
+        m_CascadeBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::UNIFORM, sizeof(GpuShadowCascades));
+        m_CascadeBuffer->SetDebugLabel("ShadowCascadeBuffer");
 
-        if (!m_FrameBuffer->CheckStatus())
+        m_StaticDrawBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::INDIRECT_DRAW);
+        m_StaticDrawBuffer->SetDebugLabel("ShadowStaticDrawBuffer");
+
+        for (int i = 0; i < SHADOW_CASCADE_COUNT; i++)
         {
-            ISLE_ERROR("ForwardPass framebuffer incomplete!\n");
+            m_DynamicDrawBuffers[i] = New<GfxBuffer>(GFX_BUFFER_TYPE::INDIRECT_DRAW);
+            m_DynamicDrawBuffers[i]->SetDebugLabel("ShadowDynamicDrawBuffer");
         }
 
         m_Shader = New<Shader>();
@@ -31,21 +41,233 @@ namespace Isle
 
     void ShadowPass::Bind()
     {
-        m_FrameBuffer->Bind();
         m_PipelineState->Bind();
-        m_FrameBuffer->Clear();
         m_Shader->Bind();
     }
 
     void ShadowPass::Unbind()
     {
-        m_FrameBuffer->Unbind();
     }
 
     void ShadowPass::Destroy()
     {
-        if (m_FrameBuffer)
-            m_FrameBuffer->Destroy();
+        if (m_ShadowMap)
+            m_ShadowMap->Destroy();
+
+        for (Ref<Texture>& cascade : m_StaticCascades)
+        {
+            if (cascade)
+                cascade->Destroy();
+        }
+    }
+
+    void ShadowPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
+    {
+        if (m_StaticCascades[0]->m_Width != m_Size)
+            CreateShadowMap();
+
+        const GpuLight* lights = pipeline.GetLightBuffer()->GetDataPtr<GpuLight>();
+        const GpuCamera* camera = pipeline.GetCameraBuffer()->GetDataPtr<GpuCamera>();
+
+        // Only the first directional light casts cascaded shadows, local lights use the atlas.
+        m_Cascades = GpuShadowCascades{};
+        m_Cascades.m_LightIndex = -1;
+        for (int i = 0; camera && lights && i < pipeline.GetNumLights(); i++)
+        {
+            if (lights[i].m_Type != 0)
+                continue;
+
+            FitCascades(*camera, lights[i].m_Direction);
+            m_Cascades.m_LightIndex = i;
+            break;
+        }
+
+        *m_CascadeBuffer->GetDataPtr<GpuShadowCascades>() = m_Cascades;
+        m_CascadeBuffer->MarkDirty();
+        m_CascadeBuffer->Upload();
+        m_CascadeBuffer->Bind(6);
+
+        RenderGraphHandle shadowMap = graph.ImportTexture("ShadowMap", m_ShadowMap);
+        if (m_Cascades.m_CascadeCount == 0)
+            return;
+
+        m_Pipeline = &pipeline;
+        const bool staticChanged = m_CachedVersion != pipeline.GetStaticVersion();
+        m_CachedVersion = pipeline.GetStaticVersion();
+
+        RenderGraphHandle staticCascades[SHADOW_CASCADE_COUNT];
+        bool anyStaticDrawn = false;
+        for (int i = 0; i < m_Cascades.m_CascadeCount; i++)
+        {
+            staticCascades[i] = graph.ImportTexture(STATIC_CASCADE_NAMES[i], m_StaticCascades[i]);
+
+            if (!staticChanged && m_CachedViewProjection[i] == m_Cascades.m_ViewProjection[i])
+                continue;
+
+            m_CachedViewProjection[i] = m_Cascades.m_ViewProjection[i];
+            anyStaticDrawn = true;
+
+            graph.AddPass(STATIC_PASS_NAMES[i], this, [this, i](RenderGraphContext&)
+                {
+                    m_Shader->SetMat4("u_LightViewProjection", m_Cascades.m_ViewProjection[i]);
+
+                    const float tolerance = m_Cascades.m_TexelSizes[i] * m_Pipeline->m_ShadowLodTexels;
+                    m_Pipeline->UpdateLodDrawCommands(m_StaticDrawBuffer.Get(), tolerance, MESH_MOBILITY::STATIC);
+                    m_Pipeline->DrawIndirect(m_StaticDrawBuffer.Get());
+                })
+                .WriteAttachment(staticCascades[i], ATTACHMENT_TYPE::SHADOW_MAP);
+        }
+
+        // With nothing moving and the cache unchanged, last frame's atlas is still valid.
+        const bool hasDynamic = pipeline.GetDynamicMeshCount() > 0;
+        if (!anyStaticDrawn && !hasDynamic && !m_DynamicDrawn)
+            return;
+        m_DynamicDrawn = hasDynamic;
+
+        RenderGraphBuilder builder = graph.AddPass("Shadow", this, [this, &pipeline](RenderGraphContext&)
+            {
+                GfxDevice* device = GfxDevice::Get();
+
+                for (int i = 0; i < m_Cascades.m_CascadeCount; i++)
+                {
+                    const glm::ivec2 origin = GetTileOrigin(i);
+                    device->CopyTextureRegion2D(m_StaticCascades[i]->m_Id, m_ShadowMap->m_Id, origin.x, origin.y, m_Size, m_Size);
+                }
+
+                if (!m_DynamicDrawn)
+                    return;
+
+                for (int i = 0; i < m_Cascades.m_CascadeCount; i++)
+                {
+                    const glm::ivec2 origin = GetTileOrigin(i);
+                    device->SetViewport(origin.x, origin.y, m_Size, m_Size);
+                    m_Shader->SetMat4("u_LightViewProjection", m_Cascades.m_ViewProjection[i]);
+
+                    const float tolerance = m_Cascades.m_TexelSizes[i] * pipeline.m_ShadowLodTexels;
+                    pipeline.UpdateLodDrawCommands(m_DynamicDrawBuffers[i].Get(), tolerance, MESH_MOBILITY::DYNAMIC);
+                    pipeline.DrawIndirect(m_DynamicDrawBuffers[i].Get());
+                }
+            });
+
+        for (int i = 0; i < m_Cascades.m_CascadeCount; i++)
+            builder.Read(staticCascades[i], RG_ACCESS::TRANSFER);
+        builder.WriteAttachment(shadowMap, ATTACHMENT_TYPE::SHADOW_MAP);
+    }
+
+    void ShadowPass::FitCascades(const GpuCamera& camera, const glm::vec3& lightDir)
+    {
+        const glm::mat4& projection = camera.m_ProjectionMatrix;
+        const float nearPlane = projection[3][2] / (projection[2][2] - 1.0f);
+        const float farPlane = projection[3][2] / (projection[2][2] + 1.0f);
+        const float shadowFar = glm::min(farPlane, m_MaxDistance);
+        if (nearPlane <= 0.0f || shadowFar <= nearPlane)
+            return;
+
+        // Frustum corner rays, view depth is linear along each of them.
+        glm::vec3 nearCorners[4];
+        glm::vec3 farCorners[4];
+        for (int c = 0; c < 4; c++)
+        {
+            const glm::vec2 ndc(c % 2 ? 1.0f : -1.0f, c / 2 ? 1.0f : -1.0f);
+            const glm::vec4 n = camera.m_InverseViewProjection * glm::vec4(ndc, -1.0f, 1.0f);
+            const glm::vec4 f = camera.m_InverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+            nearCorners[c] = glm::vec3(n) / n.w;
+            farCorners[c] = glm::vec3(f) / f.w;
+        }
+
+        const glm::vec3 dir = glm::normalize(lightDir);
+        const glm::vec3 up = glm::abs(dir.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+        const glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), dir, up);
+
+        const int snapTexels = glm::max(1, m_Size / glm::max(1, m_CacheSnap));
+
+        float sliceStart = nearPlane;
+        for (int i = 0; i < SHADOW_CASCADE_COUNT; i++)
+        {
+            // Practical split scheme, a blend of logarithmic and uniform splits.
+            const float p = static_cast<float>(i + 1) / SHADOW_CASCADE_COUNT;
+            const float logSplit = nearPlane * glm::pow(shadowFar / nearPlane, p);
+            const float uniformSplit = nearPlane + (shadowFar - nearPlane) * p;
+            const float sliceEnd = glm::mix(uniformSplit, logSplit, m_SplitLambda);
+
+            const float t0 = (sliceStart - nearPlane) / (farPlane - nearPlane);
+            const float t1 = (sliceEnd - nearPlane) / (farPlane - nearPlane);
+
+            glm::vec3 corners[8];
+            glm::vec3 center(0.0f);
+            for (int c = 0; c < 4; c++)
+            {
+                corners[c] = glm::mix(nearCorners[c], farCorners[c], t0);
+                corners[c + 4] = glm::mix(nearCorners[c], farCorners[c], t1);
+                center += corners[c] + corners[c + 4];
+            }
+            center /= 8.0f;
+
+            // The bounding sphere only depends on the projection, so the extent stays fixed as
+            // the camera turns and the cached cascade keeps its texel size.
+            float radius = 0.0f;
+            for (const glm::vec3& corner : corners)
+                radius = glm::max(radius, glm::length(corner - center));
+            radius = glm::ceil(radius * 16.0f) / 16.0f;
+
+            // Pad the extent so the centre can snap to a coarse grid and still cover the slice.
+            radius /= 1.0f - 2.0f * snapTexels / m_Size;
+            const float texelSize = 2.0f * radius / m_Size;
+            const float snap = texelSize * snapTexels;
+
+            glm::vec3 lightCenter = glm::vec3(lightView * glm::vec4(center, 1.0f));
+            lightCenter = glm::round(lightCenter / snap) * snap;
+
+            const glm::mat4 lightProjection = glm::ortho(
+                lightCenter.x - radius, lightCenter.x + radius,
+                lightCenter.y - radius, lightCenter.y + radius,
+                -lightCenter.z - radius - m_CasterDistance, -lightCenter.z + radius);
+
+            m_Cascades.m_ViewProjection[i] = lightProjection * lightView;
+            m_Cascades.m_Splits[i] = sliceEnd;
+            m_Cascades.m_TexelSizes[i] = texelSize;
+
+            sliceStart = sliceEnd;
+        }
+
+        m_Cascades.m_CascadeCount = SHADOW_CASCADE_COUNT;
+    }
+
+    void ShadowPass::CreateShadowMap()
+    {
+        GfxDevice* device = GfxDevice::Get();
+
+        // Each cascade gets one quarter of the atlas.
+        m_ShadowMap = New<Texture>();
+        m_ShadowMap->Create(m_Size * 2, m_Size * 2, TEXTURE_FORMAT::DEPTH32F, nullptr, false);
+
+        device->TexParameter(GL_TEXTURE_2D, m_ShadowMap->m_Id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        device->TexParameter(GL_TEXTURE_2D, m_ShadowMap->m_Id, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        device->TexParameter(GL_TEXTURE_2D, m_ShadowMap->m_Id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        device->TexParameter(GL_TEXTURE_2D, m_ShadowMap->m_Id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+        GLfloat borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        device->TexParameter(GL_TEXTURE_2D, m_ShadowMap->m_Id, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+        device->TexParameter(GL_TEXTURE_2D, m_ShadowMap->m_Id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        device->TexParameter(GL_TEXTURE_2D, m_ShadowMap->m_Id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        GfxResourceTracker::SetCategory(m_ShadowMap.Get(), GFX_RESOURCE_CATEGORY::FRAMEBUFFER);
+        m_ShadowMap->SetDebugLabel("ShadowMap");
+
+        // Static casters, only ever copied into the atlas.
+        for (int i = 0; i < SHADOW_CASCADE_COUNT; i++)
+        {
+            m_StaticCascades[i] = New<Texture>();
+            m_StaticCascades[i]->Create(m_Size, m_Size, TEXTURE_FORMAT::DEPTH32F, nullptr, false);
+            device->TexParameter(GL_TEXTURE_2D, m_StaticCascades[i]->m_Id, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            device->TexParameter(GL_TEXTURE_2D, m_StaticCascades[i]->m_Id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+            GfxResourceTracker::SetCategory(m_StaticCascades[i].Get(), GFX_RESOURCE_CATEGORY::FRAMEBUFFER);
+            m_StaticCascades[i]->SetDebugLabel(STATIC_CASCADE_NAMES[i]);
+        }
+
+        m_CachedVersion = UINT32_MAX;
     }
 
     void ShadowPass::SetSize(int size)
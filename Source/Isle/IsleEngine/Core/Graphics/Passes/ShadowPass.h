@@ -1,13 +1,41 @@
 // ShadowPass.h
 #pragma once
 #include <Core/Graphics/Passes/Pass.h>
+#include <Core/Graphics/GfxBuffer/GfxBuffer.h>
+#include <Core/Graphics/Structs/GpuStructs.h>
 
 namespace Isle
 {
+    // Cascaded shadows for the main directional light. Static casters are rendered once per
+    // cascade into a cache that is only redrawn when the cascade moves or a static mesh changes,
+    // the atlas sampled by lighting is the cache copied into place with dynamic casters on top.
     class ShadowPass : public Pass
     {
+    public:
+        float m_MaxDistance = 150.0f;
+        float m_SplitLambda = 0.75f;
+
+        // How far behind a cascade casters are still captured, in world units.
+        float m_CasterDistance = 100.0f;
+
+        // Cascades snap to 1/m_CacheSnap of their width, so the cache survives small camera moves.
+        int m_CacheSnap = 16;
+
     private:
         int m_Size = 2048;
+        Ref<Texture> m_ShadowMap = nullptr;
+        Ref<Texture> m_StaticCascades[SHADOW_CASCADE_COUNT];
+        Ref<GfxBuffer> m_CascadeBuffer = nullptr;
+        Ref<GfxBuffer> m_StaticDrawBuffer = nullptr;
+        Ref<GfxBuffer> m_DynamicDrawBuffers[SHADOW_CASCADE_COUNT];
+
+        GpuShadowCascades m_Cascades{};
+        glm::mat4 m_CachedViewProjection[SHADOW_CASCADE_COUNT];
+        uint32_t m_CachedVersion = UINT32_MAX;
+        bool m_DynamicDrawn = false;
+
+        // Set in AddToGraph, so the per cascade passes only need to capture their index.
+        Pipeline* m_Pipeline = nullptr;
 
     public:
         virtual void Bind() override;
@@ -15,9 +43,17 @@ namespace Isle
         virtual void Start() override;
         virtual void Update() override;
         virtual void Destroy() override;
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
+
+        Ref<Texture> GetShadowMap() { return m_ShadowMap; }
+        const GpuShadowCascades& GetCascades() const { return m_Cascades; }
 
         int GetSize();
         void SetSize(int size);
+
+    private:
+        void CreateShadowMap();
+        void FitCascades(const GpuCamera& camera, const glm::vec3& lightDir);
+        glm::ivec2 GetTileOrigin(int cascade) const { return glm::ivec2(cascade % 2, cascade / 2) * m_Size; }
     };
 }
-
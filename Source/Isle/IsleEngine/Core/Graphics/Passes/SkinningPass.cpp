@@ -0,0 +1,58 @@
+// SkinningPass.cpp
+#include "SkinningPass.h"
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
+#include <Core/Graphics/Pipeline/Pipeline.h>
+
+namespace Isle
+{
+    void SkinningPass::Start()
+    {
+        m_Shader = New<Shader>();
+        m_Shader->LoadFromFile(SHADER_TYPE::COMPUTE, "Resources\\Shaders\\Skinning\\Skinning.comp");
+        m_Shader->Link();
+    }
+
+    void SkinningPass::Update()
+    {
+    }
+
+    void SkinningPass::Bind()
+    {
+        m_Shader->Bind();
+    }
+
+    void SkinningPass::Unbind()
+    {
+    }
+
+    void SkinningPass::Destroy()
+    {
+    }
+
+    void SkinningPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
+    {
+        if (pipeline.GetSkinnedVertexCount() == 0)
+            return;
+
+        RenderGraphHandle vertices = graph.ImportBuffer("Vertices", pipeline.GetVertexBuffer().Get());
+
+        graph.AddPass("Skinning", this, [this, &pipeline](RenderGraphContext&)
+            {
+                Skin(pipeline.GetSkinnedMeshCount(), pipeline.GetSkinnedVertexCount());
+            })
+            .Write(vertices, RG_ACCESS::STORAGE);
+    }
+
+    void SkinningPass::Skin(uint32_t meshCount, uint32_t vertexCount)
+    {
+        if (meshCount == 0 || vertexCount == 0)
+            return;
+
+        m_Shader->SetUInt("u_SkinnedMeshCount", meshCount);
+        m_Shader->SetUInt("u_VertexCount", vertexCount);
+        m_Shader->DispatchCompute((vertexCount + 63) / 64, 1, 1);
+
+        // Draws and the voxelizer pull vertices without declaring the buffer to the graph.
+        GfxDevice::Get()->Barrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+}
@@ -0,0 +1,21 @@
+// SkinningPass.h
+#pragma once
+#include <Core/Graphics/Passes/Pass.h>
+
+namespace Isle
+{
+    // Skins every skinned mesh in one dispatch, from the bind pose into the mesh's range of
+    // the shared vertex buffer. Runs first, every pass after it sees posed vertices.
+    class SkinningPass : public Pass
+    {
+    public:
+        virtual void Bind() override;
+        virtual void Unbind() override;
+        virtual void Start() override;
+        virtual void Update() override;
+        virtual void Destroy() override;
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
+
+        void Skin(uint32_t meshCount, uint32_t vertexCount);
+    };
+}
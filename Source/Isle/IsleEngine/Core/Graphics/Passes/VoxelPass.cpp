@@ -1,4 +1,6 @@
 #include "VoxelPass.h"
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
+#include <Core/Graphics/Pipeline/Pipeline.h>
 
 namespace Isle
 {
@@ -6,34 +8,34 @@ namespace Isle
     {
         m_VoxelRadiance = New<Texture3D>();
         m_VoxelRadiance->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z, TEXTURE3D_FORMAT::RGBA16F, nullptr, true);
+        m_VoxelRadiance->SetDebugLabel("VoxelRadiance");
         m_VoxelRadiance->SetMinFilter(TEXTURE3D_FILTER::LINEAR_MIPMAP_LINEAR);
         m_VoxelRadiance->SetMagFilter(TEXTURE3D_FILTER::LINEAR);
         m_VoxelRadiance->SetWrap(TEXTURE3D_WRAP::CLAMP_TO_BORDER, TEXTURE3D_WRAP::CLAMP_TO_BORDER, TEXTURE3D_WRAP::CLAMP_TO_BORDER);
         m_VoxelRadiance->SetBorderColor(glm::vec4(0.0f));
 
         m_AtomicRadiance = New<Texture3D>();
-        m_AtomicRadiance->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z, TEXTURE3D_FORMAT::RGBA16F, nullptr, true);
+        m_AtomicRadiance->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z, TEXTURE3D_FORMAT::R32UI, nullptr, true);
+        m_AtomicRadiance->SetDebugLabel("AtomicRadiance");
         m_AtomicRadiance->SetMinFilter(TEXTURE3D_FILTER::NEAREST);
-        m_AtomicRadiance->SetMagFilter(TEXTURE3D_FILTER::LINEAR);
+        m_AtomicRadiance->SetMagFilter(TEXTURE3D_FILTER::NEAREST);
 
         m_VoxelNormal = New<Texture3D>();
         m_VoxelNormal->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z, TEXTURE3D_FORMAT::RGBA16F, nullptr, true);
+        m_VoxelNormal->SetDebugLabel("VoxelNormal");
         m_VoxelNormal->SetMinFilter(TEXTURE3D_FILTER::LINEAR_MIPMAP_LINEAR);
         m_VoxelNormal->SetMagFilter(TEXTURE3D_FILTER::LINEAR);
         m_VoxelNormal->SetBorderColor(glm::vec4(0.0f, 0.0f, 1.0f, 0.0f));
 
         m_AtomicNormal = New<Texture3D>();
-        m_AtomicNormal->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z, TEXTURE3D_FORMAT::RGBA16F, nullptr, true);
+        m_AtomicNormal->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z, TEXTURE3D_FORMAT::R32UI, nullptr, true);
+        m_AtomicNormal->SetDebugLabel("AtomicNormal");
         m_AtomicNormal->SetMinFilter(TEXTURE3D_FILTER::NEAREST);
-        m_AtomicNormal->SetMagFilter(TEXTURE3D_FILTER::LINEAR);
-
-        m_AtomicCounter = New<Texture3D>();
-        m_AtomicCounter->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z, TEXTURE3D_FORMAT::R32UI, nullptr, true);
-        m_AtomicCounter->SetMinFilter(TEXTURE3D_FILTER::NEAREST);
-        m_AtomicCounter->SetMagFilter(TEXTURE3D_FILTER::NEAREST);
+        m_AtomicNormal->SetMagFilter(TEXTURE3D_FILTER::NEAREST);
 
         m_IrradianceCache = New<Texture3D>();
         m_IrradianceCache->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z,TEXTURE3D_FORMAT::RGBA16F, nullptr, true);
+        m_IrradianceCache->SetDebugLabel("IrradianceCache");
         m_IrradianceCache->SetMinFilter(TEXTURE3D_FILTER::LINEAR_MIPMAP_LINEAR);
         m_IrradianceCache->SetMagFilter(TEXTURE3D_FILTER::LINEAR);
         m_IrradianceCache->SetWrap(TEXTURE3D_WRAP::CLAMP_TO_BORDER, TEXTURE3D_WRAP::CLAMP_TO_BORDER, TEXTURE3D_WRAP::CLAMP_TO_BORDER);
@@ -42,12 +44,21 @@ namespace Isle
 
         m_IrradiancePrev = New<Texture3D>();
         m_IrradiancePrev->Create(m_Resolution.x, m_Resolution.y, m_Resolution.z, TEXTURE3D_FORMAT::RGBA16F, nullptr, true);
+        m_IrradiancePrev->SetDebugLabel("IrradiancePrev");
         m_IrradiancePrev->SetMinFilter(TEXTURE3D_FILTER::LINEAR_MIPMAP_LINEAR);
         m_IrradiancePrev->SetMagFilter(TEXTURE3D_FILTER::LINEAR);
         m_IrradiancePrev->Clear(glm::vec4(0.0f));
 
-        m_AtomicRadiance->Clear(glm::vec4(0.0f));
-        m_AtomicCounter->Clear(glm::vec4(0.0f));
+        m_DrawBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::INDIRECT_DRAW);
+        m_DrawBuffer->SetDebugLabel("VoxelDrawBuffer");
+
+        // DrawArraysIndirect command followed by one uvec4 per triangle.
+        m_LargeTriangles = New<GfxBuffer>(GFX_BUFFER_TYPE::INDIRECT_DRAW, sizeof(glm::uvec4) * (m_LargeTriangleCapacity + 1), nullptr, GFX_BUFFER_USAGE::DYNAMIC);
+        m_LargeTriangles->SetDebugLabel("VoxelLargeTriangles");
+
+        m_VoxelizeShader = New<Shader>();
+        m_VoxelizeShader->LoadFromFile(SHADER_TYPE::COMPUTE, "Resources\\Shaders\\Voxel\\Voxelize.comp");
+        m_VoxelizeShader->Link();
 
         m_Shader = New<Shader>();
         m_Shader->LoadFromFile(SHADER_TYPE::VERTEX, "Resources\\Shaders\\Voxel\\Voxelize.vert");
@@ -74,23 +85,20 @@ namespace Isle
         m_CellSize = glm::vec3((m_GridMax - m_GridMin)) / glm::vec3(m_Resolution);
         m_MipCount = static_cast<int>(glm::floor(glm::log2(static_cast<float>(m_Resolution.x)))) + 1;
         m_MaxMipLevel = m_MipCount;
-
-        SetupViewport();
     }
 
     void VoxelPass::Update() {}
 
     void VoxelPass::Bind()
     {
-        glEnable(GL_CONSERVATIVE_RASTERIZATION_NV);
+        GfxDevice* device = GfxDevice::Get();
         SetViewport();
 
         m_Shader->Bind();
-        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        device->SetColorMask(false, false, false, false);
 
         m_AtomicRadiance->BindAsImage(0, GL_READ_WRITE, 0);
         m_AtomicNormal->BindAsImage(1, GL_READ_WRITE, 0);
-        m_AtomicCounter->BindAsImage(2, GL_READ_WRITE, 0);
 
         m_Shader->SetIVec3("u_Resolution", m_Resolution);
         m_Shader->SetIVec3("u_GridMin", m_GridMin);
@@ -101,8 +109,8 @@ namespace Isle
 
     void VoxelPass::Unbind()
     {
-        glDisable(GL_CONSERVATIVE_RASTERIZATION_NV);
-        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        GfxDevice* device = GfxDevice::Get();
+        device->SetColorMask(true, true, true, true);
     }
 
     void VoxelPass::Destroy()
@@ -119,11 +127,76 @@ namespace Isle
             m_AtomicRadiance->Destroy();
         }
 
-        if (m_AtomicCounter) {
-            m_AtomicCounter->Destroy();
+        if (m_AtomicNormal) {
+            m_AtomicNormal->Destroy();
         }
     }
 
+    void VoxelPass::AddToGraph(RenderGraph& graph, Pipeline& pipeline)
+    {
+        RenderGraphHandle shadowMap = graph.Find("ShadowMap");
+        RenderGraphHandle atomicRadiance = graph.ImportTexture3D("Voxel/AtomicRadiance", m_AtomicRadiance.Get());
+        RenderGraphHandle atomicNormal = graph.ImportTexture3D("Voxel/AtomicNormal", m_AtomicNormal.Get());
+        RenderGraphHandle largeTriangles = graph.ImportBuffer("Voxel/LargeTriangles", m_LargeTriangles.Get());
+        RenderGraphHandle radiance = graph.ImportTexture3D("Voxel/Radiance", m_VoxelRadiance.Get());
+        RenderGraphHandle normal = graph.ImportTexture3D("Voxel/Normal", m_VoxelNormal.Get());
+
+        // Propagation swaps the pair, the texture it writes is the cache every later pass reads.
+        RenderGraphHandle history = graph.ImportTexture3D("Voxel/IrradianceHistory", m_IrradianceCache.Get());
+        RenderGraphHandle irradiance = graph.ImportTexture3D("Voxel/Irradiance", m_IrradiancePrev.Get());
+
+        graph.AddPass("Voxelize", nullptr, [this, &pipeline](RenderGraphContext&) { VoxelizeTriangles(pipeline); })
+            .Write(atomicRadiance, RG_ACCESS::IMAGE)
+            .Write(atomicNormal, RG_ACCESS::IMAGE)
+            .Write(largeTriangles, RG_ACCESS::STORAGE);
+
+        // Whatever the sweep left behind, drawn with the arguments it wrote.
+        graph.AddPass("Voxelize Large", this, [this, &pipeline](RenderGraphContext&)
+            {
+                m_LargeTriangles->BindAs(GFX_BUFFER_TYPE::STORAGE, 9);
+                pipeline.DrawArraysIndirect(m_LargeTriangles.Get());
+            })
+            .Sample(shadowMap, "u_ShadowMap")
+            .Read(largeTriangles, RG_ACCESS::INDIRECT)
+            .Read(largeTriangles, RG_ACCESS::STORAGE)
+            .Read(atomicRadiance, RG_ACCESS::IMAGE)
+            .Read(atomicNormal, RG_ACCESS::IMAGE)
+            .Write(atomicRadiance, RG_ACCESS::IMAGE)
+            .Write(atomicNormal, RG_ACCESS::IMAGE);
+
+        graph.AddPass("Voxel Build", nullptr, [this](RenderGraphContext&) { BuildVoxels(); })
+            .Read(atomicRadiance, RG_ACCESS::IMAGE)
+            .Read(atomicNormal, RG_ACCESS::IMAGE)
+            .Write(atomicRadiance, RG_ACCESS::IMAGE)
+            .Write(atomicNormal, RG_ACCESS::IMAGE)
+            .Write(radiance, RG_ACCESS::IMAGE)
+            .Write(normal, RG_ACCESS::IMAGE);
+
+        graph.AddPass("Voxel Inject", nullptr, [this](RenderGraphContext&) { InjectDirectLighting(); })
+            .Read(radiance, RG_ACCESS::IMAGE)
+            .Read(normal, RG_ACCESS::IMAGE)
+            .Read(irradiance, RG_ACCESS::IMAGE)
+            .Write(history, RG_ACCESS::IMAGE);
+
+        graph.AddPass("Voxel Propagate", nullptr, [this](RenderGraphContext&) { PropagateIrradiance(); })
+            .Read(history, RG_ACCESS::IMAGE)
+            .Read(normal, RG_ACCESS::IMAGE)
+            .Read(radiance, RG_ACCESS::IMAGE)
+            .Write(irradiance, RG_ACCESS::IMAGE);
+
+        graph.AddPass("Voxel Mips", nullptr, [this](RenderGraphContext&)
+            {
+                GenerateMipmaps();
+                m_CurrentFrame++;
+            })
+            .Read(radiance, RG_ACCESS::IMAGE)
+            .Read(normal, RG_ACCESS::IMAGE)
+            .Read(irradiance, RG_ACCESS::IMAGE)
+            .Write(radiance, RG_ACCESS::IMAGE)
+            .Write(normal, RG_ACCESS::IMAGE)
+            .Write(irradiance, RG_ACCESS::IMAGE);
+    }
+
     void VoxelPass::GenerateMipmaps()
     {
         if (m_MipmapShader)
@@ -147,13 +220,51 @@ namespace Isle
                 m_MipmapShader->SetIVec3("u_RegionMax", mipRes - glm::ivec3(1));
 
                 glm::ivec3 groupCount = (mipRes + glm::ivec3(3)) / glm::ivec3(4);
-                glDispatchCompute(groupCount.x, groupCount.y, groupCount.z);
+                GfxDevice::Get()->DispatchCompute(groupCount.x, groupCount.y, groupCount.z);
 
-                glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+                // The next level reads this one, readers after the pass get their barrier from the graph.
+                if (mip + 1 < m_MaxMipLevel)
+                    GfxDevice::Get()->Barrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
             }
+        }
+    }
 
-            glMemoryBarrier(GL_ALL_BARRIER_BITS);
+    void VoxelPass::VoxelizeTriangles(Pipeline& pipeline)
+    {
+        pipeline.UpdateLodDrawCommands(m_DrawBuffer.Get(), glm::min(m_CellSize.x, glm::min(m_CellSize.y, m_CellSize.z)) * pipeline.m_VoxelLodCells);
+
+        // The raster path draws an empty list unless the sweep appends to it.
+        m_LargeTriangles->Clear();
+
+        const GpuDrawCommand* commands = m_DrawBuffer->GetDataPtr<GpuDrawCommand>();
+        const size_t commandCount = m_DrawBuffer->GetDataCount<GpuDrawCommand>();
+
+        uint32_t maxTriangles = 0;
+        for (size_t i = 0; i < commandCount; i++)
+        {
+            if (commands[i].m_InstanceCount > 0)
+                maxTriangles = glm::max(maxTriangles, static_cast<uint32_t>(commands[i].m_Count) / 3);
         }
+
+        if (!m_VoxelizeShader || commandCount == 0 || maxTriangles == 0)
+            return;
+
+        m_VoxelizeShader->Bind();
+        m_AtomicRadiance->BindAsImage(0, GL_READ_WRITE, 0);
+        m_AtomicNormal->BindAsImage(1, GL_READ_WRITE, 0);
+        m_DrawBuffer->BindAs(GFX_BUFFER_TYPE::STORAGE, 8);
+        m_LargeTriangles->BindAs(GFX_BUFFER_TYPE::STORAGE, 9);
+
+        m_VoxelizeShader->SetIVec3("u_Resolution", m_Resolution);
+        m_VoxelizeShader->SetIVec3("u_GridMin", m_GridMin);
+        m_VoxelizeShader->SetIVec3("u_GridMax", m_GridMax);
+        m_VoxelizeShader->SetVec3("u_CellSize", m_CellSize);
+        m_VoxelizeShader->SetInt("u_SweepCellLimit", m_SweepCellLimit);
+
+        // One row of groups per draw, wide enough for the biggest mesh up to a cap after which
+        // the threads loop instead.
+        const uint32_t groupsX = glm::min((maxTriangles + 63) / 64, 256u);
+        GfxDevice::Get()->DispatchCompute(groupsX, static_cast<GLuint>(commandCount), 1);
     }
 
     void VoxelPass::BuildVoxels()
@@ -165,7 +276,6 @@ namespace Isle
             m_AtomicNormal->BindAsImage(1, GL_READ_WRITE, 0);
             m_VoxelRadiance->BindAsImage(2, GL_WRITE_ONLY, 0);
             m_VoxelNormal->BindAsImage(3, GL_WRITE_ONLY, 0);
-            m_AtomicCounter->BindAsImage(4, GL_READ_WRITE, 0);
 
             m_BuildShader->SetIVec3("u_Resolution", m_Resolution);
             m_BuildShader->SetIVec3("u_GridMin", m_GridMin);
@@ -173,9 +283,7 @@ namespace Isle
             m_BuildShader->SetVec3("u_CellSize", m_CellSize);
 
             glm::ivec3 groupCount = (m_Resolution + glm::ivec3(7)) / glm::ivec3(8);
-            glDispatchCompute(groupCount.x, groupCount.y, groupCount.z);
-
-            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+            GfxDevice::Get()->DispatchCompute(groupCount.x, groupCount.y, groupCount.z);
         }
     }
 
@@ -192,9 +300,7 @@ namespace Isle
         m_InjectShader->SetInt("u_Frame", m_CurrentFrame);
 
         glm::ivec3 groupCount = (m_Resolution + glm::ivec3(7)) / glm::ivec3(8);
-        glDispatchCompute(groupCount.x, groupCount.y, groupCount.z);
-
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        GfxDevice::Get()->DispatchCompute(groupCount.x, groupCount.y, groupCount.z);
     }
 
     void VoxelPass::PropagateIrradiance()
@@ -212,35 +318,26 @@ namespace Isle
         m_PropagateShader->SetVec3("u_CellSize", m_CellSize);
 
         glm::ivec3 groupCount = (m_Resolution + glm::ivec3(7)) / glm::ivec3(8);
-        glDispatchCompute(groupCount.x, groupCount.y, groupCount.z);
-
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        GfxDevice::Get()->DispatchCompute(groupCount.x, groupCount.y, groupCount.z);
 
         std::swap(m_IrradianceCache, m_IrradiancePrev);
     }
 
-    void VoxelPass::SetupViewport()
+    void VoxelPass::SetConeTraceUniforms(Shader* shader)
     {
-        glViewportSwizzleNV(0, GL_VIEWPORT_SWIZZLE_POSITIVE_X_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_Y_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_Z_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_W_NV);
-
-        glViewportSwizzleNV(1, GL_VIEWPORT_SWIZZLE_POSITIVE_X_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_Z_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_Y_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_W_NV);
-
-        glViewportSwizzleNV(2, GL_VIEWPORT_SWIZZLE_POSITIVE_Z_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_Y_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_X_NV,
-            GL_VIEWPORT_SWIZZLE_POSITIVE_W_NV);
+        shader->SetIVec3("u_Resolution", m_Resolution);
+        shader->SetIVec3("u_GridMin", m_GridMin);
+        shader->SetIVec3("u_GridMax", m_GridMax);
+        shader->SetInt("u_MipCount", m_MipCount);
+        shader->SetVec3("u_CellSize", m_CellSize);
     }
 
     void VoxelPass::SetViewport()
     {
-        glViewportIndexedf(0, 0, 0, m_Resolution.x, m_Resolution.y);
-        glViewportIndexedf(1, 0, 0, m_Resolution.y, m_Resolution.z);
-        glViewportIndexedf(2, 0, 0, m_Resolution.z, m_Resolution.x);
+        GfxDevice* device = GfxDevice::Get();
+        // One viewport per projection Voxelize.geom picks, sized to the two axes it keeps.
+        device->SetViewportIndexed(0, 0, 0, m_Resolution.x, m_Resolution.y);
+        device->SetViewportIndexed(1, 0, 0, m_Resolution.x, m_Resolution.z);
+        device->SetViewportIndexed(2, 0, 0, m_Resolution.z, m_Resolution.y);
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <Core/Graphics/Passes/Pass.h>
 #include <Core/Graphics/Shader/Shader.h>
 #include <Core/Graphics/Texture3D/Texture3D.h>
+#include <Core/Graphics/GfxBuffer/GfxBuffer.h>
 
 namespace Isle
 {
@@ -15,7 +16,12 @@ namespace Isle
         Ref<Texture3D> m_VoxelNormal = nullptr;
         Ref<Texture3D> m_AtomicNormal = nullptr;
 
-        Ref<Texture3D> m_AtomicCounter = nullptr;
+        // Voxelize.comp sweeps small triangles straight from the shared vertex and index
+        // buffers, m_Shader rasterizes the ones it hands over in m_LargeTriangles.
+        Ref<Shader> m_VoxelizeShader = nullptr;
+        Ref<GfxBuffer> m_LargeTriangles = nullptr;
+        int m_SweepCellLimit = 16;
+        uint32_t m_LargeTriangleCapacity = 1 << 16;
 
         Ref<Shader> m_MipmapShader = nullptr;
         Ref<Shader> m_BuildShader = nullptr;
@@ -26,6 +32,8 @@ namespace Isle
         Ref<Shader> m_InjectShader = nullptr;
         Ref<Shader> m_PropagateShader = nullptr;
 
+        Ref<GfxBuffer> m_DrawBuffer = nullptr;
+
         int m_CurrentFrame = 0;
 
         glm::ivec3 m_Resolution = glm::ivec3(256);
@@ -41,13 +49,17 @@ namespace Isle
         virtual void Start() override;
         virtual void Update() override;
         virtual void Destroy() override;
+        virtual void AddToGraph(RenderGraph& graph, Pipeline& pipeline) override;
 
         void GenerateMipmaps();
+        void VoxelizeTriangles(Pipeline& pipeline);
         void BuildVoxels();
-        void SetupViewport();
         void SetViewport();
 
         void InjectDirectLighting();
         void PropagateIrradiance();
+
+        // Grid description the cone tracing shaders need, see Common/ConeTracing.glsl.
+        void SetConeTraceUniforms(Shader* shader);
     };
 }
\ No newline at end of file
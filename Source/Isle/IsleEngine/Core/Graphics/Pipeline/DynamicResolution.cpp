@@ -0,0 +1,47 @@
+// DynamicResolution.cpp
+#include "DynamicResolution.h"
+
+namespace Isle
+{
+    void DynamicResolution::Update(double gpuMs)
+    {
+        m_Scale = glm::clamp(m_Scale, m_MinScale, m_MaxScale);
+        m_FramesSinceChange++;
+
+        // No resolved timer queries yet, or the profiler is off.
+        if (!m_Enabled || gpuMs <= 0.0)
+            return;
+
+        m_SmoothedGpuMs = m_SmoothedGpuMs > 0.0 ? glm::mix(m_SmoothedGpuMs, gpuMs, 0.1) : gpuMs;
+
+        if (m_FramesSinceChange < m_Cooldown)
+            return;
+
+        const double ratio = m_TargetGpuMs / m_SmoothedGpuMs;
+        if (ratio > 1.0 - m_Headroom && ratio < 1.0 + m_Headroom)
+            return;
+
+        float scale = m_Scale * static_cast<float>(glm::sqrt(ratio));
+        scale = glm::round(scale / m_Step) * m_Step;
+        scale = glm::clamp(scale, m_MinScale, m_MaxScale);
+
+        if (glm::abs(scale - m_Scale) < m_Step * 0.5f)
+            return;
+
+        m_Scale = scale;
+        m_FramesSinceChange = 0;
+    }
+
+    void DynamicResolution::Reset()
+    {
+        m_Scale = m_MaxScale;
+        m_SmoothedGpuMs = 0.0;
+        m_FramesSinceChange = 0;
+    }
+
+    glm::ivec2 DynamicResolution::GetRenderSize(glm::ivec2 outputSize) const
+    {
+        const glm::vec2 size = glm::vec2(outputSize) * GetScale();
+        return glm::max(glm::ivec2(glm::round(size)), glm::ivec2(1));
+    }
+}
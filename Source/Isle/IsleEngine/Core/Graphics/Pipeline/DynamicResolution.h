@@ -0,0 +1,37 @@
+// DynamicResolution.h
+#pragma once
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    // Picks the render scale from the measured GPU frame time. Pixel cost goes with the
+    // square of the scale, so the correction is the square root of target over measured.
+    // Timer results arrive a few frames late and every change reallocates the transient
+    // targets, so the scale moves in fixed steps and waits a while after each change.
+    class ISLEENGINE_API DynamicResolution
+    {
+    public:
+        bool m_Enabled = true;
+        float m_TargetGpuMs = 16.6f;
+        float m_MinScale = 0.5f;
+        float m_MaxScale = 1.0f;
+        float m_Step = 0.05f;
+
+        // Measured time has to leave this band around the target before the scale moves.
+        float m_Headroom = 0.1f;
+        uint32_t m_Cooldown = 30;
+
+    private:
+        float m_Scale = 1.0f;
+        double m_SmoothedGpuMs = 0.0;
+        uint32_t m_FramesSinceChange = 0;
+
+    public:
+        void Update(double gpuMs);
+        void Reset();
+
+        glm::ivec2 GetRenderSize(glm::ivec2 outputSize) const;
+        float GetScale() const { return m_Enabled ? m_Scale : m_MaxScale; }
+        double GetSmoothedGpuMs() const { return m_SmoothedGpuMs; }
+    };
+}
@@ -4,9 +4,58 @@
 #include <Core/Graphics/Structs/GpuStructs.h>
 #include <Core/Graphics/Material/Material.h>
 #include <Core/Graphics/Mesh/StaticMesh.h>
+#include <Core/Graphics/Mesh/SkinnedMesh.h>
 
 namespace Isle
 {
+    namespace
+    {
+        const char* const MATERIAL_TEXTURES[] = { "BaseColor", "Emissive", "MetallicRoughness", "Occlusion", "Normal" };
+
+        // Grows the CPU copy past what the allocator hands out, so a burst of loads does not
+        // reallocate the GL storage on every upload.
+        template<typename T>
+        T* Reserve(GfxBuffer& buffer, size_t count)
+        {
+            const size_t current = buffer.GetDataCount<T>();
+            if (current < count)
+                buffer.Resize(std::max(count, current + current / 2) * sizeof(T));
+            return buffer.GetDataPtr<T>();
+        }
+
+        template<typename T>
+        void Write(GfxBuffer& buffer, size_t offset, const T* data, size_t count)
+        {
+            if (count == 0)
+                return;
+
+            std::memcpy(Reserve<T>(buffer, offset + count) + offset, data, count * sizeof(T));
+            buffer.MarkDirty(offset * sizeof(T), count * sizeof(T));
+        }
+
+        template<typename T>
+        void Zero(GfxBuffer& buffer, size_t offset, size_t count)
+        {
+            if (count == 0 || offset + count > buffer.GetDataCount<T>())
+                return;
+
+            std::memset(buffer.GetDataPtr<T>() + offset, 0, count * sizeof(T));
+            buffer.MarkDirty(offset * sizeof(T), count * sizeof(T));
+        }
+
+        // The range slid down into a hole, whatever it left behind is the new hole.
+        template<typename T>
+        void Slide(GfxBuffer& buffer, const BufferAllocator::Move& move)
+        {
+            T* data = buffer.GetDataPtr<T>();
+            std::memmove(data + move.m_To, data + move.m_From, move.m_Count * sizeof(T));
+
+            const uint32_t vacated = std::max(move.m_To + move.m_Count, move.m_From);
+            std::memset(data + vacated, 0, (move.m_From + move.m_Count - vacated) * sizeof(T));
+            buffer.MarkDirty(move.m_To * sizeof(T), (move.m_From + move.m_Count - move.m_To) * sizeof(T));
+        }
+    }
+
     void Pipeline::Start()
     {
         m_VertexBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
@@ -17,9 +66,35 @@ namespace Isle
         m_StaticMeshBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
         m_DrawCommandBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::INDIRECT_DRAW);
         m_TextureBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+        m_MeshletBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+        m_VisibleDrawBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::INDIRECT_DRAW);
+        m_VisibleCountBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE, sizeof(uint32_t));
+        m_MeshLodBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+        m_SkinSourceBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+        m_SkinWeightBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+        m_BoneMatrixBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+        m_SkinnedMeshBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
         m_DummyVAO = New<GfxBuffer>(GFX_BUFFER_TYPE::VERTEX, 0);
         m_DummyVAO->SetIndexBuffer(m_IndexBuffer.Get());
 
+        m_VertexBuffer->SetDebugLabel("VertexBuffer");
+        m_IndexBuffer->SetDebugLabel("IndexBuffer");
+        m_MaterialBuffer->SetDebugLabel("MaterialBuffer");
+        m_CameraBuffer->SetDebugLabel("CameraBuffer");
+        m_LightBuffer->SetDebugLabel("LightBuffer");
+        m_StaticMeshBuffer->SetDebugLabel("StaticMeshBuffer");
+        m_DrawCommandBuffer->SetDebugLabel("DrawCommandBuffer");
+        m_TextureBuffer->SetDebugLabel("TextureBuffer");
+        m_MeshletBuffer->SetDebugLabel("MeshletBuffer");
+        m_VisibleDrawBuffer->SetDebugLabel("VisibleDrawBuffer");
+        m_VisibleCountBuffer->SetDebugLabel("VisibleCountBuffer");
+        m_MeshLodBuffer->SetDebugLabel("MeshLodBuffer");
+        m_SkinSourceBuffer->SetDebugLabel("SkinSourceBuffer");
+        m_SkinWeightBuffer->SetDebugLabel("SkinWeightBuffer");
+        m_BoneMatrixBuffer->SetDebugLabel("BoneMatrixBuffer");
+        m_SkinnedMeshBuffer->SetDebugLabel("SkinnedMeshBuffer");
+        m_DummyVAO->SetDebugLabel("DummyVAO");
+
         m_GeometryPass = new GeometryPass();
         m_GeometryPass->Start();
 
@@ -29,28 +104,96 @@ namespace Isle
         m_ShadowPass = new ShadowPass();
         m_ShadowPass->Start();
 
+        m_LocalShadowPass = new LocalShadowPass();
+        m_LocalShadowPass->Start();
+
         m_VoxelPass = new VoxelPass();
         m_VoxelPass->Start();
 
+        m_IndirectPass = new IndirectPass();
+        m_IndirectPass->Start();
+
         m_CompositePass = new CompositePass();
         m_CompositePass->Start();
 
         m_SelectionPass = new SelectionPass();
         m_SelectionPass->Start();
 
+        m_CullPass = new CullPass();
+        m_CullPass->Start();
+
+        m_SkinningPass = new SkinningPass();
+        m_SkinningPass->Start();
+
         m_FullscreenQuad = new FullscreenQuad();
+
+        m_TextureStreamer = new TextureStreamer();
+        m_TextureStreamer->Start();
+
+        m_Moves.reserve(64);
+
+        m_Passes = {
+            m_SkinningPass,
+            m_CullPass,
+            m_ShadowPass,
+            m_LocalShadowPass,
+            m_VoxelPass,
+            m_GeometryPass,
+            m_SelectionPass,
+            m_LightingPass,
+            m_IndirectPass,
+            m_CompositePass,
+        };
     }
 
     void Pipeline::Update()
     {
-        m_VertexBuffer->Upload();
-        m_IndexBuffer->Upload();
-        m_MaterialBuffer->Upload();
-        m_CameraBuffer->Upload();
-        m_LightBuffer->Upload();
-        m_StaticMeshBuffer->Upload();
-        m_DrawCommandBuffer->Upload();
-        m_TextureBuffer->Upload();
+        ISLE_PROFILE_GPU_SCOPE("Pipeline");
+
+        // Meshes that have been still long enough rejoin the static set.
+        m_DynamicMeshCount = 0;
+        for (uint32_t& idle : m_MeshIdleFrames)
+        {
+            if (idle >= STATIC_AFTER_FRAMES)
+                continue;
+
+            if (++idle == STATIC_AFTER_FRAMES)
+                m_StaticVersion++;
+            else
+                m_DynamicMeshCount++;
+        }
+
+        if (m_TextureStreamer)
+        {
+            ISLE_PROFILE_SCOPE("Texture Streaming");
+
+            std::vector<Texture*> streamed;
+            m_TextureStreamer->Update(streamed);
+            for (Texture* texture : streamed)
+                UpdateTextureHandle(texture);
+        }
+
+        Defragment();
+        UpdateSkinning();
+
+        {
+            ISLE_PROFILE_GPU_SCOPE("Upload");
+
+            m_VertexBuffer->Upload();
+            m_IndexBuffer->Upload();
+            m_MaterialBuffer->Upload();
+            m_CameraBuffer->Upload();
+            m_LightBuffer->Upload();
+            m_StaticMeshBuffer->Upload();
+            m_DrawCommandBuffer->Upload();
+            m_TextureBuffer->Upload();
+            m_MeshletBuffer->Upload();
+            m_MeshLodBuffer->Upload();
+            m_SkinSourceBuffer->Upload();
+            m_SkinWeightBuffer->Upload();
+            m_BoneMatrixBuffer->Upload();
+            m_SkinnedMeshBuffer->Upload();
+        }
 
         m_VertexBuffer->Bind(0);
         m_IndexBuffer->Bind(1);
@@ -59,170 +202,255 @@ namespace Isle
         m_LightBuffer->Bind(4);
         m_CameraBuffer->Bind(5);
         m_TextureBuffer->Bind(6);
+        m_MeshletBuffer->Bind(7);
+        m_MeshLodBuffer->Bind(10);
+        m_SkinSourceBuffer->Bind(13);
+        m_SkinWeightBuffer->Bind(14);
+        m_BoneMatrixBuffer->Bind(15);
+        m_SkinnedMeshBuffer->Bind(16);
 
-        if (m_ShadowPass)
-        {
-            m_ShadowPass->Bind();
-            Draw();
-            m_ShadowPass->Unbind();
-        }
+        m_DynamicResolution.Update(Profiler::GetLatestGpuMs());
+        m_RenderSize = m_DynamicResolution.GetRenderSize(m_OutputSize);
 
-        if (m_VoxelPass)
-        {
-            m_VoxelPass->Bind();
-
-            m_ShadowPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::SHADOW_MAP)->Bind(7);
-            m_VoxelPass->GetShader()->SetInt("u_ShadowMap", 7);
+        m_RenderGraph.Reset();
+        for (Pass* pass : m_Passes)
+            pass->AddToGraph(m_RenderGraph, *this);
 
-            Draw();
-            m_VoxelPass->Unbind();
+        m_RenderGraph.Compile();
+        m_RenderGraph.Execute();
 
-            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-            m_VoxelPass->BuildVoxels();
-            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+        m_MovedBounds.clear();
+    }
 
-            m_VoxelPass->InjectDirectLighting();
-            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    void Pipeline::Destroy()
+    {
+        m_RenderGraph.Destroy();
 
-            m_VoxelPass->PropagateIrradiance();
-            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
+        for (Pass* pass : m_Passes)
+        {
+            pass->Destroy();
+            delete pass;
+        }
+        m_Passes.clear();
 
-            m_VoxelPass->GenerateMipmaps();
-            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+        delete m_FullscreenQuad;
 
-            m_VoxelPass->m_CurrentFrame++;
-        }
+        if (m_TextureStreamer)
+            m_TextureStreamer->Destroy();
+        delete m_TextureStreamer;
 
-        if (m_GeometryPass)
+        // Meshes outlive the pipeline, their ids mean nothing to the next one.
+        for (MeshRecord& record : m_MeshRecords)
         {
-            m_GeometryPass->Bind();
-            Draw();
-            m_GeometryPass->Unbind();
+            if (record.m_Mesh)
+                record.m_Mesh->m_Id = -1;
         }
+        m_MeshRecords.clear();
+    }
 
-        if (m_SelectionPass)
+    void Pipeline::Clear()
+    {
+        if (m_VertexBuffer) m_VertexBuffer->Clear();
+        if (m_IndexBuffer) m_IndexBuffer->Clear();
+        if (m_MaterialBuffer) m_MaterialBuffer->Clear();
+        if (m_LightBuffer) m_LightBuffer->Clear();
+        if (m_StaticMeshBuffer) m_StaticMeshBuffer->Clear();
+        if (m_DrawCommandBuffer) m_DrawCommandBuffer->Clear();
+        if (m_TextureBuffer) m_TextureBuffer->Clear();
+        if (m_MeshletBuffer) m_MeshletBuffer->Clear();
+        if (m_MeshLodBuffer) m_MeshLodBuffer->Clear();
+        if (m_SkinSourceBuffer) m_SkinSourceBuffer->Clear();
+        if (m_SkinWeightBuffer) m_SkinWeightBuffer->Clear();
+        if (m_BoneMatrixBuffer) m_BoneMatrixBuffer->Clear();
+        if (m_SkinnedMeshBuffer) m_SkinnedMeshBuffer->Clear();
+        if (m_TextureStreamer) m_TextureStreamer->Clear();
+
+        // Allocator owned buffers start over empty, the GL storage is kept for reuse.
+        if (m_VertexBuffer) m_VertexBuffer->Resize(0);
+        if (m_IndexBuffer) m_IndexBuffer->Resize(0);
+        if (m_MaterialBuffer) m_MaterialBuffer->Resize(0);
+        if (m_StaticMeshBuffer) m_StaticMeshBuffer->Resize(0);
+        if (m_DrawCommandBuffer) m_DrawCommandBuffer->Resize(0);
+        if (m_TextureBuffer) m_TextureBuffer->Resize(0);
+        if (m_MeshletBuffer) m_MeshletBuffer->Resize(0);
+        if (m_MeshLodBuffer) m_MeshLodBuffer->Resize(0);
+        if (m_SkinSourceBuffer) m_SkinSourceBuffer->Resize(0);
+        if (m_SkinWeightBuffer) m_SkinWeightBuffer->Resize(0);
+        if (m_BoneMatrixBuffer) m_BoneMatrixBuffer->Resize(0);
+        if (m_SkinnedMeshBuffer) m_SkinnedMeshBuffer->Resize(0);
+
+        for (MeshRecord& record : m_MeshRecords)
         {
-            m_SelectionPass->Bind();
-            DrawSelected();
-            m_SelectionPass->Unbind();
+            if (record.m_Mesh)
+                record.m_Mesh->m_Id = -1;
         }
+        m_MeshRecords.clear();
+        m_TextureRecords.clear();
+        m_MaterialRecords.clear();
+
+        m_VertexRanges.Clear();
+        m_IndexRanges.Clear();
+        m_MeshletRanges.Clear();
+        m_LodRanges.Clear();
+        m_SkinRanges.Clear();
+        m_MeshSlots.Clear();
+        m_MaterialSlots.Clear();
+        m_TextureSlots.Clear();
+        m_SelectedMesh = -1;
+
+        m_SkinnedMeshes.clear();
+        m_SkinnedMeshCount = 0;
+        m_SkinnedVertexCount = 0;
+
+        m_MeshIdleFrames.clear();
+        m_DynamicMeshCount = 0;
+        m_StaticVersion++;
+
+        // Everything cached against the old scene is stale.
+        m_MovedBounds.clear();
+        m_MovedBounds.push_back(glm::vec4(0.0f, 0.0f, 0.0f, FLT_MAX));
+    }
 
-        if (m_LightingPass)
-        {
-            m_LightingPass->Bind();
-
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::COLOR)->Bind(7);
-            m_LightingPass->GetShader()->SetInt("u_GColor", 7);
-
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::NORMAL)->Bind(8);
-            m_LightingPass->GetShader()->SetInt("u_GNormal", 8);
-
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::POSITION)->Bind(9);
-            m_LightingPass->GetShader()->SetInt("u_GPosition", 9);
-
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::MATERIAL)->Bind(10);
-            m_LightingPass->GetShader()->SetInt("u_GMaterial", 10);
-
-            m_ShadowPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::SHADOW_MAP)->Bind(11);
-            m_LightingPass->GetShader()->SetInt("u_ShadowMap", 11);
-
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::DEPTH)->Bind(12);
-            m_LightingPass->GetShader()->SetInt("u_DepthBuffer", 12);
-
-            if (m_FullscreenQuad)
-                m_FullscreenQuad->Draw();
 
-            m_LightingPass->Unbind();
+    void Pipeline::Draw(bool culled)
+    {
+        if (culled && GetNumMeshlets() > 0)
+        {
+            m_DummyVAO->Bind();
+            m_VisibleDrawBuffer->Bind();
+            m_VisibleCountBuffer->BindAs(GFX_BUFFER_TYPE::INDIRECT_PARAMETER);
+
+            GfxDevice* device = GfxDevice::Get();
+            device->MultiDrawElementsIndirectCount(
+                GL_TRIANGLES,
+                GL_UNSIGNED_INT,
+                0,
+                0,
+                GetNumMeshlets(),
+                sizeof(GpuDrawCommand)
+            );
+
+            device->BindBuffer(GL_PARAMETER_BUFFER, 0);
+            m_VisibleDrawBuffer->Unbind();
+            m_DummyVAO->Unbind();
+            return;
         }
 
-        if (m_CompositePass)
-        {
-            m_CompositePass->Bind();
+        DrawIndirect(m_DrawCommandBuffer.Get());
+    }
 
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::COLOR)->Bind(7);
-            m_CompositePass->GetShader()->SetInt("u_GColor", 7);
+    void Pipeline::DrawIndirect(GfxBuffer* commandBuffer)
+    {
+        if (!commandBuffer)
+            return;
 
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::NORMAL)->Bind(8);
-            m_CompositePass->GetShader()->SetInt("u_GNormal", 8);
+        m_DummyVAO->Bind();
+        commandBuffer->Bind();
 
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::POSITION)->Bind(9);
-            m_CompositePass->GetShader()->SetInt("u_GPosition", 9);
+        GfxDevice::Get()->MultiDrawElementsIndirect(
+            GL_TRIANGLES,
+            GL_UNSIGNED_INT,
+            0,
+            static_cast<GLsizei>(commandBuffer->GetSize() / sizeof(GpuDrawCommand)),
+            sizeof(GpuDrawCommand)
+        );
 
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::MATERIAL)->Bind(10);
-            m_CompositePass->GetShader()->SetInt("u_GMaterial", 10);
+        commandBuffer->Unbind();
+        m_DummyVAO->Unbind();
+    }
 
-            m_ShadowPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::SHADOW_MAP)->Bind(11);
-            m_CompositePass->GetShader()->SetInt("u_ShadowMap", 11);
+    void Pipeline::DrawArraysIndirect(GfxBuffer* commandBuffer, size_t offset)
+    {
+        if (!commandBuffer)
+            return;
 
-            m_LightingPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::COLOR)->Bind(12);
-            m_CompositePass->GetShader()->SetInt("u_DirectLighting", 12);
+        m_DummyVAO->Bind();
+        commandBuffer->BindAs(GFX_BUFFER_TYPE::INDIRECT_DRAW);
 
-            m_SelectionPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::SELECTION)->Bind(13);
-            m_CompositePass->GetShader()->SetInt("u_Selection", 13);
+        GfxDevice::Get()->DrawArraysIndirect(GL_TRIANGLES, offset);
 
-            m_VoxelPass->m_VoxelRadiance->Bind(14);
-            m_CompositePass->GetShader()->SetInt("u_VoxelRadiance", 14);
+        GfxDevice::Get()->BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        m_DummyVAO->Unbind();
+    }
 
-            m_VoxelPass->m_VoxelNormal->Bind(15);
-            m_CompositePass->GetShader()->SetInt("u_VoxelNormal", 15);
+    void Pipeline::UpdateLodDrawCommands(GfxBuffer* commandBuffer, float errorTolerance, MESH_MOBILITY mobility, const glm::vec4& cullSphere)
+    {
+        const GpuStaticMesh* staticMeshes = m_StaticMeshBuffer->GetDataPtr<GpuStaticMesh>();
+        const size_t staticMeshCount = m_StaticMeshBuffer->GetDataCount<GpuStaticMesh>();
+        const GpuMeshLod* meshLods = m_MeshLodBuffer->GetDataPtr<GpuMeshLod>();
+        const size_t meshLodCount = m_MeshLodBuffer->GetDataCount<GpuMeshLod>();
+        const GpuDrawCommand* baseCommands = m_DrawCommandBuffer->GetDataPtr<GpuDrawCommand>();
+        const size_t commandCount = m_DrawCommandBuffer->GetDataCount<GpuDrawCommand>();
 
-            m_GeometryPass->GetFrameBuffer()->GetAttachment(ATTACHMENT_TYPE::DEPTH)->Bind(16);
-            m_CompositePass->GetShader()->SetInt("u_DepthBuffer", 16);
+        if (commandBuffer->GetSize() != m_DrawCommandBuffer->GetSize())
+        {
+            commandBuffer->Create(GFX_BUFFER_TYPE::INDIRECT_DRAW, m_DrawCommandBuffer->GetSize(), baseCommands, GFX_BUFFER_USAGE::DYNAMIC);
+            commandBuffer->MarkDirty();
+        }
 
-            m_VoxelPass->m_IrradianceCache->Bind(17);
-            m_CompositePass->GetShader()->SetInt("u_IrradianceCache", 17);
+        GpuDrawCommand* commands = commandBuffer->GetDataPtr<GpuDrawCommand>();
+        if (!commands)
+            return;
 
-            m_CompositePass->m_Shader->SetIVec3("u_Resolution", m_VoxelPass->m_Resolution);
-            m_CompositePass->m_Shader->SetIVec3("u_GridMin", m_VoxelPass->m_GridMin);
-            m_CompositePass->m_Shader->SetIVec3("u_GridMax", m_VoxelPass->m_GridMax);
-            m_CompositePass->m_Shader->SetInt("u_MipCount", m_VoxelPass->m_MipCount);
-            m_CompositePass->m_Shader->SetVec3("u_CellSize", m_VoxelPass->m_CellSize);
+        size_t firstChanged = commandCount;
+        size_t lastChanged = 0;
+        for (size_t i = 0; i < commandCount; i++)
+        {
+            // Start over from the base command, removal and compaction move those around.
+            GpuDrawCommand command = baseCommands[i];
+            const uint32_t meshIndex = command.m_BaseInstance;
 
-            if (m_FullscreenQuad)
-                m_FullscreenQuad->Draw();
+            // Filtered out meshes stay in the list with no instances, the layout follows the base list.
+            if (mobility != MESH_MOBILITY::ANY && IsMeshStatic(meshIndex) != (mobility == MESH_MOBILITY::STATIC))
+                command.m_InstanceCount = 0;
+            else if (cullSphere.w > 0.0f && staticMeshes && meshIndex < staticMeshCount && !SpheresOverlap(GetBoundingSphere(staticMeshes[meshIndex]), cullSphere))
+                command.m_InstanceCount = 0;
 
-            m_CompositePass->Unbind();
+            if (staticMeshes && meshLods && meshIndex < staticMeshCount)
+            {
+                const GpuStaticMesh& mesh = staticMeshes[meshIndex];
+                if (mesh.m_LodCount > 0 && mesh.m_LodOffset + mesh.m_LodCount <= meshLodCount)
+                {
+                    const glm::mat3 basis = glm::mat3(mesh.m_Transform);
+                    const float scale = glm::max(glm::length(basis[0]), glm::max(glm::length(basis[1]), glm::length(basis[2])));
+
+                    uint32_t lod = 0;
+                    for (uint32_t l = 1; l < mesh.m_LodCount; l++)
+                    {
+                        if (meshLods[mesh.m_LodOffset + l].m_Error * scale > errorTolerance)
+                            break;
+                        lod = l;
+                    }
+
+                    const GpuMeshLod& selected = meshLods[mesh.m_LodOffset + lod];
+                    command.m_FirstIndex = selected.m_FirstIndex;
+                    command.m_Count = selected.m_IndexCount;
+                }
+            }
+
+            if (std::memcmp(&commands[i], &command, sizeof(GpuDrawCommand)) != 0)
+            {
+                commands[i] = command;
+                firstChanged = std::min(firstChanged, i);
+                lastChanged = i;
+            }
         }
-    }
 
-    void Pipeline::Destroy()
-    {
-        delete m_GeometryPass;
-        delete m_LightingPass;
-        delete m_ShadowPass;
-        delete m_VoxelPass;
-        delete m_FullscreenQuad;
-    }
+        if (firstChanged < commandCount)
+            commandBuffer->MarkDirty(firstChanged * sizeof(GpuDrawCommand), (lastChanged - firstChanged + 1) * sizeof(GpuDrawCommand));
 
-    void Pipeline::Clear()
-    {
-        if (m_VertexBuffer) m_VertexBuffer->Clear();
-        if (m_IndexBuffer) m_IndexBuffer->Clear();
-        if (m_MaterialBuffer) m_MaterialBuffer->Clear();
-        if (m_LightBuffer) m_LightBuffer->Clear();
-        if (m_StaticMeshBuffer) m_StaticMeshBuffer->Clear();
-        if (m_DrawCommandBuffer) m_DrawCommandBuffer->Clear();
-        if (m_TextureBuffer) m_TextureBuffer->Clear();
-        m_TextureToIndex.clear();
-        m_MaterialToIndex.clear();
+        commandBuffer->Upload();
     }
 
-
-    void Pipeline::Draw()
+    glm::vec4 Pipeline::GetBoundingSphere(const GpuStaticMesh& mesh)
     {
-        m_DummyVAO->Bind();
-        m_DrawCommandBuffer->Bind();
-
-        glMultiDrawElementsIndirect(
-            GL_TRIANGLES,
-            GL_UNSIGNED_INT,
-            nullptr,
-            m_DrawCommandBuffer->GetSize() / sizeof(GpuDrawCommand),
-            sizeof(GpuDrawCommand)
-        );
+        if (mesh.m_AABBMin == mesh.m_AABBMax)
+            return glm::vec4(glm::vec3(mesh.m_Transform[3]), FLT_MAX);
 
-        m_DrawCommandBuffer->Unbind();
-        m_DummyVAO->Unbind();
+        const glm::vec3 center = glm::vec3(mesh.m_Transform * glm::vec4((mesh.m_AABBMin + mesh.m_AABBMax) * 0.5f, 1.0f));
+        const glm::mat3 basis = glm::mat3(mesh.m_Transform);
+        const float scale = glm::max(glm::length(basis[0]), glm::max(glm::length(basis[1]), glm::length(basis[2])));
+        return glm::vec4(center, glm::length(mesh.m_AABBMax - mesh.m_AABBMin) * 0.5f * scale);
     }
 
     void Pipeline::DrawSelected()
@@ -252,11 +480,11 @@ namespace Isle
             if (staticMeshes[baseInstance].m_Selected)
             {
                 const GpuDrawCommand& cmd = drawCommands[i];
-                glDrawElementsInstancedBaseVertexBaseInstance(
+                GfxDevice::Get()->DrawElementsInstanced(
                     GL_TRIANGLES,
                     cmd.m_Count,
                     GL_UNSIGNED_INT,
-                    reinterpret_cast<void*>(cmd.m_FirstIndex * sizeof(uint32_t)),
+                    cmd.m_FirstIndex * sizeof(uint32_t),
                     cmd.m_InstanceCount,
                     cmd.m_BaseVertex,
                     cmd.m_BaseInstance
@@ -278,62 +506,349 @@ namespace Isle
         return nullptr;
     }
 
-    void Pipeline::AddIndexBuffer(std::vector<unsigned int> indices)
+    void Pipeline::AddStaticMesh(StaticMesh* mesh)
+    {
+        if (!mesh || IsResident(mesh))
+            return;
+
+        if (mesh->GetMeshlets().empty())
+            mesh->BuildMeshlets();
+
+        const std::vector<GpuVertex>& vertices = mesh->GetVertices();
+        const std::vector<unsigned int>& indices = mesh->GetIndices();
+        const std::vector<MeshLod>& lods = mesh->GetLods();
+
+        size_t indexCount = indices.size();
+        size_t meshletCount = mesh->GetMeshlets().size();
+        for (const MeshLod& lod : lods)
+        {
+            indexCount += lod.m_Indices.size();
+            meshletCount += lod.m_Meshlets.size();
+        }
+
+        const uint32_t slot = m_MeshSlots.Allocate();
+        if (slot >= m_MeshRecords.size())
+        {
+            m_MeshRecords.resize(slot + 1);
+            m_MeshIdleFrames.resize(slot + 1, STATIC_AFTER_FRAMES);
+        }
+
+        MeshRecord& record = m_MeshRecords[slot];
+        record.m_Mesh = mesh;
+        record.m_Material = mesh->GetMaterial();
+        record.m_Vertices = m_VertexRanges.Allocate(static_cast<uint32_t>(vertices.size()), slot);
+        record.m_Indices = m_IndexRanges.Allocate(static_cast<uint32_t>(indexCount), slot);
+        record.m_Meshlets = m_MeshletRanges.Allocate(static_cast<uint32_t>(meshletCount), slot);
+        record.m_Lods = m_LodRanges.Allocate(1 + static_cast<uint32_t>(lods.size()), slot);
+
+        GpuStaticMesh gpuMesh = mesh->GetGpuStaticMesh();
+        gpuMesh.m_MaterialIndex = AcquireMaterial(record.m_Material);
+        gpuMesh.m_VertexOffset = m_VertexRanges.GetOffset(record.m_Vertices);
+        gpuMesh.m_IndexOffset = m_IndexRanges.GetOffset(record.m_Indices);
+        gpuMesh.m_LodOffset = m_LodRanges.GetOffset(record.m_Lods);
+        gpuMesh.m_LodCount = m_LodRanges.GetCount(record.m_Lods);
+
+        Write(*m_VertexBuffer, gpuMesh.m_VertexOffset, vertices.data(), vertices.size());
+        AddMeshLods(mesh, record, slot);
+
+        // The skinning pass overwrites the mesh's vertices every frame, the bind pose it
+        // starts from is kept on the side.
+        SkinnedMesh* skinned = Cast<SkinnedMesh>(mesh);
+        if (skinned && !vertices.empty() && skinned->GetSkinWeights().size() == vertices.size())
+        {
+            record.m_Skin = m_SkinRanges.Allocate(static_cast<uint32_t>(vertices.size()), slot);
+            record.m_SkinnedIndex = static_cast<uint32_t>(m_SkinnedMeshes.size());
+            m_SkinnedMeshes.push_back(slot);
+
+            const uint32_t skinOffset = m_SkinRanges.GetOffset(record.m_Skin);
+            Write(*m_SkinSourceBuffer, skinOffset, vertices.data(), vertices.size());
+            Write(*m_SkinWeightBuffer, skinOffset, skinned->GetSkinWeights().data(), vertices.size());
+            gpuMesh.m_Skinned = 1;
+        }
+
+        Write(*m_StaticMeshBuffer, slot, &gpuMesh, 1);
+
+        GpuDrawCommand command{};
+        command.m_Count = gpuMesh.m_IndexCount;
+        command.m_InstanceCount = 1;
+        command.m_FirstIndex = gpuMesh.m_IndexOffset;
+        command.m_BaseVertex = gpuMesh.m_VertexOffset;
+        command.m_BaseInstance = slot;
+        record.m_Command = static_cast<uint32_t>(m_DrawCommandBuffer->Add<GpuDrawCommand>(command));
+
+        mesh->m_Id = slot;
+        m_MeshIdleFrames[slot] = STATIC_AFTER_FRAMES;
+        m_MovedBounds.push_back(GetBoundingSphere(gpuMesh));
+        m_StaticVersion++;
+    }
+
+    void Pipeline::RemoveStaticMesh(StaticMesh* mesh)
     {
-        m_IndexBuffer->AddRange(indices);
+        if (!IsResident(mesh))
+            return;
+
+        const uint32_t slot = mesh->m_Id;
+        MeshRecord& record = m_MeshRecords[slot];
+
+        // Anything cached with the mesh in it is stale now.
+        GpuStaticMesh* staticMeshes = m_StaticMeshBuffer->GetDataPtr<GpuStaticMesh>();
+        m_MovedBounds.push_back(GetBoundingSphere(staticMeshes[slot]));
+        m_StaticVersion++;
+
+        staticMeshes[slot] = GpuStaticMesh{};
+        m_StaticMeshBuffer->MarkDirty(slot * sizeof(GpuStaticMesh), sizeof(GpuStaticMesh));
+
+        // The culler walks every meshlet up to the end, freed ones must draw nothing.
+        Zero<GpuMeshlet>(*m_MeshletBuffer, m_MeshletRanges.GetOffset(record.m_Meshlets), m_MeshletRanges.GetCount(record.m_Meshlets));
+
+        m_VertexRanges.Free(record.m_Vertices);
+        m_IndexRanges.Free(record.m_Indices);
+        m_MeshletRanges.Free(record.m_Meshlets);
+        m_LodRanges.Free(record.m_Lods);
+
+        if (record.m_Skin.IsValid())
+        {
+            m_SkinRanges.Free(record.m_Skin);
+
+            const uint32_t lastSkinned = m_SkinnedMeshes.back();
+            m_SkinnedMeshes[record.m_SkinnedIndex] = lastSkinned;
+            m_MeshRecords[lastSkinned].m_SkinnedIndex = record.m_SkinnedIndex;
+            m_SkinnedMeshes.pop_back();
+        }
+
+        // The last command takes the freed place so the list stays dense.
+        GpuDrawCommand* commands = m_DrawCommandBuffer->GetDataPtr<GpuDrawCommand>();
+        const uint32_t last = static_cast<uint32_t>(m_DrawCommandBuffer->GetDataCount<GpuDrawCommand>()) - 1;
+        if (record.m_Command != last)
+        {
+            commands[record.m_Command] = commands[last];
+            m_MeshRecords[commands[last].m_BaseInstance].m_Command = record.m_Command;
+            m_DrawCommandBuffer->MarkDirty(record.m_Command * sizeof(GpuDrawCommand), sizeof(GpuDrawCommand));
+        }
+        m_DrawCommandBuffer->Resize(last * sizeof(GpuDrawCommand));
+
+        ReleaseMaterial(record.m_Material);
+
+        if (m_SelectedMesh == static_cast<int>(slot))
+            m_SelectedMesh = -1;
+
+        m_MeshIdleFrames[slot] = STATIC_AFTER_FRAMES;
+        record = MeshRecord{};
+        m_MeshSlots.Free(slot);
+        mesh->m_Id = -1;
     }
 
-    void Pipeline::AddVertexBuffer(std::vector<GpuVertex> vertex)
+    bool Pipeline::IsResident(const StaticMesh* mesh) const
     {
-        m_VertexBuffer->AddRange(vertex);
+        return mesh && mesh->m_Id >= 0 && static_cast<size_t>(mesh->m_Id) < m_MeshRecords.size() && m_MeshRecords[mesh->m_Id].m_Mesh == mesh;
     }
 
-    void Pipeline::AddDrawCommand(Mesh* mesh)
+    void Pipeline::AddMeshLods(StaticMesh* mesh, const MeshRecord& record, uint32_t meshIndex)
     {
-        GpuDrawCommand GDrawCmd{};
-        GDrawCmd.m_Count = mesh->GetIndices().size();
-        GDrawCmd.m_InstanceCount = 1;
-        GDrawCmd.m_FirstIndex = m_IndexBuffer->GetSize() / sizeof(unsigned int);
-        GDrawCmd.m_BaseVertex = m_VertexBuffer->GetSize() / sizeof(GpuVertex);
-        GDrawCmd.m_BaseInstance = m_StaticMeshBuffer->GetSize() / sizeof(GpuStaticMesh);
-        m_DrawCommandBuffer->Add<GpuDrawCommand>(GDrawCmd);
+        const uint32_t baseVertex = m_VertexRanges.GetOffset(record.m_Vertices);
+        uint32_t firstIndex = m_IndexRanges.GetOffset(record.m_Indices);
+        uint32_t meshletOffset = m_MeshletRanges.GetOffset(record.m_Meshlets);
+        uint32_t lodOffset = m_LodRanges.GetOffset(record.m_Lods);
+
+        const std::vector<unsigned int>& indices = mesh->GetIndices();
+
+        GpuMeshLod baseLod{};
+        baseLod.m_FirstIndex = firstIndex;
+        baseLod.m_IndexCount = indices.size();
+        baseLod.m_MeshletOffset = meshletOffset;
+        baseLod.m_MeshletCount = mesh->GetMeshlets().size();
+        baseLod.m_Error = 0.0f;
+        Write(*m_MeshLodBuffer, lodOffset++, &baseLod, 1);
+
+        AddMeshlets(mesh->GetMeshlets(), meshletOffset, firstIndex, baseVertex, meshIndex);
+        Write(*m_IndexBuffer, firstIndex, indices.data(), indices.size());
+        firstIndex += baseLod.m_IndexCount;
+        meshletOffset += baseLod.m_MeshletCount;
+
+        for (const MeshLod& lod : mesh->GetLods())
+        {
+            GpuMeshLod gpuLod{};
+            gpuLod.m_FirstIndex = firstIndex;
+            gpuLod.m_IndexCount = lod.m_Indices.size();
+            gpuLod.m_MeshletOffset = meshletOffset;
+            gpuLod.m_MeshletCount = lod.m_Meshlets.size();
+            gpuLod.m_Error = lod.m_Error;
+            Write(*m_MeshLodBuffer, lodOffset++, &gpuLod, 1);
+
+            AddMeshlets(lod.m_Meshlets, meshletOffset, firstIndex, baseVertex, meshIndex);
+            Write(*m_IndexBuffer, firstIndex, lod.m_Indices.data(), lod.m_Indices.size());
+            firstIndex += gpuLod.m_IndexCount;
+            meshletOffset += gpuLod.m_MeshletCount;
+        }
     }
 
-    void Pipeline::AddStaticMesh(StaticMesh* mesh)
+    void Pipeline::AddMeshlets(const std::vector<GpuMeshlet>& meshlets, uint32_t offset, uint32_t firstIndex, uint32_t baseVertex, uint32_t meshIndex)
+    {
+        if (meshlets.empty())
+            return;
+
+        GpuMeshlet* data = Reserve<GpuMeshlet>(*m_MeshletBuffer, offset + meshlets.size()) + offset;
+        for (GpuMeshlet meshlet : meshlets)
+        {
+            meshlet.m_MeshIndex = meshIndex;
+            meshlet.m_IndexOffset += firstIndex;
+            meshlet.m_VertexOffset = baseVertex;
+            *data++ = meshlet;
+        }
+
+        m_MeshletBuffer->MarkDirty(offset * sizeof(GpuMeshlet), meshlets.size() * sizeof(GpuMeshlet));
+    }
+
+    void Pipeline::Defragment()
+    {
+        ISLE_PROFILE_SCOPE("Defragment");
+
+        GpuStaticMesh* staticMeshes = m_StaticMeshBuffer->GetDataPtr<GpuStaticMesh>();
+        GpuDrawCommand* commands = m_DrawCommandBuffer->GetDataPtr<GpuDrawCommand>();
+
+        // Each buffer is compacted and patched before the next one, so the offsets read from
+        // the other allocators always match what is in their buffers.
+        m_Moves.clear();
+        m_VertexRanges.Compact(m_DefragmentBytesPerFrame / sizeof(GpuVertex), m_Moves);
+        for (const BufferAllocator::Move& move : m_Moves)
+        {
+            const MeshRecord& record = m_MeshRecords[move.m_Owner];
+            Slide<GpuVertex>(*m_VertexBuffer, move);
+
+            staticMeshes[move.m_Owner].m_VertexOffset = move.m_To;
+            m_StaticMeshBuffer->MarkDirty(move.m_Owner * sizeof(GpuStaticMesh), sizeof(GpuStaticMesh));
+
+            commands[record.m_Command].m_BaseVertex = move.m_To;
+            m_DrawCommandBuffer->MarkDirty(record.m_Command * sizeof(GpuDrawCommand), sizeof(GpuDrawCommand));
+
+            const uint32_t meshletOffset = m_MeshletRanges.GetOffset(record.m_Meshlets);
+            const uint32_t meshletCount = m_MeshletRanges.GetCount(record.m_Meshlets);
+            GpuMeshlet* meshlets = m_MeshletBuffer->GetDataPtr<GpuMeshlet>() + meshletOffset;
+            for (uint32_t i = 0; i < meshletCount; i++)
+                meshlets[i].m_VertexOffset = move.m_To;
+            m_MeshletBuffer->MarkDirty(meshletOffset * sizeof(GpuMeshlet), meshletCount * sizeof(GpuMeshlet));
+        }
+
+        m_Moves.clear();
+        m_IndexRanges.Compact(m_DefragmentBytesPerFrame / sizeof(unsigned int), m_Moves);
+        for (const BufferAllocator::Move& move : m_Moves)
+        {
+            const MeshRecord& record = m_MeshRecords[move.m_Owner];
+            const uint32_t delta = move.m_From - move.m_To;
+            Slide<unsigned int>(*m_IndexBuffer, move);
+
+            staticMeshes[move.m_Owner].m_IndexOffset = move.m_To;
+            m_StaticMeshBuffer->MarkDirty(move.m_Owner * sizeof(GpuStaticMesh), sizeof(GpuStaticMesh));
+
+            commands[record.m_Command].m_FirstIndex = move.m_To;
+            m_DrawCommandBuffer->MarkDirty(record.m_Command * sizeof(GpuDrawCommand), sizeof(GpuDrawCommand));
+
+            const uint32_t lodOffset = m_LodRanges.GetOffset(record.m_Lods);
+            const uint32_t lodCount = m_LodRanges.GetCount(record.m_Lods);
+            GpuMeshLod* lods = m_MeshLodBuffer->GetDataPtr<GpuMeshLod>() + lodOffset;
+            for (uint32_t i = 0; i < lodCount; i++)
+                lods[i].m_FirstIndex -= delta;
+            m_MeshLodBuffer->MarkDirty(lodOffset * sizeof(GpuMeshLod), lodCount * sizeof(GpuMeshLod));
+
+            const uint32_t meshletOffset = m_MeshletRanges.GetOffset(record.m_Meshlets);
+            const uint32_t meshletCount = m_MeshletRanges.GetCount(record.m_Meshlets);
+            GpuMeshlet* meshlets = m_MeshletBuffer->GetDataPtr<GpuMeshlet>() + meshletOffset;
+            for (uint32_t i = 0; i < meshletCount; i++)
+                meshlets[i].m_IndexOffset -= delta;
+            m_MeshletBuffer->MarkDirty(meshletOffset * sizeof(GpuMeshlet), meshletCount * sizeof(GpuMeshlet));
+        }
+
+        m_Moves.clear();
+        m_MeshletRanges.Compact(m_DefragmentBytesPerFrame / sizeof(GpuMeshlet), m_Moves);
+        for (const BufferAllocator::Move& move : m_Moves)
+        {
+            const MeshRecord& record = m_MeshRecords[move.m_Owner];
+            const uint32_t delta = move.m_From - move.m_To;
+            Slide<GpuMeshlet>(*m_MeshletBuffer, move);
+
+            const uint32_t lodOffset = m_LodRanges.GetOffset(record.m_Lods);
+            const uint32_t lodCount = m_LodRanges.GetCount(record.m_Lods);
+            GpuMeshLod* lods = m_MeshLodBuffer->GetDataPtr<GpuMeshLod>() + lodOffset;
+            for (uint32_t i = 0; i < lodCount; i++)
+                lods[i].m_MeshletOffset -= delta;
+            m_MeshLodBuffer->MarkDirty(lodOffset * sizeof(GpuMeshLod), lodCount * sizeof(GpuMeshLod));
+        }
+
+        m_Moves.clear();
+        m_LodRanges.Compact(m_DefragmentBytesPerFrame / sizeof(GpuMeshLod), m_Moves);
+        for (const BufferAllocator::Move& move : m_Moves)
+        {
+            Slide<GpuMeshLod>(*m_MeshLodBuffer, move);
+
+            staticMeshes[move.m_Owner].m_LodOffset = move.m_To;
+            m_StaticMeshBuffer->MarkDirty(move.m_Owner * sizeof(GpuStaticMesh), sizeof(GpuStaticMesh));
+        }
+
+        // Skin offsets are read from the allocator when the dispatch list is packed.
+        m_Moves.clear();
+        m_SkinRanges.Compact(m_DefragmentBytesPerFrame / sizeof(GpuVertex), m_Moves);
+        for (const BufferAllocator::Move& move : m_Moves)
+        {
+            Slide<GpuVertex>(*m_SkinSourceBuffer, move);
+            Slide<GpuSkinnedVertex>(*m_SkinWeightBuffer, move);
+        }
+    }
+
+    void Pipeline::UpdateSkinning()
     {
-        auto material = mesh->GetMaterial();
-        uint32_t materialIndex = -1;
+        ISLE_PROFILE_SCOPE("Skinning");
 
-        if (material)
+        m_SkinnedMeshCount = 0;
+        m_SkinnedVertexCount = 0;
+        if (m_SkinnedMeshes.empty())
+            return;
+
+        GpuSkinnedMesh* dispatches = Reserve<GpuSkinnedMesh>(*m_SkinnedMeshBuffer, m_SkinnedMeshes.size());
+        uint32_t boneCount = 0;
+
+        for (uint32_t slot : m_SkinnedMeshes)
         {
-            AddMaterialTexture(material, "BaseColor");
-            AddMaterialTexture(material, "Emissive");
-            AddMaterialTexture(material, "MetallicRoughness");
-            AddMaterialTexture(material, "Occlusion");
-            AddMaterialTexture(material, "Normal");
+            const MeshRecord& record = m_MeshRecords[slot];
+            SkinnedMesh* mesh = static_cast<SkinnedMesh*>(record.m_Mesh);
+            if (!mesh->HasSkeleton())
+                continue;
 
-            auto it = m_MaterialToIndex.find(material);
-            if (it != m_MaterialToIndex.end())
+            const uint32_t jointCount = mesh->GetJointCount();
+            m_JointMatrices.resize(jointCount);
+            const Bounds bounds = mesh->ComputeJointMatrices(m_JointMatrices.data());
+
+            // Only a pose that changed moves the mesh, a still character stays static.
+            glm::mat4* palette = Reserve<glm::mat4>(*m_BoneMatrixBuffer, boneCount + jointCount) + boneCount;
+            if (std::memcmp(palette, m_JointMatrices.data(), jointCount * sizeof(glm::mat4)) != 0)
             {
-                materialIndex = it->second;
+                std::memcpy(palette, m_JointMatrices.data(), jointCount * sizeof(glm::mat4));
+                m_BoneMatrixBuffer->MarkDirty(boneCount * sizeof(glm::mat4), jointCount * sizeof(glm::mat4));
+
+                if (bounds.IsValid())
+                    mesh->SetBounds(bounds);
+                mesh->MarkDirty();
+                UpdateStaticMesh(mesh);
             }
-            else
+
+            GpuSkinnedMesh dispatch{};
+            dispatch.m_SourceOffset = m_SkinRanges.GetOffset(record.m_Skin);
+            dispatch.m_VertexOffset = m_VertexRanges.GetOffset(record.m_Vertices);
+            dispatch.m_VertexCount = m_VertexRanges.GetCount(record.m_Vertices);
+            dispatch.m_FirstThread = m_SkinnedVertexCount;
+            dispatch.m_BoneMatrixOffset = boneCount;
+            dispatch.m_BoneCount = jointCount;
+
+            GpuSkinnedMesh& previous = dispatches[m_SkinnedMeshCount];
+            if (std::memcmp(&previous, &dispatch, sizeof(GpuSkinnedMesh)) != 0)
             {
-                GpuMaterial gpuMat = material->GetGpuMaterial();
-                materialIndex = m_MaterialBuffer->GetSize() / sizeof(GpuMaterial);
-                m_MaterialBuffer->Add<GpuMaterial>(gpuMat);
-                m_MaterialToIndex[material] = materialIndex;
+                previous = dispatch;
+                m_SkinnedMeshBuffer->MarkDirty(m_SkinnedMeshCount * sizeof(GpuSkinnedMesh), sizeof(GpuSkinnedMesh));
             }
-        }
-
-        GpuStaticMesh gpuMesh = mesh->GetGpuStaticMesh();
-        gpuMesh.m_MaterialIndex = materialIndex;
 
-        AddDrawCommand(mesh);
-        mesh->m_Id = GetNumStaticMeshes();
-        m_StaticMeshBuffer->Add<GpuStaticMesh>(gpuMesh);
-        AddIndexBuffer(mesh->GetIndices());
-        AddVertexBuffer(mesh->GetVertices());
+            m_SkinnedMeshCount++;
+            m_SkinnedVertexCount += dispatch.m_VertexCount;
+            boneCount += jointCount;
+        }
     }
 
     void Pipeline::UpdateLight(Light* light)
@@ -347,37 +862,34 @@ namespace Isle
         if (!lights || light->m_Id >= lightCount)
             return;
 
-        GpuLight gpuLight{};
+        GpuLight gpuLight = light->ToGpuLight();
 
-        if (auto dirLight = dynamic_cast<DirectionalLight*>(light))
-            gpuLight = dirLight->ToGpuLight();
-        else if (auto pointLight = dynamic_cast<PointLight*>(light))
-            gpuLight = pointLight->ToGpuLight();
-        else if (auto spotLight = dynamic_cast<SpotLight*>(light))
-            gpuLight = spotLight->ToGpuLight();
-        else
-            gpuLight = light->ToGpuLight();
+        // The atlas mapping belongs to the local shadow pass, keep what it last wrote.
+        const GpuLight& previous = lights[light->m_Id];
+        gpuLight.m_ShadowTileCount = previous.m_ShadowTileCount;
+        for (int i = 0; i < 6; i++)
+            gpuLight.m_ShadowTiles[i] = previous.m_ShadowTiles[i];
 
         lights[light->m_Id] = gpuLight;
         m_LightBuffer->MarkDirty();
     }
 
-    void Pipeline::AddMaterial(Material* material)
-    {
-        if (!material)
-            return;
-
-        m_MaterialBuffer->Add<GpuMaterial>(material->GetGpuMaterial());
-    }
-
 
     void Pipeline::UpdateStaticMesh(StaticMesh* mesh)
     {
-        if (!mesh)
+        if (!IsResident(mesh))
             return;
 
-        if (mesh->m_Id == -1)
-            return;
+        // A new material is held before the old one is let go, they may share textures.
+        MeshRecord& record = m_MeshRecords[mesh->m_Id];
+        if (record.m_Material != mesh->GetMaterial())
+        {
+            Material* previousMaterial = record.m_Material;
+            record.m_Material = mesh->GetMaterial();
+            AcquireMaterial(record.m_Material);
+            ReleaseMaterial(previousMaterial);
+            mesh->MarkDirty();
+        }
 
         const GpuStaticMesh* staticMeshes = m_StaticMeshBuffer->GetDataPtr<GpuStaticMesh>();
         const size_t meshCount = m_StaticMeshBuffer->GetDataCount<GpuStaticMesh>();
@@ -385,19 +897,19 @@ namespace Isle
         if (mesh->m_Id >= meshCount)
             return;
 
-        bool wasSelected = staticMeshes[mesh->m_Id].m_Selected;
+        const GpuStaticMesh& previous = staticMeshes[mesh->m_Id];
 
         GpuStaticMesh gpuMesh = mesh->GetGpuStaticMesh();
-        gpuMesh.m_Selected = wasSelected;
+        gpuMesh.m_Selected = previous.m_Selected;
+        gpuMesh.m_VertexOffset = previous.m_VertexOffset;
+        gpuMesh.m_IndexOffset = previous.m_IndexOffset;
+        gpuMesh.m_IndexCount = previous.m_IndexCount;
+        gpuMesh.m_LodOffset = previous.m_LodOffset;
+        gpuMesh.m_LodCount = previous.m_LodCount;
+        gpuMesh.m_Skinned = previous.m_Skinned;
 
-        if (mesh->GetMaterial())
-        {
-            auto it = m_MaterialToIndex.find(mesh->GetMaterial());
-            if (it != m_MaterialToIndex.end())
-                gpuMesh.m_MaterialIndex = it->second;
-            else
-                gpuMesh.m_MaterialIndex = -1;
-        }
+        auto material = m_MaterialRecords.find(record.m_Material);
+        gpuMesh.m_MaterialIndex = material != m_MaterialRecords.end() ? material->second.m_Index : -1;
 
         if (mesh->GetMaterial() && mesh->GetMaterial()->IsDirty())
         {
@@ -407,6 +919,9 @@ namespace Isle
 
         if (mesh->IsDirty())
         {
+            m_MovedBounds.push_back(GetBoundingSphere(previous));
+            m_MovedBounds.push_back(GetBoundingSphere(gpuMesh));
+
             const size_t offsetInBytes = mesh->m_Id * sizeof(GpuStaticMesh);
             const size_t totalBytes = m_StaticMeshBuffer->GetSize();
 
@@ -418,7 +933,15 @@ namespace Isle
                     sizeof(GpuStaticMesh)
                 );
 
-                m_StaticMeshBuffer->MarkDirty();
+                m_StaticMeshBuffer->MarkDirty(offsetInBytes, sizeof(GpuStaticMesh));
+            }
+
+            // A static mesh moving turns dynamic, which changes what the static casters are.
+            if (static_cast<size_t>(mesh->m_Id) < m_MeshIdleFrames.size())
+            {
+                if (m_MeshIdleFrames[mesh->m_Id] >= STATIC_AFTER_FRAMES)
+                    m_StaticVersion++;
+                m_MeshIdleFrames[mesh->m_Id] = 0;
             }
 
             mesh->MarkDirty(false);
@@ -430,49 +953,118 @@ namespace Isle
         if (!material)
             return;
 
-        auto it = m_MaterialToIndex.find(material);
-        if (it == m_MaterialToIndex.end())
+        auto it = m_MaterialRecords.find(material);
+        if (it == m_MaterialRecords.end())
             return;
 
-        const uint32_t materialIndex = it->second;
-        const size_t offsetInBytes = materialIndex * sizeof(GpuMaterial);
-        const size_t totalBytes = m_MaterialBuffer->GetSize();
+        // Textures may have been swapped, hold the new set before letting go of the old one.
+        MaterialRecord& record = it->second;
+        Texture* previous[MATERIAL_TEXTURE_COUNT];
+        std::copy(std::begin(record.m_Textures), std::end(record.m_Textures), previous);
 
-        if (offsetInBytes + sizeof(GpuMaterial) > totalBytes)
-            return;
+        AcquireTextures(material, record);
+        for (Texture* texture : previous)
+            ReleaseTexture(texture);
 
         const GpuMaterial gpuMaterial = material->GetGpuMaterial();
+        Write(*m_MaterialBuffer, record.m_Index, &gpuMaterial, 1);
+    }
 
-        std::memcpy(
-            m_MaterialBuffer->GetDataPtr<uint8_t>() + offsetInBytes,
-            &gpuMaterial,
-            sizeof(GpuMaterial)
-        );
+    uint32_t Pipeline::AcquireMaterial(Material* material)
+    {
+        if (!material)
+            return -1;
+
+        auto [it, inserted] = m_MaterialRecords.try_emplace(material);
+        MaterialRecord& record = it->second;
+        record.m_Users++;
+
+        if (inserted)
+        {
+            AcquireTextures(material, record);
+            record.m_Index = m_MaterialSlots.Allocate();
+
+            const GpuMaterial gpuMaterial = material->GetGpuMaterial();
+            Write(*m_MaterialBuffer, record.m_Index, &gpuMaterial, 1);
+        }
 
-        m_MaterialBuffer->MarkDirty();
+        return record.m_Index;
     }
 
+    void Pipeline::ReleaseMaterial(Material* material)
+    {
+        auto it = m_MaterialRecords.find(material);
+        if (it == m_MaterialRecords.end() || --it->second.m_Users > 0)
+            return;
+
+        for (Texture* texture : it->second.m_Textures)
+            ReleaseTexture(texture);
+
+        m_MaterialSlots.Free(it->second.m_Index);
+        m_MaterialRecords.erase(it);
+    }
+
+    void Pipeline::AcquireTextures(Material* material, MaterialRecord& record)
+    {
+        for (uint32_t i = 0; i < MATERIAL_TEXTURE_COUNT; i++)
+        {
+            auto texture = material->GetTexture(MATERIAL_TEXTURES[i]);
+            record.m_Textures[i] = texture.Get();
+            AcquireTexture(texture.Get());
+        }
+    }
 
-    void Pipeline::AddMaterialTexture(Material* material, std::string name)
+    void Pipeline::AcquireTexture(Texture* texture)
     {
-        auto texture = material->GetTexture(name);
         if (!texture)
             return;
 
-        auto it = m_TextureToIndex.find(texture->m_Id);
-        if (it == m_TextureToIndex.end())
-        {
-            GLuint64 handle = texture->GetBindlessHandle();
-            uint32_t index = m_TextureBuffer->GetSize() / sizeof(GLuint64);
+        auto [it, inserted] = m_TextureRecords.try_emplace(texture);
+        TextureRecord& record = it->second;
+        record.m_Users++;
 
-            m_TextureBuffer->Add(handle);
-            texture->m_BindlessIndex = index;
-            m_TextureToIndex[texture->m_Id] = index;
-        }
-        else
+        if (!inserted)
         {
-            texture->m_BindlessIndex = it->second;
+            texture->m_BindlessIndex = record.m_Index;
+            return;
         }
+
+        record.m_Index = m_TextureSlots.Allocate();
+        texture->m_BindlessIndex = record.m_Index;
+
+        const GLuint64 handle = texture->GetBindlessHandle();
+        Write(*m_TextureBuffer, record.m_Index, &handle, 1);
+
+        if (m_TextureStreamer)
+            m_TextureStreamer->Register(texture);
+    }
+
+    void Pipeline::ReleaseTexture(Texture* texture)
+    {
+        auto it = m_TextureRecords.find(texture);
+        if (it == m_TextureRecords.end() || --it->second.m_Users > 0)
+            return;
+
+        if (m_TextureStreamer)
+            m_TextureStreamer->Unregister(texture);
+
+        // The slot gets handed out again, until then it must not point at a texture that may be gone.
+        const GLuint64 handle = 0;
+        Write(*m_TextureBuffer, it->second.m_Index, &handle, 1);
+
+        m_TextureSlots.Free(it->second.m_Index);
+        texture->m_BindlessIndex = -1;
+        m_TextureRecords.erase(it);
+    }
+
+    void Pipeline::UpdateTextureHandle(Texture* texture)
+    {
+        auto it = m_TextureRecords.find(texture);
+        if (it == m_TextureRecords.end())
+            return;
+
+        const GLuint64 handle = texture->GetBindlessHandle();
+        Write(*m_TextureBuffer, it->second.m_Index, &handle, 1);
     }
 
 
@@ -491,14 +1083,16 @@ namespace Isle
         m_CameraBuffer->MarkDirty();
     }
 
+    void Pipeline::SetOutputSize(glm::ivec2 size)
+    {
+        m_OutputSize = glm::max(size, glm::ivec2(1));
+    }
+
 
     void Pipeline::AddLight(Light* light)
     {
-        light->m_Id = GetNumLights();
-        if (auto dirLight = dynamic_cast<DirectionalLight*>(light))
-        {
-            m_LightBuffer->Add<GpuLight>(dirLight->ToGpuLight());
-        }
+        // Every type goes in, the lighting and local shadow passes walk the whole buffer.
+        light->m_Id = static_cast<int>(m_LightBuffer->Add<GpuLight>(light->ToGpuLight()));
     }
 
     void Pipeline::SelectMesh(Mesh* selectedMesh, bool state)
@@ -518,6 +1112,8 @@ namespace Isle
         if (state)
             staticMeshes[selectedMesh->m_Id].m_Selected = 1;
 
+        m_SelectedMesh = state ? selectedMesh->m_Id : -1;
+
         m_StaticMeshBuffer->MarkDirty();
     }
 
@@ -530,12 +1126,12 @@ namespace Isle
 
     int Pipeline::GetNumVertices()
     {
-        return m_VertexBuffer->GetSize() / sizeof(GpuVertex);
+        return m_VertexRanges.GetUsed();
     }
 
     int Pipeline::GetNumIndicies()
     {
-        return m_IndexBuffer->GetSize() / sizeof(unsigned int);
+        return m_IndexRanges.GetUsed();
     }
 
     int Pipeline::GetNumLights()
@@ -545,16 +1141,32 @@ namespace Isle
 
     int Pipeline::GetNumMaterials()
     {
-        return m_MaterialBuffer->GetSize() / sizeof(GpuMaterial);
+        return m_MaterialSlots.GetUsed();
+    }
+
+    TextureStreamer* Pipeline::GetTextureStreamer()
+    {
+        return m_TextureStreamer;
     }
 
     int Pipeline::GetNumTextures()
     {
-        return m_TextureBuffer->GetSize() / sizeof(uint64_t);
+        return m_TextureSlots.GetUsed();
     }
 
     int Pipeline::GetNumStaticMeshes()
     {
-        return m_StaticMeshBuffer->GetSize() / sizeof(GpuStaticMesh);
+        return m_MeshSlots.GetUsed();
+    }
+
+    // The culler walks every meshlet up to the end, holes included.
+    int Pipeline::GetNumMeshlets()
+    {
+        return m_MeshletRanges.GetEnd();
+    }
+
+    int Pipeline::GetNumMeshLods()
+    {
+        return m_LodRanges.GetEnd();
     }
 }
\ No newline at end of file
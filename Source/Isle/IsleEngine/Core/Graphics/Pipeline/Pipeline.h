@@ -2,14 +2,22 @@
 #include <Core/Common/Common.h>
 #include <Core/Graphics/Structs/GpuStructs.h>
 #include <Core/Graphics/GfxBuffer/GfxBuffer.h>
+#include <Core/Graphics/GfxBuffer/BufferAllocator.h>
 #include <Core/Graphics/Passes/FowardPass.h>
 #include <Core/Graphics/Passes/GeometryPass.h>
 #include <Core/Graphics/Passes/LightingPass.h>
 #include <Core/Graphics/Passes/ShadowPass.h>
+#include <Core/Graphics/Passes/LocalShadowPass.h>
 #include <Core/Graphics/Passes/FullscreenQuad.h>
 #include <Core/Graphics/Passes/VoxelPass.h>
 #include <Core/Graphics/Passes/CompositePass.h>
+#include <Core/Graphics/Passes/IndirectPass.h>
 #include <Core/Graphics/Passes/SelectionPass.h>
+#include <Core/Graphics/Passes/CullPass.h>
+#include <Core/Graphics/Passes/SkinningPass.h>
+#include <Core/Graphics/Texture/TextureStreamer.h>
+#include <Core/Graphics/RenderGraph/RenderGraph.h>
+#include <Core/Graphics/Pipeline/DynamicResolution.h>
 
 namespace Isle
 {
@@ -19,8 +27,49 @@ namespace Isle
     class Light;
     class Material;
 
+    // Which meshes a draw command list keeps. Meshes count as dynamic while they keep moving.
+    enum class MESH_MOBILITY
+    {
+        ANY,
+        STATIC,
+        DYNAMIC
+    };
+
     class ISLEENGINE_API Pipeline : public Component
     {
+    private:
+        // Where a resident mesh lives in the shared buffers, indexed by its id. The base level
+        // and every LOD share one range per buffer.
+        struct MeshRecord
+        {
+            StaticMesh* m_Mesh = nullptr;
+            Material* m_Material = nullptr;
+            BufferRange m_Vertices;
+            BufferRange m_Indices;
+            BufferRange m_Meshlets;
+            BufferRange m_Lods;
+            uint32_t m_Command = 0;
+
+            // Bind pose and influences of a skinned mesh, and its place in m_SkinnedMeshes.
+            BufferRange m_Skin;
+            uint32_t m_SkinnedIndex = 0;
+        };
+
+        static constexpr uint32_t MATERIAL_TEXTURE_COUNT = 5;
+
+        struct MaterialRecord
+        {
+            uint32_t m_Index = 0;
+            uint32_t m_Users = 0;
+            Texture* m_Textures[MATERIAL_TEXTURE_COUNT] = {};
+        };
+
+        struct TextureRecord
+        {
+            uint32_t m_Index = 0;
+            uint32_t m_Users = 0;
+        };
+
     private:
         Ref<GfxBuffer> m_VertexBuffer;
         Ref<GfxBuffer> m_IndexBuffer;
@@ -30,45 +79,139 @@ namespace Isle
         Ref<GfxBuffer> m_StaticMeshBuffer;
         Ref<GfxBuffer> m_DrawCommandBuffer;
         Ref<GfxBuffer> m_TextureBuffer;
+        Ref<GfxBuffer> m_MeshletBuffer;
+        Ref<GfxBuffer> m_VisibleDrawBuffer;
+        Ref<GfxBuffer> m_VisibleCountBuffer;
+        Ref<GfxBuffer> m_MeshLodBuffer;
+        Ref<GfxBuffer> m_SkinSourceBuffer;
+        Ref<GfxBuffer> m_SkinWeightBuffer;
+        Ref<GfxBuffer> m_BoneMatrixBuffer;
+        Ref<GfxBuffer> m_SkinnedMeshBuffer;
         Ref<GfxBuffer> m_DummyVAO;
 
         GeometryPass* m_GeometryPass;
         LightingPass* m_LightingPass;
         ShadowPass* m_ShadowPass;
+        LocalShadowPass* m_LocalShadowPass;
         VoxelPass* m_VoxelPass;
+        IndirectPass* m_IndirectPass;
         CompositePass* m_CompositePass;
         SelectionPass* m_SelectionPass;
+        CullPass* m_CullPass;
+        SkinningPass* m_SkinningPass;
         FullscreenQuad* m_FullscreenQuad;
+        TextureStreamer* m_TextureStreamer;
+
+        // Passes add themselves to the graph in this order every frame.
+        std::vector<Pass*> m_Passes;
+        RenderGraph m_RenderGraph;
+
+        // Output is what gets displayed, the scene renders at the dynamic scale of it.
+        glm::ivec2 m_OutputSize = glm::ivec2(1920, 1080);
+        glm::ivec2 m_RenderSize = glm::ivec2(1920, 1080);
+        int m_SelectedMesh = -1;
+
+        // Frames since each mesh last moved, indexed by mesh id. The version bumps whenever
+        // the set of static meshes or one of their transforms changes.
+        std::vector<uint32_t> m_MeshIdleFrames;
+        uint32_t m_DynamicMeshCount = 0;
+        uint32_t m_StaticVersion = 0;
+
+        // World bounding spheres of meshes that appeared or moved this frame, at both their
+        // old and new place. Cleared once the frame has rendered.
+        std::vector<glm::vec4> m_MovedBounds;
+
+        // Geometry is suballocated from the shared buffers, every range is owned by a mesh id.
+        // Meshes, materials and textures keep their slot until the last user lets go of it.
+        BufferAllocator m_VertexRanges;
+        BufferAllocator m_IndexRanges;
+        BufferAllocator m_MeshletRanges;
+        BufferAllocator m_LodRanges;
+        SlotAllocator m_MeshSlots;
+        SlotAllocator m_MaterialSlots;
+        SlotAllocator m_TextureSlots;
+        std::vector<BufferAllocator::Move> m_Moves;
+
+        // Skin ranges index the bind pose and influence buffers alike. Bone palettes and the
+        // dispatch list are packed again every frame from the skinned meshes' slots.
+        BufferAllocator m_SkinRanges;
+        std::vector<uint32_t> m_SkinnedMeshes;
+        std::vector<glm::mat4> m_JointMatrices;
+        uint32_t m_SkinnedMeshCount = 0;
+        uint32_t m_SkinnedVertexCount = 0;
 
-        std::unordered_map<GLuint, uint32_t> m_TextureToIndex;
-        std::unordered_map<Material*, uint32_t> m_MaterialToIndex;
+        std::vector<MeshRecord> m_MeshRecords;
+        std::unordered_map<Texture*, TextureRecord> m_TextureRecords;
+        std::unordered_map<Material*, MaterialRecord> m_MaterialRecords;
+
+    public:
+        static constexpr uint32_t STATIC_AFTER_FRAMES = 60;
+
+        float m_ShadowLodTexels = 1.0f;
+        float m_VoxelLodCells = 0.5f;
+
+        // Upper bound on what compaction moves per buffer and frame.
+        uint32_t m_DefragmentBytesPerFrame = 1 << 20;
+        DynamicResolution m_DynamicResolution;
 
     public:
         virtual void Start() override;
         virtual void Update() override;
         virtual void Destroy() override;
 
-        void Draw();
+        void Draw(bool culled = false);
+        void DrawIndirect(GfxBuffer* commandBuffer);
+        void DrawArraysIndirect(GfxBuffer* commandBuffer, size_t offset = 0);
         void DrawSelected();
 
-        void AddIndexBuffer(std::vector<unsigned int> indices);
-        void AddVertexBuffer(std::vector<GpuVertex> vertex);
         void AddStaticMesh(StaticMesh* mesh);
-        void AddMaterial(Material* material);
-        void AddMaterialTexture(Material* material, std::string name);
+
+        // Frees everything the mesh held, its draw command is replaced by the last one.
+        void RemoveStaticMesh(StaticMesh* mesh);
+        bool IsResident(const StaticMesh* mesh) const;
 
         void UpdateStaticMesh(StaticMesh* mesh);
         void UpdateMaterial(Material* material);
         void UpdateLight(Light* light);
+        void UpdateTextureHandle(Texture* texture);
 
 
         void AddLight(Light* light);
-        void AddDrawCommand(Mesh* mesh);
+        void UpdateLodDrawCommands(GfxBuffer* commandBuffer, float errorTolerance, MESH_MOBILITY mobility = MESH_MOBILITY::ANY,
+            const glm::vec4& cullSphere = glm::vec4(0.0f));
         void SetCamera(Camera* camera);
+        void SetOutputSize(glm::ivec2 size);
 
         void SelectMesh(Mesh* selectedMesh, bool state);
+        bool HasSelection() const { return m_SelectedMesh >= 0; }
+
+        bool IsMeshStatic(uint32_t id) const { return id >= m_MeshIdleFrames.size() || m_MeshIdleFrames[id] >= STATIC_AFTER_FRAMES; }
+        uint32_t GetDynamicMeshCount() const { return m_DynamicMeshCount; }
+        uint32_t GetStaticVersion() const { return m_StaticVersion; }
+        const std::vector<glm::vec4>& GetMovedBounds() const { return m_MovedBounds; }
+
+        // xyz centre, w radius. Meshes without bounds get an infinite sphere.
+        static glm::vec4 GetBoundingSphere(const GpuStaticMesh& mesh);
+        static bool SpheresOverlap(const glm::vec4& a, const glm::vec4& b) { return glm::distance(glm::vec3(a), glm::vec3(b)) <= a.w + b.w; }
 
         Ref<GfxBuffer> GetStaticMeshBuffer();
+        Ref<GfxBuffer> GetVertexBuffer() { return m_VertexBuffer; }
+        Ref<GfxBuffer> GetCameraBuffer() { return m_CameraBuffer; }
+        Ref<GfxBuffer> GetLightBuffer() { return m_LightBuffer; }
+        Ref<GfxBuffer> GetVisibleDrawBuffer() { return m_VisibleDrawBuffer; }
+        Ref<GfxBuffer> GetVisibleCountBuffer() { return m_VisibleCountBuffer; }
+        TextureStreamer* GetTextureStreamer();
+
+        CullPass* GetCullPass() { return m_CullPass; }
+        SkinningPass* GetSkinningPass() { return m_SkinningPass; }
+        ShadowPass* GetShadowPass() { return m_ShadowPass; }
+        LocalShadowPass* GetLocalShadowPass() { return m_LocalShadowPass; }
+        VoxelPass* GetVoxelPass() { return m_VoxelPass; }
+        IndirectPass* GetIndirectPass() { return m_IndirectPass; }
+        FullscreenQuad* GetFullscreenQuad() { return m_FullscreenQuad; }
+        RenderGraph& GetRenderGraph() { return m_RenderGraph; }
+        glm::ivec2 GetRenderSize() const { return m_RenderSize; }
+        glm::ivec2 GetOutputSize() const { return m_OutputSize; }
 
         int GetNumVertices();
         int GetNumIndicies();
@@ -76,9 +219,31 @@ namespace Isle
         int GetNumLights();
         int GetNumTextures();
         int GetNumStaticMeshes();
+        int GetNumMeshlets();
+        int GetNumMeshLods();
+
+        // What this frame's skinning dispatch covers.
+        uint32_t GetSkinnedMeshCount() const { return m_SkinnedMeshCount; }
+        uint32_t GetSkinnedVertexCount() const { return m_SkinnedVertexCount; }
 
 
         void Clear();
         Ref<Texture> GetFinalOutput();
+
+    private:
+        void AddMeshLods(StaticMesh* mesh, const MeshRecord& record, uint32_t meshIndex);
+        void AddMeshlets(const std::vector<GpuMeshlet>& meshlets, uint32_t offset, uint32_t firstIndex, uint32_t baseVertex, uint32_t meshIndex);
+
+        uint32_t AcquireMaterial(Material* material);
+        void ReleaseMaterial(Material* material);
+        void AcquireTextures(Material* material, MaterialRecord& record);
+        void AcquireTexture(Texture* texture);
+        void ReleaseTexture(Texture* texture);
+
+        // Poses every skinned mesh and moves its bounds along, before anything is uploaded.
+        void UpdateSkinning();
+
+        // Slides ranges down into the holes removal left behind, a budget's worth per frame.
+        void Defragment();
     };
 }
\ No newline at end of file
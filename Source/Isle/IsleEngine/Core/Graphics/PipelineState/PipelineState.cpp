@@ -1,4 +1,5 @@
 #include "PipelineState.h"
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
 
 namespace Isle
 {
@@ -49,53 +50,26 @@ namespace Isle
 
 	void PipelineState::Bind()
 	{
-		if (m_DepthTest)
-			glEnable(GL_DEPTH_TEST);
-		else
-			glDisable(GL_DEPTH_TEST);
+		GfxDevice* device = GfxDevice::Get();
 
-		glDepthMask(m_DepthWrite ? GL_TRUE : GL_FALSE);
-		glDepthFunc(ToGL(m_DepthFunc));
+		device->SetCapability(GL_DEPTH_TEST, m_DepthTest);
+		device->SetDepthState(m_DepthWrite, ToGL(m_DepthFunc));
 
+		device->SetCapability(GL_BLEND, m_BlendEnabled);
 		if (m_BlendEnabled)
 		{
-			glEnable(GL_BLEND);
-
 			if (m_UseSeparateAlphaBlend)
-			{
-				glBlendFuncSeparate(
-					ToGL(m_BlendSrc),
-					ToGL(m_BlendDst),
-					ToGL(m_BlendAlphaSrc),
-					ToGL(m_BlendAlphaDst)
-				);
-			}
+				device->SetBlendFunc(ToGL(m_BlendSrc), ToGL(m_BlendDst), ToGL(m_BlendAlphaSrc), ToGL(m_BlendAlphaDst));
 			else
-			{
-				glBlendFunc(ToGL(m_BlendSrc), ToGL(m_BlendDst));
-			}
-		}
-		else
-		{
-			glDisable(GL_BLEND);
+				device->SetBlendFunc(ToGL(m_BlendSrc), ToGL(m_BlendDst), ToGL(m_BlendSrc), ToGL(m_BlendDst));
 		}
 
-		if (m_CullEnabled && m_CullFace != CULL_MODE::NONE)
-		{
-			glEnable(GL_CULL_FACE);
-			glCullFace(ToGL(m_CullFace));
-		}
-		else
-		{
-			glDisable(GL_CULL_FACE);
-		}
+		const bool cull = m_CullEnabled && m_CullFace != CULL_MODE::NONE;
+		device->SetCapability(GL_CULL_FACE, cull);
+		if (cull)
+			device->SetCullFace(ToGL(m_CullFace));
 
-		glColorMask(
-			m_ColorMaskR ? GL_TRUE : GL_FALSE,
-			m_ColorMaskG ? GL_TRUE : GL_FALSE,
-			m_ColorMaskB ? GL_TRUE : GL_FALSE,
-			m_ColorMaskA ? GL_TRUE : GL_FALSE
-		);
+		device->SetColorMask(m_ColorMaskR, m_ColorMaskG, m_ColorMaskB, m_ColorMaskA);
 	}
 
 
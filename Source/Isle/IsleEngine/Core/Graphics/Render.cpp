@@ -5,7 +5,8 @@ namespace Isle
     void Render::Start(Window* window)
     {
         m_Window = window;
-        glfwSwapInterval(0);
+        if (window)
+            glfwSwapInterval(0);
 
         m_Pipeline = new Pipeline();
         m_Pipeline->Start();
@@ -33,8 +34,8 @@ namespace Isle
         const float default_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
         const float* color = clear_color ? clear_color : default_color;
 
-        glClearColor(color[0], color[1], color[2], color[3]);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        GfxDevice::Get()->Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT,
+            glm::vec4(color[0], color[1], color[2], color[3]));
 
         m_Stats.ResetPerFrame();
     }
@@ -44,6 +45,7 @@ namespace Isle
         if (!m_Pipeline)
             return;
 
+        ISLE_PROFILE_SCOPE("Render");
         auto renderStart = std::chrono::high_resolution_clock::now();
 
         m_Pipeline->Update();
@@ -55,9 +57,34 @@ namespace Isle
         m_Stats.MaterialCount = m_Pipeline->GetNumMaterials();
         m_Stats.TextureCount = m_Pipeline->GetNumTextures();
 
+        GfxResourceTracker::EndFrame();
+        m_Stats.ResetPerFrame();
+        m_Stats.TextureMemoryGPU = 0;
+        for (int i = 0; i < static_cast<int>(GFX_RESOURCE_CATEGORY::COUNT); i++)
+        {
+            const GFX_RESOURCE_CATEGORY category = static_cast<GFX_RESOURCE_CATEGORY>(i);
+            const GfxCategoryStats stats = GfxResourceTracker::GetCategoryStats(category);
+
+            if (category == GFX_RESOURCE_CATEGORY::BUFFER)
+            {
+                m_Stats.BufferMemoryGPU = stats.m_Bytes;
+                m_Stats.DirtyBufferCount = stats.m_Uploads;
+            }
+            else
+            {
+                m_Stats.TextureMemoryGPU += stats.m_Bytes;
+            }
+
+            m_Stats.UploadsThisFrame += stats.m_Uploads;
+            m_Stats.UploadBytesThisFrame += stats.m_UploadBytes;
+        }
+        m_Stats.VRAMUsed = GfxResourceTracker::GetTotalBytes();
+        m_Stats.VRAMPeak = GfxResourceTracker::GetPeakBytes();
+
         auto renderEnd = std::chrono::high_resolution_clock::now();
         m_Stats.RenderTimeCPU =
             std::chrono::duration<double, std::milli>(renderEnd - renderStart).count();
+        m_Stats.RenderTimeGPU = Profiler::GetLatestGpuMs();
 
         m_Stats.RenderFrameCount++;
         m_LastFrameTime = renderEnd;
@@ -71,7 +98,7 @@ namespace Isle
 
     void Render::Reset()
     {
-        glFinish();
+        GfxDevice::Get()->Finish();
 
         if (m_Pipeline)
         {
@@ -18,10 +18,12 @@ namespace Isle
         uint32_t TextureCount = 0;
 
         uint64_t VRAMUsed = 0;
+        uint64_t VRAMPeak = 0;
         uint64_t BufferMemoryGPU = 0;
         uint64_t TextureMemoryGPU = 0;
 
         uint32_t UploadsThisFrame = 0;
+        uint64_t UploadBytesThisFrame = 0;
         uint32_t DirtyBufferCount = 0;
         uint64_t RenderFrameCount = 0;
 
@@ -30,6 +32,7 @@ namespace Isle
         void ResetPerFrame()
         {
             UploadsThisFrame = 0;
+            UploadBytesThisFrame = 0;
             DirtyBufferCount = 0;
             RenderTimeGPU = 0.0;
         }
@@ -0,0 +1,685 @@
+// RenderGraph.cpp
+#include "RenderGraph.h"
+#include <Core/Graphics/Passes/Pass.h>
+#include <Core/Graphics/Shader/Shader.h>
+#include <Core/Graphics/GfxResource/GfxResourceTracker.h>
+
+namespace Isle
+{
+    RenderGraphHandle RenderGraphBuilder::CreateTexture(const char* name, const RenderGraphTextureDesc& desc)
+    {
+        RenderGraphResource resource;
+        resource.m_Name = name;
+        resource.m_Type = RG_RESOURCE_TYPE::TEXTURE;
+        resource.m_Desc = desc;
+        return m_Graph->AddResource(resource);
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::Sample(RenderGraphHandle resource, const char* uniform)
+    {
+        RenderGraphAccess access;
+        access.m_Resource = resource;
+        access.m_Access = RG_ACCESS::SAMPLED;
+        access.m_Uniform = uniform;
+        return AddAccess(access);
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::Read(RenderGraphHandle resource, RG_ACCESS access)
+    {
+        RenderGraphAccess read;
+        read.m_Resource = resource;
+        read.m_Access = access;
+        return AddAccess(read);
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::Write(RenderGraphHandle resource, RG_ACCESS access)
+    {
+        RenderGraphAccess write;
+        write.m_Resource = resource;
+        write.m_Access = access;
+        write.m_Write = true;
+        return AddAccess(write);
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::WriteAttachment(RenderGraphHandle resource, ATTACHMENT_TYPE type)
+    {
+        RenderGraphAccess write;
+        write.m_Resource = resource;
+        write.m_Access = RG_ACCESS::ATTACHMENT;
+        write.m_Write = true;
+        write.m_Attachment = type;
+        return AddAccess(write);
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::SetClearColor(const glm::vec4& color)
+    {
+        m_Graph->m_Passes[m_Pass].m_ClearColor = color;
+        return *this;
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::SetSideEffects()
+    {
+        m_Graph->m_Passes[m_Pass].m_SideEffects = true;
+        return *this;
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::KeepContents()
+    {
+        m_Graph->m_Passes[m_Pass].m_KeepContents = true;
+        return *this;
+    }
+
+    RenderGraphBuilder& RenderGraphBuilder::AddAccess(const RenderGraphAccess& access)
+    {
+        RenderGraphPass& pass = m_Graph->m_Passes[m_Pass];
+
+        if (access.m_Resource == RENDER_GRAPH_NONE)
+        {
+            // Only a sampled input has something to bind in place of a missing resource.
+            if (access.m_Uniform)
+                pass.m_Accesses.push_back(access);
+            return *this;
+        }
+
+        RenderGraphResource& resource = m_Graph->m_Resources[access.m_Resource];
+        if (access.m_Write)
+        {
+            if (std::find(resource.m_Writers.begin(), resource.m_Writers.end(), m_Pass) == resource.m_Writers.end())
+            {
+                resource.m_Writers.push_back(m_Pass);
+                pass.m_RefCount++;
+            }
+        }
+        else
+        {
+            resource.m_Readers++;
+        }
+
+        pass.m_Accesses.push_back(access);
+        return *this;
+    }
+
+    Ref<Texture> RenderGraphContext::GetTexture(RenderGraphHandle resource)
+    {
+        if (resource >= m_Graph->m_Resources.size())
+            return nullptr;
+        return m_Graph->m_Resources[resource].m_Texture;
+    }
+
+    void RenderGraphContext::BindInputs(Shader* shader)
+    {
+        if (!shader)
+            return;
+
+        GfxDevice* device = GfxDevice::Get();
+        uint32_t unit = RenderGraph::FIRST_TEXTURE_UNIT;
+
+        for (const RenderGraphAccess& access : m_Pass->m_Accesses)
+        {
+            if (access.m_Access != RG_ACCESS::SAMPLED || !access.m_Uniform)
+                continue;
+
+            if (access.m_Resource == RENDER_GRAPH_NONE)
+            {
+                if (!m_Graph->m_BlackTexture)
+                {
+                    const uint8_t black[4] = { 0, 0, 0, 0 };
+                    m_Graph->m_BlackTexture = New<Texture>();
+                    m_Graph->m_BlackTexture->Create(1, 1, TEXTURE_FORMAT::RGBA8, black);
+                    m_Graph->m_BlackTexture->SetDebugLabel("RenderGraph/Black");
+                }
+                m_Graph->m_BlackTexture->Bind(unit);
+            }
+            else
+            {
+                const RenderGraphResource& resource = m_Graph->m_Resources[access.m_Resource];
+                if (resource.m_Type == RG_RESOURCE_TYPE::TEXTURE3D)
+                    device->BindTexture(unit, GL_TEXTURE_3D, resource.m_Texture3D ? resource.m_Texture3D->m_Id : 0);
+                else if (resource.m_Texture)
+                    resource.m_Texture->Bind(unit);
+            }
+
+            shader->SetInt(access.m_Uniform, static_cast<int>(unit));
+            unit++;
+        }
+    }
+
+    void RenderGraph::Reset()
+    {
+        // Backwards, so the first pass declared next frame gets the list the first one used.
+        for (auto it = m_Passes.rbegin(); it != m_Passes.rend(); ++it)
+        {
+            it->m_Accesses.clear();
+            m_SpareAccesses.push_back(std::move(it->m_Accesses));
+        }
+
+        for (auto it = m_Resources.rbegin(); it != m_Resources.rend(); ++it)
+        {
+            it->m_Writers.clear();
+            m_SpareWriters.push_back(std::move(it->m_Writers));
+        }
+
+        m_Passes.clear();
+        m_Resources.clear();
+        m_Frame++;
+    }
+
+    RenderGraphBuilder RenderGraph::AddPass(const char* name, Pass* owner, RenderGraphExecute execute)
+    {
+        RenderGraphPass pass;
+        pass.m_Name = name;
+        pass.m_Owner = owner;
+        pass.m_Execute = std::move(execute);
+        if (!m_SpareAccesses.empty())
+        {
+            pass.m_Accesses = std::move(m_SpareAccesses.back());
+            m_SpareAccesses.pop_back();
+        }
+        else
+        {
+            pass.m_Accesses.reserve(RESERVED_ACCESSES);
+        }
+        m_Passes.push_back(std::move(pass));
+
+        return RenderGraphBuilder(this, static_cast<uint32_t>(m_Passes.size() - 1));
+    }
+
+    RenderGraphHandle RenderGraph::ImportTexture(const char* name, Ref<Texture> texture)
+    {
+        if (!texture)
+            return RENDER_GRAPH_NONE;
+
+        RenderGraphResource resource;
+        resource.m_Name = name;
+        resource.m_Type = RG_RESOURCE_TYPE::TEXTURE;
+        resource.m_Desc = { texture->m_Width, texture->m_Height, texture->m_Format };
+        resource.m_Imported = true;
+        resource.m_Texture = texture;
+        return AddResource(resource);
+    }
+
+    RenderGraphHandle RenderGraph::ImportTexture3D(const char* name, Texture3D* texture)
+    {
+        if (!texture)
+            return RENDER_GRAPH_NONE;
+
+        RenderGraphResource resource;
+        resource.m_Name = name;
+        resource.m_Type = RG_RESOURCE_TYPE::TEXTURE3D;
+        resource.m_Imported = true;
+        resource.m_Texture3D = texture;
+        return AddResource(resource);
+    }
+
+    RenderGraphHandle RenderGraph::ImportBuffer(const char* name, GfxBuffer* buffer)
+    {
+        if (!buffer)
+            return RENDER_GRAPH_NONE;
+
+        RenderGraphResource resource;
+        resource.m_Name = name;
+        resource.m_Type = RG_RESOURCE_TYPE::BUFFER;
+        resource.m_Imported = true;
+        resource.m_Buffer = buffer;
+        return AddResource(resource);
+    }
+
+    RenderGraphHandle RenderGraph::Find(const char* name) const
+    {
+        for (size_t i = 0; i < m_Resources.size(); i++)
+        {
+            if (std::strcmp(m_Resources[i].m_Name, name) == 0)
+                return static_cast<RenderGraphHandle>(i);
+        }
+        return RENDER_GRAPH_NONE;
+    }
+
+    RenderGraphHandle RenderGraph::AddResource(const RenderGraphResource& resource)
+    {
+        m_Resources.push_back(resource);
+        RenderGraphResource& added = m_Resources.back();
+        if (!m_SpareWriters.empty())
+        {
+            added.m_Writers = std::move(m_SpareWriters.back());
+            m_SpareWriters.pop_back();
+        }
+        else
+        {
+            added.m_Writers.reserve(RESERVED_WRITERS);
+        }
+
+        if (added.m_Imported)
+        {
+            auto it = m_PendingWrites.find(GetResourceKey(added));
+            if (it != m_PendingWrites.end())
+            {
+                added.m_Dirty = true;
+                added.m_Visible = it->second;
+            }
+        }
+
+        return static_cast<RenderGraphHandle>(m_Resources.size() - 1);
+    }
+
+    void RenderGraph::Compile()
+    {
+        m_Stats = RenderGraphStats();
+
+        CullPasses();
+        AllocateTransients();
+        ComputeBarriers();
+        ResolveFrameBuffers();
+        EvictUnused();
+    }
+
+    void RenderGraph::CullPasses()
+    {
+        std::vector<RenderGraphHandle> unread;
+
+        auto cull = [&](RenderGraphPass& pass)
+            {
+                pass.m_Culled = true;
+                for (const RenderGraphAccess& access : pass.m_Accesses)
+                {
+                    if (access.m_Write || access.m_Resource == RENDER_GRAPH_NONE)
+                        continue;
+
+                    RenderGraphResource& resource = m_Resources[access.m_Resource];
+                    if (--resource.m_Readers == 0 && !resource.m_Imported)
+                        unread.push_back(access.m_Resource);
+                }
+            };
+
+        for (RenderGraphPass& pass : m_Passes)
+        {
+            if (pass.m_RefCount == 0 && !pass.m_SideEffects)
+                cull(pass);
+        }
+
+        for (size_t i = 0; i < m_Resources.size(); i++)
+        {
+            if (m_Resources[i].m_Readers == 0 && !m_Resources[i].m_Imported)
+                unread.push_back(static_cast<RenderGraphHandle>(i));
+        }
+
+        // Imported resources are never pushed, so a pass writing one keeps a reference forever.
+        while (!unread.empty())
+        {
+            const RenderGraphHandle handle = unread.back();
+            unread.pop_back();
+
+            for (uint32_t writer : m_Resources[handle].m_Writers)
+            {
+                RenderGraphPass& pass = m_Passes[writer];
+                if (pass.m_Culled || pass.m_SideEffects)
+                    continue;
+
+                if (--pass.m_RefCount == 0)
+                    cull(pass);
+            }
+        }
+
+        for (const RenderGraphPass& pass : m_Passes)
+        {
+            if (pass.m_Culled)
+                m_Stats.m_CulledPasses++;
+            else
+                m_Stats.m_Passes++;
+        }
+    }
+
+    void RenderGraph::AllocateTransients()
+    {
+        for (PooledTexture& pooled : m_Pool)
+            pooled.m_InUse = false;
+
+        for (int i = 0; i < static_cast<int>(m_Passes.size()); i++)
+        {
+            if (m_Passes[i].m_Culled)
+                continue;
+
+            for (const RenderGraphAccess& access : m_Passes[i].m_Accesses)
+            {
+                if (access.m_Resource == RENDER_GRAPH_NONE)
+                    continue;
+
+                RenderGraphResource& resource = m_Resources[access.m_Resource];
+                if (resource.m_FirstPass < 0)
+                    resource.m_FirstPass = i;
+                resource.m_LastPass = i;
+            }
+        }
+
+        // Textures go back to the pool after their last reader, so a transient first used by a
+        // later pass can alias one that is already dead.
+        for (int i = 0; i < static_cast<int>(m_Passes.size()); i++)
+        {
+            if (m_Passes[i].m_Culled)
+                continue;
+
+            for (const RenderGraphAccess& access : m_Passes[i].m_Accesses)
+            {
+                if (access.m_Resource == RENDER_GRAPH_NONE)
+                    continue;
+
+                RenderGraphResource& resource = m_Resources[access.m_Resource];
+                if (resource.m_Imported || resource.m_Type != RG_RESOURCE_TYPE::TEXTURE || resource.m_Texture)
+                    continue;
+
+                resource.m_Texture = AcquireTexture(resource.m_Desc, resource.m_Name);
+                m_Stats.m_RequestedBytes += Texture::CalculateTextureSize(resource.m_Desc.m_Width, resource.m_Desc.m_Height, resource.m_Desc.m_Format);
+            }
+
+            for (RenderGraphResource& resource : m_Resources)
+            {
+                if (!resource.m_Imported && resource.m_Texture && resource.m_LastPass == i)
+                    ReleaseTexture(resource.m_Texture);
+            }
+        }
+
+        for (const PooledTexture& pooled : m_Pool)
+        {
+            if (pooled.m_LastFrame == m_Frame)
+                m_Stats.m_TransientTextures++;
+            m_Stats.m_AllocatedBytes += Texture::CalculateTextureSize(pooled.m_Desc.m_Width, pooled.m_Desc.m_Height, pooled.m_Desc.m_Format);
+        }
+    }
+
+    Ref<Texture> RenderGraph::AcquireTexture(const RenderGraphTextureDesc& desc, const char* name)
+    {
+        for (PooledTexture& pooled : m_Pool)
+        {
+            if (!pooled.m_InUse && pooled.m_Desc == desc)
+            {
+                pooled.m_InUse = true;
+                pooled.m_LastFrame = m_Frame;
+                return pooled.m_Texture;
+            }
+        }
+
+        PooledTexture pooled;
+        pooled.m_Texture = New<Texture>(desc.m_Width, desc.m_Height, desc.m_Format);
+        pooled.m_Texture->SetDebugLabel(std::string("RenderGraph/") + name);
+        pooled.m_Texture->SetWrapS(TEXTURE_WRAP::CLAMP_TO_EDGE);
+        pooled.m_Texture->SetWrapT(TEXTURE_WRAP::CLAMP_TO_EDGE);
+        GfxResourceTracker::SetCategory(pooled.m_Texture.Get(), GFX_RESOURCE_CATEGORY::FRAMEBUFFER);
+        pooled.m_Desc = desc;
+        pooled.m_InUse = true;
+        pooled.m_LastFrame = m_Frame;
+        m_Pool.push_back(pooled);
+
+        return pooled.m_Texture;
+    }
+
+    void RenderGraph::ReleaseTexture(const Ref<Texture>& texture)
+    {
+        for (PooledTexture& pooled : m_Pool)
+        {
+            if (pooled.m_Texture == texture)
+            {
+                pooled.m_InUse = false;
+                return;
+            }
+        }
+    }
+
+    void RenderGraph::ComputeBarriers()
+    {
+        for (RenderGraphPass& pass : m_Passes)
+        {
+            if (pass.m_Culled)
+                continue;
+
+            GLbitfield barriers = 0;
+            for (const RenderGraphAccess& access : pass.m_Accesses)
+            {
+                if (access.m_Resource == RENDER_GRAPH_NONE)
+                    continue;
+
+                const RenderGraphResource& resource = m_Resources[access.m_Resource];
+                const GLbitfield bit = GetBarrierBit(access.m_Access);
+                if (resource.m_Dirty && !(resource.m_Visible & bit))
+                    barriers |= bit;
+            }
+
+            // A barrier flushes every earlier incoherent write for the access types it names.
+            if (barriers)
+            {
+                for (RenderGraphResource& resource : m_Resources)
+                {
+                    if (resource.m_Dirty)
+                        resource.m_Visible |= barriers;
+                }
+                m_Stats.m_Barriers++;
+            }
+            pass.m_Barriers = barriers;
+
+            for (const RenderGraphAccess& access : pass.m_Accesses)
+            {
+                if (!access.m_Write || access.m_Resource == RENDER_GRAPH_NONE)
+                    continue;
+
+                RenderGraphResource& resource = m_Resources[access.m_Resource];
+                if (access.m_Access == RG_ACCESS::IMAGE || access.m_Access == RG_ACCESS::STORAGE)
+                {
+                    resource.m_Dirty = true;
+                    resource.m_Visible = 0;
+                }
+                else
+                {
+                    resource.m_Dirty = false;
+                }
+            }
+        }
+
+        for (const RenderGraphResource& resource : m_Resources)
+        {
+            if (!resource.m_Imported)
+                continue;
+
+            const uint64_t key = GetResourceKey(resource);
+            if (resource.m_Dirty)
+                m_PendingWrites[key] = resource.m_Visible;
+            else
+                m_PendingWrites.erase(key);
+        }
+    }
+
+    void RenderGraph::ResolveFrameBuffers()
+    {
+        GfxDevice* device = GfxDevice::Get();
+
+        for (RenderGraphPass& pass : m_Passes)
+        {
+            pass.m_FrameBuffer = nullptr;
+            if (pass.m_Culled)
+                continue;
+
+            std::vector<GLuint>& key = m_FrameBufferKey;
+            key.clear();
+            Ref<Texture> first;
+            for (const RenderGraphAccess& access : pass.m_Accesses)
+            {
+                if (access.m_Access != RG_ACCESS::ATTACHMENT || access.m_Resource == RENDER_GRAPH_NONE)
+                    continue;
+
+                const Ref<Texture>& texture = m_Resources[access.m_Resource].m_Texture;
+                if (!texture)
+                    continue;
+
+                key.push_back(static_cast<GLuint>(access.m_Attachment));
+                key.push_back(texture->m_Id);
+                if (!first)
+                    first = texture;
+            }
+
+            if (key.empty())
+                continue;
+
+            auto it = std::find_if(m_FrameBuffers.begin(), m_FrameBuffers.end(),
+                [&](const CachedFrameBuffer& cached) { return cached.m_Key == key; });
+
+            // Imported textures can be resized in place, same names but a stale viewport.
+            if (it != m_FrameBuffers.end() &&
+                (it->m_FrameBuffer->m_Width != first->m_Width || it->m_FrameBuffer->m_Height != first->m_Height))
+            {
+                m_FrameBuffers.erase(it);
+                it = m_FrameBuffers.end();
+            }
+
+            if (it == m_FrameBuffers.end())
+            {
+                Ref<FrameBuffer> frameBuffer = New<FrameBuffer>(first->m_Width, first->m_Height);
+                std::vector<ATTACHMENT_TYPE> colorTargets;
+
+                for (const RenderGraphAccess& access : pass.m_Accesses)
+                {
+                    if (access.m_Access != RG_ACCESS::ATTACHMENT || access.m_Resource == RENDER_GRAPH_NONE)
+                        continue;
+
+                    Ref<Texture> texture = m_Resources[access.m_Resource].m_Texture;
+                    switch (access.m_Attachment)
+                    {
+                    case ATTACHMENT_TYPE::DEPTH:
+                    case ATTACHMENT_TYPE::SHADOW_MAP:
+                        frameBuffer->AttachDepthTexture(texture);
+                        break;
+                    case ATTACHMENT_TYPE::DEPTH_STENCIL:
+                        frameBuffer->AttachDepthStencilTexture(texture);
+                        break;
+                    default:
+                        frameBuffer->AttachTexture(access.m_Attachment, texture, static_cast<int>(colorTargets.size()));
+                        colorTargets.push_back(access.m_Attachment);
+                        break;
+                    }
+                }
+
+                frameBuffer->SetDrawBuffers(colorTargets);
+                if (colorTargets.empty())
+                    device->SetReadBuffer(frameBuffer->m_Id, GL_NONE);
+
+                GfxResourceTracker::SetLabel(frameBuffer.Get(), pass.m_Name);
+                device->SetObjectLabel(GL_FRAMEBUFFER, frameBuffer->m_Id, pass.m_Name);
+
+                if (!frameBuffer->CheckStatus())
+                {
+                    ISLE_ERROR("RenderGraph: %s framebuffer incomplete!\n", pass.m_Name);
+                }
+
+                m_FrameBuffers.push_back({ key, frameBuffer, m_Frame });
+                it = m_FrameBuffers.end() - 1;
+            }
+
+            it->m_LastFrame = m_Frame;
+            pass.m_FrameBuffer = it->m_FrameBuffer.Get();
+        }
+    }
+
+    void RenderGraph::EvictUnused()
+    {
+        std::vector<GLuint> evicted;
+        for (auto it = m_Pool.begin(); it != m_Pool.end();)
+        {
+            if (m_Frame - it->m_LastFrame > POOL_EVICT_FRAMES)
+            {
+                evicted.push_back(it->m_Texture->m_Id);
+                it = m_Pool.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Drop framebuffers that are idle or still point at an evicted texture, its name may be reused.
+        std::erase_if(m_FrameBuffers, [&](const CachedFrameBuffer& cached)
+            {
+                if (m_Frame - cached.m_LastFrame > POOL_EVICT_FRAMES)
+                    return true;
+
+                for (size_t i = 1; i < cached.m_Key.size(); i += 2)
+                {
+                    if (std::find(evicted.begin(), evicted.end(), cached.m_Key[i]) != evicted.end())
+                        return true;
+                }
+                return false;
+            });
+    }
+
+    void RenderGraph::Execute()
+    {
+        GfxDevice* device = GfxDevice::Get();
+
+        for (RenderGraphPass& pass : m_Passes)
+        {
+            if (pass.m_Culled)
+                continue;
+
+            ISLE_PROFILE_GPU_SCOPE(pass.m_Name);
+
+            if (pass.m_Barriers)
+                device->Barrier(pass.m_Barriers);
+
+            if (pass.m_FrameBuffer)
+                pass.m_FrameBuffer->Bind();
+
+            // The pass state goes first, a depth clear needs depth writes enabled.
+            if (pass.m_Owner)
+                pass.m_Owner->Bind();
+
+            if (pass.m_FrameBuffer && !pass.m_KeepContents)
+                pass.m_FrameBuffer->Clear(pass.m_ClearColor);
+
+            RenderGraphContext context(this, &pass);
+            if (pass.m_Owner)
+                context.BindInputs(pass.m_Owner->GetShader().Get());
+
+            if (pass.m_Execute)
+                pass.m_Execute(context);
+
+            if (pass.m_Owner)
+                pass.m_Owner->Unbind();
+
+            if (pass.m_FrameBuffer)
+                pass.m_FrameBuffer->Unbind();
+        }
+    }
+
+    void RenderGraph::Destroy()
+    {
+        m_Passes.clear();
+        m_Resources.clear();
+        m_SpareAccesses.clear();
+        m_SpareWriters.clear();
+        m_FrameBuffers.clear();
+        m_Pool.clear();
+        m_PendingWrites.clear();
+        m_BlackTexture = nullptr;
+    }
+
+    GLbitfield RenderGraph::GetBarrierBit(RG_ACCESS access)
+    {
+        switch (access)
+        {
+        case RG_ACCESS::SAMPLED:    return GL_TEXTURE_FETCH_BARRIER_BIT;
+        case RG_ACCESS::IMAGE:      return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        case RG_ACCESS::STORAGE:    return GL_SHADER_STORAGE_BARRIER_BIT;
+        case RG_ACCESS::INDIRECT:   return GL_COMMAND_BARRIER_BIT;
+        case RG_ACCESS::TRANSFER:   return GL_TEXTURE_UPDATE_BARRIER_BIT;
+        case RG_ACCESS::ATTACHMENT: return GL_FRAMEBUFFER_BARRIER_BIT;
+        default:                    return 0;
+        }
+    }
+
+    uint64_t RenderGraph::GetResourceKey(const RenderGraphResource& resource)
+    {
+        GLuint id = 0;
+        switch (resource.m_Type)
+        {
+        case RG_RESOURCE_TYPE::TEXTURE:   id = resource.m_Texture ? resource.m_Texture->m_Id : 0; break;
+        case RG_RESOURCE_TYPE::TEXTURE3D: id = resource.m_Texture3D ? resource.m_Texture3D->m_Id : 0; break;
+        case RG_RESOURCE_TYPE::BUFFER:    id = resource.m_Buffer ? resource.m_Buffer->GetId() : 0; break;
+        }
+        return (static_cast<uint64_t>(resource.m_Type) << 32) | id;
+    }
+}
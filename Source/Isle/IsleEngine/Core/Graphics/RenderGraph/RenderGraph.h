@@ -0,0 +1,242 @@
+// RenderGraph.h
+#pragma once
+#include <Core/Common/Common.h>
+#include <Core/Graphics/Texture/Texture.h>
+#include <Core/Graphics/Texture3D/Texture3D.h>
+#include <Core/Graphics/GfxBuffer/GfxBuffer.h>
+#include <Core/Graphics/FrameBuffer/FrameBuffer.h>
+
+namespace Isle
+{
+    class Pass;
+    class Shader;
+    class RenderGraph;
+
+    using RenderGraphHandle = uint32_t;
+    constexpr RenderGraphHandle RENDER_GRAPH_NONE = UINT32_MAX;
+
+    enum class RG_ACCESS
+    {
+        SAMPLED,    // texture fetch through a sampler
+        IMAGE,      // image load/store
+        STORAGE,    // shader storage buffer
+        INDIRECT,   // draw or dispatch arguments
+        TRANSFER,   // texture copy source or destination
+        ATTACHMENT  // framebuffer attachment
+    };
+
+    enum class RG_RESOURCE_TYPE
+    {
+        TEXTURE,
+        TEXTURE3D,
+        BUFFER
+    };
+
+    struct RenderGraphTextureDesc
+    {
+        int m_Width = 0;
+        int m_Height = 0;
+        TEXTURE_FORMAT m_Format = TEXTURE_FORMAT::RGBA16F;
+
+        bool operator==(const RenderGraphTextureDesc& other) const
+        {
+            return m_Width == other.m_Width && m_Height == other.m_Height && m_Format == other.m_Format;
+        }
+    };
+
+    struct RenderGraphResource
+    {
+        const char* m_Name = nullptr;
+        RG_RESOURCE_TYPE m_Type = RG_RESOURCE_TYPE::TEXTURE;
+        RenderGraphTextureDesc m_Desc;
+        bool m_Imported = false;
+
+        Ref<Texture> m_Texture;
+        Texture3D* m_Texture3D = nullptr;
+        GfxBuffer* m_Buffer = nullptr;
+
+        std::vector<uint32_t> m_Writers;
+        uint32_t m_Readers = 0;
+        int m_FirstPass = -1;
+        int m_LastPass = -1;
+
+        // Set by image and storage writes, which GL does not make visible on its own.
+        bool m_Dirty = false;
+        GLbitfield m_Visible = 0;
+    };
+
+    struct RenderGraphAccess
+    {
+        RenderGraphHandle m_Resource = RENDER_GRAPH_NONE;
+        RG_ACCESS m_Access = RG_ACCESS::SAMPLED;
+        bool m_Write = false;
+        ATTACHMENT_TYPE m_Attachment = ATTACHMENT_TYPE::NONE;
+        const char* m_Uniform = nullptr;
+    };
+
+    class RenderGraphContext;
+
+    // Passes are declared every frame, a capture larger than std::function's inline storage
+    // (two pointers with libstdc++) allocates each time. Keep per frame values on the pass.
+    using RenderGraphExecute = std::function<void(RenderGraphContext&)>;
+
+    struct RenderGraphPass
+    {
+        const char* m_Name = nullptr;
+        Pass* m_Owner = nullptr;
+        RenderGraphExecute m_Execute;
+        std::vector<RenderGraphAccess> m_Accesses;
+
+        bool m_SideEffects = false;
+        bool m_KeepContents = false;
+        glm::vec4 m_ClearColor = glm::vec4(0.0f);
+
+        bool m_Culled = false;
+        uint32_t m_RefCount = 0;
+        GLbitfield m_Barriers = 0;
+        FrameBuffer* m_FrameBuffer = nullptr;
+    };
+
+    struct RenderGraphStats
+    {
+        uint32_t m_Passes = 0;
+        uint32_t m_CulledPasses = 0;
+        uint32_t m_Barriers = 0;
+        uint32_t m_TransientTextures = 0;
+
+        // Bytes the transients would take with a texture each, and what the pool actually holds.
+        size_t m_RequestedBytes = 0;
+        size_t m_AllocatedBytes = 0;
+    };
+
+    // Declares what a pass reads and writes. Handles of RENDER_GRAPH_NONE are ignored, a sampled
+    // input with a uniform still binds a black texture so the shader never reads a stale unit.
+    class ISLEENGINE_API RenderGraphBuilder
+    {
+    private:
+        RenderGraph* m_Graph;
+        uint32_t m_Pass;
+
+    public:
+        RenderGraphBuilder(RenderGraph* graph, uint32_t pass) : m_Graph(graph), m_Pass(pass) {}
+
+        RenderGraphHandle CreateTexture(const char* name, const RenderGraphTextureDesc& desc);
+
+        RenderGraphBuilder& Sample(RenderGraphHandle resource, const char* uniform);
+        RenderGraphBuilder& Read(RenderGraphHandle resource, RG_ACCESS access);
+        RenderGraphBuilder& Write(RenderGraphHandle resource, RG_ACCESS access);
+        RenderGraphBuilder& WriteAttachment(RenderGraphHandle resource, ATTACHMENT_TYPE type);
+
+        RenderGraphBuilder& SetClearColor(const glm::vec4& color);
+        RenderGraphBuilder& SetSideEffects();
+
+        // Attachments are not cleared before the pass, for targets the pass only partly redraws.
+        RenderGraphBuilder& KeepContents();
+
+    private:
+        RenderGraphBuilder& AddAccess(const RenderGraphAccess& access);
+    };
+
+    class ISLEENGINE_API RenderGraphContext
+    {
+    private:
+        RenderGraph* m_Graph;
+        const RenderGraphPass* m_Pass;
+
+    public:
+        RenderGraphContext(RenderGraph* graph, const RenderGraphPass* pass) : m_Graph(graph), m_Pass(pass) {}
+
+        Ref<Texture> GetTexture(RenderGraphHandle resource);
+        FrameBuffer* GetFrameBuffer() { return m_Pass->m_FrameBuffer; }
+
+        // Binds every sampled input from unit 7 up and points its uniform at it.
+        void BindInputs(Shader* shader);
+    };
+
+    // Passes are declared every frame in execution order. Compile culls passes whose outputs
+    // nobody reads, hands transient textures out of a pool so textures with disjoint lifetimes
+    // share storage, and works out the glMemoryBarrier bits each pass needs before it runs.
+    // Passes that write imported resources are always kept, their results outlive the frame.
+    class ISLEENGINE_API RenderGraph
+    {
+        friend class RenderGraphBuilder;
+        friend class RenderGraphContext;
+
+    public:
+        static constexpr uint32_t FIRST_TEXTURE_UNIT = 7;
+        static constexpr uint32_t POOL_EVICT_FRAMES = 8;
+
+        // Room new lists start with, more than any pass declares today. The lists get handed to a
+        // different pass when a pass comes or goes, so they should not need to grow after that.
+        static constexpr size_t RESERVED_ACCESSES = 32;
+        static constexpr size_t RESERVED_WRITERS = 4;
+
+    private:
+        struct PooledTexture
+        {
+            Ref<Texture> m_Texture;
+            RenderGraphTextureDesc m_Desc;
+            bool m_InUse = false;
+            uint32_t m_LastFrame = 0;
+        };
+
+        struct CachedFrameBuffer
+        {
+            std::vector<GLuint> m_Key;
+            Ref<FrameBuffer> m_FrameBuffer;
+            uint32_t m_LastFrame = 0;
+        };
+
+        std::vector<RenderGraphPass> m_Passes;
+        std::vector<RenderGraphResource> m_Resources;
+
+        // Lists from last frame's passes and resources, handed back out so a graph declared the
+        // same way every frame stops allocating once it has been built a few times.
+        std::vector<std::vector<RenderGraphAccess>> m_SpareAccesses;
+        std::vector<std::vector<uint32_t>> m_SpareWriters;
+        std::vector<GLuint> m_FrameBufferKey;
+
+        std::vector<PooledTexture> m_Pool;
+        std::vector<CachedFrameBuffer> m_FrameBuffers;
+
+        // Incoherent writes to imported resources that are still unflushed when the frame ends.
+        std::unordered_map<uint64_t, GLbitfield> m_PendingWrites;
+
+        Ref<Texture> m_BlackTexture;
+        RenderGraphStats m_Stats;
+        uint32_t m_Frame = 0;
+
+    public:
+        void Reset();
+
+        RenderGraphBuilder AddPass(const char* name, Pass* owner, RenderGraphExecute execute);
+
+        RenderGraphHandle ImportTexture(const char* name, Ref<Texture> texture);
+        RenderGraphHandle ImportTexture3D(const char* name, Texture3D* texture);
+        RenderGraphHandle ImportBuffer(const char* name, GfxBuffer* buffer);
+        RenderGraphHandle Find(const char* name) const;
+
+        void Compile();
+        void Execute();
+        void Destroy();
+
+        const RenderGraphStats& GetStats() const { return m_Stats; }
+
+        // Frames declared since the graph was created.
+        uint32_t GetFrame() const { return m_Frame; }
+
+    private:
+        RenderGraphHandle AddResource(const RenderGraphResource& resource);
+        void CullPasses();
+        void AllocateTransients();
+        void ComputeBarriers();
+        void ResolveFrameBuffers();
+        void EvictUnused();
+
+        Ref<Texture> AcquireTexture(const RenderGraphTextureDesc& desc, const char* name);
+        void ReleaseTexture(const Ref<Texture>& texture);
+
+        static GLbitfield GetBarrierBit(RG_ACCESS access);
+        static uint64_t GetResourceKey(const RenderGraphResource& resource);
+    };
+}
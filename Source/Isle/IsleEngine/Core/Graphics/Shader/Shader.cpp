@@ -6,16 +6,17 @@ namespace Isle
 {
     Shader::Shader()
     {
-        m_ProgramId = glCreateProgram();
+        m_ProgramId = GfxDevice::Get()->CreateProgram();
     }
 
     Shader::~Shader()
     {
+        GfxDevice* device = GfxDevice::Get();
         for (GLuint shader : m_AttachedShaders)
-            glDeleteShader(shader);
+            device->DestroyShader(shader);
 
         if (m_ProgramId)
-            glDeleteProgram(m_ProgramId);
+            device->DestroyProgram(m_ProgramId);
     }
 
     GLenum Shader::ResolveShaderType(SHADER_TYPE type)
@@ -30,42 +31,12 @@ namespace Isle
         }
     }
 
-    bool Shader::CheckShaderErrors(GLuint shader, const std::string& type)
-    {
-        GLint success = 0;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-        if (!success)
-        {
-            GLchar infoLog[1024];
-            glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
-            ISLE_ERROR("SHADER_COMPILATION_ERROR (%s): %s\n", type.c_str(), infoLog);
-            return false;
-        }
-        return true;
-    }
-
-    bool Shader::CheckProgramErrors(GLuint program)
-    {
-        GLint success = 0;
-        glGetProgramiv(program, GL_LINK_STATUS, &success);
-        if (!success)
-        {
-            GLchar infoLog[1024];
-            glGetProgramInfoLog(program, 1024, nullptr, infoLog);
-            ISLE_ERROR("PROGRAM_LINKING_ERROR: %s\n", infoLog);
-            return false;
-        }
-        return true;
-    }
-
     GLuint Shader::CompileShader(SHADER_TYPE type, const std::string& source)
     {
-        GLenum glType = ResolveShaderType(type);
-        GLuint shader = glCreateShader(glType);
-
-        const char* src = source.c_str();
-        glShaderSource(shader, 1, &src, nullptr);
-        glCompileShader(shader);
+        std::string log;
+        GLuint shader = GfxDevice::Get()->CompileShader(ResolveShaderType(type), source, log);
+        if (shader)
+            return shader;
 
         std::string label;
         switch (type)
@@ -76,13 +47,8 @@ namespace Isle
         case SHADER_TYPE::COMPUTE:  label = "COMPUTE"; break;
         }
 
-        if (!CheckShaderErrors(shader, label))
-        {
-            glDeleteShader(shader);
-            return 0;
-        }
-
-        return shader;
+        ISLE_ERROR("SHADER_COMPILATION_ERROR (%s): %s\n", label.c_str(), log.c_str());
+        return 0;
     }
 
     bool Shader::LoadFromSource(SHADER_TYPE type, const std::string& source)
@@ -91,7 +57,7 @@ namespace Isle
         if (!shader)
             return false;
 
-        glAttachShader(m_ProgramId, shader);
+        GfxDevice::Get()->AttachShader(m_ProgramId, shader);
         m_AttachedShaders.push_back(shader);
         return true;
     }
@@ -112,24 +78,22 @@ namespace Isle
 
     bool Shader::Link()
     {
-        glLinkProgram(m_ProgramId);
-        if (!CheckProgramErrors(m_ProgramId))
+        GfxDevice* device = GfxDevice::Get();
+        std::string log;
+        if (!device->LinkProgram(m_ProgramId, log))
+        {
+            ISLE_ERROR("PROGRAM_LINKING_ERROR: %s\n", log.c_str());
             return false;
+        }
 
-        glValidateProgram(m_ProgramId);
-        GLint validated;
-        glGetProgramiv(m_ProgramId, GL_VALIDATE_STATUS, &validated);
-        if (!validated)
+        if (!device->ValidateProgram(m_ProgramId, log))
         {
-            GLchar infoLog[1024];
-            glGetProgramInfoLog(m_ProgramId, 1024, NULL, infoLog);
-            ISLE_ERROR("PROGRAM_VALIDATION_ERROR: %s\n", infoLog);
+            ISLE_ERROR("PROGRAM_VALIDATION_ERROR: %s\n", log.c_str());
             return false;
         }
 
-
         for (GLuint shader : m_AttachedShaders)
-            glDetachShader(m_ProgramId, shader);
+            device->DetachShader(m_ProgramId, shader);
 
         m_AttachedShaders.clear();
         return true;
@@ -137,12 +101,12 @@ namespace Isle
 
     void Shader::Bind() const
     {
-        glUseProgram(m_ProgramId);
+        GfxDevice::Get()->UseProgram(m_ProgramId);
     }
 
     void Shader::DispatchCompute(GLuint groupsX, GLuint groupsY, GLuint groupsZ) const
     {
-        glDispatchCompute(groupsX, groupsY, groupsZ);
+        GfxDevice::Get()->DispatchCompute(groupsX, groupsY, groupsZ);
     }
 
     std::string Shader::ProcessIncludes(std::string& source, const std::string& basePath)
@@ -213,107 +177,116 @@ namespace Isle
         return output.str();
     }
 
-    GLint Shader::GetUniform(const std::string& name) const
+    GLint Shader::GetUniform(const char* name) const
     {
-        return glGetUniformLocation(m_ProgramId, name.c_str());
+        return GfxDevice::Get()->GetUniformLocation(m_ProgramId, name);
+    }
+
+    void Shader::SetBool(const char* name, bool value) const
+    {
+        GLint location = GetUniform(name);
+        if (location != -1)
+        {
+            GfxDevice::Get()->SetUniform(location, static_cast<int>(value));
+        }
     }
 
-    void Shader::SetBool(const std::string& name, bool value) const
+    void Shader::SetInt(const char* name, int value) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform1i(location, static_cast<int>(value));
+            GfxDevice::Get()->SetUniform(location, value);
         }
     }
 
-    void Shader::SetInt(const std::string& name, int value) const
+    void Shader::SetUInt(const char* name, unsigned int value) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform1i(location, value);
+            GfxDevice::Get()->SetUniform(location, value);
         }
     }
 
-    void Shader::SetUInt(const std::string& name, unsigned int value) const
+    void Shader::SetFloat(const char* name, float value) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform1ui(location, value);
+            GfxDevice::Get()->SetUniform(location, value);
         }
     }
 
-    void Shader::SetFloat(const std::string& name, float value) const
+    void Shader::SetVec2(const char* name, const glm::vec2& value) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform1f(location, value);
+            GfxDevice::Get()->SetUniform(location, value);
         }
     }
 
-    void Shader::SetVec2(const std::string& name, const glm::vec2& value) const
+    void Shader::SetVec3(const char* name, const glm::vec3& value) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform2fv(location, 1, glm::value_ptr(value));
+            GfxDevice::Get()->SetUniform(location, value);
         }
     }
 
-    void Shader::SetVec3(const std::string& name, const glm::vec3& value) const
+    void Shader::SetIVec3(const char* name, const glm::ivec3& value) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform3fv(location, 1, glm::value_ptr(value));
+            GfxDevice::Get()->SetUniform(location, value);
         }
     }
 
-    void Shader::SetIVec3(const std::string& name, const glm::ivec3& value) const
+    void Shader::SetIVec2(const char* name, const glm::ivec2& value) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform3iv(location, 1, glm::value_ptr(value));
+            GfxDevice::Get()->SetUniform(location, value);
         }
     }
 
-    void Shader::SetIVec2(const std::string& name, const glm::ivec2& value) const
+    void Shader::SetVec4(const char* name, const glm::vec4& value) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform3iv(location, 1, glm::value_ptr(value));
+            GfxDevice::Get()->SetUniform(location, value);
         }
     }
 
-    void Shader::SetVec4(const std::string& name, const glm::vec4& value) const
+    void Shader::SetVec4Array(const char* name, const glm::vec4* values, int count) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniform4fv(location, 1, glm::value_ptr(value));
+            GfxDevice::Get()->SetUniform(location, values, count);
         }
     }
 
-    void Shader::SetMat3(const std::string& name, const glm::mat3& mat) const
+    void Shader::SetMat3(const char* name, const glm::mat3& mat) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+            GfxDevice::Get()->SetUniform(location, mat);
         }
     }
 
-    void Shader::SetMat4(const std::string& name, const glm::mat4& mat) const
+    void Shader::SetMat4(const char* name, const glm::mat4& mat) const
     {
         GLint location = GetUniform(name);
         if (location != -1)
         {
-            glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+            GfxDevice::Get()->SetUniform(location, mat);
         }
     }
 }
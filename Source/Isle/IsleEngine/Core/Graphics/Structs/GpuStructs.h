@@ -64,21 +64,12 @@ namespace Isle
     };
 
 
+    // Skin influences of one vertex, four 16 bit joint indices and four unorm16 weights. The
+    // rest of the vertex is the bind pose GpuVertex at the same index.
     struct alignas(16) GpuSkinnedVertex
     {
-        glm::vec3 m_Position;
-        float _pad0;
-        glm::vec3 m_Normal;
-        float _pad1;
-        glm::vec2 m_TexCoord;
-        glm::vec2 _pad2;
-        glm::vec3 m_Tangent;
-        float _pad3;
-        glm::vec3 m_BitTangent;
-        float _pad4;
-        glm::vec4 m_Color;
-        glm::ivec4 m_BoneIds;
-        glm::vec4 m_BoneWeights;
+        uint32_t m_Joints[2];
+        uint32_t m_Weights[2];
     };
 
     struct alignas(16) GpuMaterial
@@ -115,31 +106,51 @@ namespace Isle
         uint32_t m_IndexCount;
         uint32_t m_MaterialIndex;
         uint32_t m_UseViewModel;
-        int _pad1;
+        uint32_t m_LodOffset;
+        uint32_t m_LodCount;
+        uint32_t m_Skinned;         // vertices move every frame, meshlet bounds do not hold
     };
 
-    struct alignas(16) GpuSkinnedMesh
+    struct alignas(16) GpuMeshLod
     {
-        glm::mat4 m_Transform;
-        glm::mat4 m_NormalMatrix;
-        glm::vec3 m_AABBMin;
-        float _pad0;
-        glm::vec3 m_AABBMax;
-        int m_Selected;
-        uint32_t m_VertexOffset;
+        uint32_t m_FirstIndex;
+        uint32_t m_IndexCount;
+        uint32_t m_MeshletOffset;
+        uint32_t m_MeshletCount;
+        float m_Error;
+        float _pad0[3];
+    };
+
+    struct alignas(16) GpuMeshlet
+    {
+        glm::vec3 m_Center;
+        float m_Radius;
+        glm::vec3 m_ConeAxis;
+        float m_ConeCutoff;
+        uint32_t m_MeshIndex;
         uint32_t m_IndexOffset;
         uint32_t m_IndexCount;
-        uint32_t m_MaterialIndex;
+        uint32_t m_VertexOffset;
+    };
+
+    // One skinned mesh in the skinning dispatch. Threads are handed out in mesh order,
+    // m_FirstThread is the running vertex count of the meshes before it.
+    struct alignas(16) GpuSkinnedMesh
+    {
+        uint32_t m_SourceOffset;        // bind pose vertices and influences
+        uint32_t m_VertexOffset;        // skinned output in the shared vertex buffer
+        uint32_t m_VertexCount;
+        uint32_t m_FirstThread;
         uint32_t m_BoneMatrixOffset;
         uint32_t m_BoneCount;
-        uint32_t m_UseViewModel;
-        int _pad1;
+        int _pad0[2];
     };
 
     struct alignas(16) GpuCamera
     {
         glm::mat4 m_ViewMatrix;
         glm::mat4 m_ProjectionMatrix;
+        glm::mat4 m_InverseViewProjection;
         glm::vec3 m_CameraPos;
         float _pad0;
     };
@@ -153,9 +164,24 @@ namespace Isle
         glm::vec3 m_Direction;
         int m_Type;
         glm::vec2 m_ConeAngles;
-        glm::vec2 _pad0;
+        int m_ShadowTileCount;      // tiles in the local shadow atlas, 0 when unshadowed
+        int _pad0;
         glm::mat4 m_LightSpaceMatrix;
         glm::mat4 m_ShadowMatrices[6];
+        glm::vec4 m_ShadowTiles[6]; // atlas uv offset, uv scale, tile size in texels
+    };
+
+    constexpr int SHADOW_CASCADE_COUNT = 4;
+
+    // Cascades of the main directional light, laid out 2x2 in the ShadowMap atlas.
+    struct alignas(16) GpuShadowCascades
+    {
+        glm::mat4 m_ViewProjection[SHADOW_CASCADE_COUNT];
+        glm::vec4 m_Splits;         // view space distance where each cascade ends
+        glm::vec4 m_TexelSizes;     // world units covered by one shadow texel
+        int m_CascadeCount;
+        int m_LightIndex;           // directional light the cascades belong to
+        int _pad0[2];
     };
 
     struct alignas(16) GpuDrawCommand
@@ -1,5 +1,6 @@
 // Texture.cpp
 #include "Texture.h"
+#include "TextureCompressor.h"
 #include <stb_image.h>
 
 namespace Isle
@@ -18,9 +19,7 @@ namespace Isle
         m_GenerateMipmaps = generateMipmaps;
 
         if (!m_Id)
-            glGenTextures(1, &m_Id);
-
-        glBindTexture(GL_TEXTURE_2D, m_Id);
+            m_Id = GfxDevice::Get()->CreateTexture(GL_TEXTURE_2D);
 
         GLenum internalFormat = ResolveInternalFormat(format);
         GLenum pixelFormat = ResolveFormat(format);
@@ -39,7 +38,7 @@ namespace Isle
             pixelFormat = GL_DEPTH_STENCIL;
         }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0,
+        GfxDevice::Get()->TexImage(GL_TEXTURE_2D, m_Id, 0, internalFormat, width, height, 1,
             pixelFormat, dataType, data);
 
         SetMinFilter(m_MinFilter);
@@ -47,13 +46,13 @@ namespace Isle
         SetWrapS(m_WrapS);
         SetWrapT(m_WrapT);
 
+        m_IsLoaded = true;
+        SetSizeInBytes(CalculateTextureSize(width, height, format));
+        if (data)
+            RecordUpload(m_SizeInBytes);
+
         if (generateMipmaps && data)
             GenerateMipmaps();
-
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        m_IsLoaded = true;
-        m_SizeInBytes = CalculateTextureSize(width, height, format);
     }
 
     void Texture::CreateFromFile(const std::string& path, bool generateMipmaps)
@@ -84,16 +83,129 @@ namespace Isle
          stbi_image_free(data);
     }
 
+    void Texture::CreateCompressed(const CompressedImage& image, int firstMip)
+    {
+        if (!IsCompressedFormat(image.m_Format) || image.m_Mips.empty())
+        {
+            ISLE_ERROR("CreateCompressed: invalid compressed image\n");
+            return;
+        }
+
+        firstMip = std::clamp(firstMip, 0, static_cast<int>(image.m_Mips.size()) - 1);
+
+        // m_Width/m_Height stay the full resolution, GL level 0 holds mip firstMip.
+        m_Width = image.m_Width;
+        m_Height = image.m_Height;
+        m_Format = image.m_Format;
+        m_GenerateMipmaps = false;
+        m_MipCount = static_cast<int>(image.m_Mips.size());
+        m_ResidentMip = firstMip;
+
+        GfxDevice* device = GfxDevice::Get();
+        if (!m_Id)
+            m_Id = device->CreateTexture(GL_TEXTURE_2D);
+
+        GLenum internalFormat = ResolveInternalFormat(m_Format);
+        for (int level = firstMip; level < m_MipCount; level++)
+        {
+            const CompressedMip& mip = image.m_Mips[level];
+            device->CompressedTexImage2D(m_Id, level - firstMip, internalFormat,
+                mip.m_Width, mip.m_Height, mip.m_Data.size(), mip.m_Data.data());
+        }
+
+        device->TexParameter(GL_TEXTURE_2D, m_Id, GL_TEXTURE_BASE_LEVEL, 0);
+        device->TexParameter(GL_TEXTURE_2D, m_Id, GL_TEXTURE_MAX_LEVEL, m_MipCount - firstMip - 1);
+
+        SetMinFilter(m_MinFilter);
+        SetMagFilter(m_MagFilter);
+        SetWrapS(m_WrapS);
+        SetWrapT(m_WrapT);
+
+        m_IsLoaded = true;
+        SetSizeInBytes(image.GetSizeInBytes(firstMip));
+        RecordUpload(m_SizeInBytes);
+    }
+
+    void Texture::CreateStreamed(std::shared_ptr<CompressedImage> image, int firstMip)
+    {
+        if (!image)
+            return;
+
+        m_StreamSource = std::move(image);
+        CreateCompressed(*m_StreamSource, firstMip);
+    }
+
+    bool Texture::SetResidentMip(int mip)
+    {
+        if (!m_StreamSource || !m_Id)
+            return false;
+
+        mip = std::clamp(mip, 0, m_MipCount - 1);
+        if (mip == m_ResidentMip)
+            return false;
+
+        // Sampler and base level state is frozen once a bindless handle exists, so the
+        // new range goes into a fresh texture. Levels both ranges share are copied on
+        // the GPU, only the missing ones come from m_StreamSource.
+        const CompressedImage& image = *m_StreamSource;
+        const GLenum internalFormat = ResolveInternalFormat(m_Format);
+        const int levels = m_MipCount - mip;
+
+        size_t uploadedBytes = 0;
+
+        GfxDevice* device = GfxDevice::Get();
+        GLuint id = device->CreateTexture(GL_TEXTURE_2D);
+        device->TexStorage(GL_TEXTURE_2D, id, levels, internalFormat, image.m_Mips[mip].m_Width, image.m_Mips[mip].m_Height, 1);
+
+        for (int level = mip; level < m_MipCount; level++)
+        {
+            const CompressedMip& source = image.m_Mips[level];
+            if (level >= m_ResidentMip)
+            {
+                device->CopyTexture2D(m_Id, level - m_ResidentMip, id, level - mip, source.m_Width, source.m_Height);
+            }
+            else
+            {
+                device->CompressedTexSubImage2D(id, level - mip, source.m_Width, source.m_Height,
+                    internalFormat, source.m_Data.size(), source.m_Data.data());
+                uploadedBytes += source.m_Data.size();
+            }
+        }
+
+        if (m_BindlessHandle)
+        {
+            device->MakeTextureNonResident(m_BindlessHandle);
+            m_BindlessHandle = 0;
+        }
+        device->DestroyTexture(m_Id);
+
+        m_Id = id;
+        m_ResidentMip = mip;
+        SetSizeInBytes(image.GetSizeInBytes(mip));
+        RecordUpload(uploadedBytes);
+
+        SetMinFilter(m_MinFilter);
+        SetMagFilter(m_MagFilter);
+        SetWrapS(m_WrapS);
+        SetWrapT(m_WrapT);
+        if (m_AnisotropicLevel > 1.0f)
+            SetAnisotropicLevel(m_AnisotropicLevel);
+        if (!m_DebugName.empty())
+            SetDebugLabel(m_DebugName);
+
+        return true;
+    }
+
     void Texture::Destroy()
     {
         if (m_Id)
         {
-            glDeleteTextures(1, &m_Id);
+            GfxDevice::Get()->DestroyTexture(m_Id);
             m_Id = 0;
         }
         m_IsLoaded = false;
         m_IsResident = false;
-        m_SizeInBytes = 0;
+        SetSizeInBytes(0);
         m_Slot = -1;
         m_ImageSlot = -1;
     }
@@ -107,114 +219,98 @@ namespace Isle
     void Texture::Bind(uint32_t slot)
     {
         if (!m_Id) return;
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, m_Id);
+        GfxDevice::Get()->BindTexture(slot, GL_TEXTURE_2D, m_Id);
         m_Slot = slot;
         m_IsResident = true;
     }
 
     void Texture::Unbind(uint32_t slot)
     {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->BindTexture(slot, GL_TEXTURE_2D, 0);
         m_IsResident = false;
         m_Slot = -1;
     }
 
-    void Texture::BindAsImage(uint32_t slot, GLenum access)
+    void Texture::BindAsImage(uint32_t slot, GLenum access, int level)
     {
         if (!m_Id) return;
         GLenum format = ResolveInternalFormat(m_Format);
-        glBindImageTexture(slot, m_Id, 0, GL_FALSE, 0, access, format);
+        GfxDevice::Get()->BindImageTexture(slot, m_Id, level, GL_FALSE, access, format);
         m_ImageSlot = slot;
     }
 
     void Texture::UnbindAsImage(uint32_t slot)
     {
-        glBindImageTexture(slot, 0, 0, GL_FALSE, 0, GL_READ_WRITE, GL_RGBA8);
+        GfxDevice::Get()->BindImageTexture(slot, 0, 0, GL_FALSE, GL_READ_WRITE, GL_RGBA8);
         m_ImageSlot = -1;
     }
 
     void Texture::SetMinFilter(TEXTURE_FILTER filter)
     {
         m_MinFilter = filter;
-        glBindTexture(GL_TEXTURE_2D, m_Id);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, ResolveFilter(filter));
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_2D, m_Id, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(ResolveFilter(filter)));
     }
 
     void Texture::SetMagFilter(TEXTURE_FILTER filter)
     {
         m_MagFilter = filter;
-        glBindTexture(GL_TEXTURE_2D, m_Id);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, ResolveFilter(filter));
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_2D, m_Id, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(ResolveFilter(filter)));
     }
 
     void Texture::SetWrapS(TEXTURE_WRAP wrap)
     {
         m_WrapS = wrap;
-        glBindTexture(GL_TEXTURE_2D, m_Id);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ResolveWrap(wrap));
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_2D, m_Id, GL_TEXTURE_WRAP_S, static_cast<GLint>(ResolveWrap(wrap)));
     }
 
     void Texture::SetWrapT(TEXTURE_WRAP wrap)
     {
         m_WrapT = wrap;
-        glBindTexture(GL_TEXTURE_2D, m_Id);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ResolveWrap(wrap));
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_2D, m_Id, GL_TEXTURE_WRAP_T, static_cast<GLint>(ResolveWrap(wrap)));
     }
 
     void Texture::SetAnisotropicLevel(float level)
     {
         m_AnisotropicLevel = level;
-        glBindTexture(GL_TEXTURE_2D, m_Id);
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, level);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_2D, m_Id, GL_TEXTURE_MAX_ANISOTROPY_EXT, level);
     }
 
     void Texture::SetBorderColor(const glm::vec4& color)
     {
-        glBindTexture(GL_TEXTURE_2D, m_Id);
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(color));
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_2D, m_Id, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(color));
     }
 
     void Texture::Upload(const void* data, int level)
     {
-        glBindTexture(GL_TEXTURE_2D, m_Id);
         GLenum format = ResolveFormat(m_Format);
         GLenum type = ResolveDataType(m_Format);
-        glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, m_Width, m_Height, format, type, data);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->TexSubImage(GL_TEXTURE_2D, m_Id, level, m_Width, m_Height, 1, format, type, data);
+
+        RecordUpload(CalculateTextureSize(std::max(m_Width >> level, 1), std::max(m_Height >> level, 1), m_Format));
     }
 
     void Texture::Download(void* outData, int level) const
     {
-        glBindTexture(GL_TEXTURE_2D, m_Id);
         GLenum format = ResolveFormat(m_Format);
         GLenum type = ResolveDataType(m_Format);
-        glGetTexImage(GL_TEXTURE_2D, level, format, type, outData);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->GetTexImage(GL_TEXTURE_2D, m_Id, level, format, type, outData);
     }
 
     uint64_t Texture::GetBindlessHandle()
     {
         if (!m_BindlessHandle)
         {
-            m_BindlessHandle = glGetTextureHandleARB(m_Id);
-            glMakeTextureHandleResidentARB(m_BindlessHandle);
+            m_BindlessHandle = GfxDevice::Get()->MakeTextureResident(m_Id);
         }
         return m_BindlessHandle;
     }
 
     void Texture::GenerateMipmaps()
     {
-        glBindTexture(GL_TEXTURE_2D, m_Id);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GfxDevice::Get()->GenerateMipmap(GL_TEXTURE_2D, m_Id);
+
+        if (!IsCompressedFormat(m_Format))
+            SetSizeInBytes(CalculateMipChainSize(m_Width, m_Height, m_Format));
     }
 
     void Texture::Resize(int width, int height)
@@ -222,27 +318,25 @@ namespace Isle
         m_Width = width;
         m_Height = height;
 
-        glBindTexture(GL_TEXTURE_2D, m_Id);
         GLenum internalFormat = ResolveInternalFormat(m_Format);
         GLenum format = ResolveFormat(m_Format);
         GLenum type = ResolveDataType(m_Format);
 
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+        GfxDevice::Get()->TexImage(GL_TEXTURE_2D, m_Id, 0, internalFormat, width, height, 1, format, type, nullptr);
 
         SetMinFilter(m_MinFilter);
         SetMagFilter(m_MagFilter);
         SetWrapS(m_WrapS);
         SetWrapT(m_WrapT);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        m_SizeInBytes = CalculateTextureSize(width, height, m_Format);
+        SetSizeInBytes(CalculateTextureSize(width, height, m_Format));
     }
 
     void Texture::SetDebugLabel(const std::string& name)
     {
-        if (glObjectLabel)
-            glObjectLabel(GL_TEXTURE, m_Id, -1, name.c_str());
+        m_DebugName = name;
+        GfxResourceTracker::SetLabel(this, name);
+        GfxDevice::Get()->SetObjectLabel(GL_TEXTURE, m_Id, name);
     }
 
     GLenum Texture::ResolveInternalFormat(TEXTURE_FORMAT format)
@@ -272,6 +366,11 @@ namespace Isle
             case TEXTURE_FORMAT::DEPTH24_STENCIL8: return GL_DEPTH24_STENCIL8;
             case TEXTURE_FORMAT::DEPTH32F_STENCIL8: return GL_DEPTH32F_STENCIL8;
             case TEXTURE_FORMAT::STENCIL8: return GL_STENCIL_INDEX8;
+            case TEXTURE_FORMAT::BC1: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case TEXTURE_FORMAT::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case TEXTURE_FORMAT::BC4: return GL_COMPRESSED_RED_RGTC1;
+            case TEXTURE_FORMAT::BC5: return GL_COMPRESSED_RG_RGTC2;
+            case TEXTURE_FORMAT::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
             default: return GL_RGBA8;
         }
     }
@@ -381,8 +480,24 @@ namespace Isle
         }
     }
 
+    bool Texture::IsCompressedFormat(TEXTURE_FORMAT format)
+    {
+        switch (format)
+        {
+            case TEXTURE_FORMAT::BC1:
+            case TEXTURE_FORMAT::BC3:
+            case TEXTURE_FORMAT::BC4:
+            case TEXTURE_FORMAT::BC5:
+            case TEXTURE_FORMAT::BC7: return true;
+            default: return false;
+        }
+    }
+
     int Texture::CalculateTextureSize(int width, int height, TEXTURE_FORMAT format)
     {
+        if (IsCompressedFormat(format))
+            return static_cast<int>(TextureCompressor::GetCompressedSize(width, height, format));
+
         int bytesPerPixel = 4;
 
         switch (format)
@@ -410,4 +525,19 @@ namespace Isle
 
         return width * height * bytesPerPixel;
     }
+
+    size_t Texture::CalculateMipChainSize(int width, int height, TEXTURE_FORMAT format)
+    {
+        size_t total = 0;
+        while (true)
+        {
+            total += CalculateTextureSize(width, height, format);
+            if (width == 1 && height == 1)
+                break;
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+        return total;
+    }
 }
\ No newline at end of file
@@ -2,9 +2,12 @@
 #pragma once
 #include <Core/Common/Common.h>
 #include <Core/Graphics/GfxResource/GfxResource.h>
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
 
 namespace Isle
 {
+    struct CompressedImage;
+
     enum class TEXTURE_FORMAT
     {
         R8,
@@ -29,7 +32,12 @@ namespace Isle
         DEPTH32F,
         DEPTH24_STENCIL8,
         DEPTH32F_STENCIL8,
-        STENCIL8
+        STENCIL8,
+        BC1,
+        BC3,
+        BC4,
+        BC5,
+        BC7
     };
 
     enum class TEXTURE_FILTER
@@ -63,6 +71,12 @@ namespace Isle
         int m_ImageSlot = -1;
         uint32_t m_BindlessIndex = -1;
         uint64_t m_BindlessHandle = 0;
+        int m_MipCount = 1;
+        int m_ResidentMip = 0;
+        std::string m_DebugName;
+
+        // Full mip chain kept on the CPU for textures the TextureStreamer manages.
+        std::shared_ptr<CompressedImage> m_StreamSource;
 
         TEXTURE_FORMAT m_Format = TEXTURE_FORMAT::RGBA8;
         TEXTURE_FILTER m_MinFilter = TEXTURE_FILTER::LINEAR;
@@ -74,10 +88,11 @@ namespace Isle
         float m_AnisotropicLevel = 1.0f;
 
     public:
-        Texture() = default;
+        Texture() : GfxResource(GFX_RESOURCE_CATEGORY::TEXTURE) {}
         ~Texture() override;
 
         Texture(int width, int height, TEXTURE_FORMAT format, bool generateMipmaps = false)
+            : GfxResource(GFX_RESOURCE_CATEGORY::TEXTURE)
         {
             Create(width, height, format, nullptr, generateMipmaps);
         }
@@ -86,6 +101,9 @@ namespace Isle
         void Create(int width, int height, TEXTURE_FORMAT format,
                    const void* data = nullptr, bool generateMipmaps = false);
         void CreateFromFile(const std::string& path, bool generateMipmaps = true);
+        void CreateCompressed(const CompressedImage& image, int firstMip = 0);
+        void CreateStreamed(std::shared_ptr<CompressedImage> image, int firstMip);
+        bool SetResidentMip(int mip);
         void Destroy();
 
         void Load() override;
@@ -94,7 +112,7 @@ namespace Isle
         void Unbind(uint32_t slot = 0) override;
 
 
-        void BindAsImage(uint32_t slot, GLenum access = GL_READ_WRITE);
+        void BindAsImage(uint32_t slot, GLenum access = GL_READ_WRITE, int level = 0);
         void UnbindAsImage(uint32_t slot);
 
         void SetMinFilter(TEXTURE_FILTER filter);
@@ -113,6 +131,8 @@ namespace Isle
         void SetDebugLabel(const std::string& name);
 
         static int CalculateTextureSize(int width, int height, TEXTURE_FORMAT format);
+        static size_t CalculateMipChainSize(int width, int height, TEXTURE_FORMAT format);
+        static bool IsCompressedFormat(TEXTURE_FORMAT format);
         static GLenum ResolveInternalFormat(TEXTURE_FORMAT format);
         static GLenum ResolveFormat(TEXTURE_FORMAT format);
         static GLenum ResolveDataType(TEXTURE_FORMAT format);
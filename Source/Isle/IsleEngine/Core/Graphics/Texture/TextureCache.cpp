@@ -0,0 +1,124 @@
+// TextureCache.cpp
+#include "TextureCache.h"
+#include <filesystem>
+#include <fstream>
+
+namespace Isle
+{
+    static constexpr uint32_t TEXTURE_CACHE_MAGIC = 0x58455449; // "ITEX"
+
+    struct TextureCacheHeader
+    {
+        uint32_t m_Magic;
+        uint32_t m_Version;
+        uint32_t m_Format;
+        int32_t m_Width;
+        int32_t m_Height;
+        uint32_t m_MipCount;
+    };
+
+    struct TextureCacheMip
+    {
+        int32_t m_Width;
+        int32_t m_Height;
+        uint32_t m_Size;
+    };
+
+    std::string TextureCache::MakeKey(const uint8_t* data, size_t size, int width, int height, TEXTURE_FORMAT format)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const uint8_t* bytes, size_t count) {
+            for (size_t i = 0; i < count; i++)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            };
+
+        const int32_t params[4] = { width, height, static_cast<int32_t>(format), static_cast<int32_t>(TextureCompressor::ENCODER_VERSION) };
+        mix(reinterpret_cast<const uint8_t*>(params), sizeof(params));
+        mix(data, size);
+
+        char key[17];
+        snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+        return key;
+    }
+
+    std::string TextureCache::GetPath(const std::string& key)
+    {
+        return (std::filesystem::path(s_Directory) / (key + ".itex")).string();
+    }
+
+    bool TextureCache::Load(const std::string& key, CompressedImage& outImage)
+    {
+        std::ifstream file(GetPath(key), std::ios::binary);
+        if (!file)
+            return false;
+
+        TextureCacheHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (!file || header.m_Magic != TEXTURE_CACHE_MAGIC || header.m_Version != TextureCompressor::ENCODER_VERSION)
+            return false;
+
+        CompressedImage image;
+        image.m_Format = static_cast<TEXTURE_FORMAT>(header.m_Format);
+        image.m_Width = header.m_Width;
+        image.m_Height = header.m_Height;
+        image.m_Mips.resize(header.m_MipCount);
+
+        for (auto& mip : image.m_Mips)
+        {
+            TextureCacheMip mipHeader{};
+            file.read(reinterpret_cast<char*>(&mipHeader), sizeof(mipHeader));
+
+            if (!file || mipHeader.m_Size != TextureCompressor::GetCompressedSize(mipHeader.m_Width, mipHeader.m_Height, image.m_Format))
+            {
+                ISLE_WARN("TextureCache: corrupt entry %s\n", key.c_str());
+                return false;
+            }
+
+            mip.m_Width = mipHeader.m_Width;
+            mip.m_Height = mipHeader.m_Height;
+            mip.m_Data.resize(mipHeader.m_Size);
+            file.read(reinterpret_cast<char*>(mip.m_Data.data()), mipHeader.m_Size);
+
+            if (!file)
+                return false;
+        }
+
+        outImage = std::move(image);
+        return true;
+    }
+
+    bool TextureCache::Store(const std::string& key, const CompressedImage& image)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(s_Directory, error);
+
+        std::ofstream file(GetPath(key), std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            ISLE_WARN("TextureCache: cannot write %s\n", GetPath(key).c_str());
+            return false;
+        }
+
+        TextureCacheHeader header{};
+        header.m_Magic = TEXTURE_CACHE_MAGIC;
+        header.m_Version = TextureCompressor::ENCODER_VERSION;
+        header.m_Format = static_cast<uint32_t>(image.m_Format);
+        header.m_Width = image.m_Width;
+        header.m_Height = image.m_Height;
+        header.m_MipCount = static_cast<uint32_t>(image.m_Mips.size());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const auto& mip : image.m_Mips)
+        {
+            TextureCacheMip mipHeader{ mip.m_Width, mip.m_Height, static_cast<uint32_t>(mip.m_Data.size()) };
+            file.write(reinterpret_cast<const char*>(&mipHeader), sizeof(mipHeader));
+            file.write(reinterpret_cast<const char*>(mip.m_Data.data()), mip.m_Data.size());
+        }
+
+        return static_cast<bool>(file);
+    }
+}
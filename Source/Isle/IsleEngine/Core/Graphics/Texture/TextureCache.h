@@ -0,0 +1,24 @@
+// TextureCache.h
+#pragma once
+#include <Core/Common/Common.h>
+#include <Core/Graphics/Texture/TextureCompressor.h>
+
+namespace Isle
+{
+    // On disk cache of cooked (block compressed, mipmapped) textures. Entries are keyed by a
+    // hash of the source pixels, the target format and the encoder version.
+    class ISLEENGINE_API TextureCache
+    {
+    public:
+        static inline std::string s_Directory = "Cache/Textures";
+
+    public:
+        static std::string MakeKey(const uint8_t* data, size_t size, int width, int height, TEXTURE_FORMAT format);
+
+        static bool Load(const std::string& key, CompressedImage& outImage);
+        static bool Store(const std::string& key, const CompressedImage& image);
+
+    private:
+        static std::string GetPath(const std::string& key);
+    };
+}
@@ -0,0 +1,815 @@
+// TextureCompressor.cpp
+#include "TextureCompressor.h"
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cmath>
+
+namespace Isle
+{
+    size_t CompressedImage::GetSizeInBytes(int firstMip) const
+    {
+        size_t size = 0;
+        for (size_t level = std::max(firstMip, 0); level < m_Mips.size(); level++)
+            size += m_Mips[level].m_Data.size();
+        return size;
+    }
+
+    uint32_t TextureCompressor::GetBlockBytes(TEXTURE_FORMAT format)
+    {
+        switch (format)
+        {
+        case TEXTURE_FORMAT::BC1:
+        case TEXTURE_FORMAT::BC4: return 8;
+        case TEXTURE_FORMAT::BC3:
+        case TEXTURE_FORMAT::BC5:
+        case TEXTURE_FORMAT::BC7: return 16;
+        default: return 0;
+        }
+    }
+
+    size_t TextureCompressor::GetCompressedSize(int width, int height, TEXTURE_FORMAT format)
+    {
+        return size_t((width + 3) / 4) * size_t((height + 3) / 4) * GetBlockBytes(format);
+    }
+
+    uint32_t TextureCompressor::GetChannelMask(TEXTURE_FORMAT format)
+    {
+        switch (format)
+        {
+        case TEXTURE_FORMAT::BC1: return 0x7;
+        case TEXTURE_FORMAT::BC4: return 0x1;
+        case TEXTURE_FORMAT::BC5: return 0x3;
+        default: return 0xF;
+        }
+    }
+
+    // Fetches a 4x4 RGBA block, clamping at the image edge for sizes that are not a multiple of 4.
+    static void FetchBlock(const uint8_t* rgba, int width, int height, int bx, int by, uint8_t* block)
+    {
+        for (int y = 0; y < 4; y++)
+        {
+            const int sy = std::min(by * 4 + y, height - 1);
+            for (int x = 0; x < 4; x++)
+            {
+                const int sx = std::min(bx * 4 + x, width - 1);
+                std::memcpy(block + (y * 4 + x) * 4, rgba + (size_t(sy) * width + sx) * 4, 4);
+            }
+        }
+    }
+
+    static void StoreBlock(const uint8_t* block, int width, int height, int bx, int by, uint8_t* rgba)
+    {
+        for (int y = 0; y < 4 && by * 4 + y < height; y++)
+        {
+            for (int x = 0; x < 4 && bx * 4 + x < width; x++)
+                std::memcpy(rgba + (size_t(by * 4 + y) * width + bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+        }
+    }
+
+    template<typename Func>
+    static void ForEachBlockRow(int blockRows, Func&& func)
+    {
+        unsigned int numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0) numThreads = 4;
+        numThreads = std::min<unsigned int>(numThreads, static_cast<unsigned int>(blockRows));
+
+        std::atomic<int> nextRow(0);
+        auto worker = [&]() {
+            int row;
+            while ((row = nextRow.fetch_add(1)) < blockRows)
+                func(row);
+            };
+
+        if (numThreads <= 1)
+        {
+            worker();
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (unsigned int i = 0; i < numThreads; i++)
+            threads.emplace_back(worker);
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    std::vector<uint8_t> TextureCompressor::Compress(const uint8_t* rgba, int width, int height, TEXTURE_FORMAT format)
+    {
+        const uint32_t blockBytes = GetBlockBytes(format);
+        if (!rgba || width <= 0 || height <= 0 || blockBytes == 0)
+            return {};
+
+        const int blocksX = (width + 3) / 4;
+        const int blocksY = (height + 3) / 4;
+        std::vector<uint8_t> out(size_t(blocksX) * blocksY * blockBytes);
+
+        ForEachBlockRow(blocksY, [&](int by) {
+            uint8_t block[64];
+            for (int bx = 0; bx < blocksX; bx++)
+            {
+                FetchBlock(rgba, width, height, bx, by, block);
+                uint8_t* dst = out.data() + (size_t(by) * blocksX + bx) * blockBytes;
+
+                switch (format)
+                {
+                case TEXTURE_FORMAT::BC1: EncodeBC1Block(block, dst); break;
+                case TEXTURE_FORMAT::BC3: EncodeBC3Block(block, dst); break;
+                case TEXTURE_FORMAT::BC4: EncodeBC4Block(block, 0, dst); break;
+                case TEXTURE_FORMAT::BC5: EncodeBC5Block(block, dst); break;
+                case TEXTURE_FORMAT::BC7: EncodeBC7Block(block, dst); break;
+                default: break;
+                }
+            }
+            });
+
+        return out;
+    }
+
+    std::vector<uint8_t> TextureCompressor::Decompress(const uint8_t* blocks, int width, int height, TEXTURE_FORMAT format)
+    {
+        const uint32_t blockBytes = GetBlockBytes(format);
+        if (!blocks || width <= 0 || height <= 0 || blockBytes == 0)
+            return {};
+
+        const int blocksX = (width + 3) / 4;
+        const int blocksY = (height + 3) / 4;
+        std::vector<uint8_t> rgba(size_t(width) * height * 4);
+
+        ForEachBlockRow(blocksY, [&](int by) {
+            uint8_t block[64];
+            for (int bx = 0; bx < blocksX; bx++)
+            {
+                const uint8_t* src = blocks + (size_t(by) * blocksX + bx) * blockBytes;
+
+                switch (format)
+                {
+                case TEXTURE_FORMAT::BC1: DecodeBC1Block(src, block); break;
+                case TEXTURE_FORMAT::BC3: DecodeBC3Block(src, block); break;
+                case TEXTURE_FORMAT::BC4: DecodeBC4Block(src, 0, block); break;
+                case TEXTURE_FORMAT::BC5: DecodeBC5Block(src, block); break;
+                case TEXTURE_FORMAT::BC7: DecodeBC7Block(src, block); break;
+                default: break;
+                }
+
+                StoreBlock(block, width, height, bx, by, rgba.data());
+            }
+            });
+
+        return rgba;
+    }
+
+    CompressedImage TextureCompressor::CompressMipChain(const uint8_t* rgba, int width, int height, TEXTURE_FORMAT format)
+    {
+        CompressedImage image;
+        image.m_Format = format;
+        image.m_Width = width;
+        image.m_Height = height;
+
+        std::vector<uint8_t> level;
+        const uint8_t* source = rgba;
+        int w = width;
+        int h = height;
+
+        while (true)
+        {
+            CompressedMip mip;
+            mip.m_Width = w;
+            mip.m_Height = h;
+            mip.m_Data = Compress(source, w, h, format);
+            image.m_Mips.push_back(std::move(mip));
+
+            if (w == 1 && h == 1)
+                break;
+
+            level = Downsample(source, w, h);
+            source = level.data();
+            w = std::max(w / 2, 1);
+            h = std::max(h / 2, 1);
+        }
+
+        return image;
+    }
+
+    std::vector<uint8_t> TextureCompressor::ExpandToRGBA(const uint8_t* data, int width, int height, int channels)
+    {
+        const size_t pixels = size_t(width) * height;
+        std::vector<uint8_t> rgba(pixels * 4);
+
+        for (size_t i = 0; i < pixels; i++)
+        {
+            const uint8_t* src = data + i * channels;
+            uint8_t* dst = rgba.data() + i * 4;
+
+            switch (channels)
+            {
+            case 1: dst[0] = src[0]; dst[1] = src[0]; dst[2] = src[0]; dst[3] = 255; break;
+            case 2: dst[0] = src[0]; dst[1] = src[1]; dst[2] = 0; dst[3] = 255; break;
+            case 3: dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = 255; break;
+            default: std::memcpy(dst, src, 4); break;
+            }
+        }
+
+        return rgba;
+    }
+
+    std::vector<uint8_t> TextureCompressor::Downsample(const uint8_t* rgba, int width, int height)
+    {
+        const int w = std::max(width / 2, 1);
+        const int h = std::max(height / 2, 1);
+        std::vector<uint8_t> out(size_t(w) * h * 4);
+
+        for (int y = 0; y < h; y++)
+        {
+            const int y0 = std::min(y * 2, height - 1);
+            const int y1 = std::min(y * 2 + 1, height - 1);
+
+            for (int x = 0; x < w; x++)
+            {
+                const int x0 = std::min(x * 2, width - 1);
+                const int x1 = std::min(x * 2 + 1, width - 1);
+
+                for (int c = 0; c < 4; c++)
+                {
+                    int sum = rgba[(size_t(y0) * width + x0) * 4 + c] + rgba[(size_t(y0) * width + x1) * 4 + c] +
+                        rgba[(size_t(y1) * width + x0) * 4 + c] + rgba[(size_t(y1) * width + x1) * 4 + c];
+                    out[(size_t(y) * w + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        return out;
+    }
+
+    double TextureCompressor::ComputePSNR(const uint8_t* a, const uint8_t* b, int width, int height, uint32_t channelMask)
+    {
+        double error = 0.0;
+        size_t samples = 0;
+
+        for (size_t i = 0; i < size_t(width) * height; i++)
+        {
+            for (int c = 0; c < 4; c++)
+            {
+                if (!(channelMask & (1u << c)))
+                    continue;
+
+                const double delta = double(a[i * 4 + c]) - double(b[i * 4 + c]);
+                error += delta * delta;
+                samples++;
+            }
+        }
+
+        if (samples == 0 || error == 0.0)
+            return 99.0;
+
+        const double mse = error / double(samples);
+        return 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    // BC1 ---------------------------------------------------------------------------------
+
+    static inline uint16_t PackRGB565(const glm::vec3& color)
+    {
+        const int r = glm::clamp(static_cast<int>(color.r * 31.0f / 255.0f + 0.5f), 0, 31);
+        const int g = glm::clamp(static_cast<int>(color.g * 63.0f / 255.0f + 0.5f), 0, 63);
+        const int b = glm::clamp(static_cast<int>(color.b * 31.0f / 255.0f + 0.5f), 0, 31);
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    static inline glm::ivec3 UnpackRGB565(uint16_t color)
+    {
+        const int r = (color >> 11) & 31;
+        const int g = (color >> 5) & 63;
+        const int b = color & 31;
+        return glm::ivec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+    }
+
+    static void BuildBC1Palette(uint16_t c0, uint16_t c1, glm::ivec3 palette[4])
+    {
+        palette[0] = UnpackRGB565(c0);
+        palette[1] = UnpackRGB565(c1);
+        palette[2] = (palette[0] * 2 + palette[1]) / 3;
+        palette[3] = (palette[0] + palette[1] * 2) / 3;
+    }
+
+    static uint32_t SelectBC1Indices(const uint8_t* block, const glm::ivec3 palette[4], int* error = nullptr)
+    {
+        uint32_t indices = 0;
+        int totalError = 0;
+
+        for (int i = 0; i < 16; i++)
+        {
+            const glm::ivec3 color(block[i * 4 + 0], block[i * 4 + 1], block[i * 4 + 2]);
+            int best = 0;
+            int bestError = INT32_MAX;
+
+            for (int p = 0; p < 4; p++)
+            {
+                const glm::ivec3 d = color - palette[p];
+                const int e = d.x * d.x + d.y * d.y + d.z * d.z;
+                if (e < bestError)
+                {
+                    bestError = e;
+                    best = p;
+                }
+            }
+
+            indices |= uint32_t(best) << (i * 2);
+            totalError += bestError;
+        }
+
+        if (error)
+            *error = totalError;
+        return indices;
+    }
+
+    // Principal axis of the block colours by power iteration on the covariance matrix.
+    template<int N>
+    static void ComputePrincipalAxis(const uint8_t* block, glm::vec<N, float>& mean, glm::vec<N, float>& axis)
+    {
+        using Vec = glm::vec<N, float>;
+
+        mean = Vec(0.0f);
+        for (int i = 0; i < 16; i++)
+            for (int c = 0; c < N; c++)
+                mean[c] += block[i * 4 + c];
+        mean /= 16.0f;
+
+        float cov[N][N] = {};
+        for (int i = 0; i < 16; i++)
+        {
+            Vec d;
+            for (int c = 0; c < N; c++)
+                d[c] = block[i * 4 + c] - mean[c];
+
+            for (int r = 0; r < N; r++)
+                for (int c = 0; c < N; c++)
+                    cov[r][c] += d[r] * d[c];
+        }
+
+        axis = Vec(1.0f);
+        for (int c = 0; c < N; c++)
+            axis[c] = 1.0f + 0.1f * c;
+
+        for (int iteration = 0; iteration < 8; iteration++)
+        {
+            Vec next(0.0f);
+            for (int r = 0; r < N; r++)
+                for (int c = 0; c < N; c++)
+                    next[r] += cov[r][c] * axis[c];
+
+            const float length = glm::length(next);
+            if (length < 1e-6f)
+                break;
+            axis = next / length;
+        }
+
+    }
+
+    void TextureCompressor::EncodeBC1Block(const uint8_t* block, uint8_t* out)
+    {
+        glm::vec3 mean, axis;
+        ComputePrincipalAxis<3>(block, mean, axis);
+
+        float minProj = FLT_MAX;
+        float maxProj = -FLT_MAX;
+        for (int i = 0; i < 16; i++)
+        {
+            const glm::vec3 color(block[i * 4 + 0], block[i * 4 + 1], block[i * 4 + 2]);
+            const float proj = glm::dot(color - mean, axis);
+            minProj = std::min(minProj, proj);
+            maxProj = std::max(maxProj, proj);
+        }
+
+        uint16_t c0 = PackRGB565(glm::clamp(mean + axis * maxProj, glm::vec3(0.0f), glm::vec3(255.0f)));
+        uint16_t c1 = PackRGB565(glm::clamp(mean + axis * minProj, glm::vec3(0.0f), glm::vec3(255.0f)));
+
+        glm::ivec3 palette[4];
+        BuildBC1Palette(c0, c1, palette);
+        int bestError = 0;
+        uint32_t indices = SelectBC1Indices(block, palette, &bestError);
+
+        // One least squares pass on the endpoints for the chosen indices.
+        {
+            static const float weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+            float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+            glm::vec3 ax(0.0f), bx(0.0f);
+
+            for (int i = 0; i < 16; i++)
+            {
+                const float b = weights[(indices >> (i * 2)) & 3];
+                const float a = 1.0f - b;
+                const glm::vec3 color(block[i * 4 + 0], block[i * 4 + 1], block[i * 4 + 2]);
+                aa += a * a; bb += b * b; ab += a * b;
+                ax += a * color; bx += b * color;
+            }
+
+            const float det = aa * bb - ab * ab;
+            if (std::fabs(det) > 1e-6f)
+            {
+                const glm::vec3 e0 = (ax * bb - bx * ab) / det;
+                const glm::vec3 e1 = (bx * aa - ax * ab) / det;
+
+                const uint16_t r0 = PackRGB565(glm::clamp(e0, glm::vec3(0.0f), glm::vec3(255.0f)));
+                const uint16_t r1 = PackRGB565(glm::clamp(e1, glm::vec3(0.0f), glm::vec3(255.0f)));
+
+                glm::ivec3 refined[4];
+                BuildBC1Palette(r0, r1, refined);
+                int error = 0;
+                const uint32_t refinedIndices = SelectBC1Indices(block, refined, &error);
+
+                if (error < bestError)
+                {
+                    c0 = r0; c1 = r1;
+                    indices = refinedIndices;
+                    bestError = error;
+                }
+            }
+        }
+
+        // Four colour mode requires c0 > c1.
+        if (c0 < c1)
+        {
+            std::swap(c0, c1);
+            indices ^= 0x55555555;
+        }
+        else if (c0 == c1)
+        {
+            indices = 0;
+        }
+
+        std::memcpy(out + 0, &c0, 2);
+        std::memcpy(out + 2, &c1, 2);
+        std::memcpy(out + 4, &indices, 4);
+    }
+
+    void TextureCompressor::DecodeBC1Block(const uint8_t* in, uint8_t* block)
+    {
+        uint16_t c0, c1;
+        uint32_t indices;
+        std::memcpy(&c0, in + 0, 2);
+        std::memcpy(&c1, in + 2, 2);
+        std::memcpy(&indices, in + 4, 4);
+
+        glm::ivec3 palette[4];
+        glm::ivec4 colors[4];
+        BuildBC1Palette(c0, c1, palette);
+
+        for (int p = 0; p < 4; p++)
+            colors[p] = glm::ivec4(palette[p], 255);
+
+        if (c0 <= c1)
+        {
+            colors[2] = glm::ivec4((palette[0] + palette[1]) / 2, 255);
+            colors[3] = glm::ivec4(0);
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            const glm::ivec4& color = colors[(indices >> (i * 2)) & 3];
+            for (int c = 0; c < 4; c++)
+                block[i * 4 + c] = static_cast<uint8_t>(color[c]);
+        }
+    }
+
+    // BC4 / BC5 / BC3 alpha -----------------------------------------------------------------
+
+    static void BuildBC4Palette(int e0, int e1, int palette[8])
+    {
+        palette[0] = e0;
+        palette[1] = e1;
+
+        if (e0 > e1)
+        {
+            for (int i = 1; i < 7; i++)
+                palette[i + 1] = ((7 - i) * e0 + i * e1 + 3) / 7;
+        }
+        else
+        {
+            for (int i = 1; i < 5; i++)
+                palette[i + 1] = ((5 - i) * e0 + i * e1 + 2) / 5;
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+    }
+
+    void TextureCompressor::EncodeBC4Block(const uint8_t* block, int channel, uint8_t* out)
+    {
+        int minValue = 255;
+        int maxValue = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            minValue = std::min<int>(minValue, block[i * 4 + channel]);
+            maxValue = std::max<int>(maxValue, block[i * 4 + channel]);
+        }
+
+        uint64_t bits = 0;
+
+        if (maxValue > minValue)
+        {
+            int palette[8];
+            BuildBC4Palette(maxValue, minValue, palette);
+
+            for (int i = 0; i < 16; i++)
+            {
+                const int value = block[i * 4 + channel];
+                int best = 0;
+                int bestError = INT32_MAX;
+
+                for (int p = 0; p < 8; p++)
+                {
+                    const int e = std::abs(value - palette[p]);
+                    if (e < bestError)
+                    {
+                        bestError = e;
+                        best = p;
+                    }
+                }
+
+                bits |= uint64_t(best) << (i * 3);
+            }
+        }
+
+        out[0] = static_cast<uint8_t>(maxValue);
+        out[1] = static_cast<uint8_t>(minValue);
+        for (int i = 0; i < 6; i++)
+            out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+
+    void TextureCompressor::DecodeBC4Block(const uint8_t* in, int channel, uint8_t* block)
+    {
+        int palette[8];
+        BuildBC4Palette(in[0], in[1], palette);
+
+        uint64_t bits = 0;
+        for (int i = 0; i < 6; i++)
+            bits |= uint64_t(in[2 + i]) << (i * 8);
+
+        for (int i = 0; i < 16; i++)
+        {
+            block[i * 4 + channel] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+            if (channel == 0)
+            {
+                block[i * 4 + 1] = 0;
+                block[i * 4 + 2] = 0;
+                block[i * 4 + 3] = 255;
+            }
+        }
+    }
+
+    void TextureCompressor::EncodeBC5Block(const uint8_t* block, uint8_t* out)
+    {
+        EncodeBC4Block(block, 0, out);
+        EncodeBC4Block(block, 1, out + 8);
+    }
+
+    void TextureCompressor::DecodeBC5Block(const uint8_t* in, uint8_t* block)
+    {
+        DecodeBC4Block(in, 0, block);
+        DecodeBC4Block(in + 8, 1, block);
+    }
+
+    void TextureCompressor::EncodeBC3Block(const uint8_t* block, uint8_t* out)
+    {
+        EncodeBC4Block(block, 3, out);
+        EncodeBC1Block(block, out + 8);
+    }
+
+    void TextureCompressor::DecodeBC3Block(const uint8_t* in, uint8_t* block)
+    {
+        DecodeBC1Block(in + 8, block);
+
+        // The colour block of BC3 always decodes in four colour mode.
+        uint16_t c0, c1;
+        std::memcpy(&c0, in + 8, 2);
+        std::memcpy(&c1, in + 10, 2);
+        if (c0 <= c1)
+        {
+            uint32_t indices;
+            std::memcpy(&indices, in + 12, 4);
+
+            glm::ivec3 palette[4];
+            BuildBC1Palette(c0, c1, palette);
+            for (int i = 0; i < 16; i++)
+            {
+                const glm::ivec3& color = palette[(indices >> (i * 2)) & 3];
+                for (int c = 0; c < 3; c++)
+                    block[i * 4 + c] = static_cast<uint8_t>(color[c]);
+            }
+        }
+
+        DecodeBC4Block(in, 3, block);
+    }
+
+    // BC7 -----------------------------------------------------------------------------------
+    // The encoder only emits mode 6: one subset, RGBA 7.7.7.7 endpoints with a p-bit each and
+    // 4 bit indices. It is the highest quality single subset mode and covers alpha.
+
+    static const int s_BC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct BitWriter
+    {
+        uint8_t* m_Data;
+        int m_Offset = 0;
+
+        void Write(uint32_t value, int count)
+        {
+            for (int i = 0; i < count; i++, m_Offset++)
+            {
+                if (value & (1u << i))
+                    m_Data[m_Offset >> 3] |= static_cast<uint8_t>(1u << (m_Offset & 7));
+            }
+        }
+    };
+
+    struct BitReader
+    {
+        const uint8_t* m_Data;
+        int m_Offset = 0;
+
+        uint32_t Read(int count)
+        {
+            uint32_t value = 0;
+            for (int i = 0; i < count; i++, m_Offset++)
+                value |= uint32_t((m_Data[m_Offset >> 3] >> (m_Offset & 7)) & 1) << i;
+            return value;
+        }
+    };
+
+    static int EvaluateBC7Mode6(const uint8_t* block, const glm::ivec4& q0, const glm::ivec4& q1, int p0, int p1, uint8_t indices[16])
+    {
+        glm::ivec4 palette[16];
+        const glm::ivec4 e0 = q0 * 2 + p0;
+        const glm::ivec4 e1 = q1 * 2 + p1;
+
+        for (int i = 0; i < 16; i++)
+            palette[i] = ((64 - s_BC7Weights4[i]) * e0 + s_BC7Weights4[i] * e1 + 32) >> 6;
+
+        int total = 0;
+        for (int t = 0; t < 16; t++)
+        {
+            const glm::ivec4 color(block[t * 4 + 0], block[t * 4 + 1], block[t * 4 + 2], block[t * 4 + 3]);
+            int best = 0;
+            int bestError = INT32_MAX;
+
+            for (int i = 0; i < 16; i++)
+            {
+                const glm::ivec4 d = color - palette[i];
+                const int e = d.x * d.x + d.y * d.y + d.z * d.z + d.w * d.w;
+                if (e < bestError)
+                {
+                    bestError = e;
+                    best = i;
+                }
+            }
+
+            indices[t] = static_cast<uint8_t>(best);
+            total += bestError;
+        }
+
+        return total;
+    }
+
+    // Opaque blocks keep both p-bits set so alpha decodes to exactly 255.
+    static void FitBC7Mode6(const uint8_t* block, const glm::vec4& e0, const glm::vec4& e1, bool opaque,
+        glm::ivec4& bestQ0, glm::ivec4& bestQ1, int& bestP0, int& bestP1, uint8_t bestIndices[16], int& bestError)
+    {
+        for (int p0 = opaque ? 1 : 0; p0 < 2; p0++)
+        {
+            for (int p1 = opaque ? 1 : 0; p1 < 2; p1++)
+            {
+                const glm::ivec4 q0 = glm::clamp(glm::ivec4(glm::floor((e0 - float(p0)) * 0.5f + 0.5f)), glm::ivec4(0), glm::ivec4(127));
+                const glm::ivec4 q1 = glm::clamp(glm::ivec4(glm::floor((e1 - float(p1)) * 0.5f + 0.5f)), glm::ivec4(0), glm::ivec4(127));
+
+                uint8_t indices[16];
+                const int error = EvaluateBC7Mode6(block, q0, q1, p0, p1, indices);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestQ0 = q0; bestQ1 = q1;
+                    bestP0 = p0; bestP1 = p1;
+                    std::memcpy(bestIndices, indices, 16);
+                }
+            }
+        }
+    }
+
+    void TextureCompressor::EncodeBC7Block(const uint8_t* block, uint8_t* out)
+    {
+        glm::vec4 mean, axis;
+        ComputePrincipalAxis<4>(block, mean, axis);
+
+        float minProj = FLT_MAX;
+        float maxProj = -FLT_MAX;
+        for (int i = 0; i < 16; i++)
+        {
+            const glm::vec4 color(block[i * 4 + 0], block[i * 4 + 1], block[i * 4 + 2], block[i * 4 + 3]);
+            const float proj = glm::dot(color - mean, axis);
+            minProj = std::min(minProj, proj);
+            maxProj = std::max(maxProj, proj);
+        }
+
+        bool opaque = true;
+        for (int i = 0; i < 16 && opaque; i++)
+            opaque = block[i * 4 + 3] == 255;
+
+        glm::vec4 e0 = glm::clamp(mean + axis * minProj, glm::vec4(0.0f), glm::vec4(255.0f));
+        glm::vec4 e1 = glm::clamp(mean + axis * maxProj, glm::vec4(0.0f), glm::vec4(255.0f));
+
+        glm::ivec4 q0(0), q1(0);
+        int p0 = 0, p1 = 0;
+        uint8_t indices[16] = {};
+        int bestError = INT32_MAX;
+
+        FitBC7Mode6(block, e0, e1, opaque, q0, q1, p0, p1, indices, bestError);
+
+        // Least squares refinement of the endpoints for the chosen indices.
+        for (int iteration = 0; iteration < 2 && bestError > 0; iteration++)
+        {
+            float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+            glm::vec4 ax(0.0f), bx(0.0f);
+
+            for (int i = 0; i < 16; i++)
+            {
+                const float b = s_BC7Weights4[indices[i]] / 64.0f;
+                const float a = 1.0f - b;
+                const glm::vec4 color(block[i * 4 + 0], block[i * 4 + 1], block[i * 4 + 2], block[i * 4 + 3]);
+                aa += a * a; bb += b * b; ab += a * b;
+                ax += a * color; bx += b * color;
+            }
+
+            const float det = aa * bb - ab * ab;
+            if (std::fabs(det) < 1e-6f)
+                break;
+
+            e0 = glm::clamp((ax * bb - bx * ab) / det, glm::vec4(0.0f), glm::vec4(255.0f));
+            e1 = glm::clamp((bx * aa - ax * ab) / det, glm::vec4(0.0f), glm::vec4(255.0f));
+
+            const int previous = bestError;
+            FitBC7Mode6(block, e0, e1, opaque, q0, q1, p0, p1, indices, bestError);
+            if (bestError >= previous)
+                break;
+        }
+
+        // The anchor index stores only 3 bits, so its top bit must be zero.
+        if (indices[0] & 8)
+        {
+            std::swap(q0, q1);
+            std::swap(p0, p1);
+            for (int i = 0; i < 16; i++)
+                indices[i] = static_cast<uint8_t>(15 - indices[i]);
+        }
+
+        std::memset(out, 0, 16);
+        BitWriter writer{ out };
+        writer.Write(1u << 6, 7);
+
+        for (int c = 0; c < 4; c++)
+        {
+            writer.Write(static_cast<uint32_t>(q0[c]), 7);
+            writer.Write(static_cast<uint32_t>(q1[c]), 7);
+        }
+
+        writer.Write(static_cast<uint32_t>(p0), 1);
+        writer.Write(static_cast<uint32_t>(p1), 1);
+
+        writer.Write(indices[0], 3);
+        for (int i = 1; i < 16; i++)
+            writer.Write(indices[i], 4);
+    }
+
+    void TextureCompressor::DecodeBC7Block(const uint8_t* in, uint8_t* block)
+    {
+        // Only mode 6 is decoded; other modes come out black. The GPU decodes everything.
+        if ((in[0] & 0x7F) != 0x40)
+        {
+            std::memset(block, 0, 64);
+            return;
+        }
+
+        BitReader reader{ in };
+        reader.Read(7);
+
+        glm::ivec4 e0, e1;
+        for (int c = 0; c < 4; c++)
+        {
+            e0[c] = static_cast<int>(reader.Read(7));
+            e1[c] = static_cast<int>(reader.Read(7));
+        }
+
+        const int p0 = static_cast<int>(reader.Read(1));
+        const int p1 = static_cast<int>(reader.Read(1));
+        e0 = e0 * 2 + p0;
+        e1 = e1 * 2 + p1;
+
+        for (int i = 0; i < 16; i++)
+        {
+            const int index = static_cast<int>(reader.Read(i == 0 ? 3 : 4));
+            const glm::ivec4 color = ((64 - s_BC7Weights4[index]) * e0 + s_BC7Weights4[index] * e1 + 32) >> 6;
+            for (int c = 0; c < 4; c++)
+                block[i * 4 + c] = static_cast<uint8_t>(color[c]);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+// TextureCompressor.h
+#pragma once
+#include <Core/Common/Common.h>
+#include <Core/Graphics/Texture/Texture.h>
+
+namespace Isle
+{
+    struct CompressedMip
+    {
+        int m_Width = 0;
+        int m_Height = 0;
+        std::vector<uint8_t> m_Data;
+    };
+
+    struct CompressedImage
+    {
+        TEXTURE_FORMAT m_Format = TEXTURE_FORMAT::BC7;
+        int m_Width = 0;
+        int m_Height = 0;
+        std::vector<CompressedMip> m_Mips;
+
+        // Bytes of the levels from firstMip down to 1x1.
+        size_t GetSizeInBytes(int firstMip = 0) const;
+    };
+
+    // CPU block encoder for the cook step. All entry points take RGBA8 input and
+    // split the work across threads per row of 4x4 blocks. Pure CPU, no GL needed.
+    class ISLEENGINE_API TextureCompressor
+    {
+    public:
+        static constexpr uint32_t ENCODER_VERSION = 1;
+
+        static uint32_t GetBlockBytes(TEXTURE_FORMAT format);
+        static size_t GetCompressedSize(int width, int height, TEXTURE_FORMAT format);
+
+        static std::vector<uint8_t> Compress(const uint8_t* rgba, int width, int height, TEXTURE_FORMAT format);
+        static std::vector<uint8_t> Decompress(const uint8_t* blocks, int width, int height, TEXTURE_FORMAT format);
+
+        // Box filtered mip chain down to 1x1, every level compressed.
+        static CompressedImage CompressMipChain(const uint8_t* rgba, int width, int height, TEXTURE_FORMAT format);
+
+        static std::vector<uint8_t> ExpandToRGBA(const uint8_t* data, int width, int height, int channels);
+        static std::vector<uint8_t> Downsample(const uint8_t* rgba, int width, int height);
+
+        // PSNR in dB over the RGBA8 channels set in channelMask (bit 0 = R ... bit 3 = A).
+        static double ComputePSNR(const uint8_t* a, const uint8_t* b, int width, int height, uint32_t channelMask = 0xF);
+        static uint32_t GetChannelMask(TEXTURE_FORMAT format);
+
+        static void EncodeBC1Block(const uint8_t* block, uint8_t* out);
+        static void EncodeBC3Block(const uint8_t* block, uint8_t* out);
+        static void EncodeBC4Block(const uint8_t* block, int channel, uint8_t* out);
+        static void EncodeBC5Block(const uint8_t* block, uint8_t* out);
+        // BC7 is mode 6 only: one subset, RGBA 7.7.7.7 endpoints with p-bits and 4 bit indices.
+        // The decoder only reads what the encoder writes, blocks in any other mode come out black.
+        static void EncodeBC7Block(const uint8_t* block, uint8_t* out);
+
+        static void DecodeBC1Block(const uint8_t* in, uint8_t* block);
+        static void DecodeBC3Block(const uint8_t* in, uint8_t* block);
+        static void DecodeBC4Block(const uint8_t* in, int channel, uint8_t* block);
+        static void DecodeBC5Block(const uint8_t* in, uint8_t* block);
+        static void DecodeBC7Block(const uint8_t* in, uint8_t* block);
+    };
+}
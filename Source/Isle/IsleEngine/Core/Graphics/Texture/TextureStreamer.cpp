@@ -0,0 +1,262 @@
+// TextureStreamer.cpp
+#include "TextureStreamer.h"
+#include "TextureCompressor.h"
+
+namespace Isle
+{
+    static constexpr uint32_t NO_FEEDBACK = 0xFFFFFFFFu;
+
+    void TextureStreamer::Start()
+    {
+        m_FeedbackBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+        m_ReadbackBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+        m_ResidencyBuffer = New<GfxBuffer>(GFX_BUFFER_TYPE::STORAGE);
+
+        m_FeedbackBuffer->SetDebugLabel("StreamingFeedback");
+        m_ReadbackBuffer->SetDebugLabel("StreamingReadback");
+        m_ResidencyBuffer->SetDebugLabel("StreamingResidency");
+    }
+
+    void TextureStreamer::Destroy()
+    {
+        if (m_ReadbackFence)
+        {
+            GfxDevice::Get()->DeleteSync(m_ReadbackFence);
+            m_ReadbackFence = nullptr;
+        }
+
+        m_FeedbackBuffer = nullptr;
+        m_ReadbackBuffer = nullptr;
+        m_ResidencyBuffer = nullptr;
+        m_Streamed.clear();
+        m_ResidentBytes = 0;
+    }
+
+    void TextureStreamer::Clear()
+    {
+        Destroy();
+        Start();
+    }
+
+    void TextureStreamer::Register(Texture* texture)
+    {
+        if (!texture || texture->m_BindlessIndex == static_cast<uint32_t>(-1))
+            return;
+
+        const uint32_t index = texture->m_BindlessIndex;
+        while (m_FeedbackBuffer->GetDataCount<uint32_t>() <= index)
+        {
+            m_FeedbackBuffer->Add<uint32_t>(NO_FEEDBACK);
+            m_ResidencyBuffer->Add<uint32_t>(0);
+        }
+
+        m_ResidencyBuffer->GetDataPtr<uint32_t>()[index] = static_cast<uint32_t>(texture->m_ResidentMip);
+        m_ResidencyBuffer->MarkDirty();
+        m_ResidentBytes += texture->GetSizeInBytes();
+
+        if (!texture->m_StreamSource)
+            return;
+
+        // Whatever the importer uploaded is the tail that never leaves VRAM.
+        StreamedTexture entry;
+        entry.m_Texture = texture;
+        entry.m_TailMip = texture->m_ResidentMip;
+        entry.m_DesiredMip = texture->m_ResidentMip;
+        entry.m_LastUsed = m_Frame;
+        m_Streamed.push_back(entry);
+    }
+
+    void TextureStreamer::Unregister(Texture* texture)
+    {
+        if (!texture || texture->m_BindlessIndex == static_cast<uint32_t>(-1))
+            return;
+
+        const uint32_t index = texture->m_BindlessIndex;
+        if (index < m_FeedbackBuffer->GetDataCount<uint32_t>())
+        {
+            m_FeedbackBuffer->GetDataPtr<uint32_t>()[index] = NO_FEEDBACK;
+            m_ResidencyBuffer->GetDataPtr<uint32_t>()[index] = 0;
+            m_FeedbackBuffer->MarkDirty(index * sizeof(uint32_t), sizeof(uint32_t));
+            m_ResidencyBuffer->MarkDirty(index * sizeof(uint32_t), sizeof(uint32_t));
+        }
+
+        m_ResidentBytes -= std::min(m_ResidentBytes, texture->GetSizeInBytes());
+
+        for (size_t i = 0; i < m_Streamed.size(); i++)
+        {
+            if (m_Streamed[i].m_Texture != texture)
+                continue;
+
+            m_Streamed[i] = m_Streamed.back();
+            m_Streamed.pop_back();
+            break;
+        }
+    }
+
+    void TextureStreamer::Bind()
+    {
+        m_FeedbackBuffer->Upload();
+        m_ResidencyBuffer->Upload();
+
+        m_FeedbackBuffer->Bind(11);
+        m_ResidencyBuffer->Bind(12);
+    }
+
+    void TextureStreamer::RequestFeedback()
+    {
+        if (m_ReadbackFence || m_FeedbackBuffer->GetSize() == 0 || m_Frame % std::max(m_FeedbackInterval, 1) != 0)
+            return;
+
+        const GLsizeiptr size = m_FeedbackBuffer->GetSize();
+        if (m_ReadbackBuffer->GetSize() != size)
+            m_ReadbackBuffer->Create(GFX_BUFFER_TYPE::STORAGE, size, nullptr, GFX_BUFFER_USAGE::STREAM);
+
+        GfxDevice* device = GfxDevice::Get();
+        device->Barrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        device->CopyBufferSubData(m_FeedbackBuffer->GetId(), m_ReadbackBuffer->GetId(), 0, 0, size);
+
+        // Not GfxBuffer::Clear(), the CPU copy has to stay at NO_FEEDBACK for the next regrow.
+        const uint32_t clearValue = NO_FEEDBACK;
+        device->ClearBufferData(m_FeedbackBuffer->GetId(), GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &clearValue);
+
+        m_ReadbackFence = device->FenceSync();
+    }
+
+    void TextureStreamer::Update(std::vector<Texture*>& outChanged)
+    {
+        m_Frame++;
+
+        if (m_ReadbackFence)
+        {
+            GfxDevice* device = GfxDevice::Get();
+            if (device->IsSignaled(m_ReadbackFence))
+            {
+                device->DeleteSync(m_ReadbackFence);
+                m_ReadbackFence = nullptr;
+
+                m_ReadbackBuffer->Download();
+                ApplyFeedback();
+            }
+        }
+
+        // The budget may have been lowered since the last frame.
+        MakeRoom(0, nullptr, outChanged);
+
+        std::vector<StreamedTexture*> requests;
+        for (StreamedTexture& entry : m_Streamed)
+        {
+            if (entry.m_DesiredMip < entry.m_Texture->m_ResidentMip)
+                requests.push_back(&entry);
+        }
+
+        // Most recently seen first, then the ones furthest from what they need.
+        std::sort(requests.begin(), requests.end(), [](const StreamedTexture* a, const StreamedTexture* b)
+        {
+            if (a->m_LastUsed != b->m_LastUsed)
+                return a->m_LastUsed > b->m_LastUsed;
+            return (a->m_Texture->m_ResidentMip - a->m_DesiredMip) > (b->m_Texture->m_ResidentMip - b->m_DesiredMip);
+        });
+
+        size_t uploaded = 0;
+        for (StreamedTexture* entry : requests)
+        {
+            const CompressedImage& image = *entry->m_Texture->m_StreamSource;
+            const int resident = entry->m_Texture->m_ResidentMip;
+            const size_t residentBytes = image.GetSizeInBytes(resident);
+
+            // Settle for a coarser level when the finest one does not fit this frame.
+            for (int target = entry->m_DesiredMip; target < resident; target++)
+            {
+                const size_t bytes = image.GetSizeInBytes(target) - residentBytes;
+                if (uploaded + bytes > m_UploadBytesPerFrame)
+                    continue;
+
+                if (!MakeRoom(bytes, entry, outChanged))
+                    continue;
+
+                SetResidentMip(*entry, target, outChanged);
+                uploaded += bytes;
+                break;
+            }
+        }
+    }
+
+    void TextureStreamer::ApplyFeedback()
+    {
+        const uint32_t* feedback = m_ReadbackBuffer->GetDataPtr<uint32_t>();
+        const size_t count = m_ReadbackBuffer->GetDataCount<uint32_t>();
+
+        for (StreamedTexture& entry : m_Streamed)
+        {
+            const uint32_t index = entry.m_Texture->m_BindlessIndex;
+            if (index >= count)
+                continue;
+
+            if (feedback[index] == NO_FEEDBACK)
+            {
+                entry.m_DesiredMip = entry.m_TailMip;
+                continue;
+            }
+
+            entry.m_DesiredMip = std::min(static_cast<int>(feedback[index]), entry.m_TailMip);
+            entry.m_LastUsed = m_Frame;
+        }
+    }
+
+    bool TextureStreamer::MakeRoom(size_t bytes, const StreamedTexture* requester, std::vector<Texture*>& outChanged)
+    {
+        while (m_ResidentBytes + bytes > m_BudgetBytes)
+        {
+            // Least recently used texture holding finer mips than it asked for. Nothing
+            // seen more recently than the requester is touched.
+            StreamedTexture* victim = nullptr;
+            for (StreamedTexture& entry : m_Streamed)
+            {
+                if (&entry == requester || entry.m_Texture->m_ResidentMip >= entry.m_DesiredMip)
+                    continue;
+
+                if (requester && entry.m_LastUsed > requester->m_LastUsed)
+                    continue;
+
+                if (!victim || entry.m_LastUsed < victim->m_LastUsed ||
+                    (entry.m_LastUsed == victim->m_LastUsed && entry.m_Texture->GetSizeInBytes() > victim->m_Texture->GetSizeInBytes()))
+                {
+                    victim = &entry;
+                }
+            }
+
+            if (!victim || !SetResidentMip(*victim, victim->m_DesiredMip, outChanged))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool TextureStreamer::SetResidentMip(StreamedTexture& entry, int mip, std::vector<Texture*>& outChanged)
+    {
+        Texture* texture = entry.m_Texture;
+        const size_t before = texture->GetSizeInBytes();
+
+        if (!texture->SetResidentMip(mip))
+            return false;
+
+        m_ResidentBytes = m_ResidentBytes - before + texture->GetSizeInBytes();
+
+        m_ResidencyBuffer->GetDataPtr<uint32_t>()[texture->m_BindlessIndex] = static_cast<uint32_t>(texture->m_ResidentMip);
+        m_ResidencyBuffer->MarkDirty();
+
+        outChanged.push_back(texture);
+        return true;
+    }
+
+    int TextureStreamer::GetTailMip(const CompressedImage& image, int tailResolution)
+    {
+        for (size_t level = 0; level < image.m_Mips.size(); level++)
+        {
+            const CompressedMip& mip = image.m_Mips[level];
+            if (mip.m_Width <= tailResolution && mip.m_Height <= tailResolution)
+                return static_cast<int>(level);
+        }
+        return image.m_Mips.empty() ? 0 : static_cast<int>(image.m_Mips.size()) - 1;
+    }
+}
@@ -0,0 +1,69 @@
+// TextureStreamer.h
+#pragma once
+#include <Core/Common/Common.h>
+#include <Core/Graphics/Texture/Texture.h>
+#include <Core/Graphics/GfxBuffer/GfxBuffer.h>
+
+namespace Isle
+{
+    // Moves the finest resident mip of streamed textures up and down the chain.
+    // The geometry pass writes the finest mip it wanted per bindless index into the
+    // feedback buffer (binding 11), every resident mip is published in the residency
+    // buffer (binding 12) so the shader can report absolute levels. Feedback is copied
+    // out and read back a few frames later behind a fence, so the CPU never waits on it.
+    class ISLEENGINE_API TextureStreamer
+    {
+    private:
+        struct StreamedTexture
+        {
+            Texture* m_Texture = nullptr;
+            int m_TailMip = 0;
+            int m_DesiredMip = 0;
+            uint64_t m_LastUsed = 0;
+        };
+
+        Ref<GfxBuffer> m_FeedbackBuffer;
+        Ref<GfxBuffer> m_ReadbackBuffer;
+        Ref<GfxBuffer> m_ResidencyBuffer;
+        GLsync m_ReadbackFence = nullptr;
+
+        std::vector<StreamedTexture> m_Streamed;
+        uint64_t m_Frame = 0;
+        size_t m_ResidentBytes = 0;
+
+    public:
+        size_t m_BudgetBytes = size_t(512) << 20;
+        size_t m_UploadBytesPerFrame = size_t(32) << 20;
+        int m_FeedbackInterval = 4;
+
+    public:
+        void Start();
+        void Destroy();
+        void Clear();
+
+        void Register(Texture* texture);
+
+        // Call before the texture's bindless index is released or the texture is destroyed.
+        void Unregister(Texture* texture);
+
+        void Bind();
+
+        // Called once the geometry pass has been submitted.
+        void RequestFeedback();
+
+        // Applies finished feedback and rebalances residency. Textures whose GL object
+        // changed are appended to outChanged and need their bindless handle republished.
+        void Update(std::vector<Texture*>& outChanged);
+
+        size_t GetResidentBytes() const { return m_ResidentBytes; }
+        size_t GetNumStreamed() const { return m_Streamed.size(); }
+
+        // Finest mip no larger than tailResolution on either axis.
+        static int GetTailMip(const CompressedImage& image, int tailResolution);
+
+    private:
+        void ApplyFeedback();
+        bool MakeRoom(size_t bytes, const StreamedTexture* requester, std::vector<Texture*>& outChanged);
+        bool SetResidentMip(StreamedTexture& entry, int mip, std::vector<Texture*>& outChanged);
+    };
+}
@@ -17,22 +17,21 @@ namespace Isle
         m_Format = format;
         m_GenerateMipmaps = generateMipmaps;
 
+        GfxDevice* device = GfxDevice::Get();
         if (!m_Id)
-            glGenTextures(1, &m_Id);
-
-        glBindTexture(GL_TEXTURE_3D, m_Id);
+            m_Id = device->CreateTexture(GL_TEXTURE_3D);
 
         GLenum internalFormat = ResolveInternalFormat(format);
         GLenum dataFormat = ResolveFormat(format);
         GLenum dataType = ResolveDataType(format);
 
-        // Use glTexStorage3D for better image load/store compatibility
+        // Use immutable storage for better image load/store compatibility
         if (!data) {
             int levels = generateMipmaps ? (int)glm::floor(glm::log2((float)glm::max(width, glm::max(height, depth)))) + 1 : 1;
-            glTexStorage3D(GL_TEXTURE_3D, levels, internalFormat, width, height, depth);
+            device->TexStorage(GL_TEXTURE_3D, m_Id, levels, internalFormat, width, height, depth);
         }
         else {
-            glTexImage3D(GL_TEXTURE_3D, 0, internalFormat, width, height, depth, 0,
+            device->TexImage(GL_TEXTURE_3D, m_Id, 0, internalFormat, width, height, depth,
                 dataFormat, dataType, data);
         }
 
@@ -43,22 +42,22 @@ namespace Isle
         if (generateMipmaps && data)
             GenerateMipmaps();
 
-        glBindTexture(GL_TEXTURE_3D, 0);
-
         m_IsLoaded = true;
-        m_SizeInBytes = width * height * depth * 4;
+        SetSizeInBytes(CalculateTextureSize(width, height, depth, format, generateMipmaps));
+        if (data)
+            RecordUpload(CalculateTextureSize(width, height, depth, format));
     }
 
     void Texture3D::Destroy()
     {
         if (m_Id)
         {
-            glDeleteTextures(1, &m_Id);
+            GfxDevice::Get()->DestroyTexture(m_Id);
             m_Id = 0;
         }
         m_IsLoaded = false;
         m_IsResident = false;
-        m_SizeInBytes = 0;
+        SetSizeInBytes(0);
         m_Slot = -1;
         m_ImageSlot = -1;
     }
@@ -71,46 +70,40 @@ namespace Isle
     void Texture3D::Bind(uint32_t slot)
     {
         if (!m_Id) return;
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_3D, m_Id);
+        GfxDevice::Get()->BindTexture(slot, GL_TEXTURE_3D, m_Id);
         m_Slot = slot;
         m_IsResident = true;
     }
 
     void Texture3D::Unbind(uint32_t slot)
     {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_3D, 0);
+        GfxDevice::Get()->BindTexture(slot, GL_TEXTURE_3D, 0);
         m_IsResident = false;
         m_Slot = -1;
     }
 
     void Texture3D::BindAsImage(GLuint unit, GLenum access, GLint level)
     {
-        glBindImageTexture(unit, m_Id, level, GL_TRUE, 0, access, ResolveInternalFormat(m_Format));
+        GfxDevice::Get()->BindImageTexture(unit, m_Id, level, GL_TRUE, access, ResolveInternalFormat(m_Format));
         m_ImageSlot = unit;
     }
 
     void Texture3D::UnbindAsImage(uint32_t slot)
     {
-        glBindImageTexture(slot, 0, 0, GL_TRUE, 0, GL_READ_WRITE, GL_RGBA8);
+        GfxDevice::Get()->BindImageTexture(slot, 0, 0, GL_TRUE, GL_READ_WRITE, GL_RGBA8);
         m_ImageSlot = -1;
     }
 
     void Texture3D::SetMinFilter(TEXTURE3D_FILTER filter)
     {
         m_MinFilter = filter;
-        glBindTexture(GL_TEXTURE_3D, m_Id);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, ResolveFilter(filter));
-        glBindTexture(GL_TEXTURE_3D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_3D, m_Id, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(ResolveFilter(filter)));
     }
 
     void Texture3D::SetMagFilter(TEXTURE3D_FILTER filter)
     {
         m_MagFilter = filter;
-        glBindTexture(GL_TEXTURE_3D, m_Id);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, ResolveFilter(filter));
-        glBindTexture(GL_TEXTURE_3D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_3D, m_Id, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(ResolveFilter(filter)));
     }
 
     void Texture3D::SetWrap(TEXTURE3D_WRAP wrapS, TEXTURE3D_WRAP wrapT, TEXTURE3D_WRAP wrapR)
@@ -118,51 +111,43 @@ namespace Isle
         m_WrapS = wrapS;
         m_WrapT = wrapT;
         m_WrapR = wrapR;
-        glBindTexture(GL_TEXTURE_3D, m_Id);
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, ResolveWrap(wrapS));
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, ResolveWrap(wrapT));
-        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, ResolveWrap(wrapR));
-        glBindTexture(GL_TEXTURE_3D, 0);
+        GfxDevice* device = GfxDevice::Get();
+        device->TexParameter(GL_TEXTURE_3D, m_Id, GL_TEXTURE_WRAP_S, static_cast<GLint>(ResolveWrap(wrapS)));
+        device->TexParameter(GL_TEXTURE_3D, m_Id, GL_TEXTURE_WRAP_T, static_cast<GLint>(ResolveWrap(wrapT)));
+        device->TexParameter(GL_TEXTURE_3D, m_Id, GL_TEXTURE_WRAP_R, static_cast<GLint>(ResolveWrap(wrapR)));
     }
 
     void Texture3D::SetBorderColor(const glm::vec4& color)
     {
-        glBindTexture(GL_TEXTURE_3D, m_Id);
-        glTexParameterfv(GL_TEXTURE_3D, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(color));
-        glBindTexture(GL_TEXTURE_3D, 0);
+        GfxDevice::Get()->TexParameter(GL_TEXTURE_3D, m_Id, GL_TEXTURE_BORDER_COLOR, glm::value_ptr(color));
     }
 
     void Texture3D::Upload(const void* data, int level)
     {
-        glBindTexture(GL_TEXTURE_3D, m_Id);
         GLenum format = ResolveFormat(m_Format);
         GLenum type = ResolveDataType(m_Format);
-        glTexSubImage3D(GL_TEXTURE_3D, level, 0, 0, 0, m_Width, m_Height, m_Depth,
+        GfxDevice::Get()->TexSubImage(GL_TEXTURE_3D, m_Id, level, m_Width, m_Height, m_Depth,
                        format, type, data);
-        glBindTexture(GL_TEXTURE_3D, 0);
+
+        RecordUpload(CalculateTextureSize(
+            std::max(m_Width >> level, 1), std::max(m_Height >> level, 1), std::max(m_Depth >> level, 1), m_Format));
     }
 
     void Texture3D::Download(void* outData, int level) const
     {
-        glBindTexture(GL_TEXTURE_3D, m_Id);
         GLenum format = ResolveFormat(m_Format);
         GLenum type = ResolveDataType(m_Format);
-        glGetTexImage(GL_TEXTURE_3D, level, format, type, outData);
-        glBindTexture(GL_TEXTURE_3D, 0);
+        GfxDevice::Get()->GetTexImage(GL_TEXTURE_3D, m_Id, level, format, type, outData);
     }
 
     void Texture3D::GenerateMipmaps()
     {
-        glBindTexture(GL_TEXTURE_3D, m_Id);
-        glGenerateMipmap(GL_TEXTURE_3D);
-        glBindTexture(GL_TEXTURE_3D, 0);
+        GfxDevice::Get()->GenerateMipmap(GL_TEXTURE_3D, m_Id);
     }
 
     void Texture3D::Clear(const glm::vec4& clearColor)
     {
-        glBindTexture(GL_TEXTURE_3D, m_Id);
-        glClearTexImage(m_Id, 0, GL_RGBA, GL_FLOAT, glm::value_ptr(clearColor));
-        glBindTexture(GL_TEXTURE_3D, 0);
+        GfxDevice::Get()->ClearTexImage(m_Id, 0, GL_RGBA, GL_FLOAT, glm::value_ptr(clearColor));
     }
 
     void Texture3D::Resize(int width, int height, int depth)
@@ -171,21 +156,57 @@ namespace Isle
         m_Height = height;
         m_Depth = depth;
 
-        glBindTexture(GL_TEXTURE_3D, m_Id);
         GLenum internalFormat = ResolveInternalFormat(m_Format);
         GLenum format = ResolveFormat(m_Format);
         GLenum type = ResolveDataType(m_Format);
-        glTexImage3D(GL_TEXTURE_3D, 0, internalFormat, width, height, depth, 0,
+        GfxDevice::Get()->TexImage(GL_TEXTURE_3D, m_Id, 0, internalFormat, width, height, depth,
                     format, type, nullptr);
-        glBindTexture(GL_TEXTURE_3D, 0);
 
-        m_SizeInBytes = width * height * depth * 4;
+        SetSizeInBytes(CalculateTextureSize(width, height, depth, m_Format));
     }
 
     void Texture3D::SetDebugLabel(const std::string& name)
     {
-        if (glObjectLabel)
-            glObjectLabel(GL_TEXTURE, m_Id, -1, name.c_str());
+        GfxResourceTracker::SetLabel(this, name);
+        GfxDevice::Get()->SetObjectLabel(GL_TEXTURE, m_Id, name);
+    }
+
+    size_t Texture3D::CalculateTextureSize(int width, int height, int depth, TEXTURE3D_FORMAT format, bool mipmaps)
+    {
+        size_t bytesPerTexel = 4;
+        switch (format)
+        {
+        case TEXTURE3D_FORMAT::R8: bytesPerTexel = 1; break;
+        case TEXTURE3D_FORMAT::RG8: bytesPerTexel = 2; break;
+        case TEXTURE3D_FORMAT::RGB8: bytesPerTexel = 3; break;
+        case TEXTURE3D_FORMAT::RGBA8: bytesPerTexel = 4; break;
+        case TEXTURE3D_FORMAT::R16F: bytesPerTexel = 2; break;
+        case TEXTURE3D_FORMAT::RG16F: bytesPerTexel = 4; break;
+        case TEXTURE3D_FORMAT::RGB16F: bytesPerTexel = 6; break;
+        case TEXTURE3D_FORMAT::RGBA16F: bytesPerTexel = 8; break;
+        case TEXTURE3D_FORMAT::R32F: bytesPerTexel = 4; break;
+        case TEXTURE3D_FORMAT::RG32F: bytesPerTexel = 8; break;
+        case TEXTURE3D_FORMAT::RGB32F: bytesPerTexel = 12; break;
+        case TEXTURE3D_FORMAT::RGBA32F: bytesPerTexel = 16; break;
+        case TEXTURE3D_FORMAT::R32UI: bytesPerTexel = 4; break;
+        case TEXTURE3D_FORMAT::RG32UI: bytesPerTexel = 8; break;
+        case TEXTURE3D_FORMAT::RGB32UI: bytesPerTexel = 12; break;
+        case TEXTURE3D_FORMAT::RGBA32UI: bytesPerTexel = 16; break;
+        default: bytesPerTexel = 4; break;
+        }
+
+        size_t total = 0;
+        while (true)
+        {
+            total += size_t(width) * height * depth * bytesPerTexel;
+            if (!mipmaps || (width == 1 && height == 1 && depth == 1))
+                break;
+
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+            depth = std::max(depth / 2, 1);
+        }
+        return total;
     }
 
     GLenum Texture3D::ResolveInternalFormat(TEXTURE3D_FORMAT format)
@@ -2,6 +2,7 @@
 #pragma once
 #include <Core/Common/Common.h>
 #include <Core/Graphics/GfxResource/GfxResource.h>
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
 
 namespace Isle
 {
@@ -72,7 +73,7 @@ namespace Isle
         bool m_GenerateMipmaps = false;
 
     public:
-        Texture3D() = default;
+        Texture3D() : GfxResource(GFX_RESOURCE_CATEGORY::TEXTURE3D) {}
         ~Texture3D() override;
 
         void Create(int width, int height, int depth, TEXTURE3D_FORMAT format,
@@ -100,6 +101,7 @@ namespace Isle
 
         void SetDebugLabel(const std::string& name);
 
+        static size_t CalculateTextureSize(int width, int height, int depth, TEXTURE3D_FORMAT format, bool mipmaps = false);
         static GLenum ResolveInternalFormat(TEXTURE3D_FORMAT format);
         static GLenum ResolveFormat(TEXTURE3D_FORMAT format);
         static GLenum ResolveDataType(TEXTURE3D_FORMAT format);
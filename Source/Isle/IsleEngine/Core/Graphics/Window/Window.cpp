@@ -1,4 +1,5 @@
 #include "Window.h"
+#include <Core/Graphics/GfxDevice/GfxDevice.h>
 
 namespace Isle
 {
@@ -65,7 +66,6 @@ namespace Isle
 
 	void Window::Clear(const glm::vec4& color)
 	{
-		glClearColor(color.r, color.g, color.b, color.a);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		GfxDevice::Get()->Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, color);
 	}
 }
\ No newline at end of file
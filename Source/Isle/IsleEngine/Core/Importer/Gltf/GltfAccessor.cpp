@@ -0,0 +1,577 @@
+// GltfAccessor.cpp
+#include "GltfAccessor.h"
+#include <cstring>
+#include <emmintrin.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace Isle
+{
+    uint32_t AccessorView::GetComponentSize(ACCESSOR_COMPONENT type)
+    {
+        switch (type)
+        {
+        case ACCESSOR_COMPONENT::BYTE:
+        case ACCESSOR_COMPONENT::UNSIGNED_BYTE:     return 1;
+        case ACCESSOR_COMPONENT::SHORT:
+        case ACCESSOR_COMPONENT::UNSIGNED_SHORT:    return 2;
+        case ACCESSOR_COMPONENT::UNSIGNED_INT:
+        case ACCESSOR_COMPONENT::FLOAT:             return 4;
+        default:                                    return 0;
+        }
+    }
+
+    bool AccessorView::IsTightlyPackedFloat() const
+    {
+        return m_ComponentType == ACCESSOR_COMPONENT::FLOAT && m_Stride == GetElementSize();
+    }
+
+    template<typename T>
+    static inline T LoadUnaligned(const uint8_t* src)
+    {
+        T value;
+        std::memcpy(&value, src, sizeof(T));
+        return value;
+    }
+
+    static inline float ReadComponent(const uint8_t* src, ACCESSOR_COMPONENT type, bool normalized)
+    {
+        switch (type)
+        {
+        case ACCESSOR_COMPONENT::FLOAT:
+            return LoadUnaligned<float>(src);
+        case ACCESSOR_COMPONENT::BYTE:
+        {
+            float v = static_cast<float>(LoadUnaligned<int8_t>(src));
+            return normalized ? std::max(v / 127.0f, -1.0f) : v;
+        }
+        case ACCESSOR_COMPONENT::UNSIGNED_BYTE:
+        {
+            float v = static_cast<float>(LoadUnaligned<uint8_t>(src));
+            return normalized ? v / 255.0f : v;
+        }
+        case ACCESSOR_COMPONENT::SHORT:
+        {
+            float v = static_cast<float>(LoadUnaligned<int16_t>(src));
+            return normalized ? std::max(v / 32767.0f, -1.0f) : v;
+        }
+        case ACCESSOR_COMPONENT::UNSIGNED_SHORT:
+        {
+            float v = static_cast<float>(LoadUnaligned<uint16_t>(src));
+            return normalized ? v / 65535.0f : v;
+        }
+        case ACCESSOR_COMPONENT::UNSIGNED_INT:
+        {
+            float v = static_cast<float>(LoadUnaligned<uint32_t>(src));
+            return normalized ? v / 4294967295.0f : v;
+        }
+        default:
+            return 0.0f;
+        }
+    }
+
+    // Fixed size copies let the compiler turn the strided gather into plain vector moves.
+    template<uint32_t N>
+    static void GatherFloats(const AccessorView& view, float* out, size_t outStride)
+    {
+        const uint8_t* src = view.m_Data;
+        for (size_t i = 0; i < view.m_Count; i++, src += view.m_Stride, out += outStride)
+            std::memcpy(out, src, N * sizeof(float));
+    }
+
+    void GltfAccessor::ReadFloats(const AccessorView& view, uint32_t outComponents, float* out, size_t outStride)
+    {
+        const uint32_t components = std::min(view.m_Components, outComponents);
+        if (outStride == 0)
+            outStride = outComponents;
+
+        if (view.IsTightlyPackedFloat() && view.m_Components == outComponents && outStride == outComponents)
+        {
+            std::memcpy(out, view.m_Data, view.m_Count * outComponents * sizeof(float));
+            return;
+        }
+
+        if (view.m_ComponentType == ACCESSOR_COMPONENT::FLOAT && components == outComponents)
+        {
+            switch (components)
+            {
+            case 1: GatherFloats<1>(view, out, outStride); return;
+            case 2: GatherFloats<2>(view, out, outStride); return;
+            case 3: GatherFloats<3>(view, out, outStride); return;
+            case 4: GatherFloats<4>(view, out, outStride); return;
+            default: break;
+            }
+        }
+
+        const uint32_t componentSize = AccessorView::GetComponentSize(view.m_ComponentType);
+
+        for (size_t i = 0; i < view.m_Count; i++)
+        {
+            const uint8_t* src = view.m_Data + i * view.m_Stride;
+            float* dst = out + i * outStride;
+
+            for (uint32_t c = 0; c < components; c++)
+                dst[c] = ReadComponent(src + c * componentSize, view.m_ComponentType, view.m_Normalized);
+            for (uint32_t c = components; c < outComponents; c++)
+                dst[c] = 0.0f;
+        }
+    }
+
+    void GltfAccessor::ReadIndices(const AccessorView& view, unsigned int* out)
+    {
+        const size_t count = view.m_Count;
+        const uint32_t size = AccessorView::GetComponentSize(view.m_ComponentType);
+
+        // Index buffer views may not declare a stride, but stay correct if one does.
+        if (view.m_Stride != size)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                const uint8_t* src = view.m_Data + i * view.m_Stride;
+                switch (view.m_ComponentType)
+                {
+                case ACCESSOR_COMPONENT::UNSIGNED_BYTE:     out[i] = LoadUnaligned<uint8_t>(src); break;
+                case ACCESSOR_COMPONENT::UNSIGNED_SHORT:    out[i] = LoadUnaligned<uint16_t>(src); break;
+                default:                                    out[i] = LoadUnaligned<uint32_t>(src); break;
+                }
+            }
+            return;
+        }
+
+        size_t i = 0;
+        const __m128i zero = _mm_setzero_si128();
+
+        switch (view.m_ComponentType)
+        {
+        case ACCESSOR_COMPONENT::UNSIGNED_BYTE:
+        {
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(view.m_Data + i));
+                __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+                __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 0), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+            }
+            for (; i < count; i++)
+                out[i] = view.m_Data[i];
+            break;
+        }
+        case ACCESSOR_COMPONENT::UNSIGNED_SHORT:
+        {
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i shorts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(view.m_Data + i * 2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 0), _mm_unpacklo_epi16(shorts, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(shorts, zero));
+            }
+            for (; i < count; i++)
+                out[i] = LoadUnaligned<uint16_t>(view.m_Data + i * 2);
+            break;
+        }
+        default:
+            std::memcpy(out, view.m_Data, count * sizeof(uint32_t));
+            break;
+        }
+    }
+
+    // Normalize, clamp, scale by 511 and truncate: the same sequence GpuVertex::PackNormalTangent runs per vertex.
+    static inline __m128i PackLanes(__m128 nx, __m128 ny, __m128 nz, __m128 tx, __m128 ty, __m128 tz)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 minusOne = _mm_set1_ps(-1.0f);
+        const __m128 scale = _mm_set1_ps(511.0f);
+        const __m128i mask = _mm_set1_epi32(0x3FF);
+
+        __m128 nInv = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz))));
+        __m128 tInv = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz))));
+
+        auto quantize = [&](__m128 v, __m128 inv) {
+            v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, inv), minusOne), one);
+            return _mm_cvttps_epi32(_mm_mul_ps(v, scale));
+            };
+
+        __m128i ix = quantize(nx, nInv);
+        __m128i iy = quantize(ny, nInv);
+        __m128i iz = quantize(nz, nInv);
+        __m128i itx = quantize(tx, tInv);
+
+        __m128i packed = _mm_and_si128(ix, mask);
+        packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(iy, mask), 10));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(iz, mask), 20));
+        packed = _mm_or_si128(packed, _mm_and_si128(_mm_cmplt_epi32(itx, _mm_setzero_si128()), _mm_set1_epi32(1 << 30)));
+        return packed;
+    }
+
+#if defined(__AVX__)
+    static inline void PackLanes8(const __m256 lanes[6], uint32_t* result)
+    {
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 minusOne = _mm256_set1_ps(-1.0f);
+        const __m256 scale = _mm256_set1_ps(511.0f);
+
+        auto inverseLength = [&](__m256 x, __m256 y, __m256 z) {
+            return _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z))));
+            };
+
+        auto quantize = [&](__m256 v, __m256 inv) {
+            v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v, inv), minusOne), one);
+            return _mm256_cvttps_epi32(_mm256_mul_ps(v, scale));
+            };
+
+        __m256 nInv = inverseLength(lanes[0], lanes[1], lanes[2]);
+        __m256 tInv = inverseLength(lanes[3], lanes[4], lanes[5]);
+
+        __m256i quantized[4] = {
+            quantize(lanes[0], nInv), quantize(lanes[1], nInv), quantize(lanes[2], nInv), quantize(lanes[3], tInv)
+        };
+
+        // AVX has no 256-bit integer ops, so the bit packing runs on each half.
+        const __m128i mask = _mm_set1_epi32(0x3FF);
+        for (int half = 0; half < 2; half++)
+        {
+            __m128i ix = half ? _mm256_extractf128_si256(quantized[0], 1) : _mm256_castsi256_si128(quantized[0]);
+            __m128i iy = half ? _mm256_extractf128_si256(quantized[1], 1) : _mm256_castsi256_si128(quantized[1]);
+            __m128i iz = half ? _mm256_extractf128_si256(quantized[2], 1) : _mm256_castsi256_si128(quantized[2]);
+            __m128i itx = half ? _mm256_extractf128_si256(quantized[3], 1) : _mm256_castsi256_si128(quantized[3]);
+
+            __m128i packed = _mm_and_si128(ix, mask);
+            packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(iy, mask), 10));
+            packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(iz, mask), 20));
+            packed = _mm_or_si128(packed, _mm_and_si128(_mm_cmplt_epi32(itx, _mm_setzero_si128()), _mm_set1_epi32(1 << 30)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(result + half * 4), packed);
+        }
+    }
+#endif
+
+    // Loads four elements as rows and transposes them, returning the x, y and z columns.
+    static inline void LoadColumns(const uint8_t* src, size_t stride, __m128& x, __m128& y, __m128& z)
+    {
+        __m128 r0 = _mm_loadu_ps(reinterpret_cast<const float*>(src));
+        __m128 r1 = _mm_loadu_ps(reinterpret_cast<const float*>(src + stride));
+        __m128 r2 = _mm_loadu_ps(reinterpret_cast<const float*>(src + stride * 2));
+        __m128 r3 = _mm_loadu_ps(reinterpret_cast<const float*>(src + stride * 3));
+
+        __m128 xy01 = _mm_unpacklo_ps(r0, r1);  // x0 x1 y0 y1
+        __m128 xy23 = _mm_unpacklo_ps(r2, r3);
+        __m128 zw01 = _mm_unpackhi_ps(r0, r1);  // z0 z1 w0 w1
+        __m128 zw23 = _mm_unpackhi_ps(r2, r3);
+
+        x = _mm_movelh_ps(xy01, xy23);
+        y = _mm_movehl_ps(xy23, xy01);
+        z = _mm_movelh_ps(zw01, zw23);
+    }
+
+#if defined(__AVX__)
+    // Same as LoadColumns for eight elements, elements 4-7 go in the upper half of each row.
+    static inline void LoadColumns8(const uint8_t* src, size_t stride, __m256 columns[3])
+    {
+        __m256 r[4];
+        for (size_t k = 0; k < 4; k++)
+        {
+            __m128 lo = _mm_loadu_ps(reinterpret_cast<const float*>(src + stride * k));
+            __m128 hi = _mm_loadu_ps(reinterpret_cast<const float*>(src + stride * (k + 4)));
+            r[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+        }
+
+        __m256 xy01 = _mm256_unpacklo_ps(r[0], r[1]);
+        __m256 xy23 = _mm256_unpacklo_ps(r[2], r[3]);
+        __m256 zw01 = _mm256_unpackhi_ps(r[0], r[1]);
+        __m256 zw23 = _mm256_unpackhi_ps(r[2], r[3]);
+
+        columns[0] = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(1, 0, 1, 0));
+        columns[1] = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+        columns[2] = _mm256_shuffle_ps(zw01, zw23, _MM_SHUFFLE(1, 0, 1, 0));
+    }
+#endif
+
+    // Float views are read where they are; normalized integers are decoded to floats first,
+    // four per element so every element can be loaded as one vector.
+    static const uint8_t* ResolveFloats(const AccessorView* view, size_t count, uint32_t components,
+        std::vector<float>& scratch, size_t& stride)
+    {
+        static const float defaults[2][4] = { { 0.0f, 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } };
+
+        if (!view)
+        {
+            stride = 0;
+            return reinterpret_cast<const uint8_t*>(defaults[components == 3 ? 0 : 1]);
+        }
+
+        if (view->m_ComponentType == ACCESSOR_COMPONENT::FLOAT && view->m_Components >= 3)
+        {
+            stride = view->m_Stride;
+            return view->m_Data;
+        }
+
+        AccessorView clamped = *view;
+        clamped.m_Count = std::min(view->m_Count, count);
+
+        scratch.assign(count * 4, 0.0f);
+        GltfAccessor::ReadFloats(clamped, 3, scratch.data(), 4);
+
+        stride = 4 * sizeof(float);
+        return reinterpret_cast<const uint8_t*>(scratch.data());
+    }
+
+    void GltfAccessor::PackNormalTangents(
+        const AccessorView* normals,
+        const AccessorView* tangents,
+        size_t count,
+        uint32_t* out,
+        size_t outStride)
+    {
+        std::vector<float> normalScratch;
+        std::vector<float> tangentScratch;
+        size_t nStride = 0;
+        size_t tStride = 0;
+
+        const uint8_t* n = ResolveFloats(normals, count, 3, normalScratch, nStride);
+        const uint8_t* t = ResolveFloats(tangents, count, 4, tangentScratch, tStride);
+
+        // Element loads read four floats. For a vec3 view the fourth belongs to the next
+        // element, which the last element doesn't have, so that one is left to the scalar tail.
+        auto isVec3 = [](const AccessorView* view) {
+            return view && view->m_ComponentType == ACCESSOR_COMPONENT::FLOAT && view->m_Components < 4;
+            };
+        const size_t vectorCount = count > 0 && (isVec3(normals) || isVec3(tangents)) ? count - 1 : count;
+
+        auto gather = [](const uint8_t* base, size_t stride, size_t i, uint32_t c) {
+            return LoadUnaligned<float>(base + i * stride + c * sizeof(float));
+            };
+
+        size_t i = 0;
+
+#if defined(__AVX__)
+        for (; i + 8 <= vectorCount; i += 8)
+        {
+            __m256 lanes[6];
+            LoadColumns8(n + i * nStride, nStride, lanes);
+            LoadColumns8(t + i * tStride, tStride, lanes + 3);
+
+            alignas(32) uint32_t result[8];
+            PackLanes8(lanes, result);
+
+            for (size_t k = 0; k < 8; k++)
+                out[(i + k) * outStride] = result[k];
+        }
+#endif
+
+        for (; i + 4 <= vectorCount; i += 4)
+        {
+            __m128 lanes[6];
+            LoadColumns(n + i * nStride, nStride, lanes[0], lanes[1], lanes[2]);
+            LoadColumns(t + i * tStride, tStride, lanes[3], lanes[4], lanes[5]);
+
+            __m128i packed = PackLanes(lanes[0], lanes[1], lanes[2], lanes[3], lanes[4], lanes[5]);
+
+            alignas(16) uint32_t result[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(result), packed);
+
+            out[(i + 0) * outStride] = result[0];
+            out[(i + 1) * outStride] = result[1];
+            out[(i + 2) * outStride] = result[2];
+            out[(i + 3) * outStride] = result[3];
+        }
+
+        for (; i < count; i++)
+        {
+            __m128i packed = PackLanes(
+                _mm_set1_ps(gather(n, nStride, i, 0)), _mm_set1_ps(gather(n, nStride, i, 1)), _mm_set1_ps(gather(n, nStride, i, 2)),
+                _mm_set1_ps(gather(t, tStride, i, 0)), _mm_set1_ps(gather(t, tStride, i, 1)), _mm_set1_ps(gather(t, tStride, i, 2)));
+
+            out[i * outStride] = static_cast<uint32_t>(_mm_cvtsi128_si32(packed));
+        }
+    }
+
+    void GltfAccessor::ComputeBounds(const float* positions, size_t count, size_t stride, glm::vec3& outMin, glm::vec3& outMax)
+    {
+        outMin = glm::vec3(FLT_MAX);
+        outMax = glm::vec3(-FLT_MAX);
+
+        size_t i = 0;
+
+        if (stride >= 4)
+        {
+            // Wide elements: one unaligned load per position, the fourth lane is ignored.
+            __m128 lo = _mm_set1_ps(FLT_MAX);
+            __m128 hi = _mm_set1_ps(-FLT_MAX);
+
+            for (; i < count; i++)
+            {
+                __m128 p = _mm_loadu_ps(positions + i * stride);
+                lo = _mm_min_ps(lo, p);
+                hi = _mm_max_ps(hi, p);
+            }
+
+            alignas(16) float l[4];
+            alignas(16) float h[4];
+            _mm_store_ps(l, lo);
+            _mm_store_ps(h, hi);
+
+            outMin = glm::vec3(l[0], l[1], l[2]);
+            outMax = glm::vec3(h[0], h[1], h[2]);
+            return;
+        }
+
+        // Four packed vec3s are three registers: (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3).
+        // Reduce each register separately and sort the lanes back into x/y/z at the end.
+        if (stride == 3 && count >= 4)
+        {
+            __m128 minA = _mm_set1_ps(FLT_MAX), minB = minA, minC = minA;
+            __m128 maxA = _mm_set1_ps(-FLT_MAX), maxB = maxA, maxC = maxA;
+
+#if defined(__AVX__)
+            // Eight vec3s are three 256-bit registers with the same lane pattern per 128-bit half.
+            __m256 minA8 = _mm256_set1_ps(FLT_MAX), minB8 = minA8, minC8 = minA8;
+            __m256 maxA8 = _mm256_set1_ps(-FLT_MAX), maxB8 = maxA8, maxC8 = maxA8;
+
+            for (; i + 8 <= count; i += 8)
+            {
+                const float* p = positions + i * 3;
+                __m256 a = _mm256_loadu_ps(p + 0);
+                __m256 b = _mm256_loadu_ps(p + 8);
+                __m256 c = _mm256_loadu_ps(p + 16);
+
+                minA8 = _mm256_min_ps(minA8, a); maxA8 = _mm256_max_ps(maxA8, a);
+                minB8 = _mm256_min_ps(minB8, b); maxB8 = _mm256_max_ps(maxB8, b);
+                minC8 = _mm256_min_ps(minC8, c); maxC8 = _mm256_max_ps(maxC8, c);
+            }
+
+            // Halves in order are patterns A B | C A | B C.
+            minA = _mm_min_ps(minA, _mm256_castps256_ps128(minA8));
+            minB = _mm_min_ps(minB, _mm256_extractf128_ps(minA8, 1));
+            minC = _mm_min_ps(minC, _mm256_castps256_ps128(minB8));
+            minA = _mm_min_ps(minA, _mm256_extractf128_ps(minB8, 1));
+            minB = _mm_min_ps(minB, _mm256_castps256_ps128(minC8));
+            minC = _mm_min_ps(minC, _mm256_extractf128_ps(minC8, 1));
+
+            maxA = _mm_max_ps(maxA, _mm256_castps256_ps128(maxA8));
+            maxB = _mm_max_ps(maxB, _mm256_extractf128_ps(maxA8, 1));
+            maxC = _mm_max_ps(maxC, _mm256_castps256_ps128(maxB8));
+            maxA = _mm_max_ps(maxA, _mm256_extractf128_ps(maxB8, 1));
+            maxB = _mm_max_ps(maxB, _mm256_castps256_ps128(maxC8));
+            maxC = _mm_max_ps(maxC, _mm256_extractf128_ps(maxC8, 1));
+#endif
+
+            for (; i + 4 <= count; i += 4)
+            {
+                const float* p = positions + i * 3;
+                __m128 a = _mm_loadu_ps(p + 0);
+                __m128 b = _mm_loadu_ps(p + 4);
+                __m128 c = _mm_loadu_ps(p + 8);
+
+                minA = _mm_min_ps(minA, a); maxA = _mm_max_ps(maxA, a);
+                minB = _mm_min_ps(minB, b); maxB = _mm_max_ps(maxB, b);
+                minC = _mm_min_ps(minC, c); maxC = _mm_max_ps(maxC, c);
+            }
+
+            alignas(16) float lo[12];
+            alignas(16) float hi[12];
+            _mm_store_ps(lo + 0, minA); _mm_store_ps(lo + 4, minB); _mm_store_ps(lo + 8, minC);
+            _mm_store_ps(hi + 0, maxA); _mm_store_ps(hi + 4, maxB); _mm_store_ps(hi + 8, maxC);
+
+            for (int k = 0; k < 12; k++)
+            {
+                outMin[k % 3] = std::min(outMin[k % 3], lo[k]);
+                outMax[k % 3] = std::max(outMax[k % 3], hi[k]);
+            }
+        }
+
+        for (; i < count; i++)
+        {
+            glm::vec3 p(positions[i * stride + 0], positions[i * stride + 1], positions[i * stride + 2]);
+            outMin = glm::min(outMin, p);
+            outMax = glm::max(outMax, p);
+        }
+    }
+
+    void GltfAccessor::DecodeVertices(
+        const AccessorView& positions,
+        const AccessorView* normals,
+        const AccessorView* tangents,
+        const AccessorView* texcoords,
+        GpuVertex* out,
+        glm::vec3& outMin,
+        glm::vec3& outMax)
+    {
+        const size_t chunkSize = 256;
+        const size_t count = positions.m_Count;
+        const size_t floatStride = sizeof(GpuVertex) / sizeof(float);
+        const uint32_t white = GpuVertex::PackColor(glm::vec4(1.0f));
+
+        // Quantized normals and tangents are widened once up front, so the chunk loop only gathers floats.
+        std::vector<float> widened[2];
+        AccessorView widenedViews[2];
+        const AccessorView* sources[2] = { normals, tangents };
+
+        for (int k = 0; k < 2; k++)
+        {
+            if (!sources[k] || sources[k]->m_ComponentType == ACCESSOR_COMPONENT::FLOAT)
+                continue;
+
+            AccessorView clamped = *sources[k];
+            clamped.m_Count = std::min(clamped.m_Count, count);
+
+            widened[k].assign(count * 3, 0.0f);
+            ReadFloats(clamped, 3, widened[k].data());
+
+            widenedViews[k].m_Data = reinterpret_cast<const uint8_t*>(widened[k].data());
+            widenedViews[k].m_Count = count;
+            widenedViews[k].m_Stride = 3 * sizeof(float);
+            widenedViews[k].m_Components = 3;
+            sources[k] = &widenedViews[k];
+        }
+
+        outMin = glm::vec3(FLT_MAX);
+        outMax = glm::vec3(-FLT_MAX);
+
+        auto slice = [](const AccessorView* view, size_t first, size_t n, AccessorView& result) -> const AccessorView* {
+            if (!view)
+                return nullptr;
+            result = *view;
+            result.m_Data += first * view->m_Stride;
+            result.m_Count = n;
+            return &result;
+            };
+
+        for (size_t first = 0; first < count; first += chunkSize)
+        {
+            const size_t n = std::min(chunkSize, count - first);
+            GpuVertex* chunk = out + first;
+
+            AccessorView positionSlice, normalSlice, tangentSlice, texcoordSlice;
+            ReadFloats(*slice(&positions, first, n, positionSlice), 3, &chunk->m_Position.x, floatStride);
+
+            if (const AccessorView* texcoordView = slice(texcoords, first, n, texcoordSlice))
+            {
+                ReadFloats(*texcoordView, 2, &chunk->m_TexCoord.x, floatStride);
+                for (size_t i = 0; i < n; i++)
+                    chunk[i].m_TexCoord.y = 1.0f - chunk[i].m_TexCoord.y;
+            }
+            else
+            {
+                for (size_t i = 0; i < n; i++)
+                    chunk[i].m_TexCoord = glm::vec2(0.0f);
+            }
+
+            for (size_t i = 0; i < n; i++)
+                chunk[i].m_Color = white;
+
+            PackNormalTangents(
+                slice(sources[0], first, n, normalSlice),
+                slice(sources[1], first, n, tangentSlice),
+                n, &chunk->m_NormalTangent, sizeof(GpuVertex) / sizeof(uint32_t));
+
+            glm::vec3 chunkMin, chunkMax;
+            ComputeBounds(&chunk->m_Position.x, n, floatStride, chunkMin, chunkMax);
+            outMin = glm::min(outMin, chunkMin);
+            outMax = glm::max(outMax, chunkMax);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+// GltfAccessor.h
+#pragma once
+#include <Core/Common/Common.h>
+#include <Core/Graphics/Structs/GpuStructs.h>
+
+namespace Isle
+{
+    // Values match the glTF / GL component type enums.
+    enum class ACCESSOR_COMPONENT
+    {
+        BYTE = 5120,
+        UNSIGNED_BYTE = 5121,
+        SHORT = 5122,
+        UNSIGNED_SHORT = 5123,
+        UNSIGNED_INT = 5125,
+        FLOAT = 5126
+    };
+
+    struct AccessorView
+    {
+        const uint8_t* m_Data = nullptr;
+        size_t m_Count = 0;
+        size_t m_Stride = 0;
+        ACCESSOR_COMPONENT m_ComponentType = ACCESSOR_COMPONENT::FLOAT;
+        uint32_t m_Components = 0;
+        bool m_Normalized = false;
+
+        static uint32_t GetComponentSize(ACCESSOR_COMPONENT type);
+        uint32_t GetElementSize() const { return GetComponentSize(m_ComponentType) * m_Components; }
+        bool IsTightlyPackedFloat() const;
+    };
+
+    class ISLEENGINE_API GltfAccessor
+    {
+    public:
+        // Gathers outComponents floats per element, outStride floats apart (0 = packed). Honours
+        // the view stride and the glTF normalized integer rules; missing components are zeroed.
+        static void ReadFloats(const AccessorView& view, uint32_t outComponents, float* out, size_t outStride = 0);
+
+        // Widens 8/16/32 bit indices to 32 bit.
+        static void ReadIndices(const AccessorView& view, unsigned int* out);
+
+        // Batch equivalent of GpuVertex::PackNormalTangent, writing every outStride uint32s.
+        // Float views are gathered in place; a null view packs the GpuVertex default.
+        static void PackNormalTangents(
+            const AccessorView* normals,
+            const AccessorView* tangents,
+            size_t count,
+            uint32_t* out,
+            size_t outStride);
+
+        // Min/max reduction over vec3 positions that are stride floats apart.
+        static void ComputeBounds(const float* positions, size_t count, size_t stride, glm::vec3& outMin, glm::vec3& outMax);
+
+        // Decodes a primitive into GpuVertex in cache sized chunks so every attribute pass
+        // stays in L1. Optional attributes may be null. Returns the position bounds.
+        static void DecodeVertices(
+            const AccessorView& positions,
+            const AccessorView* normals,
+            const AccessorView* tangents,
+            const AccessorView* texcoords,
+            GpuVertex* out,
+            glm::vec3& outMin,
+            glm::vec3& outMax);
+    };
+}
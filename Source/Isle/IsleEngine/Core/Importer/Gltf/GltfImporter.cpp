@@ -4,17 +4,137 @@
 #include <tiny_gltf.h>
 
 #include "GltfImporter.h"
+#include "GltfAccessor.h"
+#include <Core/Graphics/Texture/TextureCompressor.h>
+#include <Core/Graphics/Texture/TextureCache.h>
+#include <Core/Graphics/Texture/TextureStreamer.h>
 #include <thread>
 #include <future>
 #include <algorithm>
+#include <glm/gtc/type_ptr.hpp>
 
 namespace Isle
 {
     tinygltf::Model m_Model;
 
+    enum TEXTURE_USAGE : uint32_t
+    {
+        TEXTURE_USAGE_COLOR = 1 << 0,
+        TEXTURE_USAGE_NORMAL = 1 << 1,
+        TEXTURE_USAGE_DATA = 1 << 2,
+        TEXTURE_USAGE_OCCLUSION = 1 << 3,
+        TEXTURE_USAGE_EMISSIVE = 1 << 4
+    };
+
+    // BC5 for normals, BC4 for single channel data, BC1 for opaque emissive, BC7 otherwise.
+    static TEXTURE_FORMAT ChooseCompressedFormat(uint32_t usage, int channels, const std::vector<uint8_t>& rgba)
+    {
+        if (usage == TEXTURE_USAGE_NORMAL)
+            return TEXTURE_FORMAT::BC5;
+
+        if (usage == TEXTURE_USAGE_OCCLUSION || channels == 1)
+            return TEXTURE_FORMAT::BC4;
+
+        if (usage == TEXTURE_USAGE_EMISSIVE)
+        {
+            bool opaque = true;
+            for (size_t i = 3; i < rgba.size() && opaque; i += 4)
+                opaque = rgba[i] == 255;
+
+            if (opaque)
+                return TEXTURE_FORMAT::BC1;
+        }
+
+        return TEXTURE_FORMAT::BC7;
+    }
+
+    static bool IsSkinned(const tinygltf::Primitive& primitive)
+    {
+        return primitive.attributes.count("JOINTS_0") > 0 && primitive.attributes.count("WEIGHTS_0") > 0;
+    }
+
+    static bool GetAccessorView(int accessor_index, AccessorView& view, size_t expected_count = 0)
+    {
+        if (accessor_index < 0 || static_cast<size_t>(accessor_index) >= m_Model.accessors.size())
+            return false;
+
+        const tinygltf::Accessor& accessor = m_Model.accessors[accessor_index];
+        if (accessor.bufferView < 0 || static_cast<size_t>(accessor.bufferView) >= m_Model.bufferViews.size())
+            return false;
+
+        if (accessor.sparse.isSparse)
+            ISLE_WARN("Accessor %d is sparse, sparse values are ignored\n", accessor_index);
+
+        const tinygltf::BufferView& buffer_view = m_Model.bufferViews[accessor.bufferView];
+        if (buffer_view.buffer < 0 || static_cast<size_t>(buffer_view.buffer) >= m_Model.buffers.size())
+            return false;
+
+        const tinygltf::Buffer& buffer = m_Model.buffers[buffer_view.buffer];
+
+        view.m_ComponentType = static_cast<ACCESSOR_COMPONENT>(accessor.componentType);
+        view.m_Components = static_cast<uint32_t>(tinygltf::GetNumComponentsInType(accessor.type));
+        view.m_Normalized = accessor.normalized;
+        view.m_Count = accessor.count;
+
+        const uint32_t element_size = view.GetElementSize();
+        if (element_size == 0)
+            return false;
+
+        view.m_Stride = buffer_view.byteStride > 0 ? buffer_view.byteStride : element_size;
+
+        const size_t offset = buffer_view.byteOffset + accessor.byteOffset;
+        const size_t extent = view.m_Count > 0 ? (view.m_Count - 1) * view.m_Stride + element_size : 0;
+
+        if (offset + extent > buffer.data.size() || accessor.byteOffset + extent > buffer_view.byteLength)
+        {
+            ISLE_ERROR("Accessor %d reads past the end of its buffer view\n", accessor_index);
+            return false;
+        }
+
+        if (expected_count > 0 && view.m_Count < expected_count)
+        {
+            ISLE_ERROR("Accessor %d has %zu elements, expected %zu\n", accessor_index, view.m_Count, expected_count);
+            return false;
+        }
+
+        if (expected_count > 0)
+            view.m_Count = expected_count;
+
+        view.m_Data = buffer.data.data() + offset;
+        return true;
+    }
+
+    // Samples a glTF animation channel at fixed frames. Times before the first key and after the
+    // last hold the end values, CUBICSPLINE keys come in with their tangents already dropped.
+    template<typename T, typename Mix>
+    static std::vector<T> ResampleChannel(const std::vector<float>& times, const std::vector<T>& keys, bool step, uint32_t frameCount, float sampleRate, Mix mix)
+    {
+        std::vector<T> frames(frameCount);
+        for (uint32_t f = 0; f < frameCount; f++)
+        {
+            const float time = f / sampleRate;
+            auto it = std::upper_bound(times.begin(), times.end(), time);
+
+            if (it == times.begin())
+                frames[f] = keys.front();
+            else if (it == times.end())
+                frames[f] = keys.back();
+            else
+            {
+                const size_t next = it - times.begin();
+                const size_t key = next - 1;
+                const float span = times[next] - times[key];
+                const float alpha = span > 0.0f ? (time - times[key]) / span : 0.0f;
+                frames[f] = step ? keys[key] : mix(keys[key], keys[next], alpha);
+            }
+        }
+        return frames;
+    }
+
     GltfImporter::GltfImporter()
+        : m_Arena(std::make_unique<AssetArena>())
     {
-        m_RootComponent = new SceneComponent();
+        m_RootComponent = m_Arena->m_SceneComponents.Create();
     }
 
     GltfImporter::~GltfImporter()
@@ -56,6 +176,7 @@ namespace Isle
         if (!ret)
         {
             ISLE_ERROR("Failed to load GLTF file: %s\n", file_path);
+            m_Error = err.empty() ? "Failed to load " + file_path : err.substr(0, err.find_last_not_of(" \r\n") + 1);
             return false;
         }
 
@@ -64,9 +185,15 @@ namespace Isle
             m_Textures.resize(m_Model.textures.size());
             m_Materials.resize(m_Model.materials.size());
             m_SceneComponents.reserve(m_Model.nodes.size());
+
+            // One block per type for the whole import, meshes are sized once primitives are counted.
+            m_Arena->m_SceneComponents.Reserve(static_cast<uint32_t>(m_Model.nodes.size()));
+            m_Arena->m_Materials.Reserve(static_cast<uint32_t>(m_Model.materials.size()));
+            m_Arena->m_Textures.Reserve(static_cast<uint32_t>(m_Model.textures.size()));
         }
 
-        LoadTextures();
+        if (m_LoadTextures)
+            LoadTextures();
 
         std::future<void> materialsFuture;
         std::future<void> meshesFuture;
@@ -90,8 +217,12 @@ namespace Isle
             {
                 ProcessNode(node_index, nullptr);
             }
+
+            BindSkins();
         }
 
+        LoadAnimations();
+
         return true;
     }
 
@@ -101,7 +232,7 @@ namespace Isle
             return;
 
         const tinygltf::Node& node = m_Model.nodes[node_index];
-        SceneComponent* component = new SceneComponent();
+        SceneComponent* component = m_Arena->m_SceneComponents.Create();
         component->SetName(node.name);
         m_SceneComponents.push_back(component);
 
@@ -156,6 +287,10 @@ namespace Isle
                     {
                         StaticMesh* sharedMesh = m_StaticMeshes[primitiveIdx];
                         component->AddChild(sharedMesh);
+
+                        SkinnedMesh* skinnedMesh = Cast<SkinnedMesh>(sharedMesh);
+                        if (skinnedMesh && node.skin >= 0)
+                            m_MeshSkins.emplace_back(skinnedMesh, node.skin);
                     }
                 }
             }
@@ -172,6 +307,160 @@ namespace Isle
         }
     }
 
+    void GltfImporter::BindSkins()
+    {
+        for (auto& [mesh, skin_index] : m_MeshSkins)
+        {
+            if (skin_index < 0 || static_cast<size_t>(skin_index) >= m_Model.skins.size())
+                continue;
+
+            const tinygltf::Skin& skin = m_Model.skins[skin_index];
+            if (skin.joints.empty())
+                continue;
+
+            std::vector<SceneComponent*> joints;
+            joints.reserve(skin.joints.size());
+            for (int joint_index : skin.joints)
+            {
+                auto it = m_NodeMap.find(joint_index);
+                joints.push_back(it != m_NodeMap.end() ? it->second : nullptr);
+            }
+
+            // Without inverse bind matrices the joints are already in bind space.
+            std::vector<glm::mat4> inverseBindMatrices(joints.size(), glm::mat4(1.0f));
+            AccessorView matrixView;
+            if (skin.inverseBindMatrices >= 0 && GetAccessorView(skin.inverseBindMatrices, matrixView, joints.size()) && matrixView.m_Components == 16)
+                GltfAccessor::ReadFloats(matrixView, 16, glm::value_ptr(inverseBindMatrices[0]));
+
+            mesh->SetSkeleton(joints, std::move(inverseBindMatrices));
+        }
+    }
+
+    void GltfImporter::LoadAnimations()
+    {
+        if (m_Model.animations.empty())
+            return;
+
+        ScopedTimer animationTimer("Animations");
+
+        // Every clip gets one track per node animated by any clip, so a single animator plays them all.
+        std::map<int, uint32_t> nodeTracks;
+        std::vector<SceneComponent*> targets;
+        for (const tinygltf::Animation& animation : m_Model.animations)
+        {
+            for (const tinygltf::AnimationChannel& channel : animation.channels)
+            {
+                if (channel.target_path != "translation" && channel.target_path != "rotation" && channel.target_path != "scale")
+                    continue;
+
+                auto nodeIt = m_NodeMap.find(channel.target_node);
+                if (nodeIt == m_NodeMap.end() || nodeTracks.count(channel.target_node))
+                    continue;
+
+                nodeTracks[channel.target_node] = static_cast<uint32_t>(targets.size());
+                targets.push_back(nodeIt->second);
+            }
+        }
+
+        if (targets.empty())
+            return;
+
+        const AnimationCompression settings;
+        m_Arena->m_AnimationClips.Reserve(static_cast<uint32_t>(m_Model.animations.size()));
+
+        for (const tinygltf::Animation& animation : m_Model.animations)
+        {
+            std::vector<std::vector<float>> samplerTimes(animation.samplers.size());
+            float duration = 0.0f;
+            for (size_t s = 0; s < animation.samplers.size(); s++)
+            {
+                AccessorView timeView;
+                if (!GetAccessorView(animation.samplers[s].input, timeView) || timeView.m_Components != 1 || timeView.m_Count == 0)
+                    continue;
+
+                samplerTimes[s].resize(timeView.m_Count);
+                GltfAccessor::ReadFloats(timeView, 1, samplerTimes[s].data());
+                duration = glm::max(duration, samplerTimes[s].back());
+            }
+
+            const uint32_t frameCount = static_cast<uint32_t>(glm::min(
+                glm::ceil(duration * settings.m_SampleRate) + 1.0f, static_cast<float>(AnimationClip::MAX_FRAMES)));
+
+            std::vector<AnimationTrackSource> tracks(targets.size());
+            for (const tinygltf::AnimationChannel& channel : animation.channels)
+            {
+                auto trackIt = nodeTracks.find(channel.target_node);
+                if (trackIt == nodeTracks.end() || channel.sampler < 0 || static_cast<size_t>(channel.sampler) >= animation.samplers.size())
+                    continue;
+
+                const tinygltf::AnimationSampler& sampler = animation.samplers[channel.sampler];
+                const std::vector<float>& times = samplerTimes[channel.sampler];
+                if (times.empty())
+                    continue;
+
+                const bool rotation = channel.target_path == "rotation";
+                const bool cubic = sampler.interpolation == "CUBICSPLINE";
+                const bool step = sampler.interpolation == "STEP";
+                const uint32_t components = rotation ? 4 : 3;
+                const size_t valuesPerKey = cubic ? 3 : 1;
+
+                AccessorView valueView;
+                if (!GetAccessorView(sampler.output, valueView, times.size() * valuesPerKey) || valueView.m_Components != components)
+                    continue;
+
+                std::vector<float> values(valueView.m_Count * components);
+                GltfAccessor::ReadFloats(valueView, components, values.data());
+
+                // Cubic keys are stored in-tangent, value, out-tangent.
+                const size_t valueOffset = cubic ? 1 : 0;
+
+                AnimationTrackSource& track = tracks[trackIt->second];
+                if (rotation)
+                {
+                    std::vector<glm::quat> keys(times.size());
+                    for (size_t k = 0; k < keys.size(); k++)
+                    {
+                        const float* v = &values[(k * valuesPerKey + valueOffset) * 4];
+                        keys[k] = glm::normalize(glm::quat(v[3], v[0], v[1], v[2]));
+                    }
+
+                    track.m_Rotations = ResampleChannel(times, keys, step, frameCount, settings.m_SampleRate,
+                        [](const glm::quat& a, const glm::quat& b, float alpha) { return glm::slerp(a, b, alpha); });
+                }
+                else
+                {
+                    std::vector<glm::vec3> keys(times.size());
+                    for (size_t k = 0; k < keys.size(); k++)
+                        keys[k] = glm::make_vec3(&values[(k * valuesPerKey + valueOffset) * 3]);
+
+                    std::vector<glm::vec3> frames = ResampleChannel(times, keys, step, frameCount, settings.m_SampleRate,
+                        [](const glm::vec3& a, const glm::vec3& b, float alpha) { return glm::mix(a, b, alpha); });
+
+                    if (channel.target_path == "translation")
+                        track.m_Translations = std::move(frames);
+                    else
+                        track.m_Scales = std::move(frames);
+                }
+            }
+
+            AnimationClip* clip = m_Arena->m_AnimationClips.Create();
+            clip->SetName(animation.name);
+            clip->Build(tracks, settings);
+            m_AnimationClips.push_back(clip);
+
+            ISLE_LOG("Animation '%s': %u tracks, %u frames, %zu keys, %zu KB from %zu KB\n", animation.name.c_str(), clip->GetTrackCount(),
+                clip->GetFrameCount(), clip->GetKeyCount(), clip->GetCompressedSize() / 1024, clip->GetSourceSize() / 1024);
+        }
+
+        // Starts on the first clip, the others are there for whoever drives the animator.
+        m_Arena->m_Animators.Reserve(1);
+        m_Animator = m_Arena->m_Animators.Create();
+        m_Animator->SetName("Animator");
+        m_Animator->SetTargets(targets);
+        m_Animator->Play(m_AnimationClips[0]);
+        m_RootComponent->AddChild(m_Animator);
+    }
+
     void GltfImporter::LoadStaticMeshes()
     {
         ScopedTimer totalMeshTimer("LoadStaticMeshes TOTAL");
@@ -179,14 +468,19 @@ namespace Isle
         std::vector<std::vector<int>> meshPrimitives(m_Model.meshes.size());
 
         int totalPrimitives = 0;
+        int skinnedPrimitives = 0;
         {
             ScopedTimer countTimer("Count Total Primitives");
             for (const auto& mesh : m_Model.meshes)
             {
                 for (const auto& primitive : mesh.primitives)
                 {
-                    if (primitive.mode == TINYGLTF_MODE_TRIANGLES)
-                        totalPrimitives++;
+                    if (primitive.mode != TINYGLTF_MODE_TRIANGLES)
+                        continue;
+
+                    totalPrimitives++;
+                    if (IsSkinned(primitive))
+                        skinnedPrimitives++;
                 }
             }
         }
@@ -196,6 +490,9 @@ namespace Isle
         {
             ScopedTimer resizeTimer("Resize StaticMeshes Vector");
             m_StaticMeshes.resize(totalPrimitives);
+            m_Arena->m_StaticMeshes.Reserve(static_cast<uint32_t>(totalPrimitives - skinnedPrimitives));
+            if (skinnedPrimitives > 0)
+                m_Arena->m_SkinnedMeshes.Reserve(static_cast<uint32_t>(skinnedPrimitives));
         }
 
         unsigned int numThreads = std::thread::hardware_concurrency();
@@ -226,106 +523,84 @@ namespace Isle
                         if (primCount == currentPrimIdx)
                         {
                             auto posIt = primitive.attributes.find("POSITION");
-                            if (posIt == primitive.attributes.end())
+                            AccessorView positionView;
+                            if (posIt == primitive.attributes.end() || !GetAccessorView(posIt->second, positionView) || positionView.m_Count == 0)
                                 goto next_primitive;
 
-                            const tinygltf::Accessor& pos_accessor = m_Model.accessors[posIt->second];
-                            const tinygltf::BufferView& pos_view = m_Model.bufferViews[pos_accessor.bufferView];
-                            const tinygltf::Buffer& pos_buffer = m_Model.buffers[pos_view.buffer];
-                            const float* positions = reinterpret_cast<const float*>(
-                                &pos_buffer.data[pos_view.byteOffset + pos_accessor.byteOffset]);
+                            const size_t vertexCount = positionView.m_Count;
 
-                            const float* normals = nullptr;
+                            AccessorView normalView;
                             auto normIt = primitive.attributes.find("NORMAL");
-                            if (normIt != primitive.attributes.end())
-                            {
-                                const tinygltf::Accessor& norm_accessor = m_Model.accessors[normIt->second];
-                                const tinygltf::BufferView& norm_view = m_Model.bufferViews[norm_accessor.bufferView];
-                                const tinygltf::Buffer& norm_buffer = m_Model.buffers[norm_view.buffer];
-                                normals = reinterpret_cast<const float*>(
-                                    &norm_buffer.data[norm_view.byteOffset + norm_accessor.byteOffset]);
-                            }
-
-                            const float* texcoords = nullptr;
-                            auto texIt = primitive.attributes.find("TEXCOORD_0");
-                            if (texIt != primitive.attributes.end())
-                            {
-                                const tinygltf::Accessor& tex_accessor = m_Model.accessors[texIt->second];
-                                const tinygltf::BufferView& tex_view = m_Model.bufferViews[tex_accessor.bufferView];
-                                const tinygltf::Buffer& tex_buffer = m_Model.buffers[tex_view.buffer];
-                                texcoords = reinterpret_cast<const float*>(
-                                    &tex_buffer.data[tex_view.byteOffset + tex_accessor.byteOffset]);
-                            }
+                            bool hasNormals = normIt != primitive.attributes.end() && GetAccessorView(normIt->second, normalView, vertexCount);
 
-                            const float* tangents = nullptr;
+                            AccessorView tangentView;
                             auto tanIt = primitive.attributes.find("TANGENT");
-                            if (tanIt != primitive.attributes.end())
-                            {
-                                const tinygltf::Accessor& tan_accessor = m_Model.accessors[tanIt->second];
-                                const tinygltf::BufferView& tan_view = m_Model.bufferViews[tan_accessor.bufferView];
-                                const tinygltf::Buffer& tan_buffer = m_Model.buffers[tan_view.buffer];
-                                tangents = reinterpret_cast<const float*>(
-                                    &tan_buffer.data[tan_view.byteOffset + tan_accessor.byteOffset]);
-                            }
+                            bool hasTangents = tanIt != primitive.attributes.end() && GetAccessorView(tanIt->second, tangentView, vertexCount);
 
-                            std::vector<GpuVertex> vertices;
-                            vertices.reserve(pos_accessor.count);
+                            AccessorView texcoordView;
+                            auto texIt = primitive.attributes.find("TEXCOORD_0");
+                            bool hasTexcoords = texIt != primitive.attributes.end() && GetAccessorView(texIt->second, texcoordView, vertexCount);
 
-                            glm::vec3 minBounds(FLT_MAX);
-                            glm::vec3 maxBounds(-FLT_MAX);
+                            std::vector<GpuVertex> vertices(vertexCount);
+                            glm::vec3 minBounds;
+                            glm::vec3 maxBounds;
 
-                            for (size_t v = 0; v < pos_accessor.count; v++)
-                            {
-                                const size_t p3 = v * 3;
-                                const size_t p2 = v * 2;
-                                const size_t p4 = v * 4;
-
-                                glm::vec3 position = glm::vec3(positions[p3], positions[p3 + 1], positions[p3 + 2]);
-                                glm::vec3 normal = normals ? glm::vec3(normals[p3], normals[p3 + 1], normals[p3 + 2])
-                                    : glm::vec3(0, 1, 0);
-                                glm::vec2 texCoord = texcoords ? glm::vec2(texcoords[p2], 1.0f - texcoords[p2 + 1])
-                                    : glm::vec2(0, 0);
-                                glm::vec3 tangent = tangents ? glm::vec3(tangents[p4], tangents[p4 + 1], tangents[p4 + 2])
-                                    : glm::vec3(1, 0, 0);
-                                glm::vec4 color = glm::vec4(1.0f);
-
-                                vertices.emplace_back(position, normal, tangent, texCoord, color);
-
-                                minBounds = glm::min(minBounds, position);
-                                maxBounds = glm::max(maxBounds, position);
-                            }
-
-                            const tinygltf::Accessor& idx_accessor = m_Model.accessors[primitive.indices];
-                            const tinygltf::BufferView& idx_view = m_Model.bufferViews[idx_accessor.bufferView];
-                            const tinygltf::Buffer& idx_buffer = m_Model.buffers[idx_view.buffer];
+                            GltfAccessor::DecodeVertices(
+                                positionView,
+                                hasNormals ? &normalView : nullptr,
+                                hasTangents ? &tangentView : nullptr,
+                                hasTexcoords ? &texcoordView : nullptr,
+                                vertices.data(),
+                                minBounds,
+                                maxBounds);
 
                             std::vector<unsigned int> indices;
-                            indices.reserve(idx_accessor.count);
+                            AccessorView indexView;
 
-                            if (idx_accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
+                            if (primitive.indices >= 0 && GetAccessorView(primitive.indices, indexView))
+                            {
+                                indices.resize(indexView.m_Count);
+                                GltfAccessor::ReadIndices(indexView, indices.data());
+                            }
+                            else
                             {
-                                const uint16_t* idx_data = reinterpret_cast<const uint16_t*>(
-                                    &idx_buffer.data[idx_view.byteOffset + idx_accessor.byteOffset]);
-                                for (size_t j = 0; j < idx_accessor.count; j++)
-                                    indices.push_back(idx_data[j]);
+                                indices.resize(vertexCount);
+                                for (size_t j = 0; j < vertexCount; j++)
+                                    indices[j] = static_cast<unsigned int>(j);
                             }
-                            else if (idx_accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
+
+                            AccessorView jointView;
+                            AccessorView weightView;
+                            const bool hasSkin = IsSkinned(primitive) &&
+                                GetAccessorView(primitive.attributes.at("JOINTS_0"), jointView, vertexCount) &&
+                                GetAccessorView(primitive.attributes.at("WEIGHTS_0"), weightView, vertexCount);
+
+                            StaticMesh* mesh = nullptr;
+                            if (hasSkin)
                             {
-                                const uint32_t* idx_data = reinterpret_cast<const uint32_t*>(
-                                    &idx_buffer.data[idx_view.byteOffset + idx_accessor.byteOffset]);
-                                indices.insert(indices.end(), idx_data, idx_data + idx_accessor.count);
+                                std::vector<glm::vec4> jointValues(vertexCount);
+                                std::vector<glm::vec4> weights(vertexCount);
+                                GltfAccessor::ReadFloats(jointView, 4, glm::value_ptr(jointValues[0]));
+                                GltfAccessor::ReadFloats(weightView, 4, glm::value_ptr(weights[0]));
+
+                                std::vector<glm::uvec4> joints(vertexCount);
+                                for (size_t j = 0; j < vertexCount; j++)
+                                    joints[j] = glm::uvec4(jointValues[j]);
+
+                                SkinnedMesh* skinnedMesh = m_Arena->m_SkinnedMeshes.Create();
+                                skinnedMesh->SetSkinWeights(joints, weights);
+                                mesh = skinnedMesh;
                             }
-                            else if (idx_accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+                            else
                             {
-                                const uint8_t* idx_data = reinterpret_cast<const uint8_t*>(
-                                    &idx_buffer.data[idx_view.byteOffset + idx_accessor.byteOffset]);
-                                for (size_t j = 0; j < idx_accessor.count; j++)
-                                    indices.push_back(idx_data[j]);
+                                mesh = m_Arena->m_StaticMeshes.Create();
                             }
 
-                            StaticMesh* mesh = new StaticMesh();
                             mesh->SetVertices(std::move(vertices));
                             mesh->SetIndices(std::move(indices));
+                            mesh->BuildMeshlets();
+                            if (m_BuildLods)
+                                mesh->BuildLods();
                             mesh->SetName(gltf_mesh.name);
                             mesh->m_Bounds.m_Min = minBounds;
                             mesh->m_Bounds.m_Max = maxBounds;
@@ -333,7 +608,7 @@ namespace Isle
                             if (primitive.material >= 0)
                                 mesh->SetMaterial(GetMaterial(primitive.material));
                             else
-                                mesh->SetMaterial(new Material());
+                                mesh->SetMaterial(m_Arena->m_Materials.Create());
 
                             m_StaticMeshes[currentPrimIdx] = mesh;
 
@@ -380,6 +655,8 @@ namespace Isle
     {
         ScopedTimer totalTexTimer("LoadTextures TOTAL");
 
+        std::vector<uint32_t> textureUsage = GatherTextureUsage();
+
         for (size_t i = 0; i < m_Model.textures.size(); i++)
         {
             const tinygltf::Texture& gltfTex = m_Model.textures[i];
@@ -446,8 +723,35 @@ namespace Isle
                 }
             }
 
-            Texture* texture = new Texture();
-            texture->Create(width, height, format, data, true);
+            Texture* texture = m_Arena->m_Textures.Create();
+
+            if (m_CompressTextures && (!image.uri.empty() || image.bits == 8))
+            {
+                std::vector<uint8_t> rgba = TextureCompressor::ExpandToRGBA(data, width, height, channels);
+                TEXTURE_FORMAT compressedFormat = ChooseCompressedFormat(textureUsage[i], channels, rgba);
+                std::string key = TextureCache::MakeKey(rgba.data(), rgba.size(), width, height, compressedFormat);
+
+                CompressedImage compressed;
+                if (!TextureCache::Load(key, compressed))
+                {
+                    compressed = TextureCompressor::CompressMipChain(rgba.data(), width, height, compressedFormat);
+                    TextureCache::Store(key, compressed);
+                }
+
+                if (m_StreamTextures)
+                {
+                    auto source = std::make_shared<CompressedImage>(std::move(compressed));
+                    texture->CreateStreamed(source, TextureStreamer::GetTailMip(*source, m_StreamTailResolution));
+                }
+                else
+                {
+                    texture->CreateCompressed(compressed);
+                }
+            }
+            else
+            {
+                texture->Create(width, height, format, data, true);
+            }
 
             TEXTURE_FILTER minFilter = TEXTURE_FILTER::LINEAR;
             TEXTURE_FILTER magFilter = TEXTURE_FILTER::LINEAR;
@@ -504,6 +808,27 @@ namespace Isle
         }
     }
 
+    std::vector<uint32_t> GltfImporter::GatherTextureUsage()
+    {
+        std::vector<uint32_t> usage(m_Model.textures.size(), 0);
+
+        auto mark = [&usage](int texture_index, uint32_t flag) {
+            if (texture_index >= 0 && static_cast<size_t>(texture_index) < usage.size())
+                usage[texture_index] |= flag;
+            };
+
+        for (const tinygltf::Material& gltf_mat : m_Model.materials)
+        {
+            mark(gltf_mat.pbrMetallicRoughness.baseColorTexture.index, TEXTURE_USAGE_COLOR);
+            mark(gltf_mat.pbrMetallicRoughness.metallicRoughnessTexture.index, TEXTURE_USAGE_DATA);
+            mark(gltf_mat.normalTexture.index, TEXTURE_USAGE_NORMAL);
+            mark(gltf_mat.occlusionTexture.index, TEXTURE_USAGE_OCCLUSION);
+            mark(gltf_mat.emissiveTexture.index, TEXTURE_USAGE_EMISSIVE);
+        }
+
+        return usage;
+    }
+
     void GltfImporter::LoadMaterials()
     {
         ScopedTimer totalMatTimer("LoadMaterials TOTAL");
@@ -511,7 +836,7 @@ namespace Isle
         for (size_t i = 0; i < m_Model.materials.size(); i++)
         {
             const tinygltf::Material& gltf_mat = m_Model.materials[i];
-            Material* material = new Material();
+            Material* material = m_Arena->m_Materials.Create();
 
             if (gltf_mat.pbrMetallicRoughness.baseColorTexture.index >= 0)
             {
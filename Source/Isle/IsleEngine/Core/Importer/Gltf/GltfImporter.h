@@ -2,24 +2,54 @@
 #include <Core/Common/Common.h>
 #include <Core/Graphics/Mesh/Mesh.h>
 #include <Core/Graphics/Mesh/StaticMesh.h>
+#include <Core/Graphics/Mesh/SkinnedMesh.h>
 #include <Core/Graphics/Texture/Texture.h>
+#include <Core/AssetManager/AssetArena.h>
 
 namespace Isle
 {
     class GltfImporter
     {
     public:
+        // Owns every object the import creates. AssetManager moves it into the Asset, if
+        // nobody takes it the objects go away with the importer.
+        std::unique_ptr<AssetArena> m_Arena;
+
         SceneComponent* m_RootComponent = nullptr;
         std::vector<StaticMesh*> m_StaticMeshes;
         std::vector<Texture*> m_Textures;
         std::vector<Material*> m_Materials;
         std::vector<SceneComponent*> m_SceneComponents;
 
+        // One clip per glTF animation, all played by m_Animator, which stays null without any.
+        std::vector<AnimationClip*> m_AnimationClips;
+        Animator* m_Animator = nullptr;
+
+        // Geometry only imports (offline tools) skip texture uploads and need no GL context.
+        bool m_LoadTextures = true;
+
+        // Cook textures to BC formats (cached on disk) instead of uploading raw RGBA8.
+        bool m_CompressTextures = true;
+
+        // Upload only mips up to m_StreamTailResolution, the TextureStreamer brings in the rest.
+        bool m_StreamTextures = true;
+        int m_StreamTailResolution = 128;
+
+        // Build the default LOD chain per mesh. Tools that build their own chain turn it off.
+        bool m_BuildLods = true;
+
+        // Why the last LoadFromFile failed, the ISLE_* logs are compiled out of release builds.
+        std::string m_Error;
+
     private:
         std::string m_BasePath;
         std::map<int, std::vector<int>> m_MeshToPrimitives;
         std::map<int, SceneComponent*> m_NodeMap;
 
+        // Skinned primitives and the skin of the node that placed them, bound once every
+        // joint node exists.
+        std::vector<std::pair<SkinnedMesh*, int>> m_MeshSkins;
+
     public:
         GltfImporter();
         ~GltfImporter();
@@ -31,10 +61,13 @@ namespace Isle
         Texture* GetTexture(int texture_index);
 
         void LoadTextures();
+        std::vector<uint32_t> GatherTextureUsage();
         void LoadMaterials();
         void LoadStaticMeshes();
 
         void ProcessNode(int node_index, SceneComponent* parent);
+        void BindSkins();
+        void LoadAnimations();
         void ExtractBasePath(const std::string& file_path);
     };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 // Importer.cpp
 #include "Importer.h"
+#include <Core/AssetManager/AssetManager.h>
 #include <filesystem>
 
 namespace Isle
@@ -13,23 +14,9 @@ namespace Isle
         case FILE_TYPE::GLTF:
         case FILE_TYPE::GLB:
         {
-            GltfImporter* importer = new GltfImporter();
-
-            if (!importer->LoadFromFile(file_path))
-            {
-                ISLE_ERROR("Failed to load GLTF file %s\n", file_path.c_str());
-                delete importer;
-                return nullptr;
-            }
-
-            SceneComponent* root = importer->m_RootComponent;
-
-            importer->m_SceneComponents.clear();
-            importer->m_StaticMeshes.clear();
-            importer->m_Materials.clear();
-            importer->m_Textures.clear();
-            importer->m_RootComponent = nullptr;
-            return root;
+            // The asset keeps the imported objects alive, the caller only borrows the tree.
+            Asset* asset = AssetManager::Instance()->Load(file_path);
+            return asset ? Cast<SceneComponent>(asset->m_RootObject) : nullptr;
         }
 
         default:
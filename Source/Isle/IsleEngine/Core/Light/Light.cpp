@@ -24,20 +24,6 @@ namespace Isle
         m_Intensity = 3.0f;
     }
 
-    glm::mat4 DirectionalLight::GetLightSpaceMatrix()
-    {
-        float orthoSize = 20.0f;
-        float nearPlane = 0.1f;
-        float farPlane = 150.0f;
-
-        glm::vec3 lightDir = glm::normalize(m_Dir);
-        glm::vec3 target = glm::vec3(0.0f);
-        glm::vec3 lightPos = target - lightDir * 100.0f;
-        m_ViewMatrix = glm::lookAt(lightPos, target, glm::vec3(0.0f, 1.0f, 0.0f));
-        m_ProjectionMatrix = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, nearPlane, farPlane);
-        return m_ProjectionMatrix * m_ViewMatrix;
-    }
-
     PointLight::PointLight()
     {
         m_Position = glm::vec3(0.0f, 10.0f, 0.0f);
@@ -107,7 +93,9 @@ namespace Isle
         gpu.m_Intensity = m_Intensity;
         gpu.m_Direction = m_Dir;
         gpu.m_Type = 0;
-        gpu.m_LightSpaceMatrix = GetLightSpaceMatrix();
+
+        // Cascades are fitted to the camera every frame by the shadow pass.
+        gpu.m_LightSpaceMatrix = glm::mat4(1.0f);
         return gpu;
     }
 
@@ -137,4 +125,31 @@ namespace Isle
         gpu.m_LightSpaceMatrix = GetLightSpaceMatrix();
         return gpu;
     }
+
+    BEGIN_REFLECT_CLASS(Light)
+        REFLECT_PARENT_CLASS(SceneComponent)
+        REFLECT_PROP(m_CastShadows, PropertyFlags::EditAnywhere)
+        REFLECT_PROP(m_Intensity, PropertyFlags::EditAnywhere)
+        REFLECT_PROP(m_Color, PropertyFlags::EditAnywhere)
+    END_REFLECT_CLASS(Light)
+
+    BEGIN_REFLECT_CLASS(DirectionalLight)
+        REFLECT_PARENT_CLASS(Light)
+        REFLECT_PROP(m_Dir, PropertyFlags::EditAnywhere)
+    END_REFLECT_CLASS(DirectionalLight)
+
+    BEGIN_REFLECT_CLASS(PointLight)
+        REFLECT_PARENT_CLASS(Light)
+        REFLECT_PROP(m_Radius, PropertyFlags::EditAnywhere)
+        REFLECT_PROP(m_Position, PropertyFlags::EditAnywhere)
+    END_REFLECT_CLASS(PointLight)
+
+    BEGIN_REFLECT_CLASS(SpotLight)
+        REFLECT_PARENT_CLASS(Light)
+        REFLECT_PROP(m_Position, PropertyFlags::EditAnywhere)
+        REFLECT_PROP(m_Direction, PropertyFlags::EditAnywhere)
+        REFLECT_PROP(m_Radius, PropertyFlags::EditAnywhere)
+        REFLECT_PROP(m_InnerCone, PropertyFlags::EditAnywhere)
+        REFLECT_PROP(m_OuterCone, PropertyFlags::EditAnywhere)
+    END_REFLECT_CLASS(SpotLight)
 }
@@ -6,6 +6,9 @@ namespace Isle
 {
 	class Light : public SceneComponent
 	{
+		GENERATED_BODY()
+		ISLE_TYPE(Light, SceneComponent)
+
 	public:
 		int m_Id = -1;
 		glm::mat4 m_ViewMatrix;
@@ -25,17 +28,22 @@ namespace Isle
 
 	class DirectionalLight : public Light
 	{
+		GENERATED_BODY()
+		ISLE_TYPE(DirectionalLight, Light)
+
 	public:
 		glm::vec3 m_Dir;
 
 	public:
 		DirectionalLight();
-		glm::mat4 GetLightSpaceMatrix();
 		virtual GpuLight ToGpuLight() override;
 	};
 
 	class PointLight : public Light
 	{
+		GENERATED_BODY()
+		ISLE_TYPE(PointLight, Light)
+
 	public:
 		float m_Radius = 25.0f;
 		glm::vec3 m_Position;
@@ -51,6 +59,9 @@ namespace Isle
 
 	class SpotLight : public Light
 	{
+		GENERATED_BODY()
+		ISLE_TYPE(SpotLight, Light)
+
 	public:
 		glm::vec3 m_Position;
 		glm::vec3 m_Direction;
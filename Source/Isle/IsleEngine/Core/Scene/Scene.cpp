@@ -9,11 +9,8 @@ namespace Isle
 {
     void Scene::Start()
     {
-        for (auto& child : GetChildren())
+        for (SceneComponent* child : Children())
         {
-            if (!child || !child->IsValid())
-                continue;
-
             m_Components[child] = { child, ComponentState::PendingStart, false };
             m_ProcessQueue.push(child);
         }
@@ -25,11 +22,14 @@ namespace Isle
         // Process everything in batches - no artificial frame limits
         while (!m_ProcessQueue.empty())
         {
-            // Collect all components to start
-            std::vector<SceneComponent*> toStart;
-            std::vector<SceneComponent*> toUpload;
-
+            // Collect all components to start, scratch lists live in frame memory
             size_t queueSize = m_ProcessQueue.size();
+
+            FrameVector<SceneComponent*> toStart;
+            FrameVector<SceneComponent*> toUpload;
+            toStart.reserve(queueSize);
+            toUpload.reserve(queueSize);
+
             for (size_t i = 0; i < queueSize; ++i)
             {
                 SceneComponent* comp = m_ProcessQueue.front();
@@ -73,25 +73,24 @@ namespace Isle
                 if (pipeline)
                 {
                     // Group by type for efficient pipeline operations
-                    std::vector<StaticMesh*> meshes;
-                    std::vector<Light*> lights;
+                    FrameVector<StaticMesh*> meshes;
+                    FrameVector<Light*> lights;
+                    meshes.reserve(toUpload.size());
+                    lights.reserve(toUpload.size());
                     Camera* camera = nullptr;
 
                     for (auto* comp : toUpload)
                     {
-                        if (auto* mesh = dynamic_cast<StaticMesh*>(comp))
+                        if (auto* mesh = Cast<StaticMesh>(comp))
                             meshes.push_back(mesh);
-                        else if (auto* light = dynamic_cast<Light*>(comp))
+                        else if (auto* light = Cast<Light>(comp))
                             lights.push_back(light);
-                        else if (auto* cam = dynamic_cast<Camera*>(comp))
+                        else if (auto* cam = Cast<Camera>(comp))
                             camera = cam;
 
                         // Handle children
-                        for (auto& child : comp->GetChildren())
+                        for (SceneComponent* child : comp->Children())
                         {
-                            if (!child || !child->IsValid())
-                                continue;
-
                             if (m_Components.count(child) == 0)
                             {
                                 m_Components[child] = { child, ComponentState::PendingStart, false };
@@ -126,11 +125,8 @@ namespace Isle
         m_IsUploading = !m_ProcessQueue.empty();
 
         // Update all active components
-        for (auto* child : GetChildren())
+        for (SceneComponent* child : Children())
         {
-            if (!child || !child->IsValid())
-                continue;
-
             auto it = m_Components.find(child);
             if (it != m_Components.end() && it->second.state == ComponentState::Active)
                 UpdateComponent(child, delta_time);
@@ -170,8 +166,19 @@ namespace Isle
         bool wasOwned = it->second.owned;
         m_Components.erase(it);
 
+        ReleaseFromPipeline(component);
+
         if (deleteIt && wasOwned)
+        {
             DestroyComponent(component, true);
+            return;
+        }
+
+        // The subtree leaves with its root, adding it back uploads all of it again.
+        component->ForEachDescendant<SceneComponent>([&](SceneComponent* child)
+            {
+                m_Components.erase(child);
+            });
     }
 
     void Scene::ClearAll()
@@ -224,18 +231,15 @@ namespace Isle
         if (!pipeline)
             return;
 
-        if (auto* mesh = dynamic_cast<StaticMesh*>(component))
+        if (auto* mesh = Cast<StaticMesh>(component))
             pipeline->AddStaticMesh(mesh);
-        else if (auto* light = dynamic_cast<Light*>(component))
+        else if (auto* light = Cast<Light>(component))
             pipeline->AddLight(light);
-        else if (auto* camera = dynamic_cast<Camera*>(component))
+        else if (auto* camera = Cast<Camera>(component))
             pipeline->SetCamera(camera);
 
-        for (auto& child : component->GetChildren())
+        for (SceneComponent* child : component->Children())
         {
-            if (!child || !child->IsValid())
-                continue;
-
             if (m_Components.count(child) == 0)
             {
                 m_Components[child] = { child, ComponentState::PendingStart, false };
@@ -244,6 +248,24 @@ namespace Isle
         }
     }
 
+    void Scene::ReleaseFromPipeline(SceneComponent* component)
+    {
+        if (!component || !component->IsValid() || !Render::IsValid())
+            return;
+
+        auto pipeline = Render::Instance()->GetPipeline();
+        if (!pipeline)
+            return;
+
+        if (auto* mesh = Cast<StaticMesh>(component))
+            pipeline->RemoveStaticMesh(mesh);
+
+        component->ForEachDescendant<StaticMesh>([&](StaticMesh* mesh)
+            {
+                pipeline->RemoveStaticMesh(mesh);
+            });
+    }
+
     void Scene::StartComponent(SceneComponent* component)
     {
         if (!component || !component->IsValid())
@@ -290,19 +312,16 @@ namespace Isle
         auto pipeline = Render::Instance()->GetPipeline();
         if (pipeline)
         {
-            if (auto* mainCam = dynamic_cast<MainCamera*>(component))
+            if (auto* mainCam = Cast<MainCamera>(component))
                 pipeline->SetCamera(mainCam->GetCamera());
-            else if (auto* mesh = dynamic_cast<StaticMesh*>(component))
+            else if (auto* mesh = Cast<StaticMesh>(component))
                 pipeline->UpdateStaticMesh(mesh);
-            else if (auto* light = dynamic_cast<Light*>(component))
+            else if (auto* light = Cast<Light>(component))
                 pipeline->UpdateLight(light);
         }
 
-        for (auto& child : component->GetChildren())
+        for (SceneComponent* child : component->Children())
         {
-            if (!child || !child->IsValid())
-                continue;
-
             auto it = m_Components.find(child);
             if (it != m_Components.end() && it->second.state == ComponentState::Active)
                 UpdateComponent(child, delta_time);
@@ -402,4 +421,8 @@ namespace Isle
             ISLE_ERROR("Unknown exception in SafeDelete\n");
         }
     }
-}
\ No newline at end of file
+
+    // SceneComponent lives in a header, its reflection is registered with the scene.
+    BEGIN_REFLECT_CLASS(SceneComponent)
+    END_REFLECT_CLASS(SceneComponent)
+}
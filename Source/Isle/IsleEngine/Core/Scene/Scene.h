@@ -35,12 +35,14 @@ namespace Isle
         void ClearAll();
         bool IsManaged(SceneComponent* component) const;
         bool IsOwned(SceneComponent* component) const;
+        bool IsUploading() const { return m_IsUploading; }
 
     private:
         void StartComponent(SceneComponent* component);
         void UpdateComponent(SceneComponent* component, float delta_time);
         void DestroyComponent(SceneComponent* component, bool deleteIt);
         void UploadComponentToPipeline(SceneComponent* component);
+        void ReleaseFromPipeline(SceneComponent* component);
         void SafeDelete(SceneComponent* component);
     };
 }
\ No newline at end of file
@@ -0,0 +1,476 @@
+// SceneSerializer.cpp
+#include "SceneSerializer.h"
+#include <Core/Common/MappedFile/MappedFile.h>
+#include <Core/AssetManager/AssetManager.h>
+#include <Core/Graphics/Mesh/Mesh.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <typeindex>
+
+namespace Isle
+{
+    static constexpr uint32_t SCENE_NO_PARENT = UINT32_MAX;
+    static constexpr uint32_t SCENE_LOAD_BATCH = 256;
+
+    struct SceneFileHeader
+    {
+        uint32_t m_Magic;
+        uint32_t m_Version;
+        uint32_t m_NodeCount;
+        uint32_t m_ClassCount;
+        uint32_t m_AssetCount;
+        uint32_t _pad0;
+        uint64_t m_ClassOffset;     // class schemas
+        uint64_t m_AssetOffset;     // asset paths
+        uint64_t m_NodeOffset;      // SceneNodeRecord per node
+        uint64_t m_TransformOffset; // SceneTransformRecord per node
+        uint64_t m_DataOffset;      // node names and property values
+        uint64_t m_DataSize;
+    };
+
+    struct SceneNodeRecord
+    {
+        uint32_t m_Parent;          // earlier node index or SCENE_NO_PARENT
+        uint32_t m_Class;
+        uint64_t m_DataOffset;      // relative to the data section
+        uint32_t m_DataSize;
+        int32_t m_Asset;            // asset table index or -1
+        int32_t m_AssetObject;
+        uint32_t _pad0;
+    };
+
+    struct SceneTransformRecord
+    {
+        glm::vec3 m_Translation;
+        glm::quat m_Rotation;
+        glm::vec3 m_Scale;
+    };
+
+    static void AlignTo8(std::ofstream& file, uint64_t& offset)
+    {
+        static const char zeros[8] = {};
+        const uint64_t padding = (8 - (offset & 7)) & 7;
+        file.write(zeros, static_cast<std::streamsize>(padding));
+        offset += padding;
+    }
+
+    bool SceneSerializer::Save(const std::string& path, SceneComponent* root)
+    {
+        if (!root)
+            return false;
+
+        ScopedTimer timer("SceneSerializer::Save");
+
+        struct SaveClass
+        {
+            ClassDescriptor* m_Descriptor = nullptr;
+            std::vector<PropertyField> m_Fields;
+        };
+
+        ReflectionRegistry* registry = ReflectionRegistry::Instance();
+        AssetManager* assetManager = AssetManager::Instance();
+
+        std::unordered_map<ClassDescriptor*, uint32_t> classIndices;
+        std::vector<SaveClass> classes;
+        std::unordered_map<int, int32_t> assetIndices;
+        std::vector<std::string> assetPaths;
+
+        std::vector<SceneNodeRecord> nodes;
+        std::vector<SceneTransformRecord> transforms;
+        BinaryWriter data;
+        size_t skipped = 0;
+
+        // Depth first so every parent lands before its children.
+        std::vector<std::pair<SceneComponent*, uint32_t>> stack;
+        for (auto it = root->m_Children.rbegin(); it != root->m_Children.rend(); ++it)
+            stack.push_back({ *it, SCENE_NO_PARENT });
+
+        while (!stack.empty())
+        {
+            auto [node, parent] = stack.back();
+            stack.pop_back();
+
+            if (!node || !node->IsValid())
+                continue;
+
+            ClassDescriptor* descriptor = registry->GetClass(std::type_index(typeid(*node)));
+            if (!descriptor || !descriptor->CanCreate())
+            {
+                skipped++;
+                continue;
+            }
+
+            auto classIt = classIndices.find(descriptor);
+            if (classIt == classIndices.end())
+            {
+                SaveClass saveClass;
+                saveClass.m_Descriptor = descriptor;
+                for (const PropertyField& field : descriptor->GetLayout())
+                {
+                    if (field.m_Property->IsSerializable())
+                        saveClass.m_Fields.push_back(field);
+                }
+
+                classIt = classIndices.emplace(descriptor, static_cast<uint32_t>(classes.size())).first;
+                classes.push_back(std::move(saveClass));
+            }
+
+            SceneNodeRecord record{};
+            record.m_Parent = parent;
+            record.m_Class = classIt->second;
+            record.m_DataOffset = data.GetSize();
+            record.m_Asset = -1;
+            record.m_AssetObject = -1;
+
+            const void* instance = dynamic_cast<const void*>(node);
+            data.WriteString(node->GetName());
+            for (const PropertyField& field : classes[record.m_Class].m_Fields)
+            {
+                if (field.m_Trivial)
+                    data.WriteBytes(field.GetField(instance), field.m_Size);
+                else
+                    field.m_Property->Serialize(field.GetField(instance), data);
+            }
+            record.m_DataSize = static_cast<uint32_t>(data.GetSize() - record.m_DataOffset);
+
+            if (Mesh* mesh = Cast<Mesh>(node); mesh && mesh->m_AssetId >= 0)
+            {
+                Asset* asset = assetManager->GetAsset(mesh->m_AssetId);
+                if (asset && !asset->m_Path.empty())
+                {
+                    auto assetIt = assetIndices.find(mesh->m_AssetId);
+                    if (assetIt == assetIndices.end())
+                    {
+                        assetIt = assetIndices.emplace(mesh->m_AssetId, static_cast<int32_t>(assetPaths.size())).first;
+                        assetPaths.push_back(asset->m_Path);
+                    }
+
+                    record.m_Asset = assetIt->second;
+                    record.m_AssetObject = mesh->m_AssetObjectId;
+                }
+            }
+
+            const uint32_t index = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(record);
+            transforms.push_back({ node->m_Transform.m_Translation, node->m_Transform.m_Rotation, node->m_Transform.m_Scale });
+
+            for (auto it = node->m_Children.rbegin(); it != node->m_Children.rend(); ++it)
+                stack.push_back({ *it, index });
+        }
+
+        BinaryWriter classData;
+        for (const SaveClass& saveClass : classes)
+        {
+            classData.WriteString(saveClass.m_Descriptor->GetName());
+            classData.Write(static_cast<uint32_t>(saveClass.m_Fields.size()));
+            for (const PropertyField& field : saveClass.m_Fields)
+            {
+                classData.WriteString(field.m_Property->GetName());
+                classData.Write(static_cast<uint32_t>(field.m_Type));
+                classData.Write(static_cast<uint32_t>(field.m_Property->GetSerializedSize()));
+            }
+        }
+
+        BinaryWriter assetData;
+        for (const std::string& assetPath : assetPaths)
+            assetData.WriteString(assetPath);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            ISLE_ERROR("SceneSerializer: cannot write %s\n", path.c_str());
+            return false;
+        }
+
+        SceneFileHeader header{};
+        header.m_Magic = MAGIC;
+        header.m_Version = VERSION;
+        header.m_NodeCount = static_cast<uint32_t>(nodes.size());
+        header.m_ClassCount = static_cast<uint32_t>(classes.size());
+        header.m_AssetCount = static_cast<uint32_t>(assetPaths.size());
+
+        // Header first with the offsets filled in afterwards, sections start 8 byte aligned
+        // so the loader can use the node and transform tables in place.
+        uint64_t offset = sizeof(header);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        header.m_ClassOffset = offset;
+        file.write(reinterpret_cast<const char*>(classData.GetData()), classData.GetSize());
+        offset += classData.GetSize();
+
+        header.m_AssetOffset = offset;
+        file.write(reinterpret_cast<const char*>(assetData.GetData()), assetData.GetSize());
+        offset += assetData.GetSize();
+
+        AlignTo8(file, offset);
+        header.m_NodeOffset = offset;
+        file.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(SceneNodeRecord));
+        offset += nodes.size() * sizeof(SceneNodeRecord);
+
+        AlignTo8(file, offset);
+        header.m_TransformOffset = offset;
+        file.write(reinterpret_cast<const char*>(transforms.data()), transforms.size() * sizeof(SceneTransformRecord));
+        offset += transforms.size() * sizeof(SceneTransformRecord);
+
+        AlignTo8(file, offset);
+        header.m_DataOffset = offset;
+        header.m_DataSize = data.GetSize();
+        file.write(reinterpret_cast<const char*>(data.GetData()), data.GetSize());
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (!file)
+        {
+            ISLE_ERROR("SceneSerializer: failed writing %s\n", path.c_str());
+            return false;
+        }
+
+        if (skipped > 0)
+            ISLE_WARN("SceneSerializer: skipped %zu components without a reflected class\n", skipped);
+
+        ISLE_LOG("SceneSerializer: saved %zu nodes, %zu classes, %zu assets to %s\n", nodes.size(), classes.size(), assetPaths.size(), path.c_str());
+        return true;
+    }
+
+    SceneComponent* SceneSerializer::Load(const std::string& path)
+    {
+        ScopedTimer timer("SceneSerializer::Load");
+
+        MappedFile file;
+        if (!file.Open(path))
+        {
+            ISLE_ERROR("SceneSerializer: cannot open %s\n", path.c_str());
+            return nullptr;
+        }
+
+        const uint8_t* bytes = file.GetData();
+        const size_t size = file.GetSize();
+
+        SceneFileHeader header{};
+        if (size < sizeof(header))
+        {
+            ISLE_ERROR("SceneSerializer: %s is truncated\n", path.c_str());
+            return nullptr;
+        }
+        std::memcpy(&header, bytes, sizeof(header));
+
+        if (header.m_Magic != MAGIC || header.m_Version != VERSION)
+        {
+            ISLE_ERROR("SceneSerializer: %s is not a version %u scene\n", path.c_str(), VERSION);
+            return nullptr;
+        }
+
+        auto sectionFits = [size](uint64_t offset, uint64_t length) { return offset <= size && length <= size - offset; };
+        if (!sectionFits(header.m_ClassOffset, 0) || !sectionFits(header.m_AssetOffset, 0) ||
+            !sectionFits(header.m_NodeOffset, uint64_t(header.m_NodeCount) * sizeof(SceneNodeRecord)) ||
+            !sectionFits(header.m_TransformOffset, uint64_t(header.m_NodeCount) * sizeof(SceneTransformRecord)) ||
+            !sectionFits(header.m_DataOffset, header.m_DataSize) ||
+            (header.m_NodeOffset & 7) || (header.m_TransformOffset & 7))
+        {
+            ISLE_ERROR("SceneSerializer: %s has corrupt section offsets\n", path.c_str());
+            return nullptr;
+        }
+
+        // Match the stored schemas against the live classes once, per node work is then a
+        // straight walk. Properties that were removed or changed type are skipped, classes
+        // that no longer exist load as plain SceneComponents so the hierarchy survives.
+        struct LoadClass
+        {
+            ClassDescriptor* m_Descriptor = nullptr;
+            std::vector<PropertyField> m_Fields;    // m_Property is null for skipped ones
+            std::vector<uint32_t> m_Sizes;
+        };
+
+        ReflectionRegistry* registry = ReflectionRegistry::Instance();
+        std::vector<LoadClass> classes(header.m_ClassCount);
+
+        BinaryReader classReader(bytes + header.m_ClassOffset, size - header.m_ClassOffset);
+        for (LoadClass& loadClass : classes)
+        {
+            const std::string className(classReader.ReadString());
+            ClassDescriptor* descriptor = registry->GetClass(className);
+            if (!descriptor || !descriptor->CanCreate())
+            {
+                ISLE_WARN("SceneSerializer: unknown class '%s', loading as SceneComponent\n", className.c_str());
+                descriptor = nullptr;
+            }
+            loadClass.m_Descriptor = descriptor ? descriptor : SceneComponent::StaticClass();
+
+            const uint32_t propertyCount = classReader.Read<uint32_t>();
+            for (uint32_t i = 0; i < propertyCount && classReader.IsValid(); i++)
+            {
+                const std::string propertyName(classReader.ReadString());
+                const PropertyType type = static_cast<PropertyType>(classReader.Read<uint32_t>());
+                const uint32_t propertySize = classReader.Read<uint32_t>();
+
+                PropertyField field;
+                const uint32_t index = descriptor ? descriptor->FindField(propertyName) : ClassDescriptor::INVALID_FIELD;
+                if (index != ClassDescriptor::INVALID_FIELD)
+                {
+                    const PropertyField& live = descriptor->GetLayout()[index];
+                    if (live.m_Type == type && live.m_Property->IsSerializable() && live.m_Property->GetSerializedSize() == propertySize)
+                        field = live;
+                }
+
+                loadClass.m_Fields.push_back(field);
+                loadClass.m_Sizes.push_back(propertySize);
+            }
+        }
+
+        if (!classReader.IsValid())
+        {
+            ISLE_ERROR("SceneSerializer: %s has a corrupt class table\n", path.c_str());
+            return nullptr;
+        }
+
+        // Meshes point into assets, bring those in first (already loaded ones are reused).
+        AssetManager* assetManager = AssetManager::Instance();
+        std::vector<Asset*> assets(header.m_AssetCount, nullptr);
+
+        BinaryReader assetReader(bytes + header.m_AssetOffset, size - header.m_AssetOffset);
+        for (Asset*& asset : assets)
+        {
+            const std::string assetPath(assetReader.ReadString());
+            if (!assetReader.IsValid())
+                break;
+
+            asset = assetManager->Find(assetPath);
+            if (!asset)
+                asset = assetManager->Load(assetPath);
+            if (asset)
+                asset->m_Pinned = true;     // nodes of the scene point into it from here on
+            else
+                ISLE_WARN("SceneSerializer: missing asset %s\n", assetPath.c_str());
+        }
+
+        const SceneNodeRecord* records = reinterpret_cast<const SceneNodeRecord*>(bytes + header.m_NodeOffset);
+        const SceneTransformRecord* transforms = reinterpret_cast<const SceneTransformRecord*>(bytes + header.m_TransformOffset);
+        const uint8_t* data = bytes + header.m_DataOffset;
+        const uint32_t nodeCount = header.m_NodeCount;
+
+        for (uint32_t i = 0; i < nodeCount; i++)
+        {
+            const SceneNodeRecord& record = records[i];
+            if ((record.m_Parent != SCENE_NO_PARENT && record.m_Parent >= i) ||
+                record.m_Class >= header.m_ClassCount ||
+                record.m_DataOffset > header.m_DataSize || record.m_DataSize > header.m_DataSize - record.m_DataOffset)
+            {
+                ISLE_ERROR("SceneSerializer: %s has a corrupt node table\n", path.c_str());
+                return nullptr;
+            }
+        }
+
+        // Allocation stays on this thread, filling in the nodes does not touch anything shared.
+        std::vector<SceneComponent*> components(nodeCount, nullptr);
+        for (uint32_t i = 0; i < nodeCount; i++)
+        {
+            Object* object = classes[records[i].m_Class].m_Descriptor->Create();
+            components[i] = Cast<SceneComponent>(object);
+            if (!components[i])
+            {
+                delete object;
+                components[i] = new SceneComponent();
+            }
+        }
+
+        std::atomic<uint32_t> nextBatch(0);
+        std::atomic<uint32_t> corruptNodes(0);
+
+        auto fillNodes = [&]()
+            {
+                uint32_t first;
+                while ((first = nextBatch.fetch_add(SCENE_LOAD_BATCH)) < nodeCount)
+                {
+                    const uint32_t last = glm::min(first + SCENE_LOAD_BATCH, nodeCount);
+                    for (uint32_t i = first; i < last; i++)
+                    {
+                        const SceneNodeRecord& record = records[i];
+                        const LoadClass& loadClass = classes[record.m_Class];
+                        SceneComponent* component = components[i];
+                        void* instance = dynamic_cast<void*>(component);
+
+                        BinaryReader reader(data + record.m_DataOffset, record.m_DataSize);
+                        component->SetName(std::string(reader.ReadString()));
+
+                        for (size_t p = 0; p < loadClass.m_Fields.size(); p++)
+                        {
+                            const PropertyField& field = loadClass.m_Fields[p];
+                            if (field.m_Property && field.m_Trivial)
+                                reader.ReadBytes(field.GetField(instance), field.m_Size);
+                            else if (field.m_Property)
+                                field.m_Property->Deserialize(field.GetField(instance), reader);
+                            else if (loadClass.m_Sizes[p] > 0)
+                                reader.Skip(loadClass.m_Sizes[p]);
+                            else
+                                reader.ReadString();
+                        }
+
+                        if (!reader.IsValid())
+                            corruptNodes.fetch_add(1);
+
+                        const SceneTransformRecord& transform = transforms[i];
+                        component->m_Transform.m_Translation = transform.m_Translation;
+                        component->m_Transform.m_Rotation = transform.m_Rotation;
+                        component->m_Transform.m_Scale = transform.m_Scale;
+                        component->MarkDirty();
+
+                        if (record.m_Asset < 0 || record.m_Asset >= static_cast<int32_t>(assets.size()) || !assets[record.m_Asset])
+                            continue;
+
+                        Mesh* mesh = Cast<Mesh>(component);
+                        auto objectIt = assets[record.m_Asset]->m_Objects.find(record.m_AssetObject);
+                        if (mesh && objectIt != assets[record.m_Asset]->m_Objects.end())
+                        {
+                            if (Mesh* source = Cast<Mesh>(objectIt->second))
+                                mesh->CopyGeometry(*source);
+                        }
+                    }
+                }
+            };
+
+        unsigned int numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0) numThreads = 4;
+        numThreads = glm::min(numThreads, nodeCount / SCENE_LOAD_BATCH + 1);
+
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(numThreads - 1);
+            for (unsigned int i = 1; i < numThreads; i++)
+                threads.emplace_back(fillNodes);
+
+            fillNodes();
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        if (corruptNodes > 0)
+            ISLE_WARN("SceneSerializer: %u nodes in %s had truncated properties\n", corruptNodes.load(), path.c_str());
+
+        // Link in one pass, the table order guarantees parents already exist. Going through
+        // m_Children directly skips AddChild's duplicate search, which is quadratic for wide nodes.
+        SceneComponent* root = new SceneComponent();
+        root->SetName(std::filesystem::path(path).stem().string());
+
+        std::vector<uint32_t> childCounts(nodeCount + 1, 0);
+        for (uint32_t i = 0; i < nodeCount; i++)
+            childCounts[records[i].m_Parent == SCENE_NO_PARENT ? nodeCount : records[i].m_Parent]++;
+
+        root->m_Children.reserve(childCounts[nodeCount]);
+        for (uint32_t i = 0; i < nodeCount; i++)
+            components[i]->m_Children.reserve(childCounts[i]);
+
+        for (uint32_t i = 0; i < nodeCount; i++)
+        {
+            SceneComponent* parent = records[i].m_Parent == SCENE_NO_PARENT ? root : components[records[i].m_Parent];
+            components[i]->m_Owner = parent;
+            parent->m_Children.push_back(components[i]);
+        }
+
+        ISLE_LOG("SceneSerializer: loaded %u nodes from %s\n", nodeCount, path.c_str());
+        return root;
+    }
+}
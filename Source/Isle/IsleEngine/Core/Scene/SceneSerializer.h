@@ -0,0 +1,29 @@
+// SceneSerializer.h
+#pragma once
+#include <Core/Common/Common.h>
+
+namespace Isle
+{
+    // Binary scene files built from the reflection registry. A file holds a flat node table in
+    // depth first order, one transform per node, the reflected properties of every node packed
+    // in the order its class schema lists them, and meshes as references into loaded assets.
+    //
+    // Only classes registered with reflection are written, anything else (engine singletons
+    // like the camera and the world) is skipped together with its children. Loading maps the
+    // file, creates every node up front and fills them in from worker threads, then links the
+    // hierarchy in one pass.
+    class ISLEENGINE_API SceneSerializer
+    {
+    public:
+        static constexpr uint32_t MAGIC = 0x4E435349; // "ISCN"
+        static constexpr uint32_t VERSION = 1;
+
+    public:
+        // Saves the children of root, root itself is not written.
+        static bool Save(const std::string& path, SceneComponent* root);
+
+        // Returns a new component holding the loaded top level nodes, or nullptr. The caller
+        // owns it, usually by handing it to Scene::Add.
+        static SceneComponent* Load(const std::string& path);
+    };
+}
@@ -5,7 +5,7 @@ namespace Isle
 	void World::Start()
 	{
 		SetName("World");
-		if (GetChildren<DirectionalLight>().empty())
+		if (Children<DirectionalLight>().empty())
 		{
 			auto* dirLight = new DirectionalLight();
 			dirLight->SetName("Directional Light");
@@ -3,16 +3,19 @@
 #include <Core/Common/Common.h>
 #include <Core/Graphics/Render.h>
 #include <Core/Graphics/Window/Window.h>
+#include <Core/Graphics/GfxDevice/NullDevice.h>
 #include <Core/Camera/MainCamera.h>
 #include <Core/Camera/CameraMan.h>
 #include <Core/Graphics/Mesh/StaticMesh.h>
 #include <Core/Graphics/Mesh/PrimitiveMesh.h>
 #include <Core/Input/Input.h>
 #include <Core/Scene/Scene.h>
+#include <Core/Scene/SceneSerializer.h>
 #include <Core/World/World.h>
 #include <Core/Graphics/Texture/Texture.h>
 #include <Core/AssetManager/AssetManager.h>
 #include <Core/Camera/EditorCamera.h>
 #include <Core/Camera/OrthographicCamera.h>
 #include <Core/Engine/Engine.h>
+#include <Core/Animation/AnimationSystem.h>
 #include <Core/Application/Application.h>
\ No newline at end of file
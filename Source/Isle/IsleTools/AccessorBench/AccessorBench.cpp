@@ -0,0 +1,207 @@
+// AccessorBench.cpp
+#include <Core/Importer/Gltf/GltfAccessor.h>
+#include <Core/Graphics/Structs/GpuStructs.h>
+#include <cstring>
+#include <random>
+
+using namespace Isle;
+
+namespace
+{
+    // Interleaved layout: position, normal, texcoord, tangent.
+    constexpr size_t STRIDE = (3 + 3 + 2 + 4) * sizeof(float);
+
+    // Where one vertex attribute lives, the same description for both decoders.
+    struct Attribute
+    {
+        const uint8_t* m_Data = nullptr;
+        size_t m_Stride = 0;
+        uint32_t m_Components = 0;
+
+        const float* Get(size_t v) const { return reinterpret_cast<const float*>(m_Data + v * m_Stride); }
+    };
+
+    struct Layout
+    {
+        const char* m_Name = "";
+        Attribute m_Position, m_Normal, m_TexCoord, m_Tangent;
+    };
+
+    struct Timer
+    {
+        std::chrono::high_resolution_clock::time_point m_Start = std::chrono::high_resolution_clock::now();
+
+        double Seconds() const
+        {
+            return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - m_Start).count();
+        }
+    };
+
+    // The importer loop before GltfAccessor: one vertex at a time, scalar packing.
+    void DecodeReference(const Layout& layout, const uint16_t* indexData, size_t vertexCount, size_t indexCount,
+        std::vector<GpuVertex>& outVertices, std::vector<unsigned int>& outIndices, glm::vec3& minBounds, glm::vec3& maxBounds)
+    {
+        std::vector<GpuVertex> vertices;
+        vertices.reserve(vertexCount);
+        minBounds = glm::vec3(FLT_MAX);
+        maxBounds = glm::vec3(-FLT_MAX);
+
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            const float* p = layout.m_Position.Get(v);
+            const float* n = layout.m_Normal.Get(v);
+            const float* uv = layout.m_TexCoord.Get(v);
+            const float* t = layout.m_Tangent.Get(v);
+
+            glm::vec3 position(p[0], p[1], p[2]);
+            vertices.emplace_back(position, glm::vec3(n[0], n[1], n[2]), glm::vec3(t[0], t[1], t[2]), glm::vec2(uv[0], 1.0f - uv[1]), glm::vec4(1.0f));
+
+            minBounds = glm::min(minBounds, position);
+            maxBounds = glm::max(maxBounds, position);
+        }
+
+        std::vector<unsigned int> indices;
+        indices.reserve(indexCount);
+        for (size_t i = 0; i < indexCount; i++)
+            indices.push_back(indexData[i]);
+
+        outVertices.swap(vertices);
+        outIndices.swap(indices);
+    }
+
+    AccessorView MakeView(const Attribute& attribute, size_t count)
+    {
+        AccessorView view;
+        view.m_Data = attribute.m_Data;
+        view.m_Count = count;
+        view.m_Stride = attribute.m_Stride;
+        view.m_Components = attribute.m_Components;
+        return view;
+    }
+
+    // The importer loop with GltfAccessor.
+    void DecodeAccessor(const Layout& layout, const uint16_t* indexData, size_t vertexCount, size_t indexCount,
+        std::vector<GpuVertex>& outVertices, std::vector<unsigned int>& outIndices, glm::vec3& minBounds, glm::vec3& maxBounds)
+    {
+        AccessorView positionView = MakeView(layout.m_Position, vertexCount);
+        AccessorView normalView = MakeView(layout.m_Normal, vertexCount);
+        AccessorView texcoordView = MakeView(layout.m_TexCoord, vertexCount);
+        AccessorView tangentView = MakeView(layout.m_Tangent, vertexCount);
+
+        std::vector<GpuVertex> vertices(vertexCount);
+        GltfAccessor::DecodeVertices(positionView, &normalView, &tangentView, &texcoordView, vertices.data(), minBounds, maxBounds);
+
+        AccessorView indexView;
+        indexView.m_Data = reinterpret_cast<const uint8_t*>(indexData);
+        indexView.m_Count = indexCount;
+        indexView.m_Stride = sizeof(uint16_t);
+        indexView.m_ComponentType = ACCESSOR_COMPONENT::UNSIGNED_SHORT;
+        indexView.m_Components = 1;
+
+        std::vector<unsigned int> indices(indexCount);
+        GltfAccessor::ReadIndices(indexView, indices.data());
+
+        outVertices.swap(vertices);
+        outIndices.swap(indices);
+    }
+
+    // Times both decoders on the same input and compares their output. Returns false on a mismatch.
+    bool Run(const Layout& layout, const std::vector<uint16_t>& indexData, size_t vertexCount, int iterations)
+    {
+        std::vector<GpuVertex> referenceVertices, accessorVertices;
+        std::vector<unsigned int> referenceIndices, accessorIndices;
+        glm::vec3 referenceMin(0.0f), referenceMax(0.0f), accessorMin(0.0f), accessorMax(0.0f);
+
+        double referenceTime = FLT_MAX;
+        double accessorTime = FLT_MAX;
+
+        for (int i = 0; i < iterations; i++)
+        {
+            Timer timer;
+            DecodeReference(layout, indexData.data(), vertexCount, indexData.size(), referenceVertices, referenceIndices, referenceMin, referenceMax);
+            referenceTime = std::min(referenceTime, timer.Seconds());
+        }
+
+        for (int i = 0; i < iterations; i++)
+        {
+            Timer timer;
+            DecodeAccessor(layout, indexData.data(), vertexCount, indexData.size(), accessorVertices, accessorIndices, accessorMin, accessorMax);
+            accessorTime = std::min(accessorTime, timer.Seconds());
+        }
+
+        size_t mismatches = 0;
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            const GpuVertex& a = referenceVertices[v];
+            const GpuVertex& b = accessorVertices[v];
+            if (a.m_Position != b.m_Position || a.m_NormalTangent != b.m_NormalTangent || a.m_TexCoord != b.m_TexCoord || a.m_Color != b.m_Color)
+                mismatches++;
+        }
+
+        const bool indicesMatch = referenceIndices == accessorIndices;
+        const bool boundsMatch = referenceMin == accessorMin && referenceMax == accessorMax;
+
+        printf("%s input\n", layout.m_Name);
+        printf("  Reference: %8.2f ms  %8.1f M vertices/s\n", referenceTime * 1000.0, vertexCount / referenceTime / 1e6);
+        printf("  Accessor:  %8.2f ms  %8.1f M vertices/s\n", accessorTime * 1000.0, vertexCount / accessorTime / 1e6);
+        printf("  Speedup:   %.2fx\n", referenceTime / accessorTime);
+        printf("  Vertex mismatches: %zu, indices %s, bounds %s\n",
+            mismatches, indicesMatch ? "match" : "differ", boundsMatch ? "match" : "differ");
+
+        return mismatches == 0 && indicesMatch && boundsMatch;
+    }
+}
+
+// Usage: IsleAccessorBench [vertexCount] [iterations]
+int main(int argc, char** argv)
+{
+    const size_t vertexCount = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000000;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 10;
+    const size_t indexCount = vertexCount * 3;
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    std::vector<uint8_t> interleaved(vertexCount * STRIDE);
+    std::vector<float> positions(vertexCount * 3), normals(vertexCount * 3), texcoords(vertexCount * 2), tangents(vertexCount * 4);
+
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        float element[12];
+        for (float& f : element)
+            f = dist(rng) * 100.0f;
+        element[11] = 1.0f;
+
+        std::memcpy(interleaved.data() + v * STRIDE, element, STRIDE);
+        std::memcpy(&positions[v * 3], element + 0, 12);
+        std::memcpy(&normals[v * 3], element + 3, 12);
+        std::memcpy(&texcoords[v * 2], element + 6, 8);
+        std::memcpy(&tangents[v * 4], element + 8, 16);
+    }
+
+    std::vector<uint16_t> indexData(indexCount);
+    for (size_t i = 0; i < indexCount; i++)
+        indexData[i] = static_cast<uint16_t>(rng());
+
+    // Both decoders read the same buffers, first interleaved through the vertex stride, then
+    // as separate tightly packed accessors.
+    Layout interleavedLayout;
+    interleavedLayout.m_Name = "Interleaved";
+    interleavedLayout.m_Position = { interleaved.data() + 0, STRIDE, 3 };
+    interleavedLayout.m_Normal = { interleaved.data() + 12, STRIDE, 3 };
+    interleavedLayout.m_TexCoord = { interleaved.data() + 24, STRIDE, 2 };
+    interleavedLayout.m_Tangent = { interleaved.data() + 32, STRIDE, 4 };
+
+    Layout packedLayout;
+    packedLayout.m_Name = "Packed";
+    packedLayout.m_Position = { reinterpret_cast<const uint8_t*>(positions.data()), 12, 3 };
+    packedLayout.m_Normal = { reinterpret_cast<const uint8_t*>(normals.data()), 12, 3 };
+    packedLayout.m_TexCoord = { reinterpret_cast<const uint8_t*>(texcoords.data()), 8, 2 };
+    packedLayout.m_Tangent = { reinterpret_cast<const uint8_t*>(tangents.data()), 16, 4 };
+
+    printf("Vertices: %zu, indices: %zu, best of %d\n", vertexCount, indexCount, iterations);
+    bool match = Run(interleavedLayout, indexData, vertexCount, iterations);
+    match &= Run(packedLayout, indexData, vertexCount, iterations);
+
+    return match ? 0 : 1;
+}
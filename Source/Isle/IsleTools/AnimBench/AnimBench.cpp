@@ -0,0 +1,231 @@
+// AnimBench.cpp
+#include <Core/Animation/AnimationSystem.h>
+#include <memory>
+#include <random>
+
+using namespace Isle;
+
+namespace
+{
+    constexpr float SAMPLE_RATE = 30.0f;
+    constexpr float CLIP_LENGTH = 2.0f;
+
+    struct Timer
+    {
+        std::chrono::high_resolution_clock::time_point m_Start = std::chrono::high_resolution_clock::now();
+
+        double Seconds() const
+        {
+            return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - m_Start).count();
+        }
+    };
+
+    // Something like a swinging limb chain: every joint bobs and rotates on its own axis, scale
+    // is animated but never changes, so it collapses to one key.
+    std::vector<AnimationTrackSource> MakeTracks(uint32_t jointCount, uint32_t frameCount, float phase)
+    {
+        std::vector<AnimationTrackSource> tracks(jointCount);
+        for (uint32_t j = 0; j < jointCount; j++)
+        {
+            AnimationTrackSource& track = tracks[j];
+            const glm::vec3 axis = glm::normalize(glm::vec3(glm::sin(j * 0.7f), 1.0f, glm::cos(j * 0.7f)));
+
+            for (uint32_t f = 0; f < frameCount; f++)
+            {
+                const float t = f / SAMPLE_RATE * glm::two_pi<float>() / CLIP_LENGTH;
+                track.m_Translations.push_back(glm::vec3(0.02f * glm::sin(t + phase + j), 0.1f, 0.01f * glm::cos(2.0f * t + j)));
+                track.m_Rotations.push_back(glm::angleAxis(0.6f * glm::sin(t + phase + j * 0.3f), axis));
+                track.m_Scales.push_back(glm::vec3(1.0f));
+            }
+        }
+        return tracks;
+    }
+
+    // Straight from the uncompressed frames with glm, one joint at a time.
+    Transform SampleReference(const AnimationTrackSource& track, float time)
+    {
+        const float frame = glm::clamp(time * SAMPLE_RATE, 0.0f, static_cast<float>(track.m_Rotations.size() - 1));
+        const size_t from = static_cast<size_t>(frame);
+        const size_t to = glm::min(from + 1, track.m_Rotations.size() - 1);
+        const float alpha = frame - from;
+
+        Transform transform;
+        transform.m_Translation = glm::mix(track.m_Translations[from], track.m_Translations[to], alpha);
+        transform.m_Rotation = glm::slerp(track.m_Rotations[from], track.m_Rotations[to], alpha);
+        transform.m_Scale = glm::mix(track.m_Scales[from], track.m_Scales[to], alpha);
+        return transform;
+    }
+
+    struct Skeleton
+    {
+        std::vector<std::unique_ptr<SceneComponent>> m_Joints;
+        std::unique_ptr<Animator> m_Animator;
+    };
+
+    void EvaluateReference(const std::vector<Skeleton>& skeletons, const std::vector<AnimationTrackSource>* clipTracks, const AnimationClip* clips, std::vector<Transform>& out)
+    {
+        size_t index = 0;
+        for (const Skeleton& skeleton : skeletons)
+        {
+            Animator* animator = skeleton.m_Animator.get();
+            for (uint32_t j = 0; j < animator->GetTargetCount(); j++)
+            {
+                Transform blended;
+                blended.m_Translation = glm::vec3(0.0f);
+                blended.m_Rotation = glm::quat(0.0f, 0.0f, 0.0f, 0.0f);
+                blended.m_Scale = glm::vec3(0.0f);
+
+                float totalWeight = 0.0f;
+                for (size_t l = 0; l < animator->GetLayerCount(); l++)
+                {
+                    const AnimationLayer* layer = animator->GetLayer(l);
+                    const std::vector<AnimationTrackSource>& tracks = clipTracks[layer->m_Clip - clips];
+                    const Transform sample = SampleReference(tracks[j], layer->m_Time);
+
+                    const glm::quat rotation = glm::dot(blended.m_Rotation, sample.m_Rotation) < 0.0f ? -sample.m_Rotation : sample.m_Rotation;
+                    blended.m_Translation += sample.m_Translation * layer->m_Weight;
+                    blended.m_Rotation = blended.m_Rotation + rotation * layer->m_Weight;
+                    blended.m_Scale += sample.m_Scale * layer->m_Weight;
+                    totalWeight += layer->m_Weight;
+                }
+
+                blended.m_Translation /= totalWeight;
+                blended.m_Rotation = glm::normalize(blended.m_Rotation);
+                blended.m_Scale /= totalWeight;
+                out[index++] = blended;
+            }
+        }
+    }
+}
+
+// Usage: IsleAnimBench [skeletons] [joints] [frames] [layers]
+int main(int argc, char** argv)
+{
+    const uint32_t skeletonCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 2000;
+    const uint32_t jointCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 64;
+    const int frames = argc > 3 ? std::atoi(argv[3]) : 60;
+    const uint32_t layerCount = glm::clamp(argc > 4 ? std::atoi(argv[4]) : 2, 1, 2);
+
+    const uint32_t clipFrames = static_cast<uint32_t>(CLIP_LENGTH * SAMPLE_RATE) + 1;
+
+    std::vector<AnimationTrackSource> clipTracks[2];
+    AnimationClip clips[2];
+
+    Timer compressTimer;
+    for (int c = 0; c < 2; c++)
+    {
+        clipTracks[c] = MakeTracks(jointCount, clipFrames, c * 1.3f);
+        clips[c].Build(clipTracks[c]);
+    }
+    const double compressTime = compressTimer.Seconds();
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> startTime(0.0f, CLIP_LENGTH);
+
+    std::vector<Skeleton> skeletons(skeletonCount);
+    for (Skeleton& skeleton : skeletons)
+    {
+        std::vector<SceneComponent*> targets;
+        for (uint32_t j = 0; j < jointCount; j++)
+        {
+            skeleton.m_Joints.push_back(std::make_unique<SceneComponent>());
+            targets.push_back(skeleton.m_Joints.back().get());
+
+            // Chains of eight, like fingers off a spine.
+            if (j > 0)
+                skeleton.m_Joints[j % 8 == 0 ? 0 : j - 1]->AddChild(targets.back());
+        }
+
+        skeleton.m_Animator = std::make_unique<Animator>();
+        skeleton.m_Animator->SetTargets(targets);
+        skeleton.m_Animator->Play(&clips[0]).m_Time = startTime(rng);
+        if (layerCount > 1)
+            skeleton.m_Animator->AddLayer(&clips[1], 0.5f).m_Time = startTime(rng);
+
+        skeleton.m_Animator->Start();
+    }
+
+    AnimationSystem* system = AnimationSystem::Instance();
+    const size_t jointTotal = static_cast<size_t>(skeletonCount) * jointCount;
+
+    // Both paths pose the same times, then compare.
+    std::vector<Transform> reference(jointTotal);
+    EvaluateReference(skeletons, clipTracks, clips, reference);
+
+    system->m_MaxWorkers = -1;
+    system->Update(0.0f);
+
+    float maxTranslationError = 0.0f;
+    float maxRotationError = 0.0f;
+    size_t index = 0;
+    for (const Skeleton& skeleton : skeletons)
+    {
+        for (const std::unique_ptr<SceneComponent>& joint : skeleton.m_Joints)
+        {
+            const Transform& expected = reference[index++];
+            const Transform& actual = joint->m_Transform;
+
+            const glm::vec3 d = glm::abs(expected.m_Translation - actual.m_Translation);
+            maxTranslationError = glm::max(maxTranslationError, glm::max(d.x, glm::max(d.y, d.z)));
+            const glm::quat r = glm::conjugate(expected.m_Rotation) * actual.m_Rotation;
+            maxRotationError = glm::max(maxRotationError, 2.0f * glm::atan(glm::length(glm::vec3(r.x, r.y, r.z)), glm::abs(r.w)));
+        }
+    }
+
+    const float deltaTime = 1.0f / 60.0f;
+
+    // Scalar glm sampling of the raw frames, the cost without compression, SoA or threads.
+    double referenceTime = 0.0;
+    {
+        std::vector<Transform> scratch(jointTotal);
+        Timer timer;
+        for (int f = 0; f < frames; f++)
+        {
+            EvaluateReference(skeletons, clipTracks, clips, scratch);
+
+            size_t joint = 0;
+            for (const Skeleton& skeleton : skeletons)
+            {
+                for (const std::unique_ptr<SceneComponent>& target : skeleton.m_Joints)
+                {
+                    target->m_Transform = scratch[joint++];
+                    target->MarkDirty();
+                }
+            }
+        }
+        referenceTime = timer.Seconds() / frames;
+    }
+
+    auto timeSystem = [&](int maxWorkers)
+        {
+            system->m_MaxWorkers = maxWorkers;
+            system->Update(deltaTime);
+
+            Timer timer;
+            for (int f = 0; f < frames; f++)
+                system->Update(deltaTime);
+            return timer.Seconds() / frames;
+        };
+
+    const double singleTime = timeSystem(0);
+    const double threadedTime = timeSystem(-1);
+
+    system->Shutdown();
+
+    printf("Skeletons: %u x %u joints, %u layer(s), %d frames\n", skeletonCount, jointCount, layerCount, frames);
+    printf("Clips:     %zu keys kept of %u frames, %zu bytes from %zu (%.1fx), built in %.2f ms\n",
+        clips[0].GetKeyCount() + clips[1].GetKeyCount(), 2 * jointCount * 3 * clipFrames,
+        clips[0].GetCompressedSize() + clips[1].GetCompressedSize(), clips[0].GetSourceSize() + clips[1].GetSourceSize(),
+        static_cast<double>(clips[0].GetSourceSize() + clips[1].GetSourceSize()) / (clips[0].GetCompressedSize() + clips[1].GetCompressedSize()),
+        compressTime * 1000.0);
+    printf("Reference: %8.3f ms/frame  %8.1f M joints/s (scalar, raw frames)\n", referenceTime * 1000.0, jointTotal / referenceTime / 1e6);
+    printf("SIMD:      %8.3f ms/frame  %8.1f M joints/s (1 thread)\n", singleTime * 1000.0, jointTotal / singleTime / 1e6);
+    printf("Threaded:  %8.3f ms/frame  %8.1f M joints/s (%u threads)\n", threadedTime * 1000.0, jointTotal / threadedTime / 1e6,
+        glm::max(std::thread::hardware_concurrency(), 1u));
+    printf("Speedup:   %.2fx single, %.2fx threaded\n", referenceTime / singleTime, referenceTime / threadedTime);
+    printf("Max error: translation %.6f, rotation %.6f rad\n", maxTranslationError, maxRotationError);
+
+    // Key reduction stays within 1e-4 of the source frames, quantization and nlerp against
+    // slerp add a little on top.
+    return maxTranslationError < 1e-3f && maxRotationError < 1e-3f ? 0 : 1;
+}
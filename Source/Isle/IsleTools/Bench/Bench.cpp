@@ -0,0 +1,461 @@
+// Bench.cpp
+#include <IsleEngine.h>
+#include <Core/Importer/Gltf/GltfImporter.h>
+#include <Core/Light/Light.h>
+#include <fstream>
+#include <random>
+
+using namespace Isle;
+
+namespace
+{
+    struct BenchSettings
+    {
+        int m_Nodes = 1000;
+        int m_Depth = 4;
+        int m_Lights = 8;
+        int m_Iterations = 5;
+        int m_Frames = 30;
+        int m_Picks = 256;
+        uint32_t m_Seed = 1234;
+        std::string m_Gltf = "Assets/scene.gltf";
+        bool m_Textures = false;
+        std::string m_Output = "IsleBench.json";
+    };
+
+    struct Timer
+    {
+        std::chrono::high_resolution_clock::time_point m_Start = std::chrono::high_resolution_clock::now();
+
+        double Ms() const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_Start).count();
+        }
+    };
+
+    // One entry per iteration (or per frame), summarized when the report is written.
+    struct BenchTiming
+    {
+        std::string m_Name;
+        std::vector<double> m_Samples;
+    };
+
+    struct BenchScene
+    {
+        std::string m_Name;
+        size_t m_Nodes = 0;
+        size_t m_Meshes = 0;
+        size_t m_Lights = 0;
+        size_t m_Vertices = 0;
+        size_t m_Indices = 0;
+        size_t m_LoadUploadBytes = 0;
+        size_t m_FrameUploadBytes = 0;
+        uint64_t m_DrawCalls = 0;
+        uint64_t m_Dispatches = 0;
+        std::vector<BenchTiming> m_Timings;
+
+        std::vector<double>& Timing(const char* name)
+        {
+            for (BenchTiming& timing : m_Timings)
+            {
+                if (timing.m_Name == name)
+                    return timing.m_Samples;
+            }
+            m_Timings.push_back({ name, {} });
+            return m_Timings.back().m_Samples;
+        }
+    };
+
+    // Everything the scene passes need to time and later free one populated hierarchy.
+    struct BenchGraph
+    {
+        SceneComponent* m_Root = nullptr;
+        std::vector<SceneComponent*> m_Nodes;
+        std::vector<StaticMesh*> m_Meshes;
+        size_t m_Lights = 0;
+
+        // Procedural graphs are heap allocated here, imported ones belong to the importer's arena.
+        bool m_Owned = false;
+
+        void Gather()
+        {
+            m_Nodes = m_Root->GetChildrenInChildren();
+            m_Meshes = m_Root->GetChildrenInChildren<StaticMesh>();
+            m_Lights = m_Root->GetChildrenInChildren<Light>().size();
+        }
+
+        void Release()
+        {
+            if (m_Owned)
+            {
+                for (auto it = m_Nodes.rbegin(); it != m_Nodes.rend(); ++it)
+                    delete *it;
+                delete m_Root;
+            }
+
+            m_Root = nullptr;
+            m_Nodes.clear();
+            m_Meshes.clear();
+        }
+    };
+
+    // Spreads the nodes evenly over the requested depth, each one parented to a random node of the level above.
+    BenchGraph GenerateScene(const BenchSettings& settings, std::mt19937& rng)
+    {
+        BenchGraph graph;
+        graph.m_Root = new SceneComponent();
+        graph.m_Root->SetName("Procedural");
+        graph.m_Owned = true;
+
+        const int depth = std::max(settings.m_Depth, 1);
+        const float extent = 2.0f * std::sqrt(static_cast<float>(std::max(settings.m_Nodes, 1)));
+        std::uniform_real_distribution<float> position(-extent, extent);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<SceneComponent*> parents = { graph.m_Root };
+        int created = 0;
+
+        for (int level = 0; level < depth; level++)
+        {
+            const int count = settings.m_Nodes / depth + (level < settings.m_Nodes % depth ? 1 : 0);
+            const float spread = 1.0f / static_cast<float>(1 << level);
+
+            std::vector<SceneComponent*> current;
+            current.reserve(count);
+
+            for (int i = 0; i < count; i++, created++)
+            {
+                PrimitiveMesh* mesh = nullptr;
+                switch (created % 3)
+                {
+                case 0:  mesh = new CubeMesh(); break;
+                case 1:  mesh = new SphereMesh(); break;
+                default: mesh = new PlaneMesh(); break;
+                }
+
+                mesh->SetLocalPosition(glm::vec3(position(rng), position(rng) * 0.25f, position(rng)) * spread);
+                mesh->SetLocalRotation(glm::angleAxis(unit(rng) * glm::two_pi<float>(), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+                SceneComponent* parent = parents[std::uniform_int_distribution<size_t>(0, parents.size() - 1)(rng)];
+                parent->AddChild(mesh);
+                current.push_back(mesh);
+            }
+
+            if (!current.empty())
+                parents.swap(current);
+        }
+
+        for (int i = 0; i < settings.m_Lights; i++)
+        {
+            Light* light = nullptr;
+            const glm::vec3 lightPosition(position(rng), 10.0f + unit(rng) * 10.0f, position(rng));
+
+            if (i == 0)
+            {
+                light = new DirectionalLight();
+            }
+            else if (i % 2 == 1)
+            {
+                PointLight* point = new PointLight();
+                point->m_Position = lightPosition;
+                point->UpdateMatrices();
+                light = point;
+            }
+            else
+            {
+                SpotLight* spot = new SpotLight();
+                spot->m_Position = lightPosition;
+                spot->UpdateMatrices();
+                light = spot;
+            }
+
+            graph.m_Root->AddChild(light);
+        }
+
+        graph.Gather();
+        return graph;
+    }
+
+    // Runs the engine paths the editor exercises each frame against one hierarchy. The
+    // pipeline is recreated first so every iteration starts from empty GPU buffers.
+    void RunScenePasses(const BenchSettings& settings, BenchGraph& graph, BenchScene& result, std::mt19937& rng, bool collectCounts)
+    {
+        Render* render = Render::Instance();
+        Scene* scene = Scene::Instance();
+        GfxDevice* device = GfxDevice::Get();
+
+        {
+            render->Reset();
+            Pipeline* pipeline = render->GetPipeline();
+
+            Timer timer;
+            for (StaticMesh* mesh : graph.m_Meshes)
+                pipeline->AddStaticMesh(mesh);
+            result.Timing("add_static_mesh").push_back(timer.Ms());
+        }
+
+        render->Reset();
+        Pipeline* pipeline = render->GetPipeline();
+
+        {
+            Timer timer;
+            scene->Add(graph.m_Root, false);
+            scene->Update(0.0f);
+            result.Timing("scene_load").push_back(timer.Ms());
+        }
+
+        render->RenderFrame();
+        if (collectCounts)
+        {
+            result.m_LoadUploadBytes = render->GetStats().UploadBytesThisFrame;
+            result.m_Vertices = pipeline->GetNumVertices();
+            result.m_Indices = pipeline->GetNumIndicies();
+        }
+
+        {
+            Timer timer;
+            glm::vec3 checksum(0.0f);
+            for (SceneComponent* node : graph.m_Nodes)
+                checksum += glm::vec3(node->GetWorldMatrix()[3]);
+            result.Timing("transform_propagation").push_back(timer.Ms());
+
+            if (!std::isfinite(checksum.x + checksum.y + checksum.z))
+                ISLE_WARN("Non finite world transforms in %s\n", result.m_Name.c_str());
+        }
+
+        {
+            for (StaticMesh* mesh : graph.m_Meshes)
+                mesh->MarkDirty();
+
+            Timer timer;
+            for (StaticMesh* mesh : graph.m_Meshes)
+                pipeline->UpdateStaticMesh(mesh);
+            result.Timing("update_static_mesh").push_back(timer.Ms());
+        }
+
+        if (!graph.m_Meshes.empty())
+        {
+            std::uniform_int_distribution<size_t> pick(0, graph.m_Meshes.size() - 1);
+
+            Timer timer;
+            for (int i = 0; i < settings.m_Picks; i++)
+                pipeline->SelectMesh(graph.m_Meshes[pick(rng)], true);
+            result.Timing("pick").push_back(timer.Ms());
+        }
+
+        // Every node moves each frame, the worst case for UpdateStaticMesh and the upload path.
+        const glm::quat step = glm::angleAxis(0.01f, glm::vec3(0.0f, 1.0f, 0.0f));
+        size_t uploadBytes = 0;
+        device->ResetStats();
+
+        for (int frame = 0; frame < settings.m_Frames; frame++)
+        {
+            for (SceneComponent* node : graph.m_Nodes)
+                node->SetLocalRotation(step * node->GetLocalRotation());
+
+            {
+                Timer timer;
+                scene->Update(0.016f);
+                result.Timing("scene_update").push_back(timer.Ms());
+            }
+
+            {
+                Timer timer;
+                render->RenderFrame();
+                result.Timing("render_frame").push_back(timer.Ms());
+            }
+
+            uploadBytes += render->GetStats().UploadBytesThisFrame;
+        }
+
+        if (collectCounts && settings.m_Frames > 0)
+        {
+            result.m_FrameUploadBytes = uploadBytes / settings.m_Frames;
+            result.m_DrawCalls = device->GetStats().m_DrawCalls / settings.m_Frames;
+            result.m_Dispatches = device->GetStats().m_Dispatches / settings.m_Frames;
+        }
+
+        // Drop every borrowed pointer before the caller frees the graph.
+        scene->ClearAll();
+        render->Reset();
+    }
+
+    void WriteTiming(std::ofstream& file, const BenchTiming& timing, bool last)
+    {
+        std::vector<double> sorted = timing.m_Samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        double mean = 0.0;
+        for (double sample : sorted)
+            mean += sample;
+        mean = sorted.empty() ? 0.0 : mean / sorted.size();
+
+        const double median = sorted.empty() ? 0.0 : sorted[sorted.size() / 2];
+        const double minimum = sorted.empty() ? 0.0 : sorted.front();
+        const double maximum = sorted.empty() ? 0.0 : sorted.back();
+
+        char line[256];
+        snprintf(line, sizeof(line),
+            "        \"%s\": { \"min_ms\": %.4f, \"median_ms\": %.4f, \"mean_ms\": %.4f, \"max_ms\": %.4f, \"samples\": %zu }%s\n",
+            timing.m_Name.c_str(), minimum, median, mean, maximum, sorted.size(), last ? "" : ",");
+        file << line;
+
+        printf("  %-24s median %10.3f ms  min %10.3f ms\n", timing.m_Name.c_str(), median, minimum);
+    }
+
+    bool WriteReport(const std::string& path, const BenchSettings& settings, const std::vector<BenchScene>& scenes)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            printf("Failed to write %s\n", path.c_str());
+            return false;
+        }
+
+        // Stable key order and fixed precision so two reports diff line by line.
+        file << "{\n";
+        file << "  \"version\": 1,\n";
+        file << "  \"config\": { \"nodes\": " << settings.m_Nodes << ", \"depth\": " << settings.m_Depth
+             << ", \"lights\": " << settings.m_Lights << ", \"iterations\": " << settings.m_Iterations
+             << ", \"frames\": " << settings.m_Frames << ", \"picks\": " << settings.m_Picks
+             << ", \"seed\": " << settings.m_Seed << ", \"textures\": " << (settings.m_Textures ? "true" : "false") << " },\n";
+        file << "  \"scenes\": [\n";
+
+        for (size_t s = 0; s < scenes.size(); s++)
+        {
+            const BenchScene& scene = scenes[s];
+            printf("%s: %zu nodes, %zu meshes, %zu lights, %zu vertices\n",
+                scene.m_Name.c_str(), scene.m_Nodes, scene.m_Meshes, scene.m_Lights, scene.m_Vertices);
+
+            file << "    {\n";
+            file << "      \"name\": \"" << scene.m_Name << "\",\n";
+            file << "      \"nodes\": " << scene.m_Nodes << ",\n";
+            file << "      \"meshes\": " << scene.m_Meshes << ",\n";
+            file << "      \"lights\": " << scene.m_Lights << ",\n";
+            file << "      \"vertices\": " << scene.m_Vertices << ",\n";
+            file << "      \"indices\": " << scene.m_Indices << ",\n";
+            file << "      \"load_upload_bytes\": " << scene.m_LoadUploadBytes << ",\n";
+            file << "      \"frame_upload_bytes\": " << scene.m_FrameUploadBytes << ",\n";
+            file << "      \"draw_calls_per_frame\": " << scene.m_DrawCalls << ",\n";
+            file << "      \"dispatches_per_frame\": " << scene.m_Dispatches << ",\n";
+            file << "      \"timings\": {\n";
+            for (size_t t = 0; t < scene.m_Timings.size(); t++)
+                WriteTiming(file, scene.m_Timings[t], t + 1 == scene.m_Timings.size());
+            file << "      }\n";
+            file << "    }" << (s + 1 == scenes.size() ? "" : ",") << "\n";
+        }
+
+        file << "  ]\n";
+        file << "}\n";
+        return true;
+    }
+
+    bool ParseArguments(int argc, char** argv, BenchSettings& settings)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--nodes" && hasValue)           settings.m_Nodes = std::max(std::atoi(argv[++i]), 0);
+            else if (arg == "--depth" && hasValue)      settings.m_Depth = std::max(std::atoi(argv[++i]), 1);
+            else if (arg == "--lights" && hasValue)     settings.m_Lights = std::max(std::atoi(argv[++i]), 0);
+            else if (arg == "--iterations" && hasValue) settings.m_Iterations = std::max(std::atoi(argv[++i]), 1);
+            else if (arg == "--frames" && hasValue)     settings.m_Frames = std::max(std::atoi(argv[++i]), 0);
+            else if (arg == "--picks" && hasValue)      settings.m_Picks = std::max(std::atoi(argv[++i]), 0);
+            else if (arg == "--seed" && hasValue)       settings.m_Seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            else if (arg == "--gltf" && hasValue)       settings.m_Gltf = argv[++i];
+            else if (arg == "--out" && hasValue)        settings.m_Output = argv[++i];
+            else if (arg == "--textures")               settings.m_Textures = true;
+            else
+                return false;
+        }
+        return true;
+    }
+}
+
+// Usage: IsleBench [--nodes N] [--depth D] [--lights L] [--iterations I] [--frames F] [--picks P]
+//                  [--seed S] [--gltf file|none] [--textures] [--out file.json]
+int main(int argc, char** argv)
+{
+    BenchSettings settings;
+    if (!ParseArguments(argc, argv, settings))
+    {
+        printf("Usage: IsleBench [--nodes N] [--depth D] [--lights L] [--iterations I] [--frames F] [--picks P]\n"
+               "                 [--seed S] [--gltf file|none] [--textures] [--out file.json]\n");
+        return 1;
+    }
+
+    // No window and no GL context, resources keep their contents in CPU memory.
+    GfxDevice::Initialize(GFX_BACKEND::NULL_DEVICE);
+    Render::Instance()->Start(nullptr);
+
+    std::vector<BenchScene> scenes;
+
+    {
+        BenchScene result;
+        result.m_Name = "procedural";
+
+        for (int i = 0; i < settings.m_Iterations; i++)
+        {
+            // Same seed every iteration, the samples only differ by timing noise.
+            std::mt19937 rng(settings.m_Seed);
+
+            Timer timer;
+            BenchGraph graph = GenerateScene(settings, rng);
+            result.Timing("generate").push_back(timer.Ms());
+
+            result.m_Nodes = graph.m_Nodes.size();
+            result.m_Meshes = graph.m_Meshes.size();
+            result.m_Lights = graph.m_Lights;
+
+            RunScenePasses(settings, graph, result, rng, i == 0);
+            graph.Release();
+        }
+
+        scenes.push_back(result);
+    }
+
+    if (settings.m_Gltf != "none")
+    {
+        BenchScene result;
+        result.m_Name = settings.m_Gltf;
+
+        for (int i = 0; i < settings.m_Iterations; i++)
+        {
+            std::mt19937 rng(settings.m_Seed);
+
+            GltfImporter importer;
+            importer.m_LoadTextures = settings.m_Textures;
+
+            Timer timer;
+            if (!importer.LoadFromFile(settings.m_Gltf))
+            {
+                printf("Failed to import %s, skipping: %s\n", settings.m_Gltf.c_str(), importer.m_Error.c_str());
+                break;
+            }
+            result.Timing("import").push_back(timer.Ms());
+
+            BenchGraph graph;
+            graph.m_Root = importer.m_RootComponent;
+            graph.Gather();
+
+            result.m_Nodes = graph.m_Nodes.size();
+            result.m_Meshes = graph.m_Meshes.size();
+            result.m_Lights = graph.m_Lights;
+
+            // The importer frees the imported objects when it goes out of scope.
+            RunScenePasses(settings, graph, result, rng, i == 0);
+            graph.Release();
+        }
+
+        if (!result.m_Timings.empty())
+            scenes.push_back(result);
+    }
+
+    if (!WriteReport(settings.m_Output, settings, scenes))
+        return 1;
+
+    printf("Wrote %s\n", settings.m_Output.c_str());
+    return 0;
+}
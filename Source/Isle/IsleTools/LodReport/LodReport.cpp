@@ -0,0 +1,62 @@
+// LodReport.cpp
+#include <Core/Importer/Gltf/GltfImporter.h>
+#include <Core/Graphics/Mesh/MeshSimplifier.h>
+
+// Usage: IsleLodReport <file.gltf|file.glb> [maxLods] [reduction] [maxError]
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("Usage: IsleLodReport <file.gltf|file.glb> [maxLods] [reduction] [maxError]\n");
+        return 1;
+    }
+
+    Isle::MeshLodSettings settings;
+    if (argc > 2) settings.m_MaxLods = static_cast<uint32_t>(std::atoi(argv[2]));
+    if (argc > 3) settings.m_Reduction = static_cast<float>(std::atof(argv[3]));
+    if (argc > 4) settings.m_MaxError = static_cast<float>(std::atof(argv[4]));
+
+    Isle::GltfImporter importer;
+    importer.m_LoadTextures = false;
+    importer.m_BuildLods = false;
+
+    if (!importer.LoadFromFile(argv[1]))
+    {
+        printf("Failed to import %s: %s\n", argv[1], importer.m_Error.c_str());
+        return 1;
+    }
+
+    size_t totalSource = 0;
+    size_t totalLast = 0;
+
+    for (Isle::StaticMesh* mesh : importer.m_StaticMeshes)
+    {
+        if (!mesh)
+            continue;
+
+        mesh->BuildLods(settings);
+
+        const size_t sourceTriangles = mesh->GetIndices().size() / 3;
+        const auto& lods = mesh->GetLods();
+
+        printf("%s: %zu triangles, %zu meshlets\n", mesh->GetName().c_str(), sourceTriangles, mesh->GetMeshlets().size());
+
+        size_t lastTriangles = sourceTriangles;
+        for (size_t i = 0; i < lods.size(); i++)
+        {
+            const size_t triangles = lods[i].m_Indices.size() / 3;
+            const float reduction = sourceTriangles > 0 ? 100.0f * (1.0f - float(triangles) / float(sourceTriangles)) : 0.0f;
+
+            printf("  LOD%zu: %8zu triangles %6.1f%% reduction, error %.5f, %zu meshlets\n",
+                i + 1, triangles, reduction, lods[i].m_Error, lods[i].m_Meshlets.size());
+
+            lastTriangles = triangles;
+        }
+
+        totalSource += sourceTriangles;
+        totalLast += lastTriangles;
+    }
+
+    printf("Total: %zu triangles, %zu at the coarsest LOD\n", totalSource, totalLast);
+    return 0;
+}
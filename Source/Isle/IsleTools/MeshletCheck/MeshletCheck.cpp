@@ -0,0 +1,311 @@
+// MeshletCheck.cpp
+#include <Core/Graphics/Mesh/Meshlet.h>
+#include <array>
+#include <random>
+
+using namespace Isle;
+
+namespace
+{
+    int g_Failures = 0;
+
+    void Check(bool condition, const char* mesh, const char* what)
+    {
+        if (condition)
+            return;
+
+        printf("FAIL %s: %s\n", mesh, what);
+        g_Failures++;
+    }
+
+    struct TestMesh
+    {
+        const char* m_Name = "";
+        std::vector<GpuVertex> m_Vertices;
+        std::vector<unsigned int> m_Indices;
+    };
+
+    GpuVertex MakeVertex(const glm::vec3& position, const glm::vec3& normal)
+    {
+        return GpuVertex(position, normal, glm::vec3(1.0f, 0.0f, 0.0f), glm::vec2(0.0f), glm::vec4(1.0f));
+    }
+
+    // Flat grid on y = 0, counter clockwise seen from +y.
+    TestMesh MakeGrid(uint32_t size)
+    {
+        TestMesh mesh;
+        mesh.m_Name = "grid";
+        for (uint32_t z = 0; z <= size; z++)
+        {
+            for (uint32_t x = 0; x <= size; x++)
+                mesh.m_Vertices.push_back(MakeVertex(glm::vec3(float(x), 0.0f, float(z)) - float(size) * 0.5f * glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+        }
+
+        for (uint32_t z = 0; z < size; z++)
+        {
+            for (uint32_t x = 0; x < size; x++)
+            {
+                const uint32_t a = z * (size + 1) + x;
+                const uint32_t b = a + 1;
+                const uint32_t c = a + size + 1;
+                const uint32_t d = c + 1;
+                mesh.m_Indices.insert(mesh.m_Indices.end(), { a, c, b, b, c, d });
+            }
+        }
+        return mesh;
+    }
+
+    // Closed unit sphere, counter clockwise seen from outside.
+    TestMesh MakeSphere(uint32_t rings, uint32_t segments)
+    {
+        TestMesh mesh;
+        mesh.m_Name = "sphere";
+        for (uint32_t r = 0; r <= rings; r++)
+        {
+            const float phi = glm::pi<float>() * float(r) / float(rings);
+            for (uint32_t s = 0; s <= segments; s++)
+            {
+                const float theta = glm::two_pi<float>() * float(s) / float(segments);
+                const glm::vec3 p(glm::sin(phi) * glm::cos(theta), glm::cos(phi), glm::sin(phi) * glm::sin(theta));
+                mesh.m_Vertices.push_back(MakeVertex(p, p));
+            }
+        }
+
+        for (uint32_t r = 0; r < rings; r++)
+        {
+            for (uint32_t s = 0; s < segments; s++)
+            {
+                const uint32_t a = r * (segments + 1) + s;
+                const uint32_t b = a + segments + 1;
+
+                // The pole rows would be degenerate.
+                if (r > 0)
+                    mesh.m_Indices.insert(mesh.m_Indices.end(), { a, a + 1, b });
+                if (r + 1 < rings)
+                    mesh.m_Indices.insert(mesh.m_Indices.end(), { a + 1, b + 1, b });
+            }
+        }
+        return mesh;
+    }
+
+    // Unconnected triangles in random order, so the builder keeps falling back to its scan.
+    TestMesh MakeSoup(uint32_t triangles, std::mt19937& rng)
+    {
+        TestMesh mesh;
+        mesh.m_Name = "soup";
+        std::uniform_real_distribution<float> unit(-10.0f, 10.0f);
+        for (uint32_t t = 0; t < triangles; t++)
+        {
+            const glm::vec3 origin(unit(rng), unit(rng), unit(rng));
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                mesh.m_Indices.push_back(static_cast<unsigned int>(mesh.m_Vertices.size()));
+                mesh.m_Vertices.push_back(MakeVertex(origin + glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.1f, glm::vec3(0.0f, 1.0f, 0.0f)));
+            }
+        }
+        return mesh;
+    }
+
+    glm::vec3 Position(const TestMesh& mesh, const std::vector<unsigned int>& indices, size_t i)
+    {
+        return mesh.m_Vertices[indices[i]].m_Position;
+    }
+
+    // Rotated so the smallest index comes first, winding kept.
+    std::array<unsigned int, 3> Canonical(const unsigned int* t)
+    {
+        const uint32_t first = t[0] <= t[1] && t[0] <= t[2] ? 0 : (t[1] <= t[2] ? 1 : 2);
+        return { t[first], t[(first + 1) % 3], t[(first + 2) % 3] };
+    }
+
+    void CheckBuild(const TestMesh& mesh, uint32_t maxVertices, uint32_t maxTriangles)
+    {
+        std::vector<unsigned int> indices = mesh.m_Indices;
+        const std::vector<GpuMeshlet> meshlets = MeshletBuilder::Build(mesh.m_Vertices, indices, maxVertices, maxTriangles);
+
+        Check(!meshlets.empty(), mesh.m_Name, "no meshlets");
+        Check(indices.size() == mesh.m_Indices.size(), mesh.m_Name, "index count changed");
+
+        // Meshlets are back to back index ranges covering the whole reordered list.
+        uint32_t expectedOffset = 0;
+        for (const GpuMeshlet& meshlet : meshlets)
+        {
+            Check(meshlet.m_IndexOffset == expectedOffset, mesh.m_Name, "meshlet ranges are not contiguous");
+            Check(meshlet.m_IndexCount > 0 && meshlet.m_IndexCount % 3 == 0, mesh.m_Name, "meshlet index count");
+            Check(meshlet.m_IndexCount / 3 <= maxTriangles, mesh.m_Name, "meshlet over the triangle limit");
+            expectedOffset = meshlet.m_IndexOffset + meshlet.m_IndexCount;
+
+            std::vector<unsigned int> unique(indices.begin() + meshlet.m_IndexOffset, indices.begin() + expectedOffset);
+            std::sort(unique.begin(), unique.end());
+            unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+            Check(unique.size() <= maxVertices, mesh.m_Name, "meshlet over the vertex limit");
+
+            // Every vertex inside the sphere.
+            bool contained = true;
+            for (uint32_t i = meshlet.m_IndexOffset; i < expectedOffset; i++)
+                contained &= glm::length(Position(mesh, indices, i) - meshlet.m_Center) <= meshlet.m_Radius * 1.0001f + 1e-5f;
+            Check(contained, mesh.m_Name, "vertex outside the meshlet sphere");
+
+            // Every triangle inside the cone. A cutoff of 1 disables the cone test.
+            if (meshlet.m_ConeCutoff < 1.0f)
+            {
+                const float minDot = glm::sqrt(1.0f - meshlet.m_ConeCutoff * meshlet.m_ConeCutoff);
+                bool inCone = true;
+                for (uint32_t i = meshlet.m_IndexOffset; i < expectedOffset; i += 3)
+                {
+                    const glm::vec3 a = Position(mesh, indices, i);
+                    const glm::vec3 n = glm::cross(Position(mesh, indices, i + 1) - a, Position(mesh, indices, i + 2) - a);
+                    if (glm::length(n) > 1e-12f)
+                        inCone &= glm::dot(glm::normalize(n), meshlet.m_ConeAxis) >= minDot - 1e-4f;
+                }
+                Check(inCone, mesh.m_Name, "triangle normal outside the meshlet cone");
+            }
+        }
+        Check(expectedOffset == indices.size(), mesh.m_Name, "meshlets don't cover every index");
+
+        // Same triangles with the same winding, each exactly once.
+        std::vector<std::array<unsigned int, 3>> source;
+        std::vector<std::array<unsigned int, 3>> reordered;
+        for (size_t i = 0; i < mesh.m_Indices.size(); i += 3)
+        {
+            source.push_back(Canonical(&mesh.m_Indices[i]));
+            reordered.push_back(Canonical(&indices[i]));
+        }
+        std::sort(source.begin(), source.end());
+        std::sort(reordered.begin(), reordered.end());
+        Check(source == reordered, mesh.m_Name, "triangles lost or duplicated");
+
+        printf("%-8s %6zu triangles -> %4zu meshlets (max %u vertices, %u triangles)\n",
+            mesh.m_Name, mesh.m_Indices.size() / 3, meshlets.size(), maxVertices, maxTriangles);
+    }
+
+    // Culling must be conservative: whatever the culler rejects has no visible triangle.
+    void CheckCulling(const TestMesh& mesh, const glm::mat4& transform, std::mt19937& rng)
+    {
+        std::vector<unsigned int> indices = mesh.m_Indices;
+        const std::vector<GpuMeshlet> meshlets = MeshletBuilder::Build(mesh.m_Vertices, indices);
+
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+        const glm::mat3 basis(transform);
+        const float scale = glm::max(glm::length(basis[0]), glm::max(glm::length(basis[1]), glm::length(basis[2])));
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        uint32_t frustumRejected = 0;
+        uint32_t backfaceRejected = 0;
+
+        for (int view = 0; view < 64; view++)
+        {
+            const glm::vec3 eye = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng))) * (3.0f + 6.0f * (unit(rng) * 0.5f + 0.5f));
+            const glm::vec3 target(unit(rng) * 4.0f, unit(rng) * 4.0f, unit(rng) * 4.0f);
+            const glm::mat4 viewProjection = projection * glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+
+            MeshletCuller culler;
+            culler.SetCamera(viewProjection, eye);
+
+            std::vector<GpuDrawCommand> commands;
+            const uint32_t visible = culler.Cull(meshlets, transform, commands);
+            Check(visible == commands.size(), mesh.m_Name, "Cull count differs from the commands written");
+
+            uint32_t expected = 0;
+            for (const GpuMeshlet& meshlet : meshlets)
+            {
+                const bool isVisible = culler.IsVisible(meshlet, transform);
+                expected += isVisible ? 1 : 0;
+                if (isVisible)
+                    continue;
+
+                const glm::vec3 center = glm::vec3(transform * glm::vec4(meshlet.m_Center, 1.0f));
+                const bool outside = !culler.IsInFrustum(center, meshlet.m_Radius * scale);
+                frustumRejected += outside ? 1 : 0;
+                backfaceRejected += outside ? 0 : 1;
+
+                for (uint32_t i = meshlet.m_IndexOffset; i < meshlet.m_IndexOffset + meshlet.m_IndexCount; i += 3)
+                {
+                    const glm::vec3 a = glm::vec3(transform * glm::vec4(Position(mesh, indices, i), 1.0f));
+                    const glm::vec3 b = glm::vec3(transform * glm::vec4(Position(mesh, indices, i + 1), 1.0f));
+                    const glm::vec3 c = glm::vec3(transform * glm::vec4(Position(mesh, indices, i + 2), 1.0f));
+
+                    if (outside)
+                    {
+                        // No vertex in the clip volume. A triangle could still cross it between
+                        // vertices, the sphere test is what guarantees that can't happen.
+                        for (const glm::vec3& p : { a, b, c })
+                        {
+                            const glm::vec4 clip = viewProjection * glm::vec4(p, 1.0f);
+                            const bool inside = clip.w > 0.0f && glm::all(glm::lessThanEqual(glm::abs(glm::vec3(clip)), glm::vec3(clip.w * 0.999f)));
+                            Check(!inside, mesh.m_Name, "frustum culled a meshlet with a vertex on screen");
+                        }
+                    }
+                    else
+                    {
+                        const glm::vec3 n = glm::cross(b - a, c - a);
+                        Check(glm::dot(n, a - eye) >= -1e-4f * glm::length(n), mesh.m_Name, "backface culled a meshlet with a front facing triangle");
+                    }
+                }
+            }
+            Check(visible == expected, mesh.m_Name, "Cull and IsVisible disagree");
+        }
+
+        printf("%-8s culled %u meshlets by frustum, %u by backface over 64 views\n", mesh.m_Name, frustumRejected, backfaceRejected);
+    }
+
+    // Known answers: a grid seen from above is fully drawn, from below fully backface culled,
+    // and behind the camera fully frustum culled.
+    void CheckKnownViews()
+    {
+        const TestMesh grid = MakeGrid(32);
+        std::vector<unsigned int> indices = grid.m_Indices;
+        const std::vector<GpuMeshlet> meshlets = MeshletBuilder::Build(grid.m_Vertices, indices);
+
+        const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 1000.0f);
+        const glm::mat4 identity(1.0f);
+        MeshletCuller culler;
+        std::vector<GpuDrawCommand> commands;
+
+        const glm::vec3 above(0.0f, 40.0f, 0.0f);
+        culler.SetCamera(projection * glm::lookAt(above, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f)), above);
+        Check(culler.Cull(meshlets, identity, commands) == meshlets.size(), "grid", "meshlets culled seen from above");
+
+        const glm::vec3 below(0.0f, -40.0f, 0.0f);
+        culler.SetCamera(projection * glm::lookAt(below, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f)), below);
+        Check(culler.Cull(meshlets, identity, commands) == 0, "grid", "meshlets drawn seen from below");
+
+        culler.SetCamera(projection * glm::lookAt(above, glm::vec3(0.0f, 80.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f)), above);
+        Check(culler.Cull(meshlets, identity, commands) == 0, "grid", "meshlets drawn behind the camera");
+
+        // Moving the grid in front of the camera that looked away brings it back.
+        const glm::mat4 raised = glm::translate(glm::vec3(0.0f, 60.0f, 0.0f)) * glm::rotate(glm::pi<float>(), glm::vec3(1.0f, 0.0f, 0.0f));
+        Check(culler.Cull(meshlets, raised, commands) == meshlets.size(), "grid", "transformed meshlets culled in view");
+    }
+}
+
+// Usage: IsleMeshletCheck
+int main()
+{
+    std::mt19937 rng(1234);
+
+    const TestMesh grid = MakeGrid(48);
+    const TestMesh sphere = MakeSphere(48, 64);
+    const TestMesh soup = MakeSoup(3000, rng);
+
+    for (const TestMesh* mesh : { &grid, &sphere, &soup })
+    {
+        CheckBuild(*mesh, MeshletBuilder::MAX_VERTICES, MeshletBuilder::MAX_TRIANGLES);
+        CheckBuild(*mesh, 32, 16);
+        CheckBuild(*mesh, 3, 1);
+    }
+
+    CheckCulling(sphere, glm::mat4(1.0f), rng);
+    CheckCulling(sphere, glm::translate(glm::vec3(1.0f, 0.5f, -2.0f)) * glm::scale(glm::vec3(2.0f, 1.0f, 1.5f)), rng);
+    CheckCulling(grid, glm::scale(glm::vec3(0.2f)), rng);
+    CheckKnownViews();
+
+    if (g_Failures > 0)
+    {
+        printf("%d meshlet checks failed\n", g_Failures);
+        return 1;
+    }
+
+    printf("All meshlet checks passed\n");
+    return 0;
+}
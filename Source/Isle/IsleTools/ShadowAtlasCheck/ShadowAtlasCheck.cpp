@@ -0,0 +1,134 @@
+// ShadowAtlasCheck.cpp
+#include <IsleEngine.h>
+#include <Core/Light/Light.h>
+
+using namespace Isle;
+
+namespace
+{
+    int g_Failures = 0;
+
+    void Check(bool condition, const char* light, const char* what)
+    {
+        if (condition)
+            return;
+
+        printf("FAIL %s: %s\n", light, what);
+        g_Failures++;
+    }
+
+    // In front of the lights and a little above them, looking down -z.
+    GpuCamera MakeCamera()
+    {
+        GpuCamera camera{};
+        camera.m_CameraPos = glm::vec3(0.0f, 5.0f, 20.0f);
+        camera.m_ViewMatrix = glm::lookAt(camera.m_CameraPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        camera.m_ProjectionMatrix = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        camera.m_InverseViewProjection = glm::inverse(camera.m_ProjectionMatrix * camera.m_ViewMatrix);
+        return camera;
+    }
+
+    // Every tile of a light lies inside the atlas and covers at least one texel.
+    void CheckTiles(const GpuLight& light, int expectedTiles, int atlasSize, const char* name)
+    {
+        Check(light.m_ShadowTileCount == expectedTiles, name, "wrong number of atlas tiles");
+
+        for (int t = 0; t < light.m_ShadowTileCount && t < 6; t++)
+        {
+            const glm::vec4& tile = light.m_ShadowTiles[t];
+            Check(tile.w >= 1.0f && tile.w <= atlasSize, name, "tile size out of range");
+            Check(tile.x >= 0.0f && tile.y >= 0.0f && tile.x + tile.z <= 1.0f && tile.y + tile.z <= 1.0f, name, "tile outside the atlas");
+        }
+    }
+
+    bool Overlaps(const glm::vec4& a, const glm::vec4& b)
+    {
+        return a.x < b.x + b.z && b.x < a.x + a.z && a.y < b.y + b.z && b.y < a.y + a.z;
+    }
+}
+
+// Usage: IsleShadowAtlasCheck
+int main()
+{
+    // No window and no GL context, resources keep their contents in CPU memory.
+    GfxDevice::Initialize(GFX_BACKEND::NULL_DEVICE);
+    Render* render = Render::Instance();
+    render->Start(nullptr);
+
+    Pipeline* pipeline = render->GetPipeline();
+    *pipeline->GetCameraBuffer()->GetDataPtr<GpuCamera>() = MakeCamera();
+    pipeline->GetCameraBuffer()->MarkDirty();
+
+    // Local lights first, so the directional light is not the first entry either.
+    PointLight point;
+    point.m_Position = glm::vec3(-4.0f, 3.0f, 0.0f);
+    point.m_Radius = 10.0f;
+    point.UpdateMatrices();
+
+    DirectionalLight sun;
+
+    SpotLight spot;
+    spot.m_Position = glm::vec3(4.0f, 6.0f, 0.0f);
+    spot.m_Direction = glm::normalize(glm::vec3(0.2f, -1.0f, 0.1f));
+    spot.m_Radius = 12.0f;
+    spot.UpdateMatrices();
+
+    pipeline->AddLight(&point);
+    pipeline->AddLight(&sun);
+    pipeline->AddLight(&spot);
+
+    Check(point.m_Id == 0 && sun.m_Id == 1 && spot.m_Id == 2, "lights", "ids don't match the buffer index");
+    if (pipeline->GetNumLights() != 3)
+    {
+        printf("FAIL lights: %d of 3 lights in the light buffer\n", pipeline->GetNumLights());
+        return 1;
+    }
+
+    for (int frame = 0; frame < 3; frame++)
+        render->RenderFrame();
+
+    const GpuLight* lights = pipeline->GetLightBuffer()->GetDataPtr<GpuLight>();
+    const int atlasSize = pipeline->GetLocalShadowPass()->GetAtlasSize();
+
+    Check(lights[point.m_Id].m_Type == 1 && lights[spot.m_Id].m_Type == 2 && lights[sun.m_Id].m_Type == 0, "lights", "entry types don't match the lights");
+    CheckTiles(lights[point.m_Id], 6, atlasSize, "point");
+    CheckTiles(lights[spot.m_Id], 1, atlasSize, "spot");
+    CheckTiles(lights[sun.m_Id], 0, atlasSize, "directional");
+    Check(pipeline->GetLocalShadowPass()->GetShadowedLightCount() == 2, "lights", "wrong number of shadowed lights");
+
+    // All seven tiles come out of one quadtree, none may share texels.
+    std::vector<glm::vec4> tiles;
+    for (const GpuLight* light : { &lights[point.m_Id], &lights[spot.m_Id] })
+        tiles.insert(tiles.end(), light->m_ShadowTiles, light->m_ShadowTiles + light->m_ShadowTileCount);
+
+    bool overlap = false;
+    for (size_t a = 0; a < tiles.size(); a++)
+    {
+        for (size_t b = a + 1; b < tiles.size(); b++)
+            overlap |= Overlaps(tiles[a], tiles[b]);
+    }
+    Check(!overlap, "atlas", "tiles overlap");
+
+    // An update lands in the light's own slot and keeps the atlas mapping.
+    spot.m_Intensity = 7.0f;
+    pipeline->UpdateLight(&spot);
+    lights = pipeline->GetLightBuffer()->GetDataPtr<GpuLight>();
+    Check(lights[spot.m_Id].m_Intensity == 7.0f, "spot", "update didn't reach its slot");
+    Check(lights[point.m_Id].m_Intensity == point.m_Intensity && lights[sun.m_Id].m_Intensity == sun.m_Intensity, "lights", "update overwrote another slot");
+    CheckTiles(lights[spot.m_Id], 1, atlasSize, "updated spot");
+
+    printf("point %d tiles (%.0f texels), spot %d tile (%.0f texels), atlas %d\n",
+        lights[point.m_Id].m_ShadowTileCount, lights[point.m_Id].m_ShadowTiles[0].w,
+        lights[spot.m_Id].m_ShadowTileCount, lights[spot.m_Id].m_ShadowTiles[0].w, atlasSize);
+
+    render->Destroy();
+
+    if (g_Failures > 0)
+    {
+        printf("%d shadow atlas checks failed\n", g_Failures);
+        return 1;
+    }
+
+    printf("All shadow atlas checks passed\n");
+    return 0;
+}
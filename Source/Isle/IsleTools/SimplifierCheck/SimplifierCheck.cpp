@@ -0,0 +1,287 @@
+// SimplifierCheck.cpp
+#include <Core/Graphics/Mesh/MeshSimplifier.h>
+#include <random>
+
+using namespace Isle;
+
+namespace
+{
+    int g_Failures = 0;
+
+    void Check(bool condition, const char* mesh, const char* what)
+    {
+        if (condition)
+            return;
+
+        printf("FAIL %s: %s\n", mesh, what);
+        g_Failures++;
+    }
+
+    struct TestMesh
+    {
+        const char* m_Name = "";
+        std::vector<GpuVertex> m_Vertices;
+        std::vector<unsigned int> m_Indices;
+
+        // Vertices the simplifier has to keep: open borders and seams.
+        std::vector<unsigned int> m_Locked;
+    };
+
+    GpuVertex MakeVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& texCoord)
+    {
+        return GpuVertex(position, normal, glm::vec3(1.0f, 0.0f, 0.0f), texCoord, glm::vec4(1.0f));
+    }
+
+    // Gently curved height field, counter clockwise seen from +y. With a seam the columns
+    // from seamColumn on get their own copies of the vertices, like a UV split.
+    TestMesh MakeGrid(uint32_t size, uint32_t seamColumn = 0)
+    {
+        TestMesh mesh;
+        mesh.m_Name = seamColumn > 0 ? "seam grid" : "grid";
+
+        auto addVertex = [&](uint32_t x, uint32_t z, float u)
+            {
+                const float fx = float(x) / float(size);
+                const float fz = float(z) / float(size);
+                const glm::vec3 position(fx * 2.0f - 1.0f, 0.05f * glm::sin(fx * 3.0f) * glm::cos(fz * 2.0f), fz * 2.0f - 1.0f);
+                mesh.m_Vertices.push_back(MakeVertex(position, glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(u, fz)));
+                return static_cast<unsigned int>(mesh.m_Vertices.size() - 1);
+            };
+
+        std::vector<unsigned int> left((size + 1) * (size + 1));
+        std::vector<unsigned int> right(left.size());
+        for (uint32_t z = 0; z <= size; z++)
+        {
+            for (uint32_t x = 0; x <= size; x++)
+            {
+                const uint32_t i = z * (size + 1) + x;
+                left[i] = addVertex(x, z, float(x) / float(size));
+                right[i] = seamColumn > 0 && x == seamColumn ? addVertex(x, z, 1.0f) : left[i];
+
+                if (x == 0 || z == 0 || x == size || z == size)
+                    mesh.m_Locked.push_back(left[i]);
+                if (seamColumn > 0 && x == seamColumn)
+                    mesh.m_Locked.insert(mesh.m_Locked.end(), { left[i], right[i] });
+            }
+        }
+
+        for (uint32_t z = 0; z < size; z++)
+        {
+            for (uint32_t x = 0; x < size; x++)
+            {
+                const std::vector<unsigned int>& side = seamColumn > 0 && x >= seamColumn ? right : left;
+                const uint32_t a = z * (size + 1) + x;
+                const uint32_t c = a + size + 1;
+                mesh.m_Indices.insert(mesh.m_Indices.end(), { side[a], side[c], side[a + 1], side[a + 1], side[c], side[c + 1] });
+            }
+        }
+        return mesh;
+    }
+
+    // Closed unit sphere, counter clockwise seen from outside. The pole vertices are shared.
+    TestMesh MakeSphere(uint32_t rings, uint32_t segments)
+    {
+        TestMesh mesh;
+        mesh.m_Name = "sphere";
+
+        auto index = [&](uint32_t r, uint32_t s) -> unsigned int
+            {
+                if (r == 0)
+                    return 0;
+                if (r == rings)
+                    return 1;
+                return 2 + (r - 1) * segments + s % segments;
+            };
+
+        mesh.m_Vertices.push_back(MakeVertex(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f)));
+        mesh.m_Vertices.push_back(MakeVertex(glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), glm::vec2(0.0f)));
+        for (uint32_t r = 1; r < rings; r++)
+        {
+            const float phi = glm::pi<float>() * float(r) / float(rings);
+            for (uint32_t s = 0; s < segments; s++)
+            {
+                const float theta = glm::two_pi<float>() * float(s) / float(segments);
+                const glm::vec3 p(glm::sin(phi) * glm::cos(theta), glm::cos(phi), glm::sin(phi) * glm::sin(theta));
+                mesh.m_Vertices.push_back(MakeVertex(p, p, glm::vec2(0.0f)));
+            }
+        }
+
+        for (uint32_t r = 0; r < rings; r++)
+        {
+            for (uint32_t s = 0; s < segments; s++)
+            {
+                if (r > 0)
+                    mesh.m_Indices.insert(mesh.m_Indices.end(), { index(r, s), index(r, s + 1), index(r + 1, s) });
+                if (r + 1 < rings)
+                    mesh.m_Indices.insert(mesh.m_Indices.end(), { index(r, s + 1), index(r + 1, s + 1), index(r + 1, s) });
+            }
+        }
+        return mesh;
+    }
+
+    // Unconnected triangles, every edge is a border so nothing may move.
+    TestMesh MakeSoup(uint32_t triangles)
+    {
+        TestMesh mesh;
+        mesh.m_Name = "soup";
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (uint32_t t = 0; t < triangles * 3; t++)
+        {
+            mesh.m_Indices.push_back(static_cast<unsigned int>(mesh.m_Vertices.size()));
+            mesh.m_Vertices.push_back(MakeVertex(glm::vec3(unit(rng), unit(rng), unit(rng)), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(0.0f)));
+        }
+        return mesh;
+    }
+
+    glm::vec3 Normal(const TestMesh& mesh, const unsigned int* t)
+    {
+        const glm::vec3& a = mesh.m_Vertices[t[0]].m_Position;
+        return glm::cross(mesh.m_Vertices[t[1]].m_Position - a, mesh.m_Vertices[t[2]].m_Position - a);
+    }
+
+    // Valid, non degenerate triangles facing the way the surface faces, locked vertices kept.
+    void CheckResult(const TestMesh& mesh, const std::vector<unsigned int>& result, const char* what)
+    {
+        char label[128];
+        snprintf(label, sizeof(label), "%s %s", mesh.m_Name, what);
+
+        Check(result.size() % 3 == 0, label, "index count not a multiple of three");
+
+        const glm::vec3 up(0.0f, 1.0f, 0.0f);
+        bool valid = true;
+        bool degenerate = false;
+        bool flipped = false;
+        std::vector<uint8_t> used(mesh.m_Vertices.size(), 0);
+
+        for (size_t t = 0; t + 2 < result.size(); t += 3)
+        {
+            const unsigned int* triangle = &result[t];
+            if (triangle[0] >= mesh.m_Vertices.size() || triangle[1] >= mesh.m_Vertices.size() || triangle[2] >= mesh.m_Vertices.size())
+            {
+                valid = false;
+                continue;
+            }
+
+            for (int k = 0; k < 3; k++)
+                used[triangle[k]] = 1;
+
+            // Slivers count too: the area has to be more than a sliver of the longest edge squared.
+            const glm::vec3 normal = Normal(mesh, triangle);
+            float longest = 0.0f;
+            for (int k = 0; k < 3; k++)
+                longest = glm::max(longest, glm::length(mesh.m_Vertices[triangle[(k + 1) % 3]].m_Position - mesh.m_Vertices[triangle[k]].m_Position));
+            degenerate |= triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2] || glm::length(normal) <= 1e-3f * longest * longest;
+
+            // Grids face +y, the sphere faces away from its center.
+            const glm::vec3 centroid = (mesh.m_Vertices[triangle[0]].m_Position + mesh.m_Vertices[triangle[1]].m_Position + mesh.m_Vertices[triangle[2]].m_Position) / 3.0f;
+            const glm::vec3 outward = mesh.m_Name == std::string("sphere") ? centroid : up;
+            if (mesh.m_Name != std::string("soup"))
+                flipped |= glm::dot(normal, outward) <= 0.0f;
+        }
+
+        Check(valid, label, "index out of range");
+        Check(!degenerate, label, "degenerate triangle");
+        Check(!flipped, label, "flipped triangle");
+
+        bool locked = true;
+        for (unsigned int v : mesh.m_Locked)
+            locked &= used[v] != 0;
+        Check(locked, label, "border or seam vertex removed");
+    }
+
+    void CheckTargets(const TestMesh& mesh)
+    {
+        const size_t sourceTriangles = mesh.m_Indices.size() / 3;
+
+        // Unchanged when the target is already met.
+        Check(MeshSimplifier::Simplify(mesh.m_Vertices, mesh.m_Indices, mesh.m_Indices.size(), 1.0f) == mesh.m_Indices, mesh.m_Name, "changed without a reduction to do");
+
+        for (float fraction : { 0.5f, 0.25f, 0.1f })
+        {
+            const size_t target = static_cast<size_t>(sourceTriangles * fraction);
+
+            float error = 0.0f;
+            const std::vector<unsigned int> result = MeshSimplifier::Simplify(mesh.m_Vertices, mesh.m_Indices, target * 3, 1.0f, &error);
+            const size_t triangles = result.size() / 3;
+
+            char what[32];
+            snprintf(what, sizeof(what), "at %.0f%%", fraction * 100.0f);
+            CheckResult(mesh, result, what);
+
+            // Collapses remove one or two triangles, a pass can't run far past the target.
+            Check(triangles <= target, mesh.m_Name, "target triangle count not reached");
+            Check(triangles + 4 >= target, mesh.m_Name, "simplified well past the target");
+            Check(error <= 1.0f, mesh.m_Name, "error over the limit");
+
+            printf("%-10s %6zu -> %6zu triangles (target %zu), error %.5f\n", mesh.m_Name, sourceTriangles, triangles, target, error);
+        }
+
+        // A tight error limit has to stop the collapse before the target.
+        float error = 0.0f;
+        const float maxError = 1e-3f;
+        const std::vector<unsigned int> limited = MeshSimplifier::Simplify(mesh.m_Vertices, mesh.m_Indices, 3, maxError, &error);
+        CheckResult(mesh, limited, "error limited");
+        Check(error <= maxError * 1.0001f, mesh.m_Name, "error limit exceeded");
+        Check(limited.size() > 3, mesh.m_Name, "error limit ignored");
+
+        printf("%-10s %6zu -> %6zu triangles (error limit %.4f), error %.5f\n", mesh.m_Name, sourceTriangles, limited.size() / 3, maxError, error);
+    }
+
+    void CheckLodChain(const TestMesh& mesh)
+    {
+        MeshLodSettings settings;
+        settings.m_MaxError = 1.0f;
+
+        const std::vector<MeshLod> lods = MeshSimplifier::BuildLodChain(mesh.m_Vertices, mesh.m_Indices, settings);
+        Check(!lods.empty(), mesh.m_Name, "no LODs built");
+
+        size_t previous = mesh.m_Indices.size();
+        float previousError = 0.0f;
+        for (const MeshLod& lod : lods)
+        {
+            CheckResult(mesh, lod.m_Indices, "LOD");
+            Check(lod.m_Indices.size() < previous, mesh.m_Name, "LOD not smaller than the one before");
+            Check(lod.m_Error >= previousError, mesh.m_Name, "LOD error decreased");
+            Check(!lod.m_Meshlets.empty(), mesh.m_Name, "LOD without meshlets");
+
+            uint32_t covered = 0;
+            for (const GpuMeshlet& meshlet : lod.m_Meshlets)
+                covered += meshlet.m_IndexCount;
+            Check(covered == lod.m_Indices.size(), mesh.m_Name, "LOD meshlets don't cover its indices");
+
+            previous = lod.m_Indices.size();
+            previousError = lod.m_Error;
+        }
+
+        printf("%-10s %zu LODs, coarsest %zu triangles\n", mesh.m_Name, lods.size(), previous / 3);
+    }
+}
+
+// Usage: IsleSimplifierCheck
+int main()
+{
+    const TestMesh grid = MakeGrid(48);
+    const TestMesh seamGrid = MakeGrid(48, 20);
+    const TestMesh sphere = MakeSphere(32, 48);
+
+    for (const TestMesh* mesh : { &grid, &seamGrid, &sphere })
+    {
+        CheckTargets(*mesh);
+        CheckLodChain(*mesh);
+    }
+
+    // Nothing in a soup can collapse without opening a hole.
+    const TestMesh soup = MakeSoup(500);
+    Check(MeshSimplifier::Simplify(soup.m_Vertices, soup.m_Indices, 30, 1.0f) == soup.m_Indices, soup.m_Name, "border vertices collapsed");
+
+    if (g_Failures > 0)
+    {
+        printf("%d simplifier checks failed\n", g_Failures);
+        return 1;
+    }
+
+    printf("All simplifier checks passed\n");
+    return 0;
+}
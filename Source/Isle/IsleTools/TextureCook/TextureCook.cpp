@@ -0,0 +1,198 @@
+// TextureCook.cpp
+#include <Core/Graphics/Texture/TextureCompressor.h>
+#include <Core/Graphics/Texture/TextureCache.h>
+#include <stb_image.h>
+#include <cstring>
+
+using namespace Isle;
+
+namespace
+{
+    struct FormatCheck
+    {
+        TEXTURE_FORMAT m_Format;
+        const char* m_Name;
+        double m_MinPSNR;
+    };
+
+    // A BC7 mode 6 block written bit by bit from the format spec: endpoints (127, 0, 64, 127)
+    // and (0, 127, 32, 100) with p-bits 1 and 0, texel i using index i. The expected texels
+    // come from Pillow's BC7 decoder, so they don't depend on our encoder and decoder agreeing.
+    const uint8_t s_BC7Reference[16] = {
+        0xC0, 0x3F, 0x00, 0xF0, 0x07, 0x82, 0xFE, 0xE4, 0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE
+    };
+
+    const uint8_t s_BC7ReferenceTexels[16][4] = {
+        { 255,   1, 129, 255 }, { 239,  17, 125, 252 }, { 219,  37, 120, 247 }, { 203,  52, 116, 244 },
+        { 187,  68, 112, 240 }, { 171,  84, 108, 237 }, { 151, 104, 103, 233 }, { 135, 120,  99, 229 },
+        { 120, 135,  94, 226 }, { 104, 151,  90, 222 }, {  84, 171,  85, 218 }, {  68, 187,  81, 215 },
+        {  52, 203,  77, 211 }, {  36, 218,  73, 208 }, {  16, 238,  68, 203 }, {   0, 254,  64, 200 },
+    };
+
+    bool CheckBC7Reference()
+    {
+        uint8_t block[64];
+        TextureCompressor::DecodeBC7Block(s_BC7Reference, block);
+
+        for (int i = 0; i < 16; i++)
+        {
+            const uint8_t* texel = block + i * 4;
+            const uint8_t* expected = s_BC7ReferenceTexels[i];
+            if (std::memcmp(texel, expected, 4) != 0)
+            {
+                printf("  BC7 reference: texel %d decoded to (%d, %d, %d, %d), expected (%d, %d, %d, %d)\n", i,
+                    texel[0], texel[1], texel[2], texel[3], expected[0], expected[1], expected[2], expected[3]);
+                return false;
+            }
+        }
+
+        printf("  BC7 reference: mode 6 block decodes to the expected texels\n");
+        return true;
+    }
+
+    float Noise(int x, int y)
+    {
+        uint32_t h = uint32_t(x) * 374761393u + uint32_t(y) * 668265263u;
+        h = (h ^ (h >> 13)) * 1274126177u;
+        return float((h ^ (h >> 16)) & 0xFFFF) / 65535.0f;
+    }
+
+    // Gradients, a soft blob field, per pixel noise and hard edges, so smooth, noisy and
+    // high contrast blocks are all covered.
+    std::vector<uint8_t> MakeTestImage(int width, int height)
+    {
+        std::vector<uint8_t> rgba(size_t(width) * height * 4);
+
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                const float u = float(x) / width;
+                const float v = float(y) / height;
+                const float blobs = 0.5f + 0.25f * std::sin(u * 23.0f) * std::cos(v * 17.0f) + 0.25f * std::sin((u + v) * 9.0f);
+                const bool checker = ((x / 32) + (y / 32)) & 1;
+
+                uint8_t* p = rgba.data() + (size_t(y) * width + x) * 4;
+                p[0] = static_cast<uint8_t>(255.0f * (u * 0.8f + Noise(x, y) * 0.2f));
+                p[1] = static_cast<uint8_t>(255.0f * (blobs * 0.9f + Noise(y, x) * 0.1f));
+                p[2] = checker ? 220 : static_cast<uint8_t>(255.0f * v);
+                p[3] = static_cast<uint8_t>(255.0f * glm::clamp(blobs * 1.2f - 0.1f, 0.0f, 1.0f));
+            }
+        }
+
+        return rgba;
+    }
+
+    // Tangent space normal map derived from the same blob height field.
+    std::vector<uint8_t> MakeNormalMap(int width, int height)
+    {
+        std::vector<uint8_t> rgba(size_t(width) * height * 4);
+
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                const float u = float(x) / width;
+                const float v = float(y) / height;
+                const float dx = 0.25f * 23.0f * std::cos(u * 23.0f) * std::cos(v * 17.0f) / width * 8.0f;
+                const float dy = -0.25f * 17.0f * std::sin(u * 23.0f) * std::sin(v * 17.0f) / height * 8.0f;
+                const glm::vec3 n = glm::normalize(glm::vec3(-dx + (Noise(x, y) - 0.5f) * 0.1f, -dy, 1.0f));
+
+                uint8_t* p = rgba.data() + (size_t(y) * width + x) * 4;
+                p[0] = static_cast<uint8_t>((n.x * 0.5f + 0.5f) * 255.0f + 0.5f);
+                p[1] = static_cast<uint8_t>((n.y * 0.5f + 0.5f) * 255.0f + 0.5f);
+                p[2] = static_cast<uint8_t>((n.z * 0.5f + 0.5f) * 255.0f + 0.5f);
+                p[3] = 255;
+            }
+        }
+
+        return rgba;
+    }
+}
+
+// Usage: IsleTextureCook [image] [--cache]
+// Decodes a reference BC7 block, then encodes the image (or a procedural test image) to every
+// BC format, decodes it again and checks the PSNR of the top mip against a per format floor.
+// Exits non-zero on failure.
+int main(int argc, char** argv)
+{
+    std::string path;
+    bool writeCache = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--cache")
+            writeCache = true;
+        else
+            path = arg;
+    }
+
+    int width = 512;
+    int height = 512;
+    std::vector<uint8_t> color;
+
+    if (!path.empty())
+    {
+        int channels = 0;
+        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        if (!data)
+        {
+            printf("Failed to load %s\n", path.c_str());
+            return 1;
+        }
+
+        color = TextureCompressor::ExpandToRGBA(data, width, height, channels);
+        stbi_image_free(data);
+    }
+    else
+    {
+        color = MakeTestImage(width, height);
+    }
+
+    const std::vector<uint8_t> normals = path.empty() ? MakeNormalMap(width, height) : color;
+
+    const FormatCheck checks[] = {
+        { TEXTURE_FORMAT::BC1, "BC1", 28.0 },
+        { TEXTURE_FORMAT::BC3, "BC3", 28.0 },
+        { TEXTURE_FORMAT::BC4, "BC4", 34.0 },
+        { TEXTURE_FORMAT::BC5, "BC5", 34.0 },
+        { TEXTURE_FORMAT::BC7, "BC7", 30.0 },
+    };
+
+    printf("%s: %dx%d\n", path.empty() ? "procedural" : path.c_str(), width, height);
+
+    bool passed = CheckBC7Reference();
+    for (const FormatCheck& check : checks)
+    {
+        const std::vector<uint8_t>& source = check.m_Format == TEXTURE_FORMAT::BC5 ? normals : color;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        CompressedImage image = TextureCompressor::CompressMipChain(source.data(), width, height, check.m_Format);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        std::vector<uint8_t> decoded = TextureCompressor::Decompress(image.m_Mips[0].m_Data.data(), width, height, check.m_Format);
+        double psnr = TextureCompressor::ComputePSNR(source.data(), decoded.data(), width, height, TextureCompressor::GetChannelMask(check.m_Format));
+
+        const bool ok = psnr >= check.m_MinPSNR;
+        passed &= ok;
+
+        printf("  %s: %7.2f dB (min %.0f) %s, %zu mips, %8zu bytes (%.1f:1), %7.1f ms\n",
+            check.m_Name, psnr, check.m_MinPSNR, ok ? "ok  " : "FAIL",
+            image.m_Mips.size(), image.GetSizeInBytes(),
+            double(size_t(width) * height * 4) / double(image.m_Mips[0].m_Data.size()), ms);
+
+        if (writeCache)
+        {
+            std::string key = TextureCache::MakeKey(source.data(), source.size(), width, height, check.m_Format);
+            CompressedImage cached;
+            if (!TextureCache::Store(key, image) || !TextureCache::Load(key, cached) || cached.GetSizeInBytes() != image.GetSizeInBytes())
+            {
+                printf("  %s: cache round trip failed\n", check.m_Name);
+                passed = false;
+            }
+        }
+    }
+
+    return passed ? 0 : 1;
+}